@@ -3,6 +3,7 @@
 from Crypto.PublicKey import RSA
 from Crypto.Cipher import PKCS1_OAEP
 from Crypto.Cipher import ChaCha20
+from Crypto.Cipher import AES
 from Crypto.Hash import SHA256
 import binascii
 import argparse
@@ -56,7 +57,11 @@ if __name__ == "__main__":
     #print(binascii.hexlify(ulog_key))
 
     # Read and decrypt the .ulgc
-    cipher = ChaCha20.new(key=ulog_key, nonce=nonce)
+    # the nonce identifies the algorithm: 24 bytes for XChaCha20, 8 bytes for AES-256 in CTR mode
+    if nonce_size == 8:
+        cipher = AES.new(ulog_key, AES.MODE_CTR, nonce=nonce)
+    else:
+        cipher = ChaCha20.new(key=ulog_key, nonce=nonce)
     with open(args.ulog_file, 'rb') as f:
         with open(args.ulog_file.rstrip(args.ulog_file[-1]), 'wb') as out:
             out.write(cipher.decrypt(f.read()))
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+"""
+Resolve and summarize the samples of the statistical profiler (profiler module).
+
+The input is either a histogram written with 'profiler dump <file>', or a ULog
+file containing the profiler_samples topic ('profiler start -p' and the logger
+debug profile). The addresses are resolved with addr2line against the ELF of
+the same build (on POSIX the addresses are offsets into the px4 executable).
+
+Example:
+    ./Tools/profiler_report.py -a arm-none-eabi-addr2line -e build/px4_fmu-v5_default/px4_fmu-v5_default.elf profile.txt
+    ./Tools/profiler_report.py -e build/px4_sitl_default/bin/px4 log.ulg
+"""
+
+from __future__ import print_function
+
+import argparse
+import collections
+import subprocess
+import sys
+
+
+def read_dump(file_name):
+    """ read a 'profiler dump' histogram, returns {pc: count} """
+    histogram = collections.Counter()
+    with open(file_name, 'r') as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            pc, count = line.split()
+            histogram[int(pc, 16)] += int(count)
+    return histogram
+
+
+def read_ulog(file_name, pid=None):
+    """ read the profiler_samples topic of a ULog file, returns ({pc: count}, dropped) """
+    from pyulog import ULog
+
+    ulog = ULog(file_name, ['profiler_samples'])
+    if not ulog.data_list:
+        raise RuntimeError('no profiler_samples in {}'.format(file_name))
+
+    histogram = collections.Counter()
+    dropped = 0
+    data = ulog.data_list[0].data
+    for i in range(len(data['timestamp'])):
+        dropped += int(data['dropped'][i])
+        for k in range(int(data['count'][i])):
+            if pid is not None and int(data['pid[{}]'.format(k)][i]) != pid:
+                continue
+            histogram[int(data['pc[{}]'.format(k)][i])] += 1
+    return histogram, dropped
+
+
+def resolve(addr2line, elf, addresses):
+    """ map addresses to function names with a single addr2line call """
+    if not addresses:
+        return {}
+    cmd = [addr2line, '-f', '-C', '-e', elf] + ['0x{:x}'.format(a) for a in addresses]
+    output = subprocess.check_output(cmd).decode('utf-8', errors='replace').splitlines()
+    # two lines per address: function, file:line
+    return {a: output[2 * i] for i, a in enumerate(addresses)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarize statistical profiler samples')
+    parser.add_argument('input', help='profiler dump (text) or ULog file')
+    parser.add_argument('-e', '--elf', required=True, help='ELF file of the profiled build')
+    parser.add_argument('-a', '--addr2line', default='addr2line', help='addr2line binary (default: %(default)s)')
+    parser.add_argument('-n', '--top', type=int, default=30, help='number of functions to print')
+    parser.add_argument('--pid', type=int, help='only use the samples of this task/thread (ULog only)')
+    args = parser.parse_args()
+
+    dropped = 0
+    if args.input.endswith('.ulg'):
+        histogram, dropped = read_ulog(args.input, args.pid)
+    else:
+        histogram = read_dump(args.input)
+
+    total = sum(histogram.values())
+    if total == 0:
+        print('no samples')
+        return 1
+
+    # 0: outside of the executable (e.g. shared libraries on POSIX)
+    unknown = histogram.pop(0, 0)
+
+    names = resolve(args.addr2line, args.elf, sorted(histogram.keys()))
+    functions = collections.Counter()
+    for pc, count in histogram.items():
+        functions[names.get(pc, '??')] += count
+    if unknown:
+        functions['[outside of the executable]'] = unknown
+
+    print('{} samples ({} dropped)'.format(total, dropped))
+    print('{:>8} {:>7}  {}'.format('samples', '%', 'function'))
+    for name, count in functions.most_common(args.top):
+        print('{:>8} {:>6.2f}%  {}'.format(count, 100.0 * count / total, name))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
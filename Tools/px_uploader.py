@@ -198,6 +198,7 @@ class uploader(object):
     MAX_DES_LENGTH  = 20
 
     REBOOT          = b'\x30'
+    PROG_MULTI_LONG = b'\x3a'     # rev5+  , optional, see INFO_PROG_LONG_MAX
 
     INFO_BL_REV     = b'\x01'        # bootloader protocol revision
     BL_REV_MIN      = 2              # minimum supported bootloader protocol
@@ -205,6 +206,7 @@ class uploader(object):
     INFO_BOARD_ID   = b'\x02'        # board type
     INFO_BOARD_REV  = b'\x03'        # board revision
     INFO_FLASH_SIZE = b'\x04'        # max firmware size in bytes
+    INFO_PROG_LONG_MAX = b'\x06'     # max PROG_MULTI_LONG size in bytes (INVALID if not supported)
 
     PROG_MULTI_MAX  = 252            # protocol max is 255, must be multiple of 4
     READ_MULTI_MAX  = 252            # protocol max is 255
@@ -232,6 +234,7 @@ class uploader(object):
         self.port = serial.Serial(portname, baudrate_bootloader, timeout=0.5, write_timeout=0)
         self.otp = b''
         self.sn = b''
+        self.prog_long_max = 0
         self.baudrate_bootloader = baudrate_bootloader
         self.baudrate_flightstack = baudrate_flightstack
         self.baudrate_flightstack_idx = -1
@@ -466,6 +469,20 @@ class uploader(object):
             time.sleep((ord(length) * self.chartime) + uploader.MAX_FLASH_PRGRAM_TIME)
             self.__probe(False)
 
+    # send a PROG_MULTI_LONG command to write a larger block of bytes
+    def __program_multi_long(self, data, windowMode):
+
+        length = len(data).to_bytes(2, byteorder='little')
+
+        self.__send(uploader.PROG_MULTI_LONG)
+        self.__send(length)
+        self.__send(data)
+        self.__send(uploader.EOC)
+        if (not windowMode):
+            self.__getSync(False)
+        else:
+            time.sleep((len(data) * self.chartime) + uploader.MAX_FLASH_PRGRAM_TIME)
+
     # verify multiple bytes in flash
     def __verify_multi(self, data):
 
@@ -502,12 +519,18 @@ class uploader(object):
         self.__probe(False)
         print("\n", end='')
         code = fw.image
-        groups = self.__split_len(code, uploader.PROG_MULTI_MAX)
+        if self.prog_long_max > 0:
+            groups = self.__split_len(code, self.prog_long_max)
+        else:
+            groups = self.__split_len(code, uploader.PROG_MULTI_MAX)
         # Give imedate feedback
         self.__drawProgressBar(label, 0, len(groups))
         uploadProgress = 0
         for bytes in groups:
-            self.__program_multi(bytes, self.ackWindowedMode)
+            if self.prog_long_max > 0:
+                self.__program_multi_long(bytes, self.ackWindowedMode)
+            else:
+                self.__program_multi(bytes, self.ackWindowedMode)
             # If in Window mode, extend the window size for the __ackSyncWindow
             if self.ackWindowedMode:
                 self.window += self.window_per
@@ -577,6 +600,15 @@ class uploader(object):
             print("Unsupported bootloader protocol %d" % uploader.INFO_BL_REV)
             raise RuntimeError("Bootloader protocol mismatch")
 
+        # larger program blocks are an optional extension of protocol 5
+        if self.bl_rev >= 5:
+            try:
+                self.prog_long_max = self.__getInfo(uploader.INFO_PROG_LONG_MAX) & ~3
+            except (RuntimeError, struct.error):
+                # INVALID resets the bootloader command sequence, start over
+                self.prog_long_max = 0
+                self.__sync()
+
         self.board_type = self.__getInfo(uploader.INFO_BOARD_ID)
         self.board_rev = self.__getInfo(uploader.INFO_BOARD_REV)
         self.fw_maxsize = self.__getInfo(uploader.INFO_FLASH_SIZE)
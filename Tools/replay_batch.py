@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+
+"""
+Replay a batch of ULog files in parallel.
+
+Every log is replayed by its own px4 instance (with its own working directory,
+and therefore its own uORB and parameter state), in lockstep and as fast as
+possible. The output logs are collected into a single directory, named after
+the input log.
+
+Example (EKF2 replay of all logs in a directory, using all cores):
+    make px4_sitl_default replay=dummy.ulg # once, to build the replay target
+    ./Tools/replay_batch.py -o replayed/ --params ekf2_tuning.txt logs/
+"""
+
+from __future__ import print_function
+
+import argparse
+import glob
+import multiprocessing
+import os
+import shutil
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+
+def find_logs(paths):
+    """ expand directories into the contained .ulg files """
+    logs = []
+    for path in paths:
+        if os.path.isdir(path):
+            logs.extend(sorted(glob.glob(os.path.join(path, '**', '*.ulg'), recursive=True)))
+        else:
+            logs.append(path)
+    return logs
+
+
+def newest_log(directory):
+    """ get the most recently written .ulg file below directory (or None) """
+    logs = glob.glob(os.path.join(directory, 'log', '**', '*.ulg'), recursive=True)
+    if not logs:
+        return None
+    return max(logs, key=os.path.getmtime)
+
+
+def replay(args, instance, log_file):
+    """ run a single replay, returns (log_file, output file or None, message) """
+    name = os.path.splitext(os.path.basename(log_file))[0]
+    work_dir = os.path.abspath(os.path.join(args.output, 'work', name))
+    if os.path.exists(work_dir):
+        shutil.rmtree(work_dir)
+    os.makedirs(work_dir)
+
+    if args.params:
+        # the replay module applies these on top of the parameters in the log
+        shutil.copyfile(args.params, os.path.join(work_dir, 'replay_params.txt'))
+
+    env = os.environ.copy()
+    env['replay'] = os.path.abspath(log_file)
+    if args.mode in ('ekf2', 'lockstep'):
+        env['replay_mode'] = args.mode
+    else:
+        env.pop('replay_mode', None)
+        env['PX4_SIM_SPEED_FACTOR'] = '0' # no wall-clock pacing
+
+    # the px4 instance is only used to separate the daemon sockets and lock files
+    cmd = [args.px4, '-d', '-i', str(instance), '-w', work_dir, args.etc]
+
+    start = time.time()
+    with open(os.path.join(work_dir, 'px4.log'), 'w') as console:
+        try:
+            ret = subprocess.call(cmd, env=env, stdout=console, stderr=subprocess.STDOUT,
+                                  stdin=subprocess.DEVNULL, timeout=args.timeout)
+        except subprocess.TimeoutExpired:
+            return log_file, None, 'timeout after {:.0f}s'.format(args.timeout)
+    duration = time.time() - start
+
+    if ret != 0:
+        return log_file, None, 'px4 exited with {} (see {})'.format(ret, console.name)
+
+    output_log = newest_log(work_dir)
+    if output_log is None:
+        return log_file, None, 'no output log (see {})'.format(console.name)
+
+    output_file = os.path.join(args.output, name + '_replayed.ulg')
+    shutil.move(output_log, output_file)
+    if not args.keep:
+        shutil.rmtree(work_dir)
+    return log_file, output_file, 'done in {:.1f}s'.format(duration)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Replay ULog files in parallel')
+    parser.add_argument('logs', nargs='+', help='ULog files or directories containing ULog files')
+    parser.add_argument('-o', '--output', default='replayed', help='output directory (default: %(default)s)')
+    parser.add_argument('-j', '--jobs', type=int, default=multiprocessing.cpu_count(),
+                        help='number of parallel replays (default: number of cores)')
+    parser.add_argument('-m', '--mode', choices=['ekf2', 'lockstep', 'generic'], default='ekf2',
+                        help='replay mode (default: %(default)s)')
+    parser.add_argument('-p', '--params', help='parameter file applied to every replay (replay_params.txt format)')
+    parser.add_argument('-b', '--build-dir', default='build/px4_sitl_default_replay',
+                        help='replay build directory (default: %(default)s)')
+    parser.add_argument('-t', '--timeout', type=float, default=3600, help='timeout per log in seconds')
+    parser.add_argument('-k', '--keep', action='store_true', help='keep the working directories')
+    args = parser.parse_args()
+
+    args.px4 = os.path.abspath(os.path.join(args.build_dir, 'bin', 'px4'))
+    args.etc = os.path.abspath(os.path.join(args.build_dir, 'etc'))
+    if not os.path.isfile(args.px4):
+        print('px4 binary not found: {} (build with "make px4_sitl_default replay=<log>")'.format(args.px4))
+        return 1
+    if args.params and not os.path.isfile(args.params):
+        print('parameter file not found: {}'.format(args.params))
+        return 1
+
+    logs = find_logs(args.logs)
+    if not logs:
+        print('no logs found')
+        return 1
+
+    names = [os.path.splitext(os.path.basename(log))[0] for log in logs]
+    if len(set(names)) != len(names):
+        print('log file names must be unique')
+        return 1
+
+    os.makedirs(args.output, exist_ok=True)
+    jobs = max(1, min(args.jobs, len(logs)))
+    print('Replaying {} logs with {} jobs'.format(len(logs), jobs))
+
+    failed = 0
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        # instance ids must be unique among the concurrently running px4 processes
+        futures = [executor.submit(replay, args, i, log) for i, log in enumerate(logs)]
+        for future in as_completed(futures):
+            log_file, output_file, message = future.result()
+            if output_file is None:
+                failed += 1
+                print('FAILED {}: {}'.format(log_file, message))
+            else:
+                print('{} -> {}: {}'.format(log_file, output_file, message))
+
+    print('{} of {} replays succeeded'.format(len(logs) - failed, len(logs)))
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -10,7 +10,7 @@ sitl_num=2
 [ -n "$1" ] && sitl_num="$1"
 
 SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
-src_path="$SCRIPT_DIR/.."
+src_path="$SCRIPT_DIR/../.."
 
 build_path=${src_path}/build/px4_sitl_default
 
@@ -33,3 +33,14 @@ while [ $n -lt $sitl_num ]; do
 
 	n=$(($n + 1))
 done
+
+# Report the memory actually used per instance once they are up. Code and
+# read-only data (parameter metadata, uORB metadata, mavlink stream tables)
+# are mapped from the same binary and shared, so the proportional set
+# size (Pss) is the cost of each additional vehicle.
+sleep 5
+for pid in $(pgrep -x px4); do
+	if [ -r /proc/$pid/smaps_rollup ]; then
+		echo "px4 pid $pid: $(awk '/^Rss:|^Pss:|^Shared_Clean:/ {printf "%s %d MB  ", $1, $2 / 1024}' /proc/$pid/smaps_rollup)"
+	fi
+done
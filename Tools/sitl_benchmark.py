@@ -0,0 +1,364 @@
+#!/usr/bin/env python3
+
+"""
+Run a scripted SITL flight as fast as possible and report the hot-path costs.
+
+A headless px4 instance flies the SIH quadx (takeoff, hold, land) in lockstep
+with PX4_SIM_SPEED_FACTOR=0, logging the debug profile. The resulting log and
+the uORB state at the end of the flight are reduced to a JSON report:
+ - per work item CPU time, runs and scheduling latency (work_item_stats)
+ - uORB publications per topic instance (uorb status)
+ - heap allocations and peak per module (heap_usage, builds with CONFIG_SYSTEMCMDS_MEM)
+ - gyro sample to actuator output latency (output_latency)
+All rates are normalized per simulated second, so runs of slightly different
+length remain comparable.
+
+Compare against a previous report, exits with 1 if a metric regressed:
+    make px4_sitl_default
+    ./Tools/sitl_benchmark.py -o baseline.json
+    # ... change code, rebuild ...
+    ./Tools/sitl_benchmark.py -o new.json --baseline baseline.json --threshold 10
+"""
+
+from __future__ import print_function
+
+import argparse
+import glob
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+try:
+    from pyulog import ULog
+except ImportError:
+    print('Failed to import pyulog, install it with: pip3 install --user pyulog')
+    sys.exit(1)
+
+
+ARMING_STATE_ARMED = 2
+NAVIGATION_STATE_AUTO_LOITER = 4
+STAGE_TOTAL = 4
+
+# metrics where a higher value is better, all others are costs
+HIGHER_IS_BETTER = ('sim_speedup',)
+
+
+class Px4Instance(object):
+    """ headless px4 daemon, controlled through the px4-<command> clients """
+
+    def __init__(self, build_dir, work_dir, instance):
+        self.bin_dir = os.path.join(build_dir, 'bin')
+        self.etc = os.path.join(build_dir, 'etc')
+        self.work_dir = work_dir
+        self.instance = instance
+        self.process = None
+
+    def start(self, model):
+        env = os.environ.copy()
+        env['PX4_SIM_MODEL'] = model
+        env['PX4_SIMULATOR'] = 'sihsim'
+        env['PX4_SIM_SPEED_FACTOR'] = '0' # no wall-clock pacing
+        env['PX4_BENCHMARK'] = '1'
+        env.pop('PX4_SYS_AUTOSTART', None)
+
+        self.console = open(os.path.join(self.work_dir, 'px4.log'), 'w')
+        cmd = [os.path.join(self.bin_dir, 'px4'), '-d', '-i', str(self.instance), '-w', self.work_dir, self.etc]
+        self.process = subprocess.Popen(cmd, env=env, stdout=self.console, stderr=subprocess.STDOUT,
+                                        stdin=subprocess.DEVNULL)
+
+    def command(self, module, *args):
+        """ run a px4 command, returns (return code, output) """
+        cmd = [os.path.join(self.bin_dir, 'px4-' + module), '--instance', str(self.instance)] + list(args)
+        try:
+            result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                    stdin=subprocess.DEVNULL, timeout=30)
+        except subprocess.TimeoutExpired:
+            return -1, ''
+        return result.returncode, result.stdout.decode('utf-8', 'replace')
+
+    def listen(self, topic):
+        """ fields of the latest message of a topic (as strings), None if not published yet """
+        ret, output = self.command('listener', topic, '-n', '1')
+        if ret != 0 or 'never published' in output:
+            return None
+        fields = {}
+        for line in output.splitlines():
+            m = re.match(r'^\s*(\w+):\s*(\S+)', line)
+            if m and m.group(1) not in fields:
+                fields[m.group(1)] = m.group(2)
+        return fields
+
+    def running(self):
+        return self.process is not None and self.process.poll() is None
+
+    def stop(self, timeout=30):
+        if self.running():
+            self.command('shutdown')
+            try:
+                self.process.wait(timeout=timeout)
+            except subprocess.TimeoutExpired:
+                self.process.kill()
+                self.process.wait()
+        self.console.close()
+
+
+def sim_time(px4):
+    """ current simulation time [s] (from the lockstep clock) """
+    status = px4.listen('vehicle_status')
+    if status is None or 'timestamp' not in status:
+        return None
+    return int(status['timestamp']) * 1e-6
+
+
+def wait_for(px4, condition, timeout, description):
+    """ poll the vehicle_status until condition(status) holds """
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        if not px4.running():
+            raise RuntimeError('px4 exited while waiting for {}'.format(description))
+        status = px4.listen('vehicle_status')
+        if status is not None and condition(status):
+            return status
+        time.sleep(0.2)
+    raise RuntimeError('timeout waiting for {}'.format(description))
+
+
+def fly(px4, args):
+    """ takeoff, hold for args.hold simulated seconds, land and wait for the disarm """
+    deadline = time.time() + args.timeout
+
+    # the takeoff is rejected until the preflight checks pass (estimator convergence)
+    while True:
+        if time.time() > deadline:
+            raise RuntimeError('timeout waiting for the takeoff')
+        if not px4.running():
+            raise RuntimeError('px4 exited before the takeoff')
+        status = px4.listen('vehicle_status')
+        if status is not None and int(status.get('arming_state', 0)) == ARMING_STATE_ARMED:
+            break
+        px4.command('commander', 'takeoff')
+        time.sleep(1)
+
+    wait_for(px4, lambda s: int(s.get('nav_state', 0)) == NAVIGATION_STATE_AUTO_LOITER,
+             deadline - time.time(), 'the takeoff to complete')
+
+    hold_start = sim_time(px4)
+    while True:
+        now = sim_time(px4)
+        if now is not None and hold_start is not None and now - hold_start >= args.hold:
+            break
+        if time.time() > deadline:
+            raise RuntimeError('timeout during the hold')
+        time.sleep(0.2)
+
+    px4.command('commander', 'land')
+    wait_for(px4, lambda s: int(s.get('arming_state', 0)) != ARMING_STATE_ARMED,
+             deadline - time.time(), 'the landing')
+
+
+def uorb_publications(px4):
+    """ (topic, instance) -> publications, from 'uorb status' """
+    ret, output = px4.command('uorb', 'status')
+    publications = {}
+    if ret != 0:
+        return publications
+    # TOPIC NAME INST #SUB #Q SIZE #PUB PATH
+    for line in output.splitlines():
+        m = re.match(r'^(\w+)\s+(\d+)\s+(-?\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+\S+$', line.strip())
+        if m:
+            publications['{}/{}'.format(m.group(1), m.group(2))] = int(m.group(6))
+    return publications
+
+
+def ulog_string(data, field, index):
+    """ decode a char[] field of a ULog dataset """
+    chars = []
+    i = 0
+    while '{}[{}]'.format(field, i) in data:
+        c = int(data['{}[{}]'.format(field, i)][index])
+        if c == 0:
+            break
+        chars.append(chr(c))
+        i += 1
+    return ''.join(chars)
+
+
+def datasets(ulog, name):
+    return [d for d in ulog.data_list if d.name == name]
+
+
+def analyze_log(log_file):
+    """ reduce the flight log to the report metrics """
+    ulog = ULog(log_file, ['work_item_stats', 'heap_usage', 'output_latency'])
+    duration = (ulog.last_timestamp - ulog.start_timestamp) * 1e-6
+    metrics = {}
+
+    if duration <= 0:
+        return metrics, duration
+
+    # accumulated since the item was created: the latest sample per item counts
+    work_items = {}
+    for d in datasets(ulog, 'work_item_stats'):
+        for i in range(len(d.data['timestamp'])):
+            key = '{}/{}'.format(ulog_string(d.data, 'wq_name', i), ulog_string(d.data, 'item_name', i))
+            work_items[key] = {f: int(d.data[f][i]) for f in
+                               ('timestamp', 'run_count', 'run_time_total', 'run_time_max',
+                                'latency_total', 'deadline_misses')}
+
+    for key, w in work_items.items():
+        metrics['cpu_us_per_s/' + key] = w['run_time_total'] / duration
+        metrics['runs_per_s/' + key] = w['run_count'] / duration
+        metrics['run_time_max_us/' + key] = w['run_time_max']
+        if w['run_count'] > 0:
+            metrics['sched_latency_mean_us/' + key] = w['latency_total'] / w['run_count']
+        if w['deadline_misses'] > 0:
+            metrics['deadline_misses/' + key] = w['deadline_misses']
+
+    for d in datasets(ulog, 'heap_usage'):
+        for i in range(len(d.data['timestamp'])):
+            module = ulog_string(d.data, 'module_name', i)
+            metrics['allocations_per_s/' + module] = int(d.data['allocations'][i]) / duration
+            metrics['heap_peak_bytes/' + module] = int(d.data['peak_bytes'][i])
+            metrics['heap_peak_bytes/total'] = int(d.data['total_peak_bytes'][i])
+
+    # weighted over all intervals and output modules
+    samples = 0
+    latency_sum = 0.
+    latency_max = 0
+    for d in datasets(ulog, 'output_latency'):
+        n = d.data['samples']
+        mean = d.data['latency_mean_us[{}]'.format(STAGE_TOTAL)]
+        for i in range(len(n)):
+            samples += int(n[i])
+            latency_sum += float(mean[i]) * int(n[i])
+            latency_max = max(latency_max, int(d.data['latency_max_us[{}]'.format(STAGE_TOTAL)][i]))
+    if samples > 0:
+        metrics['gyro_to_output_latency_mean_us'] = latency_sum / samples
+        metrics['gyro_to_output_latency_max_us'] = latency_max
+
+    return metrics, duration
+
+
+def newest_log(directory):
+    logs = glob.glob(os.path.join(directory, 'log', '**', '*.ulg'), recursive=True)
+    if not logs:
+        return None
+    return max(logs, key=os.path.getmtime)
+
+
+def compare(report, baseline, threshold, noise_floor):
+    """ print the changes against a baseline report, returns the number of regressions """
+    regressions = 0
+    metrics = report['metrics']
+    for key in sorted(baseline['metrics']):
+        old = baseline['metrics'][key]
+        if key not in metrics:
+            print('  missing   {}'.format(key))
+            continue
+        new = metrics[key]
+        if max(abs(old), abs(new)) < noise_floor:
+            continue
+        change = (new - old) / old * 100. if old != 0 else float('inf')
+        worse = -change if key in HIGHER_IS_BETTER else change
+        if worse > threshold:
+            regressions += 1
+            print('  REGRESSED {}: {:.2f} -> {:.2f} ({:+.1f}%)'.format(key, old, new, change))
+        elif worse < -threshold:
+            print('  improved  {}: {:.2f} -> {:.2f} ({:+.1f}%)'.format(key, old, new, change))
+    for key in sorted(set(metrics) - set(baseline['metrics'])):
+        print('  new       {}: {:.2f}'.format(key, metrics[key]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SITL hot-path benchmark (scripted SIH flight, as fast as possible)')
+    parser.add_argument('-o', '--output', default='sitl_benchmark.json', help='report file (default: %(default)s)')
+    parser.add_argument('-b', '--build-dir', default='build/px4_sitl_default',
+                        help='SITL build directory (default: %(default)s)')
+    parser.add_argument('-m', '--model', default='quadx', help='SIH model (default: %(default)s)')
+    parser.add_argument('--hold', type=float, default=30, help='hold duration [simulated s] (default: %(default)s)')
+    parser.add_argument('-i', '--instance', type=int, default=10, help='px4 instance (default: %(default)s)')
+    parser.add_argument('-t', '--timeout', type=float, default=600, help='timeout of the flight [s]')
+    parser.add_argument('--baseline', help='report to compare against')
+    parser.add_argument('--threshold', type=float, default=10, help='regression threshold [%%] (default: %(default)s)')
+    parser.add_argument('--noise-floor', type=float, default=1,
+                        help='skip metrics with both values below this (default: %(default)s)')
+    parser.add_argument('-k', '--keep', action='store_true', help='keep the working directory')
+    args = parser.parse_args()
+
+    build_dir = os.path.abspath(args.build_dir)
+    if not os.path.isfile(os.path.join(build_dir, 'bin', 'px4')):
+        print('px4 binary not found in {} (build with "make px4_sitl_default")'.format(build_dir))
+        return 1
+
+    baseline = None
+    if args.baseline:
+        with open(args.baseline, 'r') as f:
+            baseline = json.load(f)
+
+    work_dir = os.path.abspath(os.path.splitext(args.output)[0] + '_work')
+    if os.path.exists(work_dir):
+        shutil.rmtree(work_dir)
+    os.makedirs(work_dir)
+
+    px4 = Px4Instance(build_dir, work_dir, args.instance)
+    start = time.time()
+    px4.start(args.model)
+    try:
+        fly(px4, args)
+        # the log is closed on disarm (SDLOG_MODE 1), the uORB state is still there
+        time.sleep(1)
+        publications = uorb_publications(px4)
+        ret, sih_status = px4.command('simulator_sih', 'status')
+    except RuntimeError as e:
+        print('FAILED: {} (see {})'.format(e, os.path.join(work_dir, 'px4.log')))
+        px4.stop()
+        return 1
+    wall_time = time.time() - start
+    px4.stop()
+
+    log_file = newest_log(work_dir)
+    if log_file is None:
+        print('FAILED: no log written (see {})'.format(os.path.join(work_dir, 'px4.log')))
+        return 1
+
+    metrics, duration = analyze_log(log_file)
+    if duration > 0:
+        for key, count in publications.items():
+            metrics['publications_per_s/' + key] = count / duration
+
+    m = re.search(r'Simulated seconds per wall second:\s*([\d.]+)', sih_status)
+    if m:
+        metrics['sim_speedup'] = float(m.group(1))
+
+    report = {
+        'model': args.model,
+        'hold_s': args.hold,
+        'sim_duration_s': duration,
+        'wall_time_s': wall_time,
+        'metrics': metrics,
+    }
+
+    with open(args.output, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print('{:.1f} simulated seconds in {:.1f}s, {} metrics written to {}'.format(
+        duration, wall_time, len(metrics), args.output))
+
+    if not args.keep:
+        shutil.rmtree(work_dir)
+
+    if baseline is not None:
+        print('Comparison against {} (threshold {:.0f}%):'.format(args.baseline, args.threshold))
+        regressions = compare(report, baseline, args.threshold, args.noise_floor)
+        print('{} regressions'.format(regressions))
+        return 1 if regressions else 0
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
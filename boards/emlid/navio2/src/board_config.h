@@ -44,6 +44,13 @@
 
 #define BOARD_MAX_LEDS 1 // Number of external LED's this board has
 
+// work queue CPU pinning (4 cores): rate controller on its own core, EKF instances in parallel on others
+#define BOARD_WQ_CPU_AFFINITY { \
+		{"wq:rate_ctrl", (1 << 3)}, \
+		{"wq:INS0",      (1 << 1)}, \
+		{"wq:INS1",      (1 << 2)}, \
+	}
+
 
 // I2C
 #define CONFIG_I2C 1
@@ -0,0 +1,113 @@
+############################################################################
+#
+#   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#=============================================================================
+# Profile guided optimization (POSIX)
+#
+#  1. build with CMAKE_BUILD_TYPE=ProfileGenerate and run a representative
+#     workload, every process exit writes the profiles to PX4_PGO_PROFILE_DIR
+#  2. rebuild with CMAKE_BUILD_TYPE=ProfileUse (optimized with the profiles and LTO)
+#
+# 'make pgo' does this with the SITL mavsdk tests as workload. On a target
+# (e.g. Raspberry Pi) run the instrumented px4 with GCOV_PREFIX (GCC) or
+# LLVM_PROFILE_FILE (Clang) pointing to a writable directory and copy the
+# profiles back into PX4_PGO_PROFILE_DIR before doing step 2.
+#
+
+set(PX4_PGO_PROFILE_DIR "${PX4_BINARY_DIR}/pgo_profile" CACHE PATH "PGO profile directory")
+
+if("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+	# Clang writes raw profiles that have to be merged first (llvm-profdata merge)
+	set(pgo_generate_flags "-fprofile-generate=${PX4_PGO_PROFILE_DIR}")
+	set(pgo_use_flags "-fprofile-use=${PX4_PGO_PROFILE_DIR}/default.profdata -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date")
+
+else()
+	# atomic counter updates, PX4 is heavily multithreaded
+	set(pgo_generate_flags "-fprofile-generate=${PX4_PGO_PROFILE_DIR} -fprofile-update=atomic")
+	# -fprofile-correction: tolerate inconsistent counters of multithreaded code
+	set(pgo_use_flags "-fprofile-use=${PX4_PGO_PROFILE_DIR} -fprofile-correction -Wno-missing-profile")
+endif()
+
+set(CMAKE_C_FLAGS_PROFILEGENERATE "${CMAKE_C_FLAGS_RELWITHDEBINFO} ${pgo_generate_flags}"
+	CACHE STRING "Flags used by the C compiler during PGO instrumented builds" FORCE)
+set(CMAKE_CXX_FLAGS_PROFILEGENERATE "${CMAKE_CXX_FLAGS_RELWITHDEBINFO} ${pgo_generate_flags}"
+	CACHE STRING "Flags used by the C++ compiler during PGO instrumented builds" FORCE)
+set(CMAKE_EXE_LINKER_FLAGS_PROFILEGENERATE "${pgo_generate_flags}"
+	CACHE STRING "Flags used for linking binaries during PGO instrumented builds" FORCE)
+set(CMAKE_SHARED_LINKER_FLAGS_PROFILEGENERATE "${pgo_generate_flags}"
+	CACHE STRING "Flags used for linking shared libraries during PGO instrumented builds" FORCE)
+
+set(CMAKE_C_FLAGS_PROFILEUSE "${CMAKE_C_FLAGS_RELWITHDEBINFO} ${pgo_use_flags}"
+	CACHE STRING "Flags used by the C compiler during PGO optimized builds" FORCE)
+set(CMAKE_CXX_FLAGS_PROFILEUSE "${CMAKE_CXX_FLAGS_RELWITHDEBINFO} ${pgo_use_flags}"
+	CACHE STRING "Flags used by the C++ compiler during PGO optimized builds" FORCE)
+set(CMAKE_EXE_LINKER_FLAGS_PROFILEUSE "${pgo_use_flags}"
+	CACHE STRING "Flags used for linking binaries during PGO optimized builds" FORCE)
+set(CMAKE_SHARED_LINKER_FLAGS_PROFILEUSE "${pgo_use_flags}"
+	CACHE STRING "Flags used for linking shared libraries during PGO optimized builds" FORCE)
+
+mark_as_advanced(
+	CMAKE_C_FLAGS_PROFILEGENERATE CMAKE_CXX_FLAGS_PROFILEGENERATE
+	CMAKE_EXE_LINKER_FLAGS_PROFILEGENERATE CMAKE_SHARED_LINKER_FLAGS_PROFILEGENERATE
+	CMAKE_C_FLAGS_PROFILEUSE CMAKE_CXX_FLAGS_PROFILEUSE
+	CMAKE_EXE_LINKER_FLAGS_PROFILEUSE CMAKE_SHARED_LINKER_FLAGS_PROFILEUSE
+)
+
+if(CMAKE_BUILD_TYPE STREQUAL ProfileGenerate)
+	message(STATUS "PGO: instrumented build, profiles are written to ${PX4_PGO_PROFILE_DIR}")
+	file(MAKE_DIRECTORY ${PX4_PGO_PROFILE_DIR})
+
+elseif(CMAKE_BUILD_TYPE STREQUAL ProfileUse)
+	if("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+		if(NOT EXISTS "${PX4_PGO_PROFILE_DIR}/default.profdata")
+			message(FATAL_ERROR "PGO: ${PX4_PGO_PROFILE_DIR}/default.profdata missing (llvm-profdata merge -o default.profdata *.profraw)")
+		endif()
+
+	else()
+		file(GLOB_RECURSE pgo_profiles "${PX4_PGO_PROFILE_DIR}/*.gcda")
+		if(NOT pgo_profiles)
+			message(FATAL_ERROR "PGO: no profiles in ${PX4_PGO_PROFILE_DIR}, run a ProfileGenerate build first")
+		endif()
+	endif()
+
+	message(STATUS "PGO: optimizing with the profiles in ${PX4_PGO_PROFILE_DIR}")
+
+	# the profiles pay off most with cross module inlining
+	include(CheckIPOSupported)
+	check_ipo_supported(RESULT pgo_ipo_supported OUTPUT pgo_ipo_output)
+	if(pgo_ipo_supported)
+		set(CMAKE_INTERPROCEDURAL_OPTIMIZATION TRUE)
+	else()
+		message(WARNING "PGO: LTO not supported: ${pgo_ipo_output}")
+	endif()
+endif()
@@ -43,6 +43,7 @@
  *
  ****************************************************************************/
 
+#include <px4_platform_common/px4_config.h>
 #include <uORB/topics/uORBTopics.hpp>
 #include <uORB/uORB.h>
 @{
@@ -51,6 +52,7 @@ msgs_count = len(msg_names)
 topics_all = topics
 topics_all.sort()
 topics_count_all = len(topics_all)
+nested_topics_all = sorted(nested_topics.items())
 }@
 @[for msg_name in msg_names]@
 #include <uORB/topics/@(msg_name).h>
@@ -75,3 +77,54 @@ const struct orb_metadata *get_orb_meta(ORB_ID id)
 
 	return uorb_topics_list[static_cast<uint8_t>(id)];
 }
+
+@[for topic_name, nested in nested_topics_all]@
+static constexpr ORB_ID uorb_@(topic_name)_nested[] = {@(", ".join(["ORB_ID::" + n for n in nested]))};
+@[end for]
+
+int orb_get_nested_topics(ORB_ID id, const ORB_ID **nested)
+{
+	switch (id) {
+@[for topic_name, nested in nested_topics_all]@
+	case ORB_ID::@(topic_name):
+		*nested = uorb_@(topic_name)_nested;
+		return @(len(nested));
+
+@[end for]
+	default:
+		break;
+	}
+
+	*nested = nullptr;
+	return 0;
+}
+
+#if defined(CONFIG_UORB_STATIC_POOL_SIZE) && (CONFIG_UORB_STATIC_POOL_SIZE > 0) && !defined(__KERNEL__)
+template<typename T> static constexpr size_t queue_length(decltype(T::ORB_QUEUE_LENGTH) *) { return T::ORB_QUEUE_LENGTH; }
+template<typename T> static constexpr size_t queue_length(...) { return 1; }
+
+// buffers of a single instance of every topic: more than any configuration uses
+static constexpr size_t uorb_topics_data_size =
+@[for idx, topic_name in enumerate(topics_all, 1)]@
+	sizeof(@(topic_msgs[topic_name])_s) * queue_length<@(topic_msgs[topic_name])_s>(nullptr)@[if idx != topics_count_all] +@[else];@[end if]
+@[end for]
+
+static constexpr size_t uorb_static_pool_size = (CONFIG_UORB_STATIC_POOL_SIZE < uorb_topics_data_size) ?
+		CONFIG_UORB_STATIC_POOL_SIZE : uorb_topics_data_size;
+
+// with -fdata-sections a board linker script can place it (eg in DTCM) by the .bss.*uorb_static_pool* section name
+alignas(64) static uint8_t uorb_static_pool[uorb_static_pool_size];
+
+void *orb_get_static_pool(size_t *size)
+{
+	*size = uorb_static_pool_size;
+	return uorb_static_pool;
+}
+
+#else
+void *orb_get_static_pool(size_t *size)
+{
+	*size = 0;
+	return nullptr;
+}
+#endif
@@ -73,3 +73,20 @@ enum class ORB_ID : uint8_t {
 };
 
 const struct orb_metadata *get_orb_meta(ORB_ID id);
+
+/**
+ * Get the message types nested in a topic (recursively), as precomputed by the generator.
+ * A nested type is referred to by the topic with the same name.
+ * @param id topic
+ * @param nested output: array of nested topics (nullptr if there are none)
+ * @return number of nested topics
+ */
+int orb_get_nested_topics(ORB_ID id, const ORB_ID **nested);
+
+/**
+ * Get the statically allocated memory for the topic buffers (CONFIG_UORB_STATIC_POOL_SIZE),
+ * sized at build time to at most one instance of every topic.
+ * @param size output: pool size in bytes
+ * @return pool, nullptr if disabled
+ */
+void *orb_get_static_pool(size_t *size);
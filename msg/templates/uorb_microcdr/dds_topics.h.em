@@ -47,11 +47,46 @@ struct SendTopicsSubs {
 	uxrSession* session;
 
 	uint32_t num_payload_sent{};
+	uint32_t num_samples_sent{};
+	uint32_t num_frames_sent{};
 
 	bool init(uxrSession* session_, uxrStreamId stream_id, uxrObjectId participant_id);
 	void update(uxrStreamId stream_id);
+
+private:
+	// Samples are packed into the same transport frame until it reaches the MTU
+	static constexpr uint32_t max_frame_size = UXR_CONFIG_SERIAL_TRANSPORT_MTU;
+	static constexpr uint32_t submessage_overhead = 12; ///< submessage + WRITE_DATA header and alignment
+
+	bool prepare(uxrStreamId stream_id, uxrObjectId data_writer, ucdrBuffer &ub, uint32_t topic_size);
+	void flush();
+
+	uint32_t frame_size{0};
 };
 
+bool SendTopicsSubs::prepare(uxrStreamId stream_id, uxrObjectId data_writer, ucdrBuffer &ub, uint32_t topic_size)
+{
+	if ((frame_size > 0) && (frame_size + topic_size + submessage_overhead > max_frame_size)) {
+		flush();
+	}
+
+	if (uxr_prepare_output_stream(session, stream_id, data_writer, &ub, topic_size) == UXR_INVALID_REQUEST_ID) {
+		return false;
+	}
+
+	frame_size += topic_size + submessage_overhead;
+	num_payload_sent += topic_size;
+	num_samples_sent++;
+	return true;
+}
+
+void SendTopicsSubs::flush()
+{
+	uxr_flash_output_streams(session);
+	frame_size = 0;
+	num_frames_sent++;
+}
+
 bool SendTopicsSubs::init(uxrSession* session_, uxrStreamId stream_id, uxrObjectId participant_id)
 {
 	session = session_;
@@ -116,15 +151,17 @@ void SendTopicsSubs::update(uxrStreamId stream_id)
 		if (@(topic)_sub.update(&data)) {
 			ucdrBuffer ub{};
 			uint32_t topic_size = ucdr_topic_size_@(send_base_types[idx])();
-			uxr_prepare_output_stream(session, stream_id, @(topic)_data_writer, &ub, topic_size);
-			ucdr_serialize_@(send_base_types[idx])(data, ub);
-			// TODO: fill up the MTU and then flush, which reduces the packet overhead
-			uxr_flash_output_streams(session);
-			num_payload_sent += topic_size;
+
+			if (prepare(stream_id, @(topic)_data_writer, ub, topic_size)) {
+				ucdr_serialize_@(send_base_types[idx])(data, ub);
+			}
 		}
 	}
 @[    end for]@
 
+	if (frame_size > 0) {
+		flush();
+	}
 }
 
 static void on_topic_update(uxrSession* session, uxrObjectId object_id,
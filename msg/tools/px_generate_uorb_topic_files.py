@@ -120,6 +120,58 @@ def get_topics(filename, msg_name):
     return result
 
 
+def get_nested_types(filename):
+    """
+    Get the (bare) names of the message types used as fields in a msg file
+    """
+    result = []
+    with open(filename, 'r') as ofile:
+        for each_line in ofile:
+            each_line = each_line.split('#')[0].strip()
+            if not each_line or '=' in each_line:
+                # empty, comment or constant
+                continue
+            msg_type = each_line.split()[0].split('[')[0].split('/')[-1]
+            if msg_type not in genmsg.msgs.PRIMITIVE_TYPES and msg_type not in result:
+                result.append(msg_type)
+    return result
+
+
+def get_nested_topics(msg_filenames):
+    """
+    Get the nested types of every topic (recursively, in depth-first order), as
+    {topic: [topic of nested type, ...]}. Only contains topics with nested types.
+    """
+    nested_types = {}
+    topics_of_msg = {}
+    for msg_filename in msg_filenames:
+        msg_name = os.path.basename(msg_filename).replace('.msg', '')
+        nested_types[msg_name] = get_nested_types(msg_filename)
+        topics_of_msg[msg_name] = get_topics(msg_filename, msg_name)
+
+    def add_nested(msg_name, result):
+        for nested_type in nested_types.get(msg_name, []):
+            if nested_type not in result:
+                result.append(nested_type)
+                add_nested(nested_type, result)
+        return result
+
+    nested_topics = {}
+    for msg_name in nested_types:
+        nested = add_nested(msg_name, [])
+        if not nested:
+            continue
+        for nested_type in nested:
+            # the logger (and ULog) refer to a nested type by the topic with the same name
+            if nested_type not in topics_of_msg.get(nested_type, []):
+                print("[ERROR] uORB topic files generator:\n\tget_nested_topics:\tno topic named " +
+                      nested_type + " (nested type in " + msg_name + ")")
+                exit(1)
+        for topic in topics_of_msg[msg_name]:
+            nested_topics[topic] = nested
+    return nested_topics
+
+
 def get_msgs_list(msgdir):
     """
     Makes list of msg files in the given directory
@@ -461,10 +513,14 @@ def generate_topics_list_file(msgdir, outputdir, template_filename, templatedir)
     # generate cpp file with topics list
     msgs = get_msgs_list(msgdir)
     topics = []
+    topic_msgs = {}
     for msg in msgs:
         msg_filename = os.path.join(msgdir, msg)
-        topics.extend(get_topics(msg_filename, msg))
-    tl_globals = {"msgs": msgs, "topics": topics}
+        msg_topics = get_topics(msg_filename, msg.replace('.msg', ''))
+        topics.extend(msg_topics)
+        topic_msgs.update({topic: msg.replace('.msg', '') for topic in msg_topics})
+    nested_topics = get_nested_topics([os.path.join(msgdir, msg) for msg in msgs])
+    tl_globals = {"msgs": msgs, "topics": topics, "topic_msgs": topic_msgs, "nested_topics": nested_topics}
     tl_template_file = os.path.join(templatedir, template_filename)
     tl_out_file = os.path.join(outputdir, template_filename.replace(".em", ""))
     generate_by_template(tl_out_file, tl_template_file, tl_globals)
@@ -474,17 +530,23 @@ def generate_topics_list_file_from_files(files, outputdir, template_filename, te
     # Get message file names ending with .msg only
     msg_filenames = [p for p in files if os.path.basename(p).endswith(".msg")]
 
-    # Get topics used in messages
+    # Get topics used in messages (and the message type of each topic)
     topics = []
+    topic_msgs = {}
     for msg_filename in msg_filenames:
         msg_name = os.path.basename(msg_filename).replace('.msg', '')
-        topics.extend(get_topics(msg_filename, msg_name))
+        msg_topics = get_topics(msg_filename, msg_name)
+        topics.extend(msg_topics)
+        topic_msgs.update({topic: msg_name for topic in msg_topics})
 
     # Get only the message file name for "msgs" component
     msg_basenames = [os.path.basename(p) for p in msg_filenames]
 
+    # Get the nested types of the topics (for the logger)
+    nested_topics = get_nested_topics(msg_filenames)
+
     # Set the Template dictionary settings
-    tl_globals = {"msgs": msg_basenames, "topics": topics}
+    tl_globals = {"msgs": msg_basenames, "topics": topics, "topic_msgs": topic_msgs, "nested_topics": nested_topics}
     tl_template_file = os.path.join(templatedir, template_filename)
     tl_out_file = os.path.join(outputdir, template_filename.replace(".em", ""))
     generate_by_template(tl_out_file, tl_template_file, tl_globals)
@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <px4_platform_common/arena.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+
+// allocations larger than a quarter chunk are taken from the heap directly, to limit the waste at the chunk end
+static constexpr size_t CHUNK_SIZE = 1024;
+
+pthread_mutex_t arena_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+uintptr_t chunk_next = 0;
+uintptr_t chunk_end = 0;
+
+uintptr_t pool_next = 0;
+uintptr_t pool_end = 0;
+
+px4_arena_usage arena_usage{};
+
+inline uintptr_t align_up(uintptr_t address, size_t alignment)
+{
+	return (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+}
+
+} // namespace
+
+void *px4_arena_alloc(size_t size, size_t alignment)
+{
+	if (alignment < alignof(max_align_t)) {
+		alignment = alignof(max_align_t);
+	}
+
+	void *ret = nullptr;
+
+	pthread_mutex_lock(&arena_mutex);
+
+	if (pool_next != 0) {
+		const uintptr_t address = align_up(pool_next, alignment);
+
+		if (address + size <= pool_end) {
+			pool_next = address + size;
+			arena_usage.pool_used += size;
+			ret = (void *)address;
+		}
+	}
+
+	if (ret == nullptr) {
+		if (size + alignment > CHUNK_SIZE / 4) {
+			// never freed, so the unaligned start can be dropped
+			const size_t reserve = size + alignment - 1;
+			void *block = malloc(reserve);
+
+			if (block) {
+				ret = (void *)align_up((uintptr_t)block, alignment);
+				arena_usage.reserved += reserve;
+			}
+
+		} else {
+			uintptr_t address = align_up(chunk_next, alignment);
+
+			if ((chunk_next == 0) || (address + size > chunk_end)) {
+				void *chunk = malloc(CHUNK_SIZE);
+
+				if (chunk) {
+					chunk_next = (uintptr_t)chunk;
+					chunk_end = chunk_next + CHUNK_SIZE;
+					address = align_up(chunk_next, alignment);
+					arena_usage.reserved += CHUNK_SIZE;
+					arena_usage.chunks++;
+
+				} else {
+					address = 0;
+				}
+			}
+
+			if (address != 0) {
+				chunk_next = address + size;
+				ret = (void *)address;
+			}
+		}
+	}
+
+	if (ret) {
+		arena_usage.used += size;
+		arena_usage.allocations++;
+	}
+
+	pthread_mutex_unlock(&arena_mutex);
+
+	if (ret) {
+		memset(ret, 0, size);
+	}
+
+	return ret;
+}
+
+void px4_arena_add_pool(void *pool, size_t size)
+{
+	pthread_mutex_lock(&arena_mutex);
+
+	if ((pool_next == 0) && (pool != nullptr)) {
+		pool_next = (uintptr_t)pool;
+		pool_end = pool_next + size;
+		arena_usage.pool_size = size;
+	}
+
+	pthread_mutex_unlock(&arena_mutex);
+}
+
+void px4_arena_get_usage(struct px4_arena_usage *usage)
+{
+	pthread_mutex_lock(&arena_mutex);
+	*usage = arena_usage;
+	pthread_mutex_unlock(&arena_mutex);
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <px4_platform_common/boot_timeline.h>
+#include <px4_platform_common/atomic.h>
+
+#include <stdio.h>
+
+namespace
+{
+
+struct BootTimelineEntry {
+	const char *name;
+	uint32_t start_us;
+	uint32_t duration_us;
+};
+
+BootTimelineEntry boot_timeline[BOOT_TIMELINE_MAX_ENTRIES] {};
+px4::atomic<int> boot_timeline_reserved{0};
+px4::atomic<int> boot_timeline_count{0};
+
+} // namespace
+
+void px4_boot_timeline_record(const char *name, hrt_abstime start, hrt_abstime end)
+{
+	if (boot_timeline_reserved.load() >= BOOT_TIMELINE_MAX_ENTRIES) {
+		return;
+	}
+
+	const int index = boot_timeline_reserved.fetch_add(1);
+
+	if (index < BOOT_TIMELINE_MAX_ENTRIES) {
+		boot_timeline[index].name = name;
+		boot_timeline[index].start_us = (uint32_t)start;
+		boot_timeline[index].duration_us = (uint32_t)(end - start);
+		boot_timeline_count.fetch_add(1);
+	}
+}
+
+bool px4_boot_timeline_format(int index, char *buffer, int buffer_length)
+{
+	// entries are only complete once counted (starts can happen concurrently)
+	if ((index < 0) || (index >= boot_timeline_count.load()) || (boot_timeline[index].name == nullptr)) {
+		return false;
+	}
+
+	const BootTimelineEntry &entry = boot_timeline[index];
+	snprintf(buffer, buffer_length, "%8.3f s %7.1f ms %s\n", (double)entry.start_us * 1e-6,
+		 (double)entry.duration_us * 1e-3, entry.name);
+	return true;
+}
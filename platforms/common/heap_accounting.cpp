@@ -0,0 +1,328 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <px4_platform_common/heap_accounting.h>
+
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+
+#include <px4_platform_common/tasks.h>
+
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__PX4_NUTTX)
+#include <malloc.h>
+#include <nuttx/irq.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace
+{
+
+static constexpr int MAX_MODULES = 64;
+static constexpr uint16_t HEADER_MAGIC = 0xa110;
+
+struct ModuleEntry {
+	const char *key; ///< the last tag pointer resolved to this entry (string literals only)
+	px4_heap_module_usage usage;
+};
+
+ModuleEntry modules[MAX_MODULES] {};
+int num_modules = 0;
+px4_heap_totals totals{};
+
+// prepended to every allocation, keeps the alignment guaranteed by malloc
+union AllocationHeader {
+	struct {
+		uint32_t size;
+		uint16_t module;
+		uint16_t magic;
+	} info;
+	max_align_t alignment;
+};
+
+#if defined(__PX4_NUTTX)
+// indexed like the NuttX pid hash table, so two running tasks never share an entry
+struct TaskTag {
+	pid_t pid;
+	const char *tag;
+};
+
+TaskTag task_tags[CONFIG_MAX_TASKS] {};
+
+inline const char *get_tag()
+{
+	const pid_t pid = getpid();
+	const TaskTag &task_tag = task_tags[pid & (CONFIG_MAX_TASKS - 1)];
+	return (task_tag.pid == pid) ? task_tag.tag : nullptr;
+}
+
+inline void set_tag(const char *tag)
+{
+	const pid_t pid = getpid();
+	TaskTag &task_tag = task_tags[pid & (CONFIG_MAX_TASKS - 1)];
+	task_tag.pid = pid;
+	task_tag.tag = tag;
+}
+
+inline const char *task_name()
+{
+	return px4_get_taskname();
+}
+
+inline irqstate_t lock() { return enter_critical_section(); }
+inline void unlock(irqstate_t flags) { leave_critical_section(flags); }
+
+#else
+thread_local const char *thread_tag = nullptr;
+thread_local char thread_name[16] {};
+
+inline const char *get_tag() { return thread_tag; }
+inline void set_tag(const char *tag) { thread_tag = tag; }
+
+inline const char *task_name()
+{
+	// not px4_get_taskname(), it takes the task lock, which might be held by the caller of new
+	if (pthread_getname_np(pthread_self(), thread_name, sizeof(thread_name)) != 0 || thread_name[0] == '\0') {
+		return "unknown";
+	}
+
+	return thread_name;
+}
+
+pthread_mutex_t accounting_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+inline int lock() { pthread_mutex_lock(&accounting_mutex); return 0; }
+inline void unlock(int) { pthread_mutex_unlock(&accounting_mutex); }
+#endif
+
+// requires the lock
+int find_module(const char *name, bool stable_name)
+{
+	if (stable_name) {
+		for (int i = 0; i < num_modules; i++) {
+			if (modules[i].key == name) {
+				return i;
+			}
+		}
+	}
+
+	for (int i = 0; i < num_modules; i++) {
+		if (strncmp(modules[i].usage.name, name, PX4_HEAP_TAG_NAME_LEN - 1) == 0) {
+			if (stable_name) {
+				modules[i].key = name;
+			}
+
+			return i;
+		}
+	}
+
+	if (num_modules == MAX_MODULES) {
+		// everything else
+		return MAX_MODULES - 1;
+	}
+
+	ModuleEntry &entry = modules[num_modules];
+	entry.key = stable_name ? name : nullptr;
+	strncpy(entry.usage.name, (num_modules == MAX_MODULES - 1) ? "other" : name, PX4_HEAP_TAG_NAME_LEN - 1);
+
+	return num_modules++;
+}
+
+void *allocate(size_t size)
+{
+	AllocationHeader *header = static_cast<AllocationHeader *>(malloc(sizeof(AllocationHeader) + size));
+
+	const char *tag = get_tag();
+	const bool stable_name = (tag != nullptr);
+
+	if (!stable_name) {
+		tag = task_name();
+	}
+
+	auto flags = lock();
+
+	if (header == nullptr) {
+		totals.failed_allocations++;
+		unlock(flags);
+		return nullptr;
+	}
+
+	const int module = find_module(tag, stable_name);
+
+	px4_heap_module_usage &usage = modules[module].usage;
+	usage.live_bytes += size;
+	usage.live_allocations++;
+	usage.allocations++;
+
+	if (usage.live_bytes > usage.peak_bytes) {
+		usage.peak_bytes = usage.live_bytes;
+	}
+
+	totals.live_bytes += size;
+	totals.allocations++;
+
+	if (totals.live_bytes > totals.peak_bytes) {
+		totals.peak_bytes = totals.live_bytes;
+	}
+
+	unlock(flags);
+
+	header->info.size = size;
+	header->info.module = module;
+	header->info.magic = HEADER_MAGIC;
+
+	return header + 1;
+}
+
+void deallocate(void *ptr)
+{
+	if (ptr == nullptr) {
+		return;
+	}
+
+	AllocationHeader *header = static_cast<AllocationHeader *>(ptr) - 1;
+
+	if (header->info.magic == HEADER_MAGIC) {
+		auto flags = lock();
+		px4_heap_module_usage &usage = modules[header->info.module].usage;
+		usage.live_bytes -= header->info.size;
+		usage.live_allocations--;
+		totals.live_bytes -= header->info.size;
+		unlock(flags);
+
+		// catch double frees
+		header->info.magic = 0;
+	}
+
+	free(header);
+}
+
+} // namespace
+
+const char *px4_heap_set_tag(const char *tag)
+{
+	const char *previous = get_tag();
+	set_tag(tag);
+	return previous;
+}
+
+bool px4_heap_get_module_usage(int index, struct px4_heap_module_usage *usage)
+{
+	auto flags = lock();
+	const bool valid = (index >= 0) && (index < num_modules);
+
+	if (valid) {
+		*usage = modules[index].usage;
+	}
+
+	unlock(flags);
+	return valid;
+}
+
+void px4_heap_get_totals(struct px4_heap_totals *heap_totals)
+{
+	auto flags = lock();
+	*heap_totals = totals;
+	unlock(flags);
+
+#if defined(__PX4_NUTTX)
+	struct mallinfo mem = mallinfo();
+	heap_totals->heap_free = mem.fordblks;
+	heap_totals->heap_largest_free = mem.mxordblk;
+	heap_totals->fragmentation = (mem.fordblks > 0) ? 1.f - (float)mem.mxordblk / (float)mem.fordblks : 0.f;
+#else
+	heap_totals->heap_free = 0;
+	heap_totals->heap_largest_free = 0;
+	heap_totals->fragmentation = -1.f;
+#endif
+}
+
+void px4_heap_reset_peak()
+{
+	auto flags = lock();
+
+	for (int i = 0; i < num_modules; i++) {
+		modules[i].usage.peak_bytes = modules[i].usage.live_bytes;
+	}
+
+	totals.peak_bytes = totals.live_bytes;
+	unlock(flags);
+}
+
+void *operator new (size_t size)
+{
+	return allocate(size);
+}
+
+void *operator new[](size_t size)
+{
+	return allocate(size);
+}
+
+void *operator new (size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+	return allocate(size);
+}
+
+void operator delete (void *ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete (void *ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+#endif // CONFIG_SYSTEMCMDS_MEM
@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file hrt_callout_queue_test.cpp
+ *
+ * Tests the HRT callout queue (pairing heap) against a sorted reference.
+ */
+
+#include <gtest/gtest.h>
+#include <px4_platform_common/hrt_callout_queue.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class HrtCalloutQueueTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		hrt_callout_queue_init(&_queue);
+
+		for (auto &call : _calls) {
+			hrt_call_init(&call);
+		}
+	}
+
+	// pop all entries, they must come out ordered by deadline
+	std::vector<hrt_abstime> drain()
+	{
+		std::vector<hrt_abstime> deadlines;
+		struct hrt_call *call;
+
+		while ((call = hrt_callout_queue_peek(&_queue)) != nullptr) {
+			hrt_callout_queue_remove(&_queue, call);
+			EXPECT_FALSE(hrt_callout_queue_contains(&_queue, call));
+			deadlines.push_back(call->deadline);
+		}
+
+		return deadlines;
+	}
+
+	struct hrt_callout_queue _queue {};
+	struct hrt_call _calls[64] {};
+};
+
+TEST_F(HrtCalloutQueueTest, Empty)
+{
+	EXPECT_EQ(hrt_callout_queue_peek(&_queue), nullptr);
+	EXPECT_FALSE(hrt_callout_queue_contains(&_queue, &_calls[0]));
+
+	// removing an entry that is not queued does nothing
+	hrt_callout_queue_remove(&_queue, &_calls[0]);
+	EXPECT_EQ(hrt_callout_queue_peek(&_queue), nullptr);
+}
+
+TEST_F(HrtCalloutQueueTest, InsertOrder)
+{
+	const hrt_abstime deadlines[] = {50, 10, 40, 10, 30, 20, 60, 5};
+
+	for (unsigned i = 0; i < sizeof(deadlines) / sizeof(deadlines[0]); i++) {
+		_calls[i].deadline = deadlines[i];
+		hrt_callout_queue_insert(&_queue, &_calls[i]);
+		EXPECT_TRUE(hrt_callout_queue_contains(&_queue, &_calls[i]));
+	}
+
+	EXPECT_EQ(hrt_callout_queue_peek(&_queue), &_calls[7]);
+
+	std::vector<hrt_abstime> expected(std::begin(deadlines), std::end(deadlines));
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(drain(), expected);
+}
+
+TEST_F(HrtCalloutQueueTest, RandomInsertRemove)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> deadline(0, 1000);
+	std::uniform_int_distribution<int> index(0, 63);
+
+	for (int iteration = 0; iteration < 10000; iteration++) {
+		struct hrt_call *call = &_calls[index(gen)];
+
+		if (hrt_callout_queue_contains(&_queue, call)) {
+			hrt_callout_queue_remove(&_queue, call);
+
+		} else {
+			call->deadline = deadline(gen);
+			hrt_callout_queue_insert(&_queue, call);
+		}
+
+		// the head always has the earliest deadline of all queued entries
+		struct hrt_call *head = hrt_callout_queue_peek(&_queue);
+
+		for (auto &c : _calls) {
+			if (hrt_callout_queue_contains(&_queue, &c)) {
+				ASSERT_NE(head, nullptr);
+				EXPECT_LE(head->deadline, c.deadline);
+			}
+		}
+
+		// periodically pop the head and re-insert it later (like a periodic callout)
+		if ((head != nullptr) && (iteration % 3 == 0)) {
+			hrt_callout_queue_remove(&_queue, head);
+			head->deadline += 100;
+			hrt_callout_queue_insert(&_queue, head);
+		}
+	}
+
+	std::vector<hrt_abstime> expected;
+
+	for (auto &c : _calls) {
+		if (hrt_callout_queue_contains(&_queue, &c)) {
+			expected.push_back(c.deadline);
+		}
+	}
+
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(drain(), expected);
+}
@@ -48,6 +48,29 @@
 static List<I2CSPIInstance *> i2c_spi_module_instances; ///< list of currently running instances
 static pthread_mutex_t i2c_spi_module_instances_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+static board_bus_types bus_option_to_type(I2CSPIBusOption bus_option)
+{
+	switch (bus_option) {
+	case I2CSPIBusOption::All:
+		return BOARD_INVALID_BUS;
+
+#if defined(CONFIG_I2C)
+
+	case I2CSPIBusOption::I2CInternal:
+	case I2CSPIBusOption::I2CExternal:
+		return BOARD_I2C_BUS;
+#endif // CONFIG_I2C
+
+#if defined(CONFIG_SPI)
+
+	case I2CSPIBusOption::SPIInternal:
+	case I2CSPIBusOption::SPIExternal:
+		return BOARD_SPI_BUS;
+#endif // CONFIG_SPI
+	}
+
+	return BOARD_INVALID_BUS;
+}
 
 I2CSPIDriverConfig::I2CSPIDriverConfig(const BusCLIArguments &cli, const BusInstanceIterator &iterator,
 				       const px4::wq_config_t &wq_config_)
@@ -66,6 +89,7 @@ I2CSPIDriverConfig::I2CSPIDriverConfig(const BusCLIArguments &cli, const BusInst
 	  spi_devid(iterator.devid()),
 #endif // CONFIG_SPI
 	  bus_device_index(iterator.busDeviceIndex()),
+	  bus_slot(iterator.busInstancesCount()),
 	  rotation(cli.rotation),
 	  quiet_start(cli.quiet_start),
 	  keep_running(cli.keep_running),
@@ -392,6 +416,19 @@ int BusInstanceIterator::runningInstancesCount() const
 	return num_instances;
 }
 
+int BusInstanceIterator::busInstancesCount() const
+{
+	int num_instances = 0;
+
+	for (const auto &modules : i2c_spi_module_instances) {
+		if ((bus_option_to_type(modules->_bus_option) == busType()) && (modules->_bus == bus())) {
+			++num_instances;
+		}
+	}
+
+	return num_instances;
+}
+
 I2CSPIInstance *BusInstanceIterator::instance() const
 {
 	if (_current_instance == i2c_spi_module_instances.end()) {
@@ -421,26 +458,7 @@ void BusInstanceIterator::addInstance(I2CSPIInstance *instance)
 
 board_bus_types BusInstanceIterator::busType() const
 {
-	switch (_bus_option) {
-	case I2CSPIBusOption::All:
-		return BOARD_INVALID_BUS;
-
-#if defined(CONFIG_I2C)
-
-	case I2CSPIBusOption::I2CInternal:
-	case I2CSPIBusOption::I2CExternal:
-		return BOARD_I2C_BUS;
-#endif // CONFIG_I2C
-
-#if defined(CONFIG_SPI)
-
-	case I2CSPIBusOption::SPIInternal:
-	case I2CSPIBusOption::SPIExternal:
-		return BOARD_SPI_BUS;
-#endif // CONFIG_SPI
-	}
-
-	return BOARD_INVALID_BUS;
+	return bus_option_to_type(_bus_option);
 }
 
 int BusInstanceIterator::bus() const
@@ -587,6 +605,30 @@ static void initializer_trampoline(void *argument)
 	data->instance = data->instantiate(data->config, data->runtime_instance);
 }
 
+/**
+ * One bus candidate of module_start(). The probe runs on the work queue of the bus, so the probes of
+ * candidates on different buses run concurrently, while the ones on the same bus are serialized by the queue.
+ */
+struct I2CSPIDriverProbe {
+	I2CSPIDriverProbe(const BusCLIArguments &cli, const BusInstanceIterator &iterator, const px4::wq_config_t &wq_config,
+			  I2CSPIDriverBase::instantiate_method instantiate, int runtime_instance)
+		: config(cli, iterator, wq_config),
+		  data{config, instantiate, runtime_instance},
+		  initializer(wq_config, initializer_trampoline, &data),
+		  devid(iterator.devid()),
+		  external(iterator.external()),
+		  external_bus_index(iterator.externalBusIndex())
+	{}
+
+	I2CSPIDriverConfig config;
+	I2CSPIDriverInitializing data;
+	px4::WorkItemSingleShot initializer;
+
+	uint32_t devid;
+	bool external;
+	int external_bus_index;
+};
+
 int I2CSPIDriverBase::module_start(const BusCLIArguments &cli, BusInstanceIterator &iterator,
 				   void(*print_usage)(), instantiate_method instantiate)
 {
@@ -596,102 +638,145 @@ int I2CSPIDriverBase::module_start(const BusCLIArguments &cli, BusInstanceIterat
 		return -1;
 	}
 
+	// number of bus candidates that are probed at the same time
+	static constexpr int MAX_PARALLEL_PROBES = 8;
+
 	bool started = false;
+	bool iterator_done = false;
 
-	while (iterator.next()) {
-		if (iterator.instance()) {
-			PX4_WARN("Already running on bus %i", iterator.bus());
-			continue;
-		}
+	while (!iterator_done) {
+		I2CSPIDriverProbe *probes[MAX_PARALLEL_PROBES] {};
+		int num_probes = 0;
+		const int running_instances = iterator.runningInstancesCount();
+
+		// collect the candidates of this batch
+		while (num_probes < MAX_PARALLEL_PROBES) {
+			if (!iterator.next()) {
+				iterator_done = true;
+				break;
+			}
 
+			if (iterator.instance()) {
+				PX4_WARN("Already running on bus %i", iterator.bus());
+				continue;
+			}
 
-		device::Device::DeviceId device_id{};
-		device_id.devid_s.bus = iterator.bus();
+			device::Device::DeviceId device_id{};
+			device_id.devid_s.bus = iterator.bus();
 
-		switch (iterator.busType()) {
+			switch (iterator.busType()) {
 #if defined(CONFIG_I2C)
 
-		case BOARD_I2C_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_I2C; break;
+			case BOARD_I2C_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_I2C; break;
 #endif // CONFIG_I2C
 
 #if defined(CONFIG_SPI)
 
-		case BOARD_SPI_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_SPI; break;
+			case BOARD_SPI_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_SPI; break;
 #endif // CONFIG_SPI
 
-		case BOARD_INVALID_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_UNKNOWN; break;
-		}
+			case BOARD_INVALID_BUS: device_id.devid_s.bus_type = device::Device::DeviceBusType_UNKNOWN; break;
+			}
 
+			const px4::wq_config_t &wq_config = px4::device_bus_to_wq(device_id.devid);
+			I2CSPIDriverProbe *probe = new I2CSPIDriverProbe(cli, iterator, wq_config, instantiate,
+					running_instances + num_probes);
 
-		const px4::wq_config_t &wq_config = px4::device_bus_to_wq(device_id.devid);
-		I2CSPIDriverConfig driver_config{cli, iterator, wq_config};
-		const int runtime_instance = iterator.runningInstancesCount();
-		I2CSPIDriverInitializing initializer_data{driver_config, instantiate, runtime_instance};
-		// initialize the object and bus on the work queue thread - this will also probe for the device
-		px4::WorkItemSingleShot initializer(wq_config, initializer_trampoline, &initializer_data);
-		initializer.ScheduleNow();
-		initializer.wait();
-		I2CSPIDriverBase *instance = initializer_data.instance;
+			if (probe == nullptr) {
+				PX4_ERR("alloc failed");
+				iterator_done = true;
+				break;
+			}
 
-		if (!instance) {
-			PX4_DEBUG("instantiate failed (no device on bus %i (devid 0x%x)?)", iterator.bus(), iterator.devid());
-			continue;
+			// the instances of this batch are not in the instance list yet
+			for (int i = 0; i < num_probes; i++) {
+				if (probes[i]->config.bus_type == probe->config.bus_type && probes[i]->config.bus == probe->config.bus) {
+					++probe->config.bus_slot;
+				}
+			}
+
+			probes[num_probes++] = probe;
 		}
 
-#if defined(CONFIG_I2C)
+		// initialize the objects and buses on the work queue threads - this will also probe for the devices
+		for (int i = 0; i < num_probes; i++) {
+			probes[i]->initializer.ScheduleNow();
+		}
 
-		if (cli.i2c_address != 0 && instance->_i2c_address == 0) {
-			PX4_ERR("Bug: driver %s does not pass the I2C address to I2CSPIDriverBase", instance->ItemName());
+		for (int i = 0; i < num_probes; i++) {
+			probes[i]->initializer.wait();
 		}
 
+		// register the started instances in iteration order
+		for (int i = 0; i < num_probes; i++) {
+			const I2CSPIDriverProbe &probe = *probes[i];
+			I2CSPIDriverBase *instance = probe.data.instance;
+
+			if (!instance) {
+				PX4_DEBUG("instantiate failed (no device on bus %i (devid 0x%x)?)", probe.config.bus, probe.devid);
+				continue;
+			}
+
+#if defined(CONFIG_I2C)
+
+			if (cli.i2c_address != 0 && instance->_i2c_address == 0) {
+				PX4_ERR("Bug: driver %s does not pass the I2C address to I2CSPIDriverBase", instance->ItemName());
+			}
+
 #endif // CONFIG_I2C
 
-		iterator.addInstance(instance);
-		started = true;
+			const int runtime_instance = iterator.runningInstancesCount();
+			iterator.addInstance(instance);
+			started = true;
 
-		// print some info that we are running
-		switch (iterator.busType()) {
+			// print some info that we are running
+			switch (probe.config.bus_type) {
 #if defined(CONFIG_I2C)
 
-		case BOARD_I2C_BUS:
-			PX4_INFO_RAW("%s #%i on I2C bus %d", instance->ItemName(), runtime_instance, iterator.bus());
+			case BOARD_I2C_BUS:
+				PX4_INFO_RAW("%s #%i on I2C bus %d", instance->ItemName(), runtime_instance, probe.config.bus);
 
-			if (iterator.external()) {
-				PX4_INFO_RAW(" (external)");
-			}
+				if (probe.external) {
+					PX4_INFO_RAW(" (external)");
+				}
 
-			if (cli.i2c_address != 0) {
-				PX4_INFO_RAW(" address 0x%X", cli.i2c_address);
-			}
+				if (cli.i2c_address != 0) {
+					PX4_INFO_RAW(" address 0x%X", cli.i2c_address);
+				}
 
-			if (cli.rotation != 0) {
-				PX4_INFO_RAW(" rotation %d", cli.rotation);
-			}
+				if (cli.rotation != 0) {
+					PX4_INFO_RAW(" rotation %d", cli.rotation);
+				}
 
-			PX4_INFO_RAW("\n");
+				PX4_INFO_RAW("\n");
 
-			break;
+				break;
 #endif // CONFIG_I2C
 #if defined(CONFIG_SPI)
 
-		case BOARD_SPI_BUS:
-			PX4_INFO_RAW("%s #%i on SPI bus %d", instance->ItemName(), runtime_instance, iterator.bus());
+			case BOARD_SPI_BUS:
+				PX4_INFO_RAW("%s #%i on SPI bus %d", instance->ItemName(), runtime_instance, probe.config.bus);
 
-			if (iterator.external()) {
-				PX4_INFO_RAW(" (external, equal to '-b %i')", iterator.externalBusIndex());
-			}
+				if (probe.external) {
+					PX4_INFO_RAW(" (external, equal to '-b %i')", probe.external_bus_index);
+				}
 
-			if (cli.rotation != 0) {
-				PX4_INFO_RAW(" rotation %d", cli.rotation);
-			}
+				if (cli.rotation != 0) {
+					PX4_INFO_RAW(" rotation %d", cli.rotation);
+				}
 
-			PX4_INFO_RAW("\n");
+				PX4_INFO_RAW("\n");
 
-			break;
+				break;
 #endif // CONFIG_SPI
 
-		case BOARD_INVALID_BUS:
-			break;
+			case BOARD_INVALID_BUS:
+				break;
+			}
+		}
+
+		for (int i = 0; i < num_probes; i++) {
+			delete probes[i];
 		}
 	}
 
@@ -747,6 +832,7 @@ int I2CSPIDriverBase::module_status(BusInstanceIterator &iterator)
 		if (iterator.instance()) {
 			I2CSPIDriverBase *instance = (I2CSPIDriverBase *)iterator.instance();
 			instance->print_status();
+			instance->print_bus_status();
 			is_running = true;
 		}
 	}
@@ -813,6 +899,43 @@ void I2CSPIDriverBase::print_status()
 #endif // CONFIG_SPI
 }
 
+void I2CSPIDriverBase::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
+{
+	// expected worst case duration of a single driver cycle on the bus
+	static constexpr uint32_t I2C_SLOT_US = 500;
+	static constexpr uint32_t SPI_SLOT_US = 100;
+
+	const uint32_t slot_us = (bus_option_to_type(_bus_option) == BOARD_I2C_BUS) ? I2C_SLOT_US : SPI_SLOT_US;
+
+	if (interval_us > 0) {
+		delay_us += (_bus_slot * slot_us) % interval_us;
+	}
+
+	ScheduledWorkItem::ScheduleOnInterval(interval_us, delay_us);
+}
+
+void I2CSPIDriverBase::print_bus_status() const
+{
+	// the instance list is locked by the BusInstanceIterator of module_status()
+	float utilization = 0.f;
+	int num_instances = 0;
+
+	for (const auto &modules : i2c_spi_module_instances) {
+		if ((bus_option_to_type(modules->_bus_option) == bus_option_to_type(_bus_option)) && (modules->_bus == _bus)) {
+			const I2CSPIDriverBase *driver = static_cast<const I2CSPIDriverBase *>(modules);
+			const float elapsed_us = driver->elapsed_time() * 1e6f;
+
+			if ((driver->_run_count > 1) && (elapsed_us > 0.f)) {
+				utilization += driver->run_statistics().run_time_total / elapsed_us;
+			}
+
+			num_instances++;
+		}
+	}
+
+	PX4_INFO("bus slot %i, bus utilization: %.1f%% (%i instances)", _bus_slot, (double)(utilization * 100.f), num_instances);
+}
+
 void I2CSPIDriverBase::request_stop_and_wait()
 {
 	_task_should_exit.store(true);
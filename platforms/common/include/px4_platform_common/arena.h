@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file arena.h
+ *
+ * Allocator for memory that is never freed, such as the uORB topic buffers.
+ * Small allocations are packed into larger chunks taken from the heap, so they do not
+ * leave holes between the allocations that are freed and reallocated at runtime.
+ * A statically allocated pool can be added, which is used first.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <px4_platform_common/defines.h>
+
+struct px4_arena_usage {
+	size_t used; ///< allocated from the arena [bytes]
+	size_t reserved; ///< taken from the heap [bytes]
+	uint32_t allocations;
+	uint32_t chunks;
+	size_t pool_size; ///< static pool [bytes]
+	size_t pool_used; ///< allocated from the static pool [bytes]
+};
+
+__BEGIN_DECLS
+
+/**
+ * Allocate memory that must never be freed.
+ * @param size number of bytes
+ * @param alignment power of 2, at least alignof(max_align_t) is used
+ * @return zero initialized memory, or nullptr if the heap is exhausted
+ */
+__EXPORT void *px4_arena_alloc(size_t size, size_t alignment);
+
+__EXPORT void px4_arena_get_usage(struct px4_arena_usage *usage);
+
+/**
+ * Add static memory to allocate from before taking memory from the heap (only one pool is supported).
+ * @param pool memory that is never used otherwise
+ * @param size pool size in bytes
+ */
+__EXPORT void px4_arena_add_pool(void *pool, size_t size);
+
+__END_DECLS
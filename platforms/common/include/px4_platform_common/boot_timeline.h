@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boot_timeline.h
+ * Records when modules and drivers were started and how long their start command blocked,
+ * so that the boot sequence can be analyzed from a log (the logger writes the entries as
+ * 'boot_timeline' info messages).
+ * Only the first BOOT_TIMELINE_MAX_ENTRIES starts are kept, which covers the boot scripts.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+
+#include <stdbool.h>
+
+#define BOOT_TIMELINE_MAX_ENTRIES 64
+
+__BEGIN_DECLS
+
+/**
+ * Add an entry
+ * @param name module or driver name, must be a static string (e.g. MODULE_NAME)
+ * @param start time when the start command was called
+ * @param end time when the start command returned
+ */
+__EXPORT void px4_boot_timeline_record(const char *name, hrt_abstime start, hrt_abstime end);
+
+/**
+ * Format an entry as human readable line
+ * @param index entry index, starting at 0
+ * @param buffer output buffer
+ * @param buffer_length output buffer length
+ * @return false if there is no entry with this index
+ */
+__EXPORT bool px4_boot_timeline_format(int index, char *buffer, int buffer_length);
+
+__END_DECLS
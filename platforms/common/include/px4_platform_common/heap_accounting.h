@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file heap_accounting.h
+ *
+ * Per module accounting of the C++ heap allocations (new/delete), enabled with CONFIG_SYSTEMCMDS_MEM.
+ * Allocations are attributed to the tag of the calling thread: the module name while a ModuleBase
+ * command or module task runs, the WorkItem name while a work item runs, and the task name otherwise.
+ * Frees are accounted to the module that made the allocation.
+ * Without CONFIG_SYSTEMCMDS_MEM the tag scopes compile to nothing.
+ */
+
+#pragma once
+
+#include <px4_boardconfig.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+
+#include <px4_platform_common/defines.h>
+
+#define PX4_HEAP_TAG_NAME_LEN 24
+
+struct px4_heap_module_usage {
+	char name[PX4_HEAP_TAG_NAME_LEN];
+	uint32_t live_bytes; ///< currently allocated bytes (requested sizes)
+	uint32_t live_allocations; ///< currently allocated blocks
+	uint32_t peak_bytes; ///< maximum of live_bytes
+	uint32_t allocations; ///< total number of allocations
+};
+
+struct px4_heap_totals {
+	uint32_t live_bytes; ///< sum over all modules
+	uint32_t peak_bytes; ///< maximum of the sum over all modules
+	uint32_t allocations;
+	uint32_t failed_allocations;
+	uint32_t heap_free; ///< free heap [bytes] (0 if unknown)
+	uint32_t heap_largest_free; ///< largest free block [bytes] (0 if unknown)
+	float fragmentation; ///< 1 - largest free block / free heap, -1 if unknown
+};
+
+__BEGIN_DECLS
+
+/**
+ * Set the tag of the calling thread. The string must stay valid until the tag is changed again.
+ * @param tag module name, or nullptr to attribute allocations to the task name
+ * @return the previous tag
+ */
+__EXPORT const char *px4_heap_set_tag(const char *tag);
+
+/**
+ * Get the usage of a module.
+ * @param index module index, starting at 0
+ * @return false if there is no module with this index
+ */
+__EXPORT bool px4_heap_get_module_usage(int index, struct px4_heap_module_usage *usage);
+
+__EXPORT void px4_heap_get_totals(struct px4_heap_totals *totals);
+
+/**
+ * Reset the peak usage of all modules and the total.
+ */
+__EXPORT void px4_heap_reset_peak(void);
+
+__END_DECLS
+
+#if defined(__cplusplus)
+namespace px4
+{
+
+class HeapTagScope
+{
+public:
+	explicit HeapTagScope(const char *tag) : _previous(px4_heap_set_tag(tag)) {}
+	~HeapTagScope() { px4_heap_set_tag(_previous); }
+
+	HeapTagScope(const HeapTagScope &) = delete;
+	HeapTagScope &operator=(const HeapTagScope &) = delete;
+
+private:
+	const char *_previous;
+};
+
+} // namespace px4
+
+#define PX4_HEAP_TAG_SCOPE(tag) px4::HeapTagScope _px4_heap_tag_scope(tag)
+#endif // __cplusplus
+
+#else
+
+#define PX4_HEAP_TAG_SCOPE(tag)
+
+#endif // CONFIG_SYSTEMCMDS_MEM
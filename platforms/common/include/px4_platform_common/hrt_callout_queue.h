@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file hrt_callout_queue.h
+ *
+ * Callout queue of the HRT implementations, ordered by deadline.
+ *
+ * This is an intrusive pairing heap (links in struct hrt_call): insertion and
+ * peeking the next deadline are O(1), removing the head or any other entry is
+ * O(log n) amortized. It needs no allocation and no recursion, so it can be
+ * used from the timer interrupt. All functions must be called with the HRT
+ * lock held (interrupts disabled on NuttX).
+ *
+ * The links of an entry must be zero initialised before it is used the first
+ * time (static storage, {} or hrt_call_init()), they are kept zero while the
+ * entry is not queued.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <drivers/drv_hrt.h>
+
+struct hrt_callout_queue {
+	struct hrt_call *head;
+};
+
+/**
+ * Meld two heaps, both roots must not have siblings.
+ * @return the new root
+ */
+static inline struct hrt_call *hrt_callout_queue_meld(struct hrt_call *a, struct hrt_call *b)
+{
+	if (a == NULL) {
+		return b;
+	}
+
+	if (b == NULL) {
+		return a;
+	}
+
+	// on equal deadlines the existing root stays first
+	if (b->deadline < a->deadline) {
+		struct hrt_call *tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	// b becomes the leftmost child of a
+	b->sibling = a->child;
+
+	if (a->child != NULL) {
+		a->child->prev = b;
+	}
+
+	b->prev = a;
+	a->child = b;
+
+	return a;
+}
+
+/**
+ * Combine a list of siblings into one heap (two pass pairing, iterative).
+ * @return the new root
+ */
+static inline struct hrt_call *hrt_callout_queue_merge_pairs(struct hrt_call *first)
+{
+	// first pass: meld pairs from left to right, collect the results in reverse order
+	struct hrt_call *pairs = NULL;
+
+	while (first != NULL) {
+		struct hrt_call *a = first;
+		struct hrt_call *b = a->sibling;
+		first = (b != NULL) ? b->sibling : NULL;
+
+		a->sibling = NULL;
+		a->prev = NULL;
+
+		if (b != NULL) {
+			b->sibling = NULL;
+			b->prev = NULL;
+		}
+
+		a = hrt_callout_queue_meld(a, b);
+		a->sibling = pairs;
+		pairs = a;
+	}
+
+	// second pass: meld the pairs from right to left
+	struct hrt_call *root = NULL;
+
+	while (pairs != NULL) {
+		struct hrt_call *next = pairs->sibling;
+		pairs->sibling = NULL;
+		root = hrt_callout_queue_meld(root, pairs);
+		pairs = next;
+	}
+
+	return root;
+}
+
+static inline void hrt_callout_queue_init(struct hrt_callout_queue *queue)
+{
+	queue->head = NULL;
+}
+
+/**
+ * Entry with the earliest deadline, NULL if the queue is empty.
+ */
+static inline struct hrt_call *hrt_callout_queue_peek(const struct hrt_callout_queue *queue)
+{
+	return queue->head;
+}
+
+static inline bool hrt_callout_queue_contains(const struct hrt_callout_queue *queue, const struct hrt_call *entry)
+{
+	return (entry == queue->head) || (entry->prev != NULL);
+}
+
+/**
+ * Queue an entry (which must not be queued already) by its deadline.
+ */
+static inline void hrt_callout_queue_insert(struct hrt_callout_queue *queue, struct hrt_call *entry)
+{
+	entry->child = NULL;
+	entry->sibling = NULL;
+	entry->prev = NULL;
+	queue->head = hrt_callout_queue_meld(queue->head, entry);
+}
+
+/**
+ * Remove an entry, does nothing if it is not queued.
+ */
+static inline void hrt_callout_queue_remove(struct hrt_callout_queue *queue, struct hrt_call *entry)
+{
+	if (entry == queue->head) {
+		queue->head = hrt_callout_queue_merge_pairs(entry->child);
+
+	} else if (entry->prev != NULL) {
+		// unlink the subtree of entry and add its children back to the heap
+		if (entry->prev->child == entry) {
+			entry->prev->child = entry->sibling;
+
+		} else {
+			entry->prev->sibling = entry->sibling;
+		}
+
+		if (entry->sibling != NULL) {
+			entry->sibling->prev = entry->prev;
+		}
+
+		queue->head = hrt_callout_queue_meld(queue->head, hrt_callout_queue_merge_pairs(entry->child));
+
+	} else {
+		return;
+	}
+
+	entry->child = NULL;
+	entry->sibling = NULL;
+	entry->prev = NULL;
+}
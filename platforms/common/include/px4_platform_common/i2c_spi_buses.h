@@ -40,6 +40,7 @@
 #include <containers/List.hpp>
 #include <lib/conversion/rotation.h>
 #include <px4_platform_common/atomic.h>
+#include <px4_platform_common/boot_timeline.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <px4_platform_common/sem.h>
@@ -90,6 +91,7 @@ struct I2CSPIDriverConfig {
 	uint32_t spi_devid;
 #endif // CONFIG_SPI
 	int bus_device_index;
+	int bus_slot; ///< index of the instance among the instances on the same bus (see I2CSPIDriverBase::ScheduleOnInterval())
 
 	Rotation rotation;
 
@@ -230,6 +232,11 @@ public:
 
 	int runningInstancesCount() const;
 
+	/**
+	 * @return number of running instances (of any module) on the current bus
+	 */
+	int busInstancesCount() const;
+
 	bool next();
 
 	I2CSPIInstance *instance() const;
@@ -283,7 +290,7 @@ class I2CSPIDriverBase : public px4::ScheduledWorkItem, public I2CSPIInstance
 public:
 	I2CSPIDriverBase(const I2CSPIDriverConfig &config)
 		: ScheduledWorkItem(config.module_name, config.wq_config),
-		  I2CSPIInstance(config) {}
+		  I2CSPIInstance(config), _bus_slot(config.bus_slot) {}
 
 	static int module_stop(BusInstanceIterator &iterator);
 	static int module_status(BusInstanceIterator &iterator);
@@ -307,6 +314,14 @@ protected:
 
 	bool should_exit() const { return _task_should_exit.load(); }
 
+	/**
+	 * Schedule on a fixed interval like ScheduledWorkItem::ScheduleOnInterval(), but with the first run offset
+	 * by the bus slot of this instance. All drivers on a bus share the bus work queue, and this keeps periodic
+	 * drivers that start together (and run at the same or harmonic rates) from queueing up behind each other
+	 * every cycle.
+	 */
+	void ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0);
+
 	static int module_start(const BusCLIArguments &cli, BusInstanceIterator &iterator, void(*print_usage)(),
 				instantiate_method instantiate);
 
@@ -315,6 +330,13 @@ private:
 
 	void request_stop_and_wait();
 
+	/**
+	 * Print the share of time the bus work queue spent running the drivers on the bus of this instance.
+	 */
+	void print_bus_status() const;
+
+	const int _bus_slot;
+
 	px4::atomic_bool _task_should_exit{false};
 	px4::atomic_bool _task_exited{false};
 };
@@ -329,7 +351,10 @@ class I2CSPIDriver : public I2CSPIDriverBase
 public:
 	static int module_start(const BusCLIArguments &cli, BusInstanceIterator &iterator)
 	{
-		return I2CSPIDriverBase::module_start(cli, iterator, &T::print_usage, InstantiateHelper<T>::m);
+		const hrt_abstime start = hrt_absolute_time();
+		const int ret = I2CSPIDriverBase::module_start(cli, iterator, &T::print_usage, InstantiateHelper<T>::m);
+		px4_boot_timeline_record(MODULE_NAME, start, hrt_absolute_time());
+		return ret;
 	}
 
 protected:
@@ -42,6 +42,8 @@
 #include <stdbool.h>
 
 #include <px4_platform_common/atomic.h>
+#include <px4_platform_common/boot_timeline.h>
+#include <px4_platform_common/heap_accounting.h>
 #include <px4_platform_common/time.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
@@ -127,6 +129,8 @@ public:
 	 */
 	static int main(int argc, char *argv[])
 	{
+		PX4_HEAP_TAG_SCOPE(MODULE_NAME);
+
 		if (argc <= 1 ||
 		    strcmp(argv[1], "-h")    == 0 ||
 		    strcmp(argv[1], "help")  == 0 ||
@@ -167,6 +171,8 @@ public:
 	 */
 	static int run_trampoline(int argc, char *argv[])
 	{
+		PX4_HEAP_TAG_SCOPE(MODULE_NAME);
+
 		int ret = 0;
 
 		// We don't need the task name at this point.
@@ -206,7 +212,9 @@ public:
 			PX4_ERR("Task already running");
 
 		} else {
+			const hrt_abstime start = hrt_absolute_time();
 			ret = T::task_spawn(argc, argv);
+			px4_boot_timeline_record(MODULE_NAME, start, hrt_absolute_time());
 
 			if (ret < 0) {
 				PX4_ERR("Task start failed (%i)", ret);
@@ -83,18 +83,26 @@ protected:
 	 */
 	virtual void updateParams()
 	{
+		const uint32_t generation = param_change_generation();
+
 		for (const auto &child : _children) {
 			child->updateParams();
 		}
 
 		updateParamsImpl();
+
+		_params_generation = generation;
 	}
 
 	/**
-	 * @brief The implementation for this is generated with the macro DEFINE_PARAMETERS()
+	 * @brief The implementation for this is generated with the macro DEFINE_PARAMETERS().
+	 *        It only updates the parameters that changed since the last updateParams() call.
 	 */
 	virtual void updateParamsImpl() {}
 
+	/** parameter change generation the parameters were last updated at (@see param_changed_since()) */
+	uint32_t _params_generation{param_change_generation()};
+
 private:
 	/** @list _children The module parameter list of inheriting classes. */
 	List<ModuleParams *> _children;
@@ -60,7 +60,7 @@ inline static param_t param_handle(px4::params p)
 	do_not_explicitly_use_this_namespace::PAIR(x);
 
 #define _CALL_UPDATE(x) \
-	STRIP(x).update();
+	STRIP(x).update_if_changed(_params_generation);
 
 // define the parameter update method, which will update all parameters.
 // It is marked as 'final', so that wrong usages lead to a compile error (see below)
@@ -154,6 +154,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// Update the value if the parameter changed since a change generation (@see param_changed_since())
+	bool update_if_changed(uint32_t generation) { return param_changed_since(handle(), generation) && update(); }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	float _val;
@@ -206,6 +209,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// Update the value if the parameter changed since a change generation (@see param_changed_since())
+	bool update_if_changed(uint32_t generation) { return param_changed_since(handle(), generation) && update(); }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	float &_val;
@@ -256,6 +262,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// Update the value if the parameter changed since a change generation (@see param_changed_since())
+	bool update_if_changed(uint32_t generation) { return param_changed_since(handle(), generation) && update(); }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t _val;
@@ -308,6 +317,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// Update the value if the parameter changed since a change generation (@see param_changed_since())
+	bool update_if_changed(uint32_t generation) { return param_changed_since(handle(), generation) && update(); }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t &_val;
@@ -377,6 +389,9 @@ public:
 		return false;
 	}
 
+	/// Update the value if the parameter changed since a change generation (@see param_changed_since())
+	bool update_if_changed(uint32_t generation) { return param_changed_since(handle(), generation) && update(); }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	bool _val;
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "ScheduledWorkItem.hpp"
+
+#include <px4_platform_common/atomic.h>
+
+namespace px4
+{
+
+/**
+ * @class AsyncIoRequest
+ * Run a blocking operation (file access) on the low priority storage work queue, so that
+ * the caller does not stall on SD card or flash latency. All requests share the same queue,
+ * which serializes the file operations.
+ * Once the operation returned, the optional completion WorkItem is scheduled.
+ * Example usage (from a WorkItem):
+ *   AsyncIoRequest _save{"my_module_save", save_file, this, this};
+ *   _save.submit();
+ *   ...
+ *   void Run() { if (_save.completed()) { handle(_save.result()); } }
+ */
+class AsyncIoRequest : public px4::ScheduledWorkItem
+{
+public:
+	using io_method = int (*)(void *arg);
+
+	AsyncIoRequest(const char *name, io_method method, void *argument, px4::WorkItem *completion = nullptr);
+
+	~AsyncIoRequest() override = default;
+
+	AsyncIoRequest() = delete;
+
+	// no copy, assignment, move, move assignment
+	AsyncIoRequest(const AsyncIoRequest &) = delete;
+	AsyncIoRequest &operator=(const AsyncIoRequest &) = delete;
+	AsyncIoRequest(AsyncIoRequest &&) = delete;
+	AsyncIoRequest &operator=(AsyncIoRequest &&) = delete;
+
+	/**
+	 * Queue the operation, optionally after a delay.
+	 * Submitting from within the running operation queues it again (without completion of the current run).
+	 * @param delay_us delay in microseconds
+	 * @return false if the operation is already queued
+	 */
+	bool submit(uint32_t delay_us = 0);
+
+	/**
+	 * Cancel a queued operation that did not start yet.
+	 * @return true if the operation is not going to run
+	 */
+	bool cancel();
+
+	/** @return true while the operation is queued or running */
+	bool busy() const { const int state = _state.load(); return (state == STATE_QUEUED) || (state == STATE_RUNNING); }
+
+	/**
+	 * Check for (and acknowledge) the completion of the operation.
+	 * @return true once after each completed run, the return value is then available with result()
+	 */
+	bool completed();
+
+	int result() const { return _result; }
+
+private:
+	void Run() override;
+
+	enum : int {
+		STATE_IDLE = 0,
+		STATE_QUEUED,
+		STATE_RUNNING,
+		STATE_COMPLETED,
+	};
+
+	io_method _method;
+	void *_argument;
+	px4::WorkItem *_completion;
+
+	int _result{0};
+	px4::atomic<int> _state{STATE_IDLE};
+};
+
+} // namespace px4
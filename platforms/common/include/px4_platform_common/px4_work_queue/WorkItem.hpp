@@ -72,6 +72,22 @@ public:
 
 	virtual void print_run_status();
 
+	/**
+	 * Print the accumulated run statistics (execution time and schedule latency).
+	 */
+	void print_run_statistics() const;
+
+	struct RunStatistics {
+		uint64_t run_time_total{0};	///< accumulated execution time [us]
+		uint64_t latency_total{0};	///< accumulated delay from scheduling to execution start [us]
+		uint32_t run_count{0};		///< number of runs (not reset by print_run_status())
+		uint32_t run_time_max{0};	///< maximum execution time [us]
+		uint32_t latency_max{0};	///< maximum delay from scheduling to execution start [us]
+		uint32_t deadline_misses{0};	///< number of runs finishing after the deadline (see SetDeadline())
+	};
+
+	const RunStatistics &run_statistics() const { return _run_statistics; }
+
 	/**
 	 * Switch to a different WorkQueue.
 	 * NOTE: Caller is responsible for synchronization.
@@ -83,6 +99,17 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+	/**
+	 * Declare a deadline relative to scheduling (ScheduleNow, interval or uORB callback) by which
+	 * each run should be finished. Items with a deadline are run earliest deadline first ahead of
+	 * the other queued items of the same WorkQueue, and missed deadlines are counted.
+	 *
+	 * @param deadline_us The relative deadline in microseconds, 0 to disable.
+	 */
+	void SetDeadline(uint32_t deadline_us) { _deadline = deadline_us; }
+
+	uint32_t deadline() const { return _deadline; }
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -97,18 +124,45 @@ protected:
 	void ScheduleClear();
 protected:
 
-	void RunPreamble()
+	hrt_abstime RunPreamble()
 	{
+		const hrt_abstime now = hrt_absolute_time();
+
 		if (_run_count == 0) {
-			_time_first_run = hrt_absolute_time();
+			_time_first_run = now;
 			_run_count = 1;
 
 		} else {
 			_run_count++;
 		}
+
+		const uint32_t latency = (now > _time_scheduled) ? (now - _time_scheduled) : 0;
+		_run_statistics.latency_total += latency;
+		_run_statistics.latency_max = math::max(_run_statistics.latency_max, latency);
+		_run_statistics.run_count++;
+
+		return now;
+	}
+
+	/**
+	 * @return true if the run missed its deadline
+	 */
+	bool RunPostamble(const hrt_abstime &time_started, const hrt_abstime &time_deadline)
+	{
+		const hrt_abstime now = hrt_absolute_time();
+		const uint32_t run_time = now - time_started;
+		_run_statistics.run_time_total += run_time;
+		_run_statistics.run_time_max = math::max(_run_statistics.run_time_max, run_time);
+
+		if ((time_deadline != 0) && (now > time_deadline)) {
+			_run_statistics.deadline_misses++;
+			return true;
+		}
+
+		return false;
 	}
 
-	friend void WorkQueue::Run();
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -134,6 +188,11 @@ private:
 
 	WorkQueue	*_wq{nullptr};
 
+	hrt_abstime	_time_scheduled{0};	///< time the item was last added to the runnable queue
+	hrt_abstime	_time_deadline{0};	///< absolute deadline of the queued run (0 if none)
+	uint32_t	_deadline{0};		///< relative deadline [us] (0 if none)
+	RunStatistics	_run_statistics{};
+
 };
 
 } // namespace px4
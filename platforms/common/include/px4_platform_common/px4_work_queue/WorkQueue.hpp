@@ -38,6 +38,7 @@
 #include <containers/BlockingList.hpp>
 #include <containers/List.hpp>
 #include <containers/IntrusiveQueue.hpp>
+#include <lib/perf/perf_counter.h>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/sem.h>
@@ -71,7 +72,12 @@ public:
 
 	void request_stop() { _should_exit.store(true); }
 
-	void print_status(bool last = false);
+	void print_status(bool last = false, bool verbose = false);
+
+	/**
+	 * Call cb for every WorkItem attached to this queue (with the item list locked).
+	 */
+	void foreach_item(void (*cb)(const WorkQueue &wq, const WorkItem &item, void *arg), void *arg);
 
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
@@ -80,6 +86,12 @@ private:
 
 	bool should_exit() const { return _should_exit.load(); }
 
+	/**
+	 * Remove the next item to run from the queue (requires work_lock): the item
+	 * with the earliest deadline, or the front of the queue if none has a deadline.
+	 */
+	WorkItem *PopNext();
+
 	inline void SignalWorkerThread();
 
 #ifdef __PX4_NUTTX
@@ -100,6 +112,10 @@ private:
 	const wq_config_t		&_config;
 	BlockingList<WorkItem *>	_work_items;
 	px4::atomic_bool		_should_exit{false};
+	WorkItem			*_running_item{nullptr};
+
+	char				_deadline_miss_perf_name[40] {};
+	perf_counter_t			_deadline_miss_perf{nullptr};
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	int _lockstep_component {-1};
@@ -39,11 +39,13 @@ namespace px4
 {
 
 class WorkQueue; // forward declaration
+class WorkItem; // forward declaration
 
 struct wq_config_t {
 	const char *name;
 	uint16_t stacksize;
 	int8_t relative_priority; // relative to max
+	uint32_t cpu_affinity{0}; // CPU affinity mask (bit n: CPU n), 0: no affinity (POSIX only, see BOARD_WQ_CPU_AFFINITY)
 };
 
 namespace wq_configurations
@@ -91,6 +93,8 @@ static constexpr wq_config_t ttyUnknown{"wq:ttyUnknown", 1632, -32};
 
 static constexpr wq_config_t lp_default{"wq:lp_default", 1920, -50};
 
+static constexpr wq_config_t storage{"wq:storage", 2800, -60}; // blocking file I/O (AsyncIoRequest)
+
 static constexpr wq_config_t test1{"wq:test1", 2000, 0};
 static constexpr wq_config_t test2{"wq:test2", 2000, 0};
 
@@ -108,8 +112,16 @@ int WorkQueueManagerStop();
 
 /**
  * Work queue manager status.
+ *
+ * @param verbose		Also print the run statistics (execution time, latency) of every WorkItem.
+ */
+int WorkQueueManagerStatus(bool verbose = false);
+
+/**
+ * Call cb for every WorkItem of every running work queue.
+ * NOTE: cb is called with the work queue lists locked and must not attach or detach WorkItems.
  */
-int WorkQueueManagerStatus();
+void WorkQueueManagerForEachItem(void (*cb)(const WorkQueue &wq, const WorkItem &item, void *arg), void *arg);
 
 /**
  * Create (or find) a work queue with a particular configuration.
@@ -41,6 +41,8 @@
 
 #include <semaphore.h>
 
+#include <px4_platform_common/trace.h>
+
 #if !defined(__PX4_NUTTX)
 /* Values for protocol attribute */
 
@@ -91,9 +93,7 @@ __BEGIN_DECLS
 
 #define px4_sem_init		sem_init
 #define px4_sem_setprotocol	sem_setprotocol
-#define px4_sem_wait		sem_wait
 #define px4_sem_trywait		sem_trywait
-#define px4_sem_post		sem_post
 #define px4_sem_getvalue	sem_getvalue
 #define px4_sem_destroy		sem_destroy
 
@@ -103,6 +103,39 @@ __EXPORT int		px4_sem_timedwait(px4_sem_t *sem, const struct timespec *abstime);
 #define px4_sem_timedwait	sem_timedwait
 #endif
 
+#if defined(CONFIG_SYSTEMCMDS_TRACE)
+
+// trace blocking waits and the posts that wake a waiter
+static inline int px4_sem_wait_traced(px4_sem_t *s)
+{
+	if (sem_trywait(s) == 0) {
+		return 0;
+	}
+
+	PX4_TRACE(SEM_WAIT_BEGIN, s);
+	int ret = sem_wait(s);
+	PX4_TRACE(SEM_WAIT_END, s);
+	return ret;
+}
+
+static inline int px4_sem_post_traced(px4_sem_t *s)
+{
+	int value;
+
+	if (sem_getvalue(s, &value) == 0 && value < 0) {
+		PX4_TRACE(SEM_POST, s);
+	}
+
+	return sem_post(s);
+}
+
+#define px4_sem_wait		px4_sem_wait_traced
+#define px4_sem_post		px4_sem_post_traced
+#else
+#define px4_sem_wait		sem_wait
+#define px4_sem_post		sem_post
+#endif // CONFIG_SYSTEMCMDS_TRACE
+
 __END_DECLS
 
 #endif
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file trace.h
+ *
+ * Event tracing into a global ring buffer (ftrace-like), enabled with CONFIG_SYSTEMCMDS_TRACE.
+ * Recording is constant time and lock-free, the oldest entries are overwritten.
+ * The trace command starts and stops recording and writes the buffer as Chrome trace (JSON).
+ * Without CONFIG_SYSTEMCMDS_TRACE the trace points compile to nothing.
+ */
+
+#pragma once
+
+#include <px4_boardconfig.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(CONFIG_SYSTEMCMDS_TRACE)
+
+#include <px4_platform_common/defines.h>
+
+/**
+ * Trace events. The meaning of the object depends on the event.
+ */
+enum px4_trace_event {
+	PX4_TRACE_WORK_ITEM_SCHEDULE, ///< object: work item name
+	PX4_TRACE_WORK_ITEM_RUN_BEGIN, ///< object: work item name
+	PX4_TRACE_WORK_ITEM_RUN_END, ///< object: unused (the item might be gone)
+	PX4_TRACE_ORB_PUBLISH, ///< object: topic name
+	PX4_TRACE_SEM_WAIT_BEGIN, ///< object: semaphore, only recorded if the wait blocks
+	PX4_TRACE_SEM_WAIT_END, ///< object: semaphore
+	PX4_TRACE_SEM_POST, ///< object: semaphore, only recorded if there is a waiter
+	PX4_TRACE_HRT_BEGIN, ///< object: callout
+	PX4_TRACE_HRT_END, ///< object: unused
+
+	PX4_TRACE_EVENT_COUNT
+};
+
+struct px4_trace_entry {
+	uint64_t timestamp; ///< microseconds (monotonic clock on POSIX, not the lockstep time)
+	const void *object;
+	uint32_t tid; ///< task (NuttX) or thread (POSIX) id, 0 for the HRT
+	uint8_t event;
+};
+
+__BEGIN_DECLS
+
+__EXPORT extern bool px4_trace_enabled;
+
+__EXPORT void px4_trace_record_event(uint8_t event, const void *object);
+
+/**
+ * Enable or disable recording. Enabling clears the buffer.
+ */
+__EXPORT void px4_trace_enable(bool enable);
+
+/**
+ * Get a recorded entry, oldest first. Only consistent while recording is disabled.
+ * @param index entry index, starting at 0
+ * @return false if there is no entry with this index
+ */
+__EXPORT bool px4_trace_get(int index, struct px4_trace_entry *entry);
+
+/**
+ * Get the number of events that were overwritten since recording was enabled.
+ */
+__EXPORT uint32_t px4_trace_overwritten(void);
+
+__END_DECLS
+
+#define PX4_TRACE(event, object) \
+	do { \
+		if (px4_trace_enabled) { \
+			px4_trace_record_event(PX4_TRACE_##event, (const void *)(object)); \
+		} \
+	} while (0)
+
+#else
+
+#define PX4_TRACE(event, object) do {} while (0)
+
+#endif // CONFIG_SYSTEMCMDS_TRACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <px4_platform_common/px4_work_queue/AsyncIoRequest.hpp>
+
+namespace px4
+{
+
+AsyncIoRequest::AsyncIoRequest(const char *name, io_method method, void *argument, px4::WorkItem *completion)
+	: px4::ScheduledWorkItem(name, px4::wq_configurations::storage), _method(method), _argument(argument),
+	  _completion(completion)
+{
+}
+
+bool AsyncIoRequest::submit(uint32_t delay_us)
+{
+	int state = _state.load();
+
+	do {
+		if (state == STATE_QUEUED) {
+			return false;
+		}
+	} while (!_state.compare_exchange(&state, STATE_QUEUED));
+
+	if (delay_us > 0) {
+		ScheduleDelayed(delay_us);
+
+	} else {
+		ScheduleNow();
+	}
+
+	return true;
+}
+
+bool AsyncIoRequest::cancel()
+{
+	int expected = STATE_QUEUED;
+
+	if (_state.compare_exchange(&expected, STATE_IDLE)) {
+		// if already dequeued, Run() finds the request cancelled
+		ScheduleClear();
+		return true;
+	}
+
+	return expected != STATE_RUNNING;
+}
+
+bool AsyncIoRequest::completed()
+{
+	int expected = STATE_COMPLETED;
+	return _state.compare_exchange(&expected, STATE_IDLE);
+}
+
+void AsyncIoRequest::Run()
+{
+	int expected = STATE_QUEUED;
+
+	if (!_state.compare_exchange(&expected, STATE_RUNNING)) {
+		// cancelled
+		return;
+	}
+
+	_result = _method(_argument);
+
+	expected = STATE_RUNNING;
+
+	// not completed if the operation submitted itself again
+	if (_state.compare_exchange(&expected, STATE_COMPLETED) && (_completion != nullptr)) {
+		_completion->ScheduleNow();
+	}
+}
+
+} // namespace px4
@@ -140,4 +140,21 @@ void WorkItem::print_run_status()
 	_run_count = 0;
 }
 
+void WorkItem::print_run_statistics() const
+{
+	const RunStatistics stats = _run_statistics;
+
+	const uint32_t run_time_avg = (stats.run_count > 0) ? (stats.run_time_total / stats.run_count) : 0;
+	const uint32_t latency_avg = (stats.run_count > 0) ? (stats.latency_total / stats.run_count) : 0;
+
+	PX4_INFO_RAW("runs: %-10" PRIu32 " exec avg: %5" PRIu32 " max: %6" PRIu32 " us, latency avg: %5" PRIu32 " max: %6" PRIu32
+		     " us", stats.run_count, run_time_avg, stats.run_time_max, latency_avg, stats.latency_max);
+
+	if (_deadline != 0) {
+		PX4_INFO_RAW(", deadline: %" PRIu32 " us (%" PRIu32 " missed)", _deadline, stats.deadline_misses);
+	}
+
+	PX4_INFO_RAW("\n");
+}
+
 } // namespace px4
@@ -36,9 +36,11 @@
 
 #include <string.h>
 
+#include <px4_platform_common/heap_accounting.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
+#include <px4_platform_common/trace.h>
 #include <drivers/drv_hrt.h>
 
 namespace px4
@@ -63,6 +65,9 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 
 	px4_sem_init(&_exit_lock, 0, 1);
 	px4_sem_setprotocol(&_exit_lock, SEM_PRIO_NONE);
+
+	snprintf(_deadline_miss_perf_name, sizeof(_deadline_miss_perf_name), "%s: deadline miss", _config.name);
+	_deadline_miss_perf = perf_alloc(PC_COUNT, _deadline_miss_perf_name);
 }
 
 WorkQueue::~WorkQueue()
@@ -80,6 +85,8 @@ WorkQueue::~WorkQueue()
 #ifndef __PX4_NUTTX
 	px4_sem_destroy(&_qlock);
 #endif /* __PX4_NUTTX */
+
+	perf_free(_deadline_miss_perf);
 }
 
 bool WorkQueue::Attach(WorkItem *item)
@@ -105,6 +112,11 @@ void WorkQueue::Detach(WorkItem *item)
 
 	_work_items.remove(item);
 
+	if (_running_item == item) {
+		// item detached while running (e.g. deleted itself), skip the run statistics
+		_running_item = nullptr;
+	}
+
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
 		PX4_DEBUG("stopping: %s, last active WorkItem closing", _config.name);
@@ -138,10 +150,22 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
-	_q.push(item);
+	PX4_TRACE(WORK_ITEM_SCHEDULE, item->ItemName());
+
+	if (_q.push(item)) {
+		item->_time_scheduled = hrt_absolute_time();
+		item->_time_deadline = (item->_deadline != 0) ? (item->_time_scheduled + item->_deadline) : 0;
+	}
+
+	// While an item is running the worker drains the queue before it waits again, so chained items
+	// (e.g. rate controller -> allocator -> output driver on the same queue) run back-to-back without a wakeup.
+	const bool worker_busy = (_running_item != nullptr);
+
 	work_unlock();
 
-	SignalWorkerThread();
+	if (!worker_busy) {
+		SignalWorkerThread();
+	}
 }
 
 void WorkQueue::SignalWorkerThread()
@@ -171,6 +195,26 @@ void WorkQueue::Clear()
 	work_unlock();
 }
 
+WorkItem *WorkQueue::PopNext()
+{
+	WorkItem *next = _q.front();
+
+	// earliest deadline first, items without deadline in FIFO order
+	for (WorkItem *item : _q) {
+		if ((item->_time_deadline != 0)
+		    && ((next->_time_deadline == 0) || (item->_time_deadline < next->_time_deadline))) {
+			next = item;
+		}
+	}
+
+	if (next == _q.front()) {
+		return _q.pop();
+	}
+
+	_q.remove(next);
+	return next;
+}
+
 void WorkQueue::Run()
 {
 	while (!should_exit()) {
@@ -181,13 +225,32 @@ void WorkQueue::Run()
 
 		// process queued work
 		while (!_q.empty()) {
-			WorkItem *work = _q.pop();
+			WorkItem *work = PopNext();
+			const hrt_abstime time_deadline = work->_time_deadline;
+			_running_item = work;
 
 			work_unlock(); // unlock work queue to run (item may requeue itself)
-			work->RunPreamble();
+			const hrt_abstime time_started = work->RunPreamble();
+			PX4_TRACE(WORK_ITEM_RUN_BEGIN, work->ItemName());
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+			px4_heap_set_tag(work->ItemName());
+#endif // CONFIG_SYSTEMCMDS_MEM
 			work->Run();
 			// Note: after Run() we cannot access work anymore, as it might have been deleted
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+			px4_heap_set_tag(nullptr);
+#endif // CONFIG_SYSTEMCMDS_MEM
+			PX4_TRACE(WORK_ITEM_RUN_END, nullptr);
 			work_lock(); // re-lock
+
+			// still attached (cleared by Detach() otherwise)
+			if (_running_item != nullptr) {
+				if (_running_item->RunPostamble(time_started, time_deadline)) {
+					perf_count(_deadline_miss_perf);
+				}
+
+				_running_item = nullptr;
+			}
 		}
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
@@ -205,9 +268,12 @@ void WorkQueue::Run()
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
-void WorkQueue::print_status(bool last)
+void WorkQueue::print_status(bool last, bool verbose)
 {
 	const size_t num_items = _work_items.size();
+
+	LockGuard lg{_work_items.mutex()};
+
 	PX4_INFO_RAW("%-16s\n", get_name());
 	unsigned i = 0;
 
@@ -229,6 +295,21 @@ void WorkQueue::print_status(bool last)
 		}
 
 		item->print_run_status();
+
+		if (verbose) {
+			PX4_INFO_RAW(last ? "    " : "|   ");
+			PX4_INFO_RAW((i < num_items) ? "|       " : "        ");
+			item->print_run_statistics();
+		}
+	}
+}
+
+void WorkQueue::foreach_item(void (*cb)(const WorkQueue &wq, const WorkItem &item, void *arg), void *arg)
+{
+	LockGuard lg{_work_items.mutex()};
+
+	for (WorkItem *item : _work_items) {
+		cb(*this, *item, arg);
 	}
 }
 
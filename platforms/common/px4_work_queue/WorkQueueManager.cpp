@@ -36,6 +36,7 @@
 #include <px4_platform_common/px4_work_queue/WorkQueue.hpp>
 
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/tasks.h>
@@ -119,6 +120,31 @@ WorkQueueFindOrCreate(const wq_config_t &new_wq)
 	return wq;
 }
 
+/**
+ * CPU affinity of a work queue thread. Boards can override the default of any work queue
+ * by defining BOARD_WQ_CPU_AFFINITY in board_config.h as an initializer list of
+ * {name, mask} pairs, e.g. {{"wq:rate_ctrl", 0x1}, {"wq:INS0", 0x2}}
+ */
+static uint32_t
+WorkQueueCpuAffinity(const wq_config_t &wq)
+{
+#if defined(BOARD_WQ_CPU_AFFINITY)
+	static constexpr struct {
+		const char *name;
+		uint32_t cpu_affinity;
+	} board_affinity[] = BOARD_WQ_CPU_AFFINITY;
+
+	for (const auto &entry : board_affinity) {
+		if (strcmp(entry.name, wq.name) == 0) {
+			return entry.cpu_affinity;
+		}
+	}
+
+#endif // BOARD_WQ_CPU_AFFINITY
+
+	return wq.cpu_affinity;
+}
+
 const wq_config_t &
 device_bus_to_wq(uint32_t device_id_int)
 {
@@ -323,12 +349,38 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("setting sched params for %s failed (%i)", wq->name, ret_setschedparam);
 			}
 
+			// CPU affinity
+			const uint32_t cpu_affinity = WorkQueueCpuAffinity(*wq);
+
+			if (cpu_affinity != 0) {
+#if defined(__PX4_LINUX)
+				cpu_set_t cpuset;
+				CPU_ZERO(&cpuset);
+
+				for (unsigned cpu = 0; cpu < 32; cpu++) {
+					if (cpu_affinity & (1u << cpu)) {
+						CPU_SET(cpu, &cpuset);
+					}
+				}
+
+				int ret_setaffinity = pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+
+				if (ret_setaffinity != 0) {
+					PX4_ERR("setting CPU affinity 0x%" PRIx32 " for %s failed (%i)", cpu_affinity, wq->name, ret_setaffinity);
+				}
+
+#else
+				PX4_WARN("CPU affinity not supported, ignoring for %s", wq->name);
+#endif // __PX4_LINUX
+			}
+
 			// create thread
 			pthread_t thread;
 			int ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
 
 			if (ret_create == 0) {
-				PX4_DEBUG("starting: %s, priority: %d, stack: %zu bytes", wq->name, param.sched_priority, stacksize);
+				PX4_DEBUG("starting: %s, priority: %d, stack: %zu bytes, CPU affinity: 0x%" PRIx32, wq->name, param.sched_priority,
+					  stacksize, cpu_affinity);
 
 			} else {
 				PX4_ERR("failed to create thread for %s (%i): %s", wq->name, ret_create, strerror(ret_create));
@@ -450,7 +502,7 @@ WorkQueueManagerStop()
 }
 
 int
-WorkQueueManagerStatus()
+WorkQueueManagerStatus(bool verbose)
 {
 	if (!_wq_manager_should_exit.load() && (_wq_manager_wqs_list != nullptr)) {
 
@@ -472,7 +524,7 @@ WorkQueueManagerStatus()
 				PX4_INFO_RAW("\\__ %zu) ", i);
 			}
 
-			wq->print_status(last_wq);
+			wq->print_status(last_wq, verbose);
 		}
 
 	} else {
@@ -482,4 +534,16 @@ WorkQueueManagerStatus()
 	return PX4_OK;
 }
 
+void
+WorkQueueManagerForEachItem(void (*cb)(const WorkQueue &wq, const WorkItem &item, void *arg), void *arg)
+{
+	if (!_wq_manager_should_exit.load() && (_wq_manager_wqs_list != nullptr)) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			wq->foreach_item(cb, arg);
+		}
+	}
+}
+
 } // namespace px4
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <px4_platform_common/trace.h>
+
+#if defined(CONFIG_SYSTEMCMDS_TRACE)
+
+#include <px4_platform_common/atomic.h>
+
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__PX4_NUTTX)
+#include <drivers/drv_hrt.h>
+#include <nuttx/arch.h>
+#elif defined(__PX4_LINUX)
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#endif
+
+static constexpr uint32_t TRACE_BUFFER_SIZE = CONFIG_SYSTEMCMDS_TRACE_BUFFER_ENTRIES;
+static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0, "trace buffer size must be a power of 2");
+
+namespace
+{
+
+px4_trace_entry trace_buffer[TRACE_BUFFER_SIZE] {};
+px4::atomic<uint32_t> trace_head{0}; ///< total number of events since enabling (wraps in the buffer)
+
+inline uint64_t trace_time()
+{
+#if defined(__PX4_NUTTX)
+	return hrt_absolute_time();
+#else
+	// the real time, with lockstep the simulation time does not advance while the code runs
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+inline uint32_t trace_tid(uint8_t event)
+{
+	if (event == PX4_TRACE_HRT_BEGIN || event == PX4_TRACE_HRT_END) {
+		return 0;
+	}
+
+#if defined(__PX4_NUTTX)
+	return up_interrupt_context() ? 0 : getpid();
+#elif defined(__PX4_LINUX)
+	return (uint32_t)syscall(SYS_gettid);
+#else
+	return (uint32_t)(uintptr_t)pthread_self();
+#endif
+}
+
+} // namespace
+
+bool px4_trace_enabled = false;
+
+void px4_trace_record_event(uint8_t event, const void *object)
+{
+	// reserve a slot, concurrent writers (and interrupts) each get their own
+	const uint32_t index = trace_head.fetch_add(1);
+	px4_trace_entry &entry = trace_buffer[index & (TRACE_BUFFER_SIZE - 1)];
+
+	entry.timestamp = trace_time();
+	entry.object = object;
+	entry.tid = trace_tid(event);
+	entry.event = event;
+}
+
+void px4_trace_enable(bool enable)
+{
+	if (enable) {
+		trace_head.store(0);
+	}
+
+	__atomic_store_n(&px4_trace_enabled, enable, __ATOMIC_SEQ_CST);
+}
+
+bool px4_trace_get(int index, px4_trace_entry *entry)
+{
+	const uint32_t head = trace_head.load();
+	const uint32_t count = (head < TRACE_BUFFER_SIZE) ? head : TRACE_BUFFER_SIZE;
+
+	if (index < 0 || (uint32_t)index >= count) {
+		return false;
+	}
+
+	*entry = trace_buffer[(head - count + index) & (TRACE_BUFFER_SIZE - 1)];
+	return true;
+}
+
+uint32_t px4_trace_overwritten()
+{
+	const uint32_t head = trace_head.load();
+	return (head > TRACE_BUFFER_SIZE) ? head - TRACE_BUFFER_SIZE : 0;
+}
+
+#endif // CONFIG_SYSTEMCMDS_TRACE
@@ -76,6 +76,13 @@ public:
 
 	orb_id_t get_topic() const { return get_orb_meta(_orb_id); }
 
+	/**
+	 * Check if anyone would see a publication, eg to skip filling diagnostic messages.
+	 * Returns true until the topic is advertised, so that the first publish() advertises it
+	 * and subscribers can find it.
+	 */
+	bool has_subscribers() const { return !advertised() || Manager::orb_has_subscribers(_handle); }
+
 protected:
 
 	PublicationBase(ORB_ID id) : _orb_id(id) {}
@@ -131,6 +138,28 @@ public:
 
 		return (Manager::orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Loan the next queue slot to fill the struct in place (zero-copy publication).
+	 * Only use this for topics with a single publisher and call commit() once done.
+	 * @return pointer to the slot, nullptr if not available (fall back to publish()).
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(_handle));
+	}
+
+	/**
+	 * Publish the struct previously obtained with loan()
+	 */
+	bool commit()
+	{
+		return (Manager::orb_commit(get_topic(), _handle) == PX4_OK);
+	}
 };
 
 /**
@@ -92,6 +92,28 @@ public:
 		return (orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
 
+	/**
+	 * Loan the next queue slot to fill the struct in place (zero-copy publication).
+	 * Call commit() once done.
+	 * @return pointer to the slot, nullptr if not available (fall back to publish()).
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(_handle));
+	}
+
+	/**
+	 * Publish the struct previously obtained with loan()
+	 */
+	bool commit()
+	{
+		return (Manager::orb_commit(get_topic(), _handle) == PX4_OK);
+	}
+
 	int get_instance()
 	{
 		// advertise if not already advertised
@@ -171,6 +171,29 @@ public:
 		return valid() ? Manager::orb_data_copy(_node, dst, _last_generation, false) : false;
 	}
 
+	/**
+	 * Get a read-only view of the next update without copying
+	 * @return pointer to the new sample, nullptr if there is no update.
+	 *         The pointer must only be used until view_valid() has been checked.
+	 */
+	const void *view()
+	{
+		if (!valid()) {
+			subscribe();
+		}
+
+		return valid() ? Manager::orb_data_view(_node, _last_generation, true) : nullptr;
+	}
+
+	/**
+	 * Check that the sample returned by the last view() was not overwritten
+	 * by the publisher while it was being used.
+	 */
+	bool view_valid() const
+	{
+		return valid() && Manager::orb_data_view_valid(_node, _last_generation - 1);
+	}
+
 	/**
 	 * Change subscription instance
 	 * @param instance The new multi-Subscription instance
@@ -185,6 +208,7 @@ protected:
 
 	friend class SubscriptionCallback;
 	friend class SubscriptionCallbackWorkItem;
+	friend class SubscriptionQueue;
 
 	void *get_node() { return _node; }
 
@@ -160,17 +160,52 @@ public:
 
 	virtual ~SubscriptionCallbackWorkItem() = default;
 
+	using SubscriptionCallback::registerCallback;
+
+	/**
+	 * Register the callback and declare the WorkItem's run deadline (see WorkItem::SetDeadline()).
+	 *
+	 * @param deadline_us The deadline relative to the publication in microseconds.
+	 */
+	bool registerCallback(uint32_t deadline_us)
+	{
+		_work_item->SetDeadline(deadline_us);
+		return SubscriptionCallback::registerCallback();
+	}
+
 	void call() override
 	{
 		// schedule immediately if updated (queue depth or subscription interval)
 		if ((_required_updates == 0)
 		    || (Manager::updates_available(_subscription.get_node(), _subscription.get_last_generation()) >= _required_updates)) {
 			if (updated()) {
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+
+				if (_publication_time == 0) {
+					_publication_time = hrt_absolute_time();
+				}
+
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
 				_work_item->ScheduleNow();
 			}
 		}
 	}
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	// record the dispatch latency on the first read after a publication scheduled the work item
+	bool update(void *dst)
+	{
+		add_dispatch_latency();
+		return SubscriptionCallback::update(dst);
+	}
+
+	bool copy(void *dst)
+	{
+		add_dispatch_latency();
+		return SubscriptionCallback::copy(dst);
+	}
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 	/**
 	 * Optionally limit callback until more samples are available.
 	 *
@@ -183,6 +218,18 @@ public:
 	}
 
 private:
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	void add_dispatch_latency()
+	{
+		if (_publication_time != 0) {
+			Manager::orb_add_dispatch_latency(_subscription.get_node(), hrt_elapsed_time(&_publication_time));
+			_publication_time = 0;
+		}
+	}
+
+	hrt_abstime _publication_time{0};
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 	px4::WorkItem *_work_item;
 
 	uint8_t _required_updates{0};
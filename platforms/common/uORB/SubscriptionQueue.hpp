@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SubscriptionQueue.hpp
+ *
+ */
+
+#pragma once
+
+#include <uORB/SubscriptionCallback.hpp>
+#include <px4_platform_common/atomic.h>
+
+#include <string.h>
+
+namespace uORB
+{
+
+/**
+ * Subscription with a private bounded queue, which is filled on every publication.
+ * Only this subscriber pays for the queue depth, while the topic itself can keep a
+ * single element queue for the other readers. If the queue is full, new samples are
+ * dropped and counted (lost()).
+ * The queue is allocated by registerCallback(), read it with pop().
+ */
+class SubscriptionQueue : public SubscriptionCallback
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param depth The queue depth.
+	 * @param instance The instance for multi sub.
+	 * @param work_item Optional WorkItem to schedule on every queued sample.
+	 */
+	SubscriptionQueue(const orb_metadata *meta, uint8_t depth, uint8_t instance = 0, px4::WorkItem *work_item = nullptr) :
+		SubscriptionCallback(meta, 0, instance),	// interval 0
+		_work_item(work_item),
+		_depth(depth > 0 ? depth : 1)
+	{
+	}
+
+	~SubscriptionQueue() override
+	{
+		unregisterCallback();
+		delete[] _buffer;
+	}
+
+	bool registerCallback()
+	{
+		if (_buffer == nullptr) {
+			_buffer = new uint8_t[_depth * _subscription.get_topic()->o_size];
+
+			if (_buffer == nullptr) {
+				return false;
+			}
+		}
+
+		return SubscriptionCallback::registerCallback();
+	}
+
+	/**
+	 * Copy the oldest queued sample.
+	 * @param dst The destination pointer where the struct will be copied.
+	 * @return true if a sample was copied
+	 */
+	bool pop(void *dst)
+	{
+		const unsigned tail = _tail.load();
+
+		if (tail == _head.load()) {
+			return false;
+		}
+
+		const size_t size = _subscription.get_topic()->o_size;
+		memcpy(dst, &_buffer[(tail % _depth) * size], size);
+		_tail.store(next(tail));
+		return true;
+	}
+
+	/** @return number of queued samples */
+	unsigned queued() const { return (_head.load() + 2 * _depth - _tail.load()) % (2 * _depth); }
+
+	/** @return number of samples dropped because the queue was full */
+	uint32_t lost() const { return _lost.load(); }
+
+	uint8_t depth() const { return _depth; }
+
+	void call() override
+	{
+		// called by the publisher with the new sample in place (single producer, the consumer only moves the tail)
+		const unsigned head = _head.load();
+
+		if (queued() >= _depth) {
+			_lost.fetch_add(1);
+			return;
+		}
+
+		const void *data = Manager::orb_published_data(_subscription.get_node());
+
+		if (data == nullptr) {
+			return;
+		}
+
+		const size_t size = _subscription.get_topic()->o_size;
+		memcpy(&_buffer[(head % _depth) * size], data, size);
+		_head.store(next(head));
+
+		if (_work_item != nullptr) {
+			_work_item->ScheduleNow();
+		}
+	}
+
+private:
+	// indices run over twice the depth, so that a full queue can be told apart from an empty one
+	unsigned next(unsigned index) const { return (index + 1) % (2 * _depth); }
+
+	px4::WorkItem *_work_item;
+	const uint8_t _depth;
+
+	uint8_t *_buffer{nullptr};
+	px4::atomic<unsigned> _head{0};
+	px4::atomic<unsigned> _tail{0};
+	px4::atomic<uint32_t> _lost{0};
+};
+
+} // namespace uORB
@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SubscriptionReadySet.hpp
+ *
+ * Persistent wakeup set for task based modules waiting on multiple topics.
+ * Unlike px4_poll(), the subscriptions are registered once and the waiting task is
+ * signaled directly from the publication, there is no setup or teardown per wait.
+ */
+
+#pragma once
+
+#include "SubscriptionCallback.hpp"
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/sem.h>
+#include <px4_platform_common/time.h>
+
+namespace uORB
+{
+
+class ReadySet
+{
+public:
+	static constexpr int MAX_SUBSCRIPTIONS = 32;
+
+	ReadySet()
+	{
+		px4_sem_init(&_sem, 0, 0);
+		// _sem use case is a signal
+		px4_sem_setprotocol(&_sem, SEM_PRIO_NONE);
+	}
+
+	~ReadySet()
+	{
+		px4_sem_destroy(&_sem);
+	}
+
+	ReadySet(const ReadySet &) = delete;
+	ReadySet &operator=(const ReadySet &) = delete;
+
+	/**
+	 * Block until at least one subscription of the set was updated.
+	 * @param timeout_us The timeout in microseconds, or 0 to wait indefinitely.
+	 *
+	 * @return bitmask of the subscriptions that were signaled (see SubscriptionReady::ready_mask()), 0 on timeout
+	 */
+	uint32_t wait(uint32_t timeout_us = 0)
+	{
+		uint32_t ready = _ready.fetch_and(0);
+
+		if (ready != 0) {
+			return ready;
+		}
+
+		timespec ts{};
+
+		if (timeout_us > 0) {
+#if defined(__PX4_NUTTX)
+			px4_clock_gettime(CLOCK_REALTIME, &ts);
+#else
+			px4_clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+			const uint64_t nsecs = ts.tv_nsec + (uint64_t)timeout_us * 1000;
+			ts.tv_sec += nsecs / 1'000'000'000;
+			ts.tv_nsec = nsecs % 1'000'000'000;
+		}
+
+		while (true) {
+			const int ret = (timeout_us > 0) ? px4_sem_timedwait(&_sem, &ts) : px4_sem_wait(&_sem);
+
+			ready = _ready.fetch_and(0);
+
+			// a post can be left over from a signal that was already returned by the previous wait
+			if ((ready != 0) || (ret != 0)) {
+				return ready;
+			}
+		}
+	}
+
+	/**
+	 * Mark subscriptions as ready and wake up the waiting task.
+	 * Called from the publishing context.
+	 */
+	void signal(uint32_t mask)
+	{
+		if (_ready.fetch_or(mask) == 0) {
+			px4_sem_post(&_sem);
+		}
+	}
+
+private:
+	friend class SubscriptionReady;
+
+	uint32_t add()
+	{
+		if (_count < MAX_SUBSCRIPTIONS) {
+			return 1u << _count++;
+		}
+
+		PX4_ERR("ReadySet full");
+		return 0;
+	}
+
+	px4::atomic<uint32_t> _ready{0};
+	px4_sem_t _sem{};
+	uint8_t _count{0};
+};
+
+// Subscription that signals a ReadySet on new publications
+class SubscriptionReady : public SubscriptionCallback
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param ready_set The set to signal. It has to outlive the subscription.
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param interval_us The requested maximum update interval in microseconds.
+	 * @param instance The instance for multi sub.
+	 */
+	SubscriptionReady(ReadySet &ready_set, const orb_metadata *meta, uint32_t interval_us = 0, uint8_t instance = 0) :
+		SubscriptionCallback(meta, interval_us, instance),
+		_ready_set(ready_set),
+		_ready_mask(ready_set.add())
+	{
+		registerCallback();
+	}
+
+	virtual ~SubscriptionReady() = default;
+
+	void call() override
+	{
+		// signal immediately if no interval, otherwise only if interval has elapsed
+		if ((_interval_us == 0) || (hrt_elapsed_time(&_last_update) >= _interval_us)) {
+			_ready_set.signal(_ready_mask);
+		}
+	}
+
+	uint32_t ready_mask() const { return _ready_mask; }
+
+private:
+	ReadySet &_ready_set;
+	const uint32_t _ready_mask;
+};
+
+} // namespace uORB
@@ -112,6 +112,24 @@ int uorb_top(char **topic_filter, int num_filters)
 	return OK;
 }
 
+int uorb_latency_publish(void)
+{
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+#if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+	if (g_dev != nullptr) {
+		g_dev->publishLatencyStatistics();
+	}
+
+#else
+	boardctl(ORBIOCDEVMASTERCMD, ORB_DEVMASTER_LATENCY);
+#endif
+	return OK;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+}
+
 orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data)
 {
 	return uORB::Manager::get_instance()->orb_advertise(meta, data);
@@ -116,6 +116,7 @@ __BEGIN_DECLS
 int uorb_start(void);
 int uorb_status(void);
 int uorb_top(char **topic_filter, int num_filters);
+int uorb_latency_publish(void);
 
 /**
  * ORB topic advertiser handle.
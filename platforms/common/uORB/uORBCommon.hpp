@@ -40,6 +40,17 @@
 #include <drivers/drv_hrt.h>
 
 
+/*
+ * Single publisher (multi-instance) topics are published and read without taking the node lock.
+ * This needs twice the queue memory for these topics, so it's only used where the lock contention
+ * matters (multi-core POSIX targets).
+ */
+#if defined(__PX4_POSIX) && !defined(CONSTRAINED_MEMORY)
+#define ORB_LOCKLESS_PUBLICATION true
+#else
+#define ORB_LOCKLESS_PUBLICATION false
+#endif
+
 namespace uORB
 {
 static constexpr unsigned orb_maxpath = 64;
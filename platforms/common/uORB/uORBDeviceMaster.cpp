@@ -45,6 +45,10 @@
 
 #include <math.h>
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+#include <uORB/topics/uorb_latency.h>
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 #ifndef __PX4_QURT // QuRT has no poll()
 #include <poll.h>
 #endif // PX4_QURT
@@ -137,7 +141,7 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 						/* Set as advertised to avoid race conditions (otherwise 2 multi-instance advertisers
 						 * could get the same instance).
 						 */
-						existing_node->mark_as_advertised();
+						existing_node->mark_as_advertised(instance != nullptr);
 					}
 
 					ret = PX4_OK;
@@ -149,11 +153,12 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 
 		} else {
 			if (is_advertiser) {
-				node->mark_as_advertised();
+				node->mark_as_advertised(instance != nullptr);
 			}
 
 			// add to the node map.
 			_node_list.add(node);
+			addToTopicTable(node);
 			_node_exists[node->get_instance()].set((uint8_t)node->id(), true);
 		}
 
@@ -185,7 +190,7 @@ void uORB::DeviceMaster::printStatistics()
 		return;
 	}
 
-	PX4_INFO_RAW("%-*s INST #SUB #Q SIZE PATH\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+	PX4_INFO_RAW("%-*s INST #SUB #Q SIZE       #PUB PATH\n", (int)max_topic_name_length - 2, "TOPIC NAME");
 
 	cur_node = first_node;
 
@@ -273,9 +278,11 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 {
 	bool print_active_only = true;
 	bool only_once = false; // if true, run only once, then exit
+	bool show_latency = false;
 
 	if (topic_filter && num_filters > 0) {
 		bool show_all = false;
+		int num_topic_filters = 0;
 
 		for (int i = 0; i < num_filters; ++i) {
 			if (!strcmp("-a", topic_filter[i])) {
@@ -283,16 +290,28 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 			} else if (!strcmp("-1", topic_filter[i])) {
 				only_once = true;
+
+			} else if (!strcmp("-l", topic_filter[i])) {
+				show_latency = true;
+
+			} else {
+				topic_filter[num_topic_filters++] = topic_filter[i];
 			}
 		}
 
-		print_active_only = only_once ? (num_filters == 1) : false; // print non-active if -a or some filter given
+		print_active_only = !show_all && (num_topic_filters == 0); // print non-active if -a or some filter given
+		num_filters = show_all ? 0 : num_topic_filters;
+	}
 
-		if (show_all || print_active_only) {
-			num_filters = 0;
-		}
+#if !defined(CONFIG_UORB_LATENCY_STATISTICS)
+
+	if (show_latency) {
+		PX4_WARN("latency statistics not enabled (CONFIG_UORB_LATENCY_STATISTICS)");
+		show_latency = false;
 	}
 
+#endif /* !CONFIG_UORB_LATENCY_STATISTICS */
+
 	PX4_INFO_RAW("\033[2J\n"); //clear screen
 
 	lock();
@@ -388,16 +407,31 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 			PX4_INFO_RAW(CLEAR_LINE "update: 1s, topics: %i, total publications: %i, %.1f kB/s\n",
 				     num_topics, total_msgs, (double)(total_size / 1000.f));
-			PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #Q SIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+			PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #Q SIZE%s\n", (int)max_topic_name_length - 2, "TOPIC NAME",
+				     show_latency ? "  PUB P50  P99  MAX   CB P50  P99  MAX [us]" : "");
 			cur_node = first_node;
 
 			while (cur_node) {
 
 				if (!print_active_only || (cur_node->pub_msg_delta > 0 && cur_node->node->subscriber_count() > 0)) {
-					PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %2i %4i \n", (int)max_topic_name_length,
+					PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %2i %4i ", (int)max_topic_name_length,
 						     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
 						     (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
 						     cur_node->node->get_queue_size(), cur_node->node->get_meta()->o_size);
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+
+					if (show_latency) {
+						const LatencyHistogram &pub = cur_node->node->publish_latency();
+						const LatencyHistogram &cb = cur_node->node->dispatch_latency();
+						PX4_INFO_RAW("     %4" PRIu32 " %4" PRIu32 " %4" PRIu32 "      %4" PRIu32 " %4" PRIu32 " %4" PRIu32,
+							     pub.percentile(0.5f), pub.percentile(0.99f), pub.max(),
+							     cb.percentile(0.5f), cb.percentile(0.99f), cb.max());
+					}
+
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+					PX4_INFO_RAW("\n");
 				}
 
 				cur_node = cur_node->next;
@@ -435,6 +469,65 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 #undef CLEAR_LINE
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+void uORB::DeviceMaster::publishLatencyStatistics()
+{
+	if (_latency_pub == nullptr) {
+		// advertise without holding the lock (advertising takes it)
+		_latency_pub = orb_advertise_queue(ORB_ID(uorb_latency), nullptr, uorb_latency_s::ORB_QUEUE_LENGTH);
+
+		if (_latency_pub == nullptr) {
+			return;
+		}
+	}
+
+	static_assert(uorb_latency_s::HISTOGRAM_BINS == LatencyHistogram::BINS, "histogram size mismatch");
+
+	/* a DeviceNode is never deleted, so it's safe to continue from the previous one */
+	lock();
+	uORB::DeviceNode *node = (_latency_cursor != nullptr) ? _latency_cursor->getSortedSibling() : nullptr;
+	uORB::DeviceNode *const head = *_node_list.begin();
+	unlock();
+
+	if (node == nullptr) {
+		node = head;
+	}
+
+	int published = 0;
+	uORB::DeviceNode *const first = node;
+
+	while ((node != nullptr) && (published < uorb_latency_s::ORB_QUEUE_LENGTH)) {
+		const LatencyHistogram &pub = node->publish_latency();
+
+		if ((pub.count() > 0) && (node->id() != ORB_ID::uorb_latency)) {
+			const LatencyHistogram &cb = node->dispatch_latency();
+
+			uorb_latency_s report{};
+			report.orb_id = static_cast<uint16_t>(node->id());
+			report.instance = node->get_instance();
+			memcpy(report.publish_histogram, pub.bins(), sizeof(report.publish_histogram));
+			report.publish_max = pub.max();
+			memcpy(report.dispatch_histogram, cb.bins(), sizeof(report.dispatch_histogram));
+			report.dispatch_max = cb.max();
+			report.timestamp = hrt_absolute_time();
+			orb_publish(ORB_ID(uorb_latency), _latency_pub, &report);
+			published++;
+		}
+
+		_latency_cursor = node;
+		node = node->getSortedSibling();
+
+		if (node == nullptr) {
+			node = head;
+		}
+
+		if (node == first) {
+			break;
+		}
+	}
+}
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 {
 	lock();
@@ -453,11 +546,46 @@ uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
 {
-	for (uORB::DeviceNode *node : _node_list) {
-		if ((strcmp(node->get_name(), meta->o_name) == 0) && (node->get_instance() == instance)) {
-			return node;
-		}
+	return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
+}
+
+uORB::DeviceNode *uORB::DeviceMaster::findDeviceNode(ORB_ID id, const uint8_t instance) const
+{
+	if ((size_t)id >= ORB_TOPICS_COUNT) {
+		return nullptr;
+	}
+
+	uORB::DeviceNode *node = __atomic_load_n(&_topic_table[(size_t)id], __ATOMIC_ACQUIRE);
+
+	// sorted by instance
+	while (node != nullptr && node->get_instance() < instance) {
+		node = node->get_next_instance();
+	}
+
+	if (node != nullptr && node->get_instance() == instance) {
+		return node;
 	}
 
 	return nullptr;
 }
+
+void uORB::DeviceMaster::addToTopicTable(uORB::DeviceNode *node)
+{
+	uORB::DeviceNode **link = &_topic_table[(size_t)node->id()];
+
+	// inserting only needs the lock against other writers: the new node is linked before it becomes reachable
+	if (*link == nullptr || (*link)->get_instance() > node->get_instance()) {
+		node->set_next_instance(*link);
+		__atomic_store_n(link, node, __ATOMIC_RELEASE);
+		return;
+	}
+
+	uORB::DeviceNode *prev = *link;
+
+	while (prev->get_next_instance() != nullptr && prev->get_next_instance()->get_instance() < node->get_instance()) {
+		prev = prev->get_next_instance();
+	}
+
+	node->set_next_instance(prev->get_next_instance());
+	prev->set_next_instance(node);
+}
@@ -82,14 +82,9 @@ public:
 			return nullptr;
 		}
 
-		lock();
-		uORB::DeviceNode *node = getDeviceNodeLocked(meta, instance);
-		unlock();
-
-		//We can safely return the node that can be used by any thread, because
+		//No lock needed, the topic table is insert only and
 		//a DeviceNode never gets deleted.
-		return node;
-
+		return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
 	}
 
 	bool deviceNodeExists(ORB_ID id, const uint8_t instance)
@@ -111,10 +106,19 @@ public:
 	 * Exited when the user presses the enter key.
 	 * @param topic_filter list of topic filters: if set, each string can be a substring for topics to match.
 	 *        Or it can be '-a', which means to print all topics instead of only ones currently publishing with subscribers.
+	 *        '-l' additionally prints the publication and callback dispatch latencies (CONFIG_UORB_LATENCY_STATISTICS).
 	 * @param num_filters
 	 */
 	void showTop(char **topic_filter, int num_filters);
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	/**
+	 * Publish the latency statistics (uorb_latency) of the next topics with samples,
+	 * continuing round-robin from the last call.
+	 */
+	void publishLatencyStatistics();
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 private:
 	// Private constructor, uORB::Manager takes care of its creation
 	DeviceMaster();
@@ -139,7 +143,27 @@ private:
 	 */
 	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance);
 
+	/**
+	 * Find a node in the topic table, can be called without holding _lock.
+	 * @return node if exists, nullptr otherwise
+	 */
+	uORB::DeviceNode *findDeviceNode(ORB_ID id, const uint8_t instance) const;
+
+	/**
+	 * Add a new node to the topic table.
+	 * _lock must already be held when calling this.
+	 */
+	void addToTopicTable(uORB::DeviceNode *node);
+
 	IntrusiveSortedList<uORB::DeviceNode *> _node_list;
+
+	/* lowest instance node of each topic, the other instances are chained with DeviceNode::get_next_instance() */
+	uORB::DeviceNode *_topic_table[ORB_TOPICS_COUNT] {};
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	orb_advert_t _latency_pub{nullptr};
+	uORB::DeviceNode *_latency_cursor{nullptr}; ///< last node published by publishLatencyStatistics()
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
 	AtomicBitset<ORB_TOPICS_COUNT> _node_exists[ORB_MULTI_MAX_INSTANCES];
 
 	px4_sem_t	_lock; /**< lock to protect access to all class members (also for derived classes) */
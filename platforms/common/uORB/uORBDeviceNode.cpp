@@ -38,6 +38,9 @@
 
 #include "SubscriptionCallback.hpp"
 
+#include <px4_platform_common/arena.h>
+#include <px4_platform_common/trace.h>
+
 #ifdef ORB_COMMUNICATOR
 #include "uORBCommunicator.hpp"
 #endif /* ORB_COMMUNICATOR */
@@ -84,7 +87,13 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const uint8_t inst
 
 uORB::DeviceNode::~DeviceNode()
 {
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+	delete _shm_writer;
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
+#if defined(__KERNEL__)
 	free(_data);
+#endif // __KERNEL__ (otherwise the data is in the arena)
 
 	const char *devname = get_devname();
 
@@ -175,6 +184,79 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 *
 	 * Note that filp will usually be NULL.
 	 */
+	if (!allocate_data(ORB_LOCKLESS_PUBLICATION && _single_publisher)) {
+		return -ENOMEM;
+	}
+
+	/* If write size does not match, that is an error */
+	if (_meta->o_size != buflen) {
+		return -EIO;
+	}
+
+	PX4_TRACE(ORB_PUBLISH, _meta->o_name);
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	const hrt_abstime publish_start = hrt_absolute_time();
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+	if (_spare_slots && _single_publisher) {
+		/* lockless publication: nobody else writes the next slot */
+		memcpy(slot(_generation.load()), buffer, _meta->o_size);
+		publish_slot();
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+		_publish_latency.add(hrt_elapsed_time(&publish_start));
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+		return _meta->o_size;
+	}
+
+	/* Perform an atomic copy. */
+	ATOMIC_ENTER;
+
+	if (_spare_slots) {
+		/* fill the slot before incrementing the generation, lockless readers must not see partial data */
+		memcpy(slot(_generation.load()), buffer, _meta->o_size);
+		_generation.fetch_add(1);
+
+	} else {
+		/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
+		unsigned generation = _generation.fetch_add(1);
+
+		memcpy(slot(generation), buffer, _meta->o_size);
+	}
+
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+
+	if (_shm_writer != nullptr) {
+		_shm_writer->write(buffer);
+	}
+
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
+	// callbacks
+	for (auto item : _callbacks) {
+		item->call();
+	}
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	ATOMIC_LEAVE;
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	_publish_latency.add(hrt_elapsed_time(&publish_start));
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+	return _meta->o_size;
+}
+
+bool
+uORB::DeviceNode::allocate_data(bool spare_slots)
+{
 	if (nullptr == _data) {
 
 #ifdef __PX4_NUTTX
@@ -186,9 +268,32 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 
 			/* re-check size */
 			if (nullptr == _data) {
-				const size_t data_size = _meta->o_size * _queue_size;
+				_spare_slots = spare_slots;
+
+				const size_t data_size = _meta->o_size * slot_count();
+#if defined(__KERNEL__)
 				_data = (uint8_t *) px4_cache_aligned_alloc(data_size);
-				memset(_data, 0, data_size);
+
+				if (_data != nullptr) {
+					memset(_data, 0, data_size);
+				}
+
+#else
+				// nodes are never deleted, so the buffers are packed together instead of spread over the heap
+# if defined(PX4_ARCH_DCACHE_ALIGNMENT)
+				_data = (uint8_t *) px4_arena_alloc(data_size, PX4_ARCH_DCACHE_ALIGNMENT);
+# else
+				_data = (uint8_t *) px4_arena_alloc(data_size, 0);
+# endif
+#endif // __KERNEL__
+
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+
+				if (_data != nullptr) {
+					_shm_writer = SharedMemoryWriter::create(_meta, _instance);
+				}
+
+#endif /* CONFIG_UORB_SHARED_MEMORY */
 			}
 
 			unlock();
@@ -197,39 +302,125 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		}
 
 #endif /* __PX4_NUTTX */
+	}
 
-		/* failed or could not allocate */
-		if (nullptr == _data) {
-			return -ENOMEM;
-		}
+	/* failed or could not allocate */
+	return (nullptr != _data);
+}
+
+void *
+uORB::DeviceNode::loan()
+{
+	if (!allocate_data(true) || !_spare_slots) {
+		// already allocated without spare slots by a regular publication
+		return nullptr;
 	}
 
-	/* If write size does not match, that is an error */
-	if (_meta->o_size != buflen) {
-		return -EIO;
+	// single publisher: the next slot is only written by the owner of the loan
+	return slot(_generation.load());
+}
+
+bool
+uORB::DeviceNode::commit()
+{
+	if ((nullptr == _data) || !_spare_slots) {
+		return false;
 	}
 
-	/* Perform an atomic copy. */
-	ATOMIC_ENTER;
-	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
-	unsigned generation = _generation.fetch_add(1);
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	const hrt_abstime publish_start = hrt_absolute_time();
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
 
-	memcpy(_data + (_meta->o_size * (generation % _queue_size)), buffer, _meta->o_size);
+	publish_slot();
 
-	// callbacks
-	for (auto item : _callbacks) {
-		item->call();
-	}
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	_publish_latency.add(hrt_elapsed_time(&publish_start));
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
 
-	/* Mark at least one data has been published */
-	_data_valid = true;
+	return true;
+}
 
-	ATOMIC_LEAVE;
+void
+uORB::DeviceNode::publish_slot()
+{
+	if (_single_publisher) {
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+
+		// the slot is only written by this publisher
+		if (_shm_writer != nullptr) {
+			_shm_writer->write(slot(_generation.load()));
+		}
+
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
+		_generation.fetch_add(1);
+
+		/* Mark at least one data has been published */
+		_data_valid = true;
+
+		// callbacks, the lock is only needed to protect the list
+		if (!_callbacks.empty()) {
+			ATOMIC_ENTER;
+
+			for (auto item : _callbacks) {
+				item->call();
+			}
+
+			ATOMIC_LEAVE;
+		}
+
+	} else {
+		ATOMIC_ENTER;
+
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+
+		if (_shm_writer != nullptr) {
+			_shm_writer->write(slot(_generation.load()));
+		}
+
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
+		_generation.fetch_add(1);
+
+		// callbacks
+		for (auto item : _callbacks) {
+			item->call();
+		}
+
+		/* Mark at least one data has been published */
+		_data_valid = true;
+
+		ATOMIC_LEAVE;
+	}
 
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
+}
 
-	return _meta->o_size;
+const void *
+uORB::DeviceNode::view(unsigned &generation)
+{
+	if (nullptr == _data) {
+		return nullptr;
+	}
+
+	const void *data = nullptr;
+
+	if (_spare_slots) {
+		// publications never write into a readable slot, validity is checked with view_valid()
+		generation = next_generation(generation);
+		data = slot(generation);
+
+	} else {
+		ATOMIC_ENTER;
+		generation = next_generation(generation);
+		data = slot(generation);
+		ATOMIC_LEAVE;
+	}
+
+	++generation;
+
+	return data;
 }
 
 int
@@ -399,13 +590,30 @@ uORB::DeviceNode::print_statistics(int max_topic_length)
 	const uint8_t instance = get_instance();
 	const int8_t sub_count = subscriber_count();
 	const uint8_t queue_size = get_queue_size();
+	const unsigned publications = _generation.load();
 
 	unlock();
 
-	PX4_INFO_RAW("%-*s %2i %4i %2i %4i %s\n", max_topic_length, get_meta()->o_name, (int)instance, (int)sub_count,
-		     queue_size, get_meta()->o_size, get_devname());
+	PX4_INFO_RAW("%-*s %2i %4i %2i %4i %10u %s\n", max_topic_length, get_meta()->o_name, (int)instance, (int)sub_count,
+		     queue_size, get_meta()->o_size, publications, get_devname());
+
+	return true;
+}
+
+bool uORB::DeviceNode::has_subscribers() const
+{
+	if (_subscriber_count > 0) {
+		return true;
+	}
 
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+	// readers in other processes are not counted
 	return true;
+#elif defined(ORB_COMMUNICATOR)
+	return uORB::Manager::get_instance()->is_remote_subscriber_present(_meta->o_name);
+#else
+	return false;
+#endif
 }
 
 void uORB::DeviceNode::add_internal_subscriber()
@@ -476,6 +684,9 @@ int16_t uORB::DeviceNode::process_received_message(int32_t length, uint8_t *data
 		return PX4_ERROR;
 	}
 
+	// the remote side publishes as well
+	_single_publisher = false;
+
 	/* call the devnode write method with no file pointer */
 	ret = write(nullptr, (const char *)data, _meta->o_size);
 
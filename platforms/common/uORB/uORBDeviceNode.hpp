@@ -36,11 +36,22 @@
 #include "uORBCommon.hpp"
 #include "uORBDeviceMaster.hpp"
 
+#include <px4_platform_common/px4_config.h>
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+#include "uORBLatencyHistogram.hpp"
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+#include "uORBSharedMemory.hpp"
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
 #include <lib/cdev/CDev.hpp>
 
 #include <containers/IntrusiveSortedList.hpp>
 #include <containers/List.hpp>
 #include <px4_platform_common/atomic.h>
+#include <px4_platform_common/hot_section.h>
 
 namespace uORB
 {
@@ -108,7 +119,7 @@ public:
 	 * @return ssize_t
 	 *   The number of bytes that are written
 	 */
-	ssize_t write(cdev::file_t *filp, const char *buffer, size_t buflen) override;
+	PX4_HOT ssize_t write(cdev::file_t *filp, const char *buffer, size_t buflen) override;
 
 	/**
 	 * IOCTL control for the subscriber.
@@ -173,6 +184,18 @@ public:
 
 	void mark_as_advertised() { _advertised = true; }
 
+	/**
+	 * Mark as advertised by a new publisher.
+	 * A multi-instance advertiser that claims a free instance is its only publisher,
+	 * which allows lockless publications. Any further advertiser shares the instance.
+	 * @param multi_instance true if the advertiser requested a multi-instance
+	 */
+	void mark_as_advertised(bool multi_instance)
+	{
+		_single_publisher = multi_instance && !_advertised;
+		_advertised = true;
+	}
+
 	/**
 	 * Try to change the size of the queue. This can only be done as long as nobody published yet.
 	 * This is the case, for example when orb_subscribe was called before an orb_advertise.
@@ -193,6 +216,17 @@ public:
 
 	int8_t subscriber_count() const { return _subscriber_count; }
 
+	/**
+	 * The latest sample, only stable while the callbacks are called by the publisher.
+	 */
+	const void *published_data() const { return (_data != nullptr) ? slot(_generation.load() - 1) : nullptr; }
+
+	/**
+	 * Check if the published data is seen by anyone: local subscribers,
+	 * remote subscribers (communicator) or other processes (shared memory).
+	 */
+	bool has_subscribers() const;
+
 	/**
 	 * Returns the number of updated data relative to the parameter 'generation'
 	 * We can get the correct value regardless of wrap-around or not.
@@ -214,6 +248,13 @@ public:
 
 	uint8_t get_instance() const { return _instance; }
 
+	/**
+	 * Next higher instance of the same topic, chained by the DeviceMaster topic table.
+	 * Links are only ever inserted (nodes are never deleted), so they can be followed without the lock.
+	 */
+	DeviceNode *get_next_instance() const { return __atomic_load_n(&_next_instance, __ATOMIC_ACQUIRE); }
+	void set_next_instance(DeviceNode *node) { __atomic_store_n(&_next_instance, node, __ATOMIC_RELEASE); }
+
 	/**
 	 * Copies data and the corresponding generation
 	 * from a node to the buffer provided.
@@ -228,31 +269,31 @@ public:
 	bool copy(void *dst, unsigned &generation)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
-			if (_queue_size == 1) {
+			if (_spare_slots) {
+				// Lockless (seqlock) read: publications fill a free slot before the generation is
+				// incremented, so the copy is only torn if the slot got reused meanwhile. Retry in that case.
+				unsigned copied_generation;
+
+				do {
+					copied_generation = next_generation(generation);
+					memcpy(dst, slot(copied_generation), _meta->o_size);
+					__atomic_thread_fence(__ATOMIC_ACQUIRE);
+				} while (!view_valid(copied_generation));
+
+				generation = copied_generation + 1;
+				return true;
+
+			} else if (_queue_size == 1) {
 				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
 				generation = _generation.load();
+				memcpy(dst, slot(generation - 1), _meta->o_size);
 				ATOMIC_LEAVE;
 				return true;
 
 			} else {
 				ATOMIC_ENTER;
-				const unsigned current_generation = _generation.load();
-
-				if (current_generation == generation) {
-					/* The subscriber already read the latest message, but nothing new was published yet.
-					* Return the previous message
-					*/
-					--generation;
-				}
-
-				// Compatible with normal and overflow conditions
-				if (!is_in_range(current_generation - _queue_size, generation, current_generation - 1)) {
-					// Reader is too far behind: some messages are lost
-					generation = current_generation - _queue_size;
-				}
-
-				memcpy(dst, _data + (_meta->o_size * (generation % _queue_size)), _meta->o_size);
+				generation = next_generation(generation);
+				memcpy(dst, slot(generation), _meta->o_size);
 				ATOMIC_LEAVE;
 
 				++generation;
@@ -265,6 +306,56 @@ public:
 
 	}
 
+	/**
+	 * Loan the next queue slot so that a publisher can fill it in place.
+	 * Only valid for single publisher instances. The first loan must happen
+	 * before the first regular publication, as the buffer is allocated with
+	 * twice the queue size so that the loaned slot never aliases a sample
+	 * that subscribers can still read.
+	 *
+	 * @return pointer to o_size writable bytes, nullptr if loaning is not possible
+	 */
+	void *loan();
+
+	/**
+	 * Publish the slot previously returned by loan().
+	 * @return true on success
+	 */
+	bool commit();
+
+	/**
+	 * Get a read-only view of the next sample for a subscriber without copying.
+	 * The generation is updated the same way as in copy().
+	 * The sample must be checked with view_valid() once it has been consumed.
+	 *
+	 * @param generation
+	 *   The generation of the subscriber.
+	 * @return pointer to the sample in the queue, nullptr if there is no data.
+	 */
+	const void *view(unsigned &generation);
+
+	/**
+	 * Check whether a sample obtained with view() has not been overwritten (or loaned
+	 * for overwriting) in the meantime.
+	 * @param generation The generation of the viewed sample
+	 */
+	bool view_valid(unsigned generation) const
+	{
+		// with spare slots the next slot is filled before the generation is incremented
+		const unsigned head = _generation.load() + (_spare_slots ? 1 : 0);
+		return (head - generation) <= slot_count();
+	}
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	/**
+	 * Add the delay between a publication and a callback subscriber reading it.
+	 */
+	void add_dispatch_latency(uint32_t latency_us) { _dispatch_latency.add(latency_us); }
+
+	uORB::LatencyHistogram &publish_latency() { return _publish_latency; }
+	uORB::LatencyHistogram &dispatch_latency() { return _dispatch_latency; }
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 	// add item to list of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
@@ -288,10 +379,60 @@ private:
 	List<uORB::SubscriptionCallback *>	_callbacks;
 
 	const uint8_t _instance; /**< orb multi instance identifier */
+	DeviceNode *_next_instance{nullptr}; /**< next instance of the same topic, see get_next_instance() */
 	bool _advertised{false};  /**< has ever been advertised (not necessarily published data yet) */
+	bool _spare_slots{false}; /**< buffer allocated with spare slots (loaned or lockless publications) */
+	bool _single_publisher{false}; /**< only one advertiser, publications don't need the lock */
 	uint8_t _queue_size; /**< maximum number of elements in the queue */
 	int8_t _subscriber_count{0};
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	uORB::LatencyHistogram _publish_latency;
+	uORB::LatencyHistogram _dispatch_latency;
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
+#if defined(CONFIG_UORB_SHARED_MEMORY)
+	uORB::SharedMemoryWriter *_shm_writer{nullptr}; /**< export to other processes, created with the buffer */
+#endif /* CONFIG_UORB_SHARED_MEMORY */
+
+	/**
+	 * Increment the generation of a filled spare slot, then notify callbacks and poll waiters.
+	 */
+	void publish_slot();
+
+	/**
+	 * Allocate the data buffer if needed.
+	 * @return true if the buffer is available
+	 */
+	bool allocate_data(bool spare_slots);
+
+	unsigned slot_count() const { return _spare_slots ? (_queue_size * 2u) : _queue_size; }
+
+	uint8_t *slot(unsigned generation) const { return _data + (_meta->o_size * (generation % slot_count())); }
+
+	/**
+	 * Get the generation a subscriber reads next (oldest available if it fell behind,
+	 * latest if it is up to date).
+	 */
+	unsigned next_generation(unsigned generation) const
+	{
+		const unsigned current_generation = _generation.load();
+
+		if (current_generation == generation) {
+			/* The subscriber already read the latest message, but nothing new was published yet.
+			* Return the previous message
+			*/
+			--generation;
+		}
+
+		// Compatible with normal and overflow conditions
+		if (!is_in_range(current_generation - _queue_size, generation, current_generation - 1)) {
+			// Reader is too far behind: some messages are lost
+			generation = current_generation - _queue_size;
+		}
+
+		return generation;
+	}
 
 // Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
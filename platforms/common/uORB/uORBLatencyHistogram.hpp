@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uORBLatencyHistogram.hpp
+ *
+ * Power of two latency histogram used for the optional uORB latency statistics
+ * (CONFIG_UORB_LATENCY_STATISTICS).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace uORB
+{
+
+class LatencyHistogram
+{
+public:
+	static constexpr int BINS = 10; ///< bin i counts [2^i, 2^(i+1)) us, bin 0 [0, 2) us, last bin is open ended
+
+	/**
+	 * Add a sample. Not synchronized: concurrent publishers might lose a count,
+	 * which is acceptable for statistics.
+	 */
+	void add(uint32_t latency_us)
+	{
+		int bin = 0;
+
+		while ((bin < BINS - 1) && (latency_us >= (2u << bin))) {
+			bin++;
+		}
+
+		_bins[bin]++;
+
+		if (latency_us > _max_us) {
+			_max_us = latency_us;
+		}
+	}
+
+	uint32_t count() const
+	{
+		uint32_t count = 0;
+
+		for (int i = 0; i < BINS; i++) {
+			count += _bins[i];
+		}
+
+		return count;
+	}
+
+	/**
+	 * Get an upper bound of the given percentile
+	 * @param percentile in [0, 1]
+	 * @return upper bin limit in microseconds (max for the last bin)
+	 */
+	uint32_t percentile(float percentile) const
+	{
+		const uint32_t total = count();
+		const uint32_t threshold = static_cast<uint32_t>(percentile * total);
+		uint32_t sum = 0;
+
+		for (int i = 0; i < BINS - 1; i++) {
+			sum += _bins[i];
+
+			if ((sum > 0) && (sum >= threshold)) {
+				return (2u << i);
+			}
+		}
+
+		return _max_us;
+	}
+
+	const uint32_t *bins() const { return _bins; }
+	uint32_t max() const { return _max_us; }
+
+private:
+	uint32_t _bins[BINS] {};
+	uint32_t _max_us{0};
+};
+
+} // namespace uORB
@@ -37,6 +37,7 @@
 #include <fcntl.h>
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/arena.h>
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/tasks.h>
 
@@ -54,6 +55,17 @@ bool uORB::Manager::initialize()
 {
 	if (_Instance == nullptr) {
 		_Instance = new uORB::Manager();
+
+#if !defined(__KERNEL__)
+		// topic buffers are taken from the static pool first (see DeviceNode::allocate_data())
+		size_t pool_size = 0;
+		void *pool = orb_get_static_pool(&pool_size);
+
+		if (pool != nullptr) {
+			px4_arena_add_pool(pool, pool_size);
+		}
+
+#endif // !__KERNEL__
 	}
 
 #if defined(__PX4_NUTTX) && !defined(CONFIG_BUILD_FLAT) && defined(__KERNEL__)
@@ -206,6 +218,12 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 				if (arg == ORB_DEVMASTER_TOP) {
 					dev->showTop(nullptr, 0);
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+
+				} else if (arg == ORB_DEVMASTER_LATENCY) {
+					dev->publishLatencyStatistics();
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 				} else {
 					dev->printStatistics();
 				}
@@ -225,6 +243,12 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 		}
 		break;
 
+	case ORBIOCDEVHASSUBSCRIBERS: {
+			orbiocdevhassubscribers_t *data = (orbiocdevhassubscribers_t *)arg;
+			data->ret = uORB::Manager::orb_has_subscribers(data->handle);
+		}
+		break;
+
 	default:
 		ret = -ENOTTY;
 	}
@@ -490,6 +514,8 @@ void uORB::Manager::orb_remove_internal_subscriber(void *node_handle)
 
 uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle) { return static_cast<const DeviceNode *>(node_handle)->get_queue_size(); }
 
+bool uORB::Manager::orb_has_subscribers(const void *node_handle) { return static_cast<const DeviceNode *>(node_handle)->has_subscribers(); }
+
 bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
 {
 	if (!is_advertised(node_handle)) {
@@ -503,6 +529,93 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation);
 }
 
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return nullptr;
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	if (handle == nullptr) {
+		return nullptr;
+	}
+
+	return static_cast<DeviceNode *>(handle)->loan();
+}
+
+int uORB::Manager::orb_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return PX4_OK; //pretend success
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	uORB::DeviceNode *devnode = static_cast<DeviceNode *>(handle);
+
+	if ((devnode == nullptr) || (meta == nullptr) || (devnode->get_meta()->o_id != meta->o_id)) {
+		errno = EINVAL;
+		return PX4_ERROR;
+	}
+
+	if (!devnode->commit()) {
+		errno = EIO;
+		return PX4_ERROR;
+	}
+
+#ifdef ORB_COMMUNICATOR
+	uORBCommunicator::IChannel *ch = get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		unsigned generation = devnode->get_initial_generation();
+		const void *data = devnode->view(generation);
+
+		if ((data != nullptr) && (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0)) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", meta->o_name);
+			return PX4_ERROR;
+		}
+	}
+
+#endif /* ORB_COMMUNICATOR */
+
+	return PX4_OK;
+}
+
+const void *uORB::Manager::orb_data_view(void *node_handle, unsigned &generation, bool only_if_updated)
+{
+	if (!is_advertised(node_handle)) {
+		return nullptr;
+	}
+
+	if (only_if_updated && !static_cast<const uORB::DeviceNode *>(node_handle)->updates_available(generation)) {
+		return nullptr;
+	}
+
+	return static_cast<DeviceNode *>(node_handle)->view(generation);
+}
+
+bool uORB::Manager::orb_data_view_valid(const void *node_handle, unsigned generation)
+{
+	return static_cast<const DeviceNode *>(node_handle)->view_valid(generation);
+}
+
+const void *uORB::Manager::orb_published_data(const void *node_handle)
+{
+	return static_cast<const DeviceNode *>(node_handle)->published_data();
+}
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+void uORB::Manager::orb_add_dispatch_latency(void *node_handle, uint32_t latency_us)
+{
+	static_cast<DeviceNode *>(node_handle)->add_dispatch_latency(latency_us);
+}
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 // add item to list of work items to schedule on node update
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
@@ -696,13 +809,21 @@ int16_t uORB::Manager::process_remove_subscription(const char *messageName)
 
 int16_t uORB::Manager::process_received_message(const char *messageName, int32_t length, uint8_t *data)
 {
+	// a DeviceNode never gets deleted, so the node of the previous message can be reused as is
+	uORB::DeviceNode *node = _last_received_node.load();
+
+	if (node != nullptr && node->get_instance() == 0 && strcmp(node->get_name(), messageName) == 0) {
+		node->process_received_message(length, data);
+		return 0;
+	}
+
 	int16_t rc = -1;
 	char nodepath[orb_maxpath];
 	int ret = uORB::Utils::node_mkpath(nodepath, messageName);
 	DeviceMaster *device_master = get_device_master();
 
 	if (ret == OK && device_master) {
-		uORB::DeviceNode *node = device_master->getDeviceNode(nodepath);
+		node = device_master->getDeviceNode(nodepath);
 
 		// get the node name.
 		if (node == nullptr) {
@@ -710,6 +831,7 @@ int16_t uORB::Manager::process_received_message(const char *messageName, int32_t
 
 		} else {
 			// node is present.
+			_last_received_node.store(node);
 			node->process_received_message(length, data);
 			rc = 0;
 		}
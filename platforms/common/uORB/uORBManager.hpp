@@ -44,6 +44,7 @@
 #ifdef ORB_COMMUNICATOR
 #include "ORBSet.hpp"
 #include "uORBCommunicator.hpp"
+#include <px4_platform_common/atomic.h>
 #endif /* ORB_COMMUNICATOR */
 
 namespace uORB
@@ -146,9 +147,16 @@ typedef struct {
 	bool ret;
 } orbiocdevisadvertised_t;
 
+#define ORBIOCDEVHASSUBSCRIBERS	_ORBIOCDEV(43)
+typedef struct {
+	const void *handle;
+	bool ret;
+} orbiocdevhassubscribers_t;
+
 typedef enum {
 	ORB_DEVMASTER_STATUS = 0,
-	ORB_DEVMASTER_TOP = 1
+	ORB_DEVMASTER_TOP = 1,
+	ORB_DEVMASTER_LATENCY = 2
 } orbiocdevmastercmd_t;
 #define ORBIOCDEVMASTERCMD	_ORBIOCDEV(45)
 
@@ -444,8 +452,59 @@ public:
 
 	static uint8_t orb_get_queue_size(const void *node_handle);
 
+	/**
+	 * Check if anyone can see the data published on a topic instance
+	 * (local or remote subscribers, or an export to other processes).
+	 *
+	 * @param node_handle  The handle returned from orb_advertise.
+	 * @return    true if there are subscribers.
+	 */
+	static bool orb_has_subscribers(const void *node_handle);
+
 	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated);
 
+	/**
+	 * Loan the next queue slot of a single publisher topic instance for in-place publication.
+	 * Not available in the protected build (user space cannot access the queue).
+	 *
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    writable pointer to the slot, nullptr if loaning is not possible.
+	 */
+	static void *orb_loan(orb_advert_t handle);
+
+	/**
+	 * Publish the slot previously loaned with orb_loan().
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    OK on success, PX4_ERROR otherwise.
+	 */
+	static int orb_commit(const struct orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Get a read-only view of the next sample without copying it.
+	 * Must be followed by orb_data_view_valid() once the sample has been consumed.
+	 * @return pointer to the sample, nullptr if not available.
+	 */
+	static const void *orb_data_view(void *node_handle, unsigned &generation, bool only_if_updated);
+
+	static bool orb_data_view_valid(const void *node_handle, unsigned generation);
+
+	/**
+	 * Get the sample that is being published. Only valid within SubscriptionCallback::call().
+	 * Not available in the protected build.
+	 * @return pointer to the sample, nullptr if not available.
+	 */
+	static const void *orb_published_data(const void *node_handle);
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	/**
+	 * Add a sample to the dispatch latency histogram of a topic
+	 * (delay from publication until a callback subscriber reads it).
+	 */
+	static void orb_add_dispatch_latency(void *node_handle, uint32_t latency_us);
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
 
 	static void unregister_callback(void *node_handle, SubscriptionCallback *callback_sub);
@@ -506,6 +565,9 @@ private: // data members
 
 	ORBSet _remote_subscriber_topics;
 	ORBSet _remote_topics;
+
+	// remote data mostly arrives as bursts of the same topic, skip the node lookup for those
+	px4::atomic<uORB::DeviceNode *> _last_received_node{nullptr};
 #endif /* ORB_COMMUNICATOR */
 
 	DeviceMaster *_device_master{nullptr};
@@ -303,6 +303,14 @@ uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle)
 	return data.size;
 }
 
+bool uORB::Manager::orb_has_subscribers(const void *node_handle)
+{
+	orbiocdevhassubscribers_t data = {node_handle, true};
+	boardctl(ORBIOCDEVHASSUBSCRIBERS, reinterpret_cast<unsigned long>(&data));
+
+	return data.ret;
+}
+
 bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
 {
 	orbiocdevdatacopy_t data = {node_handle, dst, generation, only_if_updated, false};
@@ -312,6 +320,42 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return data.ret;
 }
 
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+	// the queue lives in kernel memory, publishers have to copy
+	return nullptr;
+}
+
+int uORB::Manager::orb_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	errno = ENOTSUP;
+	return PX4_ERROR;
+}
+
+const void *uORB::Manager::orb_data_view(void *node_handle, unsigned &generation, bool only_if_updated)
+{
+	// the queue lives in kernel memory, subscribers have to copy
+	return nullptr;
+}
+
+bool uORB::Manager::orb_data_view_valid(const void *node_handle, unsigned generation)
+{
+	return false;
+}
+
+const void *uORB::Manager::orb_published_data(const void *node_handle)
+{
+	// callbacks are not called from the publisher context in userspace
+	return nullptr;
+}
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+void uORB::Manager::orb_add_dispatch_latency(void *node_handle, uint32_t latency_us)
+{
+	// not recorded for userspace subscribers
+}
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
 	orbiocdevregcallback_t data = {node_handle, callback_sub, false};
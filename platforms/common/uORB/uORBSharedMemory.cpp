@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "uORBSharedMemory.hpp"
+
+#include <uorb_shm.h>
+
+#include <px4_platform_common/log.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace uORB
+{
+
+SharedMemoryWriter *SharedMemoryWriter::create(const orb_metadata *meta, uint8_t instance)
+{
+	// set by the px4 main (px4 -i)
+	const char *px4_instance = getenv("PX4_INSTANCE");
+
+	char name[96];
+	uorb_shm_name(name, sizeof(name), px4_instance ? atoi(px4_instance) : 0, meta->o_name, instance);
+
+	// replace a segment left over by a previous run, readers still mapping it see a stale writer_pid
+	shm_unlink(name);
+
+	const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", name, errno);
+		return nullptr;
+	}
+
+	const size_t size = uorb_shm_segment_size(meta->o_size);
+	void *data = MAP_FAILED;
+
+	if (ftruncate(fd, size) == 0) {
+		data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		PX4_ERR("mapping %s failed (%i)", name, errno);
+		shm_unlink(name);
+		return nullptr;
+	}
+
+	// the segment is zero filled, the magic is set last so readers never see a partial header
+	uorb_shm_header *header = static_cast<uorb_shm_header *>(data);
+	header->version = UORB_SHM_VERSION;
+	header->slot_count = UORB_SHM_SLOTS;
+	header->message_size = meta->o_size;
+	header->slot_size = uorb_shm_slot_size(meta->o_size);
+	header->fields_hash = uorb_shm_fields_hash(meta->o_fields);
+	header->writer_pid = getpid();
+	strncpy(header->topic, meta->o_name, sizeof(header->topic) - 1);
+	header->instance = instance;
+	__atomic_store_n(&header->magic, UORB_SHM_MAGIC, __ATOMIC_RELEASE);
+
+	SharedMemoryWriter *writer = new SharedMemoryWriter(header, size, meta->o_size, name);
+
+	if (writer == nullptr) {
+		munmap(data, size);
+		shm_unlink(name);
+	}
+
+	return writer;
+}
+
+SharedMemoryWriter::SharedMemoryWriter(uorb_shm_header *header, size_t size, uint32_t message_size, const char *name) :
+	_header(header),
+	_size(size),
+	_message_size(message_size)
+{
+	strncpy(_name, name, sizeof(_name) - 1);
+}
+
+SharedMemoryWriter::~SharedMemoryWriter()
+{
+	munmap(_header, _size);
+	shm_unlink(_name);
+}
+
+uorb_shm_slot *SharedMemoryWriter::slot(uint32_t generation) const
+{
+	uint8_t *slots = reinterpret_cast<uint8_t *>(_header) + sizeof(uorb_shm_header);
+	return reinterpret_cast<uorb_shm_slot *>(slots + (generation % UORB_SHM_SLOTS) * uorb_shm_slot_size(_message_size));
+}
+
+void SharedMemoryWriter::write(const void *data)
+{
+	uorb_shm_slot *s = slot(_generation);
+	const uint32_t sequence = 2u * (_generation / UORB_SHM_SLOTS);
+
+	// seqlock: odd while the message is copied
+	__atomic_store_n(&s->sequence, sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	memcpy(s + 1, data, _message_size);
+
+	__atomic_store_n(&s->sequence, sequence + 2, __ATOMIC_RELEASE);
+
+	_generation++;
+	__atomic_store_n(&_header->generation, _generation, __ATOMIC_SEQ_CST);
+
+	// only do the syscall if a reader sleeps on the generation
+	if (__atomic_load_n(&_header->waiters, __ATOMIC_SEQ_CST) != 0) {
+		syscall(SYS_futex, &_header->generation, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+}
+
+} // namespace uORB
@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uORBSharedMemory.hpp
+ *
+ * Export of the publications of a topic instance to a POSIX shared memory segment,
+ * for other processes using the uorb_shm client library (CONFIG_UORB_SHARED_MEMORY).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uORB.h"
+
+struct uorb_shm_header;
+struct uorb_shm_slot;
+
+namespace uORB
+{
+
+class SharedMemoryWriter
+{
+public:
+	/**
+	 * Create (or replace) the segment of a topic instance.
+	 * @return nullptr on failure
+	 */
+	static SharedMemoryWriter *create(const orb_metadata *meta, uint8_t instance);
+
+	~SharedMemoryWriter();
+
+	/**
+	 * Publish a message. There must only be one writer at a time (the caller serializes).
+	 */
+	void write(const void *data);
+
+private:
+	SharedMemoryWriter(uorb_shm_header *header, size_t size, uint32_t message_size, const char *name);
+
+	uorb_shm_slot *slot(uint32_t generation) const;
+
+	uorb_shm_header *const _header;
+	const size_t _size;
+	const uint32_t _message_size;
+	uint32_t _generation{0}; ///< kept locally, nothing written by readers is trusted
+
+	char _name[96] {};
+};
+
+} // namespace uORB
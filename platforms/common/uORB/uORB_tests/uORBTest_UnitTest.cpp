@@ -39,8 +39,11 @@
 #include <errno.h>
 #include <math.h>
 #include <lib/cdev/CDev.hpp>
+#include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
+#include <uORB/SubscriptionQueue.hpp>
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
 {
@@ -206,7 +209,19 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
-	return test_queue_poll_notify();
+	ret = test_queue_poll_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_loan();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return test_subscription_queue();
 }
 
 int uORBTest::UnitTest::test_unadvertise()
@@ -1117,3 +1132,135 @@ int uORBTest::UnitTest::pubsubtest_threadEntry(int argc, char *argv[])
 	uORBTest::UnitTest &t = uORBTest::UnitTest::instance();
 	return t.pubsublatency_main();
 }
+
+int uORBTest::UnitTest::test_loan()
+{
+	test_note("Testing loaned publications");
+
+	static constexpr uint8_t queue_size = 4;
+	uORB::Publication<orb_test_medium_s, queue_size> pub{ORB_ID(orb_test_medium_loan)};
+	uORB::Subscription sub{ORB_ID(orb_test_medium_loan)};
+
+	orb_test_medium_s *loaned = pub.loan();
+
+	if (loaned == nullptr) {
+		// not supported (eg. protected build)
+		return test_note("SKIP loaned publications");
+	}
+
+	if (pub.loan() != loaned) {
+		return test_fail("repeated loan returned a different slot");
+	}
+
+	loaned->val = 1;
+
+	if (!pub.commit()) {
+		return test_fail("commit failed");
+	}
+
+	if (!sub.updated()) {
+		return test_fail("update flag not set");
+	}
+
+	const orb_test_medium_s *viewed = static_cast<const orb_test_medium_s *>(sub.view());
+
+	if ((viewed == nullptr) || (viewed->val != 1)) {
+		return test_fail("view mismatch");
+	}
+
+	if (!sub.view_valid() || sub.updated()) {
+		return test_fail("view not valid or spurious update");
+	}
+
+	// fill the queue, the viewed sample must stay valid until its slot is loaned again
+	for (int i = 2; i < 2 + 2 * queue_size; i++) {
+		orb_test_medium_s *next = pub.loan();
+
+		if ((next == nullptr) || (next == viewed) != (i == 1 + 2 * queue_size)) {
+			return test_fail("loaned slot %d aliases a readable sample", i);
+		}
+
+		next->val = i;
+		pub.commit();
+
+		if ((i < 2 * queue_size) && !sub.view_valid()) {
+			return test_fail("view invalidated too early (%d)", i);
+		}
+	}
+
+	if (sub.view_valid()) {
+		return test_fail("overwritten view not detected");
+	}
+
+	// reader fell behind, only the last queue_size samples are available
+	orb_test_medium_s u{};
+
+	for (int i = 2 + queue_size; i < 2 + 2 * queue_size; i++) {
+		if (!sub.update(&u) || (u.val != i)) {
+			return test_fail("got wrong element from the queue (got %d, should be %d)", u.val, i);
+		}
+	}
+
+	if (sub.updated()) {
+		return test_fail("spurious updated flag");
+	}
+
+	// a regular publication on a loanable node must not alias the readable window
+	u.val = 100;
+
+	if (!pub.publish(u) || !sub.update(&u) || (u.val != 100)) {
+		return test_fail("regular publish on loaned topic failed");
+	}
+
+	return test_note("PASS loaned publications");
+}
+
+int uORBTest::UnitTest::test_subscription_queue()
+{
+	test_note("Testing subscription with private queue");
+
+	static constexpr uint8_t depth = 4;
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_sub_queue)}; // single element topic queue
+	uORB::SubscriptionQueue sub{ORB_ID(orb_test_medium_sub_queue), depth};
+
+	orb_test_medium_s t{};
+	pub.publish(t); // advertise
+
+	if (!sub.registerCallback()) {
+		return test_fail("registerCallback failed");
+	}
+
+	for (int i = 0; i < depth + 2; i++) {
+		t.val = i;
+		pub.publish(t);
+	}
+
+	if ((sub.queued() == 0) && (sub.lost() == 0)) {
+		// not supported (eg. protected build)
+		return test_note("SKIP subscription with private queue");
+	}
+
+	if ((sub.queued() != depth) || (sub.lost() != 2)) {
+		return test_fail("wrong queue state (queued %u, lost %u)", sub.queued(), (unsigned)sub.lost());
+	}
+
+	// the oldest samples are kept, even though the topic only holds one
+	for (int i = 0; i < depth; i++) {
+		if (!sub.pop(&t) || (t.val != i)) {
+			return test_fail("got wrong element from the queue (got %d, should be %d)", t.val, i);
+		}
+	}
+
+	if (sub.pop(&t)) {
+		return test_fail("queue not empty");
+	}
+
+	t.val = 42;
+	pub.publish(t);
+
+	if (!sub.pop(&t) || (t.val != 42)) {
+		return test_fail("queue not refilled");
+	}
+
+	return test_note("PASS subscription with private queue");
+}
@@ -76,6 +76,7 @@
 // CHIP_ERASE   erase the program area and reset address counter
 // loop:
 //      PROG_MULTI      program bytes
+//  or  PROG_MULTI_LONG program larger blocks (if GET_DEVICE/PROG_LONG_MAX is valid)
 // GET_CRC    verify CRC of entire flashable area
 // RESET    finalise flash programming, reset chip and starts application
 //
@@ -109,6 +110,7 @@
 #define PROTO_BOOT                  0x30    // boot the application
 #define PROTO_DEBUG                 0x31    // emit debug information - format not defined
 #define PROTO_SET_BAUD              0x33    // set baud rate on uart
+#define PROTO_PROG_MULTI_LONG       0x3a    // write up to PROTO_PROG_MULTI_LONG_MAX bytes at program address and increment
 
 #define PROTO_RESERVED_0X36         0x36  // Reserved
 #define PROTO_RESERVED_0X37         0x37  // Reserved
@@ -117,6 +119,7 @@
 
 #define PROTO_PROG_MULTI_MAX        64  // maximum PROG_MULTI size
 #define PROTO_READ_MULTI_MAX        255 // size of the size field
+#define PROTO_PROG_MULTI_LONG_MAX   4096 // maximum PROG_MULTI_LONG size, programmed in flash_buffer sized pieces
 
 /* argument values for PROTO_GET_DEVICE */
 #define PROTO_DEVICE_BL_REV         1 // bootloader revision
@@ -124,6 +127,7 @@
 #define PROTO_DEVICE_BOARD_REV      3 // board revision
 #define PROTO_DEVICE_FW_SIZE        4 // size of flashable area
 #define PROTO_DEVICE_VEC_AREA       5 // contents of reserved vectors 7-10
+#define PROTO_DEVICE_PROG_LONG_MAX  6 // maximum PROG_MULTI_LONG size
 
 #define STATE_PROTO_OK              0x10    // INSYNC/OK      - 'ok' response
 #define STATE_PROTO_FAILED          0x11    // INSYNC/FAILED  - 'fail' response
@@ -602,6 +606,44 @@ crc32(const uint8_t *src, unsigned len, unsigned state)
 	return state;
 }
 
+/**
+ * Program words at the current address, with immediate read-back verify
+ *
+ * @param address program address, incremented for every programmed word
+ * @param words data to program
+ * @param count number of words
+ * @param first_word the first word of the image, saved instead of programmed
+ * @param crc running CRC of the programmed image (as reported by GET_CRC)
+ * @return true on success, false on a read-back failure
+ */
+static bool
+program_words(uint32_t *address, const uint32_t *words, unsigned count, uint32_t *first_word, uint32_t *crc)
+{
+	for (unsigned i = 0; i < count; i++) {
+		uint32_t word = words[i];
+
+		if (*address == 0) {
+			// save the first word and don't program it until everything else is done
+			*first_word = word;
+			// replace first word with bits we can overwrite later
+			word = 0xffffffff;
+		}
+
+		// program the word
+		flash_func_write_word(*address, word);
+
+		// do immediate read-back verify
+		if (flash_func_read_word(*address) != word) {
+			return false;
+		}
+
+		*crc = crc32((const uint8_t *)&words[i], sizeof(uint32_t), *crc);
+		*address += 4;
+	}
+
+	return true;
+}
+
 void
 bootloader(unsigned timeout)
 {
@@ -609,6 +651,8 @@ bootloader(unsigned timeout)
 	volatile uint32_t  bl_state = 0; // Must see correct command sequence to erase and reboot (commit first word)
 	uint32_t  address = board_info.fw_size; /* force erase before upload will work */
 	uint32_t  first_word = 0xffffffff;
+	uint32_t  prog_crc = 0; /* CRC of the area below address, valid after an erase */
+	bool      prog_crc_valid = false;
 
 	/* (re)start the timer system */
 	arch_systic_init();
@@ -711,6 +755,12 @@ bootloader(unsigned timeout)
 
 				break;
 
+			case PROTO_DEVICE_PROG_LONG_MAX: {
+					const uint32_t prog_long_max = PROTO_PROG_MULTI_LONG_MAX;
+					cout((uint8_t *)&prog_long_max, sizeof(prog_long_max));
+				}
+				break;
+
 			default:
 				goto cmd_bad;
 			}
@@ -748,6 +798,7 @@ bootloader(unsigned timeout)
 			led_set(LED_ON);
 
 			// erase all sectors
+			prog_crc_valid = false;
 			arch_flash_unlock();
 
 			for (int i = 0; flash_func_sector_size(i) != 0; i++) {
@@ -764,6 +815,8 @@ bootloader(unsigned timeout)
 				}
 
 			address = 0;
+			prog_crc = 0;
+			prog_crc_valid = true;
 			SET_BL_STATE(STATE_PROTO_CHIP_ERASE);
 
 			// resume blinking
@@ -812,35 +865,79 @@ bootloader(unsigned timeout)
 				goto cmd_bad;
 			}
 
-			if (address == 0) {
+#if defined(TARGET_HW_PX4_FMU_V4)
+
+			if ((address == 0) && check_silicon()) {
+				goto bad_silicon;
+			}
+
+#endif
+
+			if (!program_words(&address, flash_buffer.w, arg / 4, &first_word, &prog_crc)) {
+				goto cmd_fail;
+			}
+
+			SET_BL_STATE(STATE_PROTO_PROG_MULTI);
+
+			break;
+
+		// program a larger block at current address
+		//
+		// command:   PROG_MULTI_LONG/<len:2>/<data:len>/EOC
+		// success reply: INSYNC/OK
+		// invalid reply: INSYNC/INVALID
+		// readback failure:  INSYNC/FAILURE
+		//
+		// Every flash_buffer sized piece is programmed as soon as it is received,
+		// while the next piece is already arriving in the receive buffer of the port.
+		//
+		case PROTO_PROG_MULTI_LONG: {
+				// expect count, little endian
+				int len_lo = cin_wait(50);
+				int len_hi = cin_wait(50);
+
+				if ((len_lo < 0) || (len_hi < 0)) {
+					goto cmd_bad;
+				}
+
+				unsigned len = (unsigned)len_lo | ((unsigned)len_hi << 8);
+
+				// sanity-check arguments
+				if ((len % 4) || (len > PROTO_PROG_MULTI_LONG_MAX) || ((address + len) > board_info.fw_size)) {
+					goto cmd_bad;
+				}
 
 #if defined(TARGET_HW_PX4_FMU_V4)
 
-				if (check_silicon()) {
+				if ((address == 0) && check_silicon()) {
 					goto bad_silicon;
 				}
 
 #endif
 
-				// save the first word and don't program it until everything else is done
-				first_word = flash_buffer.w[0];
-				// replace first word with bits we can overwrite later
-				flash_buffer.w[0] = 0xffffffff;
-			}
+				while (len > 0) {
+					const unsigned chunk = (len > sizeof(flash_buffer.c)) ? sizeof(flash_buffer.c) : len;
 
-			arg /= 4;
+					for (unsigned i = 0; i < chunk; i++) {
+						c = cin_wait(1000);
 
-			for (int i = 0; i < arg; i++) {
+						if (c < 0) {
+							goto cmd_bad;
+						}
 
-				// program the word
-				flash_func_write_word(address, flash_buffer.w[i]);
+						flash_buffer.c[i] = c;
+					}
 
-				// do immediate read-back verify
-				if (flash_func_read_word(address) != flash_buffer.w[i]) {
-					goto cmd_fail;
+					if (!program_words(&address, flash_buffer.w, chunk / 4, &first_word, &prog_crc)) {
+						goto cmd_fail;
+					}
+
+					len -= chunk;
 				}
 
-				address += 4;
+				if (!wait_for_eoc(200)) {
+					goto cmd_bad;
+				}
 			}
 
 			SET_BL_STATE(STATE_PROTO_PROG_MULTI);
@@ -859,10 +956,17 @@ bootloader(unsigned timeout)
 				goto cmd_bad;
 			}
 
-			// compute CRC of the programmed area
+			// compute CRC of the programmed area, the part written since the erase
+			// is already covered by the running CRC
 			uint32_t sum = 0;
+			unsigned crc_start = 0;
+
+			if (prog_crc_valid) {
+				sum = prog_crc;
+				crc_start = address;
+			}
 
-			for (unsigned p = 0; p < board_info.fw_size; p += 4) {
+			for (unsigned p = crc_start; p < board_info.fw_size; p += 4) {
 				uint32_t bytes;
 
 				if ((p == 0) && (first_word != 0xffffffff)) {
@@ -50,6 +50,11 @@ int g_usb_df = -1;
 char *g_device = 0;
 char *g_init = 0;
 
+// read ahead buffer, a single read() returns up to a full USB packet
+static char g_rx_buf[64];
+static int g_rx_len = 0;
+static int g_rx_pos = 0;
+
 #if defined(SERIAL_TRACE)
 int in = 0;
 int out = 0;
@@ -76,6 +81,8 @@ void usb_cinit(void *config)
 	}
 
 	g_usb_df = -1;
+	g_rx_len = 0;
+	g_rx_pos = 0;
 	int fd = open(g_device, O_RDWR | O_NONBLOCK);
 
 	if (fd >= 0) {
@@ -87,6 +94,8 @@ void usb_cfini(void)
 {
 	close(g_usb_df);
 	g_usb_df = -1;
+	g_rx_len = 0;
+	g_rx_pos = 0;
 }
 int usb_cin(void)
 {
@@ -104,9 +113,14 @@ int usb_cin(void)
 		free(g_init);
 	}
 
-	char b;
+	if (g_rx_pos >= g_rx_len) {
+		const int len = read(g_usb_df, g_rx_buf, sizeof(g_rx_buf));
+		g_rx_len = (len > 0) ? len : 0;
+		g_rx_pos = 0;
+	}
 
-	if (read(g_usb_df, &b, 1) == 1) {
+	if (g_rx_pos < g_rx_len) {
+		char b = g_rx_buf[g_rx_pos++];
 		c = b;
 #if defined(SERIAL_TRACE)
 		in_trace[in++] = b;
@@ -65,6 +65,7 @@
 
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/hrt_callout_queue.h>
 
 #include "hardware/s32k1xx_ftm.h"
 
@@ -210,7 +211,7 @@
 /*
  * Queue of callout entries.
  */
-static struct sq_queue_s  callout_queue;
+static struct hrt_callout_queue  callout_queue;
 
 /* latency baseline (last compare value applied) */
 static uint16_t           latency_baseline;
@@ -626,7 +627,7 @@ hrt_store_absolute_time(volatile hrt_abstime *t)
 void
 hrt_init(void)
 {
-	sq_init(&callout_queue);
+	hrt_callout_queue_init(&callout_queue);
 	hrt_tim_init();
 
 #ifdef HRT_PPM_CHANNEL
@@ -676,16 +677,7 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 	irqstate_t flags = px4_enter_critical_section();
 
 	/* if the entry is currently queued, remove it */
-	/* note that we are using a potentially uninitialized
-	   entry->link here, but it is safe as sq_rem() doesn't
-	   dereference the passed node unless it is found in the
-	   list. So we potentially waste a bit of time searching the
-	   queue for the uninitialized entry->link but we don't do
-	   anything actually unsafe.
-	*/
-	if (entry->deadline != 0) {
-		sq_rem(&entry->link, &callout_queue);
-	}
+	hrt_callout_queue_remove(&callout_queue, entry);
 
 	entry->deadline = deadline;
 	entry->period = interval;
@@ -716,7 +708,7 @@ hrt_cancel(struct hrt_call *entry)
 {
 	irqstate_t flags = px4_enter_critical_section();
 
-	sq_rem(&entry->link, &callout_queue);
+	hrt_callout_queue_remove(&callout_queue, entry);
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -730,26 +722,12 @@ hrt_cancel(struct hrt_call *entry)
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
-	struct hrt_call	*call, *next;
-
-	call = (struct hrt_call *)sq_peek(&callout_queue);
+	hrt_callout_queue_insert(&callout_queue, entry);
 
-	if ((call == NULL) || (entry->deadline < call->deadline)) {
-		sq_addfirst(&entry->link, &callout_queue);
+	if (hrt_callout_queue_peek(&callout_queue) == entry) {
 		hrtinfo("call enter at head, reschedule\n");
 		/* we changed the next deadline, reschedule the timer event */
 		hrt_call_reschedule();
-
-	} else {
-		do {
-			next = (struct hrt_call *)sq_next(&call->link);
-
-			if ((next == NULL) || (entry->deadline < next->deadline)) {
-				hrtinfo("call enter after head\n");
-				sq_addafter(&call->link, &entry->link, &callout_queue);
-				break;
-			}
-		} while ((call = next) != NULL);
 	}
 
 	hrtinfo("scheduled\n");
@@ -765,7 +743,7 @@ hrt_call_invoke(void)
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+		call = hrt_callout_queue_peek(&callout_queue);
 
 		if (call == NULL) {
 			break;
@@ -775,7 +753,7 @@ hrt_call_invoke(void)
 			break;
 		}
 
-		sq_rem(&call->link, &callout_queue);
+		hrt_callout_queue_remove(&callout_queue, call);
 		hrtinfo("call pop\n");
 
 		/* save the intended deadline for periodic calls */
@@ -790,8 +768,9 @@ hrt_call_invoke(void)
 			call->callout(call->arg);
 		}
 
-		/* if the callout has a non-zero period, it has to be re-entered */
-		if (call->period != 0) {
+		/* if the callout has a non-zero period, it has to be re-entered
+		 * (unless the callout already scheduled it again) */
+		if ((call->period != 0) && !hrt_callout_queue_contains(&callout_queue, call)) {
 			// re-check call->deadline to allow for
 			// callouts to re-schedule themselves
 			// using hrt_call_delay()
@@ -813,7 +792,7 @@ static void
 hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	struct hrt_call	*next = hrt_callout_queue_peek(&callout_queue);
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
 	/*
@@ -222,4 +222,16 @@ int up_dshot_arm(bool armed)
 	return io_timer_set_enable(armed, IOTimerChanMode_Dshot, IO_TIMER_ALL_MODES_CHANNELS);
 }
 
+int up_bdshot_enable(bool enable)
+{
+	// The reply capture needs an input capture DMA stream per timer channel, which is not part of the board
+	// timer configuration (io_timers[].dshot only provides the update DMA used for the burst output).
+	return enable ? -ENOTSUP : 0;
+}
+
+int up_bdshot_get_frame(unsigned channel, uint32_t *frame)
+{
+	return -ENOTSUP;
+}
+
 #endif
@@ -58,6 +58,13 @@ public:
 	virtual int	read(unsigned offset, void *data, unsigned count = 1);
 	virtual int	write(unsigned address, void *data, unsigned count = 1);
 
+	/**
+	 * Write registers and read the exchange registers (PX4IO_EXCHANGE_*) in a single transaction.
+	 * @param reply buffer for PX4IO_EXCHANGE_COUNT registers
+	 * @return number of registers written or <0 on error
+	 */
+	int		exchange(unsigned address, void *data, unsigned count, uint16_t *reply);
+
 protected:
 	/**
 	 * Does the PX4IO_serial instance initialization.
@@ -39,11 +39,13 @@
 
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/time.h>
+#include <px4_platform_common/trace.h>
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/workqueue.h>
 #include <px4_platform_common/tasks.h>
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/hrt_callout_queue.h>
 
 #include <semaphore.h>
 #include <time.h>
@@ -63,7 +65,7 @@ static constexpr unsigned HRT_INTERVAL_MAX = 50000000;
 /*
  * Queue of callout entries.
  */
-static struct sq_queue_s	callout_queue;
+static struct hrt_callout_queue	callout_queue;
 
 /* latency baseline (last compare value applied) */
 static uint64_t			latency_baseline;
@@ -138,7 +140,7 @@ bool	hrt_called(struct hrt_call *entry)
 void	hrt_cancel(struct hrt_call *entry)
 {
 	hrt_lock();
-	sq_rem(&entry->link, &callout_queue);
+	hrt_callout_queue_remove(&callout_queue, entry);
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -191,7 +193,7 @@ void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay)
  */
 void	hrt_init()
 {
-	sq_init(&callout_queue);
+	hrt_callout_queue_init(&callout_queue);
 
 	int sem_ret = px4_sem_init(&_hrt_lock, 0, 1);
 
@@ -205,26 +207,11 @@ void	hrt_init()
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
-	struct hrt_call	*call, *next;
+	hrt_callout_queue_insert(&callout_queue, entry);
 
-	call = (struct hrt_call *)sq_peek(&callout_queue);
-
-	if ((call == nullptr) || (entry->deadline < call->deadline)) {
-		sq_addfirst(&entry->link, &callout_queue);
-		//if (call != nullptr) PX4_INFO("call enter at head, reschedule (%lu %lu)", entry->deadline, call->deadline);
+	if (hrt_callout_queue_peek(&callout_queue) == entry) {
 		/* we changed the next deadline, reschedule the timer event */
 		hrt_call_reschedule();
-
-	} else {
-		do {
-			next = (struct hrt_call *)sq_next(&call->link);
-
-			if ((next == nullptr) || (entry->deadline < next->deadline)) {
-				//lldbg("call enter after head\n");
-				sq_addafter(&call->link, &entry->link, &callout_queue);
-				break;
-			}
-		} while ((call = next) != nullptr);
 	}
 }
 
@@ -263,7 +250,7 @@ hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
 	hrt_abstime	delay = HRT_INTERVAL_MAX;
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	struct hrt_call	*next = hrt_callout_queue_peek(&callout_queue);
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
 	/*
@@ -311,16 +298,7 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 
 	//PX4_INFO("hrt_call_internal after lock");
 	/* if the entry is currently queued, remove it */
-	/* note that we are using a potentially uninitialised
-	   entry->link here, but it is safe as sq_rem() doesn't
-	   dereference the passed node unless it is found in the
-	   list. So we potentially waste a bit of time searching the
-	   queue for the uninitialised entry->link but we don't do
-	   anything actually unsafe.
-	*/
-	if (entry->deadline != 0) {
-		sq_rem(&entry->link, &callout_queue);
-	}
+	hrt_callout_queue_remove(&callout_queue, entry);
 
 #if 1
 
@@ -391,7 +369,7 @@ hrt_call_invoke()
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+		call = hrt_callout_queue_peek(&callout_queue);
 
 		if (call == nullptr) {
 			break;
@@ -401,7 +379,7 @@ hrt_call_invoke()
 			break;
 		}
 
-		sq_rem(&call->link, &callout_queue);
+		hrt_callout_queue_remove(&callout_queue, call);
 		//PX4_INFO("call pop");
 
 		/* save the intended deadline for periodic calls */
@@ -416,13 +394,16 @@ hrt_call_invoke()
 			hrt_unlock();
 
 			//PX4_INFO("call %p: %p(%p)", call, call->callout, call->arg);
+			PX4_TRACE(HRT_BEGIN, call->callout);
 			call->callout(call->arg);
+			PX4_TRACE(HRT_END, nullptr);
 
 			hrt_lock();
 		}
 
-		/* if the callout has a non-zero period, it has to be re-entered */
-		if (call->period != 0) {
+		/* if the callout has a non-zero period, it has to be re-entered
+		 * (unless it was scheduled again while the lock was released) */
+		if ((call->period != 0) && !hrt_callout_queue_contains(&callout_queue, call)) {
 			// re-check call->deadline to allow for
 			// callouts to re-schedule themselves
 			// using hrt_call_delay()
@@ -514,4 +495,9 @@ void px4_lockstep_wait_for_components()
 {
 	lockstep_scheduler.components().wait_for_components();
 }
+
+float px4_lockstep_get_speed_factor()
+{
+	return lockstep_scheduler.get_speed_factor();
+}
 #endif
@@ -53,6 +53,12 @@ public:
 	int cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *lock, uint64_t time_us);
 	int usleep_until(uint64_t timed_us);
 
+	/**
+	 * Ratio of simulated to wall clock time, averaged over the last second of wall time.
+	 * @return speed factor, 0 until it has been measured
+	 */
+	float get_speed_factor() const { return _speed_factor; }
+
 	LockstepComponents &components() { return _components; }
 
 private:
@@ -75,10 +81,10 @@ private:
 			}
 
 			// If a thread quickly exits after a cond_timedwait(), the
-			// thread_local object can still be in the linked list. In that case
-			// we need to wait until it's removed.
-			while (!removed) {
-				system_usleep(5000);
+			// thread_local object can still be in the heap (it is only popped
+			// once its time has passed). In that case we remove it here.
+			if (!removed && scheduler) {
+				scheduler->remove_timed_wait(this);
 			}
 		}
 
@@ -89,14 +95,31 @@ private:
 		std::atomic<bool> done{false};
 		std::atomic<bool> removed{true};
 
-		TimedWait *next{nullptr}; ///< linked list
+		LockstepScheduler *scheduler{nullptr}; ///< scheduler owning the heap entry
+		size_t heap_index{0}; ///< index in _timed_waits, valid if !removed
 	};
 
+	// min-heap of _timed_waits keyed by TimedWait::time_us, all require _timed_waits_mutex to be held
+	void heap_push(TimedWait *timed_wait);
+	void heap_erase(size_t index);
+	void heap_update(size_t index);
+	void heap_sift_up(size_t index);
+	void heap_sift_down(size_t index);
+	void heap_set(size_t index, TimedWait *timed_wait);
+
+	void remove_timed_wait(TimedWait *timed_wait);
+
+	void update_speed_factor(uint64_t time_us);
+
 	LockstepComponents _components;
 
 	std::atomic<uint64_t> _time_us{0};
 
-	TimedWait *_timed_waits{nullptr}; ///< head of linked list
+	std::vector<TimedWait *> _timed_waits; ///< min-heap, earliest wake up time first
 	std::mutex _timed_waits_mutex;
 	std::atomic<bool> _setting_time{false}; ///< true if set_absolute_time() is currently being executed
+
+	std::atomic<float> _speed_factor{0.f};
+	uint64_t _speed_factor_wall_start_us{0};
+	uint64_t _speed_factor_sim_start_us{0};
 };
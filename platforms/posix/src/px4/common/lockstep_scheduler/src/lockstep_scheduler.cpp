@@ -35,16 +35,19 @@
 
 #include <px4_platform_common/log.h>
 
+#include <chrono>
+
 LockstepScheduler::~LockstepScheduler()
 {
-	// cleanup the linked list
+	// cleanup the heap
 	std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
 
-	while (_timed_waits) {
-		TimedWait *tmp = _timed_waits;
-		_timed_waits = _timed_waits->next;
-		tmp->removed = true;
+	for (TimedWait *timed_wait : _timed_waits) {
+		timed_wait->scheduler = nullptr;
+		timed_wait->removed = true;
 	}
+
+	_timed_waits.clear();
 }
 
 void LockstepScheduler::set_absolute_time(uint64_t time_us)
@@ -55,32 +58,20 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 
 	_time_us = time_us;
 
+	update_speed_factor(time_us);
+
 	{
 		std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
 		_setting_time = true;
 
-		TimedWait *timed_wait = _timed_waits;
-		TimedWait *timed_wait_prev = nullptr;
-
-		while (timed_wait) {
-			// Clean up the ones that are already done from last iteration.
-			if (timed_wait->done) {
-				// Erase from the linked list
-				if (timed_wait_prev) {
-					timed_wait_prev->next = timed_wait->next;
+		// Only the expired entries are visited, the rest of the heap is untouched.
+		while (!_timed_waits.empty() && _timed_waits[0]->time_us <= time_us) {
+			TimedWait *timed_wait = _timed_waits[0];
+			heap_erase(0);
 
-				} else {
-					_timed_waits = timed_wait->next;
-				}
-
-				TimedWait *tmp = timed_wait;
-				timed_wait = timed_wait->next;
-				tmp->removed = true;
-				continue;
-			}
-
-			if (timed_wait->time_us <= time_us &&
-			    !timed_wait->timeout) {
+			// The ones that are already done were woken up by their condition
+			// before their time passed and only need to be removed.
+			if (!timed_wait->done && !timed_wait->timeout) {
 				// We are abusing the condition here to signal that the time
 				// has passed.
 				pthread_mutex_lock(timed_wait->passed_lock);
@@ -89,8 +80,7 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 				pthread_mutex_unlock(timed_wait->passed_lock);
 			}
 
-			timed_wait_prev = timed_wait;
-			timed_wait = timed_wait->next;
+			timed_wait->removed = true;
 		}
 
 		_setting_time = false;
@@ -116,11 +106,14 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 		timed_wait.timeout = false;
 		timed_wait.done = false;
 
-		// Add to linked list if not removed yet (otherwise just re-use the object)
+		// Add to the heap if removed already (otherwise just re-use the entry at its new time)
 		if (timed_wait.removed) {
 			timed_wait.removed = false;
-			timed_wait.next = _timed_waits;
-			_timed_waits = &timed_wait;
+			timed_wait.scheduler = this;
+			heap_push(&timed_wait);
+
+		} else {
+			heap_update(timed_wait.heap_index);
 		}
 	}
 
@@ -171,3 +164,115 @@ int LockstepScheduler::usleep_until(uint64_t time_us)
 
 	return result;
 }
+
+void LockstepScheduler::remove_timed_wait(TimedWait *timed_wait)
+{
+	std::lock_guard<std::mutex> lock_timed_waits(_timed_waits_mutex);
+
+	if (!timed_wait->removed) {
+		heap_erase(timed_wait->heap_index);
+		timed_wait->removed = true;
+	}
+}
+
+void LockstepScheduler::update_speed_factor(uint64_t time_us)
+{
+	const uint64_t wall_us = std::chrono::duration_cast<std::chrono::microseconds>(
+					 std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	if (_speed_factor_wall_start_us == 0 || time_us < _speed_factor_sim_start_us) {
+		_speed_factor_wall_start_us = wall_us;
+		_speed_factor_sim_start_us = time_us;
+		return;
+	}
+
+	const uint64_t wall_elapsed_us = wall_us - _speed_factor_wall_start_us;
+
+	if (wall_elapsed_us >= 1000000) {
+		_speed_factor = (float)(time_us - _speed_factor_sim_start_us) / (float)wall_elapsed_us;
+		_speed_factor_wall_start_us = wall_us;
+		_speed_factor_sim_start_us = time_us;
+	}
+}
+
+void LockstepScheduler::heap_set(size_t index, TimedWait *timed_wait)
+{
+	_timed_waits[index] = timed_wait;
+	timed_wait->heap_index = index;
+}
+
+void LockstepScheduler::heap_push(TimedWait *timed_wait)
+{
+	_timed_waits.push_back(timed_wait);
+	timed_wait->heap_index = _timed_waits.size() - 1;
+	heap_sift_up(timed_wait->heap_index);
+}
+
+void LockstepScheduler::heap_erase(size_t index)
+{
+	const size_t last = _timed_waits.size() - 1;
+
+	if (index != last) {
+		heap_set(index, _timed_waits[last]);
+		_timed_waits.pop_back();
+		heap_update(index);
+
+	} else {
+		_timed_waits.pop_back();
+	}
+}
+
+void LockstepScheduler::heap_update(size_t index)
+{
+	if (index > 0 && _timed_waits[index]->time_us < _timed_waits[(index - 1) / 2]->time_us) {
+		heap_sift_up(index);
+
+	} else {
+		heap_sift_down(index);
+	}
+}
+
+void LockstepScheduler::heap_sift_up(size_t index)
+{
+	TimedWait *timed_wait = _timed_waits[index];
+
+	while (index > 0) {
+		const size_t parent = (index - 1) / 2;
+
+		if (_timed_waits[parent]->time_us <= timed_wait->time_us) {
+			break;
+		}
+
+		heap_set(index, _timed_waits[parent]);
+		index = parent;
+	}
+
+	heap_set(index, timed_wait);
+}
+
+void LockstepScheduler::heap_sift_down(size_t index)
+{
+	TimedWait *timed_wait = _timed_waits[index];
+	const size_t size = _timed_waits.size();
+
+	while (true) {
+		size_t child = 2 * index + 1;
+
+		if (child >= size) {
+			break;
+		}
+
+		if (child + 1 < size && _timed_waits[child + 1]->time_us < _timed_waits[child]->time_us) {
+			child++;
+		}
+
+		if (timed_wait->time_us <= _timed_waits[child]->time_us) {
+			break;
+		}
+
+		heap_set(index, _timed_waits[child]);
+		index = child;
+	}
+
+	heap_set(index, timed_wait);
+}
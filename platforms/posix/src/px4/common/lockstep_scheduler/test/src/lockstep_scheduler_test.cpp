@@ -307,6 +307,43 @@ void test_usleep()
 	thread.join(ls);
 }
 
+void test_usleep_wake_order()
+{
+	LockstepScheduler ls;
+	ls.set_absolute_time(some_time_us);
+
+	constexpr int num_threads = 20;
+	constexpr uint64_t step_us = 100;
+	std::atomic<int> num_woken{0};
+	std::vector<std::shared_ptr<TestThread>> threads{};
+
+	// Start the threads with the latest wake up time first.
+	for (int i = num_threads; i > 0; --i) {
+		const uint64_t wake_up_us = some_time_us + i * step_us;
+		threads.push_back(std::make_shared<TestThread>([&ls, &num_woken, wake_up_us]() {
+			EXPECT_EQ(ls.usleep_until(wake_up_us), 0);
+			EXPECT_GE(ls.get_absolute_time(), wake_up_us);
+			++num_woken;
+		}));
+	}
+
+	// Give the threads time to start waiting
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	for (int i = 1; i <= num_threads; ++i) {
+		ls.set_absolute_time(some_time_us + i * step_us);
+		WAIT_FOR(num_woken == i);
+
+		// Nobody else must have been woken up
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		EXPECT_EQ(num_woken, i);
+	}
+
+	for (auto &thread : threads) {
+		thread->join(ls);
+	}
+}
+
 TEST(LockstepScheduler, All)
 {
 	for (unsigned iteration = 1; iteration <= 100; ++iteration) {
@@ -316,5 +353,6 @@ TEST(LockstepScheduler, All)
 		test_locked_semaphore_getting_unlocked();
 		test_usleep();
 		test_multiple_semaphores_waiting();
+		test_usleep_wake_order();
 	}
 }
@@ -44,6 +44,8 @@
  * connect to the server.
  *
  * The symlinks for all modules are created using the build system.
+ * The 'px4-batch' symlink runs a list of commands (from a file or stdin) over a
+ * single connection to the server.
  *
  * @author Mark Charlebois <charlebm@gmail.com>
  * @author Roman Bapst <bapstroman@gmail.com>
@@ -54,6 +56,8 @@
 #include <string>
 #include <algorithm>
 #include <fstream>
+#include <iostream>
+#include <vector>
 #include <signal.h>
 #include <stdio.h>
 #include <errno.h>
@@ -106,6 +110,7 @@ static int run_startup_script(const std::string &commands_file, const std::strin
 static std::string get_absolute_binary_path(const std::string &argv0);
 static void wait_to_exit();
 static bool is_server_running(int instance, bool server);
+static int read_batch_commands(const char *file_name, std::vector<std::string> &commands);
 static void print_usage();
 static bool dir_exists(const std::string &path);
 static bool file_exists(const std::string &name);
@@ -123,6 +128,7 @@ int main(int argc, char **argv)
 #endif
 {
 	bool is_client = false;
+	bool is_batch = false;
 	bool pxh_off = false;
 
 	/* Symlinks point to all commands that can be used as a client with a prefix. */
@@ -138,6 +144,7 @@ int main(int argc, char **argv)
 
 		if (binary_name.compare(0, strlen(prefix), prefix) == 0) {
 			is_client = true;
+			is_batch = binary_name == std::string(prefix) + "batch";
 		}
 
 		path_length = full_binary_name.length() - binary_name.length();
@@ -171,10 +178,21 @@ int main(int argc, char **argv)
 			return -1;
 		}
 
+		px4_daemon::Client client(instance);
+
+		if (is_batch) {
+			std::vector<std::string> commands;
+
+			if (read_batch_commands(argc > 1 ? argv[1] : nullptr, commands) != 0) {
+				return -1;
+			}
+
+			return client.process_batch(commands);
+		}
+
 		/* Remove the path and prefix. */
 		argv[0] += path_length + strlen(prefix);
 
-		px4_daemon::Client client(instance);
 		return client.process_args(argc, (const char **)argv);
 
 	} else {
@@ -255,6 +273,9 @@ int main(int argc, char **argv)
 			PX4_INFO("instance: %i", instance);
 		}
 
+		// for the modules (e.g. the uORB shared memory segment names)
+		setenv("PX4_INSTANCE", std::to_string(instance).c_str(), 1);
+
 #if defined(PX4_BINARY_DIR)
 
 		// data_path & working_directory: if no commands specified or in current working directory),
@@ -605,6 +626,39 @@ void print_usage()
 	printf("\n");
 	printf("    px4-MODULE [--instance <instance>] command using symlink.\n");
 	printf("        e.g.: px4-commander status\n");
+	printf("    px4-batch [--instance <instance>] [<file>] runs the commands (one per line) of <file>\n");
+	printf("        or stdin over a single connection, e.g.: px4-batch params.txt\n");
+}
+
+int read_batch_commands(const char *file_name, std::vector<std::string> &commands)
+{
+	std::ifstream file;
+
+	if (file_name) {
+		file.open(file_name);
+
+		if (!file) {
+			PX4_ERR("failed to open %s", file_name);
+			return -1;
+		}
+	}
+
+	std::istream &input = file_name ? file : std::cin;
+	std::string line;
+
+	while (std::getline(input, line)) {
+		// skip empty lines and comments
+		const size_t start = line.find_first_not_of(" \t");
+
+		if (start == std::string::npos || line[start] == '#') {
+			continue;
+		}
+
+		const size_t end = line.find_last_not_of(" \t\r");
+		commands.push_back(line.substr(start, end - start + 1));
+	}
+
+	return 0;
 }
 
 bool is_server_running(int instance, bool server)
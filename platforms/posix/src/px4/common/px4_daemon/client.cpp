@@ -41,6 +41,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -63,6 +64,49 @@ Client::Client(int instance_id) :
 
 int
 Client::process_args(const int argc, const char **argv)
+{
+	int ret = _connect();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = _send_cmds(argc, argv);
+
+	if (ret != 0) {
+		PX4_ERR("Could not send commands");
+		return -3;
+	}
+
+	return _listen();
+}
+
+int
+Client::process_batch(const std::vector<std::string> &commands)
+{
+	if (commands.empty()) {
+		return 0;
+	}
+
+	int ret = _connect();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	const uint8_t isatty_flag = isatty(STDOUT_FILENO) ? CMD_TERMINATOR_ISATTY : 0;
+	std::string pending;
+
+	for (size_t i = 0; i < commands.size(); ++i) {
+		pending += commands[i];
+		pending.push_back(isatty_flag | (i + 1 < commands.size() ? CMD_TERMINATOR_MORE : 0));
+	}
+
+	return _listen_batch(commands.size(), pending);
+}
+
+int
+Client::_connect()
 {
 	std::string sock_path = get_socket_path(_instance_id);
 
@@ -82,14 +126,7 @@ Client::process_args(const int argc, const char **argv)
 		return -1;
 	}
 
-	int ret = _send_cmds(argc, argv);
-
-	if (ret != 0) {
-		PX4_ERR("Could not send commands");
-		return -3;
-	}
-
-	return _listen();
+	return 0;
 }
 
 int
@@ -108,11 +145,14 @@ Client::_send_cmds(const int argc, const char **argv)
 	}
 
 	// Last byte is 'isatty'.
-	cmd_buf.push_back(isatty(STDOUT_FILENO));
+	cmd_buf.push_back(isatty(STDOUT_FILENO) ? CMD_TERMINATOR_ISATTY : 0);
 
-	size_t n = cmd_buf.size();
-	const char *buf = cmd_buf.data();
+	return _send(cmd_buf.data(), cmd_buf.size());
+}
 
+int
+Client::_send(const char *buf, size_t n)
+{
 	while (n > 0) {
 		int n_sent = write(_fd, buf, n);
 
@@ -177,6 +217,84 @@ Client::_listen()
 	}
 }
 
+int
+Client::_listen_batch(size_t num_commands, std::string &pending)
+{
+	char buffer[1024];
+	size_t num_replies = 0;
+	bool expect_retval = false;
+	int result = 0;
+
+	// Keep sending while reading the replies, so that neither side blocks on a full
+	// socket buffer when the output of the first commands is larger than that.
+	while (num_replies < num_commands) {
+		pollfd fds {_fd, (short)(POLLIN | (pending.empty() ? 0 : POLLOUT)), 0};
+
+		if (poll(&fds, 1, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			PX4_ERR("poll() failed: %s", strerror(errno));
+			return -1;
+		}
+
+		if (fds.revents & POLLOUT) {
+			ssize_t n_sent = send(_fd, pending.data(), pending.size(), MSG_DONTWAIT);
+
+			if (n_sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+				PX4_ERR("send() failed: %s", strerror(errno));
+				return -1;
+			}
+
+			if (n_sent > 0) {
+				pending.erase(0, n_sent);
+			}
+		}
+
+		if (!(fds.revents & (POLLIN | POLLHUP | POLLERR))) {
+			continue;
+		}
+
+		ssize_t n_read = read(_fd, buffer, sizeof buffer);
+
+		if (n_read < 0) {
+			PX4_ERR("unable to read from socket");
+			return -1;
+
+		} else if (n_read == 0) {
+			// Stream was abruptly ended before all commands ran.
+			return -1;
+		}
+
+		// Every reply ends in {0, retval}, the output itself does not contain 0 bytes.
+		ssize_t output_start = 0;
+
+		for (ssize_t i = 0; i < n_read; ++i) {
+			if (expect_retval) {
+				expect_retval = false;
+				output_start = i + 1;
+
+				if (result == 0) {
+					result = buffer[i];
+				}
+
+				++num_replies;
+
+			} else if (buffer[i] == 0) {
+				fwrite(buffer + output_start, i - output_start, 1, stdout);
+				expect_retval = true;
+			}
+		}
+
+		if (!expect_retval && output_start < n_read) {
+			fwrite(buffer + output_start, n_read - output_start, 1, stdout);
+		}
+	}
+
+	return result;
+}
+
 Client::~Client()
 {
 	if (_fd >= 0) {
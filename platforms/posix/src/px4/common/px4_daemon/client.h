@@ -48,6 +48,9 @@
 
 #include <stdint.h>
 
+#include <string>
+#include <vector>
+
 #include "sock_protocol.h"
 
 namespace px4_daemon
@@ -76,9 +79,22 @@ public:
 	 */
 	int process_args(const int argc, const char **argv);
 
+	/**
+	 * Run a list of commands (one command line each) over a single connection.
+	 * The commands are pipelined and run in order, regardless of the return
+	 * value of previous commands.
+	 *
+	 * @param commands: command lines
+	 * @return 0 if all commands succeeded, otherwise the return value of the first failed one
+	 */
+	int process_batch(const std::vector<std::string> &commands);
+
 private:
+	int _connect();
 	int _send_cmds(const int argc, const char **argv);
+	int _send(const char *buf, size_t n);
 	int _listen();
+	int _listen_batch(size_t num_commands, std::string &pending);
 
 	int _fd;
 	int _instance_id; ///< instance ID for running multiple instances of the px4 server
@@ -237,60 +237,73 @@ void
 	FILE *out = (FILE *)arg;
 	int fd = fileno(out);
 
-	// Read until the end of the incoming stream.
-	std::string cmd;
+	// Data received but not processed yet: a client can send its next commands
+	// before the reply to the current one.
+	std::string buffer;
+	bool more = true;
+
+	while (more) {
+		// Read until the end of the next command.
+		size_t cmd_end = 0;
+
+		while (true) {
+			while (cmd_end < buffer.size() && (uint8_t)buffer[cmd_end] > CMD_TERMINATOR_MAX) {
+				++cmd_end;
+			}
 
-	while (true) {
-		size_t n = cmd.size();
-		cmd.resize(n + 1024);
-		ssize_t n_read = read(fd, &cmd[n], cmd.size() - n);
+			if (cmd_end < buffer.size()) {
+				break;
+			}
 
-		if (n_read <= 0) {
+			size_t n = buffer.size();
+			buffer.resize(n + 1024);
+			ssize_t n_read = read(fd, &buffer[n], buffer.size() - n);
+
+			if (n_read <= 0) {
+				_cleanup(fd);
+				return nullptr;
+			}
+
+			buffer.resize(n + n_read);
+		}
+
+		if (cmd_end == 0) {
 			_cleanup(fd);
 			return nullptr;
 		}
 
-		cmd.resize(n + n_read);
+		std::string cmd = buffer.substr(0, cmd_end);
+		const uint8_t terminator = buffer[cmd_end];
+		buffer.erase(0, cmd_end + 1);
 
-		// Command ends in 0x00 (no tty) or 0x01 (tty).
-		if (!cmd.empty() && cmd.back() < 2) {
-			break;
-		}
-	}
-
-	if (cmd.size() < 2) {
-		_cleanup(fd);
-		return nullptr;
-	}
+		more = terminator & CMD_TERMINATOR_MORE;
 
-	// Last byte is 'isatty'.
-	uint8_t isatty = cmd.back();
-	cmd.pop_back();
+		// We register thread specific data. This is used for PX4_INFO (etc.) log calls.
+		CmdThreadSpecificData *thread_data_ptr;
 
-	// We register thread specific data. This is used for PX4_INFO (etc.) log calls.
-	CmdThreadSpecificData *thread_data_ptr;
+		if ((thread_data_ptr = (CmdThreadSpecificData *)pthread_getspecific(_instance->_key)) == nullptr) {
+			thread_data_ptr = new CmdThreadSpecificData;
+			thread_data_ptr->thread_stdout = out;
+			thread_data_ptr->is_atty = terminator & CMD_TERMINATOR_ISATTY;
 
-	if ((thread_data_ptr = (CmdThreadSpecificData *)pthread_getspecific(_instance->_key)) == nullptr) {
-		thread_data_ptr = new CmdThreadSpecificData;
-		thread_data_ptr->thread_stdout = out;
-		thread_data_ptr->is_atty = isatty;
+			(void)pthread_setspecific(_instance->_key, (void *)thread_data_ptr);
+		}
 
-		(void)pthread_setspecific(_instance->_key, (void *)thread_data_ptr);
-	}
+		// Run the actual command.
+		int retval = Pxh::process_line(cmd, true);
 
-	// Run the actual command.
-	int retval = Pxh::process_line(cmd, true);
+		// Report return value.
+		char buf[2] = {0, (char)retval};
 
-	// Report return value.
-	char buf[2] = {0, (char)retval};
+		if (fwrite(buf, sizeof buf, 1, out) != 1) {
+			// Don't care it went wrong, as we're cleaning up anyway.
+		}
 
-	if (fwrite(buf, sizeof buf, 1, out) != 1) {
-		// Don't care it went wrong, as we're cleaning up anyway.
+		// Flush the FILE*'s buffer, so the client gets the reply before the next command is run
+		// (and before we shut down the connection).
+		fflush(out);
 	}
 
-	// Flush the FILE*'s buffer before we shut down the connection.
-	fflush(out);
-
 	_cleanup(fd);
 	return nullptr;
 }
@@ -37,7 +37,8 @@
  *
  * Once a client connects it will send a command and close its side of the connection.
  * The server will return the stdout of the executing command, as well as the return
- * value to the client.
+ * value to the client. A client can also send a batch of commands over the same
+ * connection, which are then executed in order (see sock_protocol.h).
  *
  * There should only every be one server running, therefore the static instance.
  * The Singleton implementation is not complete, but it should be obvious not
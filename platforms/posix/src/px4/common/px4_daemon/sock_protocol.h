@@ -37,11 +37,19 @@
  */
 #pragma once
 
+#include <stdint.h>
 #include <string>
 
 namespace px4_daemon
 {
 
+// Every command sent to the server ends in a terminator byte, the reply to it ends in {0, retval}.
+// A client can send several commands on the same connection (without waiting for the replies),
+// the last one is sent without CMD_TERMINATOR_MORE.
+static constexpr uint8_t CMD_TERMINATOR_ISATTY = 0x01; ///< stdout of the client is a terminal
+static constexpr uint8_t CMD_TERMINATOR_MORE = 0x02; ///< more commands follow on this connection
+static constexpr uint8_t CMD_TERMINATOR_MAX = CMD_TERMINATOR_ISATTY | CMD_TERMINATOR_MORE;
+
 std::string get_socket_path(int instance_id);
 
 } // namespace px4_daemon
@@ -41,6 +41,7 @@
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/workqueue.h>
 #include <px4_platform_common/time.h>
+#include <px4_platform_common/trace.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <pthread.h>
@@ -86,7 +87,9 @@ int px4_sem_wait(px4_sem_t *s)
 	s->value--;
 
 	if (s->value < 0) {
+		PX4_TRACE(SEM_WAIT_BEGIN, s);
 		ret = pthread_cond_wait(&(s->wait), &(s->lock));
+		PX4_TRACE(SEM_WAIT_END, s);
 
 	} else {
 		ret = 0;
@@ -171,6 +174,7 @@ int px4_sem_post(px4_sem_t *s)
 	s->value++;
 
 	if (s->value <= 0) {
+		PX4_TRACE(SEM_POST, s);
 		ret = pthread_cond_signal(&(s->wait));
 
 	} else {
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uorb_shm.h
+ *
+ * Layout of the shared memory segments uORB exports topics to on POSIX
+ * (CONFIG_UORB_SHARED_MEMORY). Shared between the writer in the px4 process and
+ * the standalone client library (uorb_shm_client.hpp), so it must not depend on
+ * any PX4 header.
+ *
+ * There is one segment per topic instance, named
+ * /px4_<px4 instance>.<topic name>.<topic instance> (see uorb_shm_name()).
+ * It starts with a uorb_shm_header followed by slot_count slots of slot_size
+ * bytes, each a uorb_shm_slot followed by the message.
+ *
+ * The px4 process is the only writer. Publishing generation g writes slot
+ * g % slot_count: the slot sequence is incremented to odd, the message copied,
+ * the sequence incremented to even again and then the header generation is
+ * set to g + 1. A reader of generation g therefore expects the sequence
+ * 2 * (g / slot_count + 1); a larger value means the message was overwritten.
+ * Readers waiting for a new generation sleep on the futex at generation after
+ * incrementing waiters, the writer only wakes them if waiters is not 0.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define UORB_SHM_MAGIC		0x4d534f55u	// "UOSM"
+#define UORB_SHM_VERSION	1u
+#define UORB_SHM_SLOTS		8u		// ring size, power of two
+#define UORB_SHM_TOPIC_LEN	64u
+
+struct uorb_shm_header {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t slot_count;
+	uint32_t message_size;			///< orb_metadata::o_size
+	uint32_t slot_size;			///< sizeof(uorb_shm_slot) + message_size, rounded up to 8 bytes
+	uint32_t fields_hash;			///< FNV-1a hash of orb_metadata::o_fields
+	int32_t writer_pid;
+	char topic[UORB_SHM_TOPIC_LEN];
+	uint8_t instance;
+	uint8_t reserved[7];
+
+	uint32_t generation __attribute__((aligned(64)));	///< number of published messages, futex word
+	uint32_t waiters;			///< readers sleeping on generation
+};
+
+struct uorb_shm_slot {
+	uint32_t sequence;			///< odd while the slot is written
+	uint32_t reserved;
+};
+
+static inline uint32_t uorb_shm_fields_hash(const char *fields)
+{
+	uint32_t hash = 0x811c9dc5u;
+
+	for (; *fields != '\0'; fields++) {
+		hash = (hash ^ (uint8_t)*fields) * 0x01000193u;
+	}
+
+	return hash;
+}
+
+static inline uint32_t uorb_shm_slot_size(uint32_t message_size)
+{
+	return ((uint32_t)sizeof(struct uorb_shm_slot) + message_size + 7u) & ~7u;
+}
+
+static inline uint32_t uorb_shm_segment_size(uint32_t message_size)
+{
+	return (uint32_t)sizeof(struct uorb_shm_header) + UORB_SHM_SLOTS * uorb_shm_slot_size(message_size);
+}
+
+/**
+ * Name of the segment of a topic instance (for shm_open()).
+ */
+static inline int uorb_shm_name(char *name, size_t size, int px4_instance, const char *topic, unsigned instance)
+{
+	return snprintf(name, size, "/px4_%d.%s.%u", px4_instance, topic, instance);
+}
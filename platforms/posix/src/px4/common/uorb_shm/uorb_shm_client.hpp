@@ -0,0 +1,342 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uorb_shm_client.hpp
+ *
+ * Standalone (header only, Linux) client to read uORB topics exported to shared
+ * memory by a px4 process built with CONFIG_UORB_SHARED_MEMORY.
+ *
+ * Example:
+ * @code
+ * uorb_shm::Subscription sub{"sensor_combined"};
+ * sensor_combined_s msg;
+ *
+ * while (true) {
+ *     if (sub.wait(100) && sub.update(msg)) { ... }
+ * }
+ * @endcode
+ *
+ * The message structs are the generated uORB headers (or any struct with the
+ * same layout); only the size is checked.
+ */
+
+#pragma once
+
+#include "uorb_shm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace uorb_shm
+{
+
+class Subscription
+{
+public:
+	/**
+	 * @param topic uORB topic name, e.g. "sensor_combined"
+	 * @param instance topic instance
+	 * @param px4_instance instance of the px4 process (px4 -i)
+	 */
+	Subscription(const char *topic, unsigned instance = 0, int px4_instance = 0) :
+		_instance(instance), _px4_instance(px4_instance)
+	{
+		strncpy(_topic, topic, sizeof(_topic) - 1);
+	}
+
+	~Subscription() { close(); }
+
+	Subscription(const Subscription &) = delete;
+	Subscription &operator=(const Subscription &) = delete;
+
+	/**
+	 * Map the segment. Called by the other methods if needed, fails until px4 published the topic.
+	 * Subsequent update() calls start with the latest message.
+	 */
+	bool open()
+	{
+		if (_header != nullptr) {
+			return true;
+		}
+
+		char name[128];
+		uorb_shm_name(name, sizeof(name), _px4_instance, _topic, _instance);
+
+		// read-write for the futex waiters count (the only field a reader writes), otherwise wait() polls
+		int fd = shm_open(name, O_RDWR, 0);
+		_writable = (fd >= 0);
+
+		if (fd < 0) {
+			fd = shm_open(name, O_RDONLY, 0);
+		}
+
+		if (fd < 0) {
+			return false;
+		}
+
+		uorb_shm_header header;
+
+		if (::read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)
+		    || header.magic != UORB_SHM_MAGIC || header.version != UORB_SHM_VERSION) {
+			::close(fd);
+			return false;
+		}
+
+		const size_t size = uorb_shm_segment_size(header.message_size);
+		void *data = mmap(nullptr, size, _writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+
+		if (data == MAP_FAILED) {
+			return false;
+		}
+
+		_header = static_cast<uorb_shm_header *>(data);
+		_size = size;
+		_last_generation = load(&_header->generation);
+		return true;
+	}
+
+	void close()
+	{
+		if (_header != nullptr) {
+			munmap(_header, _size);
+			_header = nullptr;
+		}
+	}
+
+	bool valid() const { return _header != nullptr; }
+
+	/**
+	 * True if the px4 process that wrote the segment is gone (the next px4 instance creates a new one).
+	 */
+	bool stale() const
+	{
+		return (_header != nullptr) && (kill(_header->writer_pid, 0) != 0) && (errno == ESRCH);
+	}
+
+	/** message size in the segment (0 if not open) */
+	size_t message_size() const { return (_header != nullptr) ? _header->message_size : 0; }
+
+	/** messages that were overwritten before they were read */
+	uint32_t lost() const { return _lost; }
+
+	/** true if there are messages that were not read yet */
+	bool updated()
+	{
+		return open() && (load(&_header->generation) != _last_generation);
+	}
+
+	/**
+	 * Copy the next message (in publication order, skipping lost ones).
+	 * @return false if there is no new message or the size does not match
+	 */
+	bool update(void *dst, size_t size)
+	{
+		if (!open() || (size != _header->message_size)) {
+			return false;
+		}
+
+		for (;;) {
+			const uint32_t generation = load(&_header->generation);
+
+			if (generation == _last_generation) {
+				return false;
+			}
+
+			if ((generation - _last_generation) > _header->slot_count) {
+				// fell behind
+				_lost += generation - _last_generation - _header->slot_count;
+				_last_generation = generation - _header->slot_count;
+			}
+
+			if (copy(_last_generation, dst)) {
+				_last_generation++;
+				return true;
+			}
+
+			// overwritten while copying, continue with the oldest one still available
+			_lost++;
+			_last_generation++;
+		}
+	}
+
+	template<typename T>
+	bool update(T &msg) { return update(&msg, sizeof(T)); }
+
+	/**
+	 * Copy the latest message regardless of the read position.
+	 */
+	bool copy_latest(void *dst, size_t size)
+	{
+		if (!open() || (size != _header->message_size)) {
+			return false;
+		}
+
+		for (int retry = 0; retry < 8; retry++) {
+			const uint32_t generation = load(&_header->generation);
+
+			if (generation == 0) {
+				return false;
+			}
+
+			if (copy(generation - 1, dst)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template<typename T>
+	bool copy_latest(T &msg) { return copy_latest(&msg, sizeof(T)); }
+
+	/**
+	 * Wait for a new message.
+	 * @param timeout_ms timeout, negative to wait forever
+	 * @return true if a message is available
+	 */
+	bool wait(int timeout_ms)
+	{
+		if (!open()) {
+			if (timeout_ms > 0) {
+				// the topic is not published yet
+				usleep(timeout_ms * 1000);
+			}
+
+			return updated();
+		}
+
+		const uint32_t last = _last_generation;
+
+		if (!_writable) {
+			for (int t = 0; (timeout_ms < 0) || (t < timeout_ms); t++) {
+				if (load(&_header->generation) != last) {
+					break;
+				}
+
+				usleep(1000);
+			}
+
+			return updated();
+		}
+
+		timespec deadline{};
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec += timeout_ms / 1000;
+		deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+
+		__atomic_fetch_add(&_header->waiters, 1, __ATOMIC_SEQ_CST);
+
+		// a wakeup can be for a generation that was already read, wait again until it changes
+		while (__atomic_load_n(&_header->generation, __ATOMIC_SEQ_CST) == last) {
+			timespec timeout{};
+
+			if (timeout_ms >= 0) {
+				timespec now{};
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+				timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+
+				if (timeout.tv_nsec < 0) {
+					timeout.tv_sec--;
+					timeout.tv_nsec += 1000000000L;
+				}
+
+				if (timeout.tv_sec < 0) {
+					break;
+				}
+			}
+
+			if ((syscall(SYS_futex, &_header->generation, FUTEX_WAIT, last, (timeout_ms >= 0) ? &timeout : nullptr, nullptr, 0) != 0)
+			    && (errno == ETIMEDOUT)) {
+				break;
+			}
+		}
+
+		__atomic_fetch_sub(&_header->waiters, 1, __ATOMIC_SEQ_CST);
+
+		return updated();
+	}
+
+private:
+	static uint32_t load(const uint32_t *v) { return __atomic_load_n(v, __ATOMIC_ACQUIRE); }
+
+	const uorb_shm_slot *slot(uint32_t generation) const
+	{
+		const char *slots = reinterpret_cast<const char *>(_header) + sizeof(uorb_shm_header);
+		return reinterpret_cast<const uorb_shm_slot *>(slots + (generation % _header->slot_count) * _header->slot_size);
+	}
+
+	bool copy(uint32_t generation, void *dst) const
+	{
+		const uorb_shm_slot *s = slot(generation);
+		const uint32_t expected = 2u * (generation / _header->slot_count + 1u);
+
+		if (load(&s->sequence) != expected) {
+			return false;
+		}
+
+		memcpy(dst, s + 1, _header->message_size);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		return load(&s->sequence) == expected;
+	}
+
+	char _topic[UORB_SHM_TOPIC_LEN] {};
+	const unsigned _instance;
+	const int _px4_instance;
+
+	uorb_shm_header *_header{nullptr};
+	size_t _size{0};
+	bool _writable{false};
+
+	uint32_t _last_generation{0};
+	uint32_t _lost{0};
+};
+
+} // namespace uorb_shm
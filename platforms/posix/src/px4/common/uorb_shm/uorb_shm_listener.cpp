@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uorb_shm_listener.cpp
+ *
+ * Example client: prints the rate and the lost messages of a topic exported
+ * to shared memory by px4, and the raw bytes of the latest message.
+ */
+
+#include "uorb_shm_client.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+static double now_s()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <topic> [<instance> [<px4 instance>]]\n", argv[0]);
+		return 1;
+	}
+
+	uorb_shm::Subscription sub{argv[1], (argc > 2) ? (unsigned)atoi(argv[2]) : 0u, (argc > 3) ? atoi(argv[3]) : 0};
+
+	while (!sub.open()) {
+		fprintf(stderr, "waiting for %s\n", argv[1]);
+		sleep(1);
+	}
+
+	std::vector<uint8_t> msg(sub.message_size());
+	unsigned count = 0;
+	double last_print = now_s();
+
+	while (!sub.stale()) {
+		if (sub.wait(1000)) {
+			while (sub.update(msg.data(), msg.size())) {
+				count++;
+			}
+		}
+
+		const double now = now_s();
+
+		if (now - last_print >= 1.0) {
+			printf("%s: %.1f Hz, %u lost, %zu bytes:", argv[1], count / (now - last_print), sub.lost(), msg.size());
+
+			for (size_t i = 0; i < msg.size() && i < 16; i++) {
+				printf(" %02x", msg[i]);
+			}
+
+			printf("%s\n", (msg.size() > 16) ? " ..." : "");
+			count = 0;
+			last_print = now;
+		}
+	}
+
+	printf("px4 exited\n");
+	return 0;
+}
@@ -99,7 +99,7 @@ void
 CameraCapture::capture_callback(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow)
 {
 	// Maximum acceptable rate is 5kHz
-	if ((edge_time - _trigger.hrt_edge_time) < 200_us) {
+	if ((edge_time - _last_edge_time) < 200_us) {
 		++_trigger_rate_exceeded_counter;
 
 		if (_trigger_rate_exceeded_counter > 100) {
@@ -113,10 +113,28 @@ CameraCapture::capture_callback(uint32_t chan_index, hrt_abstime edge_time, uint
 		--_trigger_rate_exceeded_counter;
 	}
 
-	_trigger.chan_index = chan_index;
-	_trigger.hrt_edge_time = edge_time;
-	_trigger.edge_state = edge_state;
-	_trigger.overflow = overflow;
+	queue_edge(chan_index, edge_time, edge_state, overflow);
+}
+
+void
+CameraCapture::queue_edge(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow)
+{
+	_last_edge_time = edge_time;
+
+	const uint8_t head = _trigger_queue_head.load();
+	const uint8_t head_next = (head + 1) % TRIGGER_QUEUE_SIZE;
+
+	if (head_next == _trigger_queue_tail.load()) {
+		// publisher is behind, drop the edge
+		_trigger_queue_overruns.fetch_add(1);
+
+	} else {
+		_trigger_queue[head].chan_index = chan_index;
+		_trigger_queue[head].hrt_edge_time = edge_time;
+		_trigger_queue[head].edge_state = edge_state;
+		_trigger_queue[head].overflow = overflow;
+		_trigger_queue_head.store(head_next);
+	}
 
 	work_queue(HPWORK, &_work_publisher, (worker_t)&CameraCapture::publish_trigger_trampoline, this, 0);
 }
@@ -126,12 +144,7 @@ CameraCapture::gpio_interrupt_routine(int irq, void *context, void *arg)
 {
 	CameraCapture *dev = static_cast<CameraCapture *>(arg);
 
-	dev->_trigger.chan_index = 0;
-	dev->_trigger.hrt_edge_time = hrt_absolute_time();
-	dev->_trigger.edge_state = 0;
-	dev->_trigger.overflow = 0;
-
-	work_queue(HPWORK, &_work_publisher, (worker_t)&CameraCapture::publish_trigger_trampoline, dev, 0);
+	dev->queue_edge(0, hrt_absolute_time(), 0, 0);
 
 	return PX4_OK;
 }
@@ -147,8 +160,6 @@ CameraCapture::publish_trigger_trampoline(void *arg)
 void
 CameraCapture::publish_trigger()
 {
-	bool publish = false;
-
 	if (_trigger_rate_failure.load()) {
 		mavlink_log_warning(&_mavlink_log_pub, "Hardware fault: Camera capture disabled\t");
 		events::send(events::ID("camera_capture_trigger_rate_exceeded"),
@@ -156,37 +167,53 @@ CameraCapture::publish_trigger()
 		_trigger_rate_failure.store(false);
 	}
 
+	uint8_t tail = _trigger_queue_tail.load();
+
+	while (tail != _trigger_queue_head.load()) {
+		const _trig_s edge = _trigger_queue[tail];
+		tail = (tail + 1) % TRIGGER_QUEUE_SIZE;
+		_trigger_queue_tail.store(tail);
+
+		process_edge(edge);
+	}
+}
+
+void
+CameraCapture::process_edge(const _trig_s &edge)
+{
+	bool publish = false;
+
 	camera_trigger_s trigger{};
 
 	// MODES 1 and 2 are not fully tested
 	if (_camera_capture_mode == 0 || _gpio_capture) {
-		trigger.timestamp = _trigger.hrt_edge_time - uint64_t(1000 * _strobe_delay);
+		trigger.timestamp = edge.hrt_edge_time - uint64_t(1000 * _strobe_delay);
 		trigger.seq = _capture_seq++;
 		_last_trig_time = trigger.timestamp;
 
 		publish = true;
 
 	} else if (_camera_capture_mode == 1) { // Get timestamp of mid-exposure (active high)
-		if (_trigger.edge_state == 1) {
-			_last_trig_begin_time = _trigger.hrt_edge_time - uint64_t(1000 * _strobe_delay);
+		if (edge.edge_state == 1) {
+			_last_trig_begin_time = edge.hrt_edge_time - uint64_t(1000 * _strobe_delay);
 
-		} else if (_trigger.edge_state == 0 && _last_trig_begin_time > 0) {
-			trigger.timestamp = _trigger.hrt_edge_time - ((_trigger.hrt_edge_time - _last_trig_begin_time) / 2);
+		} else if (edge.edge_state == 0 && _last_trig_begin_time > 0) {
+			trigger.timestamp = edge.hrt_edge_time - ((edge.hrt_edge_time - _last_trig_begin_time) / 2);
 			trigger.seq = _capture_seq++;
-			_last_exposure_time = _trigger.hrt_edge_time - _last_trig_begin_time;
+			_last_exposure_time = edge.hrt_edge_time - _last_trig_begin_time;
 			_last_trig_time = trigger.timestamp;
 			publish = true;
 			_capture_seq++;
 		}
 
 	} else { // Get timestamp of mid-exposure (active low)
-		if (_trigger.edge_state == 0) {
-			_last_trig_begin_time = _trigger.hrt_edge_time - uint64_t(1000 * _strobe_delay);
+		if (edge.edge_state == 0) {
+			_last_trig_begin_time = edge.hrt_edge_time - uint64_t(1000 * _strobe_delay);
 
-		} else if (_trigger.edge_state == 1 && _last_trig_begin_time > 0) {
-			trigger.timestamp = _trigger.hrt_edge_time - ((_trigger.hrt_edge_time - _last_trig_begin_time) / 2);
+		} else if (edge.edge_state == 1 && _last_trig_begin_time > 0) {
+			trigger.timestamp = edge.hrt_edge_time - ((edge.hrt_edge_time - _last_trig_begin_time) / 2);
 			trigger.seq = _capture_seq++;
-			_last_exposure_time = _trigger.hrt_edge_time - _last_trig_begin_time;
+			_last_exposure_time = edge.hrt_edge_time - _last_trig_begin_time;
 			_last_trig_time = trigger.timestamp;
 			publish = true;
 		}
@@ -194,7 +221,7 @@ CameraCapture::publish_trigger()
 	}
 
 	trigger.feedback = true;
-	_capture_overflows = _trigger.overflow;
+	_capture_overflows = edge.overflow;
 
 	if (!publish) {
 		return;
@@ -383,6 +410,7 @@ CameraCapture::status()
 	}
 
 	PX4_INFO("Number of overflows : %" PRIu32, _capture_overflows);
+	PX4_INFO("Dropped edges : %" PRIu32, _trigger_queue_overruns.load());
 
 	if (_gpio_capture) {
 		PX4_INFO("Using board GPIO pin");
@@ -42,6 +42,7 @@
 #include <drivers/drv_input_capture.h>
 #include <drivers/drv_pwm_output.h>
 #include <lib/parameters/param.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
@@ -112,7 +113,17 @@ private:
 		hrt_abstime hrt_edge_time;
 		uint32_t edge_state;
 		uint32_t overflow;
-	} _trigger{};
+	};
+
+	// edges are queued in interrupt context and drained by publish_trigger(), so that
+	// the rising and the falling edge of a short exposure are not overwritten before
+	// the work queue gets to run
+	static constexpr uint8_t TRIGGER_QUEUE_SIZE = 8;
+	_trig_s			_trigger_queue[TRIGGER_QUEUE_SIZE] {};
+	px4::atomic<uint8_t>	_trigger_queue_head{0}; ///< written in interrupt context only
+	px4::atomic<uint8_t>	_trigger_queue_tail{0}; ///< written by publish_trigger() only
+	px4::atomic<uint32_t>	_trigger_queue_overruns{0};
+	hrt_abstime		_last_edge_time{0};
 
 	bool			_capture_enabled{false};
 	bool			_gpio_capture{false};
@@ -142,6 +153,12 @@ private:
 	// Signal capture callback
 	void			capture_callback(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
 
+	// Queue an edge from interrupt context and schedule the publisher
+	void			queue_edge(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
+
+	// Handle a single queued edge, publishes a trigger if it completes a capture
+	void			process_edge(const _trig_s &edge);
+
 	// GPIO interrupt routine
 	static int		gpio_interrupt_routine(int irq, void *context, void *arg);
 
@@ -40,6 +40,7 @@
 #include <px4_platform_common/log.h>
 
 #include "o1heap/o1heap.h"
+#include "CanardMemoryPool.hpp"
 
 #include "Subscribers/BaseSubscriber.hpp"
 
@@ -56,8 +57,29 @@
 
 O1HeapInstance *cyphal_allocator{nullptr};
 
-static void *memAllocate(CanardInstance *const ins, const size_t amount) { return o1heapAllocate(cyphal_allocator, amount); }
-static void memFree(CanardInstance *const ins, void *const pointer) { o1heapFree(cyphal_allocator, pointer); }
+// a classic CAN TX queue item (libcanard allocates the item and its frame payload as one block)
+static constexpr size_t PoolBlockSize = (sizeof(CanardTxQueueItem) + CANARD_MTU_CAN_CLASSIC + O1HEAP_ALIGNMENT - 1)
+					/ O1HEAP_ALIGNMENT * O1HEAP_ALIGNMENT;
+static CanardMemoryPool<PoolBlockSize, CanardHandle::PoolBlockCount> cyphal_pool;
+
+static void *memAllocate(CanardInstance *const ins, const size_t amount)
+{
+	void *block = cyphal_pool.allocate(amount);
+
+	if (block == nullptr) {
+		// larger than a block (CAN FD frames, multi-frame RX payloads) or the pool is exhausted
+		block = o1heapAllocate(cyphal_allocator, amount);
+	}
+
+	return block;
+}
+
+static void memFree(CanardInstance *const ins, void *const pointer)
+{
+	if (!cyphal_pool.free(pointer)) {
+		o1heapFree(cyphal_allocator, pointer);
+	}
+}
 
 
 CanardHandle::CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes)
@@ -135,6 +157,7 @@ void CanardHandle::receive()
 
 			if (subscription != nullptr) {
 				UavcanBaseSubscriber *sub_instance = (UavcanBaseSubscriber *)subscription->user_reference;
+				sub_instance->countTransfer(subscription);
 				sub_instance->callback(receive);
 
 			} else {
@@ -207,6 +230,12 @@ O1HeapDiagnostics CanardHandle::getO1HeapDiagnostics()
 	return o1heapGetDiagnostics(cyphal_allocator);
 }
 
+void CanardHandle::printPoolStatus()
+{
+	PX4_INFO("Pool status %zu/%zu blocks of %zu bytes, peak %zu", cyphal_pool.in_use(), cyphal_pool.block_count(),
+		 cyphal_pool.block_size(), cyphal_pool.peak_in_use());
+}
+
 int32_t CanardHandle::mtu()
 {
 	return _queue.mtu_bytes;
@@ -48,6 +48,9 @@ class CanardHandle
 	static constexpr unsigned HeapSize = 8192;
 
 public:
+	/* Number of fixed size blocks serving the classic CAN TX frames before falling back to the heap */
+	static constexpr size_t PoolBlockCount = 48;
+
 	CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes);
 	~CanardHandle();
 
@@ -70,6 +73,7 @@ public:
 			     const CanardPortID       port_id);
 	CanardTreeNode *getRxSubscriptions(CanardTransferKind kind);
 	O1HeapDiagnostics getO1HeapDiagnostics();
+	void printPoolStatus();
 
 	int32_t mtu();
 	CanardNodeID node_id();
@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file CanardMemoryPool.hpp
+ *
+ * Fixed size block pool with O(1) allocation for the libcanard hot path.
+ * Every TX frame of a classic CAN transfer is a separate allocation of the same size,
+ * serving these from a free list avoids the o1heap bookkeeping for each frame.
+ * Not thread-safe, like the CanardInstance it is used with.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template<size_t BlockSize, size_t BlockCount>
+class CanardMemoryPool
+{
+public:
+	static constexpr size_t Alignment = sizeof(void *) * 2;
+
+	static_assert(BlockSize >= sizeof(void *), "block has to hold the free list link");
+	static_assert(BlockSize % Alignment == 0, "every block has to stay aligned");
+
+	CanardMemoryPool()
+	{
+		for (size_t i = 0; i < BlockCount; i++) {
+			Block *block = reinterpret_cast<Block *>(&_storage[i * BlockSize]);
+			block->next = _free;
+			_free = block;
+		}
+	}
+
+	/**
+	 * @return a block if amount fits and the pool is not exhausted, nullptr otherwise
+	 */
+	void *allocate(size_t amount)
+	{
+		if (amount > BlockSize || _free == nullptr) {
+			return nullptr;
+		}
+
+		Block *block = _free;
+		_free = block->next;
+
+		if (++_in_use > _peak_in_use) {
+			_peak_in_use = _in_use;
+		}
+
+		return block;
+	}
+
+	/**
+	 * Return a block to the pool.
+	 * @return false if pointer was not allocated from this pool
+	 */
+	bool free(void *pointer)
+	{
+		uint8_t *p = static_cast<uint8_t *>(pointer);
+
+		if (p < &_storage[0] || p >= &_storage[sizeof(_storage)]) {
+			return false;
+		}
+
+		Block *block = reinterpret_cast<Block *>(p);
+		block->next = _free;
+		_free = block;
+		_in_use--;
+		return true;
+	}
+
+	static constexpr size_t block_size() { return BlockSize; }
+	static constexpr size_t block_count() { return BlockCount; }
+	size_t in_use() const { return _in_use; }
+	size_t peak_in_use() const { return _peak_in_use; }
+
+private:
+	struct Block {
+		Block *next;
+	};
+
+	alignas(Alignment) uint8_t _storage[BlockSize * BlockCount] {};
+
+	Block *_free{nullptr};
+
+	size_t _in_use{0};
+	size_t _peak_in_use{0};
+};
@@ -252,6 +252,8 @@ void CyphalNode::print_info()
 		 heap_diagnostics.peak_allocated, heap_diagnostics.peak_request_size,
 		 heap_diagnostics.oom_count);
 
+	_canard_handle.printPoolStatus();
+
 	_pub_manager.printInfo();
 
 	traverseTree<CanardRxSubscription>(_canard_handle.getRxSubscriptions(CanardTransferKindMessage),
@@ -44,6 +44,7 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/log.h>
 
+#include <drivers/drv_hrt.h>
 #include <lib/parameters/param.h>
 #include <containers/List.hpp>
 
@@ -103,7 +104,8 @@ public:
 	void printInfo()
 	{
 		if (_port_id != CANARD_PORT_ID_UNSET) {
-			PX4_INFO("Enabled subject %s%s.%d on port %d", _prefix_name, _subject_name, _instance, _port_id);
+			PX4_INFO("Enabled subject %s%s.%d on port %d, published %" PRIu32 " dropped %" PRIu32,
+				 _prefix_name, _subject_name, _instance, _port_id, _published_count, _tx_error_count);
 
 		} else {
 			PX4_INFO("Subject %s%s.%d disabled", _prefix_name, _subject_name, _instance);
@@ -136,6 +138,25 @@ public:
 	}
 
 protected:
+	/**
+	 * Push a serialized transfer to the TX queue and account it in the subject stats
+	 * @return number of frames enqueued or negative libcanard error
+	 */
+	int32_t publish(const CanardTransferMetadata &transfer_metadata, size_t payload_size, const void *payload)
+	{
+		const int32_t result = _canard_handle.TxPush(hrt_absolute_time() + PUBLISHER_DEFAULT_TIMEOUT_USEC,
+				       &transfer_metadata, payload_size, payload);
+
+		if (result < 0) {
+			_tx_error_count++;
+
+		} else {
+			_published_count++;
+		}
+
+		return result;
+	}
+
 	CanardHandle &_canard_handle;
 	UavcanParamManager &_param_manager;
 	const char *_prefix_name;
@@ -145,5 +166,8 @@ protected:
 	CanardPortID _port_id {CANARD_PORT_ID_UNSET};
 	CanardTransferID _transfer_id {0};
 
+	uint32_t _published_count{0};
+	uint32_t _tx_error_count{0};
+
 	UavcanPublisher *_next_pub {nullptr};
 };
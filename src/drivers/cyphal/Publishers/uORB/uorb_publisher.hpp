@@ -77,10 +77,7 @@ public:
 
 			// set the data ready in the buffer and chop if needed
 			++_transfer_id;  // The transfer-ID shall be incremented after every transmission on this subject.
-			_canard_handle.TxPush(hrt_absolute_time() + PUBLISHER_DEFAULT_TIMEOUT_USEC,
-					      &transfer_metadata,
-					      get_payload_size(&data),
-					      &data);
+			publish(transfer_metadata, get_payload_size(&data), &data);
 		}
 	};
 
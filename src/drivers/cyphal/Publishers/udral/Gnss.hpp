@@ -86,10 +86,7 @@ public:
 			if (result == 0) {
 				// set the data ready in the buffer and chop if needed
 				++_transfer_id;  // The transfer-ID shall be incremented after every transmission on this subject.
-				result = _canard_handle.TxPush(hrt_absolute_time() + PUBLISHER_DEFAULT_TIMEOUT_USEC,
-							       &transfer_metadata,
-							       payload_size,
-							       &geo_payload_buffer);
+				result = publish(transfer_metadata, payload_size, &geo_payload_buffer);
 			}
 		}
 	};
@@ -65,7 +65,7 @@ public:
 		if (_actuator_armed_sub.updated() && _port_id != CANARD_PORT_ID_UNSET) {
 			actuator_armed_s armed {};
 			_actuator_armed_sub.update(&armed);
-			size_t payload_size;
+			size_t payload_size = reg_udral_service_common_Readiness_0_1_SERIALIZATION_BUFFER_SIZE_BYTES_;
 
 			reg_udral_service_common_Readiness_0_1 readiness {};
 
@@ -92,10 +92,7 @@ public:
 			if (result == 0) {
 				// set the data ready in the buffer and chop if needed
 				++_transfer_id;  // The transfer-ID shall be incremented after every transmission on this subject.
-				result = _canard_handle.TxPush(hrt_absolute_time() + PUBLISHER_DEFAULT_TIMEOUT_USEC,
-							       &transfer_metadata,
-							       payload_size,
-							       &readiness_payload_buffer);
+				result = publish(transfer_metadata, payload_size, &readiness_payload_buffer);
 			}
 		}
 	};
@@ -81,6 +81,21 @@ public:
 
 	virtual void callback(const CanardRxTransfer &msg) = 0;
 
+	// Account a received transfer in the per subject stats
+	void countTransfer(const CanardRxSubscription *subscription)
+	{
+		SubjectSubscription *curSubj = &_subj_sub;
+
+		while (curSubj != nullptr) {
+			if (&curSubj->_canard_sub == subscription) {
+				curSubj->_received_count++;
+				return;
+			}
+
+			curSubj = curSubj->next;
+		}
+	}
+
 	CanardPortID id(uint32_t instance = 0)
 	{
 		uint32_t i = 0;
@@ -133,7 +148,8 @@ public:
 
 		while (curSubj != nullptr) {
 			if (curSubj->_canard_sub.port_id != CANARD_PORT_ID_UNSET) {
-				PX4_INFO("Subscribed %s.%d on port %d", curSubj->_subject_name, _instance, curSubj->_canard_sub.port_id);
+				PX4_INFO("Subscribed %s.%d on port %d, received %" PRIu32, curSubj->_subject_name, _instance,
+					 curSubj->_canard_sub.port_id, curSubj->_received_count);
 			}
 
 			curSubj = curSubj->next;
@@ -144,6 +160,7 @@ protected:
 	struct SubjectSubscription {
 		CanardRxSubscription _canard_sub;
 		const char *_subject_name;
+		uint32_t _received_count{0};
 		struct SubjectSubscription *next {nullptr};
 	};
 
@@ -137,4 +137,22 @@ __EXPORT extern void up_dshot_trigger(void);
  */
 __EXPORT extern int up_dshot_arm(bool armed);
 
+/**
+ * Enable or disable bidirectional DShot (inverted signal, the ESCs reply with the eRPM on the same line).
+ * Must be called after up_dshot_init().
+ *
+ * @param enable	If true, switch to bidirectional mode
+ * @return 0 on success, -ENOTSUP if not supported by the platform
+ */
+__EXPORT extern int up_bdshot_enable(bool enable);
+
+/**
+ * Get the bidirectional DShot telemetry frame of a channel, received as reply to the previous trigger.
+ *
+ * @param channel	The channel (motor).
+ * @param frame		The 21 received line levels (non-inverted, first bit in bit 20).
+ * @return 0 if a new frame was received, <0 otherwise
+ */
+__EXPORT extern int up_bdshot_get_frame(unsigned channel, uint32_t *frame);
+
 __END_DECLS
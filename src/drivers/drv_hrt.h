@@ -72,9 +72,14 @@ typedef void	(* hrt_callout)(void *arg);
 
 /**
  * Callout record.
+ *
+ * Must be zero initialised before the first use (static storage, {} or hrt_call_init()).
  */
 typedef struct hrt_call {
-	struct sq_entry_s	link;
+	/* callout queue links (see px4_platform_common/hrt_callout_queue.h) */
+	struct hrt_call		*child;
+	struct hrt_call		*sibling;
+	struct hrt_call		*prev;
 
 	hrt_abstime		deadline;
 	hrt_abstime		period;
@@ -246,12 +251,14 @@ __EXPORT extern int px4_lockstep_register_component(void);
 __EXPORT extern void px4_lockstep_unregister_component(int component);
 __EXPORT extern void px4_lockstep_progress(int component);
 __EXPORT extern void px4_lockstep_wait_for_components(void);
+__EXPORT extern float px4_lockstep_get_speed_factor(void);
 
 #else
 static inline int px4_lockstep_register_component(void) { return 0; }
 static inline void px4_lockstep_unregister_component(int component) { }
 static inline void px4_lockstep_progress(int component) { }
 static inline void px4_lockstep_wait_for_components(void) { }
+static inline float px4_lockstep_get_speed_factor(void) { return 0.f; }
 #endif /* defined(ENABLE_LOCKSTEP_SCHEDULER) */
 
 
@@ -40,6 +40,61 @@
 char DShot::_telemetry_device[] {};
 px4::atomic_bool DShot::_request_telemetry_init{false};
 
+/**
+ * Decode a bidirectional DShot reply frame
+ * @param frame 21 bit line levels
+ * @param erpm decoded eRPM [100ERPM]
+ * @return true if the frame is valid
+ */
+static bool decode_bdshot_frame(uint32_t frame, int &erpm)
+{
+	// GCR 5 bit code -> nibble, -1 for invalid codes
+	static constexpr int8_t gcr_decode[32] = {
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, 9, 10, 11, -1, 13, 14, 15,
+		-1, -1, 2, 3, -1, 5, 6, 7, -1, 0, 8, 1, -1, 4, 12, -1,
+	};
+
+	// a level change encodes a 1
+	const uint32_t gcr = (frame ^ (frame >> 1)) & 0xfffff;
+	uint32_t value = 0;
+
+	for (int i = 3; i >= 0; i--) {
+		const int8_t nibble = gcr_decode[(gcr >> (5 * i)) & 0x1f];
+
+		if (nibble < 0) {
+			return false;
+		}
+
+		value = (value << 4) | nibble;
+	}
+
+	// inverted XOR checksum over the 3 data nibbles
+	uint32_t checksum = value ^ (value >> 8);
+	checksum ^= checksum >> 4;
+
+	if ((checksum & 0xf) != 0xf) {
+		return false;
+	}
+
+	value >>= 4;
+
+	if (value == 0xfff) {
+		// motor stopped
+		erpm = 0;
+		return true;
+	}
+
+	// eee mmmmmmmmm: period in us
+	const uint32_t period_us = (value & 0x1ff) << (value >> 9);
+
+	if (period_us == 0) {
+		return false;
+	}
+
+	erpm = (60000000 / 100 + period_us / 2) / period_us;
+	return true;
+}
+
 DShot::DShot() :
 	OutputModuleInterface(MODULE_NAME, px4::wq_configurations::hp_default)
 {
@@ -57,6 +112,7 @@ DShot::~DShot()
 	up_dshot_arm(false);
 
 	perf_free(_cycle_perf);
+	perf_free(_bdshot_error_perf);
 	delete _telemetry;
 }
 
@@ -167,6 +223,10 @@ void DShot::enable_dshot_outputs(const bool enabled)
 		}
 
 		_outputs_initialized = true;
+
+		if (_param_dshot_bidir_en.get()) {
+			init_bdshot();
+		}
 	}
 
 	if (_outputs_initialized) {
@@ -193,18 +253,27 @@ void DShot::update_telemetry_num_motors()
 	_telemetry->handler.setNumMotors(motor_count);
 }
 
-void DShot::init_telemetry(const char *device)
+bool DShot::allocate_telemetry()
 {
 	if (!_telemetry) {
 		_telemetry = new Telemetry{};
 
 		if (!_telemetry) {
 			PX4_ERR("alloc failed");
-			return;
+			return false;
 		}
+
+		_telemetry->esc_status_pub.advertise();
 	}
 
-	_telemetry->esc_status_pub.advertise();
+	return true;
+}
+
+void DShot::init_telemetry(const char *device)
+{
+	if (!allocate_telemetry()) {
+		return;
+	}
 
 	int ret = _telemetry->handler.init(device);
 
@@ -224,15 +293,25 @@ void DShot::handle_new_telemetry_data(const int telemetry_index, const DShotTele
 		esc_status.esc_online_flags |= 1 << telemetry_index;
 
 		esc_status.esc[telemetry_index].actuator_function = _telemetry->actuator_functions[telemetry_index];
-		esc_status.esc[telemetry_index].timestamp       = data.time;
-		esc_status.esc[telemetry_index].esc_rpm         = (static_cast<int>(data.erpm) * 100) /
-				(_param_mot_pole_count.get() / 2);
+
+		if (!_bdshot_enabled) {
+			esc_status.esc[telemetry_index].timestamp       = data.time;
+			esc_status.esc[telemetry_index].esc_rpm         = (static_cast<int>(data.erpm) * 100) /
+					(_param_mot_pole_count.get() / 2);
+		}
+
 		esc_status.esc[telemetry_index].esc_voltage     = static_cast<float>(data.voltage) * 0.01f;
 		esc_status.esc[telemetry_index].esc_current     = static_cast<float>(data.current) * 0.01f;
 		esc_status.esc[telemetry_index].esc_temperature = static_cast<float>(data.temperature);
 		// TODO: accumulate consumption and use for battery estimation
 	}
 
+	if (_bdshot_enabled) {
+		// published together with the eRPM of all motors on every output update
+		_telemetry->last_telemetry_index = telemetry_index;
+		return;
+	}
+
 	// publish when motor index wraps (which is robust against motor timeouts)
 	if (telemetry_index <= _telemetry->last_telemetry_index) {
 		esc_status.timestamp = hrt_absolute_time();
@@ -253,6 +332,57 @@ void DShot::handle_new_telemetry_data(const int telemetry_index, const DShotTele
 	_telemetry->last_telemetry_index = telemetry_index;
 }
 
+void DShot::init_bdshot()
+{
+	if (up_bdshot_enable(true) != 0) {
+		PX4_WARN("bidirectional DShot not supported");
+		return;
+	}
+
+	if (allocate_telemetry()) {
+		_bdshot_enabled = true;
+		update_telemetry_num_motors();
+	}
+}
+
+void DShot::update_bdshot_telemetry()
+{
+	esc_status_s &esc_status = _telemetry->esc_status_pub.get();
+	const hrt_abstime now = hrt_absolute_time();
+	int telemetry_index = 0;
+
+	// all motors replied to the previous frame by now
+	for (unsigned i = 0; i < _num_outputs && telemetry_index < esc_status_s::CONNECTED_ESC_MAX; i++) {
+		if (!_mixing_output.isFunctionSet(i)) {
+			continue;
+		}
+
+		uint32_t frame;
+		int erpm;
+
+		if (up_bdshot_get_frame(i, &frame) == 0 && decode_bdshot_frame(frame, erpm)) {
+			esc_status.esc[telemetry_index].actuator_function = _telemetry->actuator_functions[telemetry_index];
+			esc_status.esc[telemetry_index].timestamp = now;
+			esc_status.esc[telemetry_index].esc_rpm = (erpm * 100) / (_param_mot_pole_count.get() / 2);
+
+		} else {
+			perf_count(_bdshot_error_perf);
+		}
+
+		++telemetry_index;
+	}
+
+	esc_status.timestamp = now;
+	esc_status.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_DSHOT;
+	esc_status.esc_count = telemetry_index;
+	++esc_status.counter;
+	// same as for the UART telemetry: a single invalid frame does not mark the ESC as offline
+	esc_status.esc_online_flags = (1 << esc_status.esc_count) - 1;
+	esc_status.esc_armed_flags = (1 << esc_status.esc_count) - 1;
+
+	_telemetry->esc_status_pub.update();
+}
+
 int DShot::send_command_thread_safe(const dshot_command_t command, const int num_repetitions, const int motor_index)
 {
 	Command cmd{};
@@ -435,6 +565,10 @@ bool DShot::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 		_current_command.clear();
 	}
 
+	if (_bdshot_enabled) {
+		update_bdshot_telemetry();
+	}
+
 	up_dshot_trigger();
 
 	return true;
@@ -706,6 +840,12 @@ int DShot::print_status()
 	PX4_INFO("Outputs used: 0x%" PRIx32, _output_mask);
 	PX4_INFO("Outputs on: %s", _outputs_on ? "yes" : "no");
 	perf_print_counter(_cycle_perf);
+
+	if (_bdshot_enabled) {
+		PX4_INFO("bidirectional DShot on");
+		perf_print_counter(_bdshot_error_perf);
+	}
+
 	_mixing_output.printStatus();
 
 	if (_telemetry) {
@@ -129,8 +129,14 @@ private:
 
 	void enable_dshot_outputs(const bool enabled);
 
+	bool allocate_telemetry();
+
 	void init_telemetry(const char *device);
 
+	void init_bdshot();
+
+	void update_bdshot_telemetry();
+
 	void handle_new_telemetry_data(const int telemetry_index, const DShotTelemetry::EscData &data);
 
 	int request_esc_info();
@@ -158,11 +164,13 @@ private:
 	bool _outputs_initialized{false};
 	bool _outputs_on{false};
 	bool _waiting_for_esc_info{false};
+	bool _bdshot_enabled{false};
 
 	static constexpr unsigned _num_outputs{DIRECT_PWM_OUTPUT_CHANNELS};
 	uint32_t _output_mask{0};
 
 	perf_counter_t	_cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
+	perf_counter_t	_bdshot_error_perf{perf_alloc(PC_COUNT, MODULE_NAME": bdshot errors")};
 
 	Command _current_command{};
 
@@ -175,6 +183,7 @@ private:
 		(ParamBool<px4::params::DSHOT_3D_ENABLE>) _param_dshot_3d_enable,
 		(ParamInt<px4::params::DSHOT_3D_DEAD_H>) _param_dshot_3d_dead_h,
 		(ParamInt<px4::params::DSHOT_3D_DEAD_L>) _param_dshot_3d_dead_l,
+		(ParamBool<px4::params::DSHOT_BIDIR_EN>) _param_dshot_bidir_en,
 		(ParamInt<px4::params::MOT_POLE_COUNT>) _param_mot_pole_count
 	)
 };
@@ -191,6 +191,7 @@ private:
 	float				_rate{0.0f};					///< position update rate
 	float				_rate_rtcm_injection{0.0f};			///< RTCM message injection rate
 	unsigned			_last_rate_rtcm_injection_count{0};		///< counter for number of RTCM messages
+	unsigned			_rtcm_injection_dropped{0};			///< RTCM messages lost to a gps_inject_data queue overrun
 	unsigned			_num_bytes_read{0}; 				///< counter for number of read bytes from the UART (within update interval)
 	unsigned			_rate_reading{0}; 				///< reading rate in B/s
 	hrt_abstime			_last_rtcm_injection_time{0};			///< time of last rtcm injection
@@ -250,7 +251,7 @@ private:
 	void handleInjectDataTopic();
 
 	/**
-	 * send data to the device, such as an RTCM stream
+	 * send data to the device, such as an RTCM stream (without waiting for the transmission to complete)
 	 * @param data
 	 * @param len
 	 */
@@ -476,12 +477,30 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 			const unsigned sleeptime = character_count * 1000000 / (baudrate / 10);
 
 #ifdef __PX4_NUTTX
-			int err = 0;
 			int bytes_available = 0;
-			err = ::ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available);
 
-			if (err != 0 || bytes_available < (int)character_count) {
+			if (::ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available) != 0) {
 				px4_usleep(sleeptime);
+
+			} else {
+				// Wait in steps while data keeps arriving, but stop as soon as the line was idle for a step:
+				// this is the end of a message burst, and the parser can handle it right away.
+				const unsigned idle_count = character_count / 2;
+				unsigned waited = 0;
+
+				while (bytes_available < (int)character_count && waited < character_count) {
+					px4_usleep(sleeptime * idle_count / character_count);
+					waited += idle_count;
+
+					int bytes_available_now = 0;
+
+					if (::ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available_now) != 0
+					    || bytes_available_now == bytes_available) {
+						break;
+					}
+
+					bytes_available = bytes_available_now;
+				}
 			}
 
 #else
@@ -516,10 +535,12 @@ void GPS::handleInjectDataTopic()
 	}
 
 	gps_inject_data_s msg;
+	bool instance_changed = false;
 
 	// If there has not been a valid RTCM message for a while, try to switch to a different RTCM link
 	if ((hrt_absolute_time() - _last_rtcm_injection_time) > 5_s) {
 		_last_rtcm_injection_time = hrt_absolute_time();
+		instance_changed = true;
 
 		for (uint8_t i = 0; i < gps_inject_data_s::MAX_INSTANCES; i++) {
 			if (_orb_inject_data_sub.ChangeInstance(i)) {
@@ -533,37 +554,41 @@ void GPS::handleInjectDataTopic()
 		}
 	}
 
-	bool updated = false;
-
-	// Limit maximum number of GPS injections to 6 since usually
-	// GPS injections should consist of 1-4 packets (GPS, Glonass, BeiDou, Galileo).
-	// Looking at 6 packets thus guarantees, that at least a full injection
-	// data set is evaluated.
-	const size_t max_num_injections = 6;
+	// Drain the whole queue: a burst of large (MSM7) corrections spans several messages, and leaving
+	// some for the next cycle lets the publisher overrun the queue. Only wait for the UART once per batch.
 	size_t num_injections = 0;
 
-	do {
-		num_injections++;
-		updated = _orb_inject_data_sub.updated();
+	while (num_injections < gps_inject_data_s::ORB_QUEUE_LENGTH && _orb_inject_data_sub.updated()) {
+		const unsigned last_generation = _orb_inject_data_sub.get_last_generation();
 
-		if (updated) {
+		if (!_orb_inject_data_sub.copy(&msg)) {
+			break;
+		}
 
-			if (_orb_inject_data_sub.copy(&msg)) {
+		// the subscription skips ahead if the queue was overrun
+		if (!instance_changed) {
+			_rtcm_injection_dropped += _orb_inject_data_sub.get_last_generation() - last_generation - 1;
+		}
 
-				// Prevent injection of data from self
-				if (msg.device_id != get_device_id()) {
-					/* Write the message to the gps device. Note that the message could be fragmented.
-					* But as we don't write anywhere else to the device during operation, we don't
-					* need to assemble the message first.
-					*/
-					injectData(msg.data, msg.len);
+		instance_changed = false;
 
-					++_last_rate_rtcm_injection_count;
-					_last_rtcm_injection_time = hrt_absolute_time();
-				}
-			}
+		// Prevent injection of data from self
+		if (msg.device_id != get_device_id()) {
+			/* Write the message to the gps device. Note that the message could be fragmented.
+			* But as we don't write anywhere else to the device during operation, we don't
+			* need to assemble the message first.
+			*/
+			injectData(msg.data, msg.len);
+			num_injections++;
+
+			++_last_rate_rtcm_injection_count;
+			_last_rtcm_injection_time = hrt_absolute_time();
 		}
-	} while (updated && num_injections < max_num_injections);
+	}
+
+	if (num_injections > 0) {
+		::fsync(_serial_fd);
+	}
 }
 
 bool GPS::injectData(uint8_t *data, size_t len)
@@ -571,7 +596,6 @@ bool GPS::injectData(uint8_t *data, size_t len)
 	dumpGpsData(data, len, gps_dump_comm_mode_t::Full, true);
 
 	size_t written = ::write(_serial_fd, data, len);
-	::fsync(_serial_fd);
 	return written == len;
 }
 
@@ -1126,6 +1150,7 @@ GPS::print_status()
 
 		PX4_INFO("rate publication:\t\t%6.2f Hz", (double)_rate);
 		PX4_INFO("rate RTCM injection:\t%6.2f Hz", (double)_rate_rtcm_injection);
+		PX4_INFO("RTCM injection dropped:\t%6u", _rtcm_injection_dropped);
 
 		print_message(ORB_ID(sensor_gps), _report_gps_pos);
 	}
@@ -72,6 +72,8 @@ void BMI088_Gyroscope::print_status()
 	I2CSPIDriverBase::print_status();
 
 	PX4_INFO("FIFO empty interval: %d us (%.1f Hz)", _fifo_empty_interval_us, 1e6 / _fifo_empty_interval_us);
+	PX4_INFO("sample clock: %.3f us (%.0f ppm), %" PRIu32 " resyncs", (double)_sample_clock.interval(),
+		 (double)_sample_clock.driftPpm(), _sample_clock.resyncCount());
 
 	perf_print_counter(_bad_register_perf);
 	perf_print_counter(_bad_transfer_perf);
@@ -415,9 +417,9 @@ bool BMI088_Gyroscope::FIFORead(const hrt_abstime &timestamp_sample, uint8_t sam
 	}
 
 	sensor_gyro_fifo_s gyro{};
-	gyro.timestamp_sample = timestamp_sample;
+	gyro.timestamp_sample = _sample_clock.update(timestamp_sample, samples);
 	gyro.samples = samples;
-	gyro.dt = FIFO_SAMPLE_DT;
+	gyro.dt = _sample_clock.interval();
 
 	for (int i = 0; i < samples; i++) {
 		const FIFO::DATA &fifo_sample = buffer.f[i];
@@ -453,6 +455,7 @@ void BMI088_Gyroscope::FIFOReset()
 
 	// reset while FIFO is disabled
 	_drdy_timestamp_sample.store(0);
+	_sample_clock.reset();
 
 	// FIFO_CONFIG_0: restore FIFO watermark
 	// FIFO_CONFIG_1: re-enable FIFO
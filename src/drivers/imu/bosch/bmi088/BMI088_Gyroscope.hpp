@@ -36,6 +36,7 @@
 #include "BMI088.hpp"
 
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
+#include <lib/drivers/imu_sample_clock/ImuSampleClock.hpp>
 
 #include "Bosch_BMI088_Gyroscope_Registers.hpp"
 
@@ -96,6 +97,7 @@ private:
 	void FIFOReset();
 
 	PX4Gyroscope _px4_gyro;
+	ImuSampleClock _sample_clock{FIFO_SAMPLE_DT};
 
 	perf_counter_t _bad_register_perf{perf_alloc(PC_COUNT, MODULE_NAME"_gyro: bad register")};
 	perf_counter_t _bad_transfer_perf{perf_alloc(PC_COUNT, MODULE_NAME"_gyro: bad transfer")};
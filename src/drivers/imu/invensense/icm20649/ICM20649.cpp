@@ -96,6 +96,8 @@ void ICM20649::print_status()
 	I2CSPIDriverBase::print_status();
 
 	PX4_INFO("FIFO empty interval: %d us (%.1f Hz)", _fifo_empty_interval_us, 1e6 / _fifo_empty_interval_us);
+	PX4_INFO("sample clock: %.3f us (%.0f ppm), %" PRIu32 " resyncs", (double)_sample_clock.interval(),
+		 (double)_sample_clock.driftPpm(), _sample_clock.resyncCount());
 
 	perf_print_counter(_bad_register_perf);
 	perf_print_counter(_bad_transfer_perf);
@@ -563,9 +565,11 @@ bool ICM20649::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 	const uint16_t valid_samples = math::min(samples, fifo_count_samples);
 
 	if (valid_samples > 0) {
-		ProcessGyro(timestamp_sample, buffer.f, valid_samples);
+		const hrt_abstime timestamp_last_sample = _sample_clock.update(timestamp_sample, valid_samples);
 
-		if (ProcessAccel(timestamp_sample, buffer.f, valid_samples)) {
+		ProcessGyro(timestamp_last_sample, buffer.f, valid_samples);
+
+		if (ProcessAccel(timestamp_last_sample, buffer.f, valid_samples)) {
 			return true;
 		}
 	}
@@ -584,6 +588,7 @@ void ICM20649::FIFOReset()
 	// reset while FIFO is disabled
 	_drdy_count = 0;
 	_drdy_timestamp_sample.store(0);
+	_sample_clock.reset();
 }
 
 static bool fifo_accel_equal(const FIFO::DATA &f0, const FIFO::DATA &f1)
@@ -596,7 +601,7 @@ bool ICM20649::ProcessAccel(const hrt_abstime &timestamp_sample, const FIFO::DAT
 	sensor_accel_fifo_s accel{};
 	accel.timestamp_sample = timestamp_sample;
 	accel.samples = 0;
-	accel.dt = FIFO_SAMPLE_DT * SAMPLES_PER_TRANSFER;
+	accel.dt = _sample_clock.interval() * SAMPLES_PER_TRANSFER;
 
 	bool bad_data = false;
 
@@ -649,7 +654,7 @@ void ICM20649::ProcessGyro(const hrt_abstime &timestamp_sample, const FIFO::DATA
 	sensor_gyro_fifo_s gyro{};
 	gyro.timestamp_sample = timestamp_sample;
 	gyro.samples = samples;
-	gyro.dt = FIFO_SAMPLE_DT;
+	gyro.dt = _sample_clock.interval();
 
 	for (int i = 0; i < samples; i++) {
 		const int16_t gyro_x = combine(fifo[i].GYRO_XOUT_H, fifo[i].GYRO_XOUT_L);
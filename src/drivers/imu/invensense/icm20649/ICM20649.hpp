@@ -46,6 +46,7 @@
 #include <lib/drivers/accelerometer/PX4Accelerometer.hpp>
 #include <lib/drivers/device/spi.h>
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
+#include <lib/drivers/imu_sample_clock/ImuSampleClock.hpp>
 #include <lib/geo/geo.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/atomic.h>
@@ -153,6 +154,7 @@ private:
 	enum REG_BANK_SEL_BIT _last_register_bank {REG_BANK_SEL_BIT::USER_BANK_0};
 
 	px4::atomic<hrt_abstime> _drdy_timestamp_sample{0};
+	ImuSampleClock _sample_clock{FIFO_SAMPLE_DT};
 	int32_t _drdy_count{0};
 	bool _data_ready_interrupt_enabled{false};
 
@@ -96,6 +96,8 @@ void ICM42688P::print_status()
 	I2CSPIDriverBase::print_status();
 
 	PX4_INFO("FIFO empty interval: %d us (%.1f Hz)", _fifo_empty_interval_us, 1e6 / _fifo_empty_interval_us);
+	PX4_INFO("sample clock: %.3f us (%.0f ppm), %" PRIu32 " resyncs", (double)_sample_clock.interval(),
+		 (double)_sample_clock.driftPpm(), _sample_clock.resyncCount());
 
 	perf_print_counter(_bad_register_perf);
 	perf_print_counter(_bad_transfer_perf);
@@ -228,40 +230,19 @@ void ICM42688P::RunImpl()
 				ScheduleDelayed(_fifo_empty_interval_us * 2);
 			}
 
-			if (samples == 0) {
-				// check current FIFO count
-				const uint16_t fifo_count = FIFOReadCount();
-
-				if (fifo_count >= FIFO::SIZE) {
-					FIFOReset();
-					perf_count(_fifo_overflow_perf);
-
-				} else if (fifo_count == 0) {
-					perf_count(_fifo_empty_perf);
-
-				} else {
-					// FIFO count (size in bytes)
-					samples = (fifo_count / sizeof(FIFO::DATA));
-
-					// tolerate minor jitter, leave sample to next iteration if behind by only 1
-					if (samples == _fifo_gyro_samples + 1) {
-						timestamp_sample -= static_cast<int>(FIFO_SAMPLE_DT);
-						samples--;
-					}
+			bool timestamp_newest = false;
 
-					if (samples > FIFO_MAX_SAMPLES) {
-						// not technically an overflow, but more samples than we expected or can publish
-						FIFOReset();
-						perf_count(_fifo_overflow_perf);
-						samples = 0;
-					}
-				}
+			if (samples == 0) {
+				// no data ready timestamp, read the expected samples (plus one for jitter) together with
+				// INT_STATUS and FIFO_COUNT in a single burst instead of reading the count first
+				samples = math::min(_fifo_gyro_samples + 1, FIFO_MAX_SAMPLES);
+				timestamp_newest = true;
 			}
 
 			bool success = false;
 
 			if (samples >= 1) {
-				if (FIFORead(timestamp_sample, samples)) {
+				if (FIFORead(timestamp_sample, samples, timestamp_newest)) {
 					success = true;
 
 					if (_failure_count > 0) {
@@ -472,22 +453,7 @@ void ICM42688P::RegisterSetAndClearBits(T reg, uint8_t setbits, uint8_t clearbit
 	}
 }
 
-uint16_t ICM42688P::FIFOReadCount()
-{
-	// read FIFO count
-	uint8_t fifo_count_buf[3] {};
-	fifo_count_buf[0] = static_cast<uint8_t>(Register::BANK_0::FIFO_COUNTH) | DIR_READ;
-	SelectRegisterBank(REG_BANK_SEL_BIT::USER_BANK_0);
-
-	if (transfer(fifo_count_buf, fifo_count_buf, sizeof(fifo_count_buf)) != PX4_OK) {
-		perf_count(_bad_transfer_perf);
-		return 0;
-	}
-
-	return combine(fifo_count_buf[1], fifo_count_buf[2]);
-}
-
-bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
+bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples, bool timestamp_newest)
 {
 	FIFOTransferBuffer buffer{};
 	const size_t transfer_size = math::min(samples * sizeof(FIFO::DATA) + 4, FIFO::SIZE);
@@ -519,6 +485,13 @@ bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 		return false;
 	}
 
+	if (timestamp_newest && (fifo_count_samples > FIFO_MAX_SAMPLES)) {
+		// not technically an overflow, but more samples than we expected or can publish
+		perf_count(_fifo_overflow_perf);
+		FIFOReset();
+		return false;
+	}
+
 	// check FIFO header in every sample
 	uint8_t valid_samples = 0;
 
@@ -563,9 +536,23 @@ bool ICM42688P::FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples)
 	}
 
 	if (valid_samples > 0) {
+		hrt_abstime timestamp_last_sample = timestamp_sample;
+
+		if (timestamp_newest && (fifo_count_samples > valid_samples)) {
+			// samples left in the FIFO are newer than the ones read
+			timestamp_last_sample -= static_cast<int>(FIFO_SAMPLE_DT * (fifo_count_samples - valid_samples));
+		}
+
+		if (valid_samples < math::min(samples, fifo_count_samples)) {
+			// invalid samples dropped
+			_sample_clock.reset();
+		}
+
+		timestamp_last_sample = _sample_clock.update(timestamp_last_sample, valid_samples);
+
 		if (ProcessTemperature(buffer.f, valid_samples)) {
-			ProcessGyro(timestamp_sample, buffer.f, valid_samples);
-			ProcessAccel(timestamp_sample, buffer.f, valid_samples);
+			ProcessGyro(timestamp_last_sample, buffer.f, valid_samples);
+			ProcessAccel(timestamp_last_sample, buffer.f, valid_samples);
 			return true;
 		}
 	}
@@ -582,6 +569,7 @@ void ICM42688P::FIFOReset()
 
 	// reset while FIFO is disabled
 	_drdy_timestamp_sample.store(0);
+	_sample_clock.reset();
 }
 
 static constexpr int32_t reassemble_20bit(const uint32_t a, const uint32_t b, const uint32_t c)
@@ -606,7 +594,7 @@ void ICM42688P::ProcessAccel(const hrt_abstime &timestamp_sample, const FIFO::DA
 	sensor_accel_fifo_s accel{};
 	accel.timestamp_sample = timestamp_sample;
 	accel.samples = 0;
-	accel.dt = FIFO_SAMPLE_DT;
+	accel.dt = _sample_clock.interval();
 
 	// 18-bits of accelerometer data
 	bool scale_20bit = false;
@@ -693,7 +681,7 @@ void ICM42688P::ProcessGyro(const hrt_abstime &timestamp_sample, const FIFO::DAT
 	sensor_gyro_fifo_s gyro{};
 	gyro.timestamp_sample = timestamp_sample;
 	gyro.samples = 0;
-	gyro.dt = FIFO_SAMPLE_DT;
+	gyro.dt = _sample_clock.interval();
 
 	// 20-bits of gyroscope data
 	bool scale_20bit = false;
@@ -46,6 +46,7 @@
 #include <lib/drivers/accelerometer/PX4Accelerometer.hpp>
 #include <lib/drivers/device/spi.h>
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
+#include <lib/drivers/imu_sample_clock/ImuSampleClock.hpp>
 #include <lib/geo/geo.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/atomic.h>
@@ -131,8 +132,12 @@ private:
 	template <typename T> void RegisterSetBits(T reg, uint8_t setbits) { RegisterSetAndClearBits(reg, setbits, 0); }
 	template <typename T> void RegisterClearBits(T reg, uint8_t clearbits) { RegisterSetAndClearBits(reg, 0, clearbits); }
 
-	uint16_t FIFOReadCount();
-	bool FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples);
+	/**
+	 * Read INT_STATUS, FIFO_COUNT and up to samples FIFO samples in a single transfer.
+	 * @param timestamp_newest timestamp_sample is the time of the newest sample in the FIFO (polled) rather than
+	 *        the time of the last requested sample (data ready interrupt)
+	 */
+	bool FIFORead(const hrt_abstime &timestamp_sample, uint8_t samples, bool timestamp_newest = false);
 	void FIFOReset();
 
 	void ProcessAccel(const hrt_abstime &timestamp_sample, const FIFO::DATA fifo[], const uint8_t samples);
@@ -159,6 +164,7 @@ private:
 	enum REG_BANK_SEL_BIT _last_register_bank {REG_BANK_SEL_BIT::USER_BANK_0};
 
 	px4::atomic<hrt_abstime> _drdy_timestamp_sample{0};
+	ImuSampleClock _sample_clock{FIFO_SAMPLE_DT};
 	bool _data_ready_interrupt_enabled{false};
 
 	enum class STATE : uint8_t {
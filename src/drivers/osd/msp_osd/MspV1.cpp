@@ -51,11 +51,6 @@ MspV1::MspV1(int fd) :
 {
 }
 
-int MspV1::GetMessageSize(int message_type)
-{
-	return 0;
-}
-
 struct msp_message_descriptor_t {
 	uint8_t message_id;
 	bool fixed_size;
@@ -77,21 +72,34 @@ const msp_message_descriptor_t msp_message_descriptors[MSP_DESCRIPTOR_COUNT] = {
 	{MSP_MOTOR_TELEMETRY, true, sizeof(msp_motor_telemetry_t)},
 };
 
-#define MSP_FRAME_START_SIZE 5
-#define MSP_CRC_SIZE 1
-bool MspV1::Send(const uint8_t message_id, const void *payload)
+static const msp_message_descriptor_t *find_descriptor(int message_id)
 {
-	uint32_t payload_size = 0;
-
-	msp_message_descriptor_t *desc = nullptr;
-
 	for (int i = 0; i < MSP_DESCRIPTOR_COUNT; i++) {
 		if (message_id == msp_message_descriptors[i].message_id) {
-			desc = (msp_message_descriptor_t *)&msp_message_descriptors[i];
-			break;
+			return &msp_message_descriptors[i];
 		}
 	}
 
+	return nullptr;
+}
+
+int MspV1::GetMessageSize(int message_type)
+{
+	const msp_message_descriptor_t *desc = find_descriptor(message_type);
+
+	if (!desc || !desc->fixed_size) {
+		return 0;
+	}
+
+	return desc->message_size;
+}
+
+#define MSP_FRAME_START_SIZE 5
+#define MSP_CRC_SIZE 1
+bool MspV1::Send(const uint8_t message_id, const void *payload)
+{
+	const msp_message_descriptor_t *desc = find_descriptor(message_id);
+
 	if (!desc) {
 		return false;
 	}
@@ -100,9 +108,16 @@ bool MspV1::Send(const uint8_t message_id, const void *payload)
 		return false;
 	}
 
-	payload_size = desc->message_size;
+	const uint32_t payload_size = desc->message_size;
+	const int packet_size = MSP_FRAME_START_SIZE + payload_size + MSP_CRC_SIZE;
+
+	if (_tx_length + packet_size > TX_BUFFER_SIZE) {
+		if (!Flush()) {
+			return false;
+		}
+	}
 
-	uint8_t packet[MSP_FRAME_START_SIZE + payload_size + MSP_CRC_SIZE];
+	uint8_t *packet = &_tx_buffer[_tx_length];
 	uint8_t crc;
 
 	packet[0] = '$';
@@ -121,6 +136,18 @@ bool MspV1::Send(const uint8_t message_id, const void *payload)
 
 	packet[MSP_FRAME_START_SIZE + payload_size] = crc;
 
-	int packet_size =  MSP_FRAME_START_SIZE + payload_size + MSP_CRC_SIZE;
-	return  write(_fd, packet, packet_size) == packet_size;
+	_tx_length += packet_size;
+	return true;
+}
+
+bool MspV1::Flush()
+{
+	if (_tx_length == 0) {
+		return true;
+	}
+
+	const int length = _tx_length;
+	_tx_length = 0;
+
+	return write(_fd, _tx_buffer, length) == length;
 }
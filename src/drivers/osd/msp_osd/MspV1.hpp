@@ -38,9 +38,19 @@ class MspV1
 public:
 	MspV1(int fd);
 	int GetMessageSize(int message_type);
+
+	// queue a message, it is written with the next Flush() (or when the buffer is full)
 	bool Send(const uint8_t message_id, const void *payload);
 
+	// write all queued messages with a single write
+	bool Flush();
+
 private:
+	static constexpr int TX_BUFFER_SIZE = 512;
+
 	int _fd{-1};
+
+	uint8_t _tx_buffer[TX_BUFFER_SIZE] {};
+	int _tx_length{0};
 };
 
@@ -373,13 +373,55 @@ void MspOsd::Run()
 
 	// send full configuration
 	SendConfig();
+
+	// write all changed elements of this update at once
+	if (!_msp.Flush()) {
+		_performance_data.unsuccessful_sends++;
+
+		// resend everything with the next update
+		_sent_message_count = 0;
+	}
 }
 
 void MspOsd::Send(const unsigned int message_type, const void *payload)
 {
+	// FNV-1a hash of the payload to detect changed elements
+	const uint8_t *data = static_cast<const uint8_t *>(payload);
+	const int size = _msp.GetMessageSize(message_type);
+	uint32_t hash = 2166136261u;
+
+	for (int i = 0; i < size; i++) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+	SentMessage *sent = nullptr;
+
+	for (int i = 0; i < _sent_message_count; i++) {
+		if (_sent_messages[i].message_type == message_type) {
+			sent = &_sent_messages[i];
+			break;
+		}
+	}
+
+	if (sent && (sent->hash == hash) && (now < sent->timestamp + MESSAGE_REFRESH_INTERVAL)) {
+		_performance_data.skipped_sends++;
+		return;
+	}
+
 	if (_msp.Send(message_type, payload)) {
 		_performance_data.successful_sends++;
 
+		if (!sent && (_sent_message_count < MAX_MESSAGE_TYPES)) {
+			sent = &_sent_messages[_sent_message_count++];
+			sent->message_type = message_type;
+		}
+
+		if (sent) {
+			sent->hash = hash;
+			sent->timestamp = now;
+		}
+
 	} else {
 		_performance_data.unsuccessful_sends++;
 	}
@@ -459,6 +501,7 @@ int MspOsd::print_status()
 	PX4_INFO("\tscroll rate: %d", static_cast<int>(_param_osd_scroll_rate.get()));
 	PX4_INFO("\tsuccessful sends: %lu", _performance_data.successful_sends);
 	PX4_INFO("\tunsuccessful sends: %lu", _performance_data.unsuccessful_sends);
+	PX4_INFO("\tskipped (unchanged) sends: %lu", _performance_data.skipped_sends);
 
 	// print current display string
 	char msg[FULL_MSG_BUFFER];
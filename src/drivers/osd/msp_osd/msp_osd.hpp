@@ -69,6 +69,7 @@ struct PerformanceData {
 	bool initialization_problems{false};
 	long unsigned int successful_sends{0};
 	long unsigned int unsuccessful_sends{0};
+	long unsigned int skipped_sends{0};
 };
 
 // mapping from symbol name to bit in the parameter bitmask
@@ -122,7 +123,7 @@ public:
 private:
 	void Run() override;
 
-	// update a single display element in the display
+	// update a single display element in the display (skipped if it did not change)
 	void Send(const unsigned int message_type, const void *payload);
 
 	// send full configuration to MSP (triggers the actual update)
@@ -161,6 +162,19 @@ private:
 	// local heartbeat
 	bool _heartbeat{false};
 
+	// last payload sent per message type, unchanged elements are only refreshed every MESSAGE_REFRESH_INTERVAL
+	struct SentMessage {
+		unsigned int message_type;
+		uint32_t hash;
+		hrt_abstime timestamp;
+	};
+
+	static constexpr int MAX_MESSAGE_TYPES = 16;
+	static constexpr hrt_abstime MESSAGE_REFRESH_INTERVAL{1_s};
+
+	SentMessage _sent_messages[MAX_MESSAGE_TYPES] {};
+	int _sent_message_count{0};
+
 	// parameters
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::OSD_SYMBOLS>) _param_osd_symbols,
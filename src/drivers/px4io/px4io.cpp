@@ -109,7 +109,7 @@ public:
 	 * Initialize all class variables.
 	 */
 	PX4IO() = delete;
-	explicit PX4IO(device::Device *interface);
+	explicit PX4IO(PX4IO_serial *interface);
 
 	~PX4IO() override;
 
@@ -169,7 +169,7 @@ private:
 
 	static constexpr int PX4IO_MAX_ACTUATORS = 8;
 
-	device::Device *const _interface;
+	PX4IO_serial *const _interface;
 
 	unsigned		_hardware{0};		///< Hardware revision
 	unsigned		_max_actuators{0};		///< Maximum # of actuators supported by PX4IO
@@ -196,6 +196,10 @@ private:
 	uint16_t		_last_written_arming_s{0};	///< the last written arming state reg
 	uint16_t		_last_written_arming_c{0};	///< the last written arming state reg
 
+	uint16_t		_exchange_reply[PX4IO_EXCHANGE_COUNT] {};	///< IO state received with the last output update
+	bool			_exchange_reply_updated{false};
+	bool			_exchange_status_valid{false};	///< _exchange_reply status is newer than the last status poll
+
 	uORB::Subscription	_t_actuator_armed{ORB_ID(actuator_armed)};		///< system armed control topic
 	uORB::Subscription	_t_vehicle_command{ORB_ID(vehicle_command)};	///< vehicle command topic
 	uORB::Subscription	_t_vehicle_status{ORB_ID(vehicle_status)};		///< vehicle status topic
@@ -242,16 +246,18 @@ private:
 	 * Fetch status and alarms from IO
 	 *
 	 * Also publishes battery voltage/current.
+	 *
+	 * @param status_regs	Status registers received with the outputs (PX4IO_EXCHANGE_STATUS), nullptr to read them.
 	 */
-	int			io_get_status();
+	int			io_get_status(const uint16_t *status_regs = nullptr);
 
 	/**
 	 * Fetch RC inputs from IO.
 	 *
-	 * @param input_rc	Input structure to populate.
+	 * @param rc_regs	R/C registers received with the outputs (PX4IO_EXCHANGE_RAW_RC), nullptr to read them.
 	 * @return		OK if data was returned.
 	 */
-	int			io_publish_raw_rc();
+	int			io_publish_raw_rc(const uint16_t *rc_regs = nullptr);
 
 	/**
 	 * write register(s)
@@ -295,6 +301,17 @@ private:
 	uint32_t		io_reg_get(uint8_t page, uint8_t offset);
 	static const uint32_t	_io_reg_get_error = 0x80000000;
 
+	/**
+	 * write register(s) and receive the exchange registers (status and R/C input state) in the same transaction
+	 *
+	 * @param page		Register page to write to.
+	 * @param offset	Register offset to start writing at.
+	 * @param values	Pointer to array of values to write.
+	 * @param num_values	The number of values to write.
+	 * @return		OK if all values were written and _exchange_reply was updated.
+	 */
+	int			io_reg_exchange(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+
 	/**
 	 * modify a register
 	 *
@@ -344,7 +361,7 @@ private:
 
 #define PX4IO_DEVICE_PATH	"/dev/px4io"
 
-PX4IO::PX4IO(device::Device *interface) :
+PX4IO::PX4IO(PX4IO_serial *interface) :
 	CDev(PX4IO_DEVICE_PATH),
 	OutputModuleInterface(MODULE_NAME, px4::serial_port_to_wq(PX4IO_SERIAL_DEVICE)),
 	_interface(interface)
@@ -367,8 +384,10 @@ bool PX4IO::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 			  unsigned num_outputs, unsigned num_control_groups_updated)
 {
 	if (!_test_fmu_fail) {
-		/* output to the servos */
-		io_reg_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, num_outputs);
+		/* output to the servos, IO replies with its status */
+		if (io_reg_exchange(PX4IO_PAGE_DIRECT_PWM, 0, outputs, num_outputs) == OK) {
+			_exchange_reply_updated = true;
+		}
 	}
 
 	return true;
@@ -524,15 +543,29 @@ void PX4IO::Run()
 		_mixing_output.update();
 	}
 
+	bool rc_updated = false;
+
+	if (_exchange_reply_updated) {
+		_exchange_reply_updated = false;
+		_exchange_status_valid = true;
+
+		/* the R/C frame counter came with the outputs, channels are only read for a new frame */
+		io_publish_raw_rc(&_exchange_reply[PX4IO_EXCHANGE_RAW_RC]);
+		rc_updated = true;
+	}
+
 	if (hrt_elapsed_time(&_poll_last) >= 20_ms) {
 		/* run at 50 */
 		_poll_last = hrt_absolute_time();
 
 		/* pull status and alarms from IO */
-		io_get_status();
+		io_get_status(_exchange_status_valid ? &_exchange_reply[PX4IO_EXCHANGE_STATUS] : nullptr);
+		_exchange_status_valid = false;
 
 		/* get raw R/C input from IO */
-		io_publish_raw_rc();
+		if (!rc_updated) {
+			io_publish_raw_rc();
+		}
 	}
 
 	if (_param_sys_hitl.get() <= 0) {
@@ -915,17 +948,24 @@ int PX4IO::dsm_bind_ioctl(int dsmMode)
 	return ret;
 }
 
-int PX4IO::io_get_status()
+int PX4IO::io_get_status(const uint16_t *status_regs)
 {
 	/* get
 	 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
 	 * STATUS_VSERVO, STATUS_VRSSI
 	 * in that order */
-	uint16_t regs[6] {};
-	int ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+	uint16_t regs[PX4IO_EXCHANGE_STATUS_COUNT] {};
+	int ret = OK;
 
-	if (ret != OK) {
-		return ret;
+	if (status_regs) {
+		memcpy(regs, status_regs, sizeof(regs));
+
+	} else {
+		ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
+
+		if (ret != OK) {
+			return ret;
+		}
 	}
 
 	const uint16_t STATUS_FLAGS  = regs[0];
@@ -1024,9 +1064,10 @@ int PX4IO::io_get_status()
 	return ret;
 }
 
-int PX4IO::io_publish_raw_rc()
+int PX4IO::io_publish_raw_rc(const uint16_t *rc_regs)
 {
-	const uint16_t rc_valid_update_count = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT);
+	const uint16_t rc_valid_update_count = rc_regs ? rc_regs[PX4IO_P_RAW_FRAME_COUNT] :
+					       io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT);
 	const bool rc_updated = (rc_valid_update_count != _rc_valid_update_count);
 	_rc_valid_update_count = rc_valid_update_count;
 
@@ -1050,8 +1091,17 @@ int PX4IO::io_publish_raw_rc()
 	 * Read the channel count and the first 9 channels.
 	 *
 	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
+	 * If the prolog came with the outputs, only the channels need to be read.
 	 */
-	int ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+	int ret;
+
+	if (rc_regs) {
+		memcpy(regs, rc_regs, prolog * sizeof(regs[0]));
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE, &regs[prolog], 9);
+
+	} else {
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
+	}
 
 	if (ret != OK) {
 		return ret;
@@ -1178,6 +1228,26 @@ int PX4IO::io_reg_set(uint8_t page, uint8_t offset, uint16_t value)
 	return io_reg_set(page, offset, &value, 1);
 }
 
+int PX4IO::io_reg_exchange(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	/* range check the transfer */
+	if (num_values > ((_max_transfer) / sizeof(*values))) {
+		PX4_DEBUG("io_reg_exchange: too many registers (%u, max %u)", num_values, _max_transfer / 2);
+		return -EINVAL;
+	}
+
+	perf_begin(_interface_write_perf);
+	int ret = _interface->exchange((page << 8) | offset, (void *)values, num_values, _exchange_reply);
+	perf_end(_interface_write_perf);
+
+	if (ret != (int)num_values) {
+		PX4_DEBUG("io_reg_exchange(%" PRIu8 ",%" PRIu8 ",%u): error %d", page, offset, num_values, ret);
+		return -1;
+	}
+
+	return OK;
+}
+
 int PX4IO::io_reg_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
 {
 	/* range check the transfer */
@@ -1399,9 +1469,9 @@ int PX4IO::ioctl(file *filep, int cmd, unsigned long arg)
 	return ret;
 }
 
-static device::Device *get_interface()
+static PX4IO_serial *get_interface()
 {
-	device::Device *interface = PX4IO_serial_interface();
+	PX4IO_serial *interface = PX4IO_serial_interface();
 
 	if (interface != nullptr) {
 		if (interface->init() != OK) {
@@ -1424,7 +1494,7 @@ int PX4IO::checkcrc(int argc, char *argv[])
 		return 1;
 	}
 
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("interface allocation failed");
@@ -1516,7 +1586,7 @@ int PX4IO::bind(int argc, char *argv[])
 
 int PX4IO::task_spawn(int argc, char *argv[])
 {
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("Failed to create interface");
@@ -1570,7 +1640,7 @@ int PX4IO::custom_command(int argc, char *argv[])
 
 		while (ret != OK && retries < MAX_RETRIES) {
 
-			device::Device *interface = get_interface();
+			PX4IO_serial *interface = get_interface();
 
 			if (interface == nullptr) {
 				PX4_ERR("interface allocation failed");
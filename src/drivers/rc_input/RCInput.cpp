@@ -775,6 +775,48 @@ void RCInput::Run()
 			_param_rc_input_proto.set(_rc_scan_state);
 			_param_rc_input_proto.commit();
 		}
+
+		schedule_next_run(cycle_timestamp, rc_updated);
+	}
+}
+
+void RCInput::schedule_next_run(const hrt_abstime &now, bool rc_updated)
+{
+	if (rc_updated) {
+		const hrt_abstime interval = now - _last_frame_time;
+
+		// only track consecutive frames, not the gaps of dropped ones
+		if ((_last_frame_time != 0) && (interval >= FRAME_INTERVAL_MIN) && (interval <= FRAME_INTERVAL_MAX)
+		    && ((_frame_interval == 0) || (interval < _frame_interval * 3 / 2))) {
+
+			_frame_interval = (_frame_interval == 0) ? interval : (_frame_interval * 7 + interval) / 8;
+		}
+
+		_last_frame_time = now;
+	}
+
+	if (!_rc_scan_locked) {
+		_frame_interval = 0;
+	}
+
+	const hrt_abstime since_frame = now - _last_frame_time;
+
+	if ((_frame_interval != 0) && (since_frame < 2 * _frame_interval)) {
+		// Run just before the next frame is complete, then at a short period until it is there.
+		// This keeps the delay between the end of a frame and its publication below FRAME_SYNC_RETRY.
+		hrt_abstime delay = FRAME_SYNC_RETRY;
+
+		if (_frame_interval > since_frame + FRAME_SYNC_EARLY + FRAME_SYNC_RETRY) {
+			delay = _frame_interval - since_frame - FRAME_SYNC_EARLY;
+		}
+
+		ScheduleDelayed(delay);
+		_frame_synced = true;
+
+	} else if (_frame_synced) {
+		// scanning or signal lost
+		_frame_synced = false;
+		ScheduleOnInterval(_current_update_interval);
 	}
 }
 
@@ -851,6 +893,10 @@ int RCInput::print_status()
 {
 	PX4_INFO("Max update rate: %u Hz", 1000000 / _current_update_interval);
 
+	if (_frame_synced) {
+		PX4_INFO("Synchronized to frame interval: %" PRIu64 " us", _frame_interval);
+	}
+
 	if (_device[0] != '\0') {
 		PX4_INFO("UART device: %s", _device);
 		PX4_INFO("UART RX bytes: %"  PRIu32, _bytes_rx);
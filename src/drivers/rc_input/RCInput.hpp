@@ -125,6 +125,11 @@ private:
 
 	void set_rc_scan_state(RC_SCAN _rc_scan_state);
 
+	/**
+	 * Schedule the next cycle according to the measured frame interval once the input is locked
+	 */
+	void schedule_next_run(const hrt_abstime &now, bool rc_updated);
+
 	void rc_io_invert(bool invert);
 
 	hrt_abstime _rc_scan_begin{0};
@@ -134,6 +139,15 @@ private:
 
 	static constexpr unsigned	_current_update_interval{4000}; // 250 Hz
 
+	static constexpr hrt_abstime FRAME_INTERVAL_MIN{2_ms};
+	static constexpr hrt_abstime FRAME_INTERVAL_MAX{30_ms};
+	static constexpr hrt_abstime FRAME_SYNC_EARLY{500_us};
+	static constexpr hrt_abstime FRAME_SYNC_RETRY{500_us};
+
+	hrt_abstime _last_frame_time{0};
+	hrt_abstime _frame_interval{0};		///< filtered interval between decoded frames, 0 if unknown
+	bool _frame_synced{false};
+
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
 	uORB::Subscription	_adc_report_sub{ORB_ID(adc_report)};
@@ -46,6 +46,10 @@
 #include <lib/crypto/monocypher/src/optional/monocypher-ed25519.h>
 #include <tomcrypt.h>
 
+#if defined(CONFIG_CRYPTO_AES)
+#include <nuttx/crypto/crypto.h>
+#endif
+
 extern void libtomcrypt_init(void);
 
 /* room for 16 keys */
@@ -82,6 +86,14 @@ typedef struct {
 	uint64_t ctr;
 } chacha20_context_t;
 
+/* AES-256 in counter mode, counter block is nonce || 64 bit big endian block counter */
+typedef struct {
+	uint8_t nonce[8];
+	uint64_t ctr;
+} aes_ctr_context_t;
+
+#define AES_BLOCK_SIZE 16
+
 static inline void initialize_tomcrypt(void)
 {
 	if (!tomcrypt_initialized) {
@@ -145,6 +157,63 @@ static const uint8_t *crypto_get_key_ptr(keystore_session_handle_t handle, uint8
 }
 
 
+static void aes_ctr_counter_block(const aes_ctr_context_t *context, uint64_t ctr, uint8_t block[AES_BLOCK_SIZE])
+{
+	memcpy(block, context->nonce, sizeof(context->nonce));
+
+	for (int i = 0; i < 8; i++) {
+		block[AES_BLOCK_SIZE - 1 - i] = (uint8_t)(ctr >> (8 * i));
+	}
+}
+
+static bool aes_ctr_crypt(aes_ctr_context_t *context, const uint8_t *key, const uint8_t *in, uint8_t *out,
+			  size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE];
+	const uint64_t blocks = (len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+
+#if defined(CONFIG_CRYPTO_AES)
+
+	/* Use the AES peripheral through the architecture crypto driver if there is one */
+	if (len % AES_BLOCK_SIZE == 0) {
+		aes_ctr_counter_block(context, context->ctr, block);
+
+		if (aes_cypher(out, in, len, block, key, 32, AES_MODE_CTR, CYPHER_ENCRYPT) == 0) {
+			context->ctr += blocks;
+			return true;
+		}
+	}
+
+#endif
+
+	symmetric_key skey;
+
+	if (aes_setup(key, 32, 0, &skey) != CRYPT_OK) {
+		return false;
+	}
+
+	uint8_t keystream[AES_BLOCK_SIZE];
+
+	for (uint64_t i = 0; i < blocks; i++) {
+		aes_ctr_counter_block(context, context->ctr + i, block);
+		aes_ecb_encrypt(block, keystream, &skey);
+
+		const size_t offset = i * AES_BLOCK_SIZE;
+		const size_t n = (len - offset < AES_BLOCK_SIZE) ? len - offset : AES_BLOCK_SIZE;
+
+		for (size_t k = 0; k < n; k++) {
+			out[offset + k] = in[offset + k] ^ keystream[k];
+		}
+	}
+
+	context->ctr += blocks;
+
+	zeromem(&skey, sizeof(skey));
+	zeromem(keystream, sizeof(keystream));
+	return true;
+}
+
+
 void crypto_init()
 {
 	keystore_init();
@@ -183,6 +252,21 @@ crypto_session_handle_t crypto_open(px4_crypto_algorithm_t algorithm)
 		}
 		break;
 
+	case CRYPTO_AES: {
+			aes_ctr_context_t *context = XMALLOC(sizeof(aes_ctr_context_t));
+
+			if (!context) {
+				ret.handle = 0;
+				crypto_open_count--;
+
+			} else {
+				ret.context = context;
+				px4_get_secure_random(context->nonce, sizeof(context->nonce));
+				context->ctr = 0;
+			}
+		}
+		break;
+
 	default:
 		ret.context = NULL;
 	}
@@ -275,6 +359,17 @@ bool crypto_encrypt_data(crypto_session_handle_t handle,
 		}
 		break;
 
+	case CRYPTO_AES: {
+			size_t key_sz;
+			const uint8_t *key = crypto_get_key_ptr(handle.keystore_handle, key_idx, &key_sz);
+
+			if (key_sz == 32 && *cipher_size >= message_size) {
+				ret = aes_ctr_crypt(handle.context, key, message, cipher, message_size);
+				*cipher_size = message_size;
+			}
+		}
+		break;
+
 	case CRYPTO_RSA_OAEP: {
 			rsa_key key;
 			size_t key_sz;
@@ -322,6 +417,7 @@ bool crypto_generate_key(crypto_session_handle_t handle,
 
 	switch (handle.algorithm) {
 	case CRYPTO_XCHACHA20:
+	case CRYPTO_AES:
 		if (key_cache[idx].key_size < 32) {
 			if (key_cache[idx].key_size > 0) {
 				SECMEM_FREE(key_cache[idx].key);
@@ -407,6 +503,17 @@ bool crypto_get_nonce(crypto_session_handle_t handle,
 		}
 		break;
 
+	case CRYPTO_AES: {
+			aes_ctr_context_t *context = handle.context;
+
+			if (nonce != NULL && context != NULL) {
+				memcpy(nonce, context->nonce, sizeof(context->nonce));
+			}
+
+			*nonce_len = sizeof(context->nonce);
+		}
+		break;
+
 	default:
 		*nonce_len = 0;
 	}
@@ -423,6 +530,10 @@ size_t crypto_get_min_blocksize(crypto_session_handle_t handle, uint8_t key_idx)
 		ret = 64;
 		break;
 
+	case CRYPTO_AES:
+		ret = AES_BLOCK_SIZE;
+		break;
+
 	case CRYPTO_RSA_OAEP: {
 			rsa_key enc_key;
 			size_t pub_key_sz;
@@ -341,8 +341,10 @@ void IridiumSBD::standby_loop(void)
 		_rx_session_pending = true;
 	}
 
-	// write the MO buffer when the message stacking time expires
-	if (_tx_buf_write_pending && ((hrt_absolute_time() - _last_write_time) > (uint64_t)_param_stacking_time_ms * 1000)) {
+	// write the MO buffer when the message stacking time expires, or right away if a read session is due anyway,
+	// so that the buffered messages go out with it instead of requiring another session
+	if (_tx_buf_write_pending && (_rx_session_pending
+				      || ((hrt_absolute_time() - _last_write_time) > (uint64_t)_param_stacking_time_ms * 1000))) {
 		write_tx_buf();
 	}
 
@@ -494,6 +496,7 @@ void IridiumSBD::sbdsession_loop(void)
 
 		// after a successful session reset the tx buffer
 		_tx_buf_write_idx = 0;
+		_tx_buf_packet_start_idx = 0;
 		break;
 
 	case 1:
@@ -502,6 +505,7 @@ void IridiumSBD::sbdsession_loop(void)
 
 		// after a successful session reset the tx buffer
 		_tx_buf_write_idx = 0;
+		_tx_buf_packet_start_idx = 0;
 		++_successful_sbd_sessions;
 
 		_tx_session_pending = false;
@@ -642,6 +646,8 @@ ssize_t IridiumSBD::write(struct file *filp, const char *buffer, size_t buflen)
 
 	// parsing the size of the message to write
 	if (!_writing_mavlink_packet) {
+		_tx_buf_packet_start_idx = _tx_buf_write_idx;
+
 		if (buflen < 3) {
 			_packet_length = buflen;
 
@@ -665,24 +671,40 @@ ssize_t IridiumSBD::write(struct file *filp, const char *buffer, size_t buflen)
 		}
 	}
 
-	// check if there is enough space to write the message
+	// check if there is enough space to write the message, the oldest state (HIGH_LATENCY2) is dropped first
+	while ((SATCOM_TX_BUF_LEN - _tx_buf_write_idx - _packet_length < 0)
+	       && remove_tx_buf_message(SATCOM_MSG_ID_HIGH_LATENCY2)) {
+	}
+
 	if (SATCOM_TX_BUF_LEN - _tx_buf_write_idx - _packet_length < 0) {
 		_tx_buf_write_idx = 0;
+		_tx_buf_packet_start_idx = 0;
 		++_num_tx_buf_reset;
 	}
 
 	// keep track of the remaining packet length and if the full message is written
 	_packet_length -= buflen;
 
-	if (_packet_length == 0) {
-		_writing_mavlink_packet = false;
-	}
-
 	VERBOSE_INFO("WRITE: LEN %zu, TX WRITTEN: %d", buflen, _tx_buf_write_idx);
 
 	memcpy(_tx_buf + _tx_buf_write_idx, buffer, buflen);
 
 	_tx_buf_write_idx += buflen;
+
+	if (_packet_length == 0) {
+		if (_writing_mavlink_packet) {
+			const uint8_t *packet = _tx_buf + _tx_buf_packet_start_idx;
+			const uint32_t msg_id = (packet[0] == 253) ? (packet[7] | (packet[8] << 8) | (packet[9] << 16)) : packet[5];
+
+			// a new vehicle state replaces the buffered one, the session then carries the latest state only
+			if (msg_id == SATCOM_MSG_ID_HIGH_LATENCY2) {
+				remove_tx_buf_message(SATCOM_MSG_ID_HIGH_LATENCY2);
+			}
+		}
+
+		_writing_mavlink_packet = false;
+	}
+
 	_last_write_time = hrt_absolute_time();
 	_tx_buf_write_pending = true;
 
@@ -777,6 +799,47 @@ void IridiumSBD::write_tx_buf()
 	_tx_session_pending = true;
 }
 
+bool IridiumSBD::remove_tx_buf_message(uint32_t msg_id)
+{
+	int idx = 0;
+
+	while (idx < _tx_buf_packet_start_idx) {
+		const uint8_t *packet = _tx_buf + idx;
+		const int remaining = _tx_buf_packet_start_idx - idx;
+		int length = 0;
+		uint32_t id = 0;
+
+		if ((packet[0] == 253) && (remaining >= 10)) { // mavlink 2
+			length = packet[1] + 12 + ((packet[2] & 0x1) ? 13 : 0);
+			id = packet[7] | (packet[8] << 8) | (packet[9] << 16);
+
+		} else if ((packet[0] == 254) && (remaining >= 6)) { // mavlink 1
+			length = packet[1] + 8;
+			id = packet[5];
+
+		} else {
+			// not a MAVLink message, the message boundaries are unknown
+			return false;
+		}
+
+		if (length > remaining) {
+			return false;
+		}
+
+		if (id == msg_id) {
+			memmove(_tx_buf + idx, _tx_buf + idx + length, _tx_buf_write_idx - idx - length);
+			_tx_buf_write_idx -= length;
+			_tx_buf_packet_start_idx -= length;
+			_tx_buf_write_pending = true;
+			return true;
+		}
+
+		idx += length;
+	}
+
+	return false;
+}
+
 void IridiumSBD::read_rx_buf(void)
 {
 	if (!is_modem_ready()) {
@@ -91,14 +91,14 @@ extern "C" __EXPORT int iridiumsbd_main(int argc, char *argv[]);
 #define SATCOM_RX_MSG_BUF_LEN			270		// RX buffer size for MT messages
 #define SATCOM_RX_COMMAND_BUF_LEN		50		// RX buffer size for other commands
 #define SATCOM_SIGNAL_REFRESH_DELAY		20000000 // update signal quality every 20s
+#define SATCOM_MSG_ID_HIGH_LATENCY2		235	// MAVLINK_MSG_ID_HIGH_LATENCY2, a newer one supersedes the buffered one
 
 /**
  * The driver for the Rockblock 9602 and 9603 RockBlock module for satellite communication over the Iridium satellite system.
  * The MavLink 1 protocol should be used to ensure that the status message is 50 bytes (RockBlock bills every 50 bytes per transmission).
  *
- * TODO:
- * 	- Improve TX buffer handling:
- * 		- Do not reset the full TX buffer but delete the oldest HIGH_LATENCY2 message if one is in the buffer or delete the oldest message in general
+ * The TX buffer keeps only the latest HIGH_LATENCY2 message (older states are dropped when a new one is written)
+ * and all other messages (e.g. STATUSTEXT) until they are sent in an SBD session.
  */
 class IridiumSBD : public cdev::CDev, public ModuleBase<IridiumSBD>
 {
@@ -203,6 +203,13 @@ private:
 	 */
 	void write_tx_buf();
 
+	/*
+	 * Remove the oldest complete MAVLink message with the given ID from the TX buffer
+	 * (before _tx_buf_packet_start_idx). Must be called with _tx_buf_mutex held.
+	 * @return true if a message was removed
+	 */
+	bool remove_tx_buf_message(uint32_t msg_id);
+
 	/*
 	 * Read binary data from the modem
 	 */
@@ -311,6 +318,7 @@ private:
 
 	uint8_t _tx_buf[SATCOM_TX_BUF_LEN] = {};
 	int _tx_buf_write_idx = 0;
+	int _tx_buf_packet_start_idx = 0; ///< start of the MAVLink packet currently being written
 
 	bool _tx_buf_write_pending = false;
 	bool _ring_pending = false;
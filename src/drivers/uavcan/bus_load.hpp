@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file bus_load.hpp
+ *
+ * Per node CAN bus load, from the received frames.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+
+#include <uavcan/uavcan.hpp>
+
+class UavcanBusLoad : public uavcan::IRxFrameListener
+{
+public:
+	void init(uavcan::INode &node, uint32_t bitrate)
+	{
+		_bitrate = bitrate;
+		node.getDispatcher().installRxFrameListener(this);
+	}
+
+	void handleRxFrame(const uavcan::CanRxFrame &frame, uavcan::CanIOFlags flags) override
+	{
+		// the source node ID is in the lowest 7 bits of both message and service frames (0 for anonymous frames)
+		const unsigned node_id = frame.id & uavcan::NodeID::Max;
+
+		// extended frame, including the worst case bit stuffing
+		const unsigned frame_bits = 67 + 8 * frame.dlc;
+		_bits[node_id] += frame_bits + (frame_bits - 13) / 4;
+		_frames[node_id]++;
+	}
+
+	/**
+	 * Update the per second rates, called periodically
+	 */
+	void update(hrt_abstime now)
+	{
+		using namespace time_literals;
+
+		if (now < _window_start + 1_s) {
+			return;
+		}
+
+		const float window_s = (now - _window_start) * 1e-6f;
+		_window_start = now;
+
+		for (unsigned i = 0; i < NUM_NODES; i++) {
+			_frame_rate[i] = _frames[i] / window_s;
+			_load_permille[i] = (_bitrate > 0) ? (_bits[i] * 1000.f) / (_bitrate * window_s) : 0;
+			_frames[i] = 0;
+			_bits[i] = 0;
+		}
+	}
+
+	void print_status() const
+	{
+		printf("RX bus load per node (Node ID, frames/s, load):\n");
+
+		unsigned total_permille = 0;
+
+		for (unsigned i = 0; i < NUM_NODES; i++) {
+			if (_frame_rate[i] > 0) {
+				printf("\t% 3u: %5u %3u.%u%%\n", i, _frame_rate[i], _load_permille[i] / 10, _load_permille[i] % 10);
+				total_permille += _load_permille[i];
+			}
+		}
+
+		printf("\ttotal: %u.%u%%\n", total_permille / 10, total_permille % 10);
+	}
+
+private:
+	static constexpr unsigned NUM_NODES = uavcan::NodeID::Max + 1;
+
+	uint32_t _bitrate{0};
+	hrt_abstime _window_start{0};
+
+	uint16_t _frames[NUM_NODES] {};
+	uint32_t _bits[NUM_NODES] {};
+
+	uint16_t _frame_rate[NUM_NODES] {};
+	uint16_t _load_permille[NUM_NODES] {};
+};
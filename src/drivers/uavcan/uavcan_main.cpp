@@ -447,6 +447,8 @@ UavcanNode::start(uavcan::NodeID node_id, uint32_t bitrate)
 		return node_init_res;
 	}
 
+	_instance->_bus_load.init(_instance->_node, bitrate);
+
 	_instance->ScheduleOnInterval(ScheduleIntervalMs * 1000);
 	_instance->_mixing_interface_esc.ScheduleNow();
 	_instance->_mixing_interface_servo.ScheduleNow();
@@ -679,6 +681,8 @@ UavcanNode::Run()
 
 	_node.spinOnce(); // expected to be non-blocking
 
+	_bus_load.update(hrt_absolute_time());
+
 	// check for parameter updates
 	if (_parameter_update_sub.updated()) {
 		// clear update
@@ -991,6 +995,10 @@ UavcanNode::print_info()
 
 	printf("\n");
 
+	_bus_load.print_status();
+
+	printf("\n");
+
 	printf("ESC outputs:\n");
 	_mixing_interface_esc.mixingOutput().printStatus();
 	printf("Servo outputs:\n");
@@ -51,6 +51,7 @@
 #include "actuators/servo.hpp"
 #include "allocator.hpp"
 #include "beep.hpp"
+#include "bus_load.hpp"
 #include "logmessage.hpp"
 #include "rgbled.hpp"
 #include "safety_state.hpp"
@@ -239,6 +240,8 @@ private:
 
 	uavcan::NodeInfoRetriever   _node_info_retriever;
 
+	UavcanBusLoad			_bus_load;
+
 	List<IUavcanSensorBridge *>	_sensor_bridges;		///< List of active sensor bridges
 
 	perf_counter_t			_cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time")};
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "UavcanPublisherBase.hpp"
+
+#include <uavcan/equipment/ahrs/RawIMU.hpp>
+
+#include <lib/mathlib/mathlib.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/vehicle_imu.h>
+
+namespace uavcannode
+{
+
+/**
+ * vehicle_imu -> uavcan::equipment::ahrs::RawIMU
+ *
+ * All vehicle_imu samples (queued) are integrated and sent as one transfer per
+ * publication interval, so the bus load does not depend on the IMU rate.
+ */
+class RawIMU :
+	public UavcanPublisherBase,
+	public uORB::SubscriptionCallbackWorkItem,
+	private uavcan::Publisher<uavcan::equipment::ahrs::RawIMU>
+{
+public:
+	RawIMU(px4::WorkItem *work_item, uavcan::INode &node, float rate_hz) :
+		UavcanPublisherBase(uavcan::equipment::ahrs::RawIMU::DefaultDataTypeID),
+		uORB::SubscriptionCallbackWorkItem(work_item, ORB_ID(vehicle_imu)),
+		uavcan::Publisher<uavcan::equipment::ahrs::RawIMU>(node),
+		_interval_us(1e6f / math::constrain(rate_hz, 1.f, 1000.f))
+	{
+		this->setPriority(uavcan::TransferPriority::Default);
+	}
+
+	void PrintInfo() override
+	{
+		if (uORB::SubscriptionCallbackWorkItem::advertised()) {
+			printf("\t%s -> %s:%d (%.0f Hz, %" PRIu32 " samples per transfer)\n",
+			       uORB::SubscriptionCallbackWorkItem::get_topic()->o_name,
+			       uavcan::equipment::ahrs::RawIMU::getDataTypeFullName(),
+			       uavcan::equipment::ahrs::RawIMU::DefaultDataTypeID,
+			       (double)(1e6f / _interval_us), _samples_last);
+		}
+	}
+
+	void BroadcastAnyUpdates() override
+	{
+		vehicle_imu_s imu;
+
+		// drain the queue, every sample ends up in the integrals
+		while (uORB::SubscriptionCallbackWorkItem::update(&imu)) {
+			if ((imu.gyro_device_id != _gyro_device_id) || (imu.accel_device_id != _accel_device_id)) {
+				// IMU changed (failover), don't mix the integrals of different sensors
+				reset();
+				_gyro_device_id = imu.gyro_device_id;
+				_accel_device_id = imu.accel_device_id;
+			}
+
+			const float delta_angle_dt = imu.delta_angle_dt * 1e-6f;
+			const float delta_velocity_dt = imu.delta_velocity_dt * 1e-6f;
+
+			if ((delta_angle_dt > 0.f) && (delta_velocity_dt > 0.f)) {
+				_delta_angle += matrix::Vector3f{imu.delta_angle};
+				_delta_velocity += matrix::Vector3f{imu.delta_velocity};
+				_delta_angle_dt += delta_angle_dt;
+
+				_angular_velocity_latest = matrix::Vector3f{imu.delta_angle} / delta_angle_dt;
+				_acceleration_latest = matrix::Vector3f{imu.delta_velocity} / delta_velocity_dt;
+				_samples++;
+			}
+
+			// ensure callback is registered
+			uORB::SubscriptionCallbackWorkItem::registerCallback();
+		}
+
+		if ((_samples > 0) && (_delta_angle_dt * 1e6f >= _interval_us)) {
+			uavcan::equipment::ahrs::RawIMU raw_imu{};
+
+			raw_imu.integration_interval = _delta_angle_dt;
+
+			for (int i = 0; i < 3; i++) {
+				raw_imu.rate_gyro_latest[i] = _angular_velocity_latest(i);
+				raw_imu.rate_gyro_integral[i] = _delta_angle(i);
+				raw_imu.accelerometer_latest[i] = _acceleration_latest(i);
+				raw_imu.accelerometer_integral[i] = _delta_velocity(i);
+			}
+
+			uavcan::Publisher<uavcan::equipment::ahrs::RawIMU>::broadcast(raw_imu);
+
+			_samples_last = _samples;
+			reset();
+		}
+	}
+
+private:
+	void reset()
+	{
+		_delta_angle.zero();
+		_delta_velocity.zero();
+		_delta_angle_dt = 0.f;
+		_samples = 0;
+	}
+
+	const float _interval_us;
+
+	matrix::Vector3f _delta_angle{};
+	matrix::Vector3f _delta_velocity{};
+	float _delta_angle_dt{0.f}; ///< integration interval of both integrals (the accel and gyro integration of vehicle_imu are synchronized)
+
+	matrix::Vector3f _angular_velocity_latest{};
+	matrix::Vector3f _acceleration_latest{};
+
+	uint32_t _gyro_device_id{0};
+	uint32_t _accel_device_id{0};
+
+	uint32_t _samples{0};
+	uint32_t _samples_last{0};
+};
+} // namespace uavcannode
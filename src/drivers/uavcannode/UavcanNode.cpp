@@ -47,6 +47,7 @@
 #include "Publishers/MovingBaselineData.hpp"
 #include "Publishers/RangeSensorMeasurement.hpp"
 #include "Publishers/RawAirData.hpp"
+#include "Publishers/RawIMU.hpp"
 #include "Publishers/RelPosHeading.hpp"
 #include "Publishers/SafetyButton.hpp"
 #include "Publishers/StaticPressure.hpp"
@@ -309,6 +310,13 @@ int UavcanNode::init(uavcan::NodeID node_id, UAVCAN_DRIVER::BusEvent &bus_events
 		_publisher_list.add(new MovingBaselineDataPub(this, _node));
 	}
 
+	float cannode_pub_imu = 0.f;
+	param_get(param_find("CANNODE_PUB_IMU"), &cannode_pub_imu);
+
+	if (cannode_pub_imu > 0.f) {
+		_publisher_list.add(new RawIMU(this, _node, cannode_pub_imu));
+	}
+
 	_publisher_list.add(new SafetyButton(this, _node));
 	_publisher_list.add(new StaticPressure(this, _node));
 	_publisher_list.add(new StaticTemperature(this, _node));
@@ -70,9 +70,10 @@ void FakeMagnetometer::Run()
 				const double lon = gps.lon / 1.e7;
 
 				// magnetic field data returned by the geo library using the current GPS position
-				const float mag_declination_gps = get_mag_declination_radians(lat, lon);
-				const float mag_inclination_gps = get_mag_inclination_radians(lat, lon);
-				const float mag_strength_gps = get_mag_strength_gauss(lat, lon);
+				const MagField mag_field = get_mag_field(lat, lon);
+				const float mag_declination_gps = mag_field.declination;
+				const float mag_inclination_gps = mag_field.inclination;
+				const float mag_strength_gps = mag_field.strength;
 
 				_mag_earth_pred = Dcmf(Eulerf(0, -mag_inclination_gps, mag_declination_gps)) * Vector3f(mag_strength_gps, 0, 0);
 
@@ -49,12 +49,24 @@ static constexpr uint64_t Z_PROGRESS_TIMEOUT_US = 2_s;
 
 ObstacleAvoidance::ObstacleAvoidance(ModuleParams *parent) :
 	ModuleParams(parent)
+{
+	reset();
+}
+
+void ObstacleAvoidance::reset()
 {
 	_desired_waypoint = empty_trajectory_waypoint;
+	_curr_wp.zero();
+	_position.zero();
 	_failsafe_position.setNaN();
+
+	_avoidance_point_not_valid_hysteresis = systemlib::Hysteresis{false};
 	_avoidance_point_not_valid_hysteresis.set_hysteresis_time_from(false, TIME_BEFORE_FAILSAFE);
+	_no_progress_z_hysteresis = systemlib::Hysteresis{false};
 	_no_progress_z_hysteresis.set_hysteresis_time_from(false, Z_PROGRESS_TIMEOUT_US);
 
+	_prev_pos_to_target_z = -1.f;
+	_ext_yaw_active = false;
 }
 
 void ObstacleAvoidance::injectAvoidanceSetpoints(Vector3f &pos_sp, Vector3f &vel_sp, float &yaw_sp,
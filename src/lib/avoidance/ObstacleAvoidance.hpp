@@ -83,6 +83,11 @@ public:
 	 */
 	void injectAvoidanceSetpoints(matrix::Vector3f &pos_sp, matrix::Vector3f &vel_sp, float &yaw_sp, float &yaw_speed_sp);
 
+	/**
+	 * Reset to the initial state, e.g. when the flight task using it gets activated again.
+	 */
+	void reset();
+
 	/**
 	 * Updates the desired waypoints to send to the obstacle avoidance system. These messages don't have any direct impact on the flight.
 	 * @param curr_wp, current position triplet
@@ -52,6 +52,7 @@ class ObstacleAvoidance
 public:
 	ObstacleAvoidance(void *) {} // takes void* argument to be compatible with ModuleParams constructor
 
+	void reset() {}
 
 	void injectAvoidanceSetpoints(matrix::Vector3f &pos_sp, matrix::Vector3f &vel_sp, float &yaw_sp,
 				      float &yaw_speed_sp)
@@ -87,6 +87,9 @@ Battery::Battery(int index, ModuleParams *parent, const int sample_interval_us,
 	snprintf(param_name, sizeof(param_name), "BAT%d_R_INTERNAL", _index);
 	_param_handles.r_internal = param_find(param_name);
 
+	snprintf(param_name, sizeof(param_name), "BAT%d_CHEMISTRY", _index);
+	_param_handles.chemistry = param_find(param_name);
+
 	snprintf(param_name, sizeof(param_name), "BAT%d_SOURCE", _index);
 	_param_handles.source = param_find(param_name);
 
@@ -215,7 +218,9 @@ void Battery::estimateStateOfCharge(const float voltage_v, const float current_a
 		cell_voltage += throttle * _params.v_load_drop;
 	}
 
-	_state_of_charge_volt_based = math::interpolate(cell_voltage, _params.v_empty, _params.v_charged, 0.f, 1.f);
+	_voltage_normalized = math::interpolate(cell_voltage, _params.v_empty, _params.v_charged, 0.f, 1.f);
+	_state_of_charge_volt_based = _state_of_charge_curve ? math::interpolateN(_voltage_normalized, *_state_of_charge_curve)
+				      : _voltage_normalized;
 
 	// choose which quantity we're using for final reporting
 	if (_params.capacity > 0.f && _battery_initialized) {
@@ -256,7 +261,7 @@ void Battery::computeScale()
 	const float voltage_range = (_params.v_charged - _params.v_empty);
 
 	// reusing capacity calculation to get single cell voltage before drop
-	const float bat_v = _params.v_empty + (voltage_range * _state_of_charge_volt_based);
+	const float bat_v = _params.v_empty + (voltage_range * _voltage_normalized);
 
 	_scale = _params.v_charged / bat_v;
 
@@ -307,12 +312,27 @@ void Battery::updateParams()
 	param_get(_param_handles.capacity, &_params.capacity);
 	param_get(_param_handles.v_load_drop, &_params.v_load_drop);
 	param_get(_param_handles.r_internal, &_params.r_internal);
+	param_get(_param_handles.chemistry, &_params.chemistry);
 	param_get(_param_handles.source, &_params.source);
 	param_get(_param_handles.low_thr, &_params.low_thr);
 	param_get(_param_handles.crit_thr, &_params.crit_thr);
 	param_get(_param_handles.emergen_thr, &_params.emergen_thr);
 	param_get(_param_handles.bat_avrg_current, &_params.bat_avrg_current);
 
+	// state of charge at 0%, 10%, ..., 100% of the voltage range between v_empty and v_charged,
+	// derived from typical open circuit voltage curves
+	static constexpr float STATE_OF_CHARGE_CURVE[][11] {
+		{ 0.f, .06f, .15f, .35f, .55f, .66f, .75f, .83f, .9f, .96f, 1.f }, // LiPo
+		{ 0.f, .1f, .2f, .3f, .42f, .54f, .65f, .75f, .85f, .93f, 1.f }, // Li-ion
+	};
+
+	if (_params.chemistry >= 1 && _params.chemistry <= (int)(sizeof(STATE_OF_CHARGE_CURVE) / sizeof(STATE_OF_CHARGE_CURVE[0]))) {
+		_state_of_charge_curve = &STATE_OF_CHARGE_CURVE[_params.chemistry - 1];
+
+	} else {
+		_state_of_charge_curve = nullptr;
+	}
+
 	ModuleParams::updateParams();
 
 	_first_parameter_update = false;
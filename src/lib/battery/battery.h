@@ -116,6 +116,7 @@ protected:
 		param_t capacity;
 		param_t v_load_drop;
 		param_t r_internal;
+		param_t chemistry;
 		param_t low_thr;
 		param_t crit_thr;
 		param_t emergen_thr;
@@ -130,6 +131,7 @@ protected:
 		float capacity;
 		float v_load_drop;
 		float r_internal;
+		int32_t chemistry;
 		float low_thr;
 		float crit_thr;
 		float emergen_thr;
@@ -165,7 +167,9 @@ private:
 	AlphaFilter<float> _throttle_filter;
 	float _discharged_mah{0.f};
 	float _discharged_mah_loop{0.f};
+	float _voltage_normalized{0.f}; // cell voltage between v_empty and v_charged [0,1]
 	float _state_of_charge_volt_based{-1.f}; // [0,1]
+	const float (*_state_of_charge_curve)[11] {nullptr}; ///< state of charge over _voltage_normalized, nullptr for linear
 	float _state_of_charge{-1.f}; // [0,1]
 	float _scale{1.f};
 	uint8_t _warning{battery_status_s::BATTERY_WARNING_NONE};
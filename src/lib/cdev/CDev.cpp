@@ -313,6 +313,11 @@ CDev::poll_notify(px4_pollevent_t events)
 {
 	PX4_DEBUG("CDev::poll_notify events = %0x", events);
 
+	/* nobody ever polled, avoid taking the lock (poll() checks the state after storing the waiter) */
+	if (__atomic_load_n(&_max_pollwaiters, __ATOMIC_SEQ_CST) == 0) {
+		return;
+	}
+
 	/* lock against poll() as well as other wakeups */
 	ATOMIC_ENTER;
 
@@ -87,6 +87,9 @@ CollisionPrevention::CollisionPrevention(ModuleParams *parent) :
 		_data_maxranges[i] = 0;
 		_data_fov[i] = 0;
 		_obstacle_map_body_frame.distances[i] = UINT16_MAX;
+
+		const float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
+		_bin_direction_body[i] = {cosf(angle), sinf(angle)};
 	}
 }
 
@@ -224,6 +227,28 @@ CollisionPrevention::_updateObstacleMap()
 		}
 	}
 
+	// add multi-zone distance sensor data
+	for (auto &dist_sens_array_sub : _distance_sensor_array_subs) {
+		distance_sensor_array_s distance_sensor_array;
+
+		if (dist_sens_array_sub.update(&distance_sensor_array)) {
+			// consider only instances with valid data and orientations useful for collision prevention
+			if ((getElapsedTime(&distance_sensor_array.timestamp) < RANGE_STREAM_TIMEOUT_US) &&
+			    (distance_sensor_array.orientation != distance_sensor_s::ROTATION_DOWNWARD_FACING) &&
+			    (distance_sensor_array.orientation != distance_sensor_s::ROTATION_UPWARD_FACING)) {
+
+				// update message description
+				_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, distance_sensor_array.timestamp);
+				_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
+									(uint16_t)(distance_sensor_array.max_distance * 100.0f));
+				_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
+									(uint16_t)(distance_sensor_array.min_distance * 100.0f));
+
+				_addDistanceSensorArrayData(distance_sensor_array, Quatf(_sub_vehicle_attitude.get().q));
+			}
+		}
+	}
+
 	// add obstacle distance data
 	if (_sub_obstacle_distance.update()) {
 		const obstacle_distance_s &obstacle_distance = _sub_obstacle_distance.get();
@@ -253,7 +278,8 @@ CollisionPrevention::_addDistanceSensorData(distance_sensor_s &distance_sensor,
 	// discard values below min range
 	if ((distance_reading > distance_sensor.min_distance)) {
 
-		float sensor_yaw_body_rad = _sensorOrientationToYawOffset(distance_sensor, _obstacle_map_body_frame.angle_offset);
+		float sensor_yaw_body_rad = _sensorOrientationToYawOffset(distance_sensor.orientation, distance_sensor.q,
+					    _obstacle_map_body_frame.angle_offset);
 		float sensor_yaw_body_deg = math::degrees(wrap_2pi(sensor_yaw_body_rad));
 
 		// calculate the field of view boundary bin indices
@@ -291,6 +317,114 @@ CollisionPrevention::_addDistanceSensorData(distance_sensor_s &distance_sensor,
 	}
 }
 
+void
+CollisionPrevention::_addDistanceSensorArrayData(const distance_sensor_array_s &distance_sensor_array,
+		const matrix::Quatf &vehicle_attitude)
+{
+	const uint8_t zones_h = distance_sensor_array.zones_h;
+	const uint8_t zones_v = distance_sensor_array.zones_v;
+
+	if ((zones_h == 0) || (zones_v == 0)
+	    || (zones_h > distance_sensor_array_s::ZONES_PER_AXIS_MAX) || (zones_v > distance_sensor_array_s::ZONES_PER_AXIS_MAX)
+	    || (zones_h * zones_v > distance_sensor_array_s::ZONES_MAX)) {
+		return;
+	}
+
+	ZoneDirections &dir = _zone_directions;
+
+	// the zone directions only change with the sensor geometry
+	if ((dir.device_id != distance_sensor_array.device_id) || (dir.zones_h != zones_h) || (dir.zones_v != zones_v)
+	    || (fabsf(dir.h_fov - distance_sensor_array.h_fov) > FLT_EPSILON)
+	    || (fabsf(dir.v_fov - distance_sensor_array.v_fov) > FLT_EPSILON)) {
+
+		// columns from left to right
+		for (int column = 0; column < zones_h; column++) {
+			const float azimuth = distance_sensor_array.h_fov * ((column + 0.5f) / zones_h - 0.5f);
+			dir.cos_az[column] = cosf(azimuth);
+			dir.sin_az[column] = sinf(azimuth);
+		}
+
+		// rows from top to bottom
+		for (int row = 0; row < zones_v; row++) {
+			const float elevation = distance_sensor_array.v_fov * (0.5f - (row + 0.5f) / zones_v);
+			dir.cos_el[row] = cosf(elevation);
+			dir.sin_el[row] = sinf(elevation);
+		}
+
+		dir.device_id = distance_sensor_array.device_id;
+		dir.zones_h = zones_h;
+		dir.zones_v = zones_v;
+		dir.h_fov = distance_sensor_array.h_fov;
+		dir.v_fov = distance_sensor_array.v_fov;
+	}
+
+	// rotation from the sensor frame into the levelled body frame (vehicle yaw removed)
+	Dcmf R_sensor;
+
+	if (distance_sensor_array.orientation == distance_sensor_s::ROTATION_CUSTOM) {
+		R_sensor = Dcmf(Quatf(distance_sensor_array.q));
+
+	} else {
+		R_sensor = Dcmf(Eulerf(0.f, 0.f, _sensorOrientationToYawOffset(distance_sensor_array.orientation,
+					distance_sensor_array.q, _obstacle_map_body_frame.angle_offset)));
+	}
+
+	const Eulerf euler{vehicle_attitude};
+	const Dcmf R_level_sensor = Dcmf(Eulerf(euler.phi(), euler.theta(), 0.f)) * R_sensor;
+
+	// project all zones and keep the closest reading per bin, then update the map once per bin
+	float bin_distance[INTERNAL_MAP_USED_BINS];
+
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
+		bin_distance[i] = INFINITY;
+	}
+
+	const float max_distance = distance_sensor_array.max_distance;
+
+	for (int row = 0; row < zones_v; row++) {
+		for (int column = 0; column < zones_h; column++) {
+			float distance_reading = distance_sensor_array.distances[row * zones_h + column];
+
+			// discard invalid values and values below min range (also NAN)
+			if (!(distance_reading > distance_sensor_array.min_distance)) {
+				continue;
+			}
+
+			const Vector3f zone_dir = R_level_sensor * Vector3f(dir.cos_el[row] * dir.cos_az[column],
+						  dir.cos_el[row] * dir.sin_az[column], -dir.sin_el[row]);
+			const float horizontal_scale = sqrtf(zone_dir(0) * zone_dir(0) + zone_dir(1) * zone_dir(1));
+
+			// zone points (almost) straight up or down
+			if (horizontal_scale < 0.1f) {
+				continue;
+			}
+
+			// clamp at maximum sensor range, project readings in range into the horizontal plane
+			if (distance_reading < max_distance) {
+				distance_reading *= horizontal_scale;
+
+			} else {
+				distance_reading = max_distance;
+			}
+
+			const float zone_yaw_deg = math::degrees(atan2f(zone_dir(1), zone_dir(0))) - _obstacle_map_body_frame.angle_offset;
+			const int bin = wrap_bin((int)floorf(wrap_360(zone_yaw_deg) / INTERNAL_MAP_INCREMENT_DEG));
+			bin_distance[bin] = math::min(bin_distance[bin], distance_reading);
+		}
+	}
+
+	const uint16_t sensor_range = static_cast<uint16_t>(100.0f * max_distance + 0.5f); // convert to cm
+
+	for (int bin = 0; bin < INTERNAL_MAP_USED_BINS; bin++) {
+		if (PX4_ISFINITE(bin_distance[bin]) && _enterData(bin, max_distance, bin_distance[bin])) {
+			_obstacle_map_body_frame.distances[bin] = static_cast<uint16_t>(100.0f * bin_distance[bin] + 0.5f);
+			_data_timestamps[bin] = _obstacle_map_body_frame.timestamp;
+			_data_maxranges[bin] = sensor_range;
+			_data_fov[bin] = 1;
+		}
+	}
+}
+
 void
 CollisionPrevention::_adaptSetpointDirection(Vector2f &setpoint_dir, int &setpoint_index, float vehicle_yaw_angle_rad)
 {
@@ -338,11 +472,11 @@ CollisionPrevention::_adaptSetpointDirection(Vector2f &setpoint_dir, int &setpoi
 }
 
 float
-CollisionPrevention::_sensorOrientationToYawOffset(const distance_sensor_s &distance_sensor, float angle_offset) const
+CollisionPrevention::_sensorOrientationToYawOffset(uint8_t orientation, const float q[4], float angle_offset) const
 {
 	float offset = angle_offset > 0.0f ? math::radians(angle_offset) : 0.0f;
 
-	switch (distance_sensor.orientation) {
+	switch (orientation) {
 	case distance_sensor_s::ROTATION_YAW_0:
 		offset = 0.0f;
 		break;
@@ -376,7 +510,7 @@ CollisionPrevention::_sensorOrientationToYawOffset(const distance_sensor_s &dist
 		break;
 
 	case distance_sensor_s::ROTATION_CUSTOM:
-		offset = matrix::Eulerf(matrix::Quatf(distance_sensor.q)).psi();
+		offset = matrix::Eulerf(matrix::Quatf(q)).psi();
 		break;
 	}
 
@@ -419,6 +553,10 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 			// change setpoint direction slightly (max by _param_cp_guide_ang degrees) to help guide through narrow gaps
 			_adaptSetpointDirection(setpoint_dir, sp_index, vehicle_yaw_angle_rad);
 
+			// rotation of the bin directions from body to local frame
+			const float cos_yaw = cosf(vehicle_yaw_angle_rad);
+			const float sin_yaw = sinf(vehicle_yaw_angle_rad);
+
 			// limit speed for safe flight
 			for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) { // disregard unused bins at the end of the message
 
@@ -431,13 +569,12 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 
 				const float distance = _obstacle_map_body_frame.distances[i] * 0.01f; // convert to meters
 				const float max_range = _data_maxranges[i] * 0.01f; // convert to meters
-				float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-
-				// convert from body to local frame in the range [0, 2*pi]
-				angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
 
-				// get direction of current bin
-				const Vector2f bin_direction = {cosf(angle), sinf(angle)};
+				// get direction of current bin in local frame
+				const Vector2f &bin_body = _bin_direction_body[i];
+				const Vector2f bin_direction = {cos_yaw * bin_body(0) - sin_yaw * bin_body(1),
+								sin_yaw * bin_body(0) + cos_yaw * bin_body(1)
+							       };
 
 				//count number of bins in the field of valid_new
 				if (_obstacle_map_body_frame.distances[i] < UINT16_MAX) {
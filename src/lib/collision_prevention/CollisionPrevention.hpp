@@ -54,6 +54,7 @@
 #include <uORB/SubscriptionMultiArray.hpp>
 #include <uORB/topics/collision_constraints.h>
 #include <uORB/topics/distance_sensor.h>
+#include <uORB/topics/distance_sensor_array.h>
 #include <uORB/topics/mavlink_log.h>
 #include <uORB/topics/obstacle_distance.h>
 #include <uORB/topics/vehicle_attitude.h>
@@ -89,9 +90,19 @@ protected:
 	uint64_t _data_timestamps[sizeof(_obstacle_map_body_frame.distances) / sizeof(_obstacle_map_body_frame.distances[0])];
 	uint16_t _data_maxranges[sizeof(_obstacle_map_body_frame.distances) / sizeof(
 										    _obstacle_map_body_frame.distances[0])]; /**< in cm */
+	matrix::Vector2f _bin_direction_body[sizeof(_obstacle_map_body_frame.distances) / sizeof(
+			_obstacle_map_body_frame.distances[0])]; /**< unit vector of the bin centerline, body frame */
 
 	void _addDistanceSensorData(distance_sensor_s &distance_sensor, const matrix::Quatf &vehicle_attitude);
 
+	/**
+	 * Updates the obstacle map with all zones of a multi-zone distance sensor frame
+	 * @param distance_sensor_array, multi-zone distance sensor frame
+	 * @param vehicle_attitude, vehicle attitude
+	 */
+	void _addDistanceSensorArrayData(const distance_sensor_array_s &distance_sensor_array,
+					 const matrix::Quatf &vehicle_attitude);
+
 	/**
 	 * Updates obstacle distance message with measurement from offboard
 	 * @param obstacle, obstacle_distance message to be updated
@@ -134,6 +145,22 @@ private:
 	uORB::SubscriptionData<obstacle_distance_s> _sub_obstacle_distance{ORB_ID(obstacle_distance)}; /**< obstacle distances received form a range sensor */
 	uORB::SubscriptionData<vehicle_attitude_s> _sub_vehicle_attitude{ORB_ID(vehicle_attitude)};
 	uORB::SubscriptionMultiArray<distance_sensor_s> _distance_sensor_subs{ORB_ID::distance_sensor};
+	uORB::SubscriptionMultiArray<distance_sensor_array_s> _distance_sensor_array_subs{ORB_ID::distance_sensor_array};
+
+	/**
+	 * Zone directions of the last multi-zone sensor geometry, separated into columns (azimuth) and rows (elevation)
+	 */
+	struct ZoneDirections {
+		uint32_t device_id{0};
+		uint8_t zones_h{0};
+		uint8_t zones_v{0};
+		float h_fov{0.f};
+		float v_fov{0.f};
+		float cos_az[distance_sensor_array_s::ZONES_PER_AXIS_MAX];
+		float sin_az[distance_sensor_array_s::ZONES_PER_AXIS_MAX];
+		float cos_el[distance_sensor_array_s::ZONES_PER_AXIS_MAX];
+		float sin_el[distance_sensor_array_s::ZONES_PER_AXIS_MAX];
+	} _zone_directions{};
 
 	static constexpr uint64_t RANGE_STREAM_TIMEOUT_US{500_ms};
 	static constexpr uint64_t TIMEOUT_HOLD_US{5_s};
@@ -153,10 +180,11 @@ private:
 
 	/**
 	 * Transforms the sensor orientation into a yaw in the local frame
-	 * @param distance_sensor, distance sensor message
+	 * @param orientation, sensor orientation (distance_sensor_s::ROTATION_*)
+	 * @param q, sensor orientation quaternion for ROTATION_CUSTOM
 	 * @param angle_offset, sensor body frame offset
 	 */
-	float _sensorOrientationToYawOffset(const distance_sensor_s &distance_sensor, float angle_offset) const;
+	float _sensorOrientationToYawOffset(uint8_t orientation, const float q[4], float angle_offset) const;
 
 	/**
 	 * Computes collision free setpoints
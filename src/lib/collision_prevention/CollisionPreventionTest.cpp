@@ -57,6 +57,11 @@ public:
 	{
 		_addDistanceSensorData(distance_sensor, attitude);
 	}
+	void test_addDistanceSensorArrayData(const distance_sensor_array_s &distance_sensor_array,
+					     const matrix::Quatf &attitude)
+	{
+		_addDistanceSensorArrayData(distance_sensor_array, attitude);
+	}
 	void test_addObstacleSensorData(const obstacle_distance_s &obstacle, const matrix::Quatf &attitude)
 	{
 		_addObstacleSensorData(obstacle, attitude);
@@ -702,6 +707,61 @@ TEST_F(CollisionPreventionTest, addDistanceSensorData)
 
 }
 
+TEST_F(CollisionPreventionTest, addDistanceSensorArrayData)
+{
+	// GIVEN: a vehicle attitude and a forward facing 8x8 zone distance sensor frame
+	TestCollisionPrevention cp;
+	cp.getObstacleMap().increment = 10.f;
+	matrix::Quaternion<float> vehicle_attitude(1, 0, 0, 0); //unit transform
+	distance_sensor_array_s distance_sensor_array {};
+	distance_sensor_array.min_distance = 0.1f;
+	distance_sensor_array.max_distance = 4.f;
+	distance_sensor_array.zones_h = 8;
+	distance_sensor_array.zones_v = 8;
+	distance_sensor_array.h_fov = math::radians(45.f);
+	distance_sensor_array.v_fov = math::radians(45.f);
+	distance_sensor_array.orientation = distance_sensor_s::ROTATION_FORWARD_FACING;
+
+	uint32_t distances_array_size = sizeof(cp.getObstacleMap().distances) / sizeof(cp.getObstacleMap().distances[0]);
+
+	//WHEN: all zones are invalid
+	for (int i = 0; i < 64; i++) {
+		distance_sensor_array.distances[i] = NAN;
+	}
+
+	cp.test_addDistanceSensorArrayData(distance_sensor_array, vehicle_attitude);
+
+	//THEN: the map should not change
+	for (uint32_t i = 0; i < distances_array_size; i++) {
+		EXPECT_FLOAT_EQ(cp.getObstacleMap().distances[i], UINT16_MAX);
+	}
+
+	//WHEN: the sensor sees a wall 2m in front of the vehicle
+	for (int row = 0; row < 8; row++) {
+		const float elevation = math::radians(45.f) * (0.5f - (row + 0.5f) / 8.f);
+
+		for (int column = 0; column < 8; column++) {
+			const float azimuth = math::radians(45.f) * ((column + 0.5f) / 8.f - 0.5f);
+			distance_sensor_array.distances[row * 8 + column] = 2.f / (cosf(elevation) * cosf(azimuth));
+		}
+	}
+
+	cp.test_addDistanceSensorArrayData(distance_sensor_array, vehicle_attitude);
+
+	//THEN: the bins within the field of view contain the horizontal distance along their closest zone
+	for (uint32_t i = 0; i < distances_array_size; i++) {
+		if (i == 0 || i == 35) {
+			EXPECT_FLOAT_EQ(cp.getObstacleMap().distances[i], 200);
+
+		} else if (i == 1 || i == 34) {
+			EXPECT_FLOAT_EQ(cp.getObstacleMap().distances[i], 206);
+
+		} else {
+			EXPECT_FLOAT_EQ(cp.getObstacleMap().distances[i], UINT16_MAX);
+		}
+	}
+}
+
 TEST_F(CollisionPreventionTest, addObstacleSensorData_attitude)
 {
 	// GIVEN: a vehicle attitude and obstacle distance message
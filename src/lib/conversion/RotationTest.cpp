@@ -64,6 +64,89 @@ TEST(Rotations, matrix_vs_3f)
 	}
 }
 
+TEST(Rotations, axis_vs_3f)
+{
+	// every rotation handled by rotate_3() has an exact axis permutation and the other way around
+	for (size_t i = 0; i < (size_t)Rotation::ROTATION_MAX; i++) {
+
+		// GIVEN: an initial vector and a rotation
+		const matrix::Vector3f original = {1.f, 2.f, 3.f};
+		const enum Rotation rotation = static_cast<Rotation>(i);
+
+		matrix::Vector3f transformed_3 = original;
+		const bool handled = rotate_3(rotation, transformed_3(0), transformed_3(1), transformed_3(2));
+
+		// WHEN: we transform the vector using the axis permutation and the prepared rotation
+		const rot_axis_t rot_axis = get_rot_axis(rotation);
+		EXPECT_EQ(rot_axis.valid, handled) << "rotation " << i;
+
+		matrix::Vector3f transformed_prepared = original;
+		const PreparedRotation prepared{rotation};
+		prepared.apply(transformed_prepared(0), transformed_prepared(1), transformed_prepared(2));
+		EXPECT_EQ(prepared.axis_aligned(), handled) << "rotation " << i;
+
+		matrix::Vector3f transformed_3f = original;
+		rotate_3f(rotation, transformed_3f(0), transformed_3f(1), transformed_3f(2));
+
+		// THEN: the results should be the same (exactly for axis aligned rotations)
+		if (rot_axis.valid) {
+			matrix::Vector3f transformed_axis = original;
+			rotate_3(rot_axis, transformed_axis(0), transformed_axis(1), transformed_axis(2));
+
+			EXPECT_EQ(transformed_axis, transformed_3f) << "rotation " << i;
+			EXPECT_EQ(transformed_prepared, transformed_3f) << "rotation " << i;
+
+		} else {
+			EXPECT_NEAR(transformed_prepared(0), transformed_3f(0), 10e-6);
+			EXPECT_NEAR(transformed_prepared(1), transformed_3f(1), 10e-6);
+			EXPECT_NEAR(transformed_prepared(2), transformed_3f(2), 10e-6);
+		}
+	}
+
+	// compile time rotation
+	int16_t x = 1;
+	int16_t y = INT16_MIN;
+	int16_t z = 3;
+	rotate_3<ROTATION_YAW_90>(x, y, z);
+	EXPECT_EQ(x, INT16_MAX);
+	EXPECT_EQ(y, 1);
+	EXPECT_EQ(z, 3);
+}
+
+TEST(Rotations, 3i_vs_3i_fifo)
+{
+	//iterate through all defined rotations
+	for (size_t i = 0; i < (size_t)Rotation::ROTATION_MAX; i++) {
+
+		// GIVEN: a few samples including full scale values and a rotation
+		int16_t x[4] {1, 1000, INT16_MAX, INT16_MIN};
+		int16_t y[4] {2, -2000, INT16_MAX, 12345};
+		int16_t z[4] {3, 3000, INT16_MIN, -321};
+		const enum Rotation rotation = static_cast<Rotation>(i);
+
+		int16_t x_3i[4];
+		int16_t y_3i[4];
+		int16_t z_3i[4];
+
+		for (int n = 0; n < 4; n++) {
+			x_3i[n] = x[n];
+			y_3i[n] = y[n];
+			z_3i[n] = z[n];
+			rotate_3i(rotation, x_3i[n], y_3i[n], z_3i[n]);
+		}
+
+		// WHEN: we rotate all samples at once
+		rotate_3i(rotation, x, y, z, 4);
+
+		// THEN: the results should be the same within 1 LSB
+		for (int n = 0; n < 4; n++) {
+			EXPECT_NEAR(x[n], x_3i[n], 1) << "rotation " << i << " sample " << n;
+			EXPECT_NEAR(y[n], y_3i[n], 1) << "rotation " << i << " sample " << n;
+			EXPECT_NEAR(z[n], z_3i[n], 1) << "rotation " << i << " sample " << n;
+		}
+	}
+}
+
 TEST(Rotations, duplicates)
 {
 	// find all identical rotations to skip (needs to be kept in sync with mag calibration auto rotation)
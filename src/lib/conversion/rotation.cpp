@@ -56,3 +56,44 @@ get_rot_quaternion(enum Rotation rot)
 			math::radians((float)rot_lookup[rot].pitch),
 			math::radians((float)rot_lookup[rot].yaw)}};
 }
+
+__EXPORT void
+rotate_3i(enum Rotation rot, int16_t x[], int16_t y[], int16_t z[], uint8_t N)
+{
+	if (N == 0) {
+		return;
+	}
+
+	const rot_axis_t rot_axis{get_rot_axis(rot)};
+
+	if (rot_axis.valid) {
+		for (int n = 0; n < N; n++) {
+			rotate_3(rot_axis, x[n], y[n], z[n]);
+		}
+
+	} else if (rot < ROTATION_MAX) {
+		// Q14: 1.0 = 16384, products of int16 samples and coefficients and their sums fit into int32
+		static constexpr int Q = 14;
+		const matrix::Dcmf dcm{get_rot_matrix(rot)};
+		int32_t R[3][3];
+
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				R[i][j] = (int32_t)roundf(dcm(i, j) * (1 << Q));
+			}
+		}
+
+		for (int n = 0; n < N; n++) {
+			const int32_t v[3] {x[n], y[n], z[n]};
+			int32_t r[3];
+
+			for (int i = 0; i < 3; i++) {
+				r[i] = (R[i][0] * v[0] + R[i][1] * v[1] + R[i][2] * v[2] + (1 << (Q - 1))) >> Q;
+			}
+
+			x[n] = math::constrain(r[0], (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+			y[n] = math::constrain(r[1], (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+			z[n] = math::constrain(r[2], (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+		}
+	}
+}
@@ -370,6 +370,123 @@ static constexpr bool rotate_3(enum Rotation rot, T &x, T &y, T &z)
 	return false;
 }
 
+/**
+ * Axis aligned rotation (all angles a multiple of 90 degrees) as an exact axis permutation and sign change:
+ * rotated axis i = sign[i] * input axis index[i]
+ */
+struct rot_axis_t {
+	bool valid;		///< false if the rotation isn't axis aligned
+	uint8_t index[3];
+	int8_t sign[3];
+};
+
+/**
+ * Get the axis permutation of a rotation, evaluated at compile time for a constant rotation.
+ */
+static constexpr rot_axis_t get_rot_axis(enum Rotation rot)
+{
+	rot_axis_t rot_axis{};
+
+	if (rot >= ROTATION_MAX) {
+		return rot_axis;
+	}
+
+	const rot_lookup_t angles = rot_lookup[rot];
+
+	if ((angles.roll % 90 != 0) || (angles.pitch % 90 != 0) || (angles.yaw % 90 != 0)) {
+		return rot_axis;
+	}
+
+	const int cos_lookup[4] {1, 0, -1, 0};
+	const int sin_lookup[4] {0, 1, 0, -1};
+
+	const int cr = cos_lookup[(angles.roll / 90) % 4];
+	const int sr = sin_lookup[(angles.roll / 90) % 4];
+	const int cp = cos_lookup[(angles.pitch / 90) % 4];
+	const int sp = sin_lookup[(angles.pitch / 90) % 4];
+	const int cy = cos_lookup[(angles.yaw / 90) % 4];
+	const int sy = sin_lookup[(angles.yaw / 90) % 4];
+
+	// same as matrix::Dcm(matrix::Euler), with exact integer entries
+	const int dcm[3][3] {
+		{cp * cy, -cr * sy + sr * sp * cy, sr * sy + cr * sp * cy},
+		{cp * sy, cr * cy + sr * sp * sy, -sr * cy + cr * sp * sy},
+		{-sp, sr * cp, cr * cp}
+	};
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			if (dcm[i][j] != 0) {
+				rot_axis.index[i] = j;
+				rot_axis.sign[i] = dcm[i][j];
+			}
+		}
+	}
+
+	rot_axis.valid = true;
+	return rot_axis;
+}
+
+/**
+ * rotate a 3 element vector in-place with an axis permutation (see get_rot_axis())
+ */
+template<typename T>
+static constexpr void rotate_3(const rot_axis_t &rot_axis, T &x, T &y, T &z)
+{
+	const T v[3] {x, y, z};
+	x = (rot_axis.sign[0] > 0) ? v[rot_axis.index[0]] : math::negate(v[rot_axis.index[0]]);
+	y = (rot_axis.sign[1] > 0) ? v[rot_axis.index[1]] : math::negate(v[rot_axis.index[1]]);
+	z = (rot_axis.sign[2] > 0) ? v[rot_axis.index[2]] : math::negate(v[rot_axis.index[2]]);
+}
+
+/**
+ * rotate a 3 element vector in-place with a rotation known at compile time, reduces to the plain
+ * assignments of the permutation
+ */
+template<enum Rotation ROT, typename T>
+static constexpr void rotate_3(T &x, T &y, T &z)
+{
+	static_assert(get_rot_axis(ROT).valid, "rotation not axis aligned");
+	rotate_3(get_rot_axis(ROT), x, y, z);
+}
+
+/**
+ * A rotation prepared once (e.g. at driver construction) to be applied at sample rate. Axis aligned
+ * rotations are applied as a permutation, all others with the cached rotation matrix.
+ */
+class PreparedRotation
+{
+public:
+	explicit PreparedRotation(enum Rotation rot = ROTATION_NONE) :
+		_rot_axis(get_rot_axis(rot)),
+		_dcm((_rot_axis.valid || (rot >= ROTATION_MAX)) ? matrix::Dcmf{} : get_rot_matrix(rot))
+	{
+		if (rot >= ROTATION_MAX) {
+			// invalid rotations are ignored
+			_rot_axis = get_rot_axis(ROTATION_NONE);
+		}
+	}
+
+	bool axis_aligned() const { return _rot_axis.valid; }
+
+	void apply(float &x, float &y, float &z) const
+	{
+		if (_rot_axis.valid) {
+			rotate_3(_rot_axis, x, y, z);
+
+		} else {
+			const matrix::Vector3f r{_dcm * matrix::Vector3f{x, y, z}};
+			x = r(0);
+			y = r(1);
+			z = r(2);
+		}
+	}
+
+private:
+	rot_axis_t _rot_axis;
+	matrix::Dcmf _dcm;
+};
+
 /**
  * rotate a 3 element int16_t vector in-place
  */
@@ -386,6 +503,15 @@ __EXPORT inline void rotate_3i(enum Rotation rot, int16_t &x, int16_t &y, int16_
 	}
 }
 
+/**
+ * rotate N 3 element int16_t samples (e.g. a sensor FIFO) in-place
+ *
+ * Rotations that are only an axis permutation and sign change are done exactly (see rotate_3()),
+ * all others use the rotation matrix precomputed in fixed point (Q14), so neither trigonometry nor
+ * float math is needed per sample. The result may differ by 1 LSB from rotate_3i().
+ */
+__EXPORT void rotate_3i(enum Rotation rot, int16_t x[], int16_t y[], int16_t z[], uint8_t N);
+
 /**
  * rotate a 3 element float vector in-place
  */
@@ -71,6 +71,7 @@ private:
 
 	uint32_t		_device_id{0};
 	const enum Rotation	_rotation;
+	const PreparedRotation	_rotation_prepared;
 
 	int32_t			_imu_gyro_rate_max{0}; // match gyro max rate
 
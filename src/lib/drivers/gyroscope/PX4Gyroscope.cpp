@@ -68,7 +68,8 @@ static constexpr uint8_t clipping(const int16_t samples[], uint8_t len)
 
 PX4Gyroscope::PX4Gyroscope(uint32_t device_id, enum Rotation rotation) :
 	_device_id{device_id},
-	_rotation{rotation}
+	_rotation{rotation},
+	_rotation_prepared{rotation}
 {
 	// advertise immediately to keep instance numbering in sync
 	_sensor_pub.advertise();
@@ -114,7 +115,7 @@ void PX4Gyroscope::set_scale(float scale)
 void PX4Gyroscope::update(const hrt_abstime &timestamp_sample, float x, float y, float z)
 {
 	// Apply rotation (before scaling)
-	rotate_3f(_rotation, x, y, z);
+	_rotation_prepared.apply(x, y, z);
 
 	sensor_gyro_s report;
 
@@ -139,9 +140,7 @@ void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 	// rotate all raw samples and publish fifo
 	const uint8_t N = sample.samples;
 
-	for (int n = 0; n < N; n++) {
-		rotate_3i(_rotation, sample.x[n], sample.y[n], sample.z[n]);
-	}
+	rotate_3i(_rotation, sample.x, sample.y, sample.z, N);
 
 	sample.device_id = _device_id;
 	sample.scale = _scale;
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ImuSampleClock.hpp
+ *
+ * Tracks the sample clock of an IMU FIFO against HRT. The data ready interrupt timestamps carry the interrupt
+ * and scheduling latency jitter and the sensor oscillator deviates from the nominal output data rate, so a
+ * phase locked loop estimates the actual sample interval and filters the timestamp of the newest sample of
+ * every FIFO read. Samples of different IMUs are then on the same (HRT) time base.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
+
+class ImuSampleClock
+{
+public:
+	explicit ImuSampleClock(float nominal_interval_us) { setNominalInterval(nominal_interval_us); }
+
+	void setNominalInterval(float nominal_interval_us)
+	{
+		_nominal_interval = nominal_interval_us;
+		_interval = nominal_interval_us;
+		reset();
+	}
+
+	/**
+	 * Restart from the next measurement, call whenever samples are lost (FIFO reset or overflow).
+	 * The interval estimate is kept.
+	 */
+	void reset()
+	{
+		_timestamp = 0;
+		_fraction = 0.f;
+	}
+
+	/**
+	 * @param timestamp_measured HRT timestamp of the newest sample read (data ready interrupt or read time)
+	 * @param samples number of samples read since the previous update
+	 * @return drift corrected timestamp of the newest sample
+	 */
+	hrt_abstime update(const hrt_abstime timestamp_measured, const int samples)
+	{
+		if (samples <= 0) {
+			return timestamp_measured;
+		}
+
+		if (_timestamp == 0) {
+			_timestamp = timestamp_measured;
+			_fraction = 0.f;
+			return _timestamp;
+		}
+
+		const float predicted = _fraction + samples * _interval;
+		const float error = static_cast<float>(static_cast<int64_t>(timestamp_measured - _timestamp)) - predicted;
+
+		if (fabsf(error) > math::max(0.5f * samples * _interval, MAX_JITTER_US)) {
+			// samples lost or clock jump, restart from the measurement
+			_timestamp = timestamp_measured;
+			_fraction = 0.f;
+			_resync_count++;
+			return _timestamp;
+		}
+
+		_interval = math::constrain(_interval + FREQUENCY_GAIN * error / samples,
+					    _nominal_interval * (1.f - MAX_DRIFT), _nominal_interval * (1.f + MAX_DRIFT));
+
+		const float offset = math::max(predicted + PHASE_GAIN * error, 0.f);
+		const hrt_abstime offset_us = static_cast<hrt_abstime>(offset);
+		_timestamp += offset_us;
+		_fraction = offset - offset_us;
+
+		return _timestamp;
+	}
+
+	/// estimated sample interval (microseconds)
+	float interval() const { return _interval; }
+
+	/// sensor clock deviation from the nominal rate (ppm), positive if the sensor samples slower than nominal
+	float driftPpm() const { return (_interval / _nominal_interval - 1.f) * 1e6f; }
+
+	uint32_t resyncCount() const { return _resync_count; }
+
+private:
+	// critically damped second order loop, time constant of about 25 updates
+	static constexpr float PHASE_GAIN{0.08f};
+	static constexpr float FREQUENCY_GAIN{0.0016f};
+
+	static constexpr float MAX_DRIFT{0.05f};      // sensor ODR tolerance (relative)
+	static constexpr float MAX_JITTER_US{100.f};  // larger timestamp errors restart the loop
+
+	hrt_abstime _timestamp{0}; ///< corrected timestamp of the newest sample (integer part)
+	float _fraction{0.f};      ///< fractional part of _timestamp (microseconds)
+
+	float _nominal_interval;
+	float _interval;
+
+	uint32_t _resync_count{0};
+};
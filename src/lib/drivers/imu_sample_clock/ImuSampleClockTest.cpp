@@ -0,0 +1,120 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include "ImuSampleClock.hpp"
+
+#include <random>
+
+static constexpr float NOMINAL_INTERVAL{125.f}; // 8 kHz
+static constexpr int SAMPLES{8};
+
+TEST(ImuSampleClockTest, TracksDrift)
+{
+	// sensor clock 1% slow, data ready interrupt latency jitter of 5-40 us
+	const double true_interval = NOMINAL_INTERVAL * 1.01;
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> latency(5., 40.);
+
+	ImuSampleClock clock{NOMINAL_INTERVAL};
+
+	double raw_error_sq = 0.;
+	double corrected_error_sq = 0.;
+	double corrected_error = 0.;
+	int count = 0;
+
+	for (int i = 1; i <= 5000; i++) {
+		const double t_true = 1e6 + i * SAMPLES * true_interval;
+		const hrt_abstime measured = static_cast<hrt_abstime>(t_true + latency(gen));
+		const hrt_abstime corrected = clock.update(measured, SAMPLES);
+
+		if (i > 1000) {
+			// constant latency offset removed
+			const double raw = measured - t_true - 22.5;
+			const double cor = corrected - t_true - 22.5;
+			raw_error_sq += raw * raw;
+			corrected_error_sq += cor * cor;
+			corrected_error += cor;
+			count++;
+		}
+	}
+
+	EXPECT_NEAR(clock.interval(), true_interval, 0.01);
+	EXPECT_NEAR(clock.driftPpm(), 10000.f, 100.f);
+	EXPECT_EQ(clock.resyncCount(), 0u);
+
+	// filtered timestamps follow the sensor clock with less jitter and no bias
+	EXPECT_LT(corrected_error_sq, raw_error_sq / 4.);
+	EXPECT_NEAR(corrected_error / count, 0., 2.);
+}
+
+TEST(ImuSampleClockTest, ResyncOnLostSamples)
+{
+	ImuSampleClock clock{NOMINAL_INTERVAL};
+
+	hrt_abstime t = 1000000;
+
+	for (int i = 0; i < 100; i++) {
+		t += SAMPLES * NOMINAL_INTERVAL;
+		EXPECT_EQ(clock.update(t, SAMPLES), t);
+	}
+
+	// 3 reads lost, but only the samples of one read reported
+	t += 4 * SAMPLES * NOMINAL_INTERVAL;
+	EXPECT_EQ(clock.update(t, SAMPLES), t);
+	EXPECT_EQ(clock.resyncCount(), 1u);
+	EXPECT_FLOAT_EQ(clock.interval(), NOMINAL_INTERVAL);
+
+	// explicit reset starts from the next measurement
+	clock.reset();
+	t += 12345;
+	EXPECT_EQ(clock.update(t, SAMPLES), t);
+	EXPECT_EQ(clock.resyncCount(), 1u);
+}
+
+TEST(ImuSampleClockTest, DriftLimited)
+{
+	ImuSampleClock clock{NOMINAL_INTERVAL};
+
+	// timestamps 20% late every read pull the estimate up to the tolerance only
+	hrt_abstime t = 1000000;
+
+	for (int i = 0; i < 10000; i++) {
+		t += static_cast<hrt_abstime>(SAMPLES * NOMINAL_INTERVAL * 1.07f);
+		clock.update(t, SAMPLES);
+	}
+
+	EXPECT_LE(clock.interval(), NOMINAL_INTERVAL * 1.05f + 1e-3f);
+}
@@ -38,7 +38,7 @@
 
 PX4Magnetometer::PX4Magnetometer(uint32_t device_id, enum Rotation rotation) :
 	_device_id{device_id},
-	_rotation{rotation}
+	_rotation_prepared{rotation}
 {
 }
 
@@ -69,7 +69,7 @@ void PX4Magnetometer::update(const hrt_abstime &timestamp_sample, float x, float
 	report.error_count = _error_count;
 
 	// Apply rotation (before scaling)
-	rotate_3f(_rotation, x, y, z);
+	_rotation_prepared.apply(x, y, z);
 
 	report.x = x * _scale;
 	report.y = y * _scale;
@@ -58,7 +58,7 @@ private:
 	uORB::PublicationMulti<sensor_mag_s> _sensor_pub{ORB_ID(sensor_mag)};
 
 	uint32_t		_device_id{0};
-	const enum Rotation	_rotation;
+	const PreparedRotation	_rotation_prepared;
 
 	float			_scale{1.f};
 	float			_temperature{NAN};
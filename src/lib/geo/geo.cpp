@@ -113,6 +113,55 @@ void MapProjection::reproject(float x, float y, double &lat, double &lon) const
 	}
 }
 
+void MapProjection::setSmallAngleRadius(float radius)
+{
+	_small_angle_max = math::constrain((double)radius, 0.0, 100e3) / CONSTANTS_RADIUS_OF_EARTH;
+}
+
+void MapProjection::projectSmallAngle(double d_lat, double d_lon, float &x, float &y) const
+{
+	// sin/cos of the offsets from the reference up to the first neglected term (< 1e-11 at 100 km)
+	const double d_lat2 = d_lat * d_lat;
+	const double d_lon2 = d_lon * d_lon;
+	const double sin_d_lat = d_lat * (1.0 - d_lat2 / 6.0 * (1.0 - d_lat2 / 20.0));
+	const double cos_d_lat = 1.0 - d_lat2 / 2.0 * (1.0 - d_lat2 / 12.0);
+	const double sin_d_lon = d_lon * (1.0 - d_lon2 / 6.0 * (1.0 - d_lon2 / 20.0));
+	const double cos_d_lon = 1.0 - d_lon2 / 2.0 * (1.0 - d_lon2 / 12.0);
+
+	const double sin_lat = _ref_sin_lat * cos_d_lat + _ref_cos_lat * sin_d_lat;
+	const double cos_lat = _ref_cos_lat * cos_d_lat - _ref_sin_lat * sin_d_lat;
+
+	// k = c / sin(c) expanded in sin^2(c) = 1 - cos^2(c)
+	const double cos_c = _ref_sin_lat * sin_lat + _ref_cos_lat * cos_lat * cos_d_lon;
+	const double s2 = math::max(1.0 - cos_c * cos_c, 0.0);
+	const double k = 1.0 + s2 * (1.0 / 6.0 + s2 * (3.0 / 40.0 + s2 * 5.0 / 112.0));
+
+	x = static_cast<float>(k * (_ref_cos_lat * sin_lat - _ref_sin_lat * cos_lat * cos_d_lon) * CONSTANTS_RADIUS_OF_EARTH);
+	y = static_cast<float>(k * cos_lat * sin_d_lon * CONSTANTS_RADIUS_OF_EARTH);
+}
+
+void MapProjection::project(const double *lat, const double *lon, float *x, float *y, size_t count) const
+{
+	for (size_t i = 0; i < count; i++) {
+		const double d_lat = math::radians(lat[i]) - _ref_lat;
+		const double d_lon = math::radians(lon[i]) - _ref_lon;
+
+		if ((fabs(d_lat) < _small_angle_max) && (fabs(d_lon) < _small_angle_max)) {
+			projectSmallAngle(d_lat, d_lon, x[i], y[i]);
+
+		} else {
+			project(lat[i], lon[i], x[i], y[i]);
+		}
+	}
+}
+
+void MapProjection::reproject(const float *x, const float *y, double *lat, double *lon, size_t count) const
+{
+	for (size_t i = 0; i < count; i++) {
+		reproject(x[i], y[i], lat[i], lon[i]);
+	}
+}
+
 float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next)
 {
 	const double lat_now_rad = math::radians(lat_now);
@@ -169,8 +169,11 @@ private:
 	double _ref_lon{0.0};
 	double _ref_sin_lat{0.0};
 	double _ref_cos_lat{0.0};
+	double _small_angle_max{0.0};
 	bool _ref_init_done{false};
 
+	void projectSmallAngle(double d_lat, double d_lon, float &x, float &y) const;
+
 public:
 	/**
 	 * @brief Construct a new Map Projection object
@@ -272,4 +275,35 @@ public:
 	 * @param lon in degrees (8.1234567°, not 81234567°)
 	 */
 	void reproject(float x, float y, double &lat, double &lon) const;
+
+	/**
+	 * Set the distance from the reference within which the batch projection
+	 * replaces the trigonometric functions by series expansions around the reference.
+	 * The error of the expansions stays below 1 mm up to the maximum of 100 km.
+	 *
+	 * @param radius in meters, 0 (default) to always use the exact projection
+	 */
+	void setSmallAngleRadius(float radius);
+
+	/**
+	 * Transform an array of points in the geographic coordinate system to the local
+	 * azimuthal equidistant plane using the projection
+	 * @param lat array of latitudes in degrees
+	 * @param lon array of longitudes in degrees
+	 * @param x array of north coordinates
+	 * @param y array of east coordinates
+	 * @param count number of points
+	 */
+	void project(const double *lat, const double *lon, float *x, float *y, size_t count) const;
+
+	/**
+	 * Transform an array of points in the local azimuthal equidistant plane to the
+	 * geographic coordinate system using the projection
+	 * @param x array of north coordinates
+	 * @param y array of east coordinates
+	 * @param lat array of latitudes in degrees
+	 * @param lon array of longitudes in degrees
+	 * @param count number of points
+	 */
+	void reproject(const float *x, const float *y, double *lat, double *lon, size_t count) const;
 };
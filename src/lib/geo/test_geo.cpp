@@ -214,3 +214,40 @@ TEST_F(GeoTest, waypoint_from_line_and_negative_distance)
 	EXPECT_FLOAT_EQ(lat_start - lat_offset, lat_target);
 	EXPECT_DOUBLE_EQ(lon_start, lon_target);
 }
+
+TEST_F(GeoTest, batchProject)
+{
+	// GIVEN: points up to ~70 km away from a reference (and one far away)
+	MapProjection map_projection(47.356616973876953, 8.5190505981445313, 0);
+	static constexpr size_t count = 6;
+	const double lat[count] = {47.356616973876953, 47.357, 47.3, 47.9, 46.8, 10.0};
+	const double lon[count] = {8.5190505981445313, 8.52, 8.6, 8.0, 9.3, 8.5};
+
+	float x[count];
+	float y[count];
+
+	// WHEN: projecting them as a batch, with and without the small angle approximation
+	for (float radius : {0.f, 100e3f}) {
+		map_projection.setSmallAngleRadius(radius);
+		map_projection.project(lat, lon, x, y, count);
+
+		// THEN: the result matches the single point projection
+		for (size_t i = 0; i < count; i++) {
+			float x_single;
+			float y_single;
+			map_projection.project(lat[i], lon[i], x_single, y_single);
+			EXPECT_NEAR(x[i], x_single, 1e-3f);
+			EXPECT_NEAR(y[i], y_single, 1e-3f);
+		}
+	}
+
+	// AND: reprojecting the batch gives back the input
+	double lat_new[count];
+	double lon_new[count];
+	map_projection.reproject(x, y, lat_new, lon_new, count);
+
+	for (size_t i = 0; i < count; i++) {
+		EXPECT_NEAR(lat[i], lat_new[i], 1e-6);
+		EXPECT_NEAR(lon[i], lon_new[i], 1e-6);
+	}
+}
@@ -57,7 +57,13 @@ public:
 	NotchFilter() = default;
 	~NotchFilter() = default;
 
-	bool setParameters(float sample_freq, float notch_freq, float bandwidth);
+	bool setParameters(float sample_freq, float notch_freq, float bandwidth) { return setParameters(sample_freq, notch_freq, bandwidth, NAN); }
+
+	/**
+	 * Same as setParameters(), but if only the notch frequency changes the precomputed
+	 * beta = -cos(2 pi notch_freq / sample_freq) is used (e.g. from a lookup table).
+	 */
+	bool setParameters(float sample_freq, float notch_freq, float bandwidth, float beta);
 
 	/**
 	 * Add a new raw value to the filter using the Direct Form I
@@ -214,7 +220,7 @@ protected:
  * conserving the filter's history
  */
 template<typename T>
-bool NotchFilter<T>::setParameters(float sample_freq, float notch_freq, float bandwidth)
+bool NotchFilter<T>::setParameters(float sample_freq, float notch_freq, float bandwidth, float beta)
 {
 	if ((sample_freq <= 0.f) || (notch_freq <= 0.f) || (bandwidth <= 0.f) || (notch_freq >= sample_freq / 2)
 	    || !isFinite(sample_freq) || !isFinite(notch_freq) || !isFinite(bandwidth)) {
@@ -241,7 +247,9 @@ bool NotchFilter<T>::setParameters(float sample_freq, float notch_freq, float ba
 			// only notch frequency has changed
 			_notch_freq = notch_freq_new;
 
-			const float beta = -cosf(2.f * M_PI_F * _notch_freq / _sample_freq);
+			if (!isFinite(beta) || (notch_freq_new > notch_freq)) {
+				beta = -cosf(2.f * M_PI_F * _notch_freq / _sample_freq);
+			}
 
 			_b1 = 2.f * beta * _b0;
 			_a1 = _b1;
@@ -269,7 +277,7 @@ bool NotchFilter<T>::setParameters(float sample_freq, float notch_freq, float ba
 	_bandwidth = bandwidth_new;
 
 	const float alpha = tanf(M_PI_F * _bandwidth / _sample_freq);
-	const float beta = -cosf(2.f * M_PI_F * _notch_freq / _sample_freq);
+	beta = -cosf(2.f * M_PI_F * _notch_freq / _sample_freq);
 	const float a0_inv = 1.f / (alpha + 1.f);
 
 	_b0 = a0_inv;
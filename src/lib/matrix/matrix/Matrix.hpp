@@ -152,10 +152,15 @@ public:
 		const Matrix<Type, M, N> &self = *this;
 		Matrix<Type, M, P> res{};
 
+		// i-j-k order: the inner loop runs over contiguous rows of other and res,
+		// which the compiler can vectorize. Every res(i, k) is still accumulated
+		// over j in increasing order, so the result is identical to the i-k-j order.
 		for (size_t i = 0; i < M; i++) {
-			for (size_t k = 0; k < P; k++) {
-				for (size_t j = 0; j < N; j++) {
-					res(i, k) += self(i, j) * other(j, k);
+			for (size_t j = 0; j < N; j++) {
+				const Type a = self(i, j);
+
+				for (size_t k = 0; k < P; k++) {
+					res(i, k) += a * other(j, k);
 				}
 			}
 		}
@@ -0,0 +1,109 @@
+/**
+ * @file SymmetricMatrix.hpp
+ *
+ * Symmetric matrix that only stores the upper triangle (M * (M + 1) / 2 elements).
+ *
+ * Both (i, j) and (j, i) refer to the same element, so code written for a full
+ * symmetric SquareMatrix that only writes one of the two can use it unchanged.
+ */
+
+#pragma once
+
+#include "math.hpp"
+
+namespace matrix
+{
+
+template<typename Type, size_t M>
+class SymmetricMatrix
+{
+public:
+	static constexpr size_t NUM_ELEMENTS = M * (M + 1) / 2;
+
+	SymmetricMatrix() = default;
+
+	explicit SymmetricMatrix(const SquareMatrix<Type, M> &other)
+	{
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = i; j < M; j++) {
+				_data[index(i, j)] = other(i, j);
+			}
+		}
+	}
+
+	inline const Type &operator()(size_t i, size_t j) const
+	{
+		assert(i < M);
+		assert(j < M);
+
+		return _data[(i <= j) ? index(i, j) : index(j, i)];
+	}
+
+	inline Type &operator()(size_t i, size_t j)
+	{
+		assert(i < M);
+		assert(j < M);
+
+		return _data[(i <= j) ? index(i, j) : index(j, i)];
+	}
+
+	void setZero()
+	{
+		for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+			_data[i] = Type(0);
+		}
+	}
+
+	Vector<Type, M> diag() const
+	{
+		Vector<Type, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			res(i) = _data[index(i, i)];
+		}
+
+		return res;
+	}
+
+	SquareMatrix<Type, M> toSquareMatrix() const
+	{
+		SquareMatrix<Type, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = i; j < M; j++) {
+				res(i, j) = res(j, i) = _data[index(i, j)];
+			}
+		}
+
+		return res;
+	}
+
+	template <size_t Width>
+	void uncorrelateCovarianceSetVariance(size_t first, Type val)
+	{
+		static_assert(Width <= M, "Width bigger than matrix");
+		assert(first + Width <= M);
+
+		SymmetricMatrix<Type, M> &self = *this;
+
+		// zero rows and columns (the same elements), set diagonals
+		for (size_t i = first; i < first + Width; i++) {
+			for (size_t j = 0; j < M; j++) {
+				self(i, j) = Type(0);
+			}
+
+			self(i, i) = val;
+		}
+	}
+
+private:
+	// offset of row i in the packed upper triangle, valid for i <= j
+	static constexpr size_t index(size_t i, size_t j)
+	{
+		return (i * (2 * M - i + 1)) / 2 + (j - i);
+	}
+
+	Type _data[NUM_ELEMENTS] {};
+};
+
+} // namespace matrix
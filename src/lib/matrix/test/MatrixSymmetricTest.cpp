@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <matrix/math.hpp>
+
+using namespace matrix;
+
+TEST(MatrixSymmetricTest, packedAccess)
+{
+	static_assert(SymmetricMatrix<float, 24>::NUM_ELEMENTS == 300, "packed size");
+	static_assert(sizeof(SymmetricMatrix<float, 24>) == 300 * sizeof(float), "no padding");
+
+	SymmetricMatrix<float, 5> a;
+
+	// every upper element has its own storage, (i, j) and (j, i) alias
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = i; j < 5; j++) {
+			a(i, j) = 10.f * i + j;
+		}
+	}
+
+	for (size_t i = 0; i < 5; i++) {
+		for (size_t j = 0; j < 5; j++) {
+			const size_t lo = (i < j) ? i : j;
+			const size_t hi = (i < j) ? j : i;
+			EXPECT_EQ(a(i, j), 10.f * lo + hi);
+		}
+	}
+
+	a(3, 1) = -1.f;
+	EXPECT_EQ(a(1, 3), -1.f);
+}
+
+TEST(MatrixSymmetricTest, squareMatrixConversion)
+{
+	float data[9] = {1, 2, 3,
+			 2, 5, 6,
+			 3, 6, 9
+			};
+	const SquareMatrix<float, 3> m(data);
+
+	const SymmetricMatrix<float, 3> s(m);
+	EXPECT_EQ(s.toSquareMatrix(), m);
+	EXPECT_EQ(s.diag(), m.diag());
+}
+
+TEST(MatrixSymmetricTest, uncorrelateCovarianceSetVariance)
+{
+	SquareMatrix<float, 6> m;
+
+	for (size_t i = 0; i < 6; i++) {
+		for (size_t j = 0; j < 6; j++) {
+			m(i, j) = 1.f + i + j;
+		}
+	}
+
+	SymmetricMatrix<float, 6> s(m);
+
+	m.uncorrelateCovarianceSetVariance<2>(2, 7.f);
+	s.uncorrelateCovarianceSetVariance<2>(2, 7.f);
+	EXPECT_EQ(s.toSquareMatrix(), m);
+
+	s.setZero();
+	EXPECT_EQ(s.toSquareMatrix(), (SquareMatrix<float, 6>()));
+}
@@ -68,12 +68,34 @@ public:
 
 	float value(OutputFunction func) override { return _data.control[(int)func - (int)OutputFunction::Motor1]; }
 
+	uint32_t values(const OutputFunction *funcs, int count, float *values) override
+	{
+		uint32_t reversible_mask = 0;
+
+		for (int i = 0; i < count; ++i) {
+			const int index = (int)funcs[i] - (int)OutputFunction::Motor1;
+			values[i] = _data.control[index];
+			reversible_mask |= ((_data.reversible_flags >> index) & 1u) << i;
+		}
+
+		return reversible_mask;
+	}
+
 	bool allowPrearmControl() const override { return false; }
 
 	uORB::SubscriptionCallbackWorkItem *subscriptionCallback() override { return &_topic; }
 
 	bool getLatestSampleTimestamp(hrt_abstime &t) const override { t = _data.timestamp_sample; return t != 0; }
 
+	bool getLatencyTrace(LatencyTrace &trace) const override
+	{
+		trace.timestamp_sample = _data.timestamp_sample;
+		trace.timestamp_angular_velocity = _data.timestamp_angular_velocity;
+		trace.timestamp_torque_setpoint = _data.timestamp_torque_setpoint;
+		trace.timestamp_allocation = _data.timestamp;
+		return trace.timestamp_sample != 0;
+	}
+
 	static inline void updateValues(uint32_t reversible, float thrust_factor, float *values, int num_values)
 	{
 		if (thrust_factor > 0.f && thrust_factor <= 1.f) {
@@ -50,6 +50,16 @@ public:
 		const float &thrust_factor;
 	};
 
+	/**
+	 * Timestamps of the control chain stages the latest values are based on (0 if unknown)
+	 */
+	struct LatencyTrace {
+		hrt_abstime timestamp_sample;           ///< gyro sample
+		hrt_abstime timestamp_angular_velocity; ///< vehicle_angular_velocity publication
+		hrt_abstime timestamp_torque_setpoint;  ///< vehicle_torque_setpoint publication
+		hrt_abstime timestamp_allocation;       ///< publication of the function topic (e.g. actuator_motors)
+	};
+
 	FunctionProviderBase() = default;
 	virtual ~FunctionProviderBase() = default;
 
@@ -61,6 +71,24 @@ public:
 	 */
 	virtual float value(OutputFunction func) = 0;
 
+	/**
+	 * Get the current output values of consecutive outputs assigned to this provider in one call
+	 * @param funcs function of each output
+	 * @param values output: NAN (=disarmed) or value in range [-1, 1]
+	 * @return reversible() of each output as bitmask (bit i for funcs[i])
+	 */
+	virtual uint32_t values(const OutputFunction *funcs, int count, float *values)
+	{
+		uint32_t reversible_mask = 0;
+
+		for (int i = 0; i < count; ++i) {
+			values[i] = value(funcs[i]);
+			reversible_mask |= (uint32_t)reversible(funcs[i]) << i;
+		}
+
+		return reversible_mask;
+	}
+
 	virtual float defaultFailsafeValue(OutputFunction func) const { return NAN; }
 	virtual bool allowPrearmControl() const { return true; }
 
@@ -68,6 +96,8 @@ public:
 
 	virtual bool getLatestSampleTimestamp(hrt_abstime &t) const { return false; }
 
+	virtual bool getLatencyTrace(LatencyTrace &trace) const { return false; }
+
 	/**
 	 * Check whether the output (motor) is configured to be reversible
 	 */
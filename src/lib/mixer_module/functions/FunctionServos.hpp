@@ -59,6 +59,15 @@ public:
 	void update() override { _topic.update(&_data); }
 	float value(OutputFunction func) override { return _data.control[(int)func - (int)OutputFunction::Servo1]; }
 
+	uint32_t values(const OutputFunction *funcs, int count, float *values) override
+	{
+		for (int i = 0; i < count; ++i) {
+			values[i] = _data.control[(int)funcs[i] - (int)OutputFunction::Servo1];
+		}
+
+		return 0;
+	}
+
 	uORB::SubscriptionCallbackWorkItem *subscriptionCallback() override { return &_topic; }
 
 	float defaultFailsafeValue(OutputFunction func) const override { return 0.f; }
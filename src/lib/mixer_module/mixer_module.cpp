@@ -210,6 +210,26 @@ void MixingOutput::cleanupFunctions()
 		_function_allocated[i] = nullptr;
 		_functions[i] = nullptr;
 	}
+
+	_num_function_runs = 0;
+}
+
+void MixingOutput::updateFunctionRuns()
+{
+	_num_function_runs = 0;
+
+	for (int i = 0; i < _max_num_outputs; ++i) {
+		if (!_functions[i]) {
+			continue;
+		}
+
+		if ((_num_function_runs > 0) && (_functions[i] == _functions[i - 1])) {
+			_function_runs[_num_function_runs - 1].count++;
+
+		} else {
+			_function_runs[_num_function_runs++] = FunctionRun{(uint8_t)i, 1};
+		}
+	}
 }
 
 bool MixingOutput::updateSubscriptions(bool allow_wq_switch, bool limit_callbacks_to_primary)
@@ -313,6 +333,8 @@ bool MixingOutput::updateSubscriptions(bool allow_wq_switch, bool limit_callback
 		}
 	}
 
+	updateFunctionRuns();
+
 	hrt_abstime fixed_rate_scheduling_interval = 4_ms; // schedule at 250Hz
 
 	if (_max_topic_update_interval_us > fixed_rate_scheduling_interval) {
@@ -431,30 +453,34 @@ bool MixingOutput::update()
 	// check for actuator test
 	_actuator_test.update(_max_num_outputs, _param_thr_mdl_fac.get());
 
-	// get output values
+	// get output values, one provider call per block of consecutive outputs
 	float outputs[MAX_ACTUATORS];
-	bool all_disabled = true;
 	_reversible_mask = 0;
 
 	for (int i = 0; i < _max_num_outputs; ++i) {
-		if (_functions[i]) {
-			all_disabled = false;
+		outputs[i] = NAN;
+	}
 
-			if (_armed.armed || (_armed.prearmed && _functions[i]->allowPrearmControl())) {
-				outputs[i] = _functions[i]->value(_function_assignment[i]);
+	for (int r = 0; r < _num_function_runs; ++r) {
+		const FunctionRun &run = _function_runs[r];
+		const int count = math::min((int)run.count, _max_num_outputs - run.start);
 
-			} else {
-				outputs[i] = NAN;
-			}
+		if (count <= 0) {
+			continue;
+		}
 
-			_reversible_mask |= (uint32_t)_functions[i]->reversible(_function_assignment[i]) << i;
+		FunctionProviderBase *function = _functions[run.start];
 
-		} else {
-			outputs[i] = NAN;
+		_reversible_mask |= function->values(&_function_assignment[run.start], count, &outputs[run.start]) << run.start;
+
+		if (!_armed.armed && !(_armed.prearmed && function->allowPrearmControl())) {
+			for (int i = run.start; i < run.start + count; ++i) {
+				outputs[i] = NAN;
+			}
 		}
 	}
 
-	if (!all_disabled) {
+	if (_num_function_runs > 0) {
 		if (!_armed.armed && !_armed.manual_lockdown) {
 			_actuator_test.overrideValues(outputs, _max_num_outputs);
 		}
@@ -492,6 +518,12 @@ MixingOutput::limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updat
 	/* now return the outputs to the driver */
 	if (_interface.updateOutputs(stop_motors, _current_output_value, _max_num_outputs, has_updates)) {
 		actuator_outputs_s actuator_outputs{};
+
+		// Just check the first function. It means we only get the latency if motors are assigned first, which is the default
+		if (_function_allocated[0]) {
+			_function_allocated[0]->getLatestSampleTimestamp(actuator_outputs.timestamp_sample);
+		}
+
 		setAndPublishActuatorOutputs(_max_num_outputs, actuator_outputs);
 
 		updateLatencyPerfCounter(actuator_outputs);
@@ -509,10 +541,10 @@ uint16_t MixingOutput::output_limit_calc_single(int i, float value) const
 		value = -1.f * value;
 	}
 
-	uint16_t effective_output = value * (_max_value[i] - _min_value[i]) / 2 + (_max_value[i] + _min_value[i]) / 2;
+	const float effective_output = value * (_max_value[i] - _min_value[i]) / 2 + (_max_value[i] + _min_value[i]) / 2;
 
 	// last line of defense against invalid inputs
-	return math::constrain(effective_output, _min_value[i], _max_value[i]);
+	return math::constrain(effective_output, (float)_min_value[i], (float)_max_value[i]);
 }
 
 void
@@ -649,8 +681,17 @@ MixingOutput::output_limit_calc(const bool armed, const int num_channels, const
 		break;
 
 	case OutputLimitState::ON:
+
+		// output_limit_calc_single() for all channels, written without calls and early exits so that the compiler can
+		// vectorize it where the target has SIMD
 		for (int i = 0; i < num_channels; i++) {
-			_current_output_value[i] = output_limit_calc_single(i, output[i]);
+			const float value = (_reverse_output_mask & (1 << i)) ? -output[i] : output[i];
+			const float min_value = _min_value[i];
+			const float max_value = _max_value[i];
+			const float effective_output = value * (max_value - min_value) * 0.5f + (float)((_max_value[i] + _min_value[i]) / 2);
+			const float limited = math::constrain(effective_output, min_value, max_value);
+
+			_current_output_value[i] = PX4_ISFINITE(value) ? (uint16_t)limited : _disarmed_value[i];
 		}
 
 		break;
@@ -673,14 +714,20 @@ MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, actuator_output
 void
 MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
 {
-	// Just check the first function. It means we only get the latency if motors are assigned first, which is the default
-	if (_function_allocated[0]) {
-		hrt_abstime timestamp_sample;
+	if (actuator_outputs.timestamp_sample != 0) {
+		perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - actuator_outputs.timestamp_sample);
 
-		if (_function_allocated[0]->getLatestSampleTimestamp(timestamp_sample)) {
-			perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - timestamp_sample);
+		FunctionProviderBase::LatencyTrace trace{};
+
+		if (_function_allocated[0]->getLatencyTrace(trace)) {
+			_output_latency.update(trace, actuator_outputs.timestamp);
+
+		} else {
+			_output_latency.updateUntraced();
 		}
 	}
+
+	_output_latency.publishIfNeeded(actuator_outputs.timestamp);
 }
 
 uint16_t
@@ -34,6 +34,7 @@
 #pragma once
 
 #include "actuator_test.hpp"
+#include "output_latency.hpp"
 
 #include "functions/FunctionActuatorSet.hpp"
 #include "functions/FunctionConstantMax.hpp"
@@ -218,6 +219,8 @@ private:
 
 	void cleanupFunctions();
 
+	void updateFunctionRuns();
+
 	void initParamHandles();
 
 	void limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updates);
@@ -276,6 +279,7 @@ private:
 	OutputModuleInterface &_interface;
 
 	perf_counter_t _control_latency_perf;
+	OutputLatency _output_latency;
 
 	FunctionProviderBase *_function_allocated[MAX_ACTUATORS] {}; ///< unique allocated functions
 	FunctionProviderBase *_functions[MAX_ACTUATORS] {}; ///< currently assigned functions
@@ -289,6 +293,14 @@ private:
 	ActuatorTest _actuator_test{_function_assignment};
 	uint32_t _reversible_mask{0}; ///< per-output bits. If set, the output is configured to be reversible (motors only)
 
+	struct FunctionRun {
+		uint8_t start;
+		uint8_t count;
+	};
+
+	FunctionRun _function_runs[MAX_ACTUATORS] {}; ///< consecutive outputs assigned to the same provider
+	uint8_t _num_function_runs{0};
+
 	uORB::SubscriptionCallbackWorkItem *_subscription_callback{nullptr}; ///< current scheduling callback
 
 
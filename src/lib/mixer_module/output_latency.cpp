@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "output_latency.hpp"
+
+#include <float.h>
+
+int OutputLatency::histogramBin(uint32_t latency_us)
+{
+	// logarithmic bins, the first one has an upper limit of 50us
+	int bin = 0;
+	uint32_t limit = 50;
+
+	while (latency_us >= limit && bin < output_latency_s::HISTOGRAM_BINS - 1) {
+		limit *= 2;
+		bin++;
+	}
+
+	return bin;
+}
+
+void OutputLatency::add(int stage, const hrt_abstime &from, const hrt_abstime &to)
+{
+	const uint32_t latency_us = (to > from) ? to - from : 0;
+
+	_latency_sum_us[stage] += latency_us;
+
+	if (latency_us > _latency.latency_max_us[stage]) {
+		_latency.latency_max_us[stage] = latency_us;
+	}
+
+	uint16_t &count = _latency.histogram[stage * output_latency_s::HISTOGRAM_BINS + histogramBin(latency_us)];
+
+	if (count < UINT16_MAX) {
+		count++;
+	}
+}
+
+void OutputLatency::update(const FunctionProviderBase::LatencyTrace &trace, const hrt_abstime &timestamp_output)
+{
+	if (trace.timestamp_allocation == _last_allocation) {
+		// no new data since the previous output update (e.g. a low rate update)
+		return;
+	}
+
+	_last_allocation = trace.timestamp_allocation;
+
+	if (trace.timestamp_sample == 0 || trace.timestamp_angular_velocity == 0 || trace.timestamp_torque_setpoint == 0) {
+		updateUntraced();
+		return;
+	}
+
+	add(output_latency_s::STAGE_SENSOR, trace.timestamp_sample, trace.timestamp_angular_velocity);
+	add(output_latency_s::STAGE_RATE_CONTROL, trace.timestamp_angular_velocity, trace.timestamp_torque_setpoint);
+	add(output_latency_s::STAGE_ALLOCATION, trace.timestamp_torque_setpoint, trace.timestamp_allocation);
+	add(output_latency_s::STAGE_OUTPUT, trace.timestamp_allocation, timestamp_output);
+	add(output_latency_s::STAGE_TOTAL, trace.timestamp_sample, timestamp_output);
+	_latency.samples++;
+}
+
+void OutputLatency::publishIfNeeded(const hrt_abstime &now)
+{
+	if (now < _last_publish + PUBLISH_INTERVAL) {
+		return;
+	}
+
+	_last_publish = now;
+
+	if (_latency.samples == 0 && _latency.samples_untraced == 0) {
+		return;
+	}
+
+	for (int stage = 0; stage < output_latency_s::NUM_STAGES; stage++) {
+		_latency.latency_mean_us[stage] = (_latency.samples > 0) ? _latency_sum_us[stage] / _latency.samples : 0.f;
+		_latency_sum_us[stage] = 0.f;
+	}
+
+	_latency.timestamp = now;
+	_output_latency_pub.publish(_latency);
+
+	_latency = {};
+}
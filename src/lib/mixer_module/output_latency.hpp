@@ -0,0 +1,81 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "functions/FunctionProviderBase.hpp"
+
+#include <drivers/drv_hrt.h>
+#include <uORB/PublicationMulti.hpp>
+#include <uORB/topics/output_latency.h>
+
+/**
+ * @class OutputLatency
+ * Per-stage latency statistics of the control chain, from the gyro sample to the output update.
+ */
+class OutputLatency
+{
+public:
+	/**
+	 * Add an output update
+	 * @param trace stage timestamps of the values that were output
+	 * @param timestamp_output time of the output update
+	 */
+	void update(const FunctionProviderBase::LatencyTrace &trace, const hrt_abstime &timestamp_output);
+
+	/**
+	 * Add an output update for which no trace is available
+	 */
+	void updateUntraced() { _latency.samples_untraced++; }
+
+	/**
+	 * Publish the statistics of the last interval and reset them
+	 */
+	void publishIfNeeded(const hrt_abstime &now);
+
+	static int histogramBin(uint32_t latency_us);
+
+private:
+	void add(int stage, const hrt_abstime &from, const hrt_abstime &to);
+
+	static constexpr hrt_abstime PUBLISH_INTERVAL{1000000}; // 1 s
+
+	output_latency_s _latency{};
+	float _latency_sum_us[output_latency_s::NUM_STAGES] {};
+
+	hrt_abstime _last_allocation{0};
+	hrt_abstime _last_publish{0};
+
+	uORB::PublicationMulti<output_latency_s> _output_latency_pub{ORB_ID(output_latency)};
+};
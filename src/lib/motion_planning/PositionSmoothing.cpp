@@ -101,9 +101,17 @@ float PositionSmoothing::_getMaxXYSpeed(const Vector3f(&waypoints)[3]) const
 	// constrain velocity to go to the position setpoint first if the position setpoint has been modified by an external source
 	// (eg. Obstacle Avoidance)
 
-	Vector3f pos_to_waypoints[3] = {pos_traj, waypoints[1], waypoints[2]};
+	Vector3f pos_to_waypoints[3 + MAX_LOOKAHEAD_WAYPOINTS] = {pos_traj, waypoints[1], waypoints[2]};
+	size_t count = 3;
 
-	return math::trajectory::computeXYSpeedFromWaypoints<3>(pos_to_waypoints, config);
+	// the lookahead waypoints only apply if the next waypoint is an actual corner
+	if ((waypoints[2] - waypoints[1]).longerThan(0.001f)) {
+		for (int i = 0; i < _lookahead_count; i++) {
+			pos_to_waypoints[count++] = _lookahead_waypoints[i];
+		}
+	}
+
+	return math::trajectory::computeXYSpeedFromWaypoints(pos_to_waypoints, count, config);
 }
 
 float PositionSmoothing::_getMaxZSpeed(const Vector3f(&waypoints)[3]) const
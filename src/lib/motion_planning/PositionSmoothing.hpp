@@ -36,6 +36,7 @@
 #include <cmath>
 #include <motion_planning/VelocitySmoothing.hpp>
 
+#include <mathlib/mathlib.h>
 #include <matrix/matrix/math.hpp>
 #include <px4_defines.h>
 
@@ -363,6 +364,25 @@ public:
 		_target_acceptance_radius = radius;
 	}
 
+	/**
+	 * @brief Set the waypoints that follow the next waypoint (waypoints[2]) of generateSetpoints().
+	 * They are used to plan the speed over more than one corner: without them the vehicle
+	 * has to be able to stop at the next waypoint.
+	 *
+	 * @param waypoints array of waypoints, local frame
+	 * @param count number of waypoints, at most MAX_LOOKAHEAD_WAYPOINTS are used, 0 to disable
+	 */
+	void setLookaheadWaypoints(const Vector3f *waypoints, int count)
+	{
+		_lookahead_count = math::constrain(count, 0, MAX_LOOKAHEAD_WAYPOINTS);
+
+		for (int i = 0; i < _lookahead_count; i++) {
+			_lookahead_waypoints[i] = waypoints[i];
+		}
+	}
+
+	static constexpr int MAX_LOOKAHEAD_WAYPOINTS = 5;
+
 	/**
 	 * @brief Set the current position in the trajectory to the given value.
 	 * Any coordinate with NAN will not be set
@@ -416,6 +436,8 @@ private:
 	float _cruise_speed{0.f};
 	float _horizontal_trajectory_gain{0.f};
 	float _target_acceptance_radius{0.f};
+	Vector3f _lookahead_waypoints[MAX_LOOKAHEAD_WAYPOINTS] {};
+	int _lookahead_count{0};
 
 
 	/* Internal state */
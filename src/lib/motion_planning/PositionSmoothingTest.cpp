@@ -189,3 +189,32 @@ TEST_F(PositionSmoothingTest, reachesTargetInitialVelocity)
 	expectVectorEqual(TARGET, position, "position", EPS);
 	EXPECT_LT(iteration, N_ITER) << "Took too long to converge\n";
 }
+
+TEST_F(PositionSmoothingTest, lookaheadWaypointsIncreaseSpeed)
+{
+	// GIVEN: a straight line to be flown through closely spaced waypoints
+	const Vector3f FF_VELOCITY{0.f, 0.f, 0.f};
+	Vector3f waypoints[3] = {{0.f, 0.f, 0.f}, {3.f, 0.f, 0.f}, {6.f, 0.f, 0.f}};
+	const Vector3f lookahead[3] = {{9.f, 0.f, 0.f}, {12.f, 0.f, 0.f}, {30.f, 0.f, 0.f}};
+
+	PositionSmoothing lookahead_smoothing = _position_smoothing;
+	lookahead_smoothing.setLookaheadWaypoints(lookahead, 3);
+
+	PositionSmoothing::PositionSmoothingSetpoints out;
+	PositionSmoothing::PositionSmoothingSetpoints out_lookahead;
+
+	// WHEN: we compute the velocity setpoint at the start of the line
+	_position_smoothing.generateSetpoints(waypoints[0], waypoints, FF_VELOCITY, 0.02f, false, out);
+	lookahead_smoothing.generateSetpoints(waypoints[0], waypoints, FF_VELOCITY, 0.02f, false, out_lookahead);
+
+	// THEN: without lookahead the vehicle has to be able to stop at the next waypoint,
+	// with the lookahead it can fly faster
+	EXPECT_GT(out_lookahead.unsmoothed_velocity(0), out.unsmoothed_velocity(0) + 0.5f);
+	EXPECT_LE(out_lookahead.unsmoothed_velocity(0), CRUISE_SPEED);
+
+	// AND: the lookahead is ignored if there is no next waypoint
+	waypoints[2] = waypoints[1];
+	_position_smoothing.generateSetpoints(waypoints[0], waypoints, FF_VELOCITY, 0.02f, false, out);
+	lookahead_smoothing.generateSetpoints(waypoints[0], waypoints, FF_VELOCITY, 0.02f, false, out_lookahead);
+	EXPECT_FLOAT_EQ(out_lookahead.unsmoothed_velocity(0), out.unsmoothed_velocity(0));
+}
@@ -104,28 +104,36 @@ inline float computeStartXYSpeedFromWaypoints(const Vector3f &start_position, co
  * The first waypoint should be the starting location, and the later waypoints the desired points to be followed.
  *
  * @param waypoints the list of waypoints to be followed, the first of which should be the starting location
+ * @param count number of waypoints
  * @param config the vehicle dynamic limits
  *
  * @return the maximum speed at waypoint[0] which allows it to follow the trajectory while respecting the dynamic limits
  */
-template <size_t N>
-float computeXYSpeedFromWaypoints(const Vector3f waypoints[N], const VehicleDynamicLimits &config)
+inline float computeXYSpeedFromWaypoints(const Vector3f *waypoints, size_t count, const VehicleDynamicLimits &config)
 {
-	static_assert(N >= 2, "Need at least 2 points to compute speed");
-
 	float max_speed = 0.f;
 
-	for (size_t j = 0; j < N - 1; j++) {
-		size_t i = N - 2 - j;
+	// backward pass: the vehicle stops at the last waypoint and every corner limits the speed
+	// that still allows to slow down to the corner speed of the waypoint after it
+	for (size_t j = 0; j + 1 < count; j++) {
+		size_t i = count - 2 - j;
 		max_speed = computeStartXYSpeedFromWaypoints(waypoints[i],
 				waypoints[i + 1],
-				waypoints[min(i + 2, N - 1)],
+				waypoints[min(i + 2, count - 1)],
 				max_speed, config);
 	}
 
 	return max_speed;
 }
 
+template <size_t N>
+float computeXYSpeedFromWaypoints(const Vector3f waypoints[N], const VehicleDynamicLimits &config)
+{
+	static_assert(N >= 2, "Need at least 2 points to compute speed");
+
+	return computeXYSpeedFromWaypoints(waypoints, N, config);
+}
+
 /*
  * Constrain the 3D vector given a maximum XY norm
  * If the XY norm of the 3D vector is larger than the maximum norm, the whole vector
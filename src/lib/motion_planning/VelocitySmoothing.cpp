@@ -53,6 +53,7 @@ void VelocitySmoothing::reset(float accel, float vel, float pos)
 	_state.x = pos;
 
 	_state_init = _state;
+	_durations_cached = false;
 }
 
 float VelocitySmoothing::saturateT1ForAccel(float a0, float j_max, float T1, float a_max) const
@@ -162,7 +163,13 @@ float VelocitySmoothing::computeT3(float T1, float a0, float j_max) const
 
 void VelocitySmoothing::updateDurations(float vel_setpoint)
 {
-	_vel_sp = math::constrain(vel_setpoint, -_max_vel, _max_vel);
+	const float vel_sp = math::constrain(vel_setpoint, -_max_vel, _max_vel);
+
+	if (shiftCachedDurations(vel_sp)) {
+		return;
+	}
+
+	_vel_sp = vel_sp;
 	_local_time = 0.f;
 	_state_init = _state;
 
@@ -174,6 +181,46 @@ void VelocitySmoothing::updateDurations(float vel_setpoint)
 	} else {
 		_T1 = _T2 = _T3 = 0.f;
 	}
+
+	_cached_max_jerk = _max_jerk;
+	_cached_max_accel = _max_accel;
+	_durations_cached = true;
+}
+
+bool VelocitySmoothing::shiftCachedDurations(float vel_sp)
+{
+	if (!_durations_cached
+	    || (fabsf(vel_sp - _vel_sp) > VEL_SP_CACHE_TOLERANCE)
+	    || (fabsf(_max_jerk - _cached_max_jerk) > FLT_EPSILON)
+	    || (fabsf(_max_accel - _cached_max_accel) > FLT_EPSILON)) {
+		return false;
+	}
+
+	float t = _local_time;
+
+	float T1 = _T1 - t;
+	t = math::max(-T1, 0.f);
+	float T2 = _T2 - t;
+	t = math::max(-T2, 0.f);
+	float T3 = _T3 - t;
+
+	// the rounding errors of the integration must not push the acceleration over its limit
+	T1 = math::max(saturateT1ForAccel(_state.a, _direction * _max_jerk, T1, _max_accel), 0.f);
+	T2 = math::max(T2, 0.f);
+	T3 = math::max(T3, 0.f);
+
+	if (T1 + T2 + T3 <= 0.f) {
+		// The profile is over, solve again to remove the integration error
+		return false;
+	}
+
+	_T1 = T1;
+	_T2 = T2;
+	_T3 = T3;
+	_local_time = 0.f;
+	_state_init = _state;
+
+	return true;
 }
 
 int VelocitySmoothing::computeDirection() const
@@ -289,6 +336,9 @@ void VelocitySmoothing::timeSynchronization(VelocitySmoothing *traj, int n_traj)
 
 void VelocitySmoothing::updateDurationsGivenTotalTime(float T123)
 {
+	// the stretched profile depends on the other trajectories
+	_durations_cached = false;
+
 	float jerk_max_T1 = _direction * _max_jerk;
 	float delta_v = _vel_sp - _state.v;
 
@@ -100,9 +100,9 @@ public:
 	void setMaxVel(float max_vel) { _max_vel = max_vel; }
 
 	float getCurrentJerk() const { return _state.j; }
-	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; }
+	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; _durations_cached = false; }
 	float getCurrentAcceleration() const { return _state.a; }
-	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; }
+	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; _durations_cached = false; }
 	float getCurrentVelocity() const { return _state.v; }
 	void setCurrentPosition(const float pos) { _state.x = _state_init.x = pos; }
 	float getCurrentPosition() const { return _state.x; }
@@ -137,6 +137,14 @@ private:
 	 */
 	void updateDurationsGivenTotalTime(float T123);
 
+	/**
+	 * Reuse the durations of the previous call if the setpoint and the constraints did not change
+	 * and the state only evolved along the previous profile (updateTraj()). The remaining profile
+	 * is then the previous one shifted by the elapsed time, which is what the solver would return.
+	 * @return true if the durations were shifted, false if they have to be recomputed
+	 */
+	bool shiftCachedDurations(float vel_sp);
+
 	/**
 	 * Compute the direction of the jerk to be applied in order to drive the current state
 	 * to the desired one
@@ -199,6 +207,13 @@ private:
 	float _max_accel = 8.f;
 	float _max_vel = 6.f;
 
+	/* Constraints used to compute the current durations */
+	float _cached_max_jerk{0.f};
+	float _cached_max_accel{0.f};
+	bool _durations_cached{false}; ///< durations are time optimal for the state at _state_init
+
+	static constexpr float VEL_SP_CACHE_TOLERANCE = 1e-4f; ///< [m/s] setpoint change that requires a new solution
+
 	/* State (previous setpoints) */
 	Trajectory _state{};
 	int _direction{0};
@@ -208,3 +208,40 @@ TEST_F(VelocitySmoothingTest, testZeroSetpoint)
 		EXPECT_FLOAT_EQ(_trajectories[i].getCurrentPosition(), 0.f);
 	}
 }
+
+TEST_F(VelocitySmoothingTest, testCachedDurations)
+{
+	// GIVEN: two identical trajectories
+	VelocitySmoothing cached;
+	VelocitySmoothing solved;
+
+	for (VelocitySmoothing *traj : {&cached, &solved}) {
+		traj->setMaxJerk(55.2f);
+		traj->setMaxAccel(6.f);
+		traj->setMaxVel(6.f);
+		traj->reset(0.5f, -1.f, 0.f);
+	}
+
+	// WHEN: one of them is forced to solve its durations again on every update
+	const float dt = 0.01f;
+
+	for (int i = 0; i < 300; i++) {
+		const float velocity_setpoint = (i < 150) ? 4.f : -2.f;
+
+		cached.updateTraj(dt);
+		solved.updateTraj(dt);
+
+		solved.setCurrentAcceleration(solved.getCurrentAcceleration());
+
+		cached.updateDurations(velocity_setpoint);
+		solved.updateDurations(velocity_setpoint);
+
+		// THEN: the cached profile is the same as the new solution
+		EXPECT_NEAR(cached.getTotalTime(), solved.getTotalTime(), 1e-3f);
+		EXPECT_NEAR(cached.getCurrentAcceleration(), solved.getCurrentAcceleration(), 1e-3f);
+		EXPECT_NEAR(cached.getCurrentVelocity(), solved.getCurrentVelocity(), 1e-4f);
+		EXPECT_NEAR(cached.getCurrentPosition(), solved.getCurrentPosition(), 1e-4f);
+	}
+
+	EXPECT_NEAR(cached.getCurrentVelocity(), -2.f, 1e-3f);
+}
@@ -37,9 +37,42 @@
  */
 
 #include "VelocitySmoothing.hpp"
+#include <chrono>
 #include <cstdio>
 #include <matrix/matrix/math.hpp>
 
+/**
+ * Time the trajectory generation of a long constant setpoint step
+ * @param resolve force the durations to be solved on every cycle instead of reusing the cached profile
+ * @return average time per cycle in ns
+ */
+static double benchmark(bool resolve)
+{
+	static constexpr int nb_steps = 100000;
+	VelocitySmoothing trajectory;
+	trajectory.setMaxJerk(4.f);
+	trajectory.setMaxAccel(3.f);
+	trajectory.setMaxVel(1e5f);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < nb_steps; i++) {
+		trajectory.updateTraj(0.01f);
+
+		if (resolve) {
+			trajectory.setCurrentVelocity(trajectory.getCurrentVelocity());
+		}
+
+		trajectory.updateDurations(1e4f);
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	printf("%s: vel = %.3f\t", resolve ? "solved" : "cached", trajectory.getCurrentVelocity());
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / nb_steps;
+}
+
 int main(int argc, char *argv[])
 {
 	VelocitySmoothing trajectory[3];
@@ -95,5 +128,8 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	printf("%.1f ns per cycle\n", benchmark(true));
+	printf("%.1f ns per cycle\n", benchmark(false));
+
 	return 0;
 }
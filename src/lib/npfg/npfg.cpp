@@ -47,6 +47,17 @@
 using matrix::Vector2d;
 using matrix::Vector2f;
 
+// sin^2(pi/2 * x) for x = [0, 1] in steps of 1/32, sampled for the continuous bearing feasibility
+static constexpr int FEASIBILITY_TABLE_SIZE = 33;
+static constexpr float FEASIBILITY_TABLE[FEASIBILITY_TABLE_SIZE] = {
+	0.0000000f, 0.0024076f, 0.0096074f, 0.0215298f, 0.0380602f, 0.0590394f,
+	0.0842652f, 0.1134948f, 0.1464466f, 0.1828034f, 0.2222149f, 0.2643016f,
+	0.3086583f, 0.3548577f, 0.4024548f, 0.4509914f, 0.5000000f, 0.5490086f,
+	0.5975452f, 0.6451423f, 0.6913417f, 0.7356984f, 0.7777851f, 0.8171966f,
+	0.8535534f, 0.8865052f, 0.9157348f, 0.9409606f, 0.9619398f, 0.9784702f,
+	0.9903926f, 0.9975924f, 1.0000000f
+};
+
 void NPFG::guideToPath(const Vector2f &ground_vel, const Vector2f &wind_vel, const Vector2f &unit_path_tangent,
 		       const float signed_track_error, const float path_curvature)
 {
@@ -79,10 +90,11 @@ void NPFG::guideToPath(const Vector2f &ground_vel, const Vector2f &wind_vel, con
 
 	// look ahead angle based solely on track proximity
 	const float look_ahead_ang = lookAheadAngle(normalized_track_error);
+	const float sin_look_ahead_ang = sinf(look_ahead_ang);
 
-	track_proximity_ = trackProximity(look_ahead_ang);
+	track_proximity_ = sin_look_ahead_ang * sin_look_ahead_ang; // see trackProximity()
 
-	bearing_vec_ = bearingVec(unit_path_tangent, look_ahead_ang, signed_track_error);
+	bearing_vec_ = bearingVec(unit_path_tangent, cosf(look_ahead_ang), sin_look_ahead_ang, signed_track_error);
 
 	// wind triangle projections
 	const float wind_cross_bearing = wind_vel.cross(bearing_vec_);
@@ -312,12 +324,9 @@ float NPFG::lookAheadAngle(const float normalized_track_error) const
 	return M_PI_F * 0.5f * (normalized_track_error - 1.0f) * (normalized_track_error - 1.0f);
 } // lookAheadAngle
 
-Vector2f NPFG::bearingVec(const Vector2f &unit_path_tangent, const float look_ahead_ang,
-			  const float signed_track_error) const
+Vector2f NPFG::bearingVec(const Vector2f &unit_path_tangent, const float cos_look_ahead_ang,
+			  const float sin_look_ahead_ang, const float signed_track_error) const
 {
-	const float cos_look_ahead_ang = cosf(look_ahead_ang);
-	const float sin_look_ahead_ang = sinf(look_ahead_ang);
-
 	Vector2f unit_path_normal(-unit_path_tangent(1), unit_path_tangent(0)); // right handed 90 deg (clockwise) turn
 	Vector2f unit_track_error = -((signed_track_error < 0.0f) ? -1.0f : 1.0f) * unit_path_normal;
 
@@ -460,8 +469,18 @@ float NPFG::bearingFeasibility(float wind_cross_bearing, const float wind_dot_be
 		wind_cross_bearing = fabsf(wind_cross_bearing);
 	}
 
-	float sin_arg = sinf(M_PI_F * 0.5f * math::constrain((airspeed - wind_cross_bearing) / AIRSPEED_BUFFER, 0.0f, 1.0f));
-	return sin_arg * sin_arg;
+	// sin^2(pi/2 * x), linearly interpolated in the table (error < 1e-3)
+	const float x = math::constrain((airspeed - wind_cross_bearing) / AIRSPEED_BUFFER, 0.0f,
+					1.0f) * (FEASIBILITY_TABLE_SIZE - 1);
+
+	if (!PX4_ISFINITE(x)) {
+		return NAN;
+	}
+
+	const int index = math::min(static_cast<int>(x), FEASIBILITY_TABLE_SIZE - 2);
+	const float fraction = x - index;
+
+	return FEASIBILITY_TABLE[index] + fraction * (FEASIBILITY_TABLE[index + 1] - FEASIBILITY_TABLE[index]);
 } // bearingFeasibility
 
 float NPFG::lateralAccelFF(const Vector2f &unit_path_tangent, const Vector2f &ground_vel,
@@ -527,23 +546,32 @@ void NPFG::navigateWaypoints(const Vector2f &waypoint_A, const Vector2f &waypoin
 
 	path_type_loiter_ = false;
 
-	Vector2f vector_A_to_B = waypoint_B - waypoint_A;
+	if ((waypoint_A != waypoint_A_) || (waypoint_B != waypoint_B_)) {
+		// the line only changes with the waypoints, not with the vehicle position
+		waypoint_A_ = waypoint_A;
+		waypoint_B_ = waypoint_B;
+
+		const Vector2f vector_A_to_B = waypoint_B - waypoint_A;
+		length_A_to_B_ = vector_A_to_B.norm();
+		unit_tangent_A_to_B_ = (length_A_to_B_ < NPFG_EPSILON) ? Vector2f{} : vector_A_to_B / length_A_to_B_;
+	}
+
 	Vector2f vector_A_to_vehicle = vehicle_pos - waypoint_A;
 
-	if (vector_A_to_B.norm() < NPFG_EPSILON) {
+	if (length_A_to_B_ < NPFG_EPSILON) {
 		// the waypoints are on top of each other and should be considered as a
 		// single waypoint, fly directly to it
 		unit_path_tangent_ = -vector_A_to_vehicle.normalized();
 		signed_track_error_ = vector_A_to_vehicle.norm();
 		guideToPoint(ground_vel, wind_vel, unit_path_tangent_, signed_track_error_);
 
-	} else if (vector_A_to_B.dot(vector_A_to_vehicle) < 0.0f) {
+	} else if (unit_tangent_A_to_B_.dot(vector_A_to_vehicle) < 0.0f) {
 		// we are in front of waypoint A, fly directly to it until the bearing generated
 		// to the line segement between A and B is shallower than that from the
 		// bearing to the first waypoint (A).
 
 		// guidance to the line through A and B
-		unit_path_tangent_ = vector_A_to_B.normalized();
+		unit_path_tangent_ = unit_tangent_A_to_B_;
 		signed_track_error_ = unit_path_tangent_.cross(vector_A_to_vehicle);
 		guideToPath(ground_vel, wind_vel, unit_path_tangent_, signed_track_error_, 0.0f);
 
@@ -565,7 +593,7 @@ void NPFG::navigateWaypoints(const Vector2f &waypoint_A, const Vector2f &waypoin
 
 	} else {
 		// track the line segment between A and B
-		unit_path_tangent_ = vector_A_to_B.normalized();
+		unit_path_tangent_ = unit_tangent_A_to_B_;
 		signed_track_error_ = unit_path_tangent_.cross(vector_A_to_vehicle);
 		guideToPath(ground_vel, wind_vel, unit_path_tangent_, signed_track_error_, 0.0f);
 	}
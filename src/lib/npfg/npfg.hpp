@@ -423,6 +423,12 @@ private:
 	float signed_track_error_{0.0f}; // signed track error [m]
 	matrix::Vector2f bearing_vec_{matrix::Vector2f{1.0f, 0.0f}}; // bearing unit vector
 
+	// waypoint line geometry, only recomputed when the waypoints change
+	matrix::Vector2f waypoint_A_{NAN, NAN}; // first waypoint of the line [m]
+	matrix::Vector2f waypoint_B_{NAN, NAN}; // second waypoint of the line [m]
+	matrix::Vector2f unit_tangent_A_to_B_{matrix::Vector2f{1.0f, 0.0f}}; // unit vector from A to B
+	float length_A_to_B_{0.0f}; // distance from A to B [m]
+
 	/*
 	 * guidance outputs
 	 */
@@ -589,14 +595,15 @@ private:
 	 *
 	 * @param[in] unit_path_tangent Unit vector tangent to path at closest point
 	 *            in direction of path
-	 * @param[in] look_ahead_ang The bearing vector lies at this angle from
-	 *            the path normal vector [rad]
+	 * @param[in] cos_look_ahead_ang Cosine of the look ahead angle, the bearing vector
+	 *            lies at this angle from the path normal vector
+	 * @param[in] sin_look_ahead_ang Sine of the look ahead angle
 	 * @param[in] signed_track_error Signed error to track at closest point (sign
 	 *            determined by path normal direction) [m]
 	 * @return Unit bearing vector
 	 */
-	matrix::Vector2f bearingVec(const matrix::Vector2f &unit_path_tangent, const float look_ahead_ang,
-				    const float signed_track_error) const;
+	matrix::Vector2f bearingVec(const matrix::Vector2f &unit_path_tangent, const float cos_look_ahead_ang,
+				    const float sin_look_ahead_ang, const float signed_track_error) const;
 
 	/*
 	 * Calculates the minimum forward ground speed demand for minimum forward
@@ -106,3 +106,73 @@ TEST_F(ParameterTest, testUorbSendReceive)
 	// AND: all the bytes should be equal
 	EXPECT_EQ(0, memcmp(&message, &obstacle_distance, sizeof(message)));
 }
+
+TEST_F(ParameterTest, testParamChangedSince)
+{
+	// GIVEN: a change generation
+	const param_t param = param_handle(px4::params::CP_DIST);
+	const param_t other_param = param_handle(px4::params::CP_DELAY);
+	const uint32_t generation = param_change_generation();
+
+	// THEN: nothing changed yet
+	EXPECT_FALSE(param_changed_since(param, generation));
+
+	// WHEN: we set a parameter
+	float value = 12.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: only that parameter changed
+	EXPECT_TRUE(param_changed_since(param, generation));
+	EXPECT_FALSE(param_changed_since(other_param, generation));
+	EXPECT_FALSE(param_changed_since(param, param_change_generation()));
+
+	// WHEN: we set the same value again
+	const uint32_t generation2 = param_change_generation();
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it is not considered a change
+	EXPECT_FALSE(param_changed_since(param, generation2));
+
+	// WHEN: all parameters are reset
+	param_reset_all();
+
+	// THEN: all parameters changed
+	EXPECT_TRUE(param_changed_since(other_param, generation2));
+}
+
+class ParameterTestModule : public ModuleParams
+{
+public:
+	ParameterTestModule() : ModuleParams(nullptr) {}
+
+	void update() { updateParams(); }
+
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::CP_DIST>) _param_cp_dist,
+		(ParamFloat<px4::params::CP_DELAY>) _param_cp_delay
+	)
+};
+
+TEST_F(ParameterTest, testModuleParamsSelectiveUpdate)
+{
+	// GIVEN: a module with a locally modified (not committed) parameter
+	ParameterTestModule module;
+	module._param_cp_delay.set(123.f);
+
+	// WHEN: another parameter of the module changes
+	float value = 7.f;
+	EXPECT_EQ(0, param_set(param_handle(px4::params::CP_DIST), &value));
+	module.update();
+
+	// THEN: only the changed parameter is updated
+	EXPECT_FLOAT_EQ(7.f, module._param_cp_dist.get());
+	EXPECT_FLOAT_EQ(123.f, module._param_cp_delay.get());
+
+	// WHEN: the other parameter changes as well
+	value = 0.5f;
+	EXPECT_EQ(0, param_set(param_handle(px4::params::CP_DELAY), &value));
+	module.update();
+
+	// THEN: it is updated
+	EXPECT_FLOAT_EQ(0.5f, module._param_cp_delay.get());
+}
@@ -273,6 +273,22 @@ __EXPORT int		param_set_no_notification(param_t param, const void *val);
  */
 __EXPORT void		param_notify_changes(void);
 
+/**
+ * Get the current parameter change generation, which increases with every parameter value change.
+ */
+__EXPORT uint32_t	param_change_generation(void);
+
+/**
+ * Check if the value of a parameter might have changed since a change generation.
+ * It can return true for unchanged parameters (e.g. if the generation is too old), but never false
+ * for a changed one.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param generation	Change generation, as returned by param_change_generation()
+ * @return		true if the parameter changed
+ */
+__EXPORT bool		param_changed_since(param_t param, uint32_t generation);
+
 /**
  * Reset a parameter to its default value.
  *
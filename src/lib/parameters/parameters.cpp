@@ -50,6 +50,7 @@
 #include <crc32.h>
 #include <float.h>
 #include <math.h>
+#include <stddef.h>
 
 #include <containers/Bitset.hpp>
 #include <drivers/drv_hrt.h>
@@ -88,10 +89,44 @@ inline static int flash_param_import() { return -1; }
 static char *param_default_file = nullptr;
 static char *param_backup_file = nullptr;
 
-#include <px4_platform_common/workqueue.h>
+/**
+ * Parameter journal: every BSON document written by param_export_internal() is followed by a header
+ * record with a new random epoch. Autosaves of the default file then only append a record per
+ * changed parameter (param_journal_append()), until PARAM_JOURNAL_MAX_RECORDS is reached and
+ * the whole document is rewritten (compaction). On import the journal is replayed up to the
+ * first record with an invalid CRC or a different epoch.
+ */
+struct param_journal_record_s {
+	uint16_t magic;
+	uint8_t type;
+	uint8_t reserved;
+	uint32_t epoch;
+	char name[16];		///< parameter name (not null terminated if 16 characters)
+	int32_t value;		///< raw 32 bit value (int32 or float)
+	uint32_t crc;
+};
+
+static_assert(sizeof(param_journal_record_s) == 32, "unexpected journal record size");
+
+static constexpr uint16_t PARAM_JOURNAL_MAGIC = 0x4A50; // "PJ"
+static constexpr uint8_t PARAM_JOURNAL_HEADER = 0;
+static constexpr uint8_t PARAM_JOURNAL_SET = 1;
+static constexpr uint8_t PARAM_JOURNAL_RESET = 2;
+static constexpr int PARAM_JOURNAL_MAX_RECORDS = 64;
+
+struct param_journal_s {
+	off_t offset{-1};	///< file offset of the next record, -1 if unknown (rewrite the whole file)
+	uint32_t epoch{0};
+	int records{0};
+};
+
+static param_journal_s param_journal_default{}; ///< journal of the default file
+static uint32_t param_journal_epoch{0};
+
+#include <px4_platform_common/px4_work_queue/AsyncIoRequest.hpp>
 /* autosaving variables */
 static hrt_abstime last_autosave_timestamp = 0;
-static struct work_s autosave_work {};
+static px4::AsyncIoRequest *autosave_request{nullptr}; ///< runs on the storage work queue, created on first use
 static px4::atomic_bool autosave_scheduled{false};
 static bool autosave_disabled = false;
 
@@ -112,6 +147,37 @@ UT_array *param_custom_default_values{nullptr};
 
 const UT_icd param_icd = {sizeof(param_wbuf_s), nullptr, nullptr, nullptr};
 
+#if !defined(CONSTRAINED_MEMORY)
+/**
+ * Dense copy of the current value of every parameter (one 32 bit slot per parameter),
+ * kept in sync by the writers. This allows param_get() of changed parameters and parameters
+ * with a custom default without locking and searching param_values.
+ */
+#define PARAM_FLAT_STORAGE
+static int32_t param_values_flat[param_info_count] {};
+#endif // !CONSTRAINED_MEMORY
+
+#if defined(CONFIG_BOARD_PARAM_AIRFRAME_DEFAULTS)
+#include <parameters/px4_airframe_defaults.hpp>
+/**
+ * Flash resident custom defaults of the ROMFS airframes, generated from their 'param set-default' lines.
+ * A custom default matching the table of the active airframe (SYS_AUTOSTART) only sets its
+ * params_custom_default bit, any other value is stored in param_custom_default_values.
+ */
+#define PARAM_AIRFRAME_DEFAULTS
+static int param_airframe_table{-1}; ///< table of the active airframe, -1 for none
+static int32_t param_airframe_autostart{0}; ///< SYS_AUTOSTART param_airframe_table was selected for
+#endif // CONFIG_BOARD_PARAM_AIRFRAME_DEFAULTS
+
+/**
+ * Log of the last parameter changes for selective updates (@see param_changed_since()): the change with
+ * generation g is stored at param_change_log[g % PARAM_CHANGE_LOG_SIZE]. Readers that are further behind
+ * consider all parameters as changed.
+ */
+static constexpr uint32_t PARAM_CHANGE_LOG_SIZE = 32;
+static param_t param_change_log[PARAM_CHANGE_LOG_SIZE] {};
+static px4::atomic<uint32_t> param_change_count{0};
+
 /** parameter update topic handle */
 static orb_advert_t param_topic = nullptr;
 static unsigned int param_instance = 0;
@@ -198,6 +264,14 @@ param_init()
 	param_get_perf = perf_alloc(PC_COUNT, "param: get");
 	param_set_perf = perf_alloc(PC_ELAPSED, "param: set");
 
+#if defined(PARAM_FLAT_STORAGE)
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		param_values_flat[param] = px4::parameters[param].val.i;
+	}
+
+#endif // PARAM_FLAT_STORAGE
+
 #if defined(__PX4_NUTTX) && !defined(CONFIG_BUILD_FLAT)
 	px4_register_boardct_ioctl(_PARAMIOCBASE, param_ioctl);
 #endif
@@ -246,6 +320,81 @@ param_find_changed(param_t param)
 	return nullptr;
 }
 
+/**
+ * Locate the custom default value of a parameter stored in RAM, if it exists.
+ */
+static param_wbuf_s *
+param_find_custom_default(param_t param)
+{
+	if (param_custom_default_values != nullptr) {
+		param_wbuf_s key{};
+		key.param = param;
+		return (param_wbuf_s *)utarray_find(param_custom_default_values, &key, param_compare_values);
+	}
+
+	return nullptr;
+}
+
+#if defined(PARAM_AIRFRAME_DEFAULTS)
+/**
+ * Find a parameter in the table of the active airframe and the tables it chains to.
+ *
+ * @return			Pointer to the raw value in flash, or nullptr if not found.
+ */
+static const int32_t *
+param_find_airframe_default(param_t param)
+{
+	using namespace px4::airframe_defaults;
+
+	for (int t = param_airframe_table; t >= 0; t = tables[t].parent) {
+		int low = tables[t].offset;
+		int high = tables[t].offset + tables[t].count - 1;
+
+		while (low <= high) {
+			const int mid = (low + high) / 2;
+			const param_t p = static_cast<param_t>(entry_param[mid]);
+
+			if (p == param) {
+				return &entry_value[mid];
+
+			} else if (p < param) {
+				low = mid + 1;
+
+			} else {
+				high = mid - 1;
+			}
+		}
+	}
+
+	return nullptr;
+}
+#endif // PARAM_AIRFRAME_DEFAULTS
+
+/**
+ * Get a pointer to the custom default value of a parameter (RAM or airframe table).
+ *
+ * @return			The custom default, or nullptr if the parameter has none.
+ */
+static const void *
+param_get_custom_default_ptr(param_t param)
+{
+	param_assert_locked();
+
+	if (params_custom_default[param]) {
+		param_wbuf_s *s = param_find_custom_default(param);
+
+		if (s != nullptr) {
+			return &s->val;
+		}
+
+#if defined(PARAM_AIRFRAME_DEFAULTS)
+		return param_find_airframe_default(param);
+#endif // PARAM_AIRFRAME_DEFAULTS
+	}
+
+	return nullptr;
+}
+
 void
 param_notify_changes()
 {
@@ -272,6 +421,27 @@ static param_t param_find_internal(const char *name, bool notification)
 {
 	perf_count(param_find_perf);
 
+#if !defined(CONSTRAINED_FLASH)
+
+	if (param_info_count == 0) {
+		return PARAM_INVALID;
+	}
+
+	/* perfect hash lookup (generated by px_generate_params.py) */
+	const int16_t displacement = px4::parameters_hash_displacement[px4::param_name_hash(name, 0) % param_info_count];
+	const param_t param = (displacement < 0) ? (-displacement - 1) :
+			      px4::parameters_hash_index[px4::param_name_hash(name, displacement) % param_info_count];
+
+	/* unknown names hash to an arbitrary parameter */
+	if (strcmp(name, param_name(param)) == 0) {
+		if (notification) {
+			param_set_used(param);
+		}
+
+		return param;
+	}
+
+#else
 	param_t middle;
 	param_t front = 0;
 	param_t last = param_info_count;
@@ -301,6 +471,8 @@ static param_t param_find_internal(const char *name, bool notification)
 		}
 	}
 
+#endif // !CONSTRAINED_FLASH
+
 	/* not found */
 	return PARAM_INVALID;
 }
@@ -392,15 +564,11 @@ param_get_value_ptr(param_t param)
 			return &s->val;
 
 		} else {
-			if (params_custom_default[param] && param_custom_default_values) {
-				// get default from custom default storage
-				param_wbuf_s key{};
-				key.param = param;
-				param_wbuf_s *pbuf = (param_wbuf_s *)utarray_find(param_custom_default_values, &key, param_compare_values);
-
-				if (pbuf != nullptr) {
-					return &pbuf->val;
-				}
+			// get default from custom default storage
+			const void *custom_default = param_get_custom_default_ptr(param);
+
+			if (custom_default != nullptr) {
+				return custom_default;
 			}
 
 			// otherwise return static default value
@@ -417,6 +585,74 @@ param_get_value_ptr(param_t param)
 	return nullptr;
 }
 
+/**
+ * Update the flat copy of a parameter value after its storage changed (writer lock held).
+ */
+static void
+param_flat_update(param_t param)
+{
+#if defined(PARAM_FLAT_STORAGE)
+	const param_value_u *v = (const param_value_u *)param_get_value_ptr(param);
+
+	if (v != nullptr) {
+		__atomic_store_n(&param_values_flat[param], v->i, __ATOMIC_RELEASE);
+	}
+
+#endif // PARAM_FLAT_STORAGE
+}
+
+/**
+ * Record a parameter value change (writer lock held).
+ */
+static void
+param_record_change(param_t param)
+{
+	const uint32_t generation = param_change_count.load();
+	param_change_log[generation % PARAM_CHANGE_LOG_SIZE] = param;
+	param_change_count.store(generation + 1);
+}
+
+/**
+ * Record a change of all parameters (writer lock held).
+ */
+static void
+param_record_change_all()
+{
+	param_change_count.fetch_add(PARAM_CHANGE_LOG_SIZE + 1);
+}
+
+uint32_t
+param_change_generation()
+{
+	return param_change_count.load();
+}
+
+bool
+param_changed_since(param_t param, uint32_t generation)
+{
+	const uint32_t current = param_change_count.load();
+
+	if (current == generation) {
+		return false;
+	}
+
+	if (current - generation > PARAM_CHANGE_LOG_SIZE) {
+		return true;
+	}
+
+	bool changed = false;
+
+	for (uint32_t g = generation; g != current; g++) {
+		if (param_change_log[g % PARAM_CHANGE_LOG_SIZE] == param) {
+			changed = true;
+			break;
+		}
+	}
+
+	// a writer might have overwritten the entries while we were reading them
+	return changed || (param_change_count.load() - generation > PARAM_CHANGE_LOG_SIZE);
+}
+
 int
 param_get(param_t param, void *val)
 {
@@ -447,6 +683,12 @@ param_get(param_t param, void *val)
 			}
 		}
 
+#if defined(PARAM_FLAT_STORAGE)
+		// all parameter types are 32 bit, read the current value without locking
+		const int32_t v = __atomic_load_n(&param_values_flat[param], __ATOMIC_ACQUIRE);
+		memcpy(val, &v, sizeof(v));
+		result = PX4_OK;
+#else
 		param_lock_reader();
 		const void *v = param_get_value_ptr(param);
 
@@ -456,6 +698,7 @@ param_get(param_t param, void *val)
 		}
 
 		param_unlock_reader();
+#endif // PARAM_FLAT_STORAGE
 	}
 
 	return result;
@@ -470,16 +713,12 @@ param_get_default_value_internal(param_t param, void *default_val)
 	}
 
 	if (default_val) {
-		if (params_custom_default[param] && param_custom_default_values) {
-			// get default from custom default storage
-			param_wbuf_s key{};
-			key.param = param;
-			param_wbuf_s *pbuf = (param_wbuf_s *)utarray_find(param_custom_default_values, &key, param_compare_values);
+		// get default from custom default storage
+		const void *custom_default = param_get_custom_default_ptr(param);
 
-			if (pbuf != nullptr) {
-				memcpy(default_val, &pbuf->val, param_size(param));
-				return PX4_OK;
-			}
+		if (custom_default != nullptr) {
+			memcpy(default_val, custom_default, param_size(param));
+			return PX4_OK;
 		}
 
 		// otherwise return static default value
@@ -586,7 +825,7 @@ bool param_value_is_default(param_t param)
  * worker callback method to save the parameters
  * @param arg unused
  */
-static void
+static int
 autosave_worker(void *arg)
 {
 	bool disabled = false;
@@ -597,8 +836,8 @@ autosave_worker(void *arg)
 		uORB::SubscriptionData<actuator_armed_s> armed_sub{ORB_ID(actuator_armed)};
 
 		if (armed_sub.get().armed) {
-			work_queue(LPWORK, &autosave_work, (worker_t)&autosave_worker, nullptr, USEC2TICK(1_s));
-			return;
+			autosave_request->submit(1_s);
+			return PX4_OK;
 		}
 	}
 
@@ -609,7 +848,7 @@ autosave_worker(void *arg)
 	param_unlock_writer();
 
 	if (disabled) {
-		return;
+		return PX4_OK;
 	}
 
 	PX4_DEBUG("Autosaving params");
@@ -618,6 +857,8 @@ autosave_worker(void *arg)
 	if (ret != 0) {
 		PX4_ERR("param auto save failed (%i)", ret);
 	}
+
+	return ret;
 }
 
 /**
@@ -646,8 +887,17 @@ param_autosave()
 		delay = rate_limit - last_save_elapsed;
 	}
 
+	if (autosave_request == nullptr) {
+		autosave_request = new px4::AsyncIoRequest("param_autosave", autosave_worker, nullptr);
+
+		if (autosave_request == nullptr) {
+			PX4_ERR("param auto save alloc failed");
+			return;
+		}
+	}
+
 	autosave_scheduled.store(true);
-	work_queue(LPWORK, &autosave_work, (worker_t)&autosave_worker, nullptr, USEC2TICK(delay));
+	autosave_request->submit(delay);
 }
 
 void
@@ -656,7 +906,7 @@ param_control_autosave(bool enable)
 	param_lock_writer();
 
 	if (!enable && autosave_scheduled.load()) {
-		work_cancel(LPWORK, &autosave_work);
+		autosave_request->cancel();
 		autosave_scheduled.store(false);
 	}
 
@@ -749,6 +999,14 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			}
 		}
 
+		if (result == PX4_OK) {
+			param_flat_update(param);
+		}
+
+		if ((result == PX4_OK) && param_changed) {
+			param_record_change(param);
+		}
+
 		if ((result == PX4_OK) && param_changed && !mark_saved) { // this is false when importing parameters
 			param_autosave();
 		}
@@ -807,6 +1065,73 @@ void param_set_used(param_t param)
 	}
 }
 
+#if defined(PARAM_AIRFRAME_DEFAULTS)
+/**
+ * Select the airframe defaults table matching the current SYS_AUTOSTART (writer lock held).
+ * Custom defaults backed by the previous table are moved to RAM first.
+ */
+static void
+param_airframe_defaults_update()
+{
+	using namespace px4::airframe_defaults;
+
+	int32_t autostart = 0;
+	const void *v = param_get_value_ptr(static_cast<param_t>(px4::params::SYS_AUTOSTART));
+
+	if (v != nullptr) {
+		memcpy(&autostart, v, sizeof(autostart));
+	}
+
+	if (autostart == param_airframe_autostart) {
+		return;
+	}
+
+	int table = -1;
+	int low = 0;
+	int high = airframes_count - 1;
+
+	while (low <= high) {
+		const int mid = (low + high) / 2;
+
+		if (airframes[mid].autostart == autostart) {
+			table = airframes[mid].table;
+			break;
+
+		} else if (airframes[mid].autostart < autostart) {
+			low = mid + 1;
+
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	if ((table != param_airframe_table) && (param_airframe_table >= 0)) {
+		bool added = false;
+
+		for (param_t param = 0; param < param_info_count; param++) {
+			if (params_custom_default[param] && (param_find_custom_default(param) == nullptr)) {
+				const int32_t *value = param_find_airframe_default(param);
+
+				if (value != nullptr) {
+					param_wbuf_s buf{};
+					buf.param = param;
+					buf.val.i = *value;
+					utarray_push_back(param_custom_default_values, &buf);
+					added = true;
+				}
+			}
+		}
+
+		if (added) {
+			utarray_sort(param_custom_default_values, param_compare_values);
+		}
+	}
+
+	param_airframe_table = table;
+	param_airframe_autostart = autostart;
+}
+#endif // PARAM_AIRFRAME_DEFAULTS
+
 int param_set_default_value(param_t param, const void *val)
 {
 	if (!handle_in_range(param)) {
@@ -849,16 +1174,24 @@ int param_set_default_value(param_t param, const void *val)
 		break;
 	}
 
-	// find if custom default value is already set
-	param_wbuf_s *s = nullptr;
+	// values matching the airframe defaults table don't need any storage
+	bool setting_to_airframe_default = false;
 
-	{
-		param_wbuf_s key{};
-		key.param = param;
-		s = (param_wbuf_s *)utarray_find(param_custom_default_values, &key, param_compare_values);
+#if defined(PARAM_AIRFRAME_DEFAULTS)
+	param_airframe_defaults_update();
+
+	if (!setting_to_static_default) {
+		const int32_t *airframe_default = param_find_airframe_default(param);
+		setting_to_airframe_default = (airframe_default != nullptr)
+					      && (memcmp(airframe_default, val, sizeof(*airframe_default)) == 0);
 	}
 
-	if (setting_to_static_default) {
+#endif // PARAM_AIRFRAME_DEFAULTS
+
+	// find if custom default value is already set
+	param_wbuf_s *s = param_find_custom_default(param);
+
+	if (setting_to_static_default || setting_to_airframe_default) {
 		if (s != nullptr) {
 			// param in memory and set to non-default value, clear
 			int pos = utarray_eltidx(param_custom_default_values, s);
@@ -866,7 +1199,7 @@ int param_set_default_value(param_t param, const void *val)
 		}
 
 		// do nothing if param not already set and being set to default
-		params_custom_default.set(param, false);
+		params_custom_default.set(param, setting_to_airframe_default);
 		result = PX4_OK;
 
 	} else {
@@ -904,6 +1237,11 @@ int param_set_default_value(param_t param, const void *val)
 		}
 	}
 
+	if (result == PX4_OK) {
+		param_flat_update(param);
+		param_record_change(param);
+	}
+
 	param_unlock_writer();
 
 	if ((result == PX4_OK) && param_used(param)) {
@@ -914,7 +1252,7 @@ int param_set_default_value(param_t param, const void *val)
 	return result;
 }
 
-static int param_reset_internal(param_t param, bool notify = true)
+static int param_reset_internal(param_t param, bool notify = true, bool mark_saved = false)
 {
 	param_wbuf_s *s = nullptr;
 	bool param_found = false;
@@ -932,12 +1270,20 @@ static int param_reset_internal(param_t param, bool notify = true)
 		}
 
 		params_changed.set(param, false);
-		params_unsaved.set(param, true);
+		params_unsaved.set(param, !mark_saved);
+
+		param_flat_update(param);
+
+		if (s != nullptr) {
+			param_record_change(param);
+		}
 
 		param_found = true;
 	}
 
-	param_autosave();
+	if (!mark_saved) {
+		param_autosave();
+	}
 
 	param_unlock_writer();
 
@@ -965,6 +1311,19 @@ param_reset_all_internal(bool auto_save)
 	/* mark as reset / deleted */
 	param_values = nullptr;
 
+	/* the journal can't record a reset of all parameters, the next save rewrites the whole file */
+	param_journal_default.offset = -1;
+
+#if defined(PARAM_FLAT_STORAGE)
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		param_flat_update(param);
+	}
+
+#endif // PARAM_FLAT_STORAGE
+
+	param_record_change_all();
+
 	if (auto_save) {
 		param_autosave();
 	}
@@ -1091,9 +1450,192 @@ const char *param_get_backup_file()
 	return param_backup_file;
 }
 
-static int param_export_internal(int fd, param_filter_func filter);
+static int param_export_internal(int fd, param_filter_func filter, param_journal_s *journal = nullptr);
 static int param_verify(int fd);
 
+/**
+ * Encode a journal record: the record's CRC covers all preceding fields.
+ */
+static void
+param_journal_record_init(param_journal_record_s &record, uint8_t type, uint32_t epoch, const char *name, int32_t value)
+{
+	record.magic = PARAM_JOURNAL_MAGIC;
+	record.type = type;
+	record.epoch = epoch;
+
+	if (name != nullptr) {
+		memcpy(record.name, name, strnlen(name, sizeof(record.name)));
+	}
+
+	record.value = value;
+	record.crc = crc32part((const uint8_t *)&record, offsetof(param_journal_record_s, crc), 0);
+}
+
+static bool
+param_journal_record_valid(const param_journal_record_s &record)
+{
+	return (record.magic == PARAM_JOURNAL_MAGIC)
+	       && (record.crc == crc32part((const uint8_t *)&record, offsetof(param_journal_record_s, crc), 0));
+}
+
+/**
+ * Start a new journal after the BSON document just written to fd
+ * (the file position has to be at the end of the document).
+ */
+static int
+param_journal_start(int fd, param_journal_s *journal)
+{
+	const off_t document_end = lseek(fd, 0, SEEK_CUR);
+
+	if (document_end < 0) {
+		return -1;
+	}
+
+	// new (random) epoch, this invalidates any stale records from earlier saves following the document
+	const hrt_abstime now = hrt_absolute_time();
+	param_journal_epoch = crc32part((const uint8_t *)&now, sizeof(now), param_journal_epoch);
+
+	param_journal_record_s header{};
+	param_journal_record_init(header, PARAM_JOURNAL_HEADER, param_journal_epoch, nullptr, 0);
+
+	if (::write(fd, &header, sizeof(header)) != sizeof(header)) {
+		PX4_ERR("journal header write failed (%d)", errno);
+		return -1;
+	}
+
+	if (journal != nullptr) {
+		journal->offset = document_end + sizeof(header);
+		journal->epoch = param_journal_epoch;
+		journal->records = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * Append all unsaved parameters to the journal of the default file
+ * (caller is responsible for locking).
+ *
+ * @return 0 on success, -1 if the whole file needs to be rewritten
+ */
+static int
+param_journal_append(const char *filename)
+{
+	param_journal_s &journal = param_journal_default;
+
+	if ((journal.offset < 0) || (journal.records + (int)params_unsaved.count() > PARAM_JOURNAL_MAX_RECORDS)) {
+		// no valid journal or compaction due
+		return -1;
+	}
+
+	int fd = ::open(filename, O_WRONLY);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	int result = 0;
+
+	if (lseek(fd, journal.offset, SEEK_SET) != journal.offset) {
+		result = -1;
+	}
+
+	for (param_t param = 0; handle_in_range(param) && (result == 0); param++) {
+		if (!params_unsaved[param]) {
+			continue;
+		}
+
+		param_journal_record_s record{};
+
+		if (params_changed[param]) {
+			int32_t value = 0;
+			const void *v = param_get_value_ptr(param);
+
+			if (v != nullptr) {
+				memcpy(&value, v, sizeof(value));
+			}
+
+			param_journal_record_init(record, PARAM_JOURNAL_SET, journal.epoch, param_name(param), value);
+
+		} else {
+			param_journal_record_init(record, PARAM_JOURNAL_RESET, journal.epoch, param_name(param), 0);
+		}
+
+		if (::write(fd, &record, sizeof(record)) == sizeof(record)) {
+			journal.offset += sizeof(record);
+			journal.records++;
+
+		} else {
+			PX4_ERR("journal write failed (%d)", errno);
+			result = -1;
+		}
+	}
+
+	::close(fd);
+
+	if (result != 0) {
+		// unknown state, rewrite the whole file
+		journal.offset = -1;
+	}
+
+	return result;
+}
+
+/**
+ * Replay the journal following the BSON document (of size document_size) in fd.
+ */
+static void
+param_journal_replay(int fd, int32_t document_size, param_journal_s *journal)
+{
+	param_journal_record_s record{};
+
+	if ((lseek(fd, document_size, SEEK_SET) != document_size)
+	    || (::read(fd, &record, sizeof(record)) != sizeof(record))
+	    || !param_journal_record_valid(record) || (record.type != PARAM_JOURNAL_HEADER)) {
+		// no journal (e.g. written by an older version)
+		return;
+	}
+
+	const uint32_t epoch = record.epoch;
+	off_t offset = document_size + sizeof(record);
+	int records = 0;
+
+	// replay until the first invalid record (stale data from earlier saves or interrupted write)
+	while ((::read(fd, &record, sizeof(record)) == sizeof(record))
+	       && param_journal_record_valid(record) && (record.epoch == epoch) && (record.type != PARAM_JOURNAL_HEADER)) {
+
+		char name[sizeof(record.name) + 1] {};
+		memcpy(name, record.name, sizeof(record.name));
+
+		const param_t param = param_find_no_notification(name);
+
+		if (param != PARAM_INVALID) {
+			if (record.type == PARAM_JOURNAL_SET) {
+				param_set_internal(param, &record.value, true, true);
+
+			} else if (record.type == PARAM_JOURNAL_RESET) {
+				param_reset_internal(param, true, true);
+			}
+
+		} else {
+			PX4_WARN("journal: ignoring unrecognised parameter '%s'", name);
+		}
+
+		offset += sizeof(record);
+		records++;
+	}
+
+	PX4_INFO("journal: replayed %d records", records);
+
+	if (journal != nullptr) {
+		journal->offset = offset;
+		journal->epoch = epoch;
+		journal->records = records;
+	}
+
+	param_journal_epoch = epoch;
+}
+
 int param_save_default()
 {
 	PX4_DEBUG("param_save_default");
@@ -1109,21 +1651,36 @@ int param_save_default()
 	param_lock_reader();
 
 	int res = PX4_ERROR;
+	bool journal_appended = false;
 	const char *filename = param_get_default_file();
 
 	if (filename) {
+		// only append the changes if possible
+		perf_begin(param_export_perf);
+		journal_appended = (param_journal_append(filename) == PX4_OK);
+		perf_end(param_export_perf);
+
+		if (journal_appended) {
+			res = PX4_OK;
+		}
+
 		static constexpr int MAX_ATTEMPTS = 3;
 
-		for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
+		for (int attempt = 1; !journal_appended && (attempt <= MAX_ATTEMPTS); attempt++) {
 			// write parameters to file
 			int fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
 
 			if (fd > -1) {
+				param_journal_s journal{};
 				perf_begin(param_export_perf);
-				res = param_export_internal(fd, nullptr);
+				res = param_export_internal(fd, nullptr, &journal);
 				perf_end(param_export_perf);
 				::close(fd);
 
+				if (res == PX4_OK) {
+					param_journal_default = journal;
+				}
+
 				if (res == PX4_OK) {
 					// reopen file to verify
 					int fd_verify = ::open(filename, O_RDONLY, PX4_O_MODE_666);
@@ -1153,8 +1710,8 @@ int param_save_default()
 	} else {
 		params_unsaved.reset();
 
-		// backup file
-		if (param_backup_file) {
+		// backup file (full copy, not updated by journal appends)
+		if (param_backup_file && !journal_appended) {
 			int fd_backup_file = ::open(param_backup_file, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
 
 			if (fd_backup_file > -1) {
@@ -1209,9 +1766,15 @@ param_load_default()
 		return 1;
 	}
 
-	int result = param_load(fd_load);
+	param_reset_all_internal(false);
+	param_journal_s journal{};
+	int result = param_import_internal(fd_load, &journal);
 	::close(fd_load);
 
+	if (result == 0) {
+		param_journal_default = journal;
+	}
+
 	if (result != 0) {
 		PX4_ERR("error reading parameters from '%s'", filename);
 		return -2;
@@ -1348,6 +1911,11 @@ param_export(const char *filename, param_filter_func filter)
 	if (fd > -1) {
 		result = param_export_internal(fd, filter);
 
+		if (param_default_file && (strcmp(filename, param_default_file) == 0)) {
+			// document replaced, the next save rewrites the whole file
+			param_journal_default.offset = -1;
+		}
+
 	} else {
 		result = flash_param_save(filter);
 	}
@@ -1365,7 +1933,7 @@ param_export(const char *filename, param_filter_func filter)
 }
 
 // internal parameter export, caller is responsible for locking
-static int param_export_internal(int fd, param_filter_func filter)
+static int param_export_internal(int fd, param_filter_func filter, param_journal_s *journal)
 {
 	PX4_DEBUG("param_export_internal");
 
@@ -1462,6 +2030,10 @@ out:
 		}
 	}
 
+	if (result == 0) {
+		result = param_journal_start(fd, journal);
+	}
+
 	return result;
 }
 
@@ -1554,7 +2126,7 @@ param_dump_callback(bson_decoder_t decoder, bson_node_t node)
 }
 
 static int
-param_import_internal(int fd)
+param_import_internal(int fd, param_journal_s *journal = nullptr)
 {
 	static constexpr int MAX_ATTEMPTS = 3;
 
@@ -1575,6 +2147,8 @@ param_import_internal(int fd)
 						 decoder.total_document_size, decoder.total_decoded_size,
 						 decoder.count_node_int32, decoder.count_node_double);
 
+					param_journal_replay(fd, decoder.total_document_size, journal);
+
 					return 0;
 
 				} else {
@@ -1737,6 +2311,32 @@ void param_print_status()
 			 param_custom_default_values->n * sizeof(UT_icd));
 	}
 
+#if defined(PARAM_AIRFRAME_DEFAULTS)
+
+	if (param_airframe_table >= 0) {
+		int count = 0;
+		param_lock_reader();
+
+		for (param_t param = 0; param < param_info_count; param++) {
+			if (params_custom_default[param] && (param_find_custom_default(param) == nullptr)) {
+				count++;
+			}
+		}
+
+		param_unlock_reader();
+		PX4_INFO("airframe defaults (flash): %" PRId32 ", %d custom defaults", param_airframe_autostart, count);
+	}
+
+#endif // PARAM_AIRFRAME_DEFAULTS
+
+#if defined(PARAM_FLAT_STORAGE)
+	PX4_INFO("flat storage: %zu bytes", sizeof(param_values_flat));
+#endif // PARAM_FLAT_STORAGE
+
+	if (param_journal_default.offset >= 0) {
+		PX4_INFO("journal: %d/%d records", param_journal_default.records, PARAM_JOURNAL_MAX_RECORDS);
+	}
+
 	PX4_INFO("auto save: %s", autosave_disabled ? "off" : "on");
 
 	if (!autosave_disabled && (last_autosave_timestamp > 0)) {
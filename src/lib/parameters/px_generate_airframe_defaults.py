@@ -0,0 +1,261 @@
+#!/usr/bin/env python
+"""
+Generate the flash resident airframe default parameter tables
+(px4_airframe_defaults.hpp) from the 'param set-default' lines of the ROMFS
+airframe scripts.
+
+Every script (airframe or sourced defaults file like rc.mc_defaults) becomes
+one table sorted by parameter index. A script that sources another one before
+setting any default chains to the table of the sourced script instead of
+duplicating its values, otherwise the sourced values are merged in.
+
+The tables are only used to look up values already set with
+param_set_default_value(), so skipped lines (unknown parameters, values that
+are no plain numbers) just end up in RAM at runtime.
+"""
+from __future__ import print_function
+import xml.etree.ElementTree as ET
+import argparse
+import os
+import re
+import struct
+
+set_default_re = re.compile(r'^\s*param\s+set-default\s+(\w+)\s+(\S+)')
+source_re = re.compile(r'^\s*\.\s+\$\{R\}etc/(\S+)')
+int_re = re.compile(r'^[-+]?\d+$')
+float_re = re.compile(r'^[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?$')
+
+
+def parse_value(param_type, value):
+    """ @return: raw 32 bit value as set by 'param set-default', None if not representable """
+    if param_type == 'INT32':
+        if not int_re.match(value):
+            return None
+        v = int(value)
+        if v < -2**31 or v >= 2**31:
+            return None
+        return v
+
+    if param_type == 'FLOAT':
+        if not float_re.match(value):
+            return None
+        # same rounding as the param command: double -> float
+        try:
+            return struct.unpack('<i', struct.pack('<f', float(value)))[0]
+        except OverflowError:
+            return None
+
+    return None
+
+
+class Script(object):
+    def __init__(self, path):
+        self.path = path
+        self.values = {}  # name -> raw value
+        self.parent = None  # chained script (sourced before any default)
+
+
+class Generator(object):
+    def __init__(self, params, romfs_root, verbose=False):
+        self.params = params  # name -> type
+        self.romfs_root = romfs_root
+        self.verbose = verbose
+        self.scripts = {}  # path -> Script
+
+    def load(self, path, stack=()):
+        path = os.path.normpath(path)
+        if path in self.scripts:
+            return self.scripts[path]
+
+        if path in stack or not os.path.isfile(path):
+            return None
+
+        script = Script(path)
+        have_defaults = False
+
+        with open(path, 'r') as f:
+            for line in f:
+                line = line.split('#', 1)[0]
+
+                m = source_re.match(line)
+                if m:
+                    sourced = self.load(os.path.join(self.romfs_root, m.group(1)), stack + (path,))
+                    if sourced is None:
+                        continue
+                    if not have_defaults and script.parent is None:
+                        script.parent = sourced
+                    else:
+                        script.values.update(self.flatten(sourced))
+                    continue
+
+                m = set_default_re.match(line)
+                if m:
+                    name, value = m.group(1), m.group(2)
+                    if name not in self.params:
+                        continue
+                    v = parse_value(self.params[name], value)
+                    if v is None:
+                        if self.verbose:
+                            print('{}: skipping {} {}'.format(path, name, value))
+                        # a later lookup must not return an earlier value
+                        script.values.pop(name, None)
+                        continue
+                    script.values[name] = v
+                    have_defaults = True
+
+        self.scripts[path] = script
+        return script
+
+    def flatten(self, script):
+        values = {}
+        chain = []
+        while script is not None:
+            chain.append(script)
+            script = script.parent
+        for s in reversed(chain):
+            values.update(s.values)
+        return values
+
+
+def generate(xml_file, airframes_path, romfs_root, dest, verbose=False):
+    root = ET.parse(xml_file).getroot()
+    params = {}
+    for group in root:
+        if group.tag == "group" and "no_code_generation" not in group.attrib:
+            for param in group:
+                params[param.attrib["name"]] = param.attrib["type"]
+
+    generator = Generator(params, romfs_root, verbose)
+
+    airframes = {}  # autostart -> Script
+    airframe_files = sorted(os.listdir(airframes_path)) if os.path.isdir(airframes_path) else []
+    for file_name in airframe_files:
+        m = re.match(r'^(\d+)_', file_name)
+        if not m or file_name.endswith('.post') or file_name.endswith('.txt'):
+            continue
+        autostart = int(m.group(1))
+        if autostart == 0 or autostart in airframes:
+            continue
+        script = generator.load(os.path.join(airframes_path, file_name))
+        if script is not None and (script.values or script.parent is not None):
+            airframes[autostart] = script
+
+    # keep only the tables that can be reached from an airframe, parents first
+    tables = []
+    table_index = {}
+
+    def add_table(script):
+        if script.path in table_index:
+            return
+        if script.parent is not None:
+            add_table(script.parent)
+        table_index[script.path] = len(tables)
+        tables.append(script)
+
+    for autostart in sorted(airframes):
+        add_table(airframes[autostart])
+
+    names = []
+    values = []
+    table_entries = []
+    for script in tables:
+        offset = len(names)
+        for name in sorted(script.values):
+            names.append(name)
+            values.append(script.values[name])
+        parent = table_index[script.parent.path] if script.parent is not None else -1
+        table_entries.append((offset, len(script.values), parent, os.path.relpath(script.path, romfs_root)))
+
+    if len(names) > 65535 or len(tables) > 32767:
+        raise ValueError("too many airframe defaults")
+
+    out = []
+    out.append('#pragma once')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('#include <parameters/px4_parameters.hpp>')
+    out.append('')
+    out.append('// DO NOT EDIT')
+    out.append('// This file is autogenerated by px_generate_airframe_defaults.py from the ROMFS airframes')
+    out.append('')
+    out.append('namespace px4')
+    out.append('{')
+    out.append('namespace airframe_defaults')
+    out.append('{')
+    out.append('')
+    out.append('struct table_s {')
+    out.append('\tuint16_t offset;  ///< first entry in entry_param[]/entry_value[]')
+    out.append('\tuint16_t count;')
+    out.append('\tint16_t parent;   ///< table to search if the parameter is not in this one, -1 for none')
+    out.append('};')
+    out.append('')
+    out.append('struct airframe_s {')
+    out.append('\tint32_t autostart;')
+    out.append('\tint16_t table;')
+    out.append('};')
+    out.append('')
+    out.append('/// parameter of each entry, sorted by index within a table')
+    out.append('static constexpr params entry_param[] = {')
+    for script in tables:
+        out.append('\t// ' + os.path.relpath(script.path, romfs_root))
+        for name in sorted(script.values):
+            out.append('\tparams::' + name + ',')
+    if not names:
+        out.append('\tparams::SYS_AUTOSTART,')
+    out.append('};')
+    out.append('')
+    out.append('/// raw 32 bit value (int32 or float) of each entry')
+    out.append('static constexpr int32_t entry_value[] = {')
+    for script in tables:
+        out.append('\t// ' + os.path.relpath(script.path, romfs_root))
+        for name in sorted(script.values):
+            out.append('\t{}, // {}'.format(script.values[name], name))
+    if not names:
+        out.append('\t0,')
+    out.append('};')
+    out.append('')
+    out.append('static constexpr table_s tables[] = {')
+    for offset, count, parent, path in table_entries:
+        out.append('\t{{ {}, {}, {} }}, // {}'.format(offset, count, parent, path))
+    if not table_entries:
+        out.append('\t{ 0, 0, -1 },')
+    out.append('};')
+    out.append('')
+    out.append('/// sorted by autostart')
+    out.append('static constexpr airframe_s airframes[] = {')
+    for autostart in sorted(airframes):
+        out.append('\t{{ {}, {} }},'.format(autostart, table_index[airframes[autostart].path]))
+    if not airframes:
+        out.append('\t{ 0, -1 },')
+    out.append('};')
+    out.append('')
+    out.append('static constexpr int airframes_count = {};'.format(len(airframes)))
+    out.append('')
+    out.append('} // namespace airframe_defaults')
+    out.append('} // namespace px4')
+    out.append('')
+
+    if not os.path.isdir(dest):
+        os.makedirs(dest)
+
+    file_name = os.path.join(dest, 'px4_airframe_defaults.hpp')
+    content = '\n'.join(out)
+
+    with open(file_name, 'w') as f:
+        f.write(content)
+
+    if verbose:
+        print('{} airframes, {} tables, {} entries'.format(len(airframes), len(tables), len(names)))
+
+
+if __name__ == "__main__":
+    arg_parser = argparse.ArgumentParser()
+    arg_parser.add_argument("--xml", required=True, help="parameter xml file")
+    arg_parser.add_argument("--airframes-path", required=True, help="path to the airframe scripts")
+    arg_parser.add_argument("--romfs-root", required=True, help="ROMFS source directory (resolves ${R}etc/)")
+    arg_parser.add_argument("--dest", help="destination path", default=os.path.curdir)
+    arg_parser.add_argument('-v', '--verbose', action='store_true', help="verbose output")
+    args = arg_parser.parse_args()
+    generate(args.xml, args.airframes_path, args.romfs_root, args.dest, args.verbose)
+
+#  vim: set et fenc=utf-8 ff=unix sts=4 sw=4 ts=4 :
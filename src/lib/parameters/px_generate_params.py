@@ -19,6 +19,73 @@ except ImportError as e:
 
 import os
 
+def param_name_hash(name, seed):
+    """
+    FNV-1a hash of a parameter name, must match px4::param_name_hash() in
+    templates/px4_parameters.hpp.jinja.
+    """
+    h = seed if seed != 0 else 0x811c9dc5
+    for c in name.encode('ascii'):
+        h = ((h ^ c) * 0x01000193) & 0xffffffff
+    return h
+
+def generate_perfect_hash(names):
+    """
+    Generate a minimal perfect hash (hash and displace) over the parameter names.
+
+    Lookup: d = displacement[hash(name, 0) % n], the index is then -d - 1 if d < 0,
+    otherwise index[hash(name, d) % n].
+
+    @return: (displacement, index) tables of length n = len(names)
+    """
+    n = len(names)
+
+    if n == 0:
+        return [0], [0]
+
+    buckets = [[] for _ in range(n)]
+    for i, name in enumerate(names):
+        buckets[param_name_hash(name, 0) % n].append(i)
+
+    displacement = [0] * n
+    index = [None] * n
+
+    # place the largest buckets first, finding a seed that maps all their names to free slots
+    buckets_by_size = sorted(range(n), key=lambda b: len(buckets[b]), reverse=True)
+    b = 0
+    while b < n and len(buckets[buckets_by_size[b]]) > 1:
+        bucket = buckets[buckets_by_size[b]]
+        seed = 1
+        while True:
+            slots = [param_name_hash(names[i], seed) % n for i in bucket]
+            if len(set(slots)) == len(slots) and all(index[s] is None for s in slots):
+                break
+            seed += 1
+        for i, s in zip(bucket, slots):
+            index[s] = i
+        displacement[buckets_by_size[b]] = seed
+        b += 1
+
+    # single entry buckets directly reference the parameter index
+    while b < n and len(buckets[buckets_by_size[b]]) == 1:
+        displacement[buckets_by_size[b]] = -buckets[buckets_by_size[b]][0] - 1
+        b += 1
+
+    # unused slots
+    index = [i if i is not None else 0 for i in index]
+
+    if max(displacement) > 32767 or min(displacement) < -32768 or n > 32767:
+        raise ValueError("parameter hash displacement out of range")
+
+    # self check
+    for i, name in enumerate(names):
+        d = displacement[param_name_hash(name, 0) % n]
+        found = -d - 1 if d < 0 else index[param_name_hash(name, d) % n]
+        if found != i:
+            raise ValueError("parameter perfect hash failed for " + name)
+
+    return displacement, index
+
 def generate(xml_file, dest='.'):
     """
     Generate px4 param source from xml.
@@ -39,6 +106,8 @@ def generate(xml_file, dest='.'):
 
     params = sorted(params, key=lambda name: name.attrib["name"])
 
+    hash_displacement, hash_index = generate_perfect_hash([p.attrib["name"] for p in params])
+
     script_path = os.path.dirname(os.path.realpath(__file__))
 
     # for jinja docs see: http://jinja.pocoo.org/docs/2.9/api/
@@ -55,7 +124,8 @@ def generate(xml_file, dest='.'):
         template = env.get_template(template_file)
         with open(os.path.join(
                 dest, template_file.replace('.jinja','')), 'w') as fid:
-            fid.write(template.render(params=params))
+            fid.write(template.render(params=params,
+                hash_displacement=hash_displacement, hash_index=hash_index))
 
 if __name__ == "__main__":
     arg_parser = argparse.ArgumentParser()
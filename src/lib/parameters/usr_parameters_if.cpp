@@ -52,6 +52,17 @@ param_notify_changes()
 	boardctl(PARAMIOCNOTIFY, NULL);
 }
 
+uint32_t param_change_generation()
+{
+	return 0;
+}
+
+bool param_changed_since(param_t param, uint32_t generation)
+{
+	// not tracked in userspace: always do a full update
+	return true;
+}
+
 param_t param_find(const char *name)
 {
 	paramiocfind_t data = {name, true, PARAM_INVALID};
@@ -44,6 +44,8 @@
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include <pthread.h>
+#include <sched.h>
+#include <px4_platform_common/atomic.h>
 #include <systemlib/err.h>
 
 #include "perf_counter.h"
@@ -52,9 +54,10 @@
  * Header common to all counters.
  */
 struct perf_ctr_header {
-	sq_entry_t		link;	/**< list linkage */
+	perf_ctr_header		*next{nullptr};	/**< list linkage */
 	enum perf_counter_type	type;	/**< counter type */
 	const char		*name;	/**< counter name */
+	bool			shared{false};	/**< handed out by perf_alloc_once, can be updated from several threads */
 };
 
 /**
@@ -92,20 +95,70 @@ struct perf_ctr_interval : public perf_ctr_header {
 };
 
 /**
- * List of all known counters.
+ * List of all known counters. New counters are only ever added to the front.
  */
-static sq_queue_t	perf_counters = { nullptr, nullptr };
+static perf_ctr_header *perf_counters = nullptr;
 
 /**
- * mutex protecting access to the perf_counters linked list (which is read from & written to by different threads)
+ * mutex serializing the modifications of the perf_counters linked list (perf_alloc & perf_free).
+ *
+ * Readers (perf_iterate_all, perf_print_all, perf_reset_all) walk the list without it, so they never
+ * block an allocation. They register in perf_counters_readers instead, and perf_free waits for all
+ * readers to leave the list before the unlinked counter is deleted.
  */
 pthread_mutex_t perf_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
-// FIXME: the mutex does **not** protect against access to/from the perf
-// counter's data. It can still happen that a counter is updated while it is
-// printed. This can lead to inconsistent output, or completely bogus values
-// (especially the 64bit values which are in general not atomically updated).
-// The same holds for shared perf counters (perf_alloc_once), that can be updated
-// concurrently (this affects the 'ctrl_latency' counter).
+static px4::atomic<int> perf_counters_readers{0};
+// FIXME: neither protects against access to/from the perf counter's data. It can
+// still happen that a counter is updated while it is printed, which can lead to
+// inconsistent output. Event counts are read tear-free (see read_count()), and the
+// event count of shared perf counters (perf_alloc_once) is updated atomically, but
+// the samples of shared PC_ELAPSED/PC_INTERVAL counters can still be mixed up.
+
+static inline perf_ctr_header *list_first()
+{
+	return __atomic_load_n(&perf_counters, __ATOMIC_ACQUIRE);
+}
+
+static inline perf_ctr_header *list_next(const perf_ctr_header *ctr)
+{
+	return __atomic_load_n(&ctr->next, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Read a 64 bit count that might be updated concurrently, without getting a torn value on 32 bit targets.
+ */
+static inline uint64_t read_count(const uint64_t &count)
+{
+	const volatile uint64_t *c = &count;
+	uint64_t value = *c;
+
+	for (uint64_t check = *c; check != value; check = *c) {
+		value = check;
+	}
+
+	return value;
+}
+
+static inline void add_count(perf_ctr_header *ctr, uint64_t &count)
+{
+	if (!ctr->shared) {
+		count++;
+		return;
+	}
+
+#if defined(__PX4_NUTTX)
+
+	if (!__atomic_always_lock_free(sizeof(count), 0)) {
+		irqstate_t flags = enter_critical_section();
+		count++;
+		leave_critical_section(flags);
+		return;
+	}
+
+#endif // __PX4_NUTTX
+
+	__atomic_fetch_add(&count, 1, __ATOMIC_RELAXED);
+}
 
 
 perf_counter_t
@@ -134,7 +187,9 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr->type = type;
 		ctr->name = name;
 		pthread_mutex_lock(&perf_counters_mutex);
-		sq_addfirst(&ctr->link, &perf_counters);
+		ctr->next = perf_counters;
+		// publish only after the counter is complete, readers don't take the mutex
+		__atomic_store_n(&perf_counters, ctr, __ATOMIC_RELEASE);
 		pthread_mutex_unlock(&perf_counters_mutex);
 	}
 
@@ -145,12 +200,13 @@ perf_counter_t
 perf_alloc_once(enum perf_counter_type type, const char *name)
 {
 	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counter_t handle = perf_counters;
 
 	while (handle != nullptr) {
 		if (!strcmp(handle->name, name)) {
 			if (type == handle->type) {
 				/* they are the same counter */
+				handle->shared = true;
 				pthread_mutex_unlock(&perf_counters_mutex);
 				return handle;
 
@@ -161,13 +217,19 @@ perf_alloc_once(enum perf_counter_type type, const char *name)
 			}
 		}
 
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = handle->next;
 	}
 
 	pthread_mutex_unlock(&perf_counters_mutex);
 
 	/* if the execution reaches here, no existing counter of that name was found */
-	return perf_alloc(type, name);
+	handle = perf_alloc(type, name);
+
+	if (handle != nullptr) {
+		handle->shared = true;
+	}
+
+	return handle;
 }
 
 void
@@ -178,9 +240,24 @@ perf_free(perf_counter_t handle)
 	}
 
 	pthread_mutex_lock(&perf_counters_mutex);
-	sq_rem(&handle->link, &perf_counters);
+	perf_ctr_header **prev = &perf_counters;
+
+	while (*prev != nullptr && *prev != handle) {
+		prev = &(*prev)->next;
+	}
+
+	if (*prev != nullptr) {
+		// handle->next is left intact, a reader currently on handle continues with the rest of the list
+		__atomic_store_n(prev, handle->next, __ATOMIC_RELEASE);
+	}
+
 	pthread_mutex_unlock(&perf_counters_mutex);
 
+	// grace period: readers that started before the unlink might still access the counter
+	while (perf_counters_readers.load() > 0) {
+		sched_yield();
+	}
+
 	delete handle;
 }
 
@@ -193,7 +270,7 @@ perf_count(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_COUNT:
-		((struct perf_ctr_count *)handle)->event_count++;
+		add_count(handle, ((struct perf_ctr_count *)handle)->event_count);
 		break;
 
 	case PC_INTERVAL:
@@ -256,7 +333,7 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
 			if (elapsed >= 0) {
-				pce->event_count++;
+				add_count(handle, pce->event_count);
 				pce->time_total += elapsed;
 
 				if ((pce->time_least > (uint32_t)elapsed) || (pce->time_least == 0)) {
@@ -329,7 +406,7 @@ perf_count_interval(perf_counter_t handle, hrt_abstime now)
 			}
 
 			pci->time_last = now;
-			pci->event_count++;
+			add_count(handle, pci->event_count);
 			break;
 		}
 
@@ -534,16 +611,16 @@ perf_event_count(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_COUNT:
-		return ((struct perf_ctr_count *)handle)->event_count;
+		return read_count(((struct perf_ctr_count *)handle)->event_count);
 
 	case PC_ELAPSED: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			return pce->event_count;
+			return read_count(pce->event_count);
 		}
 
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			return pci->event_count;
+			return read_count(pci->event_count);
 		}
 
 	default:
@@ -581,29 +658,29 @@ perf_mean(perf_counter_t handle)
 void
 perf_iterate_all(perf_callback cb, void *user)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counters_readers.fetch_add(1);
+	perf_counter_t handle = list_first();
 
 	while (handle != nullptr) {
 		cb(handle, user);
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = list_next(handle);
 	}
 
-	pthread_mutex_unlock(&perf_counters_mutex);
+	perf_counters_readers.fetch_sub(1);
 }
 
 void
 perf_print_all(int fd)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counters_readers.fetch_add(1);
+	perf_counter_t handle = list_first();
 
 	while (handle != nullptr) {
 		perf_print_counter_fd(fd, handle);
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = list_next(handle);
 	}
 
-	pthread_mutex_unlock(&perf_counters_mutex);
+	perf_counters_readers.fetch_sub(1);
 }
 
 void
@@ -625,15 +702,15 @@ perf_print_latency(int fd)
 void
 perf_reset_all(void)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counters_readers.fetch_add(1);
+	perf_counter_t handle = list_first();
 
 	while (handle != nullptr) {
 		perf_reset(handle);
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = list_next(handle);
 	}
 
-	pthread_mutex_unlock(&perf_counters_mutex);
+	perf_counters_readers.fetch_sub(1);
 
 	reset_latency_counters();
 }
@@ -27,3 +27,12 @@ extern rc_decode_buf_t rc_decode_buf;
 
 uint8_t crc8_dvb_s2(uint8_t crc, uint8_t a);
 uint8_t crc8_dvb_s2_buf(uint8_t *buf, int len);
+
+/**
+ * Unpack the 11 bit channel values used by SBUS and CRSF (LSB first, little endian).
+ * Reads (count * 11 + 7) / 8 bytes of data.
+ * @param data packed channel data
+ * @param values raw channel values output
+ * @param count number of channels
+ */
+void rc_unpack_11bit_channels(const uint8_t *data, uint16_t *values, unsigned count);
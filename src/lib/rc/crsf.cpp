@@ -301,37 +301,11 @@ static bool crsf_parse_buffer(uint16_t *values, uint16_t *num_values, uint16_t m
 				(crsf_payload_RC_channels_packed_t *)&crsf_frame.payload;
 			*num_values = MIN(max_channels, 16);
 
-			if (max_channels > 0) { values[0] = convert_channel_value(rc_channels->chan0); }
+			rc_unpack_11bit_channels((const uint8_t *)rc_channels, values, *num_values);
 
-			if (max_channels > 1) { values[1] = convert_channel_value(rc_channels->chan1); }
-
-			if (max_channels > 2) { values[2] = convert_channel_value(rc_channels->chan2); }
-
-			if (max_channels > 3) { values[3] = convert_channel_value(rc_channels->chan3); }
-
-			if (max_channels > 4) { values[4] = convert_channel_value(rc_channels->chan4); }
-
-			if (max_channels > 5) { values[5] = convert_channel_value(rc_channels->chan5); }
-
-			if (max_channels > 6) { values[6] = convert_channel_value(rc_channels->chan6); }
-
-			if (max_channels > 7) { values[7] = convert_channel_value(rc_channels->chan7); }
-
-			if (max_channels > 8) { values[8] = convert_channel_value(rc_channels->chan8); }
-
-			if (max_channels > 9) { values[9] = convert_channel_value(rc_channels->chan9); }
-
-			if (max_channels > 10) { values[10] = convert_channel_value(rc_channels->chan10); }
-
-			if (max_channels > 11) { values[11] = convert_channel_value(rc_channels->chan11); }
-
-			if (max_channels > 12) { values[12] = convert_channel_value(rc_channels->chan12); }
-
-			if (max_channels > 13) { values[13] = convert_channel_value(rc_channels->chan13); }
-
-			if (max_channels > 14) { values[14] = convert_channel_value(rc_channels->chan14); }
-
-			if (max_channels > 15) { values[15] = convert_channel_value(rc_channels->chan15); }
+			for (unsigned i = 0; i < *num_values; i++) {
+				values[i] = convert_channel_value(values[i]);
+			}
 
 			CRSF_VERBOSE("Got Channels");
 
@@ -528,42 +528,6 @@ sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 	return decode_ret;
 }
 
-/*
- * S.bus decoder matrix.
- *
- * Each channel value can come from up to 3 input bytes. Each row in the
- * matrix describes up to three bytes, and each entry gives:
- *
- * - byte offset in the data portion of the frame
- * - right shift applied to the data byte
- * - mask for the data byte
- * - left shift applied to the result into the channel value
- */
-struct sbus_bit_pick {
-	uint8_t byte;
-	uint8_t rshift;
-	uint8_t mask;
-	uint8_t lshift;
-};
-static const struct sbus_bit_pick sbus_decoder[SBUS_INPUT_CHANNELS][3] = {
-	/*  0 */ { { 0, 0, 0xff, 0}, { 1, 0, 0x07, 8}, { 0, 0, 0x00,  0} },
-	/*  1 */ { { 1, 3, 0x1f, 0}, { 2, 0, 0x3f, 5}, { 0, 0, 0x00,  0} },
-	/*  2 */ { { 2, 6, 0x03, 0}, { 3, 0, 0xff, 2}, { 4, 0, 0x01, 10} },
-	/*  3 */ { { 4, 1, 0x7f, 0}, { 5, 0, 0x0f, 7}, { 0, 0, 0x00,  0} },
-	/*  4 */ { { 5, 4, 0x0f, 0}, { 6, 0, 0x7f, 4}, { 0, 0, 0x00,  0} },
-	/*  5 */ { { 6, 7, 0x01, 0}, { 7, 0, 0xff, 1}, { 8, 0, 0x03,  9} },
-	/*  6 */ { { 8, 2, 0x3f, 0}, { 9, 0, 0x1f, 6}, { 0, 0, 0x00,  0} },
-	/*  7 */ { { 9, 5, 0x07, 0}, {10, 0, 0xff, 3}, { 0, 0, 0x00,  0} },
-	/*  8 */ { {11, 0, 0xff, 0}, {12, 0, 0x07, 8}, { 0, 0, 0x00,  0} },
-	/*  9 */ { {12, 3, 0x1f, 0}, {13, 0, 0x3f, 5}, { 0, 0, 0x00,  0} },
-	/* 10 */ { {13, 6, 0x03, 0}, {14, 0, 0xff, 2}, {15, 0, 0x01, 10} },
-	/* 11 */ { {15, 1, 0x7f, 0}, {16, 0, 0x0f, 7}, { 0, 0, 0x00,  0} },
-	/* 12 */ { {16, 4, 0x0f, 0}, {17, 0, 0x7f, 4}, { 0, 0, 0x00,  0} },
-	/* 13 */ { {17, 7, 0x01, 0}, {18, 0, 0xff, 1}, {19, 0, 0x03,  9} },
-	/* 14 */ { {19, 2, 0x3f, 0}, {20, 0, 0x1f, 6}, { 0, 0, 0x00,  0} },
-	/* 15 */ { {20, 5, 0x07, 0}, {21, 0, 0xff, 3}, { 0, 0, 0x00,  0} }
-};
-
 bool
 sbus_decode(uint64_t frame_time, uint8_t *frame, uint16_t *values, uint16_t *num_values,
 	    bool *sbus_failsafe, bool *sbus_frame_drop, uint16_t max_values)
@@ -624,26 +588,12 @@ sbus_decode(uint64_t frame_time, uint8_t *frame, uint16_t *values, uint16_t *num
 	unsigned chancount = (max_values > SBUS_INPUT_CHANNELS) ?
 			     SBUS_INPUT_CHANNELS : max_values;
 
-	/* use the decoder matrix to extract channel data */
-	for (unsigned channel = 0; channel < chancount; channel++) {
-		unsigned value = 0;
-
-		for (unsigned pick = 0; pick < 3; pick++) {
-			const struct sbus_bit_pick *decode = &sbus_decoder[channel][pick];
-
-			if (decode->mask != 0) {
-				unsigned piece = frame[1 + decode->byte];
-				piece >>= decode->rshift;
-				piece &= decode->mask;
-				piece <<= decode->lshift;
-
-				value |= piece;
-			}
-		}
-
+	/* extract the 11 bit channel data */
+	rc_unpack_11bit_channels(&frame[1], values, chancount);
 
+	for (unsigned channel = 0; channel < chancount; channel++) {
 		/* convert 0-2048 values to 1000-2000 ppm encoding in a not too sloppy fashion */
-		values[channel] = (uint16_t)(value * SBUS_SCALE_FACTOR + .5f) + SBUS_SCALE_OFFSET;
+		values[channel] = (uint16_t)(values[channel] * SBUS_SCALE_FACTOR + .5f) + SBUS_SCALE_OFFSET;
 	}
 
 	/* decode switch channels if data fields are wide enough */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SelectedImuStatus.hpp
+ *
+ * Subscription to the vehicle_imu_status instance of the accelerometer or gyroscope
+ * currently selected by the sensors module (sensor_selection).
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/sensor_selection.h>
+#include <uORB/topics/vehicle_imu_status.h>
+
+namespace sensor_selection
+{
+
+using namespace time_literals;
+
+class SelectedImuStatus
+{
+public:
+	enum class Sensor {
+		Accel,
+		Gyro,
+	};
+
+	explicit SelectedImuStatus(Sensor sensor) : _sensor(sensor) {}
+
+	/**
+	 * Follow the sensor selection and copy the status of the selected IMU if it was updated.
+	 * @return true if a new status of the selected IMU was copied
+	 */
+	bool update(vehicle_imu_status_s *imu_status)
+	{
+		if (_sensor_selection_sub.updated()) {
+			sensor_selection_s sensor_selection;
+
+			if (_sensor_selection_sub.copy(&sensor_selection)) {
+				const uint32_t device_id = (_sensor == Sensor::Accel) ? sensor_selection.accel_device_id :
+							   sensor_selection.gyro_device_id;
+
+				if (device_id != _device_id) {
+					_device_id = device_id;
+					_found = false;
+					_time_last_search = 0;
+				}
+			}
+		}
+
+		if (!_found && (_device_id != 0) && (hrt_elapsed_time(&_time_last_search) > 1_s)) {
+			// the IMU status is usually published shortly after the selection, retry at a low rate until then
+			_found = findInstance();
+			_time_last_search = hrt_absolute_time();
+		}
+
+		return _found && _vehicle_imu_status_sub.update(imu_status) && (sensorDeviceId(*imu_status) == _device_id);
+	}
+
+	uint32_t selectedDeviceId() const { return _device_id; }
+
+private:
+	uint32_t sensorDeviceId(const vehicle_imu_status_s &imu_status) const
+	{
+		return (_sensor == Sensor::Accel) ? imu_status.accel_device_id : imu_status.gyro_device_id;
+	}
+
+	bool findInstance()
+	{
+		for (uint8_t instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+			uORB::Subscription imu_status_sub{ORB_ID(vehicle_imu_status), instance};
+			vehicle_imu_status_s imu_status;
+
+			if (imu_status_sub.copy(&imu_status) && (sensorDeviceId(imu_status) == _device_id)) {
+				_vehicle_imu_status_sub.ChangeInstance(instance);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	uORB::Subscription _sensor_selection_sub{ORB_ID(sensor_selection)};
+	uORB::Subscription _vehicle_imu_status_sub{ORB_ID(vehicle_imu_status)};
+
+	hrt_abstime _time_last_search{0};
+	uint32_t _device_id{0};
+	bool _found{false};
+
+	const Sensor _sensor;
+};
+
+} // namespace sensor_selection
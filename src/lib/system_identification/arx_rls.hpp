@@ -49,8 +49,13 @@
  * y  output of the system
  * e  white noise input
  *
+ * The covariance matrix is kept in its UD factorized form (P = U*D*U', U unit upper triangular,
+ * D diagonal) and updated using Bierman's algorithm, which guarantees a symmetric positive
+ * definite covariance and costs O(n^2) operations per sample.
+ *
  * References:
  * - Identification de systemes dynamiques, D.Bonvin and A.Karimi, epfl, 2011
+ * - Factorization Methods for Discrete Sequential Estimation, G.J.Bierman, 1977
  *
  * @author Mathieu Bresciani <mathieu@auterion.com>
  */
@@ -80,18 +85,28 @@ public:
 	 * [a_1 .. a_n b_0 .. b_m]'
 	 */
 	const matrix::Vector < float, N + M + 1 > &getCoefficients() const { return _theta_hat; }
-	const matrix::Vector < float, N + M + 1 > getVariances() const { return _P.diag(); }
+	const matrix::Vector < float, N + M + 1 > getVariances() const
+	{
+		// diag(U*D*U')
+		matrix::Vector < float, N + M + 1 > variances;
+
+		for (size_t i = 0; i < (N + M + 1); i++) {
+			variances(i) = _D(i);
+
+			for (size_t j = i + 1; j < (N + M + 1); j++) {
+				variances(i) += _U(i, j) * _U(i, j) * _D(j);
+			}
+		}
+
+		return variances;
+	}
 	float getInnovation() const { return _innovation; }
 	const matrix::Vector < float, N + M + 1 > &getDiffEstimate() const { return _diff_theta_hat; }
 
 	void reset(const matrix::Vector < float, N + M + 1 > &theta_init = {})
 	{
-		/* _P.uncorrelateCovarianceSetVariance<N + M + 1>(0, 10e3f); // does not work */
-		_P.setZero();
-
-		for (size_t i = 0; i < (N + M + 1); i++) {
-			_P(i, i) = 10e3f;
-		}
+		_U.setIdentity();
+		_D.setAll(10e3f);
 
 		_diff_theta_hat.setZero();
 
@@ -122,17 +137,49 @@ public:
 		}
 
 		const matrix::Vector < float, N + M + 1 > phi = constructDesignVector();
-		const matrix::Matrix < float, 1, N + M + 1 > phi_t = phi.transpose();
 
-		_P = (_P - _P * phi * phi_t * _P / (_lambda + (phi_t * _P * phi)(0, 0))) / _lambda;
-		_innovation = _y[N] - (phi_t * _theta_hat)(0, 0);
-		_theta_hat = _theta_hat + _P * phi * _innovation;
+		_innovation = _y[N] - phi.dot(_theta_hat);
 
-		for (size_t i = 0; i < N + M + 1; i++) {
-			_diff_theta_hat(i) = fabsf(_theta_hat(i) - theta_prev(i));
+		// Bierman UD measurement update with the forgetting factor used as measurement variance:
+		// P = (P - P*phi*phi'*P / (lambda + phi'*P*phi)) / lambda
+		// f = U'*phi, v = D*f
+		float f[N + M + 1];
+		float v[N + M + 1];
+
+		for (size_t j = 0; j < (N + M + 1); j++) {
+			f[j] = phi(j);
+
+			for (size_t i = 0; i < j; i++) {
+				f[j] += _U(i, j) * phi(i);
+			}
+
+			v[j] = _D(j) * f[j];
 		}
 
-		/* fixCovarianceErrors(); // TODO: this could help against ill-conditioned matrix but needs more testing*/
+		// b accumulates the unnormalized gain P*phi
+		float b[N + M + 1];
+		float alpha = _lambda;
+
+		for (size_t j = 0; j < (N + M + 1); j++) {
+			const float alpha_prev = alpha;
+			alpha += f[j] * v[j];
+			_D(j) *= alpha_prev / (alpha * _lambda);
+
+			const float p = -f[j] / alpha_prev;
+
+			for (size_t i = 0; i < j; i++) {
+				const float u_prev = _U(i, j);
+				_U(i, j) = u_prev + b[i] * p;
+				b[i] += u_prev * v[j];
+			}
+
+			b[j] = v[j];
+		}
+
+		for (size_t i = 0; i < (N + M + 1); i++) {
+			_theta_hat(i) += b[i] / alpha * _innovation;
+			_diff_theta_hat(i) = fabsf(_theta_hat(i) - theta_prev(i));
+		}
 	}
 
 private:
@@ -178,26 +225,8 @@ private:
 		return phi;
 	}
 
-	void fixCovarianceErrors()
-	{
-		float max_var = 0.f;
-
-		for (size_t i = 0; i < (N + M + 1); i++) {
-			if (_P(i, i) > max_var) {
-				max_var = _P(i, i);
-			}
-		}
-
-		const float min_var_allowed = max_var * 0.1f;
-
-		for (size_t i = 0; i < (N + M + 1); i++) {
-			if (_P(i, i) < min_var_allowed) {
-				_P(i, i) = min_var_allowed;
-			}
-		}
-	}
-
-	matrix::SquareMatrix < float, N + M + 1 > _P;
+	matrix::SquareMatrix < float, N + M + 1 > _U; ///< unit upper triangular factor of the covariance
+	matrix::Vector < float, N + M + 1 > _D; ///< diagonal factor of the covariance
 	matrix::Vector < float, N + M + 1 > _theta_hat;
 	matrix::Vector < float, N + M + 1 > _diff_theta_hat;
 	float _innovation{};
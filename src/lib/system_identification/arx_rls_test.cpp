@@ -115,3 +115,39 @@ TEST_F(ArxRlsTest, resetTest)
 	// THEN: the result should be exactly the same
 	EXPECT_TRUE((coefficients - _rls.getCoefficients()).abs().max() < 1e-8f);
 }
+
+TEST_F(ArxRlsTest, convergenceTest)
+{
+	// GIVEN: a known second order system excited by a pseudo-random input
+	ArxRls<2, 2, 1> _rls;
+	_rls.setForgettingFactor(0.999f);
+	const float a1 = -1.6f;
+	const float a2 = 0.7f;
+	const float b0 = 0.1f;
+	const float b1 = 0.2f;
+	const float b2 = -0.05f;
+
+	float u[4] {};
+	float y[3] {};
+	uint32_t seed = 1;
+
+	for (int k = 0; k < 2000; k++) {
+		seed = seed * 1103515245u + 12345u;
+		u[3] = u[2];
+		u[2] = u[1];
+		u[1] = u[0];
+		u[0] = ((seed >> 16) & 0x7fff) / 16384.f - 1.f;
+		y[2] = y[1];
+		y[1] = y[0];
+		y[0] = -a1 * y[1] - a2 * y[2] + b0 * u[1] + b1 * u[2] + b2 * u[3];
+
+		_rls.update(u[0], y[0]);
+	}
+
+	// THEN: the coefficients are identified and the covariance stays positive
+	float data_check[] = {a1, a2, b0, b1, b2};
+	const Vector<float, 5> coefficients_check(data_check);
+	EXPECT_TRUE((_rls.getCoefficients() - coefficients_check).abs().max() < 1e-3f);
+	EXPECT_TRUE(_rls.getVariances().min() > 0.f);
+	EXPECT_TRUE(_rls.getVariances().max() < 1.f);
+}
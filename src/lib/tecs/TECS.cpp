@@ -144,6 +144,8 @@ void TECS::_update_speed_states(float equivalent_airspeed_setpoint, float equiva
 		_tas_state = new_tas_state;
 	}
 
+	_tas_state_inv = 1.f / math::max(_tas_state, FLT_EPSILON);
+
 	_speed_update_timestamp = now;
 
 }
@@ -168,8 +170,8 @@ void TECS::_update_speed_setpoint()
 
 	// Calculate limits for the demanded rate of change of speed based on physical performance limits
 	// with a 50% margin to allow the total energy controller to correct for errors.
-	const float max_tas_rate_sp = 0.5f * _STE_rate_max / math::max(_tas_state, FLT_EPSILON);
-	const float min_tas_rate_sp = 0.5f * _STE_rate_min / math::max(_tas_state, FLT_EPSILON);
+	const float max_tas_rate_sp = 0.5f * _STE_rate_max * _tas_state_inv;
+	const float min_tas_rate_sp = 0.5f * _STE_rate_min * _tas_state_inv;
 
 	_TAS_setpoint_adj = constrain(_TAS_setpoint, _TAS_min, _TAS_max);
 
@@ -286,19 +288,16 @@ void TECS::_update_throttle_setpoint()
 
 	if (_STE_rate_setpoint >= 0) {
 		// throttle is between trim and maximum
-		throttle_predicted = _throttle_trim + _STE_rate_setpoint / _STE_rate_max * (_throttle_setpoint_max - _throttle_trim);
+		throttle_predicted = _throttle_trim + _STE_rate_setpoint * _STE_rate_max_inv * (_throttle_setpoint_max - _throttle_trim);
 
 	} else {
 		// throttle is between trim and minimum
-		throttle_predicted = _throttle_trim + _STE_rate_setpoint / _STE_rate_min * (_throttle_setpoint_min - _throttle_trim);
+		throttle_predicted = _throttle_trim + _STE_rate_setpoint * _STE_rate_min_inv * (_throttle_setpoint_min - _throttle_trim);
 
 	}
 
-	// Calculate gain scaler from specific energy rate error to throttle
-	const float STE_rate_to_throttle = 1.0f / (_STE_rate_max - _STE_rate_min);
-
 	// Add proportional and derivative control feedback to the predicted throttle and constrain to throttle limits
-	float throttle_setpoint = (_STE_rate_error * _throttle_damping_gain) * STE_rate_to_throttle + throttle_predicted;
+	float throttle_setpoint = (_STE_rate_error * _throttle_damping_gain) * _STE_rate_to_throttle + throttle_predicted;
 	throttle_setpoint = constrain(throttle_setpoint, _throttle_setpoint_min, _throttle_setpoint_max);
 
 	// Integral handling
@@ -309,7 +308,7 @@ void TECS::_update_throttle_setpoint()
 
 			// underspeed conditions zero out integration
 			float throttle_integ_input = (_STE_rate_error * _integrator_gain_throttle) * _dt *
-						     STE_rate_to_throttle * (1.0f - _percent_undersped);
+						     _STE_rate_to_throttle * (1.0f - _percent_undersped);
 
 			// only allow integrator propagation into direction which unsaturates throttle
 			if (_throttle_integ_state > integ_state_max) {
@@ -444,13 +443,13 @@ void TECS::_update_pitch_setpoint()
 	// a) The climb angle follows pitch angle with a lag that is small enough not to destabilise the control loop.
 	// b) The offset between climb angle and pitch angle (angle of attack) is constant, excluding the effect of
 	// pitch transients due to control action or turbulence.
-	_pitch_setpoint_unc = SEB_rate_correction / climb_angle_to_SEB_rate;
+	_pitch_setpoint_unc = SEB_rate_correction * _tas_state_inv * (1.f / CONSTANTS_ONE_G);
 
 	float pitch_setpoint = constrain(_pitch_setpoint_unc, _pitch_setpoint_min, _pitch_setpoint_max);
 
 	// Comply with the specified vertical acceleration limit by applying a pitch rate limit
-	// NOTE: at zero airspeed, the pitch increment is unbounded
-	const float pitch_increment = _dt * _vert_accel_limit / _tas_state;
+	// NOTE: at zero airspeed, the pitch increment is practically unbounded
+	const float pitch_increment = _dt * _vert_accel_limit * _tas_state_inv;
 	_last_pitch_setpoint = constrain(pitch_setpoint, _last_pitch_setpoint - pitch_increment,
 					 _last_pitch_setpoint + pitch_increment);
 }
@@ -542,12 +541,8 @@ void TECS::_initialize_states(float pitch, float throttle_trim, float baro_altit
 		_uncommanded_descent_recovery = false;
 	}
 
-	// filter specific energy rate error using first order filter with 0.5 second time constant
-	_STE_rate_error_filter.setParameters(DT_DEFAULT, _STE_rate_time_const);
+	// the filter coefficients are set with the parameter dependent limits
 	_STE_rate_error_filter.reset(0.0f);
-
-	// filter true airspeed rate using first order filter with 0.5 second time constant
-	_TAS_rate_filter.setParameters(DT_DEFAULT, _speed_derivative_time_const);
 	_TAS_rate_filter.reset(0.0f);
 
 	_states_initialized = true;
@@ -560,6 +555,22 @@ void TECS::_update_STE_rate_lim()
 
 	// Calculate the specific total energy lower rate limits from the min throttle sink rate
 	_STE_rate_min = - math::max(_min_sink_rate, FLT_EPSILON) * CONSTANTS_ONE_G;
+
+	_STE_rate_max_inv = 1.f / _STE_rate_max;
+	_STE_rate_min_inv = 1.f / _STE_rate_min;
+
+	// Calculate gain scaler from specific energy rate error to throttle
+	_STE_rate_to_throttle = 1.0f / (_STE_rate_max - _STE_rate_min);
+
+	_updateTrajectoryGenerationConstraints();
+
+	// filter specific energy rate error using first order filter with 0.5 second time constant
+	_STE_rate_error_filter.setParameters(DT_DEFAULT, _STE_rate_time_const);
+
+	// filter true airspeed rate using first order filter with 0.5 second time constant
+	_TAS_rate_filter.setParameters(DT_DEFAULT, _speed_derivative_time_const);
+
+	_limits_dirty = false;
 }
 
 void TECS::update_pitch_throttle(float pitch, float baro_altitude, float hgt_setpoint,
@@ -580,17 +591,17 @@ void TECS::update_pitch_throttle(float pitch, float baro_altitude, float hgt_set
 	_climbout_mode_active = climb_out_setpoint;
 	_throttle_trim = throttle_trim;
 
+	// Calculate rate limits for specific total energy, only when their parameters changed
+	if (_limits_dirty) {
+		_update_STE_rate_lim();
+	}
+
 	// Initialize selected states and variables as required
 	_initialize_states(pitch, throttle_trim, baro_altitude, pitch_min_climbout, eas_to_tas);
 
-	_updateTrajectoryGenerationConstraints();
-
 	// Update the true airspeed state estimate
 	_update_speed_states(EAS_setpoint, equivalent_airspeed, eas_to_tas);
 
-	// Calculate rate limits for specific total energy
-	_update_STE_rate_lim();
-
 	// Detect an underspeed condition
 	_detect_underspeed();
 
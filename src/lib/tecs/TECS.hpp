@@ -128,9 +128,9 @@ public:
 	void set_integrator_gain_throttle(float gain) { _integrator_gain_throttle = gain; }
 	void set_integrator_gain_pitch(float gain) { _integrator_gain_pitch = gain; }
 
-	void set_min_sink_rate(float rate) { _min_sink_rate = rate; }
-	void set_max_sink_rate(float sink_rate) { _max_sink_rate = sink_rate; }
-	void set_max_climb_rate(float climb_rate) { _max_climb_rate = climb_rate; }
+	void set_min_sink_rate(float rate) { _min_sink_rate = rate; _limits_dirty = true; }
+	void set_max_sink_rate(float sink_rate) { _max_sink_rate = sink_rate; _limits_dirty = true; }
+	void set_max_climb_rate(float climb_rate) { _max_climb_rate = climb_rate; _limits_dirty = true; }
 
 	void set_heightrate_ff(float heightrate_ff) { _height_setpoint_gain_ff = heightrate_ff; }
 	void set_height_error_time_constant(float time_const) { _height_error_gain = 1.0f / math::max(time_const, 0.1f); }
@@ -140,7 +140,7 @@ public:
 	void set_equivalent_airspeed_trim(float airspeed) { _equivalent_airspeed_trim = airspeed; }
 
 	void set_pitch_damping(float damping) { _pitch_damping_gain = damping; }
-	void set_vertical_accel_limit(float limit) { _vert_accel_limit = limit; }
+	void set_vertical_accel_limit(float limit) { _vert_accel_limit = limit; _limits_dirty = true; }
 
 	void set_speed_comp_filter_omega(float omega) { _tas_estimate_freq = omega; }
 	void set_speed_weight(float weight) { _pitch_speed_weight = weight; }
@@ -152,8 +152,8 @@ public:
 	void set_roll_throttle_compensation(float compensation) { _load_factor_correction = compensation; }
 	void set_load_factor(float load_factor) { _load_factor = load_factor; }
 
-	void set_ste_rate_time_const(float time_const) { _STE_rate_time_const = time_const; }
-	void set_speed_derivative_time_constant(float time_const) { _speed_derivative_time_const = time_const; }
+	void set_ste_rate_time_const(float time_const) { _STE_rate_time_const = time_const; _limits_dirty = true; }
+	void set_speed_derivative_time_constant(float time_const) { _speed_derivative_time_const = time_const; _limits_dirty = true; }
 
 	void set_seb_rate_ff_gain(float ff_gain) { _SEB_rate_ff = ff_gain; }
 
@@ -289,6 +289,10 @@ private:
 	float _pitch_setpoint_unc{0.0f};				///< pitch demand before limiting (rad)
 	float _STE_rate_max{FLT_EPSILON};				///< specific total energy rate upper limit achieved when throttle is at _throttle_setpoint_max (m**2/sec**3)
 	float _STE_rate_min{-FLT_EPSILON};				///< specific total energy rate lower limit acheived when throttle is at _throttle_setpoint_min (m**2/sec**3)
+	float _STE_rate_max_inv{1.f / FLT_EPSILON};			///< 1 / _STE_rate_max
+	float _STE_rate_min_inv{-1.f / FLT_EPSILON};			///< 1 / _STE_rate_min
+	float _STE_rate_to_throttle{0.5f / FLT_EPSILON};		///< gain scaler from specific energy rate error to throttle
+	float _tas_state_inv{1.f / FLT_EPSILON};			///< 1 / _tas_state, updated with the speed states
 	float _throttle_setpoint_max{0.0f};				///< normalised throttle upper limit
 	float _throttle_setpoint_min{0.0f};				///< normalised throttle lower limit
 	float _throttle_trim{0.0f};					///< throttle required to fly level at _EAS_setpoint, compensated for air density and vehicle weight
@@ -327,6 +331,7 @@ private:
 	bool _climbout_mode_active{false};				///< true when in climbout mode
 	bool _airspeed_enabled{false};					///< true when airspeed use has been enabled
 	bool _states_initialized{false};				///< true when TECS states have been iniitalized
+	bool _limits_dirty{true};					///< true when parameters of the cached limits and filters changed
 
 	/**
 	 * Update the airspeed internal state using a second order complementary filter
@@ -381,7 +386,8 @@ private:
 				float eas_to_tas);
 
 	/**
-	 * Calculate specific total energy rate limits
+	 * Calculate specific total energy rate limits, the trajectory constraints and the filter
+	 * coefficients, which only depend on parameters
 	 */
 	void _update_STE_rate_lim();
 
@@ -0,0 +1,275 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "VoxelMap.hpp"
+
+#include <mathlib/mathlib.h>
+
+#include <float.h>
+#include <math.h>
+
+using matrix::Vector3f;
+
+void VoxelMap::setResolution(float resolution)
+{
+	_resolution = math::max(resolution, 0.05f);
+	clear();
+}
+
+void VoxelMap::clear()
+{
+	for (Voxel &voxel : _voxels) {
+		voxel = {};
+	}
+}
+
+bool VoxelMap::toKey(const Vector3f &position, Key &key) const
+{
+	const Vector3f index = position / _resolution;
+
+	for (int i = 0; i < 3; i++) {
+		if (!PX4_ISFINITE(index(i)) || fabsf(index(i)) > static_cast<float>(INT16_MAX - 1)) {
+			return false;
+		}
+	}
+
+	key.x = static_cast<int16_t>(floorf(index(0)));
+	key.y = static_cast<int16_t>(floorf(index(1)));
+	key.z = static_cast<int16_t>(floorf(index(2)));
+	return true;
+}
+
+uint32_t VoxelMap::hash(const Key &key)
+{
+	// spatial hash with large primes (Teschner et al.)
+	return (static_cast<uint32_t>(key.x) * 73856093u) ^ (static_cast<uint32_t>(key.y) * 19349663u)
+	       ^ (static_cast<uint32_t>(key.z) * 83492791u);
+}
+
+const VoxelMap::Voxel *VoxelMap::find(const Key &key) const
+{
+	uint32_t slot = hash(key);
+
+	for (int probe = 0; probe < MAX_PROBES; probe++) {
+		const Voxel &voxel = _voxels[slot & (CAPACITY - 1)];
+
+		if (voxel.occupancy == 0) {
+			// end of the probe sequence
+			return nullptr;
+		}
+
+		if (voxel.key == key) {
+			return &voxel;
+		}
+
+		slot++;
+	}
+
+	return nullptr;
+}
+
+void VoxelMap::hit(const Key &key, uint32_t now_ms)
+{
+	uint32_t slot = hash(key);
+	Voxel *free_slot = nullptr;
+
+	for (int probe = 0; probe < MAX_PROBES; probe++) {
+		Voxel &voxel = _voxels[slot & (CAPACITY - 1)];
+
+		if (voxel.occupancy != 0 && voxel.key == key) {
+			voxel.occupancy = isExpired(voxel, now_ms) ? OCCUPANCY_HIT : math::min<int8_t>(voxel.occupancy + OCCUPANCY_HIT,
+					  OCCUPANCY_MAX);
+			voxel.last_hit_ms = now_ms;
+			return;
+		}
+
+		if (voxel.occupancy == 0) {
+			// key is not in the map, prefer reusing an expired slot earlier in the sequence
+			if (free_slot == nullptr) {
+				free_slot = &voxel;
+			}
+
+			break;
+		}
+
+		if (free_slot == nullptr && (isExpired(voxel, now_ms) || voxel.occupancy < OCCUPANCY_THRESHOLD)) {
+			free_slot = &voxel;
+		}
+
+		slot++;
+	}
+
+	// the map is full around this key if no slot was found, drop the measurement
+	if (free_slot != nullptr) {
+		free_slot->key = key;
+		free_slot->occupancy = OCCUPANCY_HIT;
+		free_slot->last_hit_ms = now_ms;
+	}
+}
+
+void VoxelMap::miss(const Key &key)
+{
+	Voxel *voxel = find(key);
+
+	if (voxel != nullptr) {
+		// keep the slot in use (>= 1) to not break the probe sequence of other keys
+		voxel->occupancy = math::max<int8_t>(voxel->occupancy - 1, 1);
+	}
+}
+
+template<typename Visitor>
+void VoxelMap::traverse(const Vector3f &origin, const Vector3f &direction, float max_distance, Visitor visit) const
+{
+	Key key;
+
+	if (!toKey(origin, key) || !(max_distance > 0.f)) {
+		return;
+	}
+
+	int16_t *index[3] {&key.x, &key.y, &key.z};
+	int step[3];
+	float t_max[3];  // distance along the ray to the next voxel boundary per axis
+	float t_delta[3]; // distance along the ray between voxel boundaries per axis
+
+	for (int i = 0; i < 3; i++) {
+		if (fabsf(direction(i)) > FLT_EPSILON) {
+			step[i] = direction(i) > 0.f ? 1 : -1;
+			const float boundary = (*index[i] + (step[i] > 0 ? 1 : 0)) * _resolution;
+			t_max[i] = (boundary - origin(i)) / direction(i);
+			t_delta[i] = _resolution / fabsf(direction(i));
+
+		} else {
+			step[i] = 0;
+			t_max[i] = INFINITY;
+			t_delta[i] = INFINITY;
+		}
+	}
+
+	float t = 0.f;
+
+	while (t <= max_distance) {
+		if (!visit(key, t)) {
+			return;
+		}
+
+		int axis = 0;
+
+		if (t_max[1] < t_max[axis]) { axis = 1; }
+
+		if (t_max[2] < t_max[axis]) { axis = 2; }
+
+		if (!PX4_ISFINITE(t_max[axis])
+		    || (step[axis] > 0 && *index[axis] >= INT16_MAX - 1)
+		    || (step[axis] < 0 && *index[axis] <= INT16_MIN + 1)) {
+			return;
+		}
+
+		t = t_max[axis];
+		t_max[axis] += t_delta[axis];
+		*index[axis] += step[axis];
+	}
+}
+
+void VoxelMap::insertRay(const Vector3f &origin, const Vector3f &direction, float distance, float max_distance,
+			 hrt_abstime now)
+{
+	if (!PX4_ISFINITE(distance) || distance < 0.f) {
+		return;
+	}
+
+	const uint32_t now_ms = static_cast<uint32_t>(now / 1000);
+	const bool obstacle = distance < max_distance;
+	const float clear_distance = math::min(distance, max_distance);
+
+	Key end_key{};
+	const bool end_valid = obstacle && toKey(origin + direction * distance, end_key);
+
+	// clear the free space in front of the measurement
+	traverse(origin, direction, clear_distance, [&](const Key & key, float) {
+		if (end_valid && key == end_key) {
+			return false;
+		}
+
+		miss(key);
+		return true;
+	});
+
+	if (end_valid) {
+		hit(end_key, now_ms);
+	}
+}
+
+float VoxelMap::raycast(const Vector3f &origin, const Vector3f &direction, float max_distance, hrt_abstime now) const
+{
+	const uint32_t now_ms = static_cast<uint32_t>(now / 1000);
+	float distance = INFINITY;
+
+	traverse(origin, direction, max_distance, [&](const Key & key, float t) {
+		const Voxel *voxel = find(key);
+
+		if (voxel != nullptr && isOccupied(*voxel, now_ms)) {
+			distance = t;
+			return false;
+		}
+
+		return true;
+	});
+
+	return distance;
+}
+
+bool VoxelMap::isOccupied(const Vector3f &position, hrt_abstime now) const
+{
+	Key key;
+
+	if (!toKey(position, key)) {
+		return false;
+	}
+
+	const Voxel *voxel = find(key);
+	return (voxel != nullptr) && isOccupied(*voxel, static_cast<uint32_t>(now / 1000));
+}
+
+int VoxelMap::occupiedCount(hrt_abstime now) const
+{
+	const uint32_t now_ms = static_cast<uint32_t>(now / 1000);
+	int count = 0;
+
+	for (const Voxel &voxel : _voxels) {
+		if (isOccupied(voxel, now_ms)) {
+			count++;
+		}
+	}
+
+	return count;
+}
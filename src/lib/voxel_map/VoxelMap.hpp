@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file VoxelMap.hpp
+ *
+ * Memory bounded sparse 3D occupancy map. Occupied voxels are stored in a fixed
+ * size open addressing hash table and expire after a decay time if they are not
+ * observed again. Range measurements are integrated as rays: the end point is
+ * marked occupied, the traversed voxels are cleared.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <matrix/math.hpp>
+
+#include <stdint.h>
+
+class VoxelMap
+{
+public:
+#if defined(CONSTRAINED_MEMORY)
+	static constexpr int CAPACITY = 256;
+#else
+	static constexpr int CAPACITY = 2048;
+#endif // CONSTRAINED_MEMORY
+
+	VoxelMap() = default;
+	~VoxelMap() = default;
+
+	/**
+	 * Set the edge length of a voxel, clears the map
+	 * @param resolution in meters
+	 */
+	void setResolution(float resolution);
+	float getResolution() const { return _resolution; }
+
+	/**
+	 * @param decay_time time after which an occupied voxel that was not observed again is dropped
+	 */
+	void setDecayTime(hrt_abstime decay_time) { _decay_time_ms = static_cast<uint32_t>(decay_time / 1000); }
+
+	void clear();
+
+	/**
+	 * Integrate a range measurement
+	 * @param origin sensor position in local frame [m]
+	 * @param direction unit vector of the measurement direction in local frame
+	 * @param distance measured distance [m]
+	 * @param max_distance maximum sensor range [m], readings at or beyond it only clear the map
+	 * @param now timestamp of the measurement
+	 */
+	void insertRay(const matrix::Vector3f &origin, const matrix::Vector3f &direction, float distance, float max_distance,
+		       hrt_abstime now);
+
+	/**
+	 * Find the first occupied voxel along a ray
+	 * @param origin ray origin in local frame [m]
+	 * @param direction unit vector of the ray direction in local frame
+	 * @param max_distance length of the ray [m]
+	 * @param now current time, used to ignore expired voxels
+	 * @return distance to the boundary of the first occupied voxel, INFINITY if the ray is free
+	 */
+	float raycast(const matrix::Vector3f &origin, const matrix::Vector3f &direction, float max_distance,
+		      hrt_abstime now) const;
+
+	bool isOccupied(const matrix::Vector3f &position, hrt_abstime now) const;
+
+	/**
+	 * @return number of occupied, not expired voxels
+	 */
+	int occupiedCount(hrt_abstime now) const;
+
+private:
+	struct Key {
+		int16_t x;
+		int16_t y;
+		int16_t z;
+
+		bool operator==(const Key &other) const { return x == other.x && y == other.y && z == other.z; }
+	};
+
+	struct Voxel {
+		Key key;
+		int8_t occupancy;     ///< hit counter, 0 marks a slot that was never used, used slots stay >= 1
+		uint32_t last_hit_ms; ///< time of the last hit
+	};
+
+	static constexpr int MAX_PROBES = 16;
+	static constexpr int8_t OCCUPANCY_HIT = 2;
+	static constexpr int8_t OCCUPANCY_MAX = 8;
+	static constexpr int8_t OCCUPANCY_THRESHOLD = 2;
+
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+	bool toKey(const matrix::Vector3f &position, Key &key) const;
+	static uint32_t hash(const Key &key);
+
+	bool isExpired(const Voxel &voxel, uint32_t now_ms) const { return (now_ms - voxel.last_hit_ms) > _decay_time_ms; }
+	bool isOccupied(const Voxel &voxel, uint32_t now_ms) const
+	{
+		return (voxel.occupancy >= OCCUPANCY_THRESHOLD) && !isExpired(voxel, now_ms);
+	}
+
+	const Voxel *find(const Key &key) const;
+	Voxel *find(const Key &key) { return const_cast<Voxel *>(static_cast<const VoxelMap *>(this)->find(key)); }
+
+	void hit(const Key &key, uint32_t now_ms);
+	void miss(const Key &key);
+
+	/**
+	 * Walk the voxels along a ray (3D digital differential analyzer)
+	 * @param visit called with (key, distance at voxel entry), returns false to stop
+	 */
+	template<typename Visitor>
+	void traverse(const matrix::Vector3f &origin, const matrix::Vector3f &direction, float max_distance,
+		      Visitor visit) const;
+
+	Voxel _voxels[CAPACITY] {};
+
+	float _resolution{0.2f};
+	uint32_t _decay_time_ms{5000};
+};
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <px4_platform_common/defines.h>
+#include <VoxelMap.hpp>
+
+using namespace matrix;
+using namespace time_literals;
+
+class VoxelMapTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_map.setResolution(0.5f);
+		_map.setDecayTime(2_s);
+	}
+
+	VoxelMap _map;
+	static constexpr hrt_abstime now = 100_s;
+};
+
+TEST_F(VoxelMapTest, EmptyMap)
+{
+	EXPECT_EQ(_map.occupiedCount(now), 0);
+	EXPECT_FALSE(PX4_ISFINITE(_map.raycast(Vector3f(), Vector3f(1.f, 0.f, 0.f), 10.f, now)));
+}
+
+TEST_F(VoxelMapTest, RangeMeasurementIsFound)
+{
+	// GIVEN: an obstacle 4 m in front of a sensor at (1, 1, -2)
+	const Vector3f origin(1.f, 1.f, -2.f);
+	const Vector3f forward(1.f, 0.f, 0.f);
+	_map.insertRay(origin, forward, 4.f, 10.f, now);
+
+	// THEN: it is occupied and a ray along the measurement hits it within one voxel
+	EXPECT_TRUE(_map.isOccupied(origin + forward * 4.f, now));
+	EXPECT_EQ(_map.occupiedCount(now), 1);
+	const float distance = _map.raycast(origin, forward, 10.f, now);
+	EXPECT_NEAR(distance, 4.f, _map.getResolution());
+	EXPECT_LE(distance, 4.f);
+
+	// AND: a ray from a different position and direction hits it as well
+	const Vector3f diagonal = Vector3f(1.f, 1.f, 0.f).normalized();
+	const Vector3f obstacle = origin + forward * 4.f;
+	const float distance_diagonal = _map.raycast(obstacle - diagonal * 3.f, diagonal, 10.f, now);
+	EXPECT_NEAR(distance_diagonal, 3.f, _map.getResolution() * 2.f);
+
+	// AND: rays shorter than the distance or in other directions are free
+	EXPECT_FALSE(PX4_ISFINITE(_map.raycast(origin, forward, 3.f, now)));
+	EXPECT_FALSE(PX4_ISFINITE(_map.raycast(origin, Vector3f(0.f, 0.f, -1.f), 10.f, now)));
+}
+
+TEST_F(VoxelMapTest, OutOfRangeClears)
+{
+	// GIVEN: an obstacle
+	const Vector3f forward(0.f, 1.f, 0.f);
+	_map.insertRay(Vector3f(), forward, 3.f, 10.f, now);
+	ASSERT_TRUE(PX4_ISFINITE(_map.raycast(Vector3f(), forward, 10.f, now)));
+
+	// WHEN: the sensor reports no obstacle in that direction (repeatedly)
+	for (int i = 0; i < 4; i++) {
+		_map.insertRay(Vector3f(), forward, 10.f, 10.f, now);
+	}
+
+	// THEN: the obstacle is cleared
+	EXPECT_FALSE(PX4_ISFINITE(_map.raycast(Vector3f(), forward, 10.f, now)));
+}
+
+TEST_F(VoxelMapTest, Decay)
+{
+	const Vector3f down(0.f, 0.f, 1.f);
+	_map.insertRay(Vector3f(), down, 2.f, 10.f, now);
+	EXPECT_TRUE(PX4_ISFINITE(_map.raycast(Vector3f(), down, 10.f, now + 1_s)));
+
+	// obstacles that are not observed again expire
+	EXPECT_FALSE(PX4_ISFINITE(_map.raycast(Vector3f(), down, 10.f, now + 3_s)));
+	EXPECT_EQ(_map.occupiedCount(now + 3_s), 0);
+}
+
+TEST_F(VoxelMapTest, MemoryBounded)
+{
+	// WHEN: inserting more obstacles than the map can hold
+	int inserted = 0;
+
+	for (int x = 0; x < 100; x++) {
+		for (int y = 0; y < 100; y++) {
+			_map.insertRay(Vector3f(x * 0.5f + 0.25f, y * 0.5f + 0.25f, -10.f), Vector3f(0.f, 0.f, 1.f), 10.f, 20.f, now);
+			inserted++;
+		}
+	}
+
+	// THEN: the map is at most at capacity and still answers queries
+	ASSERT_GT(inserted, static_cast<int>(VoxelMap::CAPACITY));
+	EXPECT_LE(_map.occupiedCount(now), static_cast<int>(VoxelMap::CAPACITY));
+	EXPECT_GT(_map.occupiedCount(now), static_cast<int>(VoxelMap::CAPACITY) / 2);
+
+	// AND: once the old data expired new obstacles can be stored again
+	const hrt_abstime later = now + 10_s;
+	EXPECT_EQ(_map.occupiedCount(later), 0);
+	_map.insertRay(Vector3f(0.25f, 0.25f, 0.25f), Vector3f(1.f, 0.f, 0.f), 5.f, 20.f, later);
+	EXPECT_EQ(_map.occupiedCount(later), 1);
+}
@@ -59,12 +59,29 @@ public:
 	WindEstimator(WindEstimator &&) = delete;
 	WindEstimator &operator=(WindEstimator &&) = delete;
 
+	/**
+	 * Vehicle velocity and attitude used by the fusion. It is computed once per cycle
+	 * and shared by all the estimator instances (one per airspeed sensor and sideslip only).
+	 */
+	struct VehicleState {
+		VehicleState() = default;
+		VehicleState(const matrix::Vector3f &vel, float vel_hor_variance, const matrix::Quatf &q) :
+			velI(vel),
+			hor_vel_variance(vel_hor_variance),
+			R_body_to_earth(q)
+		{}
+
+		float heading() const { return atan2f(R_body_to_earth(1, 0), R_body_to_earth(0, 0)); }
+
+		matrix::Vector3f velI{};
+		float hor_vel_variance{0.f};
+		matrix::Dcmf R_body_to_earth{};
+	};
+
 	void update(uint64_t time_now);
 
-	void fuse_airspeed(uint64_t time_now, float true_airspeed, const matrix::Vector3f &velI,
-			   const float hor_vel_variance, const matrix::Quatf &q_att);
-	void fuse_beta(uint64_t time_now, const matrix::Vector3f &velI, const float hor_vel_variance,
-		       const matrix::Quatf &q_att);
+	void fuse_airspeed(uint64_t time_now, float true_airspeed, const VehicleState &vehicle);
+	void fuse_beta(uint64_t time_now, const VehicleState &vehicle);
 
 	bool is_estimate_valid() { return _initialised; }
 
@@ -66,7 +66,15 @@ static constexpr unsigned get_lookup_table_index(float *val, float min, float ma
 	return static_cast<unsigned>((-(min) + *val) / SAMPLING_RES);
 }
 
-static constexpr float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+// grid cell of a position and its bilinear interpolation weights, shared by all tables
+struct TableCell {
+	unsigned lat_index;
+	unsigned lon_index;
+	float lat_scale;
+	float lon_scale;
+};
+
+static TableCell get_table_cell(float lat, float lon)
 {
 	lat = math::constrain(lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 
@@ -82,23 +90,46 @@ static constexpr float get_table_data(float lat, float lon, const int16_t table[
 	float min_lat = floorf(lat / SAMPLING_RES) * SAMPLING_RES;
 	float min_lon = floorf(lon / SAMPLING_RES) * SAMPLING_RES;
 
+	TableCell cell{};
+
 	/* find index of nearest low sampling point */
-	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
-	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+	cell.lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
+	cell.lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+
+	cell.lat_scale = constrain((lat - min_lat) / SAMPLING_RES, 0.f, 1.f);
+	cell.lon_scale = constrain((lon - min_lon) / SAMPLING_RES, 0.f, 1.f);
+
+	return cell;
+}
 
-	const float data_sw = table[min_lat_index][min_lon_index];
-	const float data_se = table[min_lat_index][min_lon_index + 1];
-	const float data_ne = table[min_lat_index + 1][min_lon_index + 1];
-	const float data_nw = table[min_lat_index + 1][min_lon_index];
+static float get_table_data(const TableCell &cell, const int16_t table[LAT_DIM][LON_DIM])
+{
+	const float data_sw = table[cell.lat_index][cell.lon_index];
+	const float data_se = table[cell.lat_index][cell.lon_index + 1];
+	const float data_ne = table[cell.lat_index + 1][cell.lon_index + 1];
+	const float data_nw = table[cell.lat_index + 1][cell.lon_index];
 
 	/* perform bilinear interpolation on the four grid corners */
-	const float lat_scale = constrain((lat - min_lat) / SAMPLING_RES, 0.f, 1.f);
-	const float lon_scale = constrain((lon - min_lon) / SAMPLING_RES, 0.f, 1.f);
+	const float data_min = cell.lon_scale * (data_se - data_sw) + data_sw;
+	const float data_max = cell.lon_scale * (data_ne - data_nw) + data_nw;
 
-	const float data_min = lon_scale * (data_se - data_sw) + data_sw;
-	const float data_max = lon_scale * (data_ne - data_nw) + data_nw;
+	return cell.lat_scale * (data_max - data_min) + data_min;
+}
+
+static float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+{
+	return get_table_data(get_table_cell(lat, lon), table);
+}
+
+MagField get_mag_field(float lat, float lon)
+{
+	const TableCell cell = get_table_cell(lat, lon);
 
-	return lat_scale * (data_max - data_min) + data_min;
+	MagField field;
+	field.declination = get_table_data(cell, declination_table) * 1e-4f;
+	field.inclination = get_table_data(cell, inclination_table) * 1e-4f;
+	field.strength = get_table_data(cell, strength_table) * 1e-4f;
+	return field;
 }
 
 float get_mag_declination_radians(float lat, float lon)
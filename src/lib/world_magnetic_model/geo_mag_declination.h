@@ -52,3 +52,12 @@ float get_mag_inclination_radians(float lat, float lon);
 // return magnetic field strength in Gauss or Tesla
 float get_mag_strength_gauss(float lat, float lon);
 float get_mag_strength_tesla(float lat, float lon);
+
+struct MagField {
+	float declination; // radians
+	float inclination; // radians
+	float strength;    // Gauss
+};
+
+// return declination, inclination and strength with a single table lookup
+MagField get_mag_field(float lat, float lon);
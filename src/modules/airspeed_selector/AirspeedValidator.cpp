@@ -53,12 +53,18 @@ AirspeedValidator::update_airspeed_validator(const airspeed_validator_update_dat
 	update_CAS_scale_validated(input_data.lpos_valid, input_data.ground_velocity, input_data.airspeed_true_raw);
 	update_CAS_scale_applied();
 	update_CAS_TAS(input_data.air_pressure_pa, input_data.air_temperature_celsius);
+
+	if (permanently_invalid()) {
+		// only keep the reported airspeeds up to date
+		return;
+	}
+
 	update_wind_estimator(input_data.timestamp, input_data.airspeed_true_raw, input_data.lpos_valid,
-			      input_data.ground_velocity, input_data.lpos_evh, input_data.lpos_evv, input_data.att_q);
+			      input_data.wind_estimator_vehicle_state);
 	update_in_fixed_wing_flight(input_data.in_fixed_wing_flight);
 	check_airspeed_data_stuck(input_data.timestamp);
 	check_airspeed_data_variation(input_data.timestamp);
-	check_load_factor(input_data.accel_z);
+	check_load_factor(input_data.load_factor);
 	check_airspeed_innovation(input_data.timestamp, input_data.vel_test_ratio, input_data.mag_test_ratio,
 				  input_data.ground_velocity);
 	update_airspeed_valid_status(input_data.timestamp);
@@ -73,20 +79,16 @@ AirspeedValidator::reset_airspeed_to_invalid(const uint64_t timestamp)
 
 void
 AirspeedValidator::update_wind_estimator(const uint64_t time_now_usec, float airspeed_true_raw, bool lpos_valid,
-		const matrix::Vector3f &vI, float lpos_evh, float lpos_evv, const float att_q[4])
+		const WindEstimator::VehicleState &vehicle_state)
 {
 	_wind_estimator.update(time_now_usec);
 
 	if (lpos_valid && _in_fixed_wing_flight) {
-
-		Quatf q(att_q);
-
 		// airspeed fusion (with raw TAS)
-		const float hor_vel_variance =  lpos_evh * lpos_evh;
-		_wind_estimator.fuse_airspeed(time_now_usec, airspeed_true_raw, vI, hor_vel_variance, q);
+		_wind_estimator.fuse_airspeed(time_now_usec, airspeed_true_raw, vehicle_state);
 
 		// sideslip fusion
-		_wind_estimator.fuse_beta(time_now_usec, vI, hor_vel_variance, q);
+		_wind_estimator.fuse_beta(time_now_usec, vehicle_state);
 	}
 }
 
@@ -295,7 +297,7 @@ AirspeedValidator::check_airspeed_innovation(uint64_t time_now, float estimator_
 
 
 void
-AirspeedValidator::check_load_factor(float accel_z)
+AirspeedValidator::check_load_factor(float load_factor)
 {
 	// Check if the airspeed reading is lower than physically possible given the load factor
 
@@ -309,7 +311,7 @@ AirspeedValidator::check_load_factor(float accel_z)
 
 		float max_lift_ratio = fmaxf(_CAS, 0.7f) / fmaxf(_airspeed_stall, 1.0f);
 		max_lift_ratio *= max_lift_ratio;
-		_load_factor_ratio = 0.95f * _load_factor_ratio + 0.05f * (fabsf(accel_z) / 9.81f) / max_lift_ratio;
+		_load_factor_ratio = 0.95f * _load_factor_ratio + 0.05f * load_factor / max_lift_ratio;
 		_load_factor_ratio = math::constrain(_load_factor_ratio, 0.25f, 2.0f);
 		_load_factor_check_failed = (_load_factor_ratio > 1.1f);
 
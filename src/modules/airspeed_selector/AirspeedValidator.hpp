@@ -57,12 +57,10 @@ struct airspeed_validator_update_data {
 	uint64_t airspeed_timestamp;
 	matrix::Vector3f ground_velocity;
 	bool lpos_valid;
-	float lpos_evh;
-	float lpos_evv;
-	float att_q[4];
+	WindEstimator::VehicleState wind_estimator_vehicle_state; ///< common to all the validators of a cycle
 	float air_pressure_pa;
 	float air_temperature_celsius;
-	float accel_z;
+	float load_factor; ///< measured load factor (|accel_z| / g), common to all the validators of a cycle
 	float vel_test_ratio;
 	float mag_test_ratio;
 	bool in_fixed_wing_flight;
@@ -78,6 +76,12 @@ public:
 
 	void reset_airspeed_to_invalid(const uint64_t timestamp);
 
+	/**
+	 * @return true if the airspeed is invalid and can not be declared valid again (re-enabling disabled),
+	 * the wind estimator and checks of such an instance are not run anymore
+	 */
+	bool permanently_invalid() const { return !_airspeed_valid && (_checks_clear_delay <= 0); }
+
 	float get_IAS() { return _IAS; }
 	float get_CAS() { return _CAS; }
 	float get_TAS() { return _TAS; }
@@ -187,8 +191,7 @@ private:
 	void update_in_fixed_wing_flight(bool in_fixed_wing_flight) { _in_fixed_wing_flight = in_fixed_wing_flight; }
 
 	void update_wind_estimator(const uint64_t timestamp, float airspeed_true_raw, bool lpos_valid,
-				   const matrix::Vector3f &vI,
-				   float lpos_evh, float lpos_evv, const float att_q[4]);
+				   const WindEstimator::VehicleState &vehicle_state);
 	void update_CAS_scale_validated(bool lpos_valid, const matrix::Vector3f &vI, float airspeed_true_raw);
 	void update_CAS_scale_applied();
 	void update_CAS_TAS(float air_pressure_pa, float air_temperature_celsius);
@@ -196,7 +199,7 @@ private:
 	void check_airspeed_data_variation(uint64_t timestamp);
 	void check_airspeed_innovation(uint64_t timestamp, float estimator_status_vel_test_ratio,
 				       float estimator_status_mag_test_ratio, const matrix::Vector3f &vI);
-	void check_load_factor(float accel_z);
+	void check_load_factor(float load_factor);
 	void update_airspeed_valid_status(const uint64_t timestamp);
 	void reset();
 	void reset_CAS_scale_check();
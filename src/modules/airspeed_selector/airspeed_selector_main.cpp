@@ -194,7 +194,7 @@ private:
 	void 		check_for_connected_airspeed_sensors(); /**< check for airspeed sensors (airspeed topics) and get _number_of_airspeed_sensors */
 	void		update_params(); /**< update parameters */
 	void 		poll_topics(); /**< poll all topics required beside airspeed (e.g. current temperature) */
-	void 		update_wind_estimator_sideslip(); /**< update the wind estimator instance only fusing sideslip */
+	void 		update_wind_estimator_sideslip(const WindEstimator::VehicleState &vehicle_state); /**< update the wind estimator instance only fusing sideslip */
 	void		update_ground_minus_wind_airspeed(); /**< update airspeed estimate based on groundspeed minus windspeed */
 	void 		select_airspeed_and_publish(); /**< select airspeed sensor (or groundspeed-windspeed) */
 
@@ -330,7 +330,13 @@ AirspeedModule::Run()
 	}
 
 	poll_topics();
-	update_wind_estimator_sideslip();
+
+	// velocity and attitude used by all the wind estimator instances
+	const WindEstimator::VehicleState wind_estimator_vehicle_state(
+		Vector3f(_vehicle_local_position.vx, _vehicle_local_position.vy, _vehicle_local_position.vz),
+		_vehicle_local_position.evh * _vehicle_local_position.evh, Quatf(_vehicle_attitude.q));
+
+	update_wind_estimator_sideslip(wind_estimator_vehicle_state);
 	update_ground_minus_wind_airspeed();
 
 	if (_number_of_airspeed_sensors > 0) {
@@ -349,14 +355,9 @@ AirspeedModule::Run()
 		input_data.timestamp = _time_now_usec;
 		input_data.ground_velocity = vI;
 		input_data.lpos_valid = _vehicle_local_position_valid;
-		input_data.lpos_evh = _vehicle_local_position.evh;
-		input_data.lpos_evv = _vehicle_local_position.evv;
-		input_data.att_q[0] = _vehicle_attitude.q[0];
-		input_data.att_q[1] = _vehicle_attitude.q[1];
-		input_data.att_q[2] = _vehicle_attitude.q[2];
-		input_data.att_q[3] = _vehicle_attitude.q[3];
+		input_data.wind_estimator_vehicle_state = wind_estimator_vehicle_state;
 		input_data.air_pressure_pa = _vehicle_air_data.baro_pressure_pa;
-		input_data.accel_z = _accel.xyz[2];
+		input_data.load_factor = fabsf(_accel.xyz[2]) / 9.81f;
 		input_data.vel_test_ratio = _estimator_status.vel_test_ratio;
 		input_data.mag_test_ratio = _estimator_status.mag_test_ratio;
 
@@ -515,7 +516,7 @@ void AirspeedModule::poll_topics()
 					&& !_vehicle_local_position.dead_reckoning;
 }
 
-void AirspeedModule::update_wind_estimator_sideslip()
+void AirspeedModule::update_wind_estimator_sideslip(const WindEstimator::VehicleState &vehicle_state)
 {
 	// update wind and airspeed estimator
 	_wind_estimator_sideslip.update(_time_now_usec);
@@ -523,12 +524,7 @@ void AirspeedModule::update_wind_estimator_sideslip()
 	if (_vehicle_local_position_valid
 	    && _vtol_vehicle_status.vehicle_vtol_state == vtol_vehicle_status_s::VEHICLE_VTOL_STATE_FW &&
 	    _vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) {
-		Vector3f vI(_vehicle_local_position.vx, _vehicle_local_position.vy, _vehicle_local_position.vz);
-		Quatf q(_vehicle_attitude.q);
-
-		const float hor_vel_variance =  _vehicle_local_position.evh * _vehicle_local_position.evh;
-
-		_wind_estimator_sideslip.fuse_beta(_time_now_usec, vI, hor_vel_variance, q);
+		_wind_estimator_sideslip.fuse_beta(_time_now_usec, vehicle_state);
 	}
 
 	_wind_estimate_sideslip.timestamp = _time_now_usec;
@@ -47,7 +47,9 @@ CameraFeedback::CameraFeedback() :
 bool
 CameraFeedback::init()
 {
-	if (!_trigger_sub.registerCallback()) {
+	if (!_trigger_sub.registerCallback()
+	    || !_gpos_sub.registerCallback()
+	    || !_att_sub.registerCallback()) {
 		PX4_ERR("callback registration failed");
 		return false;
 	}
@@ -57,31 +59,145 @@ CameraFeedback::init()
 	return true;
 }
 
+void
+CameraFeedback::update_pose_history()
+{
+	vehicle_global_position_s gpos;
+
+	if (_gpos_sub.update(&gpos)) {
+		if (gpos.lat_lon_reset_counter != _lat_lon_reset_counter || gpos.alt_reset_counter != _alt_reset_counter) {
+			// don't interpolate across an estimator reset
+			_position_history.reset();
+			_lat_lon_reset_counter = gpos.lat_lon_reset_counter;
+			_alt_reset_counter = gpos.alt_reset_counter;
+		}
+
+		PositionSample sample;
+		sample.time_us = gpos.timestamp_sample;
+		sample.lat = gpos.lat;
+		sample.lon = gpos.lon;
+		sample.alt = gpos.alt;
+		sample.terrain_alt = gpos.terrain_alt;
+		sample.terrain_alt_valid = gpos.terrain_alt_valid;
+		_position_history.push(sample);
+	}
+
+	vehicle_attitude_s att;
+
+	if (_att_sub.update(&att)) {
+		if (att.quat_reset_counter != _quat_reset_counter) {
+			_attitude_history.reset();
+			_quat_reset_counter = att.quat_reset_counter;
+		}
+
+		AttitudeSample sample;
+		sample.time_us = att.timestamp_sample;
+
+		for (int i = 0; i < 4; i++) {
+			sample.q[i] = att.q[i];
+		}
+
+		_attitude_history.push(sample);
+	}
+}
+
+bool
+CameraFeedback::publish_capture(const camera_trigger_s &trig, bool force)
+{
+	const PositionSample *pos_before;
+	const PositionSample *pos_after;
+	const AttitudeSample *att_before;
+	const AttitudeSample *att_after;
+
+	const bool pos_found = _position_history.find(trig.timestamp, pos_before, pos_after);
+	const bool att_found = _attitude_history.find(trig.timestamp, att_before, att_after);
+
+	if (!pos_before || !att_before) {
+		// reject until we have valid data
+		return true;
+	}
+
+	const bool pose_pending = (!pos_found && trig.timestamp > pos_after->time_us)
+				  || (!att_found && trig.timestamp > att_after->time_us);
+
+	if (pose_pending && !force) {
+		// wait for the next sample, the trigger is newer than the history
+		return false;
+	}
+
+	camera_capture_s capture{};
+
+	// Fill timestamps
+	capture.timestamp = trig.timestamp;
+	capture.timestamp_utc = trig.timestamp_utc;
+
+	// Fill image sequence
+	capture.seq = trig.seq;
+
+	// Fill position data, linearly interpolated at the trigger time (or the closest sample)
+	float k_pos = 0.f;
+
+	if (pos_after->time_us > pos_before->time_us) {
+		k_pos = (float)(trig.timestamp - pos_before->time_us) / (float)(pos_after->time_us - pos_before->time_us);
+	}
+
+	capture.lat = pos_before->lat + (double)k_pos * (pos_after->lat - pos_before->lat);
+	capture.lon = pos_before->lon + (double)k_pos * (pos_after->lon - pos_before->lon);
+	capture.alt = pos_before->alt + k_pos * (pos_after->alt - pos_before->alt);
+
+	if (pos_before->terrain_alt_valid && pos_after->terrain_alt_valid) {
+		const float terrain_alt = pos_before->terrain_alt + k_pos * (pos_after->terrain_alt - pos_before->terrain_alt);
+		capture.ground_distance = capture.alt - terrain_alt;
+
+	} else {
+		capture.ground_distance = -1.0f;
+	}
+
+	// Fill attitude data, normalized linear interpolation is accurate enough between attitude samples
+	// TODO : this needs to be rotated by camera orientation or set to gimbal orientation when available
+	float k_att = 0.f;
+
+	if (att_after->time_us > att_before->time_us) {
+		k_att = (float)(trig.timestamp - att_before->time_us) / (float)(att_after->time_us - att_before->time_us);
+	}
+
+	const matrix::Quatf q_before(att_before->q);
+	matrix::Quatf q_after(att_after->q);
+
+	if (q_before.dot(q_after) < 0.f) {
+		// take the shorter way
+		q_after = -q_after;
+	}
+
+	matrix::Quatf q = q_before * (1.f - k_att) + q_after * k_att;
+	q.normalize();
+	q.copyTo(capture.q);
+
+	capture.result = 1;
+
+	_capture_pub.publish(capture);
+
+	return true;
+}
+
 void
 CameraFeedback::Run()
 {
 	if (should_exit()) {
 		_trigger_sub.unregisterCallback();
+		_gpos_sub.unregisterCallback();
+		_att_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
+	update_pose_history();
+
 	camera_trigger_s trig{};
 
 	while (_trigger_sub.update(&trig)) {
 
-		// update geotagging subscriptions
-		vehicle_global_position_s gpos{};
-		_gpos_sub.copy(&gpos);
-
-		vehicle_attitude_s att{};
-		_att_sub.copy(&att);
-
-		if (trig.timestamp == 0 ||
-		    gpos.timestamp == 0 ||
-		    att.timestamp == 0) {
-
-			// reject until we have valid data
+		if (trig.timestamp == 0) {
 			continue;
 		}
 
@@ -90,36 +206,33 @@ CameraFeedback::Run()
 			continue;
 		}
 
-		camera_capture_s capture{};
+		if (_pending_triggers_count == MAX_PENDING_TRIGGERS) {
+			// make space, use the best pose we have for the oldest one
+			publish_capture(_pending_triggers[0], true);
 
-		// Fill timestamps
-		capture.timestamp = trig.timestamp;
-		capture.timestamp_utc = trig.timestamp_utc;
+			for (int i = 1; i < _pending_triggers_count; i++) {
+				_pending_triggers[i - 1] = _pending_triggers[i];
+			}
 
-		// Fill image sequence
-		capture.seq = trig.seq;
+			_pending_triggers_count--;
+		}
 
-		// Fill position data
-		capture.lat = gpos.lat;
-		capture.lon = gpos.lon;
-		capture.alt = gpos.alt;
+		_pending_triggers[_pending_triggers_count++] = trig;
+	}
 
-		if (gpos.terrain_alt_valid) {
-			capture.ground_distance = gpos.alt - gpos.terrain_alt;
+	// publish in order, as soon as the pose history covers the trigger time
+	while (_pending_triggers_count > 0) {
+		const bool timeout = hrt_elapsed_time(&_pending_triggers[0].timestamp) > MAX_POSE_WAIT;
 
-		} else {
-			capture.ground_distance = -1.0f;
+		if (!publish_capture(_pending_triggers[0], timeout)) {
+			break;
 		}
 
-		// Fill attitude data
-		// TODO : this needs to be rotated by camera orientation or set to gimbal orientation when available
-		capture.q[0] = att.q[0];
-		capture.q[1] = att.q[1];
-		capture.q[2] = att.q[2];
-		capture.q[3] = att.q[3];
-		capture.result = 1;
+		for (int i = 1; i < _pending_triggers_count; i++) {
+			_pending_triggers[i - 1] = _pending_triggers[i];
+		}
 
-		_capture_pub.publish(capture);
+		_pending_triggers_count--;
 	}
 }
 
@@ -40,7 +40,11 @@
 
 #pragma once
 
+#include "PoseHistory.hpp"
+
+#include <drivers/drv_hrt.h>
 #include <lib/mathlib/mathlib.h>
+#include <lib/matrix/matrix/math.hpp>
 #include <lib/parameters/param.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
@@ -56,6 +60,8 @@
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_global_position.h>
 
+using namespace time_literals;
+
 class CameraFeedback : public ModuleBase<CameraFeedback>, public ModuleParams, public px4::WorkItem
 {
 public:
@@ -77,10 +83,48 @@ private:
 
 	void Run() override;
 
+	void update_pose_history();
+
+	/**
+	 * Publish the capture of a trigger with the pose interpolated at the trigger time.
+	 * @param force publish even if the history does not reach the trigger time yet
+	 * @return true if the trigger was handled (published or rejected)
+	 */
+	bool publish_capture(const camera_trigger_s &trig, bool force);
+
+	struct PositionSample {
+		uint64_t time_us;
+		double lat;
+		double lon;
+		float alt;
+		float terrain_alt;
+		bool terrain_alt_valid;
+	};
+
+	struct AttitudeSample {
+		uint64_t time_us;
+		float q[4];
+	};
+
+	// waiting for a pose sample newer than the trigger, at most this long
+	static constexpr hrt_abstime MAX_POSE_WAIT{100_ms};
+
+	PoseHistory<PositionSample, 8> _position_history{};
+	PoseHistory<AttitudeSample, 16> _attitude_history{};
+
+	uint8_t _lat_lon_reset_counter{0};
+	uint8_t _alt_reset_counter{0};
+	uint8_t _quat_reset_counter{0};
+
+	static constexpr uint8_t MAX_PENDING_TRIGGERS{4};
+	camera_trigger_s _pending_triggers[MAX_PENDING_TRIGGERS] {};
+	uint8_t _pending_triggers_count{0};
+
 	uORB::SubscriptionCallbackWorkItem _trigger_sub{this, ORB_ID(camera_trigger)};
 
-	uORB::Subscription	_gpos_sub{ORB_ID(vehicle_global_position)};
-	uORB::Subscription	_att_sub{ORB_ID(vehicle_attitude)};
+	// the pose topics drive the history so that every sample is stored
+	uORB::SubscriptionCallbackWorkItem _gpos_sub{this, ORB_ID(vehicle_global_position)};
+	uORB::SubscriptionCallbackWorkItem _att_sub{this, ORB_ID(vehicle_attitude)};
 
 	uORB::Publication<camera_capture_s>	_capture_pub{ORB_ID(camera_capture)};
 
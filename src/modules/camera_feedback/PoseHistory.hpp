@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file PoseHistory.hpp
+ *
+ * Short history of timestamped samples, used to look up the samples around
+ * the time of a camera capture.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <typename T, size_t SIZE>
+class PoseHistory
+{
+public:
+	/** samples need to be pushed in chronological order, T needs a uint64_t time_us member */
+	void push(const T &sample)
+	{
+		if (_count > 0 && sample.time_us <= newest().time_us) {
+			// out of order or duplicate
+			return;
+		}
+
+		_buffer[_head] = sample;
+		_head = (_head + 1) % SIZE;
+
+		if (_count < SIZE) {
+			_count++;
+		}
+	}
+
+	void reset() { _count = 0; }
+
+	bool empty() const { return _count == 0; }
+
+	const T &newest() const { return _buffer[(_head + SIZE - 1) % SIZE]; }
+	const T &oldest() const { return _buffer[(_head + SIZE - _count) % SIZE]; }
+
+	/**
+	 * Find the samples around a timestamp.
+	 * @param time_us timestamp to look up
+	 * @param before latest sample with time <= time_us, or the oldest sample if time_us is older than the history
+	 * @param after first sample with time >= time_us, or the newest sample if time_us is newer than the history
+	 * @return true if time_us is within the history, false otherwise (or if it is empty)
+	 */
+	bool find(uint64_t time_us, const T *&before, const T *&after) const
+	{
+		if (_count == 0) {
+			before = after = nullptr;
+			return false;
+		}
+
+		if (time_us >= newest().time_us) {
+			before = after = &newest();
+			return time_us == newest().time_us;
+		}
+
+		if (time_us <= oldest().time_us) {
+			before = after = &oldest();
+			return time_us == oldest().time_us;
+		}
+
+		// search from the newest sample, captures are usually recent
+		for (size_t i = 1; i < _count; i++) {
+			const T &sample = _buffer[(_head + SIZE - 1 - i) % SIZE];
+
+			if (sample.time_us <= time_us) {
+				before = &sample;
+				after = &_buffer[(_head + SIZE - i) % SIZE];
+				return true;
+			}
+		}
+
+		before = after = &oldest();
+		return false;
+	}
+
+private:
+	T _buffer[SIZE] {};
+	size_t _head{0};
+	size_t _count{0};
+};
@@ -482,6 +482,8 @@ int Commander::print_status()
 	PX4_INFO("navigation: %s", nav_state_names[_vehicle_status.nav_state]);
 	perf_print_counter(_loop_perf);
 	perf_print_counter(_preflight_check_perf);
+	perf_print_counter(_failsafe_reaction_perf);
+	_health_and_arming_checks.printStatus();
 	return 0;
 }
 
@@ -760,13 +762,28 @@ Commander::Commander() :
 	_param_mav_type = param_find("MAV_TYPE");
 	_param_rc_map_fltmode = param_find("RC_MAP_FLTMODE");
 
+	px4_sem_init(&_wakeup_sem, 0, 0);
+	// _wakeup_sem use case is a signal
+	px4_sem_setprotocol(&_wakeup_sem, SEM_PRIO_NONE);
+
 	updateParameters();
 }
 
 Commander::~Commander()
 {
+	_action_request_sub.unregisterCallback();
+	_geofence_result_sub.unregisterCallback();
+	_vehicle_command_sub.unregisterCallback();
+
+	for (auto &battery_status_sub : _battery_status_subs) {
+		battery_status_sub.unregisterCallback();
+	}
+
+	px4_sem_destroy(&_wakeup_sem);
+
 	perf_free(_loop_perf);
 	perf_free(_preflight_check_perf);
+	perf_free(_failsafe_reaction_perf);
 }
 
 bool
@@ -1769,12 +1786,44 @@ Commander::run()
 
 	arm_auth_init(&_mavlink_log_pub, &_vehicle_status.system_id);
 
+	_action_request_sub.registerCallback();
+	_geofence_result_sub.registerCallback();
+	_vehicle_command_sub.registerCallback();
+
+	for (auto &battery_status_sub : _battery_status_subs) {
+		battery_status_sub.registerCallback();
+	}
+
+	hrt_abstime housekeeping_deadline = 0;
+
 	while (!should_exit()) {
 
+		// wait for the next cycle or a wakeup if there are no vehicle_commands or action_requests to process
+		if (!_vehicle_command_sub.updated() && !_action_request_sub.updated()) {
+			waitForWakeup(housekeeping_deadline);
+		}
+
+		const hrt_abstime failsafe_event_time = failsafeEventUpdate();
+
+		if ((failsafe_event_time == 0) && (hrt_absolute_time() < housekeeping_deadline)
+		    && !_vehicle_command_sub.updated() && !_action_request_sub.updated()) {
+			// woken up by a publication that does not need a reaction
+			continue;
+		}
+
 		perf_begin(_loop_perf);
 
 		const actuator_armed_s actuator_armed_prev{_actuator_armed};
 
+		if ((failsafe_event_time != 0) && !_vehicle_status_flags.calibration_enabled) {
+			// evaluate the battery warning now instead of with the next 2 Hz status update,
+			// so that the failsafe below already reacts on it
+			perf_begin(_preflight_check_perf);
+			_health_and_arming_checks.update();
+			_vehicle_status_flags.pre_flight_checks_pass = _health_and_arming_checks.canArm(_vehicle_status.nav_state);
+			perf_end(_preflight_check_perf);
+		}
+
 		/* update parameters */
 		const bool params_updated = _parameter_update_sub.updated();
 
@@ -1832,11 +1881,6 @@ Commander::run()
 
 		checkForMissionUpdate();
 
-		/* start geofence result check */
-		if (_geofence_result_sub.update(&_geofence_result)) {
-			_vehicle_status.geofence_violated = _geofence_result.geofence_violated;
-		}
-
 		const bool in_low_battery_failsafe_delay = _battery_failsafe_timestamp != 0;
 
 		// Geofence actions
@@ -2283,10 +2327,12 @@ Commander::run()
 
 		perf_end(_loop_perf);
 
-		// sleep if there are no vehicle_commands or action_requests to process
-		if (!_vehicle_command_sub.updated() && !_action_request_sub.updated()) {
-			px4_usleep(COMMANDER_MONITORING_INTERVAL);
+		if (failsafe_event_time != 0) {
+			// from the publication of the trigger until the reaction got published
+			perf_set_elapsed(_failsafe_reaction_perf, hrt_elapsed_time(&failsafe_event_time));
 		}
+
+		housekeeping_deadline = hrt_absolute_time() + COMMANDER_MONITORING_INTERVAL;
 	}
 
 	rgbled_set_color_and_mode(led_control_s::COLOR_WHITE, led_control_s::MODE_OFF);
@@ -2296,6 +2342,62 @@ Commander::run()
 	buzzer_deinit();
 }
 
+void Commander::waitForWakeup(const hrt_abstime deadline)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (now < deadline) {
+		timespec ts{};
+#if defined(__PX4_NUTTX)
+		px4_clock_gettime(CLOCK_REALTIME, &ts);
+#else
+		px4_clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+		uint64_t nsecs = ts.tv_nsec + (deadline - now) * 1000;
+		ts.tv_sec += nsecs / 1'000'000'000;
+		ts.tv_nsec = nsecs % 1'000'000'000;
+
+		px4_sem_timedwait(&_wakeup_sem, &ts);
+	}
+
+	// all publications since are handled by this cycle
+	while (px4_sem_trywait(&_wakeup_sem) == 0) {}
+}
+
+hrt_abstime Commander::failsafeEventUpdate()
+{
+	hrt_abstime event_time = 0;
+
+	for (int i = 0; i < battery_status_s::MAX_INSTANCES; i++) {
+		battery_status_s battery_status;
+
+		if (_battery_status_subs[i].update(&battery_status)) {
+			const uint8_t warning = battery_status.connected ? battery_status.warning : battery_status_s::BATTERY_WARNING_NONE;
+
+			if (warning != _battery_status_warning[i]) {
+				_battery_status_warning[i] = warning;
+
+				if ((event_time == 0) || (battery_status.timestamp < event_time)) {
+					event_time = battery_status.timestamp;
+				}
+			}
+		}
+	}
+
+	/* start geofence result check */
+	if (_geofence_result_sub.update(&_geofence_result)) {
+		if (_geofence_result.geofence_violated != _vehicle_status.geofence_violated) {
+			if ((event_time == 0) || (_geofence_result.timestamp < event_time)) {
+				event_time = _geofence_result.timestamp;
+			}
+		}
+
+		_vehicle_status.geofence_violated = _geofence_result.geofence_violated;
+	}
+
+	return event_time;
+}
+
 void Commander::checkForMissionUpdate()
 {
 	if (_mission_result_sub.updated()) {
@@ -48,6 +48,7 @@
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
+#include <px4_platform_common/sem.h>
 
 // publications
 #include <uORB/Publication.hpp>
@@ -61,6 +62,7 @@
 
 // subscriptions
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/SubscriptionInterval.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
 #include <uORB/topics/action_request.h>
@@ -120,6 +122,23 @@ public:
 	void get_circuit_breaker_params();
 
 private:
+	/**
+	 * Subscription that wakes up the main loop whenever the topic is published
+	 */
+	class WakeupSubscription : public uORB::SubscriptionCallback
+	{
+	public:
+		WakeupSubscription(px4_sem_t &wakeup_sem, const orb_metadata *meta, uint8_t instance = 0) :
+			SubscriptionCallback(meta, 0, instance),
+			_wakeup_sem(wakeup_sem)
+		{}
+
+		void call() override { px4_sem_post(&_wakeup_sem); }
+
+	private:
+		px4_sem_t &_wakeup_sem;
+	};
+
 	void answer_command(const vehicle_command_s &cmd, uint8_t result);
 
 	transition_result_t arm(arm_disarm_reason_t calling_reason, bool run_preflight_checks = true);
@@ -127,6 +146,17 @@ private:
 
 	void battery_status_check();
 
+	/**
+	 * Wait until the next housekeeping cycle is due or a subscribed event is published.
+	 */
+	void waitForWakeup(const hrt_abstime deadline);
+
+	/**
+	 * Fast path for failsafe triggers (battery warning level, geofence violation).
+	 * @return timestamp of the earliest trigger that needs a reaction, 0 if none
+	 */
+	hrt_abstime failsafeEventUpdate();
+
 	void control_status_leds(bool changed, const uint8_t battery_warning);
 
 	/**
@@ -353,15 +383,18 @@ private:
 
 	WorkerThread _worker_thread;
 
+	// posted by the WakeupSubscriptions
+	px4_sem_t _wakeup_sem{};
+
 	// Subscriptions
-	uORB::Subscription					_action_request_sub {ORB_ID(action_request)};
+	WakeupSubscription					_action_request_sub{_wakeup_sem, ORB_ID(action_request)};
 	uORB::Subscription					_cpuload_sub{ORB_ID(cpuload)};
-	uORB::Subscription					_geofence_result_sub{ORB_ID(geofence_result)};
+	WakeupSubscription					_geofence_result_sub{_wakeup_sem, ORB_ID(geofence_result)};
 	uORB::Subscription					_iridiumsbd_status_sub{ORB_ID(iridiumsbd_status)};
 	uORB::Subscription					_vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
 	uORB::Subscription					_manual_control_setpoint_sub{ORB_ID(manual_control_setpoint)};
 	uORB::Subscription					_system_power_sub{ORB_ID(system_power)};
-	uORB::Subscription					_vehicle_command_sub{ORB_ID(vehicle_command)};
+	WakeupSubscription					_vehicle_command_sub{_wakeup_sem, ORB_ID(vehicle_command)};
 	uORB::Subscription					_vtol_vehicle_status_sub{ORB_ID(vtol_vehicle_status)};
 	uORB::Subscription					_wind_sub{ORB_ID(wind)};
 
@@ -369,6 +402,14 @@ private:
 
 	uORB::SubscriptionMultiArray<telemetry_status_s>        _telemetry_status_subs{ORB_ID::telemetry_status};
 
+	WakeupSubscription _battery_status_subs[battery_status_s::MAX_INSTANCES] {
+		{_wakeup_sem, ORB_ID(battery_status), 0},
+		{_wakeup_sem, ORB_ID(battery_status), 1},
+		{_wakeup_sem, ORB_ID(battery_status), 2},
+		{_wakeup_sem, ORB_ID(battery_status), 3},
+	};
+	uint8_t _battery_status_warning[battery_status_s::MAX_INSTANCES] {};
+
 #if defined(BOARD_HAS_POWER_CONTROL)
 	uORB::Subscription					_power_button_state_sub {ORB_ID(power_button_state)};
 #endif // BOARD_HAS_POWER_CONTROL
@@ -391,6 +432,7 @@ private:
 
 	perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
 	perf_counter_t _preflight_check_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": preflight check")};
+	perf_counter_t _failsafe_reaction_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": failsafe reaction")};
 	HealthAndArmingChecks _health_and_arming_checks;
 	HomePosition _home_position{_vehicle_status_flags};
 };
@@ -41,6 +41,10 @@ HealthAndArmingChecks::HealthAndArmingChecks(ModuleParams *parent, vehicle_statu
 {
 }
 
+#if !defined(CONSTRAINED_FLASH)
+constexpr const char *HealthAndArmingChecks::_check_names[];
+#endif
+
 bool HealthAndArmingChecks::update(bool force_reporting)
 {
 	_reporter.reset();
@@ -52,9 +56,28 @@ bool HealthAndArmingChecks::update(bool force_reporting)
 			break;
 		}
 
+#if !defined(CONSTRAINED_FLASH)
+		const hrt_abstime check_start = hrt_absolute_time();
 		_checks[i]->checkAndReport(_context, _reporter);
+
+		if (i < sizeof(_check_profile) / sizeof(_check_profile[0])) {
+			const uint32_t elapsed_us = hrt_elapsed_time(&check_start);
+			_check_profile[i].total_us += elapsed_us;
+
+			if (elapsed_us > _check_profile[i].max_us) {
+				_check_profile[i].max_us = elapsed_us;
+			}
+		}
+
+#else
+		_checks[i]->checkAndReport(_context, _reporter);
+#endif // !CONSTRAINED_FLASH
 	}
 
+#if !defined(CONSTRAINED_FLASH)
+	_profile_runs++;
+#endif
+
 	_reporter.finalize();
 
 	if (_reporter.report(_context.isArmed(), force_reporting)) {
@@ -101,3 +124,25 @@ void HealthAndArmingChecks::updateParams()
 		_checks[i]->updateParams();
 	}
 }
+
+void HealthAndArmingChecks::printStatus() const
+{
+#if !defined(CONSTRAINED_FLASH)
+
+	if (_profile_runs == 0) {
+		return;
+	}
+
+	PX4_INFO("health and arming checks (%" PRIu32 " runs):", _profile_runs);
+
+	for (unsigned i = 0; i < sizeof(_check_profile) / sizeof(_check_profile[0]); ++i) {
+		if (!_checks[i]) {
+			break;
+		}
+
+		PX4_INFO_RAW("  %-18s avg: %5.1f us, max: %5" PRIu32 " us\n", _check_names[i],
+			     (double)_check_profile[i].total_us / _profile_runs, _check_profile[i].max_us);
+	}
+
+#endif // !CONSTRAINED_FLASH
+}
@@ -84,6 +84,11 @@ public:
 	 */
 	bool canRun(uint8_t nav_state) const { return _reporter.canRun(nav_state); }
 
+	/**
+	 * Print the execution time profile of the individual checks
+	 */
+	void printStatus() const;
+
 protected:
 	void updateParams() override;
 private:
@@ -135,5 +140,38 @@ private:
 		&_system_checks,
 		&_battery_checks,
 	};
+
+#if !defined(CONSTRAINED_FLASH)
+	// names for the profile, same order as _checks
+	static constexpr const char *_check_names[] = {
+		"accelerometer",
+		"airspeed",
+		"baro",
+		"cpu_resource",
+		"distance_sensor",
+		"esc",
+		"estimator",
+		"failure_detector",
+		"gyro",
+		"imu_consistency",
+		"magnetometer",
+		"manual_control",
+		"mode",
+		"parachute",
+		"power",
+		"rc_calibration",
+		"sd_card",
+		"system",
+		"battery",
+	};
+
+	struct CheckProfile {
+		uint64_t total_us;
+		uint32_t max_us;
+	};
+
+	CheckProfile _check_profile[sizeof(_check_names) / sizeof(_check_names[0])] {};
+	uint32_t _profile_runs{0};
+#endif // !CONSTRAINED_FLASH
 };
 
@@ -288,59 +288,24 @@ void FailureDetector::updateEscsStatus(const vehicle_status_s &vehicle_status, c
 
 void FailureDetector::updateImbalancedPropStatus()
 {
+	vehicle_imu_status_s imu_status;
 
-	if (_sensor_selection_sub.updated()) {
-		sensor_selection_s selection;
+	if (_selected_imu_status.update(&imu_status)) {
+		const float dt = math::constrain((float)(imu_status.timestamp - _imu_status_timestamp_prev), 0.01f, 1.f);
+		_imu_status_timestamp_prev = imu_status.timestamp;
 
-		if (_sensor_selection_sub.copy(&selection)) {
-			_selected_accel_device_id = selection.accel_device_id;
-		}
-	}
-
-	const bool updated = _vehicle_imu_status_sub.updated(); // save before doing a copy
-
-	// Find the imu_status instance corresponding to the selected accelerometer
-	vehicle_imu_status_s imu_status{};
-	_vehicle_imu_status_sub.copy(&imu_status);
-
-	if (imu_status.accel_device_id != _selected_accel_device_id) {
-
-		for (unsigned i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
-			if (!_vehicle_imu_status_sub.ChangeInstance(i)) {
-				continue;
-			}
-
-			if (_vehicle_imu_status_sub.copy(&imu_status)
-			    && (imu_status.accel_device_id == _selected_accel_device_id)) {
-				// instance found
-				break;
-			}
-		}
-	}
-
-	if (updated) {
-
-		if (_vehicle_imu_status_sub.copy(&imu_status)) {
+		_imbalanced_prop_lpf.setParameters(dt, _imbalanced_prop_lpf_time_constant);
 
-			if ((imu_status.accel_device_id != 0)
-			    && (imu_status.accel_device_id == _selected_accel_device_id)) {
-				const float dt = math::constrain((float)(imu_status.timestamp - _imu_status_timestamp_prev), 0.01f, 1.f);
-				_imu_status_timestamp_prev = imu_status.timestamp;
+		const float std_x = sqrtf(imu_status.var_accel[0]);
+		const float std_y = sqrtf(imu_status.var_accel[1]);
+		const float std_z = sqrtf(imu_status.var_accel[2]);
 
-				_imbalanced_prop_lpf.setParameters(dt, _imbalanced_prop_lpf_time_constant);
+		// Note: the metric is done using standard deviations instead of variances to be linear
+		const float metric = (std_x + std_y) / 2.f - std_z;
+		const float metric_lpf = _imbalanced_prop_lpf.update(metric);
 
-				const float std_x = sqrtf(imu_status.var_accel[0]);
-				const float std_y = sqrtf(imu_status.var_accel[1]);
-				const float std_z = sqrtf(imu_status.var_accel[2]);
-
-				// Note: the metric is done using standard deviations instead of variances to be linear
-				const float metric = (std_x + std_y) / 2.f - std_z;
-				const float metric_lpf = _imbalanced_prop_lpf.update(metric);
-
-				const bool is_imbalanced = metric_lpf > _param_fd_imb_prop_thr.get();
-				_status.flags.imbalanced_prop = is_imbalanced;
-			}
-		}
+		const bool is_imbalanced = metric_lpf > _param_fd_imb_prop_thr.get();
+		_status.flags.imbalanced_prop = is_imbalanced;
 	}
 }
 
@@ -33,6 +33,9 @@
 
 #include "lm_fit.hpp"
 
+static constexpr float min_radius = 0.2f;
+static constexpr float max_radius = 0.7f;
+
 struct iteration_result {
 	float gradient_damping;
 	float cost;
@@ -76,8 +79,8 @@ void lm_sphere_fit_iteration(const float x[], const float y[], const float z[],
 		residual = params.radius - length;
 
 		for (uint8_t i = 0; i < 4; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 4; j++) {
+			// compute JTJ (upper triangle only, it is symmetric)
+			for (uint8_t j = i; j < 4; j++) {
 				JTJ(i, j) += sphere_jacob[i] * sphere_jacob[j];
 			}
 
@@ -85,6 +88,12 @@ void lm_sphere_fit_iteration(const float x[], const float y[], const float z[],
 		}
 	}
 
+	for (uint8_t i = 1; i < 4; i++) {
+		for (uint8_t j = 0; j < i; j++) {
+			JTJ(i, j) = JTJ(j, i);
+		}
+	}
+
 
 	//------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
 	// refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
@@ -214,8 +223,8 @@ void lm_ellipsoid_fit_iteration(const float x[], const float y[], const float z[
 		ellipsoid_jacob[8] = -1.0f * (((z[k] - params.offset(2)) * B) + ((y[k] - params.offset(1)) * C)) / length;
 
 		for (uint8_t i = 0; i < 9; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 9; j++) {
+			// compute JTJ (upper triangle only, it is symmetric)
+			for (uint8_t j = i; j < 9; j++) {
 				JTJ(i, j) += ellipsoid_jacob[i] * ellipsoid_jacob[j];
 			}
 
@@ -223,6 +232,12 @@ void lm_ellipsoid_fit_iteration(const float x[], const float y[], const float z[
 		}
 	}
 
+	for (uint8_t i = 1; i < 9; i++) {
+		for (uint8_t j = 0; j < i; j++) {
+			JTJ(i, j) = JTJ(j, i);
+		}
+	}
+
 
 	//------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
 	// refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
@@ -322,9 +337,6 @@ int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int s
 	const float cost_threshold = 0.01;
 	const float step_threshold = 0.001;
 
-	const float min_radius = 0.2;
-	const float max_radius = 0.7;
-
 	iteration_result iter;
 	iter.cost = 1e30f;
 	iter.gradient_damping = 1;
@@ -354,3 +366,50 @@ int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int s
 	return 1;
 }
 
+
+void SphereFitAccumulator::add(const matrix::Vector3f &point)
+{
+	if (_samples == 0) {
+		_reference = point;
+	}
+
+	const matrix::Vector3f p = point - _reference;
+	const float a[4] {p(0), p(1), p(2), 1.f};
+	const float b = p.norm_squared();
+
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			_ATA(i, j) += a[i] * a[j];
+		}
+
+		_ATb(i) += a[i] * b;
+	}
+
+	_samples++;
+}
+
+bool SphereFitAccumulator::fit(sphere_params &params) const
+{
+	if (_samples < 4) {
+		return false;
+	}
+
+	matrix::SquareMatrix<float, 4> ATA_inv;
+
+	if (!_ATA.I(ATA_inv)) {
+		return false;
+	}
+
+	const matrix::Vector<float, 4> u = ATA_inv * _ATb;
+	const matrix::Vector3f center{u(0) * 0.5f, u(1) * 0.5f, u(2) * 0.5f};
+	const float radius_squared = u(3) + center.norm_squared();
+
+	if (!PX4_ISFINITE(radius_squared) || (radius_squared < min_radius * min_radius)
+	    || (radius_squared > max_radius * max_radius)) {
+		return false;
+	}
+
+	params.offset = _reference + center;
+	params.radius = sqrtf(radius_squared);
+	return true;
+}
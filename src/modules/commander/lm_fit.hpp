@@ -63,3 +63,32 @@ struct sphere_params {
  */
 int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int samples_collected, sphere_params &params,
 	       bool full_ellipsoid);
+
+/**
+ * Linear least-squares fit of a sphere, updated with every new point.
+ *
+ * Solves |p|^2 = 2 p.c + r^2 - |c|^2 for the center c and the radius r using normal equations
+ * that are accumulated as the points arrive, so the result is available right after the last
+ * point without another pass over the data. It does not minimize the geometric distance (and
+ * ignores scale factors), but it is a close initial guess for lm_mag_fit().
+ */
+class SphereFitAccumulator
+{
+public:
+	void add(const matrix::Vector3f &point);
+
+	/**
+	 * Compute the sphere from the points added so far.
+	 * @param params offset and radius are updated on success
+	 * @return true on success
+	 */
+	bool fit(sphere_params &params) const;
+
+	unsigned int samples() const { return _samples; }
+
+private:
+	matrix::SquareMatrix<float, 4> _ATA{};
+	matrix::Vector<float, 4> _ATb{};
+	matrix::Vector3f _reference{}; ///< first point, all points are relative to it for numerical stability
+	unsigned int _samples{0};
+};
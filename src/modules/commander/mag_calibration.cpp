@@ -94,6 +94,8 @@ struct mag_worker_data_t {
 	float		*y[MAX_MAGS];
 	float		*z[MAX_MAGS];
 
+	SphereFitAccumulator sphere_fit[MAX_MAGS] {};		///< updated with every sample for the initial guess
+
 	calibration::Magnetometer calibration[MAX_MAGS] {};
 };
 
@@ -387,6 +389,7 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 						worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](0);
 						worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](1);
 						worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](2);
+						worker_data->sphere_fit[cur_mag].add(new_samples[cur_mag]);
 
 						worker_data->calibration_counter_total[cur_mag]++;
 					}
@@ -590,6 +593,12 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 				sphere_data.diag = matrix::Vector3f(diag[cur_mag](0), diag[cur_mag](1), diag[cur_mag](2));
 				sphere_data.offdiag = matrix::Vector3f(offdiag[cur_mag](0), offdiag[cur_mag](1), offdiag[cur_mag](2));
 
+				// start from the linear fit of the collected samples, it is usually close to the solution
+				// and saves most of the Levenberg-Marquardt iterations
+				if (worker_data.sphere_fit[cur_mag].fit(sphere_data)) {
+					PX4_DEBUG("Mag: %" PRIu8 " initial sphere radius: %.4f", cur_mag, (double)sphere_data.radius);
+				}
+
 				bool sphere_fit_success = false;
 				bool ellipsoid_fit_success = false;
 				int ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
@@ -974,9 +983,10 @@ int do_mag_calibration_quick(orb_advert_t *mavlink_log_pub, float heading_radian
 	} else {
 
 		// magnetic field data returned by the geo library using the current GPS position
-		const float mag_declination_gps = get_mag_declination_radians(latitude, longitude);
-		const float mag_inclination_gps = get_mag_inclination_radians(latitude, longitude);
-		const float mag_strength_gps = get_mag_strength_gauss(latitude, longitude);
+		const MagField mag_field = get_mag_field(latitude, longitude);
+		const float mag_declination_gps = mag_field.declination;
+		const float mag_inclination_gps = mag_field.inclination;
+		const float mag_strength_gps = mag_field.strength;
 
 		const Vector3f mag_earth_pred = Dcmf(Eulerf(0, -mag_inclination_gps, mag_declination_gps)) * Vector3f(mag_strength_gps,
 						0, 0);
@@ -236,3 +236,55 @@ TEST_F(MagCalTest, replayTestData)
 	EXPECT_NEAR(ellipsoid.diag(1), scale_true(1), 0.01f) << "scale Y: " << ellipsoid.diag(1);
 	EXPECT_NEAR(ellipsoid.diag(2), scale_true(2), 0.01f) << "scale Z: " << ellipsoid.diag(2);
 }
+
+TEST_F(MagCalTest, sphereAccumulatorInitialGuess)
+{
+	// GIVEN: the real test dataset, added to the accumulator one sample at a time
+	constexpr unsigned int N_SAMPLES = 231;
+
+	const float mag_str_true = 0.4f;
+	const Vector3f offset_true = {-0.18f, 0.05f, -0.58f};
+
+	SphereFitAccumulator accumulator;
+
+	for (unsigned int k = 0; k < N_SAMPLES; k++) {
+		accumulator.add(Vector3f{mag_data1_x[k], mag_data1_y[k], mag_data1_z[k]});
+	}
+
+	// WHEN: solving the accumulated linear fit
+	sphere_params sphere;
+	sphere.diag = {1.f, 1.f, 1.f};
+	sphere.radius = 0.2;
+	const bool linear_success = accumulator.fit(sphere);
+
+	// THEN: the result is already close to the solution
+	EXPECT_TRUE(linear_success);
+	EXPECT_EQ(accumulator.samples(), N_SAMPLES);
+	EXPECT_NEAR(sphere.radius, mag_str_true, 0.1f) << "radius: " << sphere.radius;
+	EXPECT_NEAR(sphere.offset(0), offset_true(0), 0.05f) << "offset X: " << sphere.offset(0);
+	EXPECT_NEAR(sphere.offset(1), offset_true(1), 0.05f) << "offset Y: " << sphere.offset(1);
+	EXPECT_NEAR(sphere.offset(2), offset_true(2), 0.05f) << "offset Z: " << sphere.offset(2);
+
+	// AND: the Levenberg-Marquardt fit started from it finds the correct parameters
+	EXPECT_EQ(lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, sphere, false), PX4_OK);
+	EXPECT_NEAR(sphere.offset(0), offset_true(0), 0.01f) << "offset X: " << sphere.offset(0);
+	EXPECT_NEAR(sphere.offset(1), offset_true(1), 0.01f) << "offset Y: " << sphere.offset(1);
+	EXPECT_NEAR(sphere.offset(2), offset_true(2), 0.01f) << "offset Z: " << sphere.offset(2);
+}
+
+TEST_F(MagCalTest, sphereAccumulatorNotEnoughSamples)
+{
+	// GIVEN: less samples than unknowns
+	SphereFitAccumulator accumulator;
+	accumulator.add(Vector3f{0.4f, 0.f, 0.f});
+	accumulator.add(Vector3f{0.f, 0.4f, 0.f});
+	accumulator.add(Vector3f{0.f, 0.f, 0.4f});
+
+	// WHEN: solving the linear fit
+	sphere_params sphere;
+	sphere.radius = 0.2;
+
+	// THEN: it fails and does not touch the parameters
+	EXPECT_FALSE(accumulator.fit(sphere));
+	EXPECT_FLOAT_EQ(sphere.radius, 0.2f);
+}
@@ -51,6 +51,7 @@ enum class AllocationMethod {
 	PSEUDO_INVERSE = 0,
 	SEQUENTIAL_DESATURATION = 1,
 	AUTO = 2,
+	WEIGHTED_LEAST_SQUARES = 3,
 };
 
 enum class ActuatorType {
@@ -63,6 +63,23 @@ ControlAllocation::setEffectivenessMatrix(
 	_control_trim = _effectiveness * linearization_point_clipped;
 }
 
+matrix::Vector<float, ControlAllocation::NUM_AXES>
+ControlAllocation::getAllocatedControl() const
+{
+	// only the configured actuators contribute, the other effectiveness columns are 0
+	matrix::Vector<float, NUM_AXES> allocated_control;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		const float actuator = _actuator_sp(i) - _actuator_trim(i);
+
+		for (int j = 0; j < NUM_AXES; j++) {
+			allocated_control(j) += _effectiveness(j, i) * actuator;
+		}
+	}
+
+	return allocated_control.emult(_control_allocation_scale);
+}
+
 void
 ControlAllocation::setActuatorSetpoint(
 	const matrix::Vector<float, ControlAllocation::NUM_ACTUATORS> &actuator_sp)
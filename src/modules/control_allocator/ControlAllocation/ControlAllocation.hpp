@@ -142,8 +142,7 @@ public:
 	 *
 	 * @return Control vector
 	 */
-	matrix::Vector<float, NUM_AXES> getAllocatedControl() const
-	{ return (_effectiveness * (_actuator_sp - _actuator_trim)).emult(_control_allocation_scale); }
+	matrix::Vector<float, NUM_AXES> getAllocatedControl() const;
 
 	/**
 	 * Get the control effectiveness matrix
@@ -41,6 +41,15 @@
 
 #include "ControlAllocationPseudoInverse.hpp"
 
+#include <string.h>
+
+// bitwise comparison, a cached mix is only reused for the identical matrix
+static bool isEqualExact(const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &a,
+			 const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &b)
+{
+	return memcmp(&a(0, 0), &b(0, 0), sizeof(float) * ControlAllocation::NUM_AXES * ControlAllocation::NUM_ACTUATORS) == 0;
+}
+
 void
 ControlAllocationPseudoInverse::setEffectivenessMatrix(
 	const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &effectiveness,
@@ -51,13 +60,38 @@ ControlAllocationPseudoInverse::setEffectivenessMatrix(
 			update_normalization_scale);
 	_mix_update_needed = true;
 	_normalization_needs_update = update_normalization_scale;
+
+	_mix_kernel = selectMixKernel(num_actuators);
+
+	// the kernels only write the configured actuators
+	for (int i = num_actuators; i < NUM_ACTUATORS; i++) {
+		_actuator_sp(i) = _actuator_trim(i);
+	}
+}
+
+ControlAllocationPseudoInverse::MixKernel
+ControlAllocationPseudoInverse::selectMixKernel(int num_actuators)
+{
+	switch (num_actuators) {
+	case 4:
+		return &mixKernel<4>;
+
+	case 6:
+		return &mixKernel<6>;
+
+	case 8:
+		return &mixKernel<8>;
+
+	default:
+		return &mixKernel<0>;
+	}
 }
 
 void
 ControlAllocationPseudoInverse::updatePseudoInverse()
 {
 	if (_mix_update_needed) {
-		matrix::geninv(_effectiveness, _mix);
+		computeMix();
 
 		if (_normalization_needs_update && !_had_actuator_failure) {
 			updateControlAllocationMatrixScale();
@@ -69,6 +103,25 @@ ControlAllocationPseudoInverse::updatePseudoInverse()
 	}
 }
 
+void
+ControlAllocationPseudoInverse::computeMix()
+{
+	for (int i = 0; i < MIX_CACHE_SIZE; i++) {
+		if (_mix_cache[i].valid && isEqualExact(_mix_cache[i].effectiveness, _effectiveness)) {
+			_mix = _mix_cache[i].mix;
+			return;
+		}
+	}
+
+	matrix::geninv(_effectiveness, _mix);
+
+	MixCacheEntry &entry = _mix_cache[_mix_cache_next];
+	entry.effectiveness = _effectiveness;
+	entry.mix = _mix;
+	entry.valid = true;
+	_mix_cache_next = (_mix_cache_next + 1) % MIX_CACHE_SIZE;
+}
+
 void
 ControlAllocationPseudoInverse::updateControlAllocationMatrixScale()
 {
@@ -177,5 +230,5 @@ ControlAllocationPseudoInverse::allocate()
 	_prev_actuator_sp = _actuator_sp;
 
 	// Allocate
-	_actuator_sp = _actuator_trim + _mix * (_control_sp - _control_trim);
+	_mix_kernel(_mix, _control_sp - _control_trim, _actuator_trim, _num_actuators, _actuator_sp);
 }
@@ -59,8 +59,38 @@ public:
 				    bool update_normalization_scale) override;
 
 protected:
+	typedef void (*MixKernel)(const matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> &mix,
+				  const matrix::Vector<float, NUM_AXES> &control, const ActuatorVector &actuator_trim, int num_actuators,
+				  ActuatorVector &actuator_sp);
+
+	/**
+	 * actuator_sp = actuator_trim + mix * control for the first N actuators,
+	 * with a compile time trip count for the common rotor counts.
+	 */
+	template<int N>
+	static void mixKernel(const matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> &mix,
+			      const matrix::Vector<float, NUM_AXES> &control, const ActuatorVector &actuator_trim, int num_actuators,
+			      ActuatorVector &actuator_sp)
+	{
+		const int n = (N > 0) ? N : num_actuators;
+
+		for (int i = 0; i < n; i++) {
+			float sum = actuator_trim(i);
+
+			for (int j = 0; j < NUM_AXES; j++) {
+				sum += mix(i, j) * control(j);
+			}
+
+			actuator_sp(i) = sum;
+		}
+	}
+
+	static MixKernel selectMixKernel(int num_actuators);
+
 	matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> _mix;
 
+	MixKernel _mix_kernel{&mixKernel<0>};
+
 	bool _mix_update_needed{false};
 
 	/**
@@ -72,5 +102,29 @@ protected:
 private:
 	void normalizeControlAllocationMatrix();
 	void updateControlAllocationMatrixScale();
+
+	/**
+	 * Get the (not normalized) pseudo inverse of the current effectiveness matrix from the cache,
+	 * or compute and add it to the cache.
+	 */
+	void computeMix();
+
 	bool _normalization_needs_update{false};
+
+	// Cache of recent pseudo inverses. Time-varying configurations (tilt-rotors, VTOL transitions)
+	// mostly switch between a few steady effectiveness matrices, for which this avoids the inversion.
+#if defined(CONSTRAINED_MEMORY)
+	static constexpr int MIX_CACHE_SIZE = 1;
+#else
+	static constexpr int MIX_CACHE_SIZE = 4;
+#endif
+
+	struct MixCacheEntry {
+		matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> effectiveness;
+		matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> mix;
+		bool valid{false};
+	};
+
+	MixCacheEntry _mix_cache[MIX_CACHE_SIZE] {};
+	int _mix_cache_next{0};
 };
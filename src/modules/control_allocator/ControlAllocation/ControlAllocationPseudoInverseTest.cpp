@@ -67,3 +67,40 @@ TEST(ControlAllocationTest, AllZeroCase)
 	EXPECT_EQ(actuator_sp, actuator_sp_expected);
 	EXPECT_EQ(control_allocated, control_allocated_expected);
 }
+
+TEST(ControlAllocationTest, CachedMixCase)
+{
+	// switching back to a previous effectiveness matrix must give the same allocation
+	matrix::Matrix<float, 6, 16> effectiveness_a;
+	matrix::Matrix<float, 6, 16> effectiveness_b;
+	matrix::Vector<float, 16> actuator_trim;
+	matrix::Vector<float, 16> linearization_point;
+
+	for (int i = 0; i < 6; i++) {
+		for (int j = 0; j < 4; j++) {
+			effectiveness_a(i, j) = ((i + j) % 3) - 1.f + 0.1f * i;
+			effectiveness_b(i, j) = ((i * j) % 3) - 1.f + 0.2f * j;
+		}
+	}
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.1f;
+	control_sp(2) = -0.2f;
+	control_sp(5) = -0.5f;
+
+	ControlAllocationPseudoInverse reference;
+	reference.setEffectivenessMatrix(effectiveness_a, actuator_trim, linearization_point, 4, true);
+	reference.setControlSetpoint(control_sp);
+	reference.allocate();
+
+	ControlAllocationPseudoInverse method;
+	method.setEffectivenessMatrix(effectiveness_a, actuator_trim, linearization_point, 4, true);
+	method.setControlSetpoint(control_sp);
+	method.allocate();
+	method.setEffectivenessMatrix(effectiveness_b, actuator_trim, linearization_point, 4, false);
+	method.allocate();
+	method.setEffectivenessMatrix(effectiveness_a, actuator_trim, linearization_point, 4, false);
+	method.allocate();
+
+	EXPECT_EQ(method.getActuatorSetpoint(), reference.getActuatorSetpoint());
+}
@@ -0,0 +1,287 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationWeightedLeastSquares.cpp
+ *
+ * Active set solver for the weighted least-squares control allocation,
+ * see O. Härkegård, "Efficient active set algorithms for solving constrained least squares problems
+ * in aircraft control allocation", CDC 2002.
+ */
+
+#include "ControlAllocationWeightedLeastSquares.hpp"
+
+#include <mathlib/math/Limits.hpp>
+
+// allocation priorities (Wv): roll/pitch over thrust over yaw
+static constexpr float AXIS_WEIGHTS[ControlAllocation::NUM_AXES] {1.f, 1.f, 0.1f, 0.5f, 0.5f, 0.5f};
+
+void
+ControlAllocationWeightedLeastSquares::updateHessian()
+{
+	// effectiveness in the normalized control space: B_n = diag(scale) * B
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> effectiveness;
+
+	for (int j = 0; j < NUM_AXES; j++) {
+		effectiveness.row(j) = _effectiveness.row(j) * _control_allocation_scale(j);
+	}
+
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		for (int j = 0; j < NUM_AXES; j++) {
+			_gradient_map(i, j) = AXIS_WEIGHTS[j] * AXIS_WEIGHTS[j] * effectiveness(j, i);
+		}
+	}
+
+	_hessian = _gradient_map * effectiveness;
+
+	float diag_max = 0.f;
+
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		diag_max = fmaxf(diag_max, _hessian(i, i));
+	}
+
+	const float regularization = (diag_max > FLT_EPSILON) ? REGULARIZATION * diag_max : 1.f;
+
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		_hessian(i, i) += regularization;
+	}
+}
+
+bool
+ControlAllocationWeightedLeastSquares::solveFree(const ActuatorVector &r, ActuatorVector &p)
+{
+	int free_idx[NUM_ACTUATORS];
+	int n = 0;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_active_set[i] == ActiveSet::FREE) {
+			free_idx[n++] = i;
+		}
+	}
+
+	p.setZero();
+
+	// Cholesky decomposition H_ff = L L^T (lower triangle of _cholesky)
+	for (int j = 0; j < n; j++) {
+		float diag = _hessian(free_idx[j], free_idx[j]);
+
+		for (int k = 0; k < j; k++) {
+			diag -= _cholesky(j, k) * _cholesky(j, k);
+		}
+
+		if (!(diag > 0.f)) {
+			return false;
+		}
+
+		_cholesky(j, j) = sqrtf(diag);
+
+		for (int i = j + 1; i < n; i++) {
+			float sum = _hessian(free_idx[i], free_idx[j]);
+
+			for (int k = 0; k < j; k++) {
+				sum -= _cholesky(i, k) * _cholesky(j, k);
+			}
+
+			_cholesky(i, j) = sum / _cholesky(j, j);
+		}
+	}
+
+	// forward substitution L y = r_f
+	float y[NUM_ACTUATORS];
+
+	for (int i = 0; i < n; i++) {
+		float sum = r(free_idx[i]);
+
+		for (int k = 0; k < i; k++) {
+			sum -= _cholesky(i, k) * y[k];
+		}
+
+		y[i] = sum / _cholesky(i, i);
+	}
+
+	// back substitution L^T p_f = y
+	for (int i = n - 1; i >= 0; i--) {
+		float sum = y[i];
+
+		for (int k = i + 1; k < n; k++) {
+			sum -= _cholesky(k, i) * p(free_idx[k]);
+		}
+
+		p(free_idx[i]) = sum / _cholesky(i, i);
+	}
+
+	return true;
+}
+
+void
+ControlAllocationWeightedLeastSquares::allocate()
+{
+	// Compute new gains (and normalization) if needed
+	const bool effectiveness_updated = _mix_update_needed;
+	updatePseudoInverse();
+
+	if (effectiveness_updated) {
+		updateHessian();
+	}
+
+	_prev_actuator_sp = _actuator_sp;
+
+	// work with the deviation from trim: u = _actuator_trim + delta
+	ActuatorVector delta;
+	ActuatorVector lower;
+	ActuatorVector upper;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		lower(i) = _actuator_min(i) - _actuator_trim(i);
+		upper(i) = _actuator_max(i) - _actuator_trim(i);
+
+		if (_actuator_max(i) < _actuator_min(i)) {
+			_active_set[i] = ActiveSet::FIXED;
+			delta(i) = 0.f;
+			continue;
+		}
+
+		if (_active_set[i] == ActiveSet::FIXED) {
+			_active_set[i] = ActiveSet::FREE;
+		}
+
+		// warm start: previous solution and active set, made consistent and feasible
+		if (_active_set[i] == ActiveSet::LOWER) {
+			delta(i) = lower(i);
+
+		} else if (_active_set[i] == ActiveSet::UPPER) {
+			delta(i) = upper(i);
+
+		} else {
+			delta(i) = math::constrain(_actuator_sp(i) - _actuator_trim(i), lower(i), upper(i));
+		}
+	}
+
+	// residual r = A^T (b - A delta) = B^T Wv^2 v - H delta (negative gradient of the cost)
+	const ActuatorVector c = _gradient_map * (_control_sp - _control_trim);
+
+	int iteration = 0;
+
+	for (; iteration < MAX_ITERATIONS; iteration++) {
+		const ActuatorVector r = c - _hessian * delta;
+
+		ActuatorVector p;
+
+		if (!solveFree(r, p)) {
+			break;
+		}
+
+		// largest step along p that stays feasible
+		float alpha = 1.f;
+		int blocking = -1;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_active_set[i] != ActiveSet::FREE) {
+				continue;
+			}
+
+			const float delta_new = delta(i) + p(i);
+
+			if (delta_new > upper(i) && p(i) > FLT_EPSILON) {
+				const float alpha_i = (upper(i) - delta(i)) / p(i);
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking = i;
+				}
+
+			} else if (delta_new < lower(i) && p(i) < -FLT_EPSILON) {
+				const float alpha_i = (lower(i) - delta(i)) / p(i);
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking = i;
+				}
+			}
+		}
+
+		if (blocking < 0) {
+			// the unconstrained optimum of the free actuators is feasible:
+			// release the bound with the most negative Lagrange multiplier, or stop if there is none
+			delta += p;
+
+			const ActuatorVector r_opt = c - _hessian * delta;
+
+			float lambda_min = -FLT_EPSILON;
+			int release = -1;
+
+			for (int i = 0; i < _num_actuators; i++) {
+				float lambda = 0.f;
+
+				if (_active_set[i] == ActiveSet::UPPER) {
+					lambda = r_opt(i);
+
+				} else if (_active_set[i] == ActiveSet::LOWER) {
+					lambda = -r_opt(i);
+				}
+
+				if (lambda < lambda_min) {
+					lambda_min = lambda;
+					release = i;
+				}
+			}
+
+			if (release < 0) {
+				iteration++;
+				break;
+			}
+
+			_active_set[release] = ActiveSet::FREE;
+
+		} else {
+			// step up to the blocking bound and add it to the active set
+			delta += p * alpha;
+
+			if (p(blocking) > 0.f) {
+				delta(blocking) = upper(blocking);
+				_active_set[blocking] = ActiveSet::UPPER;
+
+			} else {
+				delta(blocking) = lower(blocking);
+				_active_set[blocking] = ActiveSet::LOWER;
+			}
+		}
+	}
+
+	_last_iteration_count = iteration;
+
+	// every iterate is feasible, so the result is usable even if the iteration limit is reached
+	for (int i = 0; i < _num_actuators; i++) {
+		_actuator_sp(i) = _actuator_trim(i) + delta(i);
+	}
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationWeightedLeastSquares.hpp
+ *
+ * Control Allocation Algorithm solving a bounded weighted least-squares problem
+ * with an active set method:
+ *
+ *   min  ||Wv (B (u - u_trim) - v)||^2 + epsilon * ||u - u_trim||^2
+ *   s.t. u_min <= u <= u_max
+ *
+ * The small regularization term only selects the solution closest to trim
+ * out of the ones that achieve the same (weighted) control error.
+ *
+ * The active set and the solution are warm-started from the previous call and
+ * the number of iterations is limited, so the run time is bounded.
+ * All the workspace is statically sized on NUM_ACTUATORS.
+ */
+
+#pragma once
+
+#include "ControlAllocationPseudoInverse.hpp"
+
+class ControlAllocationWeightedLeastSquares: public ControlAllocationPseudoInverse
+{
+public:
+	ControlAllocationWeightedLeastSquares() = default;
+	virtual ~ControlAllocationWeightedLeastSquares() = default;
+
+	void allocate() override;
+
+	/**
+	 * Number of active set iterations used by the last allocation.
+	 */
+	int lastIterationCount() const { return _last_iteration_count; }
+
+	static constexpr int MAX_ITERATIONS = 10;
+
+private:
+	enum class ActiveSet : int8_t {
+		LOWER = -1,
+		FREE = 0,
+		UPPER = 1,
+		FIXED = 2, ///< disabled actuator (max < min), kept at trim
+	};
+
+	/**
+	 * Compute the Hessian H = B^T Wv^2 B + epsilon * I (with B in the normalized control space).
+	 */
+	void updateHessian();
+
+	/**
+	 * Solve H_ff p_f = r_f for the free actuators with a Cholesky decomposition.
+	 *
+	 * @return false if the free subproblem is not positive definite
+	 */
+	bool solveFree(const ActuatorVector &r, ActuatorVector &p);
+
+	static constexpr float REGULARIZATION = 1e-5f; ///< epsilon relative to the largest diagonal element of B^T Wv^2 B
+
+	matrix::Matrix<float, NUM_ACTUATORS, NUM_ACTUATORS> _hessian;
+	matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> _gradient_map; ///< B^T Wv^2
+
+	matrix::Matrix<float, NUM_ACTUATORS, NUM_ACTUATORS> _cholesky; ///< workspace of solveFree()
+
+	ActiveSet _active_set[NUM_ACTUATORS] {};
+
+	int _last_iteration_count{0};
+};
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlAllocationWeightedLeastSquaresTest.cpp
+ *
+ * Tests for the weighted least-squares control allocation
+ */
+
+#include <gtest/gtest.h>
+#include <ControlAllocationWeightedLeastSquares.hpp>
+
+using namespace matrix;
+
+class ControlAllocationWeightedLeastSquaresTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// quadrotor X
+		const float roll[4] {-0.5f, 0.5f, 0.5f, -0.5f};
+		const float pitch[4] {0.5f, -0.5f, 0.5f, -0.5f};
+		const float yaw[4] {0.05f, 0.05f, -0.05f, -0.05f};
+
+		for (int i = 0; i < 4; i++) {
+			_effectiveness(0, i) = roll[i];
+			_effectiveness(1, i) = pitch[i];
+			_effectiveness(2, i) = yaw[i];
+			_effectiveness(5, i) = -1.f;
+			_actuator_max(i) = 1.f;
+		}
+
+		_reference.setNormalizeRPY(true);
+		_method.setNormalizeRPY(true);
+		_reference.setActuatorMin(_actuator_min);
+		_reference.setActuatorMax(_actuator_max);
+		_method.setActuatorMin(_actuator_min);
+		_method.setActuatorMax(_actuator_max);
+
+		_reference.setEffectivenessMatrix(_effectiveness, _actuator_trim, _linearization_point, 4, true);
+		_method.setEffectivenessMatrix(_effectiveness, _actuator_trim, _linearization_point, 4, true);
+	}
+
+	Matrix<float, 6, 16> _effectiveness;
+	Vector<float, 16> _actuator_trim;
+	Vector<float, 16> _linearization_point;
+	Vector<float, 16> _actuator_min;
+	Vector<float, 16> _actuator_max;
+
+	ControlAllocationPseudoInverse _reference;
+	ControlAllocationWeightedLeastSquares _method;
+};
+
+TEST_F(ControlAllocationWeightedLeastSquaresTest, UnsaturatedMatchesPseudoInverse)
+{
+	Vector<float, 6> control_sp;
+	control_sp(0) = 0.05f;
+	control_sp(1) = -0.02f;
+	control_sp(2) = 0.02f;
+	control_sp(5) = -0.5f;
+
+	_reference.setControlSetpoint(control_sp);
+	_reference.allocate();
+	_method.setControlSetpoint(control_sp);
+	_method.allocate();
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_GT(_reference.getActuatorSetpoint()(i), 0.f);
+		EXPECT_NEAR(_method.getActuatorSetpoint()(i), _reference.getActuatorSetpoint()(i), 0.01f) << i;
+	}
+}
+
+TEST_F(ControlAllocationWeightedLeastSquaresTest, SaturatedWithinBounds)
+{
+	// full thrust with a large roll demand: roll has priority over thrust
+	Vector<float, 6> control_sp;
+	control_sp(0) = 0.5f;
+	control_sp(5) = -1.f;
+
+	_method.setControlSetpoint(control_sp);
+	_method.allocate();
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_GE(_method.getActuatorSetpoint()(i), 0.f);
+		EXPECT_LE(_method.getActuatorSetpoint()(i), 1.f);
+	}
+
+	EXPECT_LE(_method.lastIterationCount(), static_cast<int>(ControlAllocationWeightedLeastSquares::MAX_ITERATIONS));
+
+	// roll is tracked better than with the clipped pseudo inverse, thrust is reduced instead
+	_reference.setControlSetpoint(control_sp);
+	_reference.allocate();
+	_reference.clipActuatorSetpoint();
+
+	const Vector<float, 6> allocated = _method.getAllocatedControl();
+	const Vector<float, 6> allocated_clipped = _reference.getAllocatedControl();
+	EXPECT_LT(fabsf(allocated(0) - control_sp(0)), fabsf(allocated_clipped(0) - control_sp(0)));
+	EXPECT_GT(allocated(5), control_sp(5));
+
+	// warm start: the same setpoint again converges right away
+	_method.allocate();
+	EXPECT_EQ(_method.lastIterationCount(), 1);
+}
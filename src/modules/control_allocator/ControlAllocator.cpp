@@ -187,6 +187,10 @@ ControlAllocator::update_allocation_method(bool force)
 				_control_allocation[i] = new ControlAllocationSequentialDesaturation();
 				break;
 
+			case AllocationMethod::WEIGHTED_LEAST_SQUARES:
+				_control_allocation[i] = new ControlAllocationWeightedLeastSquares();
+				break;
+
 			default:
 				PX4_ERR("Unknown allocation method");
 				break;
@@ -369,6 +373,8 @@ ControlAllocator::Run()
 
 		do_update = true;
 		_timestamp_sample = vehicle_torque_setpoint.timestamp_sample;
+		_timestamp_angular_velocity = vehicle_torque_setpoint.timestamp_angular_velocity;
+		_timestamp_torque_setpoint = vehicle_torque_setpoint.timestamp;
 
 	}
 
@@ -380,6 +386,8 @@ ControlAllocator::Run()
 		if (dt > 5_ms) {
 			do_update = true;
 			_timestamp_sample = vehicle_thrust_setpoint.timestamp_sample;
+			_timestamp_angular_velocity = 0;
+			_timestamp_torque_setpoint = 0;
 		}
 	}
 
@@ -643,6 +651,8 @@ ControlAllocator::publish_actuator_controls()
 	actuator_motors_s actuator_motors;
 	actuator_motors.timestamp = hrt_absolute_time();
 	actuator_motors.timestamp_sample = _timestamp_sample;
+	actuator_motors.timestamp_angular_velocity = _timestamp_angular_velocity;
+	actuator_motors.timestamp_torque_setpoint = _timestamp_torque_setpoint;
 
 	actuator_servos_s actuator_servos;
 	actuator_servos.timestamp = actuator_motors.timestamp;
@@ -56,9 +56,11 @@
 #include <ControlAllocation.hpp>
 #include <ControlAllocationPseudoInverse.hpp>
 #include <ControlAllocationSequentialDesaturation.hpp>
+#include <ControlAllocationWeightedLeastSquares.hpp>
 
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/perf/perf_counter.h>
+#include <px4_platform_common/hot_section.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
@@ -104,7 +106,7 @@ public:
 	/** @see ModuleBase::print_status() */
 	int print_status() override;
 
-	void Run() override;
+	PX4_HOT void Run() override;
 
 	bool init();
 
@@ -198,6 +200,8 @@ private:
 	bool _armed{false};
 	hrt_abstime _last_run{0};
 	hrt_abstime _timestamp_sample{0};
+	hrt_abstime _timestamp_angular_velocity{0}; ///< latency trace of the last allocated torque setpoint
+	hrt_abstime _timestamp_torque_setpoint{0};
 	hrt_abstime _last_status_pub{0};
 
 	ParamHandles _param_handles{};
@@ -47,11 +47,17 @@
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/getopt.h>
+#include <px4_platform_common/time.h>
 #include <drivers/drv_hrt.h>
 #include <lib/parameters/param.h>
 #include <lib/perf/perf_counter.h>
 #include <stdlib.h>
 
+#if defined(__PX4_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // __PX4_POSIX
+
 #include "dataman.h"
 
 __BEGIN_DECLS
@@ -66,6 +72,7 @@ static ssize_t _file_read(dm_item_t item, unsigned index, void *buf, size_t coun
 static int  _file_clear(dm_item_t item);
 static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
+static int _file_wait(px4_sem_t *sem);
 
 /* Private Ram based Operations */
 static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_t count);
@@ -74,6 +81,15 @@ static int  _ram_clear(dm_item_t item);
 static int _ram_initialize(unsigned max_offset);
 static void _ram_shutdown();
 
+#if defined(__PX4_POSIX)
+/* Private memory mapped file Operations */
+static ssize_t _mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int  _mmap_clear(dm_item_t item);
+static int _mmap_initialize(unsigned max_offset);
+static void _mmap_shutdown();
+static int _mmap_wait(px4_sem_t *sem);
+#endif // __PX4_POSIX
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
@@ -89,7 +105,7 @@ static constexpr dm_operations_t dm_file_operations = {
 	.clear   = _file_clear,
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
-	.wait = px4_sem_wait,
+	.wait = _file_wait,
 };
 
 static constexpr dm_operations_t dm_ram_operations = {
@@ -101,6 +117,18 @@ static constexpr dm_operations_t dm_ram_operations = {
 	.wait = px4_sem_wait,
 };
 
+#if defined(__PX4_POSIX)
+/* the file is mapped in place of the RAM buffer, reads are the same as for the RAM backend */
+static constexpr dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _ram_read,
+	.clear   = _mmap_clear,
+	.initialize = _mmap_initialize,
+	.shutdown = _mmap_shutdown,
+	.wait = _mmap_wait,
+};
+#endif // __PX4_POSIX
+
 static const dm_operations_t *g_dm_ops;
 
 static struct {
@@ -112,6 +140,13 @@ static struct {
 			uint8_t *data;
 			uint8_t *data_end;
 		} ram;
+		struct {
+			uint8_t *data;		/* must match ram: the mapping is accessed through the RAM backend functions */
+			uint8_t *data_end;
+			int fd;
+			size_t size;
+			hrt_abstime dirty_since;	/* 0 if the mapping is in sync with the file */
+		} mmap;
 	};
 	bool running;
 	bool silence = false;
@@ -188,6 +223,41 @@ static px4_sem_t g_sys_state_mutex_fence;
 
 static perf_counter_t _dm_read_perf{nullptr};
 static perf_counter_t _dm_write_perf{nullptr};
+static perf_counter_t _dm_flush_perf{nullptr};
+
+static constexpr size_t max_item_size()
+{
+	size_t size = 0;
+
+	for (size_t item_size : g_per_item_size) {
+		size = (item_size > size) ? item_size : size;
+	}
+
+	return size;
+}
+
+/* Write-back cache of the file backend.
+ *
+ * Item writes are collected in the cache and committed in offset order with a single fsync, either when the
+ * cache is full, or when no item got written for DM_CACHE_FLUSH_TIMEOUT_US.
+ * Items referencing other items (mission state, fence/safe point stats and the compat item) are written through:
+ * the cache is flushed before, so everything they refer to is on the media when they are committed.
+ */
+#if defined(CONSTRAINED_MEMORY)
+static constexpr unsigned DM_CACHE_ITEMS = 8;
+#else
+static constexpr unsigned DM_CACHE_ITEMS = 32;
+#endif
+static constexpr hrt_abstime DM_CACHE_FLUSH_TIMEOUT_US = 100 * 1000;
+
+typedef struct {
+	int offset;
+	uint16_t size;
+	uint8_t data[max_item_size()];
+} dm_cache_entry_t;
+
+static dm_cache_entry_t *g_cache{nullptr};	/* nullptr if the allocation failed: write through */
+static unsigned g_cache_used{0};
 
 /* The data manager store file handle and file name */
 static const char *default_device_path = PX4_STORAGEDIR "/dataman";
@@ -197,6 +267,7 @@ static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
 	BACKEND_RAM,
+	BACKEND_MMAP,
 	BACKEND_LAST
 } backend = BACKEND_NONE;
 
@@ -425,6 +496,107 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 	return count;
 }
 
+/* write a formatted item at offset, without syncing */
+static bool
+_file_write_raw(int offset, const unsigned char *buffer, size_t count)
+{
+	for (int i = 0; i < 2; i++) {
+		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
+
+		if (ret_seek < 0) {
+			PX4_ERR("file write lseek failed %d", errno);
+			continue;
+		}
+
+		if (ret_seek != offset) {
+			PX4_ERR("file write lseek failed, incorrect offset %d vs %d", ret_seek, offset);
+			continue;
+		}
+
+		int ret_write = write(dm_operations_data.file.fd, buffer, count);
+
+		if (ret_write < 0) {
+			PX4_ERR("file write failed %d", errno);
+			continue;
+		}
+
+		if (ret_write != (ssize_t)count) {
+			PX4_ERR("file write failed, wrote %d bytes, expected %zu", ret_write, count);
+			continue;
+
+		} else {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static dm_cache_entry_t *
+_cache_find(int offset)
+{
+	for (unsigned i = 0; i < g_cache_used; i++) {
+		if (g_cache[i].offset == offset) {
+			return &g_cache[i];
+		}
+	}
+
+	return nullptr;
+}
+
+static int
+_cache_compare(const void *a, const void *b)
+{
+	return ((const dm_cache_entry_t *)a)->offset - ((const dm_cache_entry_t *)b)->offset;
+}
+
+/* commit all cached items to the file, in item order */
+static int
+_cache_flush()
+{
+	if (g_cache_used == 0) {
+		return 0;
+	}
+
+	perf_begin(_dm_flush_perf);
+
+	qsort(g_cache, g_cache_used, sizeof(dm_cache_entry_t), _cache_compare);
+
+	int result = 0;
+
+	for (unsigned i = 0; i < g_cache_used; i++) {
+		if (!_file_write_raw(g_cache[i].offset, g_cache[i].data, g_cache[i].size)) {
+			result = -1;
+		}
+	}
+
+	g_cache_used = 0;
+
+	/* Make sure data is written to physical media */
+	fsync(dm_operations_data.file.fd);
+
+	perf_end(_dm_flush_perf);
+	return result;
+}
+
+/* items other items depend on are committed immediately */
+static bool
+_is_write_through(dm_item_t item, unsigned index)
+{
+	switch (item) {
+	case DM_KEY_SAFE_POINTS:
+	case DM_KEY_FENCE_POINTS:
+		return index == 0; // mission_stats_entry_s
+
+	case DM_KEY_WAYPOINTS_OFFBOARD_0:
+	case DM_KEY_WAYPOINTS_OFFBOARD_1:
+		return false;
+
+	default:
+		return true;
+	}
+}
+
 /* write to the data manager file */
 static ssize_t
 _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
@@ -454,41 +626,29 @@ _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 		memcpy(buffer + DM_SECTOR_HDR_SIZE, buf, count);
 	}
 
-	count += DM_SECTOR_HDR_SIZE;
-
-	bool write_success = false;
-
-	for (int i = 0; i < 2; i++) {
-		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
-
-		if (ret_seek < 0) {
-			PX4_ERR("file write lseek failed %d", errno);
-			continue;
-		}
-
-		if (ret_seek != offset) {
-			PX4_ERR("file write lseek failed, incorrect offset %d vs %d", ret_seek, offset);
-			continue;
-		}
+	if ((g_cache != nullptr) && !_is_write_through(item, index)) {
+		dm_cache_entry_t *entry = _cache_find(offset);
 
-		int ret_write = write(dm_operations_data.file.fd, buffer, count);
+		if (entry == nullptr) {
+			if ((g_cache_used == DM_CACHE_ITEMS) && (_cache_flush() != 0)) {
+				return -1;
+			}
 
-		if (ret_write < 0) {
-			PX4_ERR("file write failed %d", errno);
-			continue;
+			entry = &g_cache[g_cache_used++];
+			entry->offset = offset;
 		}
 
-		if (ret_write != (ssize_t)count) {
-			PX4_ERR("file write failed, wrote %d bytes, expected %zu", ret_write, count);
-			continue;
+		entry->size = count + DM_SECTOR_HDR_SIZE;
+		memcpy(entry->data, buffer, entry->size);
+		return count;
+	}
 
-		} else {
-			write_success = true;
-			break;
-		}
+	/* everything written before has to be on the media first */
+	if (_cache_flush() != 0) {
+		return -1;
 	}
 
-	if (!write_success) {
+	if (!_file_write_raw(offset, buffer, count + DM_SECTOR_HDR_SIZE)) {
 		return -1;
 	}
 
@@ -496,7 +656,7 @@ _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 	fsync(dm_operations_data.file.fd);
 
 	/* All is well... return the number of user data written */
-	return count - DM_SECTOR_HDR_SIZE;
+	return count;
 }
 
 /* Retrieve from the data manager RAM buffer*/
@@ -564,7 +724,15 @@ _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 	int len = -1;
 	bool read_success = false;
 
-	for (int i = 0; i < 2; i++) {
+	const dm_cache_entry_t *cached = (g_cache != nullptr) ? _cache_find(offset) : nullptr;
+
+	if (cached != nullptr) {
+		memcpy(buffer, cached->data, cached->size);
+		len = cached->size;
+		read_success = true;
+	}
+
+	for (int i = 0; (i < 2) && !read_success; i++) {
 		int ret_seek = lseek(dm_operations_data.file.fd, offset, SEEK_SET);
 
 		if ((ret_seek < 0) && !dm_operations_data.silence) {
@@ -658,6 +826,18 @@ _file_clear(dm_item_t item)
 		return -1;
 	}
 
+	/* Drop the cached items of this type, they are cleared anyway */
+	const int end_offset = offset + g_per_item_max_index[item] * g_per_item_size[item];
+
+	for (unsigned c = 0; c < g_cache_used;) {
+		if ((g_cache[c].offset >= offset) && (g_cache[c].offset < end_offset)) {
+			g_cache[c] = g_cache[--g_cache_used];
+
+		} else {
+			c++;
+		}
+	}
+
 	/* Clear all items of this type */
 	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++) {
 		char buf[1];
@@ -749,6 +929,14 @@ _file_initialize(unsigned max_offset)
 	}
 
 	fsync(dm_operations_data.file.fd);
+
+	g_cache = (dm_cache_entry_t *)malloc(DM_CACHE_ITEMS * sizeof(dm_cache_entry_t));
+	g_cache_used = 0;
+
+	if (g_cache == nullptr) {
+		PX4_WARN("write-back cache allocation failed");
+	}
+
 	dm_operations_data.running = true;
 
 	return 0;
@@ -776,10 +964,49 @@ _ram_initialize(unsigned max_offset)
 static void
 _file_shutdown()
 {
+	_cache_flush();
+	free(g_cache);
+	g_cache = nullptr;
+
 	close(dm_operations_data.file.fd);
 	dm_operations_data.running = false;
 }
 
+/* wait for work at most timeout_us */
+static int
+_sem_wait_timeout(px4_sem_t *sem, hrt_abstime timeout_us)
+{
+	timespec ts{};
+#if defined(__PX4_NUTTX)
+	px4_clock_gettime(CLOCK_REALTIME, &ts);
+#else
+	px4_clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+	uint64_t nsecs = ts.tv_nsec + timeout_us * 1000;
+	ts.tv_sec += nsecs / 1000000000;
+	ts.tv_nsec = nsecs % 1000000000;
+
+	return px4_sem_timedwait(sem, &ts);
+}
+
+/* wait for work, commit the cache once the writes stop */
+static int
+_file_wait(px4_sem_t *sem)
+{
+	if (g_cache_used == 0) {
+		return px4_sem_wait(sem);
+	}
+
+	int ret = _sem_wait_timeout(sem, DM_CACHE_FLUSH_TIMEOUT_US);
+
+	if (ret != 0) {
+		// timeout (or interrupted): no new work, commit
+		_cache_flush();
+	}
+
+	return ret;
+}
+
 static void
 _ram_shutdown()
 {
@@ -787,6 +1014,161 @@ _ram_shutdown()
 	dm_operations_data.running = false;
 }
 
+#if defined(__PX4_POSIX)
+/* The memory mapped backend uses the same file layout as the file backend.
+ * Writes go to the mapping, which is written back to the file DM_MMAP_SYNC_INTERVAL_US after it got modified.
+ * The same items as for the file backend are written through.
+ */
+static constexpr hrt_abstime DM_MMAP_SYNC_INTERVAL_US = 1000 * 1000;
+
+static int
+_mmap_sync()
+{
+	if (dm_operations_data.mmap.dirty_since == 0) {
+		return 0;
+	}
+
+	perf_begin(_dm_flush_perf);
+	int ret = msync(dm_operations_data.mmap.data, dm_operations_data.mmap.size, MS_SYNC);
+	perf_end(_dm_flush_perf);
+
+	if (ret != 0) {
+		PX4_ERR("msync failed %d", errno);
+		return -1;
+	}
+
+	dm_operations_data.mmap.dirty_since = 0;
+	return 0;
+}
+
+static ssize_t
+_mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	const bool write_through = _is_write_through(item, index);
+
+	/* everything written before has to be on the media first */
+	if (write_through && (_mmap_sync() != 0)) {
+		return -1;
+	}
+
+	ssize_t ret = _ram_write(item, index, buf, count);
+
+	if (ret >= 0) {
+		if (dm_operations_data.mmap.dirty_since == 0) {
+			dm_operations_data.mmap.dirty_since = hrt_absolute_time();
+		}
+
+		if (write_through && (_mmap_sync() != 0)) {
+			return -1;
+		}
+	}
+
+	return ret;
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	int ret = _ram_clear(item);
+
+	if ((ret == 0) && (dm_operations_data.mmap.dirty_since == 0)) {
+		dm_operations_data.mmap.dirty_since = hrt_absolute_time();
+	}
+
+	return ret;
+}
+
+static int
+_mmap_initialize(unsigned max_offset)
+{
+	/* Open or create the data manager file */
+	int fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	/* the file backend does not necessarily write the last items: make sure the whole file can be mapped */
+	struct stat st {};
+
+	if ((fstat(fd, &st) != 0) || (((size_t)st.st_size < max_offset) && (ftruncate(fd, max_offset) != 0))) {
+		close(fd);
+		PX4_WARN("Could not resize data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	void *data = ::mmap(nullptr, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (data == MAP_FAILED) {
+		close(fd);
+		PX4_WARN("Could not map data manager file %s (%d)", k_data_manager_device_path, errno);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	dm_operations_data.mmap.data = (uint8_t *)data;
+	dm_operations_data.mmap.data_end = &dm_operations_data.mmap.data[max_offset - 1];
+	dm_operations_data.mmap.fd = fd;
+	dm_operations_data.mmap.size = max_offset;
+	dm_operations_data.mmap.dirty_since = 0;
+
+	/* Read the mission state and check the hash, reset the content if it does not match */
+	struct dataman_compat_s compat_state;
+	int ret = _ram_read(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
+
+	if ((ret != sizeof(compat_state)) || (compat_state.key != DM_COMPAT_KEY)) {
+		memset(dm_operations_data.mmap.data, 0, max_offset);
+
+		/* Write current compat info */
+		compat_state.key = DM_COMPAT_KEY;
+		ret = _mmap_write(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
+
+		if (ret != sizeof(compat_state)) {
+			PX4_ERR("Failed writing compat: %d", ret);
+		}
+	}
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+
+static void
+_mmap_shutdown()
+{
+	_mmap_sync();
+	munmap(dm_operations_data.mmap.data, dm_operations_data.mmap.size);
+	close(dm_operations_data.mmap.fd);
+	dm_operations_data.running = false;
+}
+
+/* wait for work, write the mapping back once it is due */
+static int
+_mmap_wait(px4_sem_t *sem)
+{
+	if (dm_operations_data.mmap.dirty_since == 0) {
+		return px4_sem_wait(sem);
+	}
+
+	const hrt_abstime sync_time = dm_operations_data.mmap.dirty_since + DM_MMAP_SYNC_INTERVAL_US;
+	const hrt_abstime now = hrt_absolute_time();
+	int ret = -1;
+
+	if (now < sync_time) {
+		ret = _sem_wait_timeout(sem, sync_time - now);
+	}
+
+	if (hrt_absolute_time() >= sync_time) {
+		_mmap_sync();
+	}
+
+	return ret;
+}
+#endif // __PX4_POSIX
+
 /** Write to the data manager file */
 __EXPORT ssize_t
 dm_write(dm_item_t item, unsigned index, const void *buf, size_t count)
@@ -950,6 +1332,13 @@ task_main(int argc, char *argv[])
 		g_dm_ops = &dm_ram_operations;
 		break;
 
+#if defined(__PX4_POSIX)
+
+	case BACKEND_MMAP:
+		g_dm_ops = &dm_mmap_operations;
+		break;
+#endif // __PX4_POSIX
+
 	default:
 		PX4_WARN("No valid backend set.");
 		return -1;
@@ -995,6 +1384,7 @@ task_main(int argc, char *argv[])
 
 	_dm_read_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": read");
 	_dm_write_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": write");
+	_dm_flush_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": flush");
 
 	int ret = g_dm_ops->initialize(max_offset);
 
@@ -1013,6 +1403,10 @@ task_main(int argc, char *argv[])
 		PX4_INFO("data manager RAM size is %u bytes", max_offset);
 		break;
 
+	case BACKEND_MMAP:
+		PX4_INFO("data manager file '%s' (mapped) size is %u bytes", k_data_manager_device_path, max_offset);
+		break;
+
 	default:
 		break;
 	}
@@ -1093,6 +1487,9 @@ end:
 	perf_free(_dm_write_perf);
 	_dm_write_perf = nullptr;
 
+	perf_free(_dm_flush_perf);
+	_dm_flush_perf = nullptr;
+
 	return 0;
 }
 
@@ -1133,6 +1530,7 @@ status()
 	PX4_INFO("Max Q lengths work %u, free %u", g_work_q.max_size, g_free_q.max_size);
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
+	perf_print_counter(_dm_flush_perf);
 }
 
 static void
@@ -1153,6 +1551,7 @@ Module to provide persistent storage for the rest of the system in form of a sim
 Multiple backends are supported:
 - a file (eg. on the SD card)
 - RAM (this is obviously not persistent)
+- a memory mapped file (POSIX only)
 
 It is used to store structured data of different types: mission waypoints, mission state and geofence polygons.
 Each type has a specific type and a fixed maximum amount of storage items, so that fast random access is possible.
@@ -1166,12 +1565,17 @@ which stores the number of items for these types. These items are always updated
 the mavlink mission manager). During that time, navigator will try to acquire the geofence item lock, fail, and will not
 check for geofence violations.
 
+With the file backend, item writes are cached and committed to the file in batches (when the cache is full or the
+writes stop for 100ms). Items other items depend on (mission state, the fence and safe point stats) are written
+through, after committing the cache.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('m', "Memory map the storage file (POSIX only)", true);
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 }
@@ -1205,10 +1609,11 @@ dataman_main(int argc, char *argv[])
 		int ch;
 		int dmoptind = 1;
 		const char *dmoptarg = nullptr;
+		bool use_mmap = false;
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:rm", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -1228,6 +1633,15 @@ dataman_main(int argc, char *argv[])
 				backend = BACKEND_RAM;
 				break;
 
+			case 'm':
+#if defined(__PX4_POSIX)
+				use_mmap = true;
+				break;
+#else
+				PX4_WARN("memory mapped backend not supported");
+				return -1;
+#endif // __PX4_POSIX
+
 			//no break
 			default:
 				usage();
@@ -1240,6 +1654,16 @@ dataman_main(int argc, char *argv[])
 			k_data_manager_device_path = strdup(default_device_path);
 		}
 
+		if (use_mmap) {
+			if (backend != BACKEND_FILE) {
+				PX4_WARN("-m and -r are mutually exclusive");
+				usage();
+				return -1;
+			}
+
+			backend = BACKEND_MMAP;
+		}
+
 		start();
 
 		if (!is_running()) {
@@ -40,8 +40,8 @@ EKFGSF_yaw::EKFGSF_yaw()
 	_ahrs_ekf_gsf_tilt_aligned = false;
 
 	// these objects are initialised in initialise() before being used internally, but can be reported for logging before then
-	memset(&_ahrs_ekf_gsf, 0, sizeof(_ahrs_ekf_gsf));
-	memset(&_ekf_gsf, 0, sizeof(_ekf_gsf));
+	memset(&_ahrs, 0, sizeof(_ahrs));
+	memset(&_ekf, 0, sizeof(_ekf));
 	_gsf_yaw = 0.0f;
 	_ahrs_accel.zero();
 }
@@ -86,9 +86,11 @@ void EKFGSF_yaw::update(const imuSample &imu_sample,
 
 	// AHRS prediction cycle for each model - this always runs
 	_ahrs_accel_fusion_gain = ahrsCalcAccelGain();
+	ahrsPredict();
 
-	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-		predictEKF(model_index);
+	// we don't start running the EKF part of the algorithm until there are regular velocity observations
+	if (_ekf_gsf_vel_fuse_started) {
+		predictEKF();
 	}
 
 	// The 3-state EKF models only run when flying to avoid corrupted estimates due to operator handling and GPS interference
@@ -99,44 +101,18 @@ void EKFGSF_yaw::update(const imuSample &imu_sample,
 
 			// Initialise to gyro bias estimate from main filter because there could be a large
 			// uncorrected rate gyro bias error about the gravity vector
-			for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-				_ahrs_ekf_gsf[model_index].gyro_bias = imu_gyro_bias;
+			for (uint8_t i = 0; i < 3; i++) {
+				for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
+					_ahrs.gyro_bias[i][model_index] = imu_gyro_bias(i);
+				}
 			}
 
 			_ekf_gsf_vel_fuse_started = true;
 
 		} else {
-			bool bad_update = false;
-
-			for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-				// subsequent measurements are fused as direct state observations
-				if (!updateEKF(model_index)) {
-					bad_update = true;
-				}
-			}
-
-			if (!bad_update) {
-				float total_weight = 0.0f;
-				// calculate weighting for each model assuming a normal distribution
-				const float min_weight = 1e-5f;
-				uint8_t n_weight_clips = 0;
-
-				for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-					_model_weights(model_index) = gaussianDensity(model_index) * _model_weights(model_index);
-
-					if (_model_weights(model_index) < min_weight) {
-						n_weight_clips++;
-						_model_weights(model_index) = min_weight;
-					}
-
-					total_weight += _model_weights(model_index);
-				}
-
-				// normalise the weighting function
-				if (n_weight_clips < N_MODELS_EKFGSF) {
-					_model_weights /= total_weight;
-
-				} else {
+			// subsequent measurements are fused as direct state observations
+			if (updateEKF()) {
+				if (!updateWeights()) {
 					// all weights have collapsed due to excessive innovation variances so reset filters
 					initialiseEKFGSF();
 				}
@@ -154,8 +130,8 @@ void EKFGSF_yaw::update(const imuSample &imu_sample,
 	Vector2f yaw_vector;
 
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-		yaw_vector(0) += _model_weights(model_index) * cosf(_ekf_gsf[model_index].X(2));
-		yaw_vector(1) += _model_weights(model_index) * sinf(_ekf_gsf[model_index].X(2));
+		yaw_vector(0) += _model_weights(model_index) * cosf(_ekf.X[2][model_index]);
+		yaw_vector(1) += _model_weights(model_index) * sinf(_ekf.X[2][model_index]);
 	}
 
 	_gsf_yaw = atan2f(yaw_vector(1), yaw_vector(0));
@@ -165,61 +141,120 @@ void EKFGSF_yaw::update(const imuSample &imu_sample,
 	_gsf_yaw_variance = 0.0f;
 
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index ++) {
-		const float yaw_delta = wrap_pi(_ekf_gsf[model_index].X(2) - _gsf_yaw);
-		_gsf_yaw_variance += _model_weights(model_index) * (_ekf_gsf[model_index].P(2, 2) + yaw_delta * yaw_delta);
+		const float yaw_delta = wrap_pi(_ekf.X[2][model_index] - _gsf_yaw);
+		_gsf_yaw_variance += _model_weights(model_index) * (_ekf.P[2][2][model_index] + yaw_delta * yaw_delta);
 	}
 
 	// prevent the same velocity data being used more than once
 	_vel_data_updated = false;
 }
 
-void EKFGSF_yaw::ahrsPredict(const uint8_t model_index)
+void EKFGSF_yaw::ahrsPredict()
 {
-	// generate attitude solution using simple complementary filter for the selected model
+	// generate attitude solution using simple complementary filter for all models
 
-	const Vector3f ang_rate = _delta_ang / fmaxf(_delta_ang_dt, 0.001f) - _ahrs_ekf_gsf[model_index].gyro_bias;
+	const Vector3f ang_rate_meas = _delta_ang / fmaxf(_delta_ang_dt, 0.001f);
+	const bool accel_correction = (_ahrs_accel_fusion_gain > 0.0f);
+	const bool centripetal_accel_correction = (_true_airspeed > FLT_EPSILON);
+	const float accel_norm_inv = accel_correction ? 1.0f / _ahrs_accel_norm : 0.0f;
+	const float gyro_bias_gain_dt = _gyro_bias_gain * _delta_ang_dt;
+	constexpr float gyro_bias_limit = 0.05f;
 
-	const Dcmf R_to_body = _ahrs_ekf_gsf[model_index].R.transpose();
-	const Vector3f gravity_direction_bf = R_to_body.col(2);
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		float R[3][3];
 
-	// Perform angular rate correction using accel data and reduce correction as accel magnitude moves away from 1 g (reduces drift when vehicle picked up and moved).
-	// During fixed wing flight, compensate for centripetal acceleration assuming coordinated turns and X axis forward
-	Vector3f tilt_correction;
+		for (uint8_t r = 0; r < 3; r++) {
+			for (uint8_t c = 0; c < 3; c++) {
+				R[r][c] = _ahrs.R[r][c][model_index];
+			}
+		}
 
-	if (_ahrs_accel_fusion_gain > 0.0f) {
+		float gyro_bias[3];
+		float ang_rate[3];
 
-		Vector3f accel = _ahrs_accel;
+		for (uint8_t i = 0; i < 3; i++) {
+			gyro_bias[i] = _ahrs.gyro_bias[i][model_index];
+			ang_rate[i] = ang_rate_meas(i) - gyro_bias[i];
+		}
 
-		if (_true_airspeed > FLT_EPSILON) {
-			// Calculate body frame centripetal acceleration with assumption X axis is aligned with the airspeed vector
-			// Use cross product of body rate and body frame airspeed vector
-			const Vector3f centripetal_accel_bf = Vector3f(0.0f, _true_airspeed * ang_rate(2), - _true_airspeed * ang_rate(1));
+		// Perform angular rate correction using accel data and reduce correction as accel magnitude moves away from 1 g (reduces drift when vehicle picked up and moved).
+		// During fixed wing flight, compensate for centripetal acceleration assuming coordinated turns and X axis forward
+		float tilt_correction[3] {};
 
-			// correct measured accel for centripetal acceleration
-			accel -= centripetal_accel_bf;
+		if (accel_correction) {
+			float accel[3] {_ahrs_accel(0), _ahrs_accel(1), _ahrs_accel(2)};
+
+			if (centripetal_accel_correction) {
+				// Calculate body frame centripetal acceleration with assumption X axis is aligned with the airspeed vector
+				// Use cross product of body rate and body frame airspeed vector and correct measured accel for it
+				accel[1] -= _true_airspeed * ang_rate[2];
+				accel[2] -= - _true_airspeed * ang_rate[1];
+			}
+
+			// cross product of the body frame gravity direction (last row of R) and accel
+			tilt_correction[0] = (R[2][1] * accel[2] - R[2][2] * accel[1]) * _ahrs_accel_fusion_gain * accel_norm_inv;
+			tilt_correction[1] = (R[2][2] * accel[0] - R[2][0] * accel[2]) * _ahrs_accel_fusion_gain * accel_norm_inv;
+			tilt_correction[2] = (R[2][0] * accel[1] - R[2][1] * accel[0]) * _ahrs_accel_fusion_gain * accel_norm_inv;
 		}
 
-		tilt_correction = (gravity_direction_bf % accel) * _ahrs_accel_fusion_gain / _ahrs_accel_norm;
+		// Gyro bias estimation
+		const float spin_rate = sqrtf(ang_rate[0] * ang_rate[0] + ang_rate[1] * ang_rate[1] + ang_rate[2] * ang_rate[2]);
 
-	}
+		if (spin_rate < 0.175f) {
+			for (uint8_t i = 0; i < 3; i++) {
+				gyro_bias[i] = math::constrain(gyro_bias[i] - tilt_correction[i] * gyro_bias_gain_dt,
+							       -gyro_bias_limit, gyro_bias_limit);
+				_ahrs.gyro_bias[i][model_index] = gyro_bias[i];
+			}
+		}
 
-	// Gyro bias estimation
-	constexpr float gyro_bias_limit = 0.05f;
-	const float spinRate = ang_rate.length();
+		// delta angle from previous to current frame
+		float g[3];
+
+		for (uint8_t i = 0; i < 3; i++) {
+			g[i] = _delta_ang(i) + (tilt_correction[i] - gyro_bias[i]) * _delta_ang_dt;
+		}
+
+		// Apply delta angle to rotation matrix
+		for (uint8_t r = 0; r < 3; r++) {
+			float row[3];
+			row[0] = R[r][0] + (R[r][1] * g[2] - R[r][2] * g[1]);
+			row[1] = R[r][1] + (R[r][2] * g[0] - R[r][0] * g[2]);
+			row[2] = R[r][2] + (R[r][0] * g[1] - R[r][1] * g[0]);
+
+			// Renormalise rows
+			const float row_length_sq = row[0] * row[0] + row[1] * row[1] + row[2] * row[2];
+
+			// Use linear approximation for inverse sqrt taking advantage of the row length being close to 1.0
+			const float row_length_inv = (row_length_sq > FLT_EPSILON) ? (1.5f - 0.5f * row_length_sq) : 1.0f;
 
-	if (spinRate < 0.175f) {
-		_ahrs_ekf_gsf[model_index].gyro_bias -= tilt_correction * (_gyro_bias_gain * _delta_ang_dt);
-		_ahrs_ekf_gsf[model_index].gyro_bias = matrix::constrain(_ahrs_ekf_gsf[model_index].gyro_bias, -gyro_bias_limit,
-						       gyro_bias_limit);
+			for (uint8_t c = 0; c < 3; c++) {
+				_ahrs.R[r][c][model_index] = row[c] * row_length_inv;
+			}
+		}
 	}
+}
 
-	// delta angle from previous to current frame
-	const Vector3f delta_angle_corrected = _delta_ang + (tilt_correction - _ahrs_ekf_gsf[model_index].gyro_bias) *
-					       _delta_ang_dt;
+Dcmf EKFGSF_yaw::ahrsRotMat(const uint8_t model_index) const
+{
+	Dcmf R;
 
-	// Apply delta angle to rotation matrix
-	_ahrs_ekf_gsf[model_index].R = ahrsPredictRotMat(_ahrs_ekf_gsf[model_index].R, delta_angle_corrected);
+	for (uint8_t r = 0; r < 3; r++) {
+		for (uint8_t c = 0; c < 3; c++) {
+			R(r, c) = _ahrs.R[r][c][model_index];
+		}
+	}
 
+	return R;
+}
+
+void EKFGSF_yaw::setAhrsRotMat(const uint8_t model_index, const Dcmf &R)
+{
+	for (uint8_t r = 0; r < 3; r++) {
+		for (uint8_t c = 0; c < 3; c++) {
+			_ahrs.R[r][c][model_index] = R(r, c);
+		}
+	}
 }
 
 void EKFGSF_yaw::ahrsAlignTilt()
@@ -250,7 +285,7 @@ void EKFGSF_yaw::ahrsAlignTilt()
 	R.setRow(2, down_in_bf);
 
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-		_ahrs_ekf_gsf[model_index].R = R;
+		setAhrsRotMat(model_index, R);
 	}
 }
 
@@ -258,208 +293,214 @@ void EKFGSF_yaw::ahrsAlignYaw()
 {
 	// Align yaw angle for each model
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-		Dcmf &R = _ahrs_ekf_gsf[model_index].R;
-		const float yaw = wrap_pi(_ekf_gsf[model_index].X(2));
-		R = updateYawInRotMat(yaw, R);
-
-		_ahrs_ekf_gsf[model_index].aligned = true;
+		const float yaw = wrap_pi(_ekf.X[2][model_index]);
+		setAhrsRotMat(model_index, updateYawInRotMat(yaw, ahrsRotMat(model_index)));
 	}
 }
 
-void EKFGSF_yaw::predictEKF(const uint8_t model_index)
+void EKFGSF_yaw::predictEKF()
 {
-	// generate an attitude reference using IMU data
-	ahrsPredict(model_index);
-
-	// we don't start running the EKF part of the algorithm until there are regular velocity observations
-	if (!_ekf_gsf_vel_fuse_started) {
-		return;
-	}
-
-	// Calculate the yaw state using a projection onto the horizontal that avoids gimbal lock
-	_ekf_gsf[model_index].X(2) = getEulerYaw(_ahrs_ekf_gsf[model_index].R);
-
-	// calculate delta velocity in a horizontal front-right frame
-	const Vector3f del_vel_NED = _ahrs_ekf_gsf[model_index].R * _delta_vel;
-	const float cos_yaw = cosf(_ekf_gsf[model_index].X(2));
-	const float sin_yaw = sinf(_ekf_gsf[model_index].X(2));
-	const float dvx =   del_vel_NED(0) * cos_yaw + del_vel_NED(1) * sin_yaw;
-	const float dvy = - del_vel_NED(0) * sin_yaw + del_vel_NED(1) * cos_yaw;
-
-	// sum delta velocities in earth frame:
-	_ekf_gsf[model_index].X(0) += del_vel_NED(0);
-	_ekf_gsf[model_index].X(1) += del_vel_NED(1);
-
-	// predict covariance - equations generated using EKF/python/gsf_ekf_yaw_estimator/main.py
-
-	// Local short variable name copies required for readability
-	const float P00 = _ekf_gsf[model_index].P(0,0);
-	const float P01 = _ekf_gsf[model_index].P(0,1);
-	const float P02 = _ekf_gsf[model_index].P(0,2);
-	const float P11 = _ekf_gsf[model_index].P(1,1);
-	const float P12 = _ekf_gsf[model_index].P(1,2);
-	const float P22 = _ekf_gsf[model_index].P(2,2);
-	const float psi = _ekf_gsf[model_index].X(2);
-
 	// Use fixed values for delta velocity and delta angle process noise variances
 	const float dvxVar = sq(_accel_noise * _delta_vel_dt); // variance of forward delta velocity - (m/s)^2
 	const float dvyVar = dvxVar; // variance of right delta velocity - (m/s)^2
 	const float dazVar = sq(_gyro_noise * _delta_ang_dt); // variance of yaw delta angle - rad^2
 
-	// optimized auto generated code from SymPy script src/lib/ecl/EKF/python/ekf_derivation/main.py
-	const float S0 = cosf(psi);
-	const float S1 = ecl::powf(S0, 2);
-	const float S2 = sinf(psi);
-	const float S3 = ecl::powf(S2, 2);
-	const float S4 = S0*dvy + S2*dvx;
-	const float S5 = P02 - P22*S4;
-	const float S6 = S0*dvx - S2*dvy;
-	const float S7 = S0*S2;
-	const float S8 = P01 + S7*dvxVar - S7*dvyVar;
-	const float S9 = P12 + P22*S6;
-
-	_ekf_gsf[model_index].P(0,0) = P00 - P02*S4 + S1*dvxVar + S3*dvyVar - S4*S5;
-	_ekf_gsf[model_index].P(0,1) = -P12*S4 + S5*S6 + S8;
-	_ekf_gsf[model_index].P(1,1) = P11 + P12*S6 + S1*dvyVar + S3*dvxVar + S6*S9;
-	_ekf_gsf[model_index].P(0,2) = S5;
-	_ekf_gsf[model_index].P(1,2) = S9;
-	_ekf_gsf[model_index].P(2,2) = P22 + dazVar;
-
-	// covariance matrix is symmetrical, so copy upper half to lower half
-	_ekf_gsf[model_index].P(1,0) = _ekf_gsf[model_index].P(0,1);
-	_ekf_gsf[model_index].P(2,0) = _ekf_gsf[model_index].P(0,2);
-	_ekf_gsf[model_index].P(2,1) = _ekf_gsf[model_index].P(1,2);
-
-	// constrain variances
-	const float min_var = 1e-6f;
-
-	for (unsigned index = 0; index < 3; index++) {
-		_ekf_gsf[model_index].P(index, index) = fmaxf(_ekf_gsf[model_index].P(index, index), min_var);
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		const float R00 = _ahrs.R[0][0][model_index];
+		const float R01 = _ahrs.R[0][1][model_index];
+		const float R10 = _ahrs.R[1][0][model_index];
+		const float R11 = _ahrs.R[1][1][model_index];
+
+		// Calculate the yaw state using a projection onto the horizontal that avoids gimbal lock (see getEulerYaw())
+		const float psi = (fabsf(_ahrs.R[2][0][model_index]) < fabsf(_ahrs.R[2][1][model_index]))
+				  ? atan2f(R10, R00) : atan2f(-R01, R11);
+		_ekf.X[2][model_index] = psi;
+
+		// calculate delta velocity in a horizontal front-right frame
+		const float del_vel_N = R00 * _delta_vel(0) + R01 * _delta_vel(1) + _ahrs.R[0][2][model_index] * _delta_vel(2);
+		const float del_vel_E = R10 * _delta_vel(0) + R11 * _delta_vel(1) + _ahrs.R[1][2][model_index] * _delta_vel(2);
+		const float cos_yaw = cosf(psi);
+		const float sin_yaw = sinf(psi);
+		const float dvx =   del_vel_N * cos_yaw + del_vel_E * sin_yaw;
+		const float dvy = - del_vel_N * sin_yaw + del_vel_E * cos_yaw;
+
+		// sum delta velocities in earth frame:
+		_ekf.X[0][model_index] += del_vel_N;
+		_ekf.X[1][model_index] += del_vel_E;
+
+		// predict covariance - equations generated using EKF/python/gsf_ekf_yaw_estimator/main.py
+
+		// Local short variable name copies required for readability
+		const float P00 = _ekf.P[0][0][model_index];
+		const float P01 = _ekf.P[0][1][model_index];
+		const float P02 = _ekf.P[0][2][model_index];
+		const float P11 = _ekf.P[1][1][model_index];
+		const float P12 = _ekf.P[1][2][model_index];
+		const float P22 = _ekf.P[2][2][model_index];
+
+		// optimized auto generated code from SymPy script src/lib/ecl/EKF/python/ekf_derivation/main.py
+		const float S0 = cos_yaw;
+		const float S1 = ecl::powf(S0, 2);
+		const float S2 = sin_yaw;
+		const float S3 = ecl::powf(S2, 2);
+		const float S4 = S0*dvy + S2*dvx;
+		const float S5 = P02 - P22*S4;
+		const float S6 = S0*dvx - S2*dvy;
+		const float S7 = S0*S2;
+		const float S8 = P01 + S7*dvxVar - S7*dvyVar;
+		const float S9 = P12 + P22*S6;
+
+		// constrain variances
+		const float min_var = 1e-6f;
+
+		const float P01_new = -P12*S4 + S5*S6 + S8;
+
+		_ekf.P[0][0][model_index] = fmaxf(P00 - P02*S4 + S1*dvxVar + S3*dvyVar - S4*S5, min_var);
+		_ekf.P[1][1][model_index] = fmaxf(P11 + P12*S6 + S1*dvyVar + S3*dvxVar + S6*S9, min_var);
+		_ekf.P[2][2][model_index] = fmaxf(P22 + dazVar, min_var);
+
+		// covariance matrix is symmetrical, so copy upper half to lower half
+		_ekf.P[0][1][model_index] = P01_new;
+		_ekf.P[0][2][model_index] = S5;
+		_ekf.P[1][2][model_index] = S9;
+		_ekf.P[1][0][model_index] = P01_new;
+		_ekf.P[2][0][model_index] = S5;
+		_ekf.P[2][1][model_index] = S9;
 	}
 }
 
-// Update EKF states and covariance for specified model index using velocity measurement
-bool EKFGSF_yaw::updateEKF(const uint8_t model_index)
+// Update EKF states and covariance of all models using velocity measurement
+bool EKFGSF_yaw::updateEKF()
 {
 	// set observation variance from accuracy estimate supplied by GPS and apply a sanity check minimum
 	const float velObsVar = sq(fmaxf(_vel_accuracy, 0.01f));
 
-	// calculate velocity observation innovations
-	_ekf_gsf[model_index].innov(0) = _ekf_gsf[model_index].X(0) - _vel_NE(0);
-	_ekf_gsf[model_index].innov(1) = _ekf_gsf[model_index].X(1) - _vel_NE(1);
-
-	// Use temporary variables for covariance elements to reduce verbosity of auto-code expressions
-	const float P00 = _ekf_gsf[model_index].P(0,0);
-	const float P01 = _ekf_gsf[model_index].P(0,1);
-	const float P02 = _ekf_gsf[model_index].P(0,2);
-	const float P11 = _ekf_gsf[model_index].P(1,1);
-	const float P12 = _ekf_gsf[model_index].P(1,2);
-	const float P22 = _ekf_gsf[model_index].P(2,2);
-
-	// optimized auto generated code from SymPy script src/lib/ecl/EKF/python/ekf_derivation/main.py
-	const float t0 = ecl::powf(P01, 2);
-	const float t1 = -t0;
-	const float t2 = P00*P11 + P00*velObsVar + P11*velObsVar + t1 + ecl::powf(velObsVar, 2);
-	if (fabsf(t2) < 1e-6f) {
-		return false;
-	}
-	const float t3 = 1.0F/t2;
-	const float t4 = P11 + velObsVar;
-	const float t5 = P01*t3;
-	const float t6 = -t5;
-	const float t7 = P00 + velObsVar;
-	const float t8 = P00*t4 + t1;
-	const float t9 = t5*velObsVar;
-	const float t10 = P11*t7;
-	const float t11 = t1 + t10;
-	const float t12 = P01*P12;
-	const float t13 = P02*t4;
-	const float t14 = P01*P02;
-	const float t15 = P12*t7;
-	const float t16 = t0*velObsVar;
-	const float t17 = ecl::powf(t2, -2);
-	const float t18 = t4*velObsVar + t8;
-	const float t19 = t17*t18;
-	const float t20 = t17*(t16 + t7*t8);
-	const float t21 = t0 - t10;
-	const float t22 = t17*t21;
-	const float t23 = t14 - t15;
-	const float t24 = P01*t23;
-	const float t25 = t12 - t13;
-	const float t26 = t16 - t21*t4;
-	const float t27 = t17*t26;
-	const float t28 = t11 + t7*velObsVar;
-	const float t30 = t17*t28;
-	const float t31 = P01*t25;
-	const float t32 = t23*t4 + t31;
-	const float t33 = t17*t32;
-	const float t35 = t24 + t25*t7;
-	const float t36 = t17*t35;
-
-	_ekf_gsf[model_index].S_det_inverse = t3;
-
-	_ekf_gsf[model_index].S_inverse(0,0) = t3*t4;
-	_ekf_gsf[model_index].S_inverse(0,1) = t6;
-	_ekf_gsf[model_index].S_inverse(1,1) = t3*t7;
-	_ekf_gsf[model_index].S_inverse(1,0) = _ekf_gsf[model_index].S_inverse(0,1);
-
-	matrix::Matrix<float, 3, 2> K;
-	K(0,0) = t3*t8;
-	K(1,0) = t9;
-	K(2,0) = t3*(-t12 + t13);
-	K(0,1) = t9;
-	K(1,1) = t11*t3;
-	K(2,1) = t3*(-t14 + t15);
-
-	_ekf_gsf[model_index].P(0,0) = P00 - t16*t19 - t20*t8;
-	_ekf_gsf[model_index].P(0,1) = P01*(t18*t22 - t20*velObsVar + 1);
-	_ekf_gsf[model_index].P(1,1) = P11 - t16*t30 + t22*t26;
-	_ekf_gsf[model_index].P(0,2) = P02 + t19*t24 + t20*t25;
-	_ekf_gsf[model_index].P(1,2) = P12 + t23*t27 + t30*t31;
-	_ekf_gsf[model_index].P(2,2) = P22 - t23*t33 - t25*t36;
-	_ekf_gsf[model_index].P(1,0) = _ekf_gsf[model_index].P(0,1);
-	_ekf_gsf[model_index].P(2,0) = _ekf_gsf[model_index].P(0,2);
-	_ekf_gsf[model_index].P(2,1) = _ekf_gsf[model_index].P(1,2);
-
-	// constrain variances
-	const float min_var = 1e-6f;
-
-	for (unsigned index = 0; index < 3; index++) {
-		_ekf_gsf[model_index].P(index, index) = fmaxf(_ekf_gsf[model_index].P(index, index), min_var);
-	}
-
-	// test ratio = transpose(innovation) * inverse(innovation variance) * innovation = [1x2] * [2,2] * [2,1] = [1,1]
-	const float test_ratio = _ekf_gsf[model_index].innov * (_ekf_gsf[model_index].S_inverse * _ekf_gsf[model_index].innov);
-
-	// Perform a chi-square innovation consistency test and calculate a compression scale factor
-	// that limits the magnitude of innovations to 5-sigma
-	// If the test ratio is greater than 25 (5 Sigma) then reduce the length of the innovation vector to clip it at 5-Sigma
-	// This protects from large measurement spikes
-	const float innov_comp_scale_factor = test_ratio > 25.f ? sqrtf(25.0f / test_ratio) : 1.f;
-
-	// Correct the state vector and capture the change in yaw angle
-	const float oldYaw = _ekf_gsf[model_index].X(2);
-
-	_ekf_gsf[model_index].X -= (K * _ekf_gsf[model_index].innov) * innov_comp_scale_factor;
-
-	const float yawDelta = _ekf_gsf[model_index].X(2) - oldYaw;
-
-	// apply the change in yaw angle to the AHRS
-	// take advantage of sparseness in the yaw rotation matrix
-	const float cosYaw = cosf(yawDelta);
-	const float sinYaw = sinf(yawDelta);
-	const float R_prev00 = _ahrs_ekf_gsf[model_index].R(0, 0);
-	const float R_prev01 = _ahrs_ekf_gsf[model_index].R(0, 1);
-	const float R_prev02 = _ahrs_ekf_gsf[model_index].R(0, 2);
+	bool update_ok = true;
 
-	_ahrs_ekf_gsf[model_index].R(0, 0) = R_prev00 * cosYaw - _ahrs_ekf_gsf[model_index].R(1, 0) * sinYaw;
-	_ahrs_ekf_gsf[model_index].R(0, 1) = R_prev01 * cosYaw - _ahrs_ekf_gsf[model_index].R(1, 1) * sinYaw;
-	_ahrs_ekf_gsf[model_index].R(0, 2) = R_prev02 * cosYaw - _ahrs_ekf_gsf[model_index].R(1, 2) * sinYaw;
-	_ahrs_ekf_gsf[model_index].R(1, 0) = R_prev00 * sinYaw + _ahrs_ekf_gsf[model_index].R(1, 0) * cosYaw;
-	_ahrs_ekf_gsf[model_index].R(1, 1) = R_prev01 * sinYaw + _ahrs_ekf_gsf[model_index].R(1, 1) * cosYaw;
-	_ahrs_ekf_gsf[model_index].R(1, 2) = R_prev02 * sinYaw + _ahrs_ekf_gsf[model_index].R(1, 2) * cosYaw;
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		// calculate velocity observation innovations
+		const float innov0 = _ekf.X[0][model_index] - _vel_NE(0);
+		const float innov1 = _ekf.X[1][model_index] - _vel_NE(1);
+		_ekf.innov[0][model_index] = innov0;
+		_ekf.innov[1][model_index] = innov1;
+
+		// Use temporary variables for covariance elements to reduce verbosity of auto-code expressions
+		const float P00 = _ekf.P[0][0][model_index];
+		const float P01 = _ekf.P[0][1][model_index];
+		const float P02 = _ekf.P[0][2][model_index];
+		const float P11 = _ekf.P[1][1][model_index];
+		const float P12 = _ekf.P[1][2][model_index];
+		const float P22 = _ekf.P[2][2][model_index];
+
+		// optimized auto generated code from SymPy script src/lib/ecl/EKF/python/ekf_derivation/main.py
+		const float t0 = ecl::powf(P01, 2);
+		const float t1 = -t0;
+		const float t2 = P00*P11 + P00*velObsVar + P11*velObsVar + t1 + ecl::powf(velObsVar, 2);
+		if (fabsf(t2) < 1e-6f) {
+			update_ok = false;
+			continue;
+		}
+		const float t3 = 1.0F/t2;
+		const float t4 = P11 + velObsVar;
+		const float t5 = P01*t3;
+		const float t6 = -t5;
+		const float t7 = P00 + velObsVar;
+		const float t8 = P00*t4 + t1;
+		const float t9 = t5*velObsVar;
+		const float t10 = P11*t7;
+		const float t11 = t1 + t10;
+		const float t12 = P01*P12;
+		const float t13 = P02*t4;
+		const float t14 = P01*P02;
+		const float t15 = P12*t7;
+		const float t16 = t0*velObsVar;
+		const float t17 = ecl::powf(t2, -2);
+		const float t18 = t4*velObsVar + t8;
+		const float t19 = t17*t18;
+		const float t20 = t17*(t16 + t7*t8);
+		const float t21 = t0 - t10;
+		const float t22 = t17*t21;
+		const float t23 = t14 - t15;
+		const float t24 = P01*t23;
+		const float t25 = t12 - t13;
+		const float t26 = t16 - t21*t4;
+		const float t27 = t17*t26;
+		const float t28 = t11 + t7*velObsVar;
+		const float t30 = t17*t28;
+		const float t31 = P01*t25;
+		const float t32 = t23*t4 + t31;
+		const float t33 = t17*t32;
+		const float t35 = t24 + t25*t7;
+		const float t36 = t17*t35;
+
+		_ekf.S_det_inverse[model_index] = t3;
+
+		const float S_inverse00 = t3*t4;
+		const float S_inverse01 = t6;
+		const float S_inverse11 = t3*t7;
+		_ekf.S_inverse[0][0][model_index] = S_inverse00;
+		_ekf.S_inverse[0][1][model_index] = S_inverse01;
+		_ekf.S_inverse[1][0][model_index] = S_inverse01;
+		_ekf.S_inverse[1][1][model_index] = S_inverse11;
+
+		const float K00 = t3*t8;
+		const float K10 = t9;
+		const float K20 = t3*(-t12 + t13);
+		const float K01 = t9;
+		const float K11 = t11*t3;
+		const float K21 = t3*(-t14 + t15);
+
+		// constrain variances
+		const float min_var = 1e-6f;
+
+		const float P01_new = P01*(t18*t22 - t20*velObsVar + 1);
+		const float P02_new = P02 + t19*t24 + t20*t25;
+		const float P12_new = P12 + t23*t27 + t30*t31;
+
+		_ekf.P[0][0][model_index] = fmaxf(P00 - t16*t19 - t20*t8, min_var);
+		_ekf.P[1][1][model_index] = fmaxf(P11 - t16*t30 + t22*t26, min_var);
+		_ekf.P[2][2][model_index] = fmaxf(P22 - t23*t33 - t25*t36, min_var);
+		_ekf.P[0][1][model_index] = P01_new;
+		_ekf.P[0][2][model_index] = P02_new;
+		_ekf.P[1][2][model_index] = P12_new;
+		_ekf.P[1][0][model_index] = P01_new;
+		_ekf.P[2][0][model_index] = P02_new;
+		_ekf.P[2][1][model_index] = P12_new;
+
+		// test ratio = transpose(innovation) * inverse(innovation variance) * innovation = [1x2] * [2,2] * [2,1] = [1,1]
+		const float test_ratio = innov0 * (S_inverse00 * innov0 + S_inverse01 * innov1)
+					 + innov1 * (S_inverse01 * innov0 + S_inverse11 * innov1);
+
+		// Perform a chi-square innovation consistency test and calculate a compression scale factor
+		// that limits the magnitude of innovations to 5-sigma
+		// If the test ratio is greater than 25 (5 Sigma) then reduce the length of the innovation vector to clip it at 5-Sigma
+		// This protects from large measurement spikes
+		const float innov_comp_scale_factor = test_ratio > 25.f ? sqrtf(25.0f / test_ratio) : 1.f;
+
+		// Correct the state vector and capture the change in yaw angle
+		_ekf.X[0][model_index] -= (K00 * innov0 + K01 * innov1) * innov_comp_scale_factor;
+		_ekf.X[1][model_index] -= (K10 * innov0 + K11 * innov1) * innov_comp_scale_factor;
+
+		const float oldYaw = _ekf.X[2][model_index];
+		_ekf.X[2][model_index] -= (K20 * innov0 + K21 * innov1) * innov_comp_scale_factor;
+
+		const float yawDelta = _ekf.X[2][model_index] - oldYaw;
+
+		// apply the change in yaw angle to the AHRS
+		// take advantage of sparseness in the yaw rotation matrix
+		const float cosYaw = cosf(yawDelta);
+		const float sinYaw = sinf(yawDelta);
+
+		for (uint8_t c = 0; c < 3; c++) {
+			const float R_prev0 = _ahrs.R[0][c][model_index];
+			const float R_prev1 = _ahrs.R[1][c][model_index];
+
+			_ahrs.R[0][c][model_index] = R_prev0 * cosYaw - R_prev1 * sinYaw;
+			_ahrs.R[1][c][model_index] = R_prev0 * sinYaw + R_prev1 * cosYaw;
+		}
+	}
 
-	return true;
+	return update_ok;
 }
 
 void EKFGSF_yaw::initialiseEKFGSF()
@@ -469,30 +510,57 @@ void EKFGSF_yaw::initialiseEKFGSF()
 	_gsf_yaw_variance = _m_pi2 * _m_pi2;
 	_model_weights.setAll(1.0f / (float)N_MODELS_EKFGSF);  // All filter models start with the same weight
 
-	memset(&_ekf_gsf, 0, sizeof(_ekf_gsf));
+	memset(&_ekf, 0, sizeof(_ekf));
 	const float yaw_increment = 2.0f * _m_pi / (float)N_MODELS_EKFGSF;
 
 	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
 		// evenly space initial yaw estimates in the region between +-Pi
-		_ekf_gsf[model_index].X(2) = -_m_pi + (0.5f * yaw_increment) + ((float)model_index * yaw_increment);
+		_ekf.X[2][model_index] = -_m_pi + (0.5f * yaw_increment) + ((float)model_index * yaw_increment);
 
 		// take velocity states and corresponding variance from last measurement
-		_ekf_gsf[model_index].X(0) = _vel_NE(0);
-		_ekf_gsf[model_index].X(1) = _vel_NE(1);
-		_ekf_gsf[model_index].P(0, 0) = sq(_vel_accuracy);
-		_ekf_gsf[model_index].P(1, 1) = _ekf_gsf[model_index].P(0, 0);
+		_ekf.X[0][model_index] = _vel_NE(0);
+		_ekf.X[1][model_index] = _vel_NE(1);
+		_ekf.P[0][0][model_index] = sq(_vel_accuracy);
+		_ekf.P[1][1][model_index] = _ekf.P[0][0][model_index];
 
 		// use half yaw interval for yaw uncertainty
-		_ekf_gsf[model_index].P(2, 2) = sq(0.5f * yaw_increment);
+		_ekf.P[2][2][model_index] = sq(0.5f * yaw_increment);
 	}
 }
 
-float EKFGSF_yaw::gaussianDensity(const uint8_t model_index) const
+bool EKFGSF_yaw::updateWeights()
 {
-	// calculate transpose(innovation) * inv(S) * innovation
-	const float normDist = _ekf_gsf[model_index].innov.dot(_ekf_gsf[model_index].S_inverse * _ekf_gsf[model_index].innov);
+	// calculate weighting for each model assuming a normal distribution
+	const float min_weight = 1e-5f;
+	float total_weight = 0.0f;
+	uint8_t n_weight_clips = 0;
+
+	for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+		// calculate transpose(innovation) * inv(S) * innovation
+		const float innov0 = _ekf.innov[0][model_index];
+		const float innov1 = _ekf.innov[1][model_index];
+		const float normDist = innov0 * (_ekf.S_inverse[0][0][model_index] * innov0 + _ekf.S_inverse[0][1][model_index] * innov1)
+				       + innov1 * (_ekf.S_inverse[1][0][model_index] * innov0 + _ekf.S_inverse[1][1][model_index] * innov1);
+
+		const float density = _m_2pi_inv * sqrtf(_ekf.S_det_inverse[model_index]) * expf(-0.5f * normDist);
+		float weight = density * _model_weights(model_index);
+
+		if (weight < min_weight) {
+			n_weight_clips++;
+			weight = min_weight;
+		}
+
+		_model_weights(model_index) = weight;
+		total_weight += weight;
+	}
+
+	// normalise the weighting function
+	if (n_weight_clips < N_MODELS_EKFGSF) {
+		_model_weights /= total_weight;
+		return true;
+	}
 
-	return _m_2pi_inv * sqrtf(_ekf_gsf[model_index].S_det_inverse) * expf(-0.5f * normDist);
+	return false;
 }
 
 bool EKFGSF_yaw::getLogData(float *yaw_composite, float *yaw_variance, float yaw[N_MODELS_EKFGSF],
@@ -503,9 +571,9 @@ bool EKFGSF_yaw::getLogData(float *yaw_composite, float *yaw_variance, float yaw
 		*yaw_variance = _gsf_yaw_variance;
 
 		for (uint8_t model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
-			yaw[model_index] = _ekf_gsf[model_index].X(2);
-			innov_VN[model_index] = _ekf_gsf[model_index].innov(0);
-			innov_VE[model_index] = _ekf_gsf[model_index].innov(1);
+			yaw[model_index] = _ekf.X[2][model_index];
+			innov_VN[model_index] = _ekf.innov[0][model_index];
+			innov_VE[model_index] = _ekf.innov[1][model_index];
 			weight[model_index] = _model_weights(model_index);
 		}
 
@@ -535,33 +603,6 @@ float EKFGSF_yaw::ahrsCalcAccelGain() const
 	return _tilt_gain * sq(1.f - math::min(attenuation * fabsf(delta_accel_g), 1.f));
 }
 
-Matrix3f EKFGSF_yaw::ahrsPredictRotMat(const Matrix3f &R, const Vector3f &g)
-{
-	Matrix3f ret = R;
-	ret(0,0) += R(0,1) * g(2) - R(0,2) * g(1);
-	ret(0,1) += R(0,2) * g(0) - R(0,0) * g(2);
-	ret(0,2) += R(0,0) * g(1) - R(0,1) * g(0);
-	ret(1,0) += R(1,1) * g(2) - R(1,2) * g(1);
-	ret(1,1) += R(1,2) * g(0) - R(1,0) * g(2);
-	ret(1,2) += R(1,0) * g(1) - R(1,1) * g(0);
-	ret(2,0) += R(2,1) * g(2) - R(2,2) * g(1);
-	ret(2,1) += R(2,2) * g(0) - R(2,0) * g(2);
-	ret(2,2) += R(2,0) * g(1) - R(2,1) * g(0);
-
-	// Renormalise rows
-	for (uint8_t r = 0; r < 3; r++) {
-		const float rowLengthSq = ret.row(r).norm_squared();
-
-		if (rowLengthSq > FLT_EPSILON) {
-			// Use linear approximation for inverse sqrt taking advantage of the row length being close to 1.0
-			const float rowLengthInv = 1.5f - 0.5f * rowLengthSq;
-			ret.row(r) *=  rowLengthInv;
-		}
-	}
-
-	return ret;
-}
-
 void EKFGSF_yaw::setVelocity(const Vector2f &velocity, float accuracy)
 {
 	_vel_NE = velocity;
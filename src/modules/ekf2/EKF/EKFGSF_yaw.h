@@ -50,7 +50,13 @@ using matrix::Vector2f;
 using matrix::Vector3f;
 using matrix::wrap_pi;
 
+#if defined(CONFIG_EKF2_GSF_N_MODELS)
+static constexpr uint8_t N_MODELS_EKFGSF = CONFIG_EKF2_GSF_N_MODELS;
+#else
 static constexpr uint8_t N_MODELS_EKFGSF = 5;
+#endif
+
+static_assert(N_MODELS_EKFGSF >= 3, "at least 3 yaw models are required");
 
 // Required math constants
 static constexpr float _m_2pi_inv = 0.159154943f;
@@ -101,14 +107,12 @@ private:
 	float _delta_vel_dt{};	// _delta_vel integration time interval (sec)
 	float _true_airspeed{};	// true airspeed used for centripetal accel compensation (m/s)
 
-	struct _ahrs_ekf_gsf_struct {
-		Dcmf R;			// matrix that rotates a vector from body to earth frame
-		Vector3f gyro_bias;	// gyro bias learned and used by the quaternion calculation
-		bool aligned;		// true when AHRS has been aligned
-		float vel_NE[2];	// NE velocity vector from last GPS measurement (m/s)
-		bool fuse_gps;		// true when GPS should be fused on that frame
-		float accel_dt;		// time step used when generating _simple_accel_FR data (sec)
-	} _ahrs_ekf_gsf[N_MODELS_EKFGSF] {};
+	// The model states are stored as struct of arrays (one array element per model) and every
+	// processing step loops over all models, so the compiler can update several models at once.
+	struct {
+		float R[3][3][N_MODELS_EKFGSF];		// matrix that rotates a vector from body to earth frame
+		float gyro_bias[3][N_MODELS_EKFGSF];	// gyro bias learned and used by the quaternion calculation
+	} _ahrs {};
 
 	bool _ahrs_ekf_gsf_tilt_aligned{};	// true the initial tilt alignment has been calculated
 	float _ahrs_accel_fusion_gain{};	// gain from accel vector tilt error to rate gyro correction used by AHRS calculation
@@ -118,8 +122,8 @@ private:
 	// calculate the gain from gravity vector misalingment to tilt correction to be used by all AHRS filters
 	float ahrsCalcAccelGain() const;
 
-	// update specified AHRS rotation matrix using IMU and optionally true airspeed data
-	void ahrsPredict(const uint8_t model_index);
+	// update all AHRS rotation matrices using IMU and optionally true airspeed data
+	void ahrsPredict();
 
 	// align all AHRS roll and pitch orientations using IMU delta velocity vector
 	void ahrsAlignTilt();
@@ -127,18 +131,18 @@ private:
 	// align all AHRS yaw orientations to initial values
 	void ahrsAlignYaw();
 
-	// Efficient propagation of a delta angle in body frame applied to the body to earth frame rotation matrix
-	Matrix3f ahrsPredictRotMat(const Matrix3f &R, const Vector3f &g);
+	Dcmf ahrsRotMat(const uint8_t model_index) const;
+	void setAhrsRotMat(const uint8_t model_index, const Dcmf &R);
 
 	// Declarations used by a bank of N_MODELS_EKFGSF EKFs
 
-	struct _ekf_gsf_struct {
-		matrix::Vector3f X; 				// Vel North (m/s),  Vel East (m/s), yaw (rad)s
-		matrix::SquareMatrix<float, 3> P; 		// covariance matrix
-		matrix::SquareMatrix<float, 2> S_inverse;	// inverse of the innovation covariance matrix
-		float S_det_inverse; 				// inverse of the innovation covariance matrix determinant
-		matrix::Vector2f innov; 			// Velocity N,E innovation (m/s)
-	} _ekf_gsf[N_MODELS_EKFGSF] {};
+	struct {
+		float X[3][N_MODELS_EKFGSF]; 		// Vel North (m/s),  Vel East (m/s), yaw (rad)s
+		float P[3][3][N_MODELS_EKFGSF]; 	// covariance matrix
+		float S_inverse[2][2][N_MODELS_EKFGSF];	// inverse of the innovation covariance matrix
+		float S_det_inverse[N_MODELS_EKFGSF]; 	// inverse of the innovation covariance matrix determinant
+		float innov[2][N_MODELS_EKFGSF]; 	// Velocity N,E innovation (m/s)
+	} _ekf {};
 
 	bool _vel_data_updated{};	// true when velocity data has been updated
 	Vector2f _vel_NE{};        // NE velocity observations (m/s)
@@ -148,12 +152,12 @@ private:
 	// initialise states and covariance data for the GSF and EKF filters
 	void initialiseEKFGSF();
 
-	// predict state and covariance for the specified EKF using inertial data
-	void predictEKF(const uint8_t model_index);
+	// predict state and covariance of all EKFs using inertial data
+	void predictEKF();
 
-	// update state and covariance for the specified EKF using a NE velocity measurement
-	// return false if update failed
-	bool updateEKF(const uint8_t model_index);
+	// update state and covariance of all EKFs using a NE velocity measurement
+	// return false if the update failed for any of them
+	bool updateEKF();
 
 	inline float sq(float x) const { return x * x; };
 
@@ -163,7 +167,8 @@ private:
 	float _gsf_yaw{}; 		// yaw estimate (rad)
 	float _gsf_yaw_variance{}; 	// variance of yaw estimate (rad^2)
 
-	// return the probability of the state estimate for the specified EKF assuming a gaussian error distribution
-	float gaussianDensity(const uint8_t model_index) const;
+	// update the model weights with the probability of the state estimate of each EKF assuming a gaussian error distribution
+	// return false if all weights have collapsed
+	bool updateWeights();
 };
 #endif // !EKF_EKFGSF_YAW_H
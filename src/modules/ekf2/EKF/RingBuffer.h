@@ -66,14 +66,26 @@ public:
 			return false;
 		}
 
-		if (_buffer != nullptr) {
-			delete[] _buffer;
-		}
+		if ((_buffer != nullptr) && (size <= _capacity)) {
+			// fits in the existing storage, reuse it instead of fragmenting the heap
+			for (uint8_t i = 0; i < _capacity; i++) {
+				_buffer[i] = {};
+			}
 
-		_buffer = new data_type[size] {};
+		} else {
+			if (_buffer != nullptr) {
+				delete[] _buffer;
+			}
 
-		if (_buffer == nullptr) {
-			return false;
+			_buffer = new data_type[size] {};
+
+			if (_buffer == nullptr) {
+				_capacity = 0;
+				_size = 0;
+				return false;
+			}
+
+			_capacity = size;
 		}
 
 		_size = size;
@@ -93,7 +105,7 @@ public:
 		uint8_t head_new = _head;
 
 		if (!_first_write) {
-			head_new = (_head + 1) % _size;
+			head_new = next(_head);
 		}
 
 		_buffer[head_new] = sample;
@@ -101,7 +113,7 @@ public:
 
 		// move tail if we overwrite it
 		if (_head == _tail && !_first_write) {
-			_tail = (_tail + 1) % _size;
+			_tail = next(_tail);
 
 		} else {
 			_first_write = false;
@@ -135,7 +147,7 @@ public:
 					_first_write = true;
 
 				} else {
-					_tail = (index + 1) % _size;
+					_tail = next(index);
 				}
 
 				_buffer[index].time_us = 0;
@@ -153,7 +165,7 @@ public:
 		return false;
 	}
 
-	int get_total_size() const { return sizeof(*this) + sizeof(data_type) * _size; }
+	int get_total_size() const { return sizeof(*this) + sizeof(data_type) * _capacity; }
 
 	int entries() const
 	{
@@ -169,11 +181,15 @@ public:
 	}
 
 private:
+	// increment an index with wrap around, cheaper than a modulo by the runtime size
+	uint8_t next(int index) const { return (index + 1 < _size) ? index + 1 : 0; }
+
 	data_type *_buffer{nullptr};
 
 	uint8_t _head{0};
 	uint8_t _tail{0};
 	uint8_t _size{0};
+	uint8_t _capacity{0}; ///< allocated number of elements, >= _size
 
 	bool _first_write{true};
 };
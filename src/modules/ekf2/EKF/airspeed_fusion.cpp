@@ -77,6 +77,8 @@ void Ekf::updateAirspeed(const airspeedSample &airspeed_sample, estimator_aid_so
 
 void Ekf::fuseAirspeed(estimator_aid_source_1d_s &airspeed)
 {
+	ECL_PROFILE(FuseAirspeed);
+
 	if (airspeed.innovation_rejected) {
 		return;
 	}
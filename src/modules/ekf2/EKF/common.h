@@ -294,6 +294,7 @@ struct parameters {
 
 	float terrain_p_noise{5.0f};            ///< process noise for terrain offset (m/sec)
 	float terrain_gradient{0.5f};           ///< gradient of terrain used to estimate process noise due to changing position (m/m)
+	float terrain_grid_cell_size{5.0f};     ///< size of the cells of the terrain map, 0 to disable (m)
 	const float terrain_timeout{10.f};      ///< maximum time for invalid bottom distance measurements before resetting terrain estimate (s)
 
 	// initialization errors
@@ -429,6 +430,8 @@ struct parameters {
 	int32_t synthesize_mag_z{0};
 	int32_t check_mag_strength{0};
 
+	int32_t fusion_spread{0};                       ///< defer mag fusion by one filter update when GPS is fused in the same update
+
 	// Parameters used to control when yaw is reset to the EKF-GSF yaw estimator value
 	float EKFGSF_tas_default{15.0f};                ///< default airspeed value assumed during fixed wing flight if no airspeed measurement available (m/s)
 	const unsigned EKFGSF_reset_delay{1000000};     ///< Number of uSec of bad innovations on main filter in immediate post-takeoff phase before yaw is reset to EKF-GSF value
@@ -561,6 +564,7 @@ union terrain_fusion_status_u {
 	struct {
 		bool range_finder : 1;  ///< 0 - true if we are fusing range finder data
 		bool flow         : 1;  ///< 1 - true if we are fusing flow data
+		bool grid         : 1;  ///< 2 - true if we are fusing the terrain map
 	} flags;
 	uint8_t value;
 };
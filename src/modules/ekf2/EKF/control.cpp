@@ -150,10 +150,14 @@ void Ekf::controlFusionModes()
 		_ev_data_ready = _ext_vision_buffer->pop_first_older_than(_imu_sample_delayed.time_us, &_ev_sample_delayed);
 	}
 
+#if defined(CONFIG_EKF2_WIND)
+
 	if (_airspeed_buffer) {
 		_tas_data_ready = _airspeed_buffer->pop_first_older_than(_imu_sample_delayed.time_us, &_airspeed_sample_delayed);
 	}
 
+#endif // CONFIG_EKF2_WIND
+
 	// run EKF-GSF yaw estimator once per _imu_sample_delayed update after all main EKF data samples available
 	runYawEKFGSF();
 
@@ -161,9 +165,11 @@ void Ekf::controlFusionModes()
 	controlMagFusion();
 	controlOpticalFlowFusion();
 	controlGpsFusion();
+#if defined(CONFIG_EKF2_WIND)
 	controlAirDataFusion();
 	controlBetaFusion();
 	controlDragFusion();
+#endif // CONFIG_EKF2_WIND
 	controlHeightFusion();
 
 	// Additional data odoemtery data from an external estimator can be fused.
@@ -640,6 +646,7 @@ void Ekf::controlGpsYawFusion(const gpsSample &gps_sample, bool gps_checks_passi
 	}
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void Ekf::controlAirDataFusion()
 {
 	// control activation and initialisation/reset of wind states required for airspeed fusion
@@ -739,6 +746,7 @@ void Ekf::controlDragFusion()
 		}
 	}
 }
+#endif // CONFIG_EKF2_WIND
 
 void Ekf::controlAuxVelFusion()
 {
@@ -99,6 +99,8 @@ void Ekf::initialiseCovariance()
 
 void Ekf::predictCovariance()
 {
+	ECL_PROFILE(PredictCovariance);
+
 	// assign intermediate state variables
 	const float q0 = _state.quat_nominal(0);
 	const float q1 = _state.quat_nominal(1);
@@ -494,8 +496,8 @@ void Ekf::predictCovariance()
 	const float PS222 = P(0,6)*PS216 + P(1,6)*PS217 - P(2,6)*PS214 + P(3,6)*PS215 + P(6,13)*PS199 - P(6,14)*PS197 + P(6,15)*PS87 + P(6,6);
 
 
-	// covariance update
-	SquareMatrix24f nextP;
+	// covariance update, only the upper triangle is computed so it is stored packed
+	matrix::SymmetricMatrix<float, _k_num_states> nextP;
 
 	// calculate variances and upper diagonal covariances for quaternion, velocity, position and gyro bias states
 
@@ -686,193 +688,39 @@ void Ekf::predictCovariance()
 	}
 
 	// Don't do covariance prediction on magnetic field states unless we are using 3-axis fusion
-	if (_control_status.flags.mag_3D) {
-		// calculate variances and upper diagonal covariances for earth and body magnetic field states
-
-
-		nextP(0,16) = P(0,16) - P(1,16)*PS11 + P(10,16)*PS6 + P(11,16)*PS7 + P(12,16)*PS9 - P(2,16)*PS12 - P(3,16)*PS13;
-		nextP(1,16) = P(0,16)*PS11 + P(1,16) - P(10,16)*PS34 + P(11,16)*PS9 - P(12,16)*PS7 + P(2,16)*PS13 - P(3,16)*PS12;
-		nextP(2,16) = P(0,16)*PS12 - P(1,16)*PS13 - P(10,16)*PS9 - P(11,16)*PS34 + P(12,16)*PS6 + P(2,16) + P(3,16)*PS11;
-		nextP(3,16) = P(0,16)*PS13 + P(1,16)*PS12 + P(10,16)*PS7 - P(11,16)*PS6 - P(12,16)*PS34 - P(2,16)*PS11 + P(3,16);
-		nextP(4,16) = P(0,16)*PS174 + P(1,16)*PS173 + P(13,16)*PS43 + P(14,16)*PS172 - P(15,16)*PS171 + P(2,16)*PS175 - P(3,16)*PS176 + P(4,16);
-		nextP(5,16) = -P(0,16)*PS202 - P(1,16)*PS204 - P(13,16)*PS193 + P(14,16)*PS75 + P(15,16)*PS190 + P(2,16)*PS201 + P(3,16)*PS203 + P(5,16);
-		nextP(6,16) = P(0,16)*PS216 + P(1,16)*PS217 + P(13,16)*PS199 - P(14,16)*PS197 + P(15,16)*PS87 - P(2,16)*PS214 + P(3,16)*PS215 + P(6,16);
-		nextP(7,16) = P(4,16)*dt + P(7,16);
-		nextP(8,16) = P(5,16)*dt + P(8,16);
-		nextP(9,16) = P(6,16)*dt + P(9,16);
-		nextP(10,16) = P(10,16);
-		nextP(11,16) = P(11,16);
-		nextP(12,16) = P(12,16);
-		nextP(13,16) = P(13,16);
-		nextP(14,16) = P(14,16);
-		nextP(15,16) = P(15,16);
-		nextP(16,16) = P(16,16);
-		nextP(0,17) = P(0,17) - P(1,17)*PS11 + P(10,17)*PS6 + P(11,17)*PS7 + P(12,17)*PS9 - P(2,17)*PS12 - P(3,17)*PS13;
-		nextP(1,17) = P(0,17)*PS11 + P(1,17) - P(10,17)*PS34 + P(11,17)*PS9 - P(12,17)*PS7 + P(2,17)*PS13 - P(3,17)*PS12;
-		nextP(2,17) = P(0,17)*PS12 - P(1,17)*PS13 - P(10,17)*PS9 - P(11,17)*PS34 + P(12,17)*PS6 + P(2,17) + P(3,17)*PS11;
-		nextP(3,17) = P(0,17)*PS13 + P(1,17)*PS12 + P(10,17)*PS7 - P(11,17)*PS6 - P(12,17)*PS34 - P(2,17)*PS11 + P(3,17);
-		nextP(4,17) = P(0,17)*PS174 + P(1,17)*PS173 + P(13,17)*PS43 + P(14,17)*PS172 - P(15,17)*PS171 + P(2,17)*PS175 - P(3,17)*PS176 + P(4,17);
-		nextP(5,17) = -P(0,17)*PS202 - P(1,17)*PS204 - P(13,17)*PS193 + P(14,17)*PS75 + P(15,17)*PS190 + P(2,17)*PS201 + P(3,17)*PS203 + P(5,17);
-		nextP(6,17) = P(0,17)*PS216 + P(1,17)*PS217 + P(13,17)*PS199 - P(14,17)*PS197 + P(15,17)*PS87 - P(2,17)*PS214 + P(3,17)*PS215 + P(6,17);
-		nextP(7,17) = P(4,17)*dt + P(7,17);
-		nextP(8,17) = P(5,17)*dt + P(8,17);
-		nextP(9,17) = P(6,17)*dt + P(9,17);
-		nextP(10,17) = P(10,17);
-		nextP(11,17) = P(11,17);
-		nextP(12,17) = P(12,17);
-		nextP(13,17) = P(13,17);
-		nextP(14,17) = P(14,17);
-		nextP(15,17) = P(15,17);
-		nextP(16,17) = P(16,17);
-		nextP(17,17) = P(17,17);
-		nextP(0,18) = P(0,18) - P(1,18)*PS11 + P(10,18)*PS6 + P(11,18)*PS7 + P(12,18)*PS9 - P(2,18)*PS12 - P(3,18)*PS13;
-		nextP(1,18) = P(0,18)*PS11 + P(1,18) - P(10,18)*PS34 + P(11,18)*PS9 - P(12,18)*PS7 + P(2,18)*PS13 - P(3,18)*PS12;
-		nextP(2,18) = P(0,18)*PS12 - P(1,18)*PS13 - P(10,18)*PS9 - P(11,18)*PS34 + P(12,18)*PS6 + P(2,18) + P(3,18)*PS11;
-		nextP(3,18) = P(0,18)*PS13 + P(1,18)*PS12 + P(10,18)*PS7 - P(11,18)*PS6 - P(12,18)*PS34 - P(2,18)*PS11 + P(3,18);
-		nextP(4,18) = P(0,18)*PS174 + P(1,18)*PS173 + P(13,18)*PS43 + P(14,18)*PS172 - P(15,18)*PS171 + P(2,18)*PS175 - P(3,18)*PS176 + P(4,18);
-		nextP(5,18) = -P(0,18)*PS202 - P(1,18)*PS204 - P(13,18)*PS193 + P(14,18)*PS75 + P(15,18)*PS190 + P(2,18)*PS201 + P(3,18)*PS203 + P(5,18);
-		nextP(6,18) = P(0,18)*PS216 + P(1,18)*PS217 + P(13,18)*PS199 - P(14,18)*PS197 + P(15,18)*PS87 - P(2,18)*PS214 + P(3,18)*PS215 + P(6,18);
-		nextP(7,18) = P(4,18)*dt + P(7,18);
-		nextP(8,18) = P(5,18)*dt + P(8,18);
-		nextP(9,18) = P(6,18)*dt + P(9,18);
-		nextP(10,18) = P(10,18);
-		nextP(11,18) = P(11,18);
-		nextP(12,18) = P(12,18);
-		nextP(13,18) = P(13,18);
-		nextP(14,18) = P(14,18);
-		nextP(15,18) = P(15,18);
-		nextP(16,18) = P(16,18);
-		nextP(17,18) = P(17,18);
-		nextP(18,18) = P(18,18);
-		nextP(0,19) = P(0,19) - P(1,19)*PS11 + P(10,19)*PS6 + P(11,19)*PS7 + P(12,19)*PS9 - P(2,19)*PS12 - P(3,19)*PS13;
-		nextP(1,19) = P(0,19)*PS11 + P(1,19) - P(10,19)*PS34 + P(11,19)*PS9 - P(12,19)*PS7 + P(2,19)*PS13 - P(3,19)*PS12;
-		nextP(2,19) = P(0,19)*PS12 - P(1,19)*PS13 - P(10,19)*PS9 - P(11,19)*PS34 + P(12,19)*PS6 + P(2,19) + P(3,19)*PS11;
-		nextP(3,19) = P(0,19)*PS13 + P(1,19)*PS12 + P(10,19)*PS7 - P(11,19)*PS6 - P(12,19)*PS34 - P(2,19)*PS11 + P(3,19);
-		nextP(4,19) = P(0,19)*PS174 + P(1,19)*PS173 + P(13,19)*PS43 + P(14,19)*PS172 - P(15,19)*PS171 + P(2,19)*PS175 - P(3,19)*PS176 + P(4,19);
-		nextP(5,19) = -P(0,19)*PS202 - P(1,19)*PS204 - P(13,19)*PS193 + P(14,19)*PS75 + P(15,19)*PS190 + P(2,19)*PS201 + P(3,19)*PS203 + P(5,19);
-		nextP(6,19) = P(0,19)*PS216 + P(1,19)*PS217 + P(13,19)*PS199 - P(14,19)*PS197 + P(15,19)*PS87 - P(2,19)*PS214 + P(3,19)*PS215 + P(6,19);
-		nextP(7,19) = P(4,19)*dt + P(7,19);
-		nextP(8,19) = P(5,19)*dt + P(8,19);
-		nextP(9,19) = P(6,19)*dt + P(9,19);
-		nextP(10,19) = P(10,19);
-		nextP(11,19) = P(11,19);
-		nextP(12,19) = P(12,19);
-		nextP(13,19) = P(13,19);
-		nextP(14,19) = P(14,19);
-		nextP(15,19) = P(15,19);
-		nextP(16,19) = P(16,19);
-		nextP(17,19) = P(17,19);
-		nextP(18,19) = P(18,19);
-		nextP(19,19) = P(19,19);
-		nextP(0,20) = P(0,20) - P(1,20)*PS11 + P(10,20)*PS6 + P(11,20)*PS7 + P(12,20)*PS9 - P(2,20)*PS12 - P(3,20)*PS13;
-		nextP(1,20) = P(0,20)*PS11 + P(1,20) - P(10,20)*PS34 + P(11,20)*PS9 - P(12,20)*PS7 + P(2,20)*PS13 - P(3,20)*PS12;
-		nextP(2,20) = P(0,20)*PS12 - P(1,20)*PS13 - P(10,20)*PS9 - P(11,20)*PS34 + P(12,20)*PS6 + P(2,20) + P(3,20)*PS11;
-		nextP(3,20) = P(0,20)*PS13 + P(1,20)*PS12 + P(10,20)*PS7 - P(11,20)*PS6 - P(12,20)*PS34 - P(2,20)*PS11 + P(3,20);
-		nextP(4,20) = P(0,20)*PS174 + P(1,20)*PS173 + P(13,20)*PS43 + P(14,20)*PS172 - P(15,20)*PS171 + P(2,20)*PS175 - P(3,20)*PS176 + P(4,20);
-		nextP(5,20) = -P(0,20)*PS202 - P(1,20)*PS204 - P(13,20)*PS193 + P(14,20)*PS75 + P(15,20)*PS190 + P(2,20)*PS201 + P(3,20)*PS203 + P(5,20);
-		nextP(6,20) = P(0,20)*PS216 + P(1,20)*PS217 + P(13,20)*PS199 - P(14,20)*PS197 + P(15,20)*PS87 - P(2,20)*PS214 + P(3,20)*PS215 + P(6,20);
-		nextP(7,20) = P(4,20)*dt + P(7,20);
-		nextP(8,20) = P(5,20)*dt + P(8,20);
-		nextP(9,20) = P(6,20)*dt + P(9,20);
-		nextP(10,20) = P(10,20);
-		nextP(11,20) = P(11,20);
-		nextP(12,20) = P(12,20);
-		nextP(13,20) = P(13,20);
-		nextP(14,20) = P(14,20);
-		nextP(15,20) = P(15,20);
-		nextP(16,20) = P(16,20);
-		nextP(17,20) = P(17,20);
-		nextP(18,20) = P(18,20);
-		nextP(19,20) = P(19,20);
-		nextP(20,20) = P(20,20);
-		nextP(0,21) = P(0,21) - P(1,21)*PS11 + P(10,21)*PS6 + P(11,21)*PS7 + P(12,21)*PS9 - P(2,21)*PS12 - P(3,21)*PS13;
-		nextP(1,21) = P(0,21)*PS11 + P(1,21) - P(10,21)*PS34 + P(11,21)*PS9 - P(12,21)*PS7 + P(2,21)*PS13 - P(3,21)*PS12;
-		nextP(2,21) = P(0,21)*PS12 - P(1,21)*PS13 - P(10,21)*PS9 - P(11,21)*PS34 + P(12,21)*PS6 + P(2,21) + P(3,21)*PS11;
-		nextP(3,21) = P(0,21)*PS13 + P(1,21)*PS12 + P(10,21)*PS7 - P(11,21)*PS6 - P(12,21)*PS34 - P(2,21)*PS11 + P(3,21);
-		nextP(4,21) = P(0,21)*PS174 + P(1,21)*PS173 + P(13,21)*PS43 + P(14,21)*PS172 - P(15,21)*PS171 + P(2,21)*PS175 - P(3,21)*PS176 + P(4,21);
-		nextP(5,21) = -P(0,21)*PS202 - P(1,21)*PS204 - P(13,21)*PS193 + P(14,21)*PS75 + P(15,21)*PS190 + P(2,21)*PS201 + P(3,21)*PS203 + P(5,21);
-		nextP(6,21) = P(0,21)*PS216 + P(1,21)*PS217 + P(13,21)*PS199 - P(14,21)*PS197 + P(15,21)*PS87 - P(2,21)*PS214 + P(3,21)*PS215 + P(6,21);
-		nextP(7,21) = P(4,21)*dt + P(7,21);
-		nextP(8,21) = P(5,21)*dt + P(8,21);
-		nextP(9,21) = P(6,21)*dt + P(9,21);
-		nextP(10,21) = P(10,21);
-		nextP(11,21) = P(11,21);
-		nextP(12,21) = P(12,21);
-		nextP(13,21) = P(13,21);
-		nextP(14,21) = P(14,21);
-		nextP(15,21) = P(15,21);
-		nextP(16,21) = P(16,21);
-		nextP(17,21) = P(17,21);
-		nextP(18,21) = P(18,21);
-		nextP(19,21) = P(19,21);
-		nextP(20,21) = P(20,21);
-		nextP(21,21) = P(21,21);
-
-		// add process noise that is not from the IMU
-		for (unsigned i = 16; i <= 21; i++) {
-			nextP(i, i) += process_noise(i);
+	// Don't do covariance prediction on wind states unless we are using them
+	if (_control_status.flags.mag_3D || _control_status.flags.wind) {
+		// The earth and body magnetic field and the wind states have an identity state transition and are
+		// not driven by the IMU, so their upper diagonal covariances reduce to the same linear combination
+		// of P for every column. Evaluate it column-wise over the whole contiguous range of these states:
+		// row-major storage makes every term a contiguous row segment of P, which the compiler vectorizes.
+		const unsigned first = _control_status.flags.mag_3D ? 16 : 22;
+		const unsigned last = _control_status.flags.wind ? 23 : 21;
+
+		for (unsigned j = first; j <= last; j++) {
+			nextP(0,j) = P(0,j) - P(1,j)*PS11 + P(10,j)*PS6 + P(11,j)*PS7 + P(12,j)*PS9 - P(2,j)*PS12 - P(3,j)*PS13;
+			nextP(1,j) = P(0,j)*PS11 + P(1,j) - P(10,j)*PS34 + P(11,j)*PS9 - P(12,j)*PS7 + P(2,j)*PS13 - P(3,j)*PS12;
+			nextP(2,j) = P(0,j)*PS12 - P(1,j)*PS13 - P(10,j)*PS9 - P(11,j)*PS34 + P(12,j)*PS6 + P(2,j) + P(3,j)*PS11;
+			nextP(3,j) = P(0,j)*PS13 + P(1,j)*PS12 + P(10,j)*PS7 - P(11,j)*PS6 - P(12,j)*PS34 - P(2,j)*PS11 + P(3,j);
+			nextP(4,j) = P(0,j)*PS174 + P(1,j)*PS173 + P(13,j)*PS43 + P(14,j)*PS172 - P(15,j)*PS171 + P(2,j)*PS175 - P(3,j)*PS176 + P(4,j);
+			nextP(5,j) = -P(0,j)*PS202 - P(1,j)*PS204 - P(13,j)*PS193 + P(14,j)*PS75 + P(15,j)*PS190 + P(2,j)*PS201 + P(3,j)*PS203 + P(5,j);
+			nextP(6,j) = P(0,j)*PS216 + P(1,j)*PS217 + P(13,j)*PS199 - P(14,j)*PS197 + P(15,j)*PS87 - P(2,j)*PS214 + P(3,j)*PS215 + P(6,j);
+			nextP(7,j) = P(4,j)*dt + P(7,j);
+			nextP(8,j) = P(5,j)*dt + P(8,j);
+			nextP(9,j) = P(6,j)*dt + P(9,j);
 		}
 
-	}
-
-	// Don't do covariance prediction on wind states unless we are using them
-	if (_control_status.flags.wind) {
-
-		// calculate variances and upper diagonal covariances for wind states
-
-		nextP(0,22) = P(0,22) - P(1,22)*PS11 + P(10,22)*PS6 + P(11,22)*PS7 + P(12,22)*PS9 - P(2,22)*PS12 - P(3,22)*PS13;
-		nextP(1,22) = P(0,22)*PS11 + P(1,22) - P(10,22)*PS34 + P(11,22)*PS9 - P(12,22)*PS7 + P(2,22)*PS13 - P(3,22)*PS12;
-		nextP(2,22) = P(0,22)*PS12 - P(1,22)*PS13 - P(10,22)*PS9 - P(11,22)*PS34 + P(12,22)*PS6 + P(2,22) + P(3,22)*PS11;
-		nextP(3,22) = P(0,22)*PS13 + P(1,22)*PS12 + P(10,22)*PS7 - P(11,22)*PS6 - P(12,22)*PS34 - P(2,22)*PS11 + P(3,22);
-		nextP(4,22) = P(0,22)*PS174 + P(1,22)*PS173 + P(13,22)*PS43 + P(14,22)*PS172 - P(15,22)*PS171 + P(2,22)*PS175 - P(3,22)*PS176 + P(4,22);
-		nextP(5,22) = -P(0,22)*PS202 - P(1,22)*PS204 - P(13,22)*PS193 + P(14,22)*PS75 + P(15,22)*PS190 + P(2,22)*PS201 + P(3,22)*PS203 + P(5,22);
-		nextP(6,22) = P(0,22)*PS216 + P(1,22)*PS217 + P(13,22)*PS199 - P(14,22)*PS197 + P(15,22)*PS87 - P(2,22)*PS214 + P(3,22)*PS215 + P(6,22);
-		nextP(7,22) = P(4,22)*dt + P(7,22);
-		nextP(8,22) = P(5,22)*dt + P(8,22);
-		nextP(9,22) = P(6,22)*dt + P(9,22);
-		nextP(10,22) = P(10,22);
-		nextP(11,22) = P(11,22);
-		nextP(12,22) = P(12,22);
-		nextP(13,22) = P(13,22);
-		nextP(14,22) = P(14,22);
-		nextP(15,22) = P(15,22);
-		nextP(16,22) = P(16,22);
-		nextP(17,22) = P(17,22);
-		nextP(18,22) = P(18,22);
-		nextP(19,22) = P(19,22);
-		nextP(20,22) = P(20,22);
-		nextP(21,22) = P(21,22);
-		nextP(22,22) = P(22,22);
-		nextP(0,23) = P(0,23) - P(1,23)*PS11 + P(10,23)*PS6 + P(11,23)*PS7 + P(12,23)*PS9 - P(2,23)*PS12 - P(3,23)*PS13;
-		nextP(1,23) = P(0,23)*PS11 + P(1,23) - P(10,23)*PS34 + P(11,23)*PS9 - P(12,23)*PS7 + P(2,23)*PS13 - P(3,23)*PS12;
-		nextP(2,23) = P(0,23)*PS12 - P(1,23)*PS13 - P(10,23)*PS9 - P(11,23)*PS34 + P(12,23)*PS6 + P(2,23) + P(3,23)*PS11;
-		nextP(3,23) = P(0,23)*PS13 + P(1,23)*PS12 + P(10,23)*PS7 - P(11,23)*PS6 - P(12,23)*PS34 - P(2,23)*PS11 + P(3,23);
-		nextP(4,23) = P(0,23)*PS174 + P(1,23)*PS173 + P(13,23)*PS43 + P(14,23)*PS172 - P(15,23)*PS171 + P(2,23)*PS175 - P(3,23)*PS176 + P(4,23);
-		nextP(5,23) = -P(0,23)*PS202 - P(1,23)*PS204 - P(13,23)*PS193 + P(14,23)*PS75 + P(15,23)*PS190 + P(2,23)*PS201 + P(3,23)*PS203 + P(5,23);
-		nextP(6,23) = P(0,23)*PS216 + P(1,23)*PS217 + P(13,23)*PS199 - P(14,23)*PS197 + P(15,23)*PS87 - P(2,23)*PS214 + P(3,23)*PS215 + P(6,23);
-		nextP(7,23) = P(4,23)*dt + P(7,23);
-		nextP(8,23) = P(5,23)*dt + P(8,23);
-		nextP(9,23) = P(6,23)*dt + P(9,23);
-		nextP(10,23) = P(10,23);
-		nextP(11,23) = P(11,23);
-		nextP(12,23) = P(12,23);
-		nextP(13,23) = P(13,23);
-		nextP(14,23) = P(14,23);
-		nextP(15,23) = P(15,23);
-		nextP(16,23) = P(16,23);
-		nextP(17,23) = P(17,23);
-		nextP(18,23) = P(18,23);
-		nextP(19,23) = P(19,23);
-		nextP(20,23) = P(20,23);
-		nextP(21,23) = P(21,23);
-		nextP(22,23) = P(22,23);
-		nextP(23,23) = P(23,23);
+		// the remaining upper diagonal elements are unchanged
+		for (unsigned i = 10; i <= last; i++) {
+			for (unsigned j = (i > first) ? i : first; j <= last; j++) {
+				nextP(i,j) = P(i,j);
+			}
+		}
 
 		// add process noise that is not from the IMU
-		for (unsigned i = 22; i <= 23; i++) {
+		for (unsigned i = first; i <= last; i++) {
 			nextP(i, i) += process_noise(i);
 		}
-
 	}
 
 	// stop position covariance growth if our total position variance reaches 100m
@@ -880,8 +728,8 @@ void Ekf::predictCovariance()
 	if ((P(7, 7) + P(8, 8)) > 1e4f) {
 		for (uint8_t i = 7; i <= 8; i++) {
 			for (uint8_t j = 0; j < _k_num_states; j++) {
-				nextP(i, j) = P(i, j);
-				nextP(j, i) = P(j, i);
+				// nextP(i, j) and nextP(j, i) are the same element, keep the upper one of P
+				nextP(i, j) = (i <= j) ? P(i, j) : P(j, i);
 			}
 		}
 	}
@@ -1098,6 +946,21 @@ bool Ekf::checkAndFixCovarianceUpdate(const SquareMatrix24f &KHP)
 	return healthy;
 }
 
+bool Ekf::checkAndFixCovarianceUpdate(const Vector24f &K, const Vector24f &HP)
+{
+	// same as above with the diagonal of the rank one update KHP = K * HP
+	bool healthy = true;
+
+	for (int i = 0; i < _k_num_states; i++) {
+		if (P(i, i) < K(i) * HP(i)) {
+			P.uncorrelateCovarianceSetVariance<1>(i, 0.0f);
+			healthy = false;
+		}
+	}
+
+	return healthy;
+}
+
 void Ekf::resetMagRelatedCovariances()
 {
 	resetQuatCov();
@@ -1157,6 +1020,7 @@ void Ekf::resetZDeltaAngBiasCov()
 	P.uncorrelateCovarianceSetVariance<1>(12, init_delta_ang_bias_var);
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void Ekf::resetWindCovarianceUsingAirspeed()
 {
 	// Derived using EKF/matlab/scripts/Inertial Nav EKF/wind_cov.py
@@ -1187,3 +1051,4 @@ void Ekf::resetWindCovarianceUsingAirspeed()
 	P(22, 22) += P(4, 4);
 	P(23, 23) += P(5, 5);
 }
+#endif // CONFIG_EKF2_WIND
@@ -46,6 +46,8 @@
 
 void Ekf::fuseDrag(const dragSample &drag_sample)
 {
+	ECL_PROFILE(FuseDrag);
+
 	SparseVector24f<0,1,2,3,4,5,6,22,23> Hfusion;  // Observation Jacobians
 	Vector24f Kfusion; // Kalman gain vector
 
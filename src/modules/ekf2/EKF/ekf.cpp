@@ -62,6 +62,7 @@ void Ekf::reset()
 	_state.quat_nominal.setIdentity();
 
 	// TODO: who resets the output buffer content?
+	applyOutputBufferOffset();
 	_output_new.vel.setZero();
 	_output_new.pos.setZero();
 	_output_new.quat_nominal.setIdentity();
@@ -238,6 +239,8 @@ bool Ekf::initialiseTilt()
 
 void Ekf::predictState()
 {
+	ECL_PROFILE(PredictState);
+
 	// apply imu bias corrections
 	const Vector3f delta_ang_bias_scaled = (_state.delta_ang_bias / _dt_ekf_avg) * _imu_sample_delayed.delta_ang_dt;
 	Vector3f corrected_delta_ang = _imu_sample_delayed.delta_ang - delta_ang_bias_scaled;
@@ -380,14 +383,20 @@ void Ekf::calculateOutputStates(const imuSample &imu)
 
 	// store the INS states in a ring buffer with the same length and time coordinates as the IMU data buffer
 	if (_imu_updated) {
-		_output_buffer.push(_output_new);
+		// the stored samples don't include the accumulated corrections
+		outputSample output_stored{_output_new};
+		output_stored.vel -= _output_vel_offset;
+		output_stored.pos -= _output_pos_offset;
+		_output_buffer.push(output_stored);
 		_output_vert_buffer.push(_output_vert_new);
 
 		// get the oldest INS state data from the ring buffer
 		// this data will be at the EKF fusion time horizon
 		// TODO: there is no guarantee that data is at delayed fusion horizon
 		//       Shouldnt we use pop_first_older_than?
-		const outputSample &output_delayed = _output_buffer.get_oldest();
+		outputSample output_delayed{_output_buffer.get_oldest()};
+		output_delayed.vel += _output_vel_offset;
+		output_delayed.pos += _output_pos_offset;
 		const outputVert &output_vert_delayed = _output_vert_buffer.get_oldest();
 
 		// calculate the quaternion delta between the INS and EKF quaternions at the EKF fusion time horizon
@@ -464,16 +473,14 @@ void Ekf::applyCorrectionToVerticalOutputBuffer(float vert_vel_correction)
 
 	const uint8_t size = _output_vert_buffer.get_length();
 
+	// correct the velocity
+	_output_vert_buffer[index].vert_vel += vert_vel_correction;
+
 	for (uint8_t counter = 0; counter < (size - 1); counter++) {
 		const uint8_t index_next = (index + 1) % size;
 		outputVert &current_state = _output_vert_buffer[index];
 		outputVert &next_state = _output_vert_buffer[index_next];
 
-		// correct the velocity
-		if (counter == 0) {
-			current_state.vert_vel += vert_vel_correction;
-		}
-
 		next_state.vert_vel += vert_vel_correction;
 
 		// position is propagated forward using the corrected velocity and a trapezoidal integrator
@@ -497,17 +504,30 @@ void Ekf::applyCorrectionToVerticalOutputBuffer(float vert_vel_correction)
 */
 void Ekf::applyCorrectionToOutputBuffer(const Vector3f &vel_correction, const Vector3f &pos_correction)
 {
-	// loop through the output filter state history and apply the corrections to the velocity and position states
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
-		// a constant velocity correction is applied
-		_output_buffer[index].vel += vel_correction;
+	// the same correction is applied to the whole state history, so instead of looping through the
+	// output buffer on every update accumulate it and add it when a sample is read
+	_output_vel_offset += vel_correction;
+	_output_pos_offset += pos_correction;
+
+	// update output state to corrected values (the newest sample was just pushed)
+	_output_new.vel += vel_correction;
+	_output_new.pos += pos_correction;
+
+	// keep the offsets small to preserve the precision of the stored samples
+	if ((_output_vel_offset.abs().max() > 1.f) || (_output_pos_offset.abs().max() > 1.f)) {
+		applyOutputBufferOffset();
+	}
+}
 
-		// a constant position correction is applied
-		_output_buffer[index].pos += pos_correction;
+void Ekf::applyOutputBufferOffset()
+{
+	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
+		_output_buffer[index].vel += _output_vel_offset;
+		_output_buffer[index].pos += _output_pos_offset;
 	}
 
-	// update output state to corrected values
-	_output_new = _output_buffer.get_newest();
+	_output_vel_offset.setZero();
+	_output_pos_offset.setZero();
 }
 
 /*
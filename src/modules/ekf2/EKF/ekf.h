@@ -48,7 +48,12 @@
 #include "EKFGSF_yaw.h"
 #include "bias_estimator.hpp"
 #include "height_bias_estimator.hpp"
+#include "profiling.hpp"
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+# include "terrain_grid.hpp"
+#endif // CONFIG_EKF2_TERRAIN_GRID
 
+#include <px4_platform_common/hot_section.h>
 #include <uORB/topics/estimator_aid_source_1d.h>
 #include <uORB/topics/estimator_aid_source_2d.h>
 #include <uORB/topics/estimator_aid_source_3d.h>
@@ -192,8 +197,10 @@ public:
 	// get the wind velocity var
 	Vector2f getWindVelocityVariance() const { return P.slice<2, 2>(22, 22).diag(); }
 
+#if defined(CONFIG_EKF2_WIND)
 	// get the true airspeed in m/s
 	float getTrueAirspeed() const;
+#endif // CONFIG_EKF2_WIND
 
 	// get the full covariance matrix
 	const matrix::SquareMatrix<float, 24> &covariances() const { return P; }
@@ -308,6 +315,11 @@ public:
 	// get the terrain variance
 	float get_terrain_var() const { return _terrain_var; }
 
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	// get the terrain vertical position stored in the terrain map at a horizontal position in local NED frame (lookahead)
+	bool getTerrainGridVertPos(const Vector2f &pos_ne, float &vpos, float &var) const { return _terrain_grid.lookup(pos_ne, vpos, var); }
+#endif // CONFIG_EKF2_TERRAIN_GRID
+
 	// gyro bias (states 10, 11, 12)
 	Vector3f getGyroBias() const { return _state.delta_ang_bias / _dt_ekf_avg; } // get the gyroscope bias in rad/s
 	Vector3f getGyroBiasVariance() const { return Vector3f{P(10, 10), P(11, 11), P(12, 12)} / sq(_dt_ekf_avg); } // get the gyroscope bias variance in rad/s
@@ -587,6 +599,10 @@ private:
 	Vector3f _pos_err_integ{};	///< integral of position tracking error (m.s)
 	Vector3f _output_tracking_error{}; ///< contains the magnitude of the angle, velocity and position track errors (rad, m/s, m)
 
+	// corrections applied to the whole output buffer, not yet added to the stored samples (see applyCorrectionToOutputBuffer())
+	Vector3f _output_vel_offset{};	///< velocity correction (m/sec)
+	Vector3f _output_pos_offset{};	///< position correction (m)
+
 	// variables used for the GPS quality checks
 	Vector3f _gps_pos_deriv_filt{};	///< GPS NED position derivative (m/sec)
 	Vector2f _gps_velNE_filt{};	///< filtered GPS North and East velocity (m/sec)
@@ -605,6 +621,7 @@ private:
 	bool _is_first_imu_sample{true};
 	uint32_t _baro_counter{0};		///< number of baro samples read during initialisation
 	uint32_t _mag_counter{0};		///< number of magnetometer samples read during initialisation
+	bool _mag_fusion_deferred{false};	///< true if the mag sample was left in the buffer during the previous update (EKF2_FUSE_SPREAD)
 	AlphaFilter<Vector3f> _accel_lpf{0.1f};	///< filtered accelerometer measurement used to align tilt (m/s/s)
 	AlphaFilter<Vector3f> _gyro_lpf{0.1f};	///< filtered gyro measurement used for alignment excessive movement check (rad/sec)
 
@@ -636,6 +653,10 @@ private:
 	uint64_t _time_last_hagl_fuse{0};		///< last system time that a range sample was fused by the terrain estimator
 	bool _hagl_valid{false};		///< true when the height above ground estimate is valid
 	terrain_fusion_status_u _hagl_sensor_status{}; ///< Struct indicating type of sensor used to estimate height above ground
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	TerrainGrid _terrain_grid{};		///< terrain vertical position of the area flown over, filled from range finder and flow fusion
+	uint64_t _time_last_grid_terrain_fuse{0};	///< last system time that the terrain map was fused by the terrain estimator
+#endif // CONFIG_EKF2_TERRAIN_GRID
 
 	// height sensor status
 	bool _baro_hgt_faulty{false};		///< true if baro data have been declared faulty TODO: move to fault flags
@@ -654,6 +675,9 @@ private:
 	void applyCorrectionToVerticalOutputBuffer(float vert_vel_correction);
 	void applyCorrectionToOutputBuffer(const Vector3f &vel_correction, const Vector3f &pos_correction);
 
+	// add the accumulated corrections to the stored output buffer samples
+	void applyOutputBufferOffset();
+
 	// initialise filter states of both the delayed ekf and the real time complementary filter
 	bool initialiseFilter(void);
 
@@ -664,7 +688,7 @@ private:
 	void predictState();
 
 	// predict ekf covariance
-	void predictCovariance();
+	PX4_HOT void predictCovariance();
 
 	// ekf sequential fusion of magnetometer measurements
 	bool fuseMag(const Vector3f &mag, estimator_aid_source_3d_s &aid_src_mag, bool update_all_states = true);
@@ -688,6 +712,7 @@ private:
 	// apply sensible limits to the declination and length of the NE mag field states estimates
 	void limitDeclination();
 
+#if defined(CONFIG_EKF2_WIND)
 	void updateAirspeed(const airspeedSample &airspeed_sample, estimator_aid_source_1d_s &airspeed) const;
 	void fuseAirspeed(estimator_aid_source_1d_s &airspeed);
 
@@ -696,6 +721,7 @@ private:
 
 	// fuse body frame drag specific forces for multi-rotor wind estimation
 	void fuseDrag(const dragSample &drag_sample);
+#endif // CONFIG_EKF2_WIND
 
 	void fuseBaroHgt(estimator_aid_source_1d_s &baro_hgt);
 	void fuseRngHgt(estimator_aid_source_1d_s &range_hgt);
@@ -794,6 +820,12 @@ private:
 	void controlHaglFakeFusion();
 	void resetHaglFake();
 
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	// store the terrain estimate in the terrain map, and use the map when no sensor is observing the terrain
+	void updateTerrainGrid();
+	void controlHaglGridFusion();
+#endif // CONFIG_EKF2_TERRAIN_GRID
+
 	// reset the heading and magnetic field states using the declination and magnetometer measurements
 	// return true if successful
 	bool resetMagHeading();
@@ -819,13 +851,12 @@ private:
 
 	Vector3f getVisionVelocityVarianceInEkfFrame() const;
 
-	// matrix vector multiplication for computing K<24,1> * H<1,24> * P<24,24>
-	// that is optimized by exploring the sparsity in H
+	// vector matrix multiplication for computing H<1,24> * P<24,24>
+	// that is optimized by exploring the sparsity in H (only the rows of P
+	// selected by the non-zero elements of H are used)
 	template <size_t ...Idxs>
-	SquareMatrix24f computeKHP(const Vector24f &K, const SparseVector24f<Idxs...> &H) const
+	Vector24f computeHP(const SparseVector24f<Idxs...> &H) const
 	{
-		// K(HP) and (KH)P are equivalent (matrix multiplication is associative)
-		// but K(HP) is computationally much less expensive
 		Vector24f HP;
 		for (unsigned i = 0; i < H.non_zeros(); i++) {
 			const size_t row = H.index(i);
@@ -834,14 +865,7 @@ private:
 			}
 		}
 
-		SquareMatrix24f KHP;
-		for (unsigned row = 0; row < _k_num_states; row++) {
-			for (unsigned col = 0; col < _k_num_states; col++) {
-				KHP(row, col) = K(row) * HP(col);
-			}
-		}
-
-		return KHP;
+		return HP;
 	}
 
 	// measurement update with a single measurement
@@ -856,15 +880,20 @@ private:
 		}
 
 		// apply covariance correction via P_new = (I -K*H)*P
-		// first calculate expression for KHP
-		// then calculate P - KHP
-		const SquareMatrix24f KHP = computeKHP(K, H);
+		// K(HP) and (KH)P are equivalent (matrix multiplication is associative)
+		// but K(HP) is computationally much less expensive.
+		// KHP = K * HP is a rank one update, it is applied in place without forming the 24x24 matrix
+		const Vector24f HP = computeHP(H);
 
-		const bool is_healthy = checkAndFixCovarianceUpdate(KHP);
+		const bool is_healthy = checkAndFixCovarianceUpdate(K, HP);
 
 		if (is_healthy) {
 			// apply the covariance corrections
-			P -= KHP;
+			for (unsigned row = 0; row < _k_num_states; row++) {
+				for (unsigned col = 0; col < _k_num_states; col++) {
+					P(row, col) -= K(row) * HP(col);
+				}
+			}
 
 			fixCovarianceErrors(true);
 
@@ -878,6 +907,7 @@ private:
 	// if the covariance correction will result in a negative variance, then
 	// the covariance matrix is unhealthy and must be corrected
 	bool checkAndFixCovarianceUpdate(const SquareMatrix24f &KHP);
+	bool checkAndFixCovarianceUpdate(const Vector24f &K, const Vector24f &HP);
 
 	// limit the diagonal of the covariance matrix
 	// force symmetry when the argument is true
@@ -941,6 +971,7 @@ private:
 	void runMagAndMagDeclFusions(const Vector3f &mag);
 	void run3DMagAndDeclFusions(const Vector3f &mag);
 
+#if defined(CONFIG_EKF2_WIND)
 	// control fusion of air data observations
 	void controlAirDataFusion();
 
@@ -949,6 +980,7 @@ private:
 
 	// control fusion of multi-rotor drag specific force observations
 	void controlDragFusion();
+#endif // CONFIG_EKF2_WIND
 
 	// control fusion of fake position observations to constrain drift
 	void controlFakePosFusion();
@@ -1021,6 +1053,7 @@ private:
 	void zeroQuatCov();
 	void resetMagCov();
 
+#if defined(CONFIG_EKF2_WIND)
 	// perform a limited reset of the wind state covariances
 	void resetWindCovarianceUsingAirspeed();
 
@@ -1028,6 +1061,7 @@ private:
 	void resetWind();
 	void resetWindUsingAirspeed();
 	void resetWindToZero();
+#endif // CONFIG_EKF2_WIND
 
 	// check that the range finder data is continuous
 	void updateRangeDataContinuity();
@@ -1066,8 +1100,10 @@ private:
 		return sensor_timestamp + acceptance_interval > _newest_high_rate_imu_sample.time_us;
 	}
 
+#if defined(CONFIG_EKF2_WIND)
 	void startAirspeedFusion();
 	void stopAirspeedFusion();
+#endif // CONFIG_EKF2_WIND
 
 	void startGpsFusion(const gpsSample &gps_sample);
 	void stopGpsFusion();
@@ -280,6 +280,8 @@ void Ekf::resetVerticalVelocityToZero()
 // align output filter states to match EKF states at the fusion time horizon
 void Ekf::alignOutputFilter()
 {
+	applyOutputBufferOffset();
+
 	const outputSample &output_delayed = _output_buffer.get_oldest();
 
 	// calculate the quaternion rotation delta from the EKF to output observer states at the EKF fusion time horizon
@@ -667,6 +669,11 @@ bool Ekf::setEkfGlobalOrigin(const double latitude, const double longitude, cons
 		_pos_ref.initReference(latitude, longitude, _imu_sample_delayed.time_us);
 		_gps_alt_ref = altitude;
 
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+		// the terrain map is stored in the local frame
+		_terrain_grid.reset();
+#endif // CONFIG_EKF2_TERRAIN_GRID
+
 		// minimum change in position or height that triggers a reset
 		static constexpr float MIN_RESET_DIST_M = 0.01f;
 
@@ -1441,6 +1448,7 @@ void Ekf::loadMagCovData()
 	P(18, 18) = _saved_mag_ef_d_variance;
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void Ekf::startAirspeedFusion()
 {
 	// If starting wind state estimation, reset the wind states and covariances before fusing any data
@@ -1458,6 +1466,7 @@ void Ekf::stopAirspeedFusion()
 {
 	_control_status.flags.fuse_aspd = false;
 }
+#endif // CONFIG_EKF2_WIND
 
 void Ekf::startGpsFusion(const gpsSample &gps_sample)
 {
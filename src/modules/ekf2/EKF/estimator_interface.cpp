@@ -50,11 +50,14 @@ EstimatorInterface::~EstimatorInterface()
 	delete _mag_buffer;
 	delete _baro_buffer;
 	delete _range_buffer;
-	delete _airspeed_buffer;
 	delete _flow_buffer;
 	delete _ext_vision_buffer;
-	delete _drag_buffer;
 	delete _auxvel_buffer;
+
+#if defined(CONFIG_EKF2_WIND)
+	delete _airspeed_buffer;
+	delete _drag_buffer;
+#endif // CONFIG_EKF2_WIND
 }
 
 // Accumulate imu data and store to buffer at desired rate
@@ -78,7 +81,9 @@ void EstimatorInterface::setIMUData(const imuSample &imu_sample)
 	// accumulate and down-sample imu data and push to the buffer when new downsampled data becomes available
 	if (_imu_updated) {
 
-		_imu_buffer.push(_imu_down_sampler.getDownSampledImuAndTriggerReset());
+		// copy straight into the buffer and start the next accumulation
+		_imu_buffer.push(_imu_down_sampler.getDownSampledImu());
+		_imu_down_sampler.reset();
 
 		// get the oldest data from the buffer
 		_imu_sample_delayed = _imu_buffer.get_oldest();
@@ -87,7 +92,9 @@ void EstimatorInterface::setIMUData(const imuSample &imu_sample)
 		// this will occur if data is overwritten before its time stamp falls behind the fusion time horizon
 		_min_obs_interval_us = (imu_sample.time_us - _imu_sample_delayed.time_us) / (_obs_buffer_length - 1);
 
+#if defined(CONFIG_EKF2_WIND)
 		setDragData(imu_sample);
+#endif // CONFIG_EKF2_WIND
 	}
 }
 
@@ -231,6 +238,7 @@ void EstimatorInterface::setBaroData(const baroSample &baro_sample)
 	}
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void EstimatorInterface::setAirspeedData(const airspeedSample &airspeed_sample)
 {
 	if (!_initialised) {
@@ -265,6 +273,7 @@ void EstimatorInterface::setAirspeedData(const airspeedSample &airspeed_sample)
 		ECL_WARN("airspeed data too fast %" PRIi64 " < %" PRIu64 " + %d", time_us, _airspeed_buffer->get_newest().time_us, _min_obs_interval_us);
 	}
 }
+#endif // CONFIG_EKF2_WIND
 
 void EstimatorInterface::setRangeData(const rangeSample &range_sample)
 {
@@ -410,6 +419,7 @@ void EstimatorInterface::setAuxVelData(const auxVelSample &auxvel_sample)
 	}
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void EstimatorInterface::setDragData(const imuSample &imu)
 {
 	// down-sample the drag specific force data by accumulating and calculating the mean when
@@ -460,6 +470,7 @@ void EstimatorInterface::setDragData(const imuSample &imu)
 		}
 	}
 }
+#endif // CONFIG_EKF2_WIND
 
 bool EstimatorInterface::initialise_interface(uint64_t timestamp)
 {
@@ -632,10 +643,14 @@ void EstimatorInterface::print_status()
 		printf("range buffer: %d/%d (%d Bytes)\n", _range_buffer->entries(), _range_buffer->get_length(), _range_buffer->get_total_size());
 	}
 
+#if defined(CONFIG_EKF2_WIND)
+
 	if (_airspeed_buffer) {
 		printf("airspeed buffer: %d/%d (%d Bytes)\n", _airspeed_buffer->entries(), _airspeed_buffer->get_length(), _airspeed_buffer->get_total_size());
 	}
 
+#endif // CONFIG_EKF2_WIND
+
 	if (_flow_buffer) {
 		printf("flow buffer: %d/%d (%d Bytes)\n", _flow_buffer->entries(), _flow_buffer->get_length(), _flow_buffer->get_total_size());
 	}
@@ -644,10 +659,14 @@ void EstimatorInterface::print_status()
 		printf("vision buffer: %d/%d (%d Bytes)\n", _ext_vision_buffer->entries(), _ext_vision_buffer->get_length(), _ext_vision_buffer->get_total_size());
 	}
 
+#if defined(CONFIG_EKF2_WIND)
+
 	if (_drag_buffer) {
 		printf("drag buffer: %d/%d (%d Bytes)\n", _drag_buffer->entries(), _drag_buffer->get_length(), _drag_buffer->get_total_size());
 	}
 
+#endif // CONFIG_EKF2_WIND
+
 	printf("output buffer: %d/%d (%d Bytes)\n", _output_buffer.entries(), _output_buffer.get_length(), _output_buffer.get_total_size());
 	printf("output vert buffer: %d/%d (%d Bytes)\n", _output_vert_buffer.entries(), _output_vert_buffer.get_length(), _output_vert_buffer.get_total_size());
 }
@@ -42,6 +42,8 @@
 #ifndef EKF_ESTIMATOR_INTERFACE_H
 #define EKF_ESTIMATOR_INTERFACE_H
 
+#include <px4_platform_common/px4_config.h>
+
 #if defined(MODULE_NAME)
 #include <px4_platform_common/log.h>
 # define ECL_INFO PX4_DEBUG
@@ -89,7 +91,9 @@ public:
 
 	void setBaroData(const baroSample &baro_sample);
 
+#if defined(CONFIG_EKF2_WIND)
 	void setAirspeedData(const airspeedSample &airspeed_sample);
+#endif // CONFIG_EKF2_WIND
 
 	void setRangeData(const rangeSample &range_sample);
 
@@ -369,12 +373,15 @@ protected:
 	RingBuffer<magSample> *_mag_buffer{nullptr};
 	RingBuffer<baroSample> *_baro_buffer{nullptr};
 	RingBuffer<rangeSample> *_range_buffer{nullptr};
-	RingBuffer<airspeedSample> *_airspeed_buffer{nullptr};
 	RingBuffer<flowSample> 	*_flow_buffer{nullptr};
 	RingBuffer<extVisionSample> *_ext_vision_buffer{nullptr};
-	RingBuffer<dragSample> *_drag_buffer{nullptr};
 	RingBuffer<auxVelSample> *_auxvel_buffer{nullptr};
 
+#if defined(CONFIG_EKF2_WIND)
+	RingBuffer<airspeedSample> *_airspeed_buffer{nullptr};
+	RingBuffer<dragSample> *_drag_buffer{nullptr};
+#endif // CONFIG_EKF2_WIND
+
 	uint64_t _time_last_gps_buffer_push{0};
 	uint64_t _time_last_gps_yaw_buffer_push{0};
 	uint64_t _time_last_mag_buffer_push{0};
@@ -408,7 +415,9 @@ protected:
 
 private:
 
+#if defined(CONFIG_EKF2_WIND)
 	inline void setDragData(const imuSample &imu);
+#endif // CONFIG_EKF2_WIND
 
 	void printBufferAllocationFailed(const char *buffer_name);
 
@@ -47,6 +47,8 @@
 
 void Ekf::fuseGpsYaw(const gpsSample& gps_sample)
 {
+	ECL_PROFILE(FuseGpsYaw);
+
 	// assign intermediate state variables
 	const float q0 = _state.quat_nominal(0);
 	const float q1 = _state.quat_nominal(1);
@@ -60,9 +60,13 @@ public:
 		return imu;
 	}
 
-private:
+	// down-sampled data, valid after update() returned true and until reset()
+	const imuSample &getDownSampledImu() const { return _imu_down_sampled; }
+
 	void reset();
 
+private:
+
 	imuSample _imu_down_sampled{};
 	Quatf _delta_angle_accumulated{};
 
@@ -46,7 +46,14 @@ void Ekf::controlMagFusion()
 	magSample mag_sample;
 
 	if (_mag_buffer) {
-		mag_data_ready = _mag_buffer->pop_first_older_than(_imu_sample_delayed.time_us, &mag_sample);
+		// when spreading the fusion load, don't fuse mag and GPS on the same update.
+		// The sample stays in the buffer and is still older than the next fusion time horizon.
+		const bool defer = _params.fusion_spread && _gps_data_ready && !_mag_fusion_deferred;
+		_mag_fusion_deferred = defer;
+
+		if (!defer) {
+			mag_data_ready = _mag_buffer->pop_first_older_than(_imu_sample_delayed.time_us, &mag_sample);
+		}
 
 		if (mag_data_ready) {
 			_mag_lpf.update(mag_sample.mag);
@@ -47,6 +47,8 @@
 
 bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source_3d_s &aid_src_mag, bool update_all_states)
 {
+	ECL_PROFILE(FuseMag);
+
 	// assign intermediate variables
 	const float q0 = _state.quat_nominal(0);
 	const float q1 = _state.quat_nominal(1);
@@ -433,6 +435,8 @@ bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source_3d_s &aid_src_mag, b
 // update quaternion states and covariances using the yaw innovation and yaw observation variance
 bool Ekf::fuseYaw(const float innovation, const float variance, estimator_aid_source_1d_s& aid_src_status)
 {
+	ECL_PROFILE(FuseYaw);
+
 	aid_src_status.innovation = innovation;
 
 	// assign intermediate state variables
@@ -684,6 +688,8 @@ bool Ekf::fuseYaw(const float innovation, const float variance, estimator_aid_so
 
 bool Ekf::fuseDeclination(float decl_sigma)
 {
+	ECL_PROFILE(FuseDeclination);
+
 	// assign intermediate state variables
 	const float magN = _state.mag_I(0);
 	const float magE = _state.mag_I(1);
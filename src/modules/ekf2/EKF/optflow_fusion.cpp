@@ -49,6 +49,8 @@
 
 void Ekf::fuseOptFlow()
 {
+	ECL_PROFILE(FuseOptFlow);
+
 	float gndclearance = fmaxf(_params.rng_gnd_clearance, 0.1f);
 
 	// get latest estimated orientation
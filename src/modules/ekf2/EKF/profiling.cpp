@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "profiling.hpp"
+
+#if defined(__PX4_NUTTX)
+#include <drivers/drv_hrt.h>
+#else
+#include <chrono>
+#endif
+
+namespace ecl
+{
+namespace profiling
+{
+
+static Stats _stats[static_cast<int>(Section::Count)] {};
+
+const char *name(Section section)
+{
+	switch (section) {
+	case Section::PredictState: return "predictState";
+
+	case Section::PredictCovariance: return "predictCovariance";
+
+	case Section::FuseMag: return "fuseMag";
+
+	case Section::FuseYaw: return "fuseYaw";
+
+	case Section::FuseDeclination: return "fuseDeclination";
+
+	case Section::FuseGpsYaw: return "fuseGpsYaw";
+
+	case Section::FuseVelPosHeight: return "fuseVelPosHeight";
+
+	case Section::FuseOptFlow: return "fuseOptFlow";
+
+	case Section::FuseAirspeed: return "fuseAirspeed";
+
+	case Section::FuseSideslip: return "fuseSideslip";
+
+	case Section::FuseDrag: return "fuseDrag";
+
+	case Section::FuseHaglRng: return "fuseHaglRng";
+
+	case Section::FuseFlowForTerrain: return "fuseFlowForTerrain";
+
+	case Section::Count: break;
+	}
+
+	return "unknown";
+}
+
+Stats &stats(Section section)
+{
+	return _stats[static_cast<int>(section)];
+}
+
+void reset()
+{
+	for (Stats &s : _stats) {
+		s = {};
+	}
+}
+
+uint64_t now_ns()
+{
+#if defined(__PX4_NUTTX)
+	// microsecond resolution, the sums over many calls are still meaningful
+	return hrt_absolute_time() * 1000;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		       std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+} // namespace profiling
+} // namespace ecl
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file profiling.hpp
+ * @brief Execution time accounting of the estimator prediction and fusion steps
+ *
+ * Only compiled in when ECL_PROFILING is defined (ekf2_benchmark, or the ekf2 module
+ * with CONFIG_EKF2_PROFILING), otherwise the ECL_PROFILE() markers expand to nothing.
+ * The statistics are shared by all estimator instances.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace ecl
+{
+namespace profiling
+{
+
+enum class Section : uint8_t {
+	PredictState,
+	PredictCovariance,
+	FuseMag,
+	FuseYaw,
+	FuseDeclination,
+	FuseGpsYaw,
+	FuseVelPosHeight,
+	FuseOptFlow,
+	FuseAirspeed,
+	FuseSideslip,
+	FuseDrag,
+	FuseHaglRng,
+	FuseFlowForTerrain,
+	Count
+};
+
+struct Stats {
+	uint64_t elapsed_ns;
+	uint32_t calls;
+};
+
+const char *name(Section section);
+Stats &stats(Section section);
+void reset();
+
+uint64_t now_ns();
+
+class Scope
+{
+public:
+	explicit Scope(Section section) : _section(section), _start_ns(now_ns()) {}
+
+	~Scope()
+	{
+		Stats &s = stats(_section);
+		s.elapsed_ns += now_ns() - _start_ns;
+		s.calls++;
+	}
+
+	Scope(const Scope &) = delete;
+	Scope &operator=(const Scope &) = delete;
+
+private:
+	const Section _section;
+	const uint64_t _start_ns;
+};
+
+} // namespace profiling
+} // namespace ecl
+
+#if defined(ECL_PROFILING)
+# define ECL_PROFILE(section) ecl::profiling::Scope _ecl_profile_scope(ecl::profiling::Section::section)
+#else
+# define ECL_PROFILE(section)
+#endif
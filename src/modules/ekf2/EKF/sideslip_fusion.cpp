@@ -47,6 +47,8 @@
 
 void Ekf::fuseSideslip()
 {
+	ECL_PROFILE(FuseSideslip);
+
 	// get latest estimated orientation
 	const float q0 = _state.quat_nominal(0);
 	const float q1 = _state.quat_nominal(1);
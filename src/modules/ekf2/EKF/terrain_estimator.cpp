@@ -60,6 +60,9 @@ void Ekf::runTerrainEstimator()
 
 	controlHaglRngFusion();
 	controlHaglFlowFusion();
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	controlHaglGridFusion();
+#endif // CONFIG_EKF2_TERRAIN_GRID
 	controlHaglFakeFusion();
 
 	// constrain _terrain_vpos to be a minimum of _params.rng_gnd_clearance larger than _state.pos(2)
@@ -67,6 +70,10 @@ void Ekf::runTerrainEstimator()
 		_terrain_vpos = _params.rng_gnd_clearance + _state.pos(2);
 	}
 
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	updateTerrainGrid();
+#endif // CONFIG_EKF2_TERRAIN_GRID
+
 	updateTerrainValidity();
 }
 
@@ -202,6 +209,8 @@ void Ekf::stopHaglRngFusion()
 
 void Ekf::fuseHaglRng()
 {
+	ECL_PROFILE(FuseHaglRng);
+
 	// get a height above ground measurement from the range finder assuming a flat earth
 	const float meas_hagl = _range_sensor.getDistBottom();
 
@@ -310,6 +319,8 @@ void Ekf::resetHaglFlow()
 
 void Ekf::fuseFlowForTerrain()
 {
+	ECL_PROFILE(FuseFlowForTerrain);
+
 	// calculate optical LOS rates using optical flow rates that have had the body angular rate contribution removed
 	// correct for gyro bias errors in the data used to do the motion compensation
 	// Note the sign convention used: A positive LOS rate is a RH rotation of the scene about that axis.
@@ -435,5 +446,68 @@ void Ekf::updateTerrainValidity()
 	// this can only be the case if the main filter does not fuse optical flow
 	const bool recent_flow_for_terrain_fusion = isRecent(_time_last_flow_terrain_fuse, (uint64_t)5e6);
 
-	_hagl_valid = (recent_range_fusion || recent_flow_for_terrain_fusion);
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+	// the terrain map has been fused within the last 5 seconds (no sensor is observing the terrain)
+	const bool recent_grid_fusion = isRecent(_time_last_grid_terrain_fuse, (uint64_t)5e6);
+#else
+	const bool recent_grid_fusion = false;
+#endif // CONFIG_EKF2_TERRAIN_GRID
+
+	_hagl_valid = (recent_range_fusion || recent_flow_for_terrain_fusion || recent_grid_fusion);
+}
+
+#if defined(CONFIG_EKF2_TERRAIN_GRID)
+void Ekf::updateTerrainGrid()
+{
+	_terrain_grid.setCellSize(_params.terrain_grid_cell_size);
+
+	// only store estimates that come from a sensor observing the terrain in this cycle
+	const bool rng_fused = _hagl_sensor_status.flags.range_finder && (_time_last_hagl_fuse == _imu_sample_delayed.time_us);
+	const bool flow_fused = _hagl_sensor_status.flags.flow && (_time_last_flow_terrain_fuse == _imu_sample_delayed.time_us);
+
+	if ((rng_fused || flow_fused) && isHorizontalAidingActive()) {
+		_terrain_grid.update(Vector2f(_state.pos), _terrain_vpos, _terrain_var, _params.terrain_gradient);
+	}
+}
+
+void Ekf::controlHaglGridFusion()
+{
+	const bool sensor_fusion_recent = isRecent(_time_last_hagl_fuse, (uint64_t)1e6)
+					  || isRecent(_time_last_flow_terrain_fuse, (uint64_t)1e6);
+
+	float grid_vpos;
+	float grid_var;
+
+	if (!_control_status.flags.in_air || sensor_fusion_recent || !isHorizontalAidingActive()
+	    || !_terrain_grid.lookup(Vector2f(_state.pos), grid_vpos, grid_var)) {
+
+		_hagl_sensor_status.flags.grid = false;
+		return;
+	}
+
+	_hagl_sensor_status.flags.grid = true;
+
+	// the horizontal position uncertainty maps into a terrain height error through the terrain gradient
+	const float obs_var = grid_var + (P(7, 7) + P(8, 8)) * sq(_params.terrain_gradient);
+
+	if (!_hagl_valid) {
+		// instant re-initialization over an area that has already been flown over
+		_terrain_vpos = grid_vpos;
+		_terrain_var = obs_var;
+		_terrain_vpos_reset_counter++;
+		_time_last_grid_terrain_fuse = _imu_sample_delayed.time_us;
+		return;
+	}
+
+	const float innov = _terrain_vpos - grid_vpos;
+	const float innov_var = fmaxf(_terrain_var + obs_var, obs_var);
+	const float gate_size = fmaxf(_params.range_innov_gate, 1.0f);
+
+	if (sq(innov) / (sq(gate_size) * innov_var) <= 1.0f) {
+		const float gain = _terrain_var / innov_var;
+		_terrain_vpos -= gain * innov;
+		_terrain_var = fmaxf(_terrain_var * (1.0f - gain), 0.0f);
+		_time_last_grid_terrain_fuse = _imu_sample_delayed.time_us;
+	}
 }
+#endif // CONFIG_EKF2_TERRAIN_GRID
@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file terrain_grid.hpp
+ * Memory bounded map of the terrain vertical position the vehicle has flown over.
+ *
+ * Two levels of square cells (fine and COARSE_SCALE times coarser) are stored in toroidal
+ * buffers around the local NED origin: a cell that aliases with the one being written is
+ * overwritten, so the map always holds the most recently visited area.
+ */
+
+#pragma once
+
+#include <matrix/math.hpp>
+#include <mathlib/mathlib.h>
+
+#include <stdint.h>
+
+class TerrainGrid
+{
+public:
+	static constexpr int SIZE = 16; ///< number of cells along each axis, per level
+	static constexpr int COARSE_SCALE = 8; ///< size ratio of the coarse to the fine cells
+
+	void reset()
+	{
+		for (Level &level : _levels) {
+			for (Cell &cell : level.cells) {
+				cell = Cell{};
+			}
+		}
+	}
+
+	void setCellSize(float cell_size)
+	{
+		if (fabsf(cell_size - _cell_size) > FLT_EPSILON) {
+			// the stored cells do not match the new resolution
+			_cell_size = cell_size;
+			reset();
+		}
+	}
+
+	bool enabled() const { return _cell_size > FLT_EPSILON; }
+
+	/**
+	 * Merge an estimate of the terrain vertical position into the fine and coarse cells at pos_ne
+	 * @param pos_ne horizontal position in local NED frame (m)
+	 * @param vpos terrain vertical position in local NED frame (m)
+	 * @param var variance of vpos (m^2)
+	 * @param gradient terrain gradient (m/m), the spread within a cell bounds its confidence
+	 */
+	void update(const matrix::Vector2f &pos_ne, float vpos, float var, float gradient)
+	{
+		if (!enabled()) {
+			return;
+		}
+
+		for (int l = 0; l < 2; l++) {
+			const float cell_size = levelCellSize(l);
+			int16_t x;
+			int16_t y;
+
+			if (!cellIndex(pos_ne, cell_size, x, y)) {
+				continue;
+			}
+
+			Cell &cell = _levels[l].cells[wrap(x) * SIZE + wrap(y)];
+			const float obs_var = var + math::sq(0.5f * gradient * cell_size);
+
+			if (cell.x != x || cell.y != y || !(cell.var > 0.f)) {
+				cell.x = x;
+				cell.y = y;
+				cell.vpos = vpos;
+				cell.var = obs_var;
+
+			} else {
+				const float gain = cell.var / (cell.var + obs_var);
+				cell.vpos += gain * (vpos - cell.vpos);
+				// samples taken in the same cell are correlated, do not get more confident than a single one
+				cell.var = fmaxf(cell.var * (1.f - gain), 0.5f * obs_var);
+			}
+		}
+	}
+
+	/**
+	 * Get the terrain vertical position at pos_ne from the finest level covering it
+	 * @return true if a matching cell was found
+	 */
+	bool lookup(const matrix::Vector2f &pos_ne, float &vpos, float &var) const
+	{
+		if (!enabled()) {
+			return false;
+		}
+
+		for (int l = 0; l < 2; l++) {
+			int16_t x;
+			int16_t y;
+
+			if (!cellIndex(pos_ne, levelCellSize(l), x, y)) {
+				continue;
+			}
+
+			const Cell &cell = _levels[l].cells[wrap(x) * SIZE + wrap(y)];
+
+			if (cell.x == x && cell.y == y && cell.var > 0.f) {
+				vpos = cell.vpos;
+				var = cell.var;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	struct Cell {
+		int16_t x{INT16_MIN}; ///< absolute index of the cell, used to detect aliasing
+		int16_t y{INT16_MIN};
+		float vpos{0.f};
+		float var{0.f};
+	};
+
+	struct Level {
+		Cell cells[SIZE * SIZE];
+	};
+
+	float levelCellSize(int level) const { return (level == 0) ? _cell_size : _cell_size * COARSE_SCALE; }
+
+	static bool cellIndex(const matrix::Vector2f &pos_ne, float cell_size, int16_t &x, int16_t &y)
+	{
+		const float fx = floorf(pos_ne(0) / cell_size);
+		const float fy = floorf(pos_ne(1) / cell_size);
+
+		if (!(fabsf(fx) < INT16_MAX) || !(fabsf(fy) < INT16_MAX)) {
+			return false;
+		}
+
+		x = static_cast<int16_t>(fx);
+		y = static_cast<int16_t>(fy);
+		return true;
+	}
+
+	static int wrap(int16_t index) { return index & (SIZE - 1); }
+
+	Level _levels[2] {};
+	float _cell_size{0.f};
+};
@@ -258,6 +258,8 @@ void Ekf::fusePosition(estimator_aid_source_3d_s& pos_aid_src)
 // Helper function that fuses a single velocity or position measurement
 bool Ekf::fuseVelPosHeight(const float innov, const float innov_var, const int obs_index)
 {
+	ECL_PROFILE(FuseVelPosHeight);
+
 	Vector24f Kfusion;  // Kalman gain vector for any single observation - sequential fusion is used.
 	const unsigned state_index = obs_index + 4;  // we start with vx and this is the 4. state
 
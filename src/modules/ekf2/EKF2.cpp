@@ -34,6 +34,8 @@
 #include <px4_platform_common/events.h>
 #include "EKF2.hpp"
 
+#include <unistd.h>
+
 using namespace time_literals;
 using math::constrain;
 using matrix::Eulerf;
@@ -46,6 +48,43 @@ static px4::atomic<EKF2 *> _objects[EKF2_MAX_INSTANCES] {};
 static px4::atomic<EKF2Selector *> _ekf2_selector {nullptr};
 #endif // !CONSTRAINED_FLASH
 
+#if defined(CONFIG_EKF2_INSTANCE_PER_CORE)
+/**
+ * Work queue of multi-EKF instance n: one thread per instance, pinned round-robin to
+ * the online CPUs (a board BOARD_WQ_CPU_AFFINITY entry for the name takes precedence).
+ */
+static const px4::wq_config_t &instance_to_wq(uint8_t n)
+{
+	static constexpr const char *names[EKF2_MAX_INSTANCES] {
+		"wq:ekf2_0", "wq:ekf2_1",
+#if EKF2_MAX_INSTANCES > 2
+		"wq:ekf2_2", "wq:ekf2_3",
+#if EKF2_MAX_INSTANCES > 4
+		"wq:ekf2_4", "wq:ekf2_5", "wq:ekf2_6", "wq:ekf2_7", "wq:ekf2_8",
+#endif
+#endif
+	};
+
+	// referenced by the work queue for its whole lifetime
+	static px4::wq_config_t configs[EKF2_MAX_INSTANCES] {};
+
+	px4::wq_config_t &config = configs[n];
+
+	if (config.name == nullptr) {
+		config = px4::wq_configurations::INS0;
+		config.name = names[n];
+
+		const long cpus = math::min(sysconf(_SC_NPROCESSORS_ONLN), 32L);
+
+		if (cpus > 1) {
+			config.cpu_affinity = 1u << (n % cpus);
+		}
+	}
+
+	return config;
+}
+#endif // CONFIG_EKF2_INSTANCE_PER_CORE
+
 EKF2::EKF2(bool multi_mode, const px4::wq_config_t &config, bool replay_mode):
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, config),
@@ -76,6 +115,7 @@ EKF2::EKF2(bool multi_mode, const px4::wq_config_t &config, bool replay_mode):
 	_param_ekf2_wind_nsd(_params->wind_vel_nsd),
 	_param_ekf2_terr_noise(_params->terrain_p_noise),
 	_param_ekf2_terr_grad(_params->terrain_gradient),
+	_param_ekf2_terr_cell(_params->terrain_grid_cell_size),
 	_param_ekf2_gps_v_noise(_params->gps_vel_noise),
 	_param_ekf2_gps_p_noise(_params->gps_pos_noise),
 	_param_ekf2_noaid_noise(_params->pos_noaid_noise),
@@ -166,6 +206,7 @@ EKF2::EKF2(bool multi_mode, const px4::wq_config_t &config, bool replay_mode):
 	_param_ekf2_pcoef_z(_params->static_pressure_coef_z),
 	_param_ekf2_mag_check(_params->check_mag_strength),
 	_param_ekf2_synthetic_mag_z(_params->synthesize_mag_z),
+	_param_ekf2_fuse_spread(_params->fusion_spread),
 	_param_ekf2_gsf_tas_default(_params->EKFGSF_tas_default)
 {
 	// advertise expected minimal topic set immediately to ensure logging
@@ -333,11 +374,19 @@ void EKF2::Run()
 	}
 
 	if (!_callback_registered) {
+		// every run should finish within one filter update period
+		const uint32_t deadline_us = math::max(_param_ekf2_predict_us.get(), (int32_t)1000);
+
+		// optionally wake up only every N IMU samples and process the queued samples in one go
+		const uint8_t imu_batch = math::constrain(_param_ekf2_imu_batch.get(), (int32_t)1, (int32_t)IMU_QUEUE_LENGTH);
+
 		if (_multi_mode) {
-			_callback_registered = _vehicle_imu_sub.registerCallback();
+			_vehicle_imu_sub.set_required_updates(imu_batch);
+			_callback_registered = _vehicle_imu_sub.registerCallback(deadline_us);
 
 		} else {
-			_callback_registered = _sensor_combined_sub.registerCallback();
+			_sensor_combined_sub.set_required_updates(imu_batch);
+			_callback_registered = _sensor_combined_sub.registerCallback(deadline_us);
 		}
 
 		if (!_callback_registered) {
@@ -370,142 +419,23 @@ void EKF2::Run()
 		}
 	}
 
-	bool imu_updated = false;
 	imuSample imu_sample_new {};
-
 	hrt_abstime imu_dt = 0; // for tracking time slip later
+	bool imu_updated = UpdateImuSample(imu_sample_new, imu_dt);
+	bool ekf_batch_updated = false;
 
-	if (_multi_mode) {
-		const unsigned last_generation = _vehicle_imu_sub.get_last_generation();
-		vehicle_imu_s imu;
-		imu_updated = _vehicle_imu_sub.update(&imu);
-
-		if (imu_updated && (_vehicle_imu_sub.get_last_generation() != last_generation + 1)) {
-			perf_count(_msg_missed_imu_perf);
-		}
-
-		if (imu_updated) {
-			imu_sample_new.time_us = imu.timestamp_sample;
-			imu_sample_new.delta_ang_dt = imu.delta_angle_dt * 1.e-6f;
-			imu_sample_new.delta_ang = Vector3f{imu.delta_angle};
-			imu_sample_new.delta_vel_dt = imu.delta_velocity_dt * 1.e-6f;
-			imu_sample_new.delta_vel = Vector3f{imu.delta_velocity};
-
-			if (imu.delta_velocity_clipping > 0) {
-				imu_sample_new.delta_vel_clipping[0] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_X;
-				imu_sample_new.delta_vel_clipping[1] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_Y;
-				imu_sample_new.delta_vel_clipping[2] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_Z;
-			}
-
-			imu_dt = imu.delta_angle_dt;
-
-			if ((_device_id_accel == 0) || (_device_id_gyro == 0)) {
-				_device_id_accel = imu.accel_device_id;
-				_device_id_gyro = imu.gyro_device_id;
-				_accel_calibration_count = imu.accel_calibration_count;
-				_gyro_calibration_count = imu.gyro_calibration_count;
-
-			} else {
-				if ((imu.accel_calibration_count != _accel_calibration_count)
-				    || (imu.accel_device_id != _device_id_accel)) {
-
-					PX4_DEBUG("%d - resetting accelerometer bias", _instance);
-					_device_id_accel = imu.accel_device_id;
-
-					_ekf.resetAccelBias();
-					_accel_calibration_count = imu.accel_calibration_count;
-
-					// reset bias learning
-					_accel_cal = {};
-				}
-
-				if ((imu.gyro_calibration_count != _gyro_calibration_count)
-				    || (imu.gyro_device_id != _device_id_gyro)) {
-
-					PX4_DEBUG("%d - resetting rate gyro bias", _instance);
-					_device_id_gyro = imu.gyro_device_id;
-
-					_ekf.resetGyroBias();
-					_gyro_calibration_count = imu.gyro_calibration_count;
-
-					// reset bias learning
-					_gyro_cal = {};
-				}
-			}
-		}
-
-	} else {
-		const unsigned last_generation = _sensor_combined_sub.get_last_generation();
-		sensor_combined_s sensor_combined;
-		imu_updated = _sensor_combined_sub.update(&sensor_combined);
-
-		if (imu_updated && (_sensor_combined_sub.get_last_generation() != last_generation + 1)) {
-			perf_count(_msg_missed_imu_perf);
-		}
-
-		if (imu_updated) {
-			imu_sample_new.time_us = sensor_combined.timestamp;
-			imu_sample_new.delta_ang_dt = sensor_combined.gyro_integral_dt * 1.e-6f;
-			imu_sample_new.delta_ang = Vector3f{sensor_combined.gyro_rad} * imu_sample_new.delta_ang_dt;
-			imu_sample_new.delta_vel_dt = sensor_combined.accelerometer_integral_dt * 1.e-6f;
-			imu_sample_new.delta_vel = Vector3f{sensor_combined.accelerometer_m_s2} * imu_sample_new.delta_vel_dt;
-
-			if (sensor_combined.accelerometer_clipping > 0) {
-				imu_sample_new.delta_vel_clipping[0] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_X;
-				imu_sample_new.delta_vel_clipping[1] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_Y;
-				imu_sample_new.delta_vel_clipping[2] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_Z;
-			}
-
-			imu_dt = sensor_combined.gyro_integral_dt;
-
-			if (sensor_combined.accel_calibration_count != _accel_calibration_count) {
-
-				PX4_DEBUG("%d - resetting accelerometer bias", _instance);
-
-				_ekf.resetAccelBias();
-				_accel_calibration_count = sensor_combined.accel_calibration_count;
-
-				// reset bias learning
-				_accel_cal = {};
-			}
-
-			if (sensor_combined.gyro_calibration_count != _gyro_calibration_count) {
-
-				PX4_DEBUG("%d - resetting rate gyro bias", _instance);
-
-				_ekf.resetGyroBias();
-				_gyro_calibration_count = sensor_combined.gyro_calibration_count;
-
-				// reset bias learning
-				_gyro_cal = {};
-			}
+	// drain the IMU queue, all but the newest sample only go through the filter and output predictor
+	for (unsigned i = 1; imu_updated && (i < IMU_QUEUE_LENGTH); i++) {
+		if (!(_multi_mode ? _vehicle_imu_sub.updated() : _sensor_combined_sub.updated())) {
+			break;
 		}
 
-		if (_sensor_selection_sub.updated() || (_device_id_accel == 0 || _device_id_gyro == 0)) {
-			sensor_selection_s sensor_selection;
-
-			if (_sensor_selection_sub.copy(&sensor_selection)) {
-				if (_device_id_accel != sensor_selection.accel_device_id) {
-
-					_device_id_accel = sensor_selection.accel_device_id;
-
-					_ekf.resetAccelBias();
-
-					// reset bias learning
-					_accel_cal = {};
-				}
-
-				if (_device_id_gyro != sensor_selection.gyro_device_id) {
-
-					_device_id_gyro = sensor_selection.gyro_device_id;
-
-					_ekf.resetGyroBias();
+		_ekf.setIMUData(imu_sample_new);
+		UpdateTimeSlip(imu_sample_new, imu_dt);
+		ekf_batch_updated |= _ekf.update();
 
-					// reset bias learning
-					_gyro_cal = {};
-				}
-			}
-		}
+		imu_sample_new = {};
+		imu_updated = UpdateImuSample(imu_sample_new, imu_dt);
 	}
 
 	if (imu_updated) {
@@ -515,15 +445,7 @@ void EKF2::Run()
 		_ekf.setIMUData(imu_sample_new);
 		PublishAttitude(now); // publish attitude immediately (uses quaternion from output predictor)
 
-		// integrate time to monitor time slippage
-		if (_start_time_us > 0) {
-			_integrated_time_us += imu_dt;
-			_last_time_slip_us = (imu_sample_new.time_us - _start_time_us) - _integrated_time_us;
-
-		} else {
-			_start_time_us = imu_sample_new.time_us;
-			_last_time_slip_us = 0;
-		}
+		UpdateTimeSlip(imu_sample_new, imu_dt);
 
 		// update all other topics if they have new data
 		if (_status_sub.updated()) {
@@ -586,7 +508,9 @@ void EKF2::Run()
 			.visual_odometry_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID,
 		};
 
+#if defined(CONFIG_EKF2_WIND)
 		UpdateAirspeedSample(ekf2_timestamps);
+#endif // CONFIG_EKF2_WIND
 		UpdateAuxVelSample(ekf2_timestamps);
 		UpdateBaroSample(ekf2_timestamps);
 		UpdateFlowSample(ekf2_timestamps);
@@ -600,7 +524,7 @@ void EKF2::Run()
 		// run the EKF update and output
 		const hrt_abstime ekf_update_start = hrt_absolute_time();
 
-		if (_ekf.update()) {
+		if (_ekf.update() || ekf_batch_updated) {
 			perf_set_elapsed(_ecl_ekf_update_full_perf, hrt_elapsed_time(&ekf_update_start));
 
 			PublishLocalPosition(now);
@@ -979,6 +903,11 @@ void EKF2::PublishGpsStatus(const hrt_abstime &timestamp)
 
 void EKF2::PublishInnovations(const hrt_abstime &timestamp)
 {
+	// the innovations are still needed for the pre-flight checks below
+	if (_ekf.control_status_flags().in_air && !_estimator_innovations_pub.has_subscribers()) {
+		return;
+	}
+
 	// publish estimator innovation data
 	estimator_innovations_s innovations{};
 	innovations.timestamp_sample = _ekf.get_imu_sample_delayed().time_us;
@@ -1020,6 +949,10 @@ void EKF2::PublishInnovations(const hrt_abstime &timestamp)
 
 void EKF2::PublishInnovationTestRatios(const hrt_abstime &timestamp)
 {
+	if (!_estimator_innovation_test_ratios_pub.has_subscribers()) {
+		return;
+	}
+
 	// publish estimator innovation test ratio data
 	estimator_innovations_s test_ratios{};
 	test_ratios.timestamp_sample = _ekf.get_imu_sample_delayed().time_us;
@@ -1046,6 +979,10 @@ void EKF2::PublishInnovationTestRatios(const hrt_abstime &timestamp)
 
 void EKF2::PublishInnovationVariances(const hrt_abstime &timestamp)
 {
+	if (!_estimator_innovation_variances_pub.has_subscribers()) {
+		return;
+	}
+
 	// publish estimator innovation variance data
 	estimator_innovations_s variances{};
 	variances.timestamp_sample = _ekf.get_imu_sample_delayed().time_us;
@@ -1306,6 +1243,10 @@ void EKF2::PublishSensorBias(const hrt_abstime &timestamp)
 
 void EKF2::PublishStates(const hrt_abstime &timestamp)
 {
+	if (!_estimator_states_pub.has_subscribers()) {
+		return;
+	}
+
 	// publish estimator states
 	estimator_states_s states;
 	states.timestamp_sample = _ekf.get_imu_sample_delayed().time_us;
@@ -1365,6 +1306,26 @@ void EKF2::PublishStatus(const hrt_abstime &timestamp)
 
 	status.timestamp = _replay_mode ? timestamp : hrt_absolute_time();
 	_estimator_status_pub.publish(status);
+
+#if !defined(CONSTRAINED_FLASH)
+
+	if (_multi_mode && (_instance >= 0) && (_instance < EKF2_MAX_INSTANCES)) {
+		const EKF2StatusSummary summary{
+			.timestamp = status.timestamp,
+			.accel_device_id = status.accel_device_id,
+			.gyro_device_id = status.gyro_device_id,
+			.baro_device_id = status.baro_device_id,
+			.mag_device_id = status.mag_device_id,
+			.vel_test_ratio = status.vel_test_ratio,
+			.pos_test_ratio = status.pos_test_ratio,
+			.hgt_test_ratio = status.hgt_test_ratio,
+			.filter_fault_flags = status.filter_fault_flags,
+		};
+
+		EKF2Selector::StatusMailbox(_instance).publish(summary);
+	}
+
+#endif // !CONSTRAINED_FLASH
 }
 
 void EKF2::PublishStatusFlags(const hrt_abstime &timestamp)
@@ -1474,15 +1435,25 @@ void EKF2::PublishStatusFlags(const hrt_abstime &timestamp)
 
 void EKF2::PublishYawEstimatorStatus(const hrt_abstime &timestamp)
 {
-	static_assert(sizeof(yaw_estimator_status_s::yaw) / sizeof(float) == N_MODELS_EKFGSF,
-		      "yaw_estimator_status_s::yaw wrong size");
+	// the message holds the first models only if the bank is larger (CONFIG_EKF2_GSF_N_MODELS)
+	static constexpr size_t n_logged = sizeof(yaw_estimator_status_s::yaw) / sizeof(float);
+
+	yaw_estimator_status_s yaw_est_test_data{};
 
-	yaw_estimator_status_s yaw_est_test_data;
+	float yaw[N_MODELS_EKFGSF];
+	float innov_vn[N_MODELS_EKFGSF];
+	float innov_ve[N_MODELS_EKFGSF];
+	float weight[N_MODELS_EKFGSF];
 
 	if (_ekf.getDataEKFGSF(&yaw_est_test_data.yaw_composite, &yaw_est_test_data.yaw_variance,
-			       yaw_est_test_data.yaw,
-			       yaw_est_test_data.innov_vn, yaw_est_test_data.innov_ve,
-			       yaw_est_test_data.weight)) {
+			       yaw, innov_vn, innov_ve, weight)) {
+
+		for (size_t i = 0; i < math::min(n_logged, (size_t)N_MODELS_EKFGSF); i++) {
+			yaw_est_test_data.yaw[i] = yaw[i];
+			yaw_est_test_data.innov_vn[i] = innov_vn[i];
+			yaw_est_test_data.innov_ve[i] = innov_ve[i];
+			yaw_est_test_data.weight[i] = weight[i];
+		}
 
 		yaw_est_test_data.yaw_composite_valid = _ekf.isYawEmergencyEstimateAvailable();
 		yaw_est_test_data.timestamp_sample = _ekf.get_imu_sample_delayed().time_us;
@@ -1558,6 +1529,7 @@ float EKF2::filter_altitude_ellipsoid(float amsl_hgt)
 	return amsl_hgt + _wgs84_hgt_offset;
 }
 
+#if defined(CONFIG_EKF2_WIND)
 void EKF2::UpdateAirspeedSample(ekf2_timestamps_s &ekf2_timestamps)
 {
 	// EKF airspeed sample
@@ -1624,6 +1596,7 @@ void EKF2::UpdateAirspeedSample(ekf2_timestamps_s &ekf2_timestamps)
 		}
 	}
 }
+#endif // CONFIG_EKF2_WIND
 
 void EKF2::UpdateAuxVelSample(ekf2_timestamps_s &ekf2_timestamps)
 {
@@ -1956,6 +1929,159 @@ void EKF2::UpdateGpsSample(ekf2_timestamps_s &ekf2_timestamps)
 	}
 }
 
+bool EKF2::UpdateImuSample(imuSample &imu_sample, hrt_abstime &imu_dt)
+{
+	bool imu_updated = false;
+
+	if (_multi_mode) {
+		const unsigned last_generation = _vehicle_imu_sub.get_last_generation();
+		vehicle_imu_s imu;
+		imu_updated = _vehicle_imu_sub.update(&imu);
+
+		if (imu_updated && (_vehicle_imu_sub.get_last_generation() != last_generation + 1)) {
+			perf_count(_msg_missed_imu_perf);
+		}
+
+		if (imu_updated) {
+			imu_sample.time_us = imu.timestamp_sample;
+			imu_sample.delta_ang_dt = imu.delta_angle_dt * 1.e-6f;
+			imu_sample.delta_ang = Vector3f{imu.delta_angle};
+			imu_sample.delta_vel_dt = imu.delta_velocity_dt * 1.e-6f;
+			imu_sample.delta_vel = Vector3f{imu.delta_velocity};
+
+			if (imu.delta_velocity_clipping > 0) {
+				imu_sample.delta_vel_clipping[0] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_X;
+				imu_sample.delta_vel_clipping[1] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_Y;
+				imu_sample.delta_vel_clipping[2] = imu.delta_velocity_clipping & vehicle_imu_s::CLIPPING_Z;
+			}
+
+			imu_dt = imu.delta_angle_dt;
+
+			if ((_device_id_accel == 0) || (_device_id_gyro == 0)) {
+				_device_id_accel = imu.accel_device_id;
+				_device_id_gyro = imu.gyro_device_id;
+				_accel_calibration_count = imu.accel_calibration_count;
+				_gyro_calibration_count = imu.gyro_calibration_count;
+
+			} else {
+				if ((imu.accel_calibration_count != _accel_calibration_count)
+				    || (imu.accel_device_id != _device_id_accel)) {
+
+					PX4_DEBUG("%d - resetting accelerometer bias", _instance);
+					_device_id_accel = imu.accel_device_id;
+
+					_ekf.resetAccelBias();
+					_accel_calibration_count = imu.accel_calibration_count;
+
+					// reset bias learning
+					_accel_cal = {};
+				}
+
+				if ((imu.gyro_calibration_count != _gyro_calibration_count)
+				    || (imu.gyro_device_id != _device_id_gyro)) {
+
+					PX4_DEBUG("%d - resetting rate gyro bias", _instance);
+					_device_id_gyro = imu.gyro_device_id;
+
+					_ekf.resetGyroBias();
+					_gyro_calibration_count = imu.gyro_calibration_count;
+
+					// reset bias learning
+					_gyro_cal = {};
+				}
+			}
+		}
+
+	} else {
+		const unsigned last_generation = _sensor_combined_sub.get_last_generation();
+		sensor_combined_s sensor_combined;
+		imu_updated = _sensor_combined_sub.update(&sensor_combined);
+
+		if (imu_updated && (_sensor_combined_sub.get_last_generation() != last_generation + 1)) {
+			perf_count(_msg_missed_imu_perf);
+		}
+
+		if (imu_updated) {
+			imu_sample.time_us = sensor_combined.timestamp;
+			imu_sample.delta_ang_dt = sensor_combined.gyro_integral_dt * 1.e-6f;
+			imu_sample.delta_ang = Vector3f{sensor_combined.gyro_rad} * imu_sample.delta_ang_dt;
+			imu_sample.delta_vel_dt = sensor_combined.accelerometer_integral_dt * 1.e-6f;
+			imu_sample.delta_vel = Vector3f{sensor_combined.accelerometer_m_s2} * imu_sample.delta_vel_dt;
+
+			if (sensor_combined.accelerometer_clipping > 0) {
+				imu_sample.delta_vel_clipping[0] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_X;
+				imu_sample.delta_vel_clipping[1] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_Y;
+				imu_sample.delta_vel_clipping[2] = sensor_combined.accelerometer_clipping & sensor_combined_s::CLIPPING_Z;
+			}
+
+			imu_dt = sensor_combined.gyro_integral_dt;
+
+			if (sensor_combined.accel_calibration_count != _accel_calibration_count) {
+
+				PX4_DEBUG("%d - resetting accelerometer bias", _instance);
+
+				_ekf.resetAccelBias();
+				_accel_calibration_count = sensor_combined.accel_calibration_count;
+
+				// reset bias learning
+				_accel_cal = {};
+			}
+
+			if (sensor_combined.gyro_calibration_count != _gyro_calibration_count) {
+
+				PX4_DEBUG("%d - resetting rate gyro bias", _instance);
+
+				_ekf.resetGyroBias();
+				_gyro_calibration_count = sensor_combined.gyro_calibration_count;
+
+				// reset bias learning
+				_gyro_cal = {};
+			}
+		}
+
+		if (_sensor_selection_sub.updated() || (_device_id_accel == 0 || _device_id_gyro == 0)) {
+			sensor_selection_s sensor_selection;
+
+			if (_sensor_selection_sub.copy(&sensor_selection)) {
+				if (_device_id_accel != sensor_selection.accel_device_id) {
+
+					_device_id_accel = sensor_selection.accel_device_id;
+
+					_ekf.resetAccelBias();
+
+					// reset bias learning
+					_accel_cal = {};
+				}
+
+				if (_device_id_gyro != sensor_selection.gyro_device_id) {
+
+					_device_id_gyro = sensor_selection.gyro_device_id;
+
+					_ekf.resetGyroBias();
+
+					// reset bias learning
+					_gyro_cal = {};
+				}
+			}
+		}
+	}
+
+	return imu_updated;
+}
+
+void EKF2::UpdateTimeSlip(const imuSample &imu_sample, const hrt_abstime imu_dt)
+{
+	// integrate time to monitor time slippage
+	if (_start_time_us > 0) {
+		_integrated_time_us += imu_dt;
+		_last_time_slip_us = (imu_sample.time_us - _start_time_us) - _integrated_time_us;
+
+	} else {
+		_start_time_us = imu_sample.time_us;
+		_last_time_slip_us = 0;
+	}
+}
+
 void EKF2::UpdateMagSample(ekf2_timestamps_s &ekf2_timestamps)
 {
 	const unsigned last_generation = _magnetometer_sub.get_last_generation();
@@ -2173,8 +2299,38 @@ void EKF2::UpdateMagCalibration(const hrt_abstime &timestamp)
 	}
 }
 
+#if defined(ECL_PROFILING)
+static void print_profile()
+{
+	using namespace ecl::profiling;
+
+	// machine readable, same format as 'microbench -c'
+	for (int i = 0; i < static_cast<int>(Section::Count); i++) {
+		const Section section = static_cast<Section>(i);
+		const Stats &s = stats(section);
+		const double mean_us = (s.calls > 0) ? (double)s.elapsed_ns / (double)s.calls / 1000.0 : 0.0;
+		PX4_INFO_RAW("EKF2_PROFILE,%s,%" PRIu32 ",%.3f\n", name(section), s.calls, mean_us);
+	}
+}
+#endif // ECL_PROFILING
+
 int EKF2::custom_command(int argc, char *argv[])
 {
+#if defined(ECL_PROFILING)
+
+	if (argc > 0 && strcmp(argv[0], "profile") == 0) {
+		if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+			ecl::profiling::reset();
+
+		} else {
+			print_profile();
+		}
+
+		return 0;
+	}
+
+#endif // ECL_PROFILING
+
 	return print_usage("unknown command");
 }
 
@@ -2283,7 +2439,11 @@ int EKF2::task_spawn(int argc, char *argv[])
 					if ((vehicle_mag_sub.advertised() || mag == 0) && (vehicle_imu_sub.advertised())) {
 
 						if (!ekf2_instance_created[imu][mag]) {
+#if defined(CONFIG_EKF2_INSTANCE_PER_CORE)
+							EKF2 *ekf2_inst = new EKF2(true, instance_to_wq(multi_instances_allocated), false);
+#else
 							EKF2 *ekf2_inst = new EKF2(true, px4::ins_instance_to_wq(imu), false);
+#endif // CONFIG_EKF2_INSTANCE_PER_CORE
 
 							if (ekf2_inst && ekf2_inst->multi_init(imu, mag)) {
 								int actual_instance = ekf2_inst->instance(); // match uORB instance numbering
@@ -2369,6 +2529,10 @@ timestamps from the sensor topics.
 	PRINT_MODULE_USAGE_COMMAND_DESCR("select_instance", "Request switch to new estimator instance");
 	PRINT_MODULE_USAGE_ARG("<instance>", "Specify desired estimator instance", false);
 #endif // !CONSTRAINED_FLASH
+#if defined(ECL_PROFILING)
+	PRINT_MODULE_USAGE_COMMAND_DESCR("profile", "Print the execution time of the prediction and fusion steps");
+	PRINT_MODULE_USAGE_ARG("reset", "Reset the statistics", true);
+#endif // ECL_PROFILING
 	return 0;
 }
 
@@ -2431,6 +2595,11 @@ extern "C" __EXPORT int ekf2_main(int argc, char *argv[])
 				}
 			}
 
+#if defined(ECL_PROFILING)
+			PX4_INFO_RAW("\n");
+			print_profile();
+#endif // ECL_PROFILING
+
 			EKF2::unlock_module();
 
 		} else {
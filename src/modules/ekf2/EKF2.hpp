@@ -133,6 +133,10 @@ private:
 	static constexpr uint8_t MAX_NUM_IMUS = 4;
 	static constexpr uint8_t MAX_NUM_MAGS = 4;
 
+	// maximum number of IMU samples processed per run (queued by uORB)
+	static constexpr uint8_t IMU_QUEUE_LENGTH = vehicle_imu_s::ORB_QUEUE_LENGTH;
+	static_assert(sensor_combined_s::ORB_QUEUE_LENGTH == IMU_QUEUE_LENGTH, "IMU topic queue lengths differ");
+
 	void Run() override;
 
 	void VerifyParams();
@@ -162,15 +166,20 @@ private:
 	void PublishWindEstimate(const hrt_abstime &timestamp);
 	void PublishYawEstimatorStatus(const hrt_abstime &timestamp);
 
+#if defined(CONFIG_EKF2_WIND)
 	void UpdateAirspeedSample(ekf2_timestamps_s &ekf2_timestamps);
+#endif // CONFIG_EKF2_WIND
 	void UpdateAuxVelSample(ekf2_timestamps_s &ekf2_timestamps);
 	void UpdateBaroSample(ekf2_timestamps_s &ekf2_timestamps);
 	bool UpdateExtVisionSample(ekf2_timestamps_s &ekf2_timestamps, vehicle_odometry_s &ev_odom);
 	bool UpdateFlowSample(ekf2_timestamps_s &ekf2_timestamps);
 	void UpdateGpsSample(ekf2_timestamps_s &ekf2_timestamps);
+	bool UpdateImuSample(imuSample &imu_sample, hrt_abstime &imu_dt);
 	void UpdateMagSample(ekf2_timestamps_s &ekf2_timestamps);
 	void UpdateRangeSample(ekf2_timestamps_s &ekf2_timestamps);
 
+	void UpdateTimeSlip(const imuSample &imu_sample, const hrt_abstime imu_dt);
+
 	// Used to check, save and use learned accel/gyro/mag biases
 	struct InFlightCalibration {
 		hrt_abstime last_us{0};         ///< last time the EKF was operating a mode that estimates accelerometer biases (uSec)
@@ -189,7 +198,7 @@ private:
 	template <typename T>
 	void PublishAidSourceStatus(const T &status, hrt_abstime &status_publish_last, uORB::PublicationMulti<T> &pub)
 	{
-		if (status.timestamp_sample > status_publish_last) {
+		if ((status.timestamp_sample > status_publish_last) && pub.has_subscribers()) {
 			// publish if updated
 			T status_out{status};
 			status_out.estimator_instance = _instance;
@@ -293,8 +302,10 @@ private:
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
 	uORB::Subscription _airdata_sub{ORB_ID(vehicle_air_data)};
+#if defined(CONFIG_EKF2_WIND)
 	uORB::Subscription _airspeed_sub{ORB_ID(airspeed)};
 	uORB::Subscription _airspeed_validated_sub{ORB_ID(airspeed_validated)};
+#endif // CONFIG_EKF2_WIND
 	uORB::Subscription _ev_odom_sub{ORB_ID(vehicle_visual_odometry)};
 	uORB::Subscription _landing_target_pose_sub{ORB_ID(landing_target_pose)};
 	uORB::Subscription _magnetometer_sub{ORB_ID(vehicle_magnetometer)};
@@ -380,6 +391,7 @@ private:
 
 	DEFINE_PARAMETERS(
 		(ParamExtInt<px4::params::EKF2_PREDICT_US>) _param_ekf2_predict_us,
+		(ParamInt<px4::params::EKF2_IMU_BATCH>) _param_ekf2_imu_batch,
 		(ParamExtFloat<px4::params::EKF2_MAG_DELAY>)
 		_param_ekf2_mag_delay,	///< magnetometer measurement delay relative to the IMU (mSec)
 		(ParamExtFloat<px4::params::EKF2_BARO_DELAY>)
@@ -416,6 +428,8 @@ private:
 		(ParamExtFloat<px4::params::EKF2_TERR_NOISE>) _param_ekf2_terr_noise,	///< process noise for terrain offset (m/sec)
 		(ParamExtFloat<px4::params::EKF2_TERR_GRAD>)
 		_param_ekf2_terr_grad,	///< gradient of terrain used to estimate process noise due to changing position (m/m)
+		(ParamExtFloat<px4::params::EKF2_TERR_CELL>)
+		_param_ekf2_terr_cell,	///< size of the cells of the terrain map (m)
 
 		(ParamExtFloat<px4::params::EKF2_GPS_V_NOISE>)
 		_param_ekf2_gps_v_noise,	///< minimum allowed observation noise for gps velocity fusion (m/sec)
@@ -607,6 +621,8 @@ private:
 		(ParamExtInt<px4::params::EKF2_MAG_CHECK>) _param_ekf2_mag_check, ///< Mag field strength check
 		(ParamExtInt<px4::params::EKF2_SYNT_MAG_Z>)
 		_param_ekf2_synthetic_mag_z, ///< Enables the use of a synthetic value for the Z axis of the magnetometer calculated from the 3D magnetic field vector at the location of the drone.
+		(ParamExtInt<px4::params::EKF2_FUSE_SPREAD>)
+		_param_ekf2_fuse_spread, ///< spread mag and GPS fusion over consecutive filter updates
 
 		// Used by EKF-GSF experimental yaw estimator
 		(ParamExtFloat<px4::params::EKF2_GSF_TAS>)
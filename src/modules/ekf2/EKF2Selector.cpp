@@ -39,6 +39,8 @@ using matrix::Vector2f;
 using math::constrain;
 using math::radians;
 
+EKF2StatusMailbox EKF2Selector::_status_mailbox[EKF2_MAX_INSTANCES] {};
+
 EKF2Selector::EKF2Selector() :
 	ModuleParams(nullptr),
 	ScheduledWorkItem("ekf2_selector", px4::wq_configurations::nav_and_controllers)
@@ -55,6 +57,10 @@ EKF2Selector::EKF2Selector() :
 EKF2Selector::~EKF2Selector()
 {
 	Stop();
+
+	perf_free(_cycle_perf);
+	perf_free(_instance_change_perf);
+	perf_free(_instance_change_unhealthy_perf);
 }
 
 void EKF2Selector::Stop()
@@ -123,6 +129,12 @@ bool EKF2Selector::SelectInstance(uint8_t ekf_instance)
 			_instance[_selected_instance].estimator_status_sub.unregisterCallback();
 
 			PrintInstanceChange(_selected_instance, ekf_instance);
+
+			perf_count(_instance_change_perf);
+
+			if (!_instance[_selected_instance].healthy.get_state()) {
+				perf_count(_instance_change_unhealthy_perf);
+			}
 		}
 
 		_instance[ekf_instance].estimator_attitude_sub.registerCallback();
@@ -258,9 +270,9 @@ bool EKF2Selector::UpdateErrorScores()
 	for (uint8_t i = 0; i < EKF2_MAX_INSTANCES; i++) {
 		const bool prev_healthy = _instance[i].healthy.get_state();
 
-		estimator_status_s status;
+		EKF2StatusSummary status;
 
-		if (_instance[i].estimator_status_sub.update(&status)) {
+		if (_status_mailbox[i].update(status, _instance[i].status_sequence)) {
 
 			_instance[i].timestamp_last = status.timestamp;
 
@@ -274,10 +286,6 @@ bool EKF2Selector::UpdateErrorScores()
 				updated = true;
 			}
 
-			if (i == _selected_instance) {
-				primary_updated = true;
-			}
-
 			// test ratios are invalid when 0, >= 1 is a failure
 			if (!PX4_ISFINITE(status.vel_test_ratio) || (status.vel_test_ratio <= 0.f)) {
 				status.vel_test_ratio = 1.f;
@@ -310,6 +318,14 @@ bool EKF2Selector::UpdateErrorScores()
 				_instance[i].relative_test_ratio = 0;
 			}
 
+			// score only the instances with a new status, each against the latest status of the selected instance
+			if (i == _selected_instance) {
+				primary_updated = true;
+
+			} else {
+				UpdateRelativeTestRatio(i);
+			}
+
 		} else if (!_instance[i].timeout && (hrt_elapsed_time(&_instance[i].timestamp_last) > status_timeout)) {
 			_instance[i].healthy.set_state_and_update(false, hrt_absolute_time());
 			_instance[i].timeout = true;
@@ -335,30 +351,33 @@ bool EKF2Selector::UpdateErrorScores()
 		}
 	}
 
-	// update relative test ratios if primary has updated
-	if (primary_updated) {
-		for (uint8_t i = 0; i < _available_instances; i++) {
-			if (i != _selected_instance) {
+	return (primary_updated || updated);
+}
+
+void EKF2Selector::UpdateRelativeTestRatio(uint8_t instance)
+{
+	// nothing to compare against until the selected instance reports again
+	if ((_selected_instance == INVALID_INSTANCE) || _instance[_selected_instance].timeout
+	    || !PX4_ISFINITE(_instance[_selected_instance].combined_test_ratio)) {
+		return;
+	}
 
-				const float error_delta = _instance[i].combined_test_ratio - _instance[_selected_instance].combined_test_ratio;
+	EstimatorInstance &inst = _instance[instance];
 
-				// reduce error only if its better than the primary instance by at least EKF2_SEL_ERR_RED to prevent unnecessary selection changes
-				const float threshold = _gyro_fault_detected ? 0.0f : fmaxf(_param_ekf2_sel_err_red.get(), 0.05f);
+	const float error_delta = inst.combined_test_ratio - _instance[_selected_instance].combined_test_ratio;
 
-				if (error_delta > 0 || error_delta < -threshold) {
-					_instance[i].relative_test_ratio += error_delta;
-					_instance[i].relative_test_ratio = constrain(_instance[i].relative_test_ratio, -_rel_err_score_lim, _rel_err_score_lim);
+	// reduce error only if its better than the primary instance by at least EKF2_SEL_ERR_RED to prevent unnecessary selection changes
+	const float threshold = _gyro_fault_detected ? 0.0f : fmaxf(_param_ekf2_sel_err_red.get(), 0.05f);
 
-					if ((error_delta < -threshold) && (_instance[i].relative_test_ratio < 1.f)) {
-						// increase status publication rate if there's movement towards a potential instance change
-						_selector_status_publish = true;
-					}
-				}
-			}
+	if (error_delta > 0 || error_delta < -threshold) {
+		inst.relative_test_ratio += error_delta;
+		inst.relative_test_ratio = constrain(inst.relative_test_ratio, -_rel_err_score_lim, _rel_err_score_lim);
+
+		if ((error_delta < -threshold) && (inst.relative_test_ratio < 1.f)) {
+			// increase status publication rate if there's movement towards a potential instance change
+			_selector_status_publish = true;
 		}
 	}
-
-	return (primary_updated || updated);
 }
 
 void EKF2Selector::PublishVehicleAttitude()
@@ -674,6 +693,8 @@ void EKF2Selector::PublishWindEstimate()
 
 void EKF2Selector::Run()
 {
+	perf_begin(_cycle_perf);
+
 	// check for parameter updates
 	if (_parameter_update_sub.updated()) {
 		// clear update
@@ -702,6 +723,7 @@ void EKF2Selector::Run()
 		// if still invalid return early and check again on next scheduled run
 		if (_selected_instance == INVALID_INSTANCE) {
 			ScheduleDelayed(100_ms);
+			perf_end(_cycle_perf);
 			return;
 		}
 	}
@@ -805,6 +827,8 @@ void EKF2Selector::Run()
 
 	// re-schedule as backup timeout
 	ScheduleDelayed(FILTER_UPDATE_PERIOD);
+
+	perf_end(_cycle_perf);
 }
 
 void EKF2Selector::PublishEstimatorSelectorStatus()
@@ -841,6 +865,10 @@ void EKF2Selector::PrintStatus()
 {
 	PX4_INFO("available instances: %" PRIu8, _available_instances);
 
+	perf_print_counter(_cycle_perf);
+	perf_print_counter(_instance_change_perf);
+	perf_print_counter(_instance_change_unhealthy_perf);
+
 	if (_selected_instance == INVALID_INSTANCE) {
 		PX4_WARN("selected instance: None");
 	}
@@ -34,6 +34,8 @@
 #ifndef EKF2SELECTOR_HPP
 #define EKF2SELECTOR_HPP
 
+#include "EKF2StatusMailbox.hpp"
+
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/module.h>
@@ -41,6 +43,7 @@
 #include <px4_platform_common/time.h>
 #include <lib/hysteresis/hysteresis.h>
 #include <lib/mathlib/mathlib.h>
+#include <lib/perf/perf_counter.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
@@ -76,6 +79,9 @@ public:
 
 	void RequestInstance(uint8_t instance) { _request_instance.store(instance); }
 
+	// status of every estimator instance, written by the instance each cycle
+	static EKF2StatusMailbox &StatusMailbox(uint8_t instance) { return _status_mailbox[instance]; }
+
 private:
 	static constexpr uint8_t INVALID_INSTANCE{UINT8_MAX};
 	static constexpr uint64_t FILTER_UPDATE_PERIOD{10_ms};
@@ -96,6 +102,9 @@ private:
 	// Update the error scores for all available instances
 	bool UpdateErrorScores();
 
+	// Accumulate the error of an instance with a new status relative to the selected instance
+	void UpdateRelativeTestRatio(uint8_t instance);
+
 	// Subscriptions (per estimator instance)
 	struct EstimatorInstance {
 
@@ -120,6 +129,7 @@ private:
 		uORB::Subscription estimator_wind_sub;
 
 		uint64_t timestamp_last{0};
+		uint32_t status_sequence{0};
 
 		uint32_t accel_device_id{0};
 		uint32_t gyro_device_id{0};
@@ -143,6 +153,9 @@ private:
 		const uint8_t instance;
 	};
 
+	// read lock-free instead of one estimator_status subscription per instance
+	static EKF2StatusMailbox _status_mailbox[EKF2_MAX_INSTANCES];
+
 	static constexpr float _rel_err_score_lim{1.0f}; // +- limit applied to the relative error score
 	static constexpr float _rel_err_thresh{0.5f};    // the relative score difference needs to be greater than this to switch from an otherwise healthy instance
 
@@ -187,6 +200,10 @@ private:
 	uint32_t _instance_changed_count{0};
 	hrt_abstime _last_instance_change{0};
 
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": selector cycle")};
+	perf_counter_t _instance_change_perf{perf_alloc(PC_COUNT, MODULE_NAME": selector instance change")};
+	perf_counter_t _instance_change_unhealthy_perf{perf_alloc(PC_COUNT, MODULE_NAME": selector instance change (unhealthy)")};
+
 	hrt_abstime _last_status_publish{0};
 	bool _selector_status_publish{false};
 
@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file EKF2StatusMailbox.hpp
+ *
+ * Lock-free hand over of the status an EKF2 instance reports to the EKF2Selector.
+ * There is a single writer (the estimator instance), readers never block it and
+ * retry if the writer updated the mailbox while they were copying.
+ */
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+#include <drivers/drv_hrt.h>
+
+#include <stdint.h>
+
+struct EKF2StatusSummary {
+	hrt_abstime timestamp;
+
+	uint32_t accel_device_id;
+	uint32_t gyro_device_id;
+	uint32_t baro_device_id;
+	uint32_t mag_device_id;
+
+	float vel_test_ratio;
+	float pos_test_ratio;
+	float hgt_test_ratio;
+
+	uint32_t filter_fault_flags;
+};
+
+class EKF2StatusMailbox
+{
+public:
+	void publish(const EKF2StatusSummary &status)
+	{
+		// odd sequence: write in progress
+		_sequence.fetch_add(1);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+
+		_status = status;
+
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		_sequence.fetch_add(1);
+	}
+
+	/**
+	 * Copy the latest status if it changed since the last successful read.
+	 * @param status output
+	 * @param last_sequence sequence of the previous read (updated on success), 0 initially
+	 * @return true if a new status was copied
+	 */
+	bool update(EKF2StatusSummary &status, uint32_t &last_sequence) const
+	{
+		for (int retry = 0; retry < 4; retry++) {
+			const uint32_t sequence = _sequence.load();
+
+			if (sequence == last_sequence) {
+				return false;
+			}
+
+			if (sequence & 1) {
+				// the writer is only a few stores into the update
+				continue;
+			}
+
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			status = _status;
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (_sequence.load() == sequence) {
+				last_sequence = sequence;
+				return true;
+			}
+		}
+
+		// the writer is busy, the next cycle will get it
+		return false;
+	}
+
+private:
+	px4::atomic<uint32_t> _sequence{0};
+	EKF2StatusSummary _status{};
+};
@@ -52,6 +52,20 @@
  */
 PARAM_DEFINE_INT32(EKF2_PREDICT_US, 10000);
 
+/**
+ * IMU samples per estimator run
+ *
+ * Number of IMU samples that are queued before the estimator is scheduled. Larger
+ * values reduce the scheduling overhead at the cost of latency of the estimator outputs.
+ * Queued samples are always processed in order, regardless of this setting.
+ *
+ * @group EKF2
+ * @min 1
+ * @max 4
+ * @reboot_required true
+ */
+PARAM_DEFINE_INT32(EKF2_IMU_BATCH, 1);
+
 /**
  * Magnetometer measurement delay relative to IMU measurements
  *
@@ -873,6 +887,22 @@ PARAM_DEFINE_FLOAT(EKF2_TERR_NOISE, 5.0f);
  */
 PARAM_DEFINE_FLOAT(EKF2_TERR_GRAD, 0.5f);
 
+/**
+ * Terrain map cell size
+ *
+ * Size of the fine cells of the terrain map used by the terrain estimator when no sensor
+ * observes the terrain. The map covers 16 x 16 cells, and 16 x 16 cells that are 8 times
+ * larger, around the area last flown over. Set to 0 to disable the map.
+ * Only used if the terrain map is included in the build (EKF2_TERRAIN_GRID).
+ *
+ * @group EKF2
+ * @min 0.0
+ * @max 50.0
+ * @unit m
+ * @decimal 1
+ */
+PARAM_DEFINE_FLOAT(EKF2_TERR_CELL, 5.0f);
+
 /**
  * X position of IMU in body frame (forward axis with origin relative to vehicle centre of gravity)
  *
@@ -1419,6 +1449,18 @@ PARAM_DEFINE_INT32(EKF2_MAG_CHECK, 1);
 */
 PARAM_DEFINE_INT32(EKF2_SYNT_MAG_Z, 0);
 
+/**
+ * Spread measurement fusion over the fusion time horizon steps.
+ *
+ * When enabled, a magnetometer sample reaching the fusion time horizon in the same filter update as a GPS sample
+ * is left in the buffer and fused on the next update instead. This bounds the worst case execution time of a single
+ * filter update at the cost of delaying magnetometer fusion by one filter update period (EKF2_PREDICT_US).
+ *
+ * @group EKF2
+ * @boolean
+ */
+PARAM_DEFINE_INT32(EKF2_FUSE_SPREAD, 0);
+
 /**
  * Default value of true airspeed used in EKF-GSF AHRS calculation.
  *
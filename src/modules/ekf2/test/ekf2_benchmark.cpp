@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ekf2_benchmark.cpp
+ *
+ * Replays the recorded sensor data in replay_data/ through the estimator (no uORB) and reports
+ * the execution time of the prediction and fusion steps. Usage:
+ *   ekf2_benchmark [output.csv]
+ * The optional csv output (one line per replay and section) can be used to track the results over time.
+ * Times are inclusive, e.g. fuseVelPosHeight contains the time spent in fuse().
+ */
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+
+#include "EKF/ekf.h"
+#include "sensor_simulator/sensor_simulator.h"
+#include "sensor_simulator/ekf_wrapper.h"
+
+using namespace ecl::profiling;
+
+struct Replay {
+	const char *name;
+	float duration_s;
+};
+
+static constexpr Replay replays[] {
+	{"iris_gps", 35.f},
+	{"ekf_gsf_reset", 39.f},
+};
+
+static uint64_t runReplay(const Replay &replay)
+{
+	std::shared_ptr<Ekf> ekf = std::make_shared<Ekf>();
+	SensorSimulator sensor_simulator(ekf);
+	EkfWrapper ekf_wrapper(ekf);
+
+	sensor_simulator.loadSensorDataFromFile(std::string(TEST_DATA_PATH"/replay_data/") + replay.name + ".csv");
+	sensor_simulator.startGps();
+	ekf_wrapper.enableGpsFusion();
+
+	reset();
+
+	const auto start = std::chrono::steady_clock::now();
+	sensor_simulator.runReplaySeconds(replay.duration_s);
+	const auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *csv = nullptr;
+
+	if (argc > 1) {
+		csv = fopen(argv[1], "w");
+
+		if (csv == nullptr) {
+			printf("failed to open %s\n", argv[1]);
+			return 1;
+		}
+
+		fprintf(csv, "replay,section,calls,ns_per_call\n");
+	}
+
+	for (const Replay &replay : replays) {
+		const uint64_t total_ns = runReplay(replay);
+
+		printf("%s (%.0f s of data): %.1f ms total\n", replay.name, (double)replay.duration_s, total_ns * 1e-6);
+		printf("  %-20s %10s %14s\n", "section", "calls", "ns per call");
+
+		for (int i = 0; i < static_cast<int>(Section::Count); i++) {
+			const Section section = static_cast<Section>(i);
+			const Stats &s = stats(section);
+
+			if (s.calls == 0) {
+				continue;
+			}
+
+			const uint64_t ns_per_call = s.elapsed_ns / s.calls;
+			printf("  %-20s %10u %14llu\n", name(section), (unsigned)s.calls, (unsigned long long)ns_per_call);
+
+			if (csv) {
+				fprintf(csv, "%s,%s,%u,%llu\n", replay.name, name(section), (unsigned)s.calls, (unsigned long long)ns_per_call);
+			}
+		}
+
+		if (csv) {
+			fprintf(csv, "%s,total,1,%llu\n", replay.name, (unsigned long long)total_ns);
+		}
+	}
+
+	if (csv) {
+		fclose(csv);
+	}
+
+	return 0;
+}
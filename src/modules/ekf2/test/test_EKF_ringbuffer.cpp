@@ -158,3 +158,27 @@ TEST_F(EkfRingBufferTest, reallocateBuffer)
 	EXPECT_EQ(3, _buffer->get_length());
 
 }
+
+TEST_F(EkfRingBufferTest, reallocateKeepsStorage)
+{
+	ASSERT_EQ(true, _buffer->allocate(5));
+	const int total_size = _buffer->get_total_size();
+	_buffer->push(_x);
+	_buffer->push(_y);
+
+	// WHEN: the buffer is reallocated to a smaller size
+	ASSERT_EQ(true, _buffer->allocate(2));
+
+	// THEN: the storage is reused and the samples are cleared
+	EXPECT_EQ(2, _buffer->get_length());
+	EXPECT_EQ(total_size, _buffer->get_total_size());
+	EXPECT_EQ(0, _buffer->entries());
+
+	// AND: the smaller buffer wraps around at its new length
+	_buffer->push(_x);
+	_buffer->push(_y);
+	_buffer->push(_z);
+	EXPECT_EQ(_y.time_us, _buffer->get_oldest().time_us);
+	EXPECT_EQ(_z.time_us, _buffer->get_newest().time_us);
+	EXPECT_EQ(2, _buffer->entries());
+}
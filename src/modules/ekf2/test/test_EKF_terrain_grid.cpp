@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test the terrain map of the terrain estimator
+ */
+
+#include <gtest/gtest.h>
+#include "EKF/terrain_grid.hpp"
+
+using matrix::Vector2f;
+
+TEST(TerrainGridTest, disabledByDefault)
+{
+	TerrainGrid grid;
+	float vpos;
+	float var;
+
+	grid.update(Vector2f(1.f, 1.f), 10.f, 1.f, 0.5f);
+	EXPECT_FALSE(grid.enabled());
+	EXPECT_FALSE(grid.lookup(Vector2f(1.f, 1.f), vpos, var));
+}
+
+TEST(TerrainGridTest, storeAndMerge)
+{
+	TerrainGrid grid;
+	grid.setCellSize(5.f);
+	float vpos;
+	float var;
+
+	// WHEN: nothing has been stored
+	// THEN: there is no terrain height available
+	EXPECT_FALSE(grid.lookup(Vector2f(1.f, 1.f), vpos, var));
+
+	// WHEN: an estimate is stored
+	grid.update(Vector2f(1.f, 1.f), 10.f, 1.f, 0.f);
+
+	// THEN: it is returned for any position in the cell
+	EXPECT_TRUE(grid.lookup(Vector2f(4.9f, 0.1f), vpos, var));
+	EXPECT_FLOAT_EQ(vpos, 10.f);
+	EXPECT_FLOAT_EQ(var, 1.f);
+
+	// AND WHEN: a second estimate is stored in the same cell
+	grid.update(Vector2f(2.f, 2.f), 12.f, 1.f, 0.f);
+
+	// THEN: both are merged, without getting more confident than a single one
+	EXPECT_TRUE(grid.lookup(Vector2f(1.f, 1.f), vpos, var));
+	EXPECT_FLOAT_EQ(vpos, 11.f);
+	EXPECT_FLOAT_EQ(var, 0.5f);
+
+	// AND: the neighbouring fine cell is served by the coarse level
+	EXPECT_TRUE(grid.lookup(Vector2f(6.f, 1.f), vpos, var));
+	EXPECT_FLOAT_EQ(vpos, 11.f);
+	EXPECT_FALSE(grid.lookup(Vector2f(-1.f, -100.f), vpos, var));
+}
+
+TEST(TerrainGridTest, aliasing)
+{
+	TerrainGrid grid;
+	const float cell_size = 2.f;
+	grid.setCellSize(cell_size);
+	float vpos;
+	float var;
+
+	// WHEN: two cells that share the same storage on both levels are updated
+	const float distance = cell_size * TerrainGrid::SIZE * TerrainGrid::COARSE_SCALE;
+	grid.update(Vector2f(0.5f, 0.5f), 1.f, 1.f, 0.f);
+	grid.update(Vector2f(0.5f + distance, 0.5f), 2.f, 1.f, 0.f);
+
+	// THEN: only the most recent one is kept
+	EXPECT_FALSE(grid.lookup(Vector2f(0.5f, 0.5f), vpos, var));
+	EXPECT_TRUE(grid.lookup(Vector2f(0.5f + distance, 0.5f), vpos, var));
+	EXPECT_FLOAT_EQ(vpos, 2.f);
+
+	// WHEN: the cell size changes
+	grid.setCellSize(cell_size * 2.f);
+
+	// THEN: the map is cleared
+	EXPECT_FALSE(grid.lookup(Vector2f(0.5f + distance, 0.5f), vpos, var));
+}
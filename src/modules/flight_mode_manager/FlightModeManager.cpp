@@ -56,7 +56,7 @@ FlightModeManager::FlightModeManager() :
 
 FlightModeManager::~FlightModeManager()
 {
-	if (_current_task.task) {
+	if (_current_task.task && !_current_task.standby) {
 		_current_task.task->~FlightTask();
 	}
 
@@ -127,9 +127,12 @@ void FlightModeManager::updateParams()
 {
 	ModuleParams::updateParams();
 
-	if (isAnyTaskActive()) {
+	if (isAnyTaskActive() && !_current_task.standby) {
 		_current_task.task->handleParameterUpdate();
 	}
+
+	// inactive standby tasks keep their parameters up to date as well
+	_updateStandbyTaskParams();
 }
 
 void FlightModeManager::start_flight_task()
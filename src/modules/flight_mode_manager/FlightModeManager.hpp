@@ -116,6 +116,7 @@ private:
 
 	// generated
 	int _initTask(FlightTaskIndex task_index);
+	void _updateStandbyTaskParams();
 	FlightTaskIndex switchVehicleCommand(const int command);
 
 	static constexpr int NUM_FAILURE_TRIES = 10; ///< number of tries before switching to a failsafe flight task
@@ -125,10 +126,12 @@ private:
 	 * task is needed, and to avoid using dynamic memory allocations.
 	 */
 	TaskUnion _task_union; /**< storage for the currently active task */
+	StandbyTasks _standby_tasks; /**< tasks that stay constructed, switching to them does not run a constructor */
 
 	struct flight_task_t {
 		FlightTask *task{nullptr};
 		FlightTaskIndex index{FlightTaskIndex::None};
+		bool standby{false}; /**< task is one of _standby_tasks and must not be destroyed */
 	} _current_task{};
 
 	int8_t _old_landing_gear_position{landing_gear_s::GEAR_KEEP};
@@ -45,11 +45,15 @@
 int FlightModeManager::_initTask(FlightTaskIndex task_index)
 {
 
-	// disable the old task if there is any
+	// disable the old task if there is any, standby tasks stay constructed
 	if (_current_task.task) {
-		_current_task.task->~FlightTask();
+		if (!_current_task.standby) {
+			_current_task.task->~FlightTask();
+		}
+
 		_current_task.task = nullptr;
 		_current_task.index = FlightTaskIndex::None;
+		_current_task.standby = false;
 	}
 
 	switch (task_index) {
@@ -61,7 +65,13 @@ int FlightModeManager::_initTask(FlightTaskIndex task_index)
 @[if tasks]@
 @[for task in tasks]@
 	case FlightTaskIndex::@(task):
+@[if task in tasks_standby]@
+		_standby_tasks.@(task).resetState();
+		_current_task.task = &_standby_tasks.@(task);
+		_current_task.standby = true;
+@[else]@
 		_current_task.task = new (&_task_union.@(task)) FlightTask@(task)();
+@[end if]@
 		break;
 
 @[end for]@
@@ -76,6 +86,13 @@ int FlightModeManager::_initTask(FlightTaskIndex task_index)
 	return 0;
 }
 
+void FlightModeManager::_updateStandbyTaskParams()
+{
+@[for task in tasks_standby]@
+	_standby_tasks.@(task).handleParameterUpdate();
+@[end for]@
+}
+
 FlightTaskIndex FlightModeManager::switchVehicleCommand(const int command)
 {
     switch (command) {
@@ -66,10 +66,19 @@ union TaskUnion {
     TaskUnion() {}
     ~TaskUnion() {}
 
-@# loop through all requested tasks
+@# loop through all requested tasks that are constructed on activation
 @[if tasks]@
 @[for task in tasks]@
+@[if task not in tasks_standby]@
     FlightTask@(task) @(task);
+@[end if]@
 @[end for]@
 @[end if]@
 };
+
+// tasks that are constructed once and only get reset and activated on a switch
+struct StandbyTasks {
+@[for task in tasks_standby]@
+    FlightTask@(task) @(task);
+@[end for]@
+};
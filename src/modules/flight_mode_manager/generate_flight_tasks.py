@@ -7,6 +7,7 @@ import argparse
 parser = argparse.ArgumentParser()
 parser.add_argument("-t", "--tasks", dest='tasks_all', nargs='+', required=True, help="All tasks to be generated")
 parser.add_argument("-s", "--tasks_additional", dest='tasks_add', nargs='+', help="Additional tasks to be generated (on top of the core)")
+parser.add_argument("-b", "--tasks_standby", dest='tasks_standby', nargs='+', default=[], help="Tasks that stay constructed while inactive")
 parser.add_argument("-i", "--input_directory", dest='directory_in', required=True, help="Output directory")
 parser.add_argument("-o", "--output_directory", dest='directory_out', required=True, help="Input directory")
 parser.add_argument("-f", "--files", dest='gen_files', nargs='+', required=True, help="Files to generate")
@@ -21,6 +22,7 @@ for gen_file in args.gen_files:
     em_globals = {
         "tasks": args.tasks_all,
         "tasks_add": args.tasks_add,
+        "tasks_standby": args.tasks_standby,
     }
     interpreter = em.Interpreter(output=output_file, globals=em_globals)
     interpreter.file(open(args.directory_in + "/" + gen_file + ".em"))
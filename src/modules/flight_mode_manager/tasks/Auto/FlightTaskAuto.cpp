@@ -86,6 +86,38 @@ void FlightTaskAuto::reActivate()
 	_position_smoothing.reset({0.f, 0.f, 0.f}, {0.f, 0.f, 0.7f}, _position);
 }
 
+void FlightTaskAuto::resetState()
+{
+	// forget the triplets of the last activation, a new (or the same) mission item has to be evaluated again
+	_prev_prev_wp.zero();
+	_prev_wp.zero();
+	_target.zero();
+	_next_wp.zero();
+	_prev_was_valid = false;
+	_next_was_valid = false;
+	_triplet_target.zero();
+	_triplet_prev_wp.zero();
+	_triplet_next_wp.zero();
+	_lookahead_wp_count = 0;
+	_lock_position_xy.setNaN();
+
+	_mc_cruise_speed = NAN;
+	_type = WaypointType::idle;
+	_type_previous = WaypointType::idle;
+	_current_state = State::none;
+	_target_acceptance_radius = 0.f;
+	_yaw_sp_aligned = false;
+	_yaw_lock = false;
+	_want_takeoff = false;
+
+	// project the global setpoints with a fresh reference
+	_reference_position = MapProjection{};
+	_reference_altitude = NAN;
+	_time_stamp_reference = 0;
+
+	_obstacle_avoidance.reset();
+}
+
 bool FlightTaskAuto::updateInitialize()
 {
 	bool ret = FlightTask::updateInitialize();
@@ -174,6 +206,13 @@ bool FlightTaskAuto::update()
 	const bool should_wait_for_yaw_align = _param_mpc_yaw_mode.get() == 4 && !_yaw_sp_aligned;
 	const bool force_zero_velocity_setpoint = should_wait_for_yaw_align || _is_emergency_braking_active;
 	_updateTrajConstraints();
+
+	// plan the speed over the following mission waypoints as long as the vehicle flies towards the triplet
+	const bool use_lookahead = (_sub_vehicle_status.get().nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION)
+				   && ((_current_state == State::none) || (_current_state == State::target_behind))
+				   && !isTargetModified();
+	_position_smoothing.setLookaheadWaypoints(_lookahead_wp, use_lookahead ? _lookahead_wp_count : 0);
+
 	PositionSmoothing::PositionSmoothingSetpoints smoothed_setpoints;
 	_position_smoothing.generateSetpoints(
 		_position,
@@ -441,6 +480,10 @@ bool FlightTaskAuto::_evaluateTriplets()
 		_next_was_valid = _sub_triplet_setpoint.get().next.valid;
 	}
 
+	if (_sub_mission_lookahead.update() || triplet_update) {
+		_updateLookaheadWaypoints();
+	}
+
 	// activation/deactivation of weather vane is based on parameter WV_EN and setting of navigator (allow_weather_vane)
 	_weathervane.setNavigatorForceDisabled(_sub_triplet_setpoint.get().current.disable_weather_vane);
 
@@ -646,6 +689,35 @@ State FlightTaskAuto::_getCurrentState()
 	return return_state;
 }
 
+void FlightTaskAuto::_updateLookaheadWaypoints()
+{
+	_lookahead_wp_count = 0;
+
+	const mission_lookahead_s &mission_lookahead = _sub_mission_lookahead.get();
+	const position_setpoint_s &next = _sub_triplet_setpoint.get().next;
+
+	// the waypoints are only valid if they follow the next waypoint we are using
+	if ((_type != WaypointType::position) || !next.valid || !_isFinite(next)
+	    || (fabs(mission_lookahead.anchor_lat - next.lat) > 1e-9)
+	    || (fabs(mission_lookahead.anchor_lon - next.lon) > 1e-9)) {
+		return;
+	}
+
+	const int count = math::min((int)mission_lookahead.count, PositionSmoothing::MAX_LOOKAHEAD_WAYPOINTS);
+
+	for (int i = 0; i < count; i++) {
+		Vector3f waypoint;
+		_reference_position.project(mission_lookahead.lat[i], mission_lookahead.lon[i], waypoint(0), waypoint(1));
+		waypoint(2) = -(mission_lookahead.alt[i] - _reference_altitude);
+
+		if (!PX4_ISFINITE(waypoint(0)) || !PX4_ISFINITE(waypoint(1)) || !PX4_ISFINITE(waypoint(2))) {
+			break;
+		}
+
+		_lookahead_wp[_lookahead_wp_count++] = waypoint;
+	}
+}
+
 void FlightTaskAuto::_updateInternalWaypoints()
 {
 	// The internal Waypoints might differ from _triplet_prev_wp, _triplet_target and _triplet_next_wp.
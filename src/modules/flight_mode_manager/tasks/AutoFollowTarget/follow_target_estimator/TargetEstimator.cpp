@@ -134,18 +134,30 @@ void TargetEstimator::update()
 
 	if (_follow_target_sub.update(&follow_target)) {
 
+		if (follow_target.timestamp_sample == 0) {
+			// sender time unknown, assume no delay
+			follow_target.timestamp_sample = follow_target.timestamp;
+		}
+
 		// Don't perform measurement update if two follow_target messages with identical timestamps are used
 		// This can happen when using the MAVSDK and more than one outgoing follow_target message is queued.
 		const bool duplicate_measurement_received = follow_target.timestamp == _last_follow_target_timestamp;
 
 		// Skip measurements that lie in the past
-		const bool measurement_in_the_past = _last_position_fusion_timestamp >= follow_target.timestamp;
+		const bool measurement_in_the_past = _last_position_fusion_timestamp >= follow_target.timestamp_sample;
 
 		// Need at least one vehicle_local_position before estimator can work
 		const bool vehicle_local_position_invalid = _vehicle_local_position.timestamp == 0;
 
 		if (!duplicate_measurement_received && !measurement_in_the_past && !vehicle_local_position_invalid) {
+			// Fuse the measurement at the time it was taken instead of now: move the states back
+			// with the constant acceleration model, update them there and predict them forward again
+			const float delay = (now > follow_target.timestamp_sample) ? math::min((now - follow_target.timestamp_sample) * 1e-6f,
+					    MAXIMUM_MEASUREMENT_DELAY_MS * 1e-3f) : 0.f;
+
+			_filter_states.predict(-delay);
 			measurement_update(follow_target);
+			_filter_states.predict(delay);
 		}
 	}
 
@@ -168,6 +180,9 @@ void TargetEstimator::update()
 	follow_target_estimator.valid = states_are_finite;
 	follow_target_estimator.stale = is_stale(GPS_MESSAGE_STALE_TIMEOUT_MS);
 	follow_target_estimator.last_filter_reset_timestamp = _last_filter_reset_timestamp;
+	follow_target_estimator.timestamp_sample = _last_fused_sample_timestamp;
+	follow_target_estimator.prediction_horizon = (_last_fused_sample_timestamp != 0) ?
+			(follow_target_estimator.timestamp - _last_fused_sample_timestamp) * 1e-6f : NAN;
 	follow_target_estimator.lat_est = get_lat_lon_alt_est()(0);
 	follow_target_estimator.lon_est = get_lat_lon_alt_est()(1);
 	follow_target_estimator.alt_est = get_lat_lon_alt_est()(2);
@@ -255,6 +270,7 @@ void TargetEstimator::measurement_update(follow_target_s follow_target)
 	}
 
 	_last_follow_target_timestamp = follow_target.timestamp;
+	_last_fused_sample_timestamp = follow_target.timestamp_sample;
 
 	// Fuse position measurement
 	//
@@ -266,9 +282,9 @@ void TargetEstimator::measurement_update(follow_target_s follow_target)
 				     MINIMUM_TIME_BETWEEN_POS_FUSIONS_MS)) {
 		// Update with only position measurement
 
-		const float dt_update_pos = math::constrain((follow_target.timestamp - _last_position_fusion_timestamp) * 1e-6f, 1e-3f,
-					    20.0f);  // seconds
-		_last_position_fusion_timestamp = follow_target.timestamp;
+		const float dt_update_pos = math::constrain((follow_target.timestamp_sample - _last_position_fusion_timestamp) * 1e-6f,
+					    1e-3f, 20.0f);  // seconds
+		_last_position_fusion_timestamp = follow_target.timestamp_sample;
 
 		const Vector3f pos_innovation = pos_measured - _filter_states.pos_ned_est;
 
@@ -292,9 +308,9 @@ void TargetEstimator::measurement_update(follow_target_s follow_target)
 				     MINIMUM_TIME_BETWEEN_VEL_FUSIONS_MS)) {
 		// Update with only velocity measurement
 
-		const float dt_update_vel = math::constrain((follow_target.timestamp - _last_velocity_fusion_timestamp) * 1e-6f, 1e-3f,
-					    20.0f); // seconds
-		_last_velocity_fusion_timestamp = follow_target.timestamp;
+		const float dt_update_vel = math::constrain((follow_target.timestamp_sample - _last_velocity_fusion_timestamp) * 1e-6f,
+					    1e-3f, 20.0f); // seconds
+		_last_velocity_fusion_timestamp = follow_target.timestamp_sample;
 
 		const Vector3f vel_innovation = vel_measured - _filter_states.vel_ned_est;
 
@@ -312,17 +328,7 @@ void TargetEstimator::measurement_update(follow_target_s follow_target)
 void TargetEstimator::prediction_update(float deltatime)
 {
 	_prediction_count++;
-	// Temporary copy to not mix old and new values during the update calculations
-	const Vector3f vel_ned_est_prev = _filter_states.vel_ned_est;
-	const Vector3f acc_ned_est_prev = _filter_states.acc_ned_est;
-
-	if (PX4_ISFINITE(vel_ned_est_prev(0)) && PX4_ISFINITE(vel_ned_est_prev(1)) && PX4_ISFINITE(vel_ned_est_prev(2))) {
-		_filter_states.pos_ned_est += deltatime * vel_ned_est_prev + 0.5f * acc_ned_est_prev * deltatime * deltatime;
-	}
-
-	if (PX4_ISFINITE(acc_ned_est_prev(0)) && PX4_ISFINITE(acc_ned_est_prev(1)) && PX4_ISFINITE(acc_ned_est_prev(2))) {
-		_filter_states.vel_ned_est += deltatime * acc_ned_est_prev;
-	}
+	_filter_states.predict(deltatime);
 }
 
 Vector3<double> TargetEstimator::get_lat_lon_alt_est() const
@@ -350,6 +356,7 @@ void TargetEstimator::reset()
 	_last_filter_reset_timestamp = hrt_absolute_time();  // debug only
 	_last_position_fusion_timestamp = _last_velocity_fusion_timestamp = 0;
 	_last_follow_target_timestamp = 0;
+	_last_fused_sample_timestamp = 0;
 	_filter_states.pos_ned_est.setAll(NAN);
 	_filter_states.vel_ned_est.setAll(NAN);
 	_filter_states.acc_ned_est.setAll(NAN);
@@ -59,6 +59,7 @@ static constexpr float GPS_MESSAGE_STALE_TIMEOUT_MS =
 	3000.0f;  	// Duration after which the connection to the target is considered lost
 static constexpr float MINIMUM_TIME_BETWEEN_POS_FUSIONS_MS = 500.0f;
 static constexpr float MINIMUM_TIME_BETWEEN_VEL_FUSIONS_MS = 100.0f;
+static constexpr float MAXIMUM_MEASUREMENT_DELAY_MS = 1000.0f;	// older measurements are fused as if they were that old
 static constexpr float ACCELERATION_SATURATION = 20.0f; 		// 2*g
 static constexpr float MINIMUM_SPEED_FOR_TARGET_MOVING =
 	0.1f; 	// speed threshold above which the target is considered to be moving
@@ -96,6 +97,26 @@ struct filter_states_s {
 			PX4_ISFINITE(acc_ned_est(0)) && PX4_ISFINITE(acc_ned_est(1)) && PX4_ISFINITE(acc_ned_est(2));
 	}
 
+	/**
+	 * Propagate the states with the constant acceleration model of a point mass
+	 *
+	 * @param deltatime [s] time to predict, negative to move the states back in time
+	 */
+	void predict(float deltatime)
+	{
+		// Temporary copy to not mix old and new values during the update calculations
+		const matrix::Vector3f vel_ned_est_prev = vel_ned_est;
+		const matrix::Vector3f acc_ned_est_prev = acc_ned_est;
+
+		if (PX4_ISFINITE(vel_ned_est_prev(0)) && PX4_ISFINITE(vel_ned_est_prev(1)) && PX4_ISFINITE(vel_ned_est_prev(2))) {
+			pos_ned_est += deltatime * vel_ned_est_prev + 0.5f * acc_ned_est_prev * deltatime * deltatime;
+		}
+
+		if (PX4_ISFINITE(acc_ned_est_prev(0)) && PX4_ISFINITE(acc_ned_est_prev(1)) && PX4_ISFINITE(acc_ned_est_prev(2))) {
+			vel_ned_est += deltatime * acc_ned_est_prev;
+		}
+	}
+
 	/**
 	 * Limits the acceleration state to some sane value to prevent unrealistic
 	 * spikes in the acceleration, which could cause severely unexpected behaviour in the drone
@@ -156,6 +177,7 @@ protected:
 
 	/**
 	 * Perform filter update with new follow_target data
+	 * The filter states need to be at the time of the measurement (timestamp_sample).
 	 *
 	 * @param follow_target GPS data last received from target
 	 */
@@ -199,6 +221,7 @@ protected:
 	hrt_abstime _last_position_fusion_timestamp{0};
 	hrt_abstime _last_velocity_fusion_timestamp{0};
 	hrt_abstime _last_follow_target_timestamp{0};
+	hrt_abstime _last_fused_sample_timestamp{0};
 
 	// Pos/vel from previous measurement update. Required for filtering duplicate messages
 	matrix::Vector3f _pos_measurement_old{};
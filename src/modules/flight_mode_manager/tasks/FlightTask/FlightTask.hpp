@@ -88,6 +88,12 @@ public:
 	 */
 	virtual void reActivate();
 
+	/**
+	 * Bring a task that stays constructed between activations (standby task)
+	 * back to the state of a freshly constructed one, called before activate()
+	 */
+	virtual void resetState() {}
+
 	/**
 	 * To be called to adopt parameters from an arrived vehicle command
 	 * @param command received command message containing the parameters
@@ -249,16 +249,55 @@ float FixedwingAttitudeControl::get_airspeed_and_update_scaling()
 	return airspeed;
 }
 
+void FixedwingAttitudeControl::vtol_suspend_poll()
+{
+	vtol_vehicle_status_s vtol_vehicle_status;
+
+	if (!_vtol_vehicle_status_sub.update(&vtol_vehicle_status)
+	    || (vtol_vehicle_status.fw_control_suspended == _vtol_suspended)) {
+		return;
+	}
+
+	_vtol_suspended = vtol_vehicle_status.fw_control_suspended;
+
+	if (_vtol_suspended) {
+		// only wake up on VTOL state changes, zero the outputs so that the next transition doesn't start from stale values
+		_att_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.registerCallback();
+
+		actuator_controls_s actuator_controls{};
+		actuator_controls.timestamp = hrt_absolute_time();
+		_actuator_controls_0_pub.publish(actuator_controls);
+
+	} else {
+		_vtol_vehicle_status_sub.unregisterCallback();
+		_att_sub.registerCallback();
+
+		// start from the current state
+		_rate_control.resetIntegral();
+		_wheel_ctrl.reset_integrator();
+		_last_run = 0;
+	}
+}
+
 void FixedwingAttitudeControl::Run()
 {
 	if (should_exit()) {
 		_att_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
 	perf_begin(_loop_perf);
 
+	vtol_suspend_poll();
+
+	if (_vtol_suspended) {
+		perf_end(_loop_perf);
+		return;
+	}
+
 	// only run controller if attitude changed
 	if (_att_sub.updated() || (hrt_elapsed_time(&_last_run) > 20_ms)) {
 
@@ -628,15 +667,17 @@ void FixedwingAttitudeControl::Run()
 			}
 
 			// publish rate controller status
-			rate_ctrl_status_s rate_ctrl_status{};
-			_rate_control.getRateControlStatus(rate_ctrl_status);
-			rate_ctrl_status.timestamp = hrt_absolute_time();
+			if (_rate_ctrl_status_pub.has_subscribers()) {
+				rate_ctrl_status_s rate_ctrl_status{};
+				_rate_control.getRateControlStatus(rate_ctrl_status);
+				rate_ctrl_status.timestamp = hrt_absolute_time();
 
-			if (wheel_control) {
-				rate_ctrl_status.wheel_rate_integ = _wheel_ctrl.get_integrator();
-			}
+				if (wheel_control) {
+					rate_ctrl_status.wheel_rate_integ = _wheel_ctrl.get_integrator();
+				}
 
-			_rate_ctrl_status_pub.publish(rate_ctrl_status);
+				_rate_ctrl_status_pub.publish(rate_ctrl_status);
+			}
 
 		} else {
 			// full manual
@@ -78,6 +78,7 @@
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/vehicle_thrust_setpoint.h>
 #include <uORB/topics/vehicle_torque_setpoint.h>
+#include <uORB/topics/vtol_vehicle_status.h>
 
 using matrix::Eulerf;
 using matrix::Quatf;
@@ -113,7 +114,13 @@ private:
 	void publishTorqueSetpoint(const hrt_abstime &timestamp_sample);
 	void publishThrustSetpoint(const hrt_abstime &timestamp_sample);
 
+	/**
+	 * VTOL: stop running on attitude updates while vtol_att_control doesn't use the outputs (VT_CTRL_SUSPEND)
+	 */
+	void vtol_suspend_poll();
+
 	uORB::SubscriptionCallbackWorkItem _att_sub{this, ORB_ID(vehicle_attitude)};		/**< vehicle attitude */
+	uORB::SubscriptionCallbackWorkItem _vtol_vehicle_status_sub{this, ORB_ID(vtol_vehicle_status)};	/**< wakeup while suspended */
 
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
@@ -158,6 +165,7 @@ private:
 	float _airspeed_scaling{1.0f};
 
 	bool _landed{true};
+	bool _vtol_suspended{false};
 
 	float _battery_scale{1.0f};
 
@@ -53,6 +53,9 @@ FixedwingPositionControl::FixedwingPositionControl(bool vtol) :
 	WorkItem(MODULE_NAME, px4::wq_configurations::nav_and_controllers),
 	_attitude_sp_pub(vtol ? ORB_ID(fw_virtual_attitude_setpoint) : ORB_ID(vehicle_attitude_setpoint)),
 	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
+	_inputs_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": inputs")),
+	_control_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": control")),
+	_tecs_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": tecs")),
 	_launchDetector(this),
 	_runway_takeoff(this)
 {
@@ -76,6 +79,9 @@ FixedwingPositionControl::FixedwingPositionControl(bool vtol) :
 FixedwingPositionControl::~FixedwingPositionControl()
 {
 	perf_free(_loop_perf);
+	perf_free(_inputs_perf);
+	perf_free(_control_perf);
+	perf_free(_tecs_perf);
 }
 
 bool
@@ -2069,6 +2075,8 @@ FixedwingPositionControl::Run()
 					       MIN_AUTO_TIMESTEP, MAX_AUTO_TIMESTEP);
 		_last_time_position_control_called = _local_pos.timestamp;
 
+		perf_begin(_inputs_perf);
+
 		// check for parameter updates
 		if (_parameter_update_sub.updated()) {
 			// clear update
@@ -2217,6 +2225,10 @@ FixedwingPositionControl::Run()
 
 		update_in_air_states(_local_pos.timestamp);
 
+		perf_end(_inputs_perf);
+
+		perf_begin(_control_perf);
+
 		// update lateral guidance timesteps for slewrates
 		if (_param_fw_use_npfg.get()) {
 			_npfg.setDt(control_interval);
@@ -2300,6 +2312,8 @@ FixedwingPositionControl::Run()
 
 		}
 
+		perf_end(_control_perf);
+
 		if (_control_mode_current != FW_POSCTRL_MODE_OTHER) {
 
 			if (_control_mode.flag_control_manual_enabled) {
@@ -2472,6 +2486,8 @@ FixedwingPositionControl::tecs_update_pitch_throttle(const float control_interva
 		return;
 	}
 
+	perf_begin(_tecs_perf);
+
 	if (_reinitialize_tecs) {
 		_tecs.reset_state();
 		_reinitialize_tecs = false;
@@ -2509,6 +2525,8 @@ FixedwingPositionControl::tecs_update_pitch_throttle(const float control_interva
 				    desired_max_sinkrate,
 				    hgt_rate_sp);
 
+	perf_end(_tecs_perf);
+
 	tecs_status_publish();
 }
 
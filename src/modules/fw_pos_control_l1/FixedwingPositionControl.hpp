@@ -223,6 +223,9 @@ private:
 	vehicle_status_s _vehicle_status{};
 
 	perf_counter_t _loop_perf; // loop performance counter
+	perf_counter_t _inputs_perf; // parameter, setpoint and state updates
+	perf_counter_t _control_perf; // mode dependent guidance, takeoff/landing logic and TECS
+	perf_counter_t _tecs_perf; // TECS update only (part of _control_perf)
 
 	// [us] Last absolute time position control has been called
 	hrt_abstime _last_time_position_control_called{0};
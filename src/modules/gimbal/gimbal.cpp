@@ -57,11 +57,19 @@
 #include "output_mavlink.h"
 
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/topics/gimbal_manager_set_attitude.h>
+#include <uORB/topics/gimbal_manager_set_manual_control.h>
+#include <uORB/topics/manual_control_setpoint.h>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_command.h>
+#include <uORB/topics/vehicle_roi.h>
 
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 
 using namespace time_literals;
 using namespace gimbal;
@@ -85,61 +93,104 @@ static void usage();
 static void update_params(ParameterHandles &param_handles, Parameters &params);
 static bool initialize_params(ParameterHandles &param_handles, Parameters &params);
 
-static int gimbal_thread_main(int argc, char *argv[]);
 extern "C" __EXPORT int gimbal_main(int argc, char *argv[]);
 
-static int gimbal_thread_main(int argc, char *argv[])
+/**
+ * Runs inputs and output whenever the vehicle attitude or one of the inputs updates,
+ * with a backup schedule to keep the output going without them.
+ */
+class Gimbal : public px4::ScheduledWorkItem
 {
-	ParameterHandles param_handles;
-	Parameters params {};
+public:
+	Gimbal() :
+		ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::nav_and_controllers)
+	{}
+
+	~Gimbal() override;
+
+	bool init();
+
 	ThreadData thread_data;
 
-	if (!initialize_params(param_handles, params)) {
-		PX4_ERR("could not get mount parameters!");
-		delete g_thread_data->test_input;
-		return -1;
+private:
+	void Run() override;
+
+	static constexpr hrt_abstime BACKUP_SCHEDULE_INTERVAL{20_ms};
+
+	ParameterHandles _param_handles{};
+	Parameters _params{};
+	ControlData _control_data{};
+
+	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
+
+	// triggers only, the inputs and the output read the topics themselves
+	uORB::SubscriptionCallbackWorkItem _vehicle_attitude_sub{this, ORB_ID(vehicle_attitude)};
+	uORB::SubscriptionCallbackWorkItem _manual_control_setpoint_sub{this, ORB_ID(manual_control_setpoint)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub{this, ORB_ID(vehicle_command)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_roi_sub{this, ORB_ID(vehicle_roi)};
+	uORB::SubscriptionCallbackWorkItem _gimbal_manager_set_attitude_sub{this, ORB_ID(gimbal_manager_set_attitude)};
+	uORB::SubscriptionCallbackWorkItem _gimbal_manager_set_manual_control_sub{this, ORB_ID(gimbal_manager_set_manual_control)};
+};
+
+Gimbal::~Gimbal()
+{
+	for (int i = 0; i < input_objs_len_max; ++i) {
+		if (thread_data.input_objs[i]) {
+			delete (thread_data.input_objs[i]);
+			thread_data.input_objs[i] = nullptr;
+		}
 	}
 
-	uORB::SubscriptionInterval parameter_update_sub{ORB_ID(parameter_update), 1_s};
-	thread_running.store(true);
-	ControlData control_data {};
-	g_thread_data = &thread_data;
+	thread_data.input_objs_len = 0;
 
-	thread_data.test_input = new InputTest(params);
+	if (thread_data.output_obj) {
+		delete (thread_data.output_obj);
+		thread_data.output_obj = nullptr;
+	}
+}
+
+bool Gimbal::init()
+{
+	if (!initialize_params(_param_handles, _params)) {
+		PX4_ERR("could not get mount parameters!");
+		return false;
+	}
+
+	thread_data.test_input = new InputTest(_params);
 
 	bool alloc_failed = false;
 
 	thread_data.input_objs[thread_data.input_objs_len++] = thread_data.test_input;
 
-	switch (params.mnt_mode_in) {
+	switch (_params.mnt_mode_in) {
 	case 0:
 		// Automatic
 		// MAVLINK_V2 as well as RC input are supported together.
 		// Whichever signal is updated last, gets control, for RC there is a deadzone
 		// to avoid accidental activation.
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(_params);
 
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(_params);
 		break;
 
 	case 1: // RC only
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputRC(_params);
 		break;
 
 	case 2: // MAVLINK_ROI commands only (to be deprecated)
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkROI(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkROI(_params);
 		break;
 
 	case 3: // MAVLINK_DO_MOUNT commands only (to be deprecated)
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkCmdMount(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkCmdMount(_params);
 		break;
 
 	case 4: //MAVLINK_V2
-		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(params);
+		thread_data.input_objs[thread_data.input_objs_len++] = new InputMavlinkGimbalV2(_params);
 		break;
 
 	default:
-		PX4_ERR("invalid input mode %" PRId32, params.mnt_mode_in);
+		PX4_ERR("invalid input mode %" PRId32, _params.mnt_mode_in);
 		break;
 	}
 
@@ -151,165 +202,157 @@ static int gimbal_thread_main(int argc, char *argv[])
 
 	if (alloc_failed) {
 		PX4_ERR("input objs memory allocation failed");
-		thread_should_exit.store(true);
+		return false;
 	}
 
-	if (!alloc_failed) {
-		for (int i = 0; i < thread_data.input_objs_len; ++i) {
-			if (thread_data.input_objs[i]->initialize() != 0) {
-				PX4_ERR("Input %d failed", i);
-				thread_should_exit.store(true);
-			}
+	for (int i = 0; i < thread_data.input_objs_len; ++i) {
+		if (thread_data.input_objs[i]->initialize() != 0) {
+			PX4_ERR("Input %d failed", i);
+			return false;
 		}
 	}
 
-	switch (params.mnt_mode_out) {
+	switch (_params.mnt_mode_out) {
 	case 0: //AUX
-		thread_data.output_obj = new OutputRC(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		thread_data.output_obj = new OutputRC(_params);
 		break;
 
 	case 1: //MAVLink gimbal v1 protocol
-		thread_data.output_obj = new OutputMavlinkV1(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		thread_data.output_obj = new OutputMavlinkV1(_params);
 		break;
 
 	case 2: //MAVLink gimbal v2 protocol
-		thread_data.output_obj = new OutputMavlinkV2(params);
-
-		if (!thread_data.output_obj) { alloc_failed = true; }
-
+		thread_data.output_obj = new OutputMavlinkV2(_params);
 		break;
 
 	default:
-		PX4_ERR("invalid output mode %" PRId32, params.mnt_mode_out);
-		thread_should_exit.store(true);
-		break;
+		PX4_ERR("invalid output mode %" PRId32, _params.mnt_mode_out);
+		return false;
 	}
 
-	if (alloc_failed) {
+	if (!thread_data.output_obj) {
 		PX4_ERR("output memory allocation failed");
-		thread_should_exit.store(true);
+		return false;
 	}
 
-	while (!thread_should_exit.load()) {
-
-		const bool updated = parameter_update_sub.updated();
-
-		if (updated) {
-			parameter_update_s pupdate;
-			parameter_update_sub.copy(&pupdate);
-			update_params(param_handles, params);
-		}
-
-		if (thread_data.last_input_active == -1) {
-			// Reset control as no one is active anymore, or yet.
-			control_data.sysid_primary_control = 0;
-			control_data.compid_primary_control = 0;
-		}
-
-		InputBase::UpdateResult update_result = InputBase::UpdateResult::NoUpdate;
-
-		if (thread_data.input_objs_len > 0) {
+	// the attitude drives the stabilization, limit it to 100 Hz
+	_vehicle_attitude_sub.set_interval_ms(10);
+	_manual_control_setpoint_sub.set_interval_ms(10);
+
+	if (!_vehicle_attitude_sub.registerCallback()
+	    || !_manual_control_setpoint_sub.registerCallback()
+	    || !_vehicle_command_sub.registerCallback()
+	    || !_vehicle_roi_sub.registerCallback()
+	    || !_gimbal_manager_set_attitude_sub.registerCallback()
+	    || !_gimbal_manager_set_manual_control_sub.registerCallback()) {
+		PX4_ERR("callback registration failed");
+		return false;
+	}
 
-			// get input: we cannot make the timeout too large, because the output needs to update
-			// periodically for stabilization and angle updates.
+	ScheduleNow();
+	return true;
+}
 
-			for (int i = 0; i < thread_data.input_objs_len; ++i) {
+void Gimbal::Run()
+{
+	if (thread_should_exit.load()) {
+		_vehicle_attitude_sub.unregisterCallback();
+		_manual_control_setpoint_sub.unregisterCallback();
+		_vehicle_command_sub.unregisterCallback();
+		_vehicle_roi_sub.unregisterCallback();
+		_gimbal_manager_set_attitude_sub.unregisterCallback();
+		_gimbal_manager_set_manual_control_sub.unregisterCallback();
+		ScheduleClear();
+		thread_running.store(false);
+		return;
+	}
 
-				const bool already_active = (thread_data.last_input_active == i);
-				// poll only on active input to reduce latency, or on all if none is active
-				const unsigned int poll_timeout =
-					(already_active || thread_data.last_input_active == -1) ? 20 : 0;
+	// run at least every BACKUP_SCHEDULE_INTERVAL, the angle rate inputs and the stabilization
+	// need periodic output updates even if no topic triggers
+	ScheduleDelayed(BACKUP_SCHEDULE_INTERVAL);
 
-				update_result = thread_data.input_objs[i]->update(poll_timeout, control_data, already_active);
+	const bool updated = _parameter_update_sub.updated();
 
-				bool break_loop = false;
+	if (updated) {
+		parameter_update_s pupdate;
+		_parameter_update_sub.copy(&pupdate);
+		update_params(_param_handles, _params);
+	}
 
-				switch (update_result) {
-				case InputBase::UpdateResult::NoUpdate:
-					if (already_active) {
-						// No longer active.
-						thread_data.last_input_active = -1;
-					}
+	if (thread_data.last_input_active == -1) {
+		// Reset control as no one is active anymore, or yet.
+		_control_data.sysid_primary_control = 0;
+		_control_data.compid_primary_control = 0;
+	}
 
-					break;
+	InputBase::UpdateResult update_result = InputBase::UpdateResult::NoUpdate;
 
-				case InputBase::UpdateResult::UpdatedActive:
-					thread_data.last_input_active = i;
-					break_loop = true;
-					break;
+	// get input: never block, the next trigger runs the inputs again
+	for (int i = 0; i < thread_data.input_objs_len; ++i) {
 
-				case InputBase::UpdateResult::UpdatedActiveOnce:
-					thread_data.last_input_active = -1;
-					break_loop = true;
-					break;
+		const bool already_active = (thread_data.last_input_active == i);
 
-				case InputBase::UpdateResult::UpdatedNotActive:
-					if (already_active) {
-						// No longer active
-						thread_data.last_input_active = -1;
-					}
+		update_result = thread_data.input_objs[i]->update(0, _control_data, already_active);
 
-					break;
-				}
+		bool break_loop = false;
 
-				if (break_loop) {
-					break;
-				}
+		switch (update_result) {
+		case InputBase::UpdateResult::NoUpdate:
+			if (already_active) {
+				// No longer active.
+				thread_data.last_input_active = -1;
 			}
 
-			if (params.mnt_do_stab == 1) {
-				thread_data.output_obj->set_stabilize(true, true, true);
+			break;
 
-			} else if (params.mnt_do_stab == 2) {
-				thread_data.output_obj->set_stabilize(false, false, true);
+		case InputBase::UpdateResult::UpdatedActive:
+			thread_data.last_input_active = i;
+			break_loop = true;
+			break;
 
-			} else {
-				thread_data.output_obj->set_stabilize(false, false, false);
-			}
-
-			// Update output
-			thread_data.output_obj->update(
-				control_data,
-				update_result != InputBase::UpdateResult::NoUpdate);
+		case InputBase::UpdateResult::UpdatedActiveOnce:
+			thread_data.last_input_active = -1;
+			break_loop = true;
+			break;
 
-			// Only publish the mount orientation if the mode is not mavlink v1 or v2
-			// If the gimbal speaks mavlink it publishes its own orientation.
-			if (params.mnt_mode_out != 1 && params.mnt_mode_out != 2) { // 1 = MAVLink v1, 2 = MAVLink v2
-				thread_data.output_obj->publish();
+		case InputBase::UpdateResult::UpdatedNotActive:
+			if (already_active) {
+				// No longer active
+				thread_data.last_input_active = -1;
 			}
 
-		} else {
-			// We still need to wake up regularly to check for thread exit requests
-			px4_usleep(1e6);
+			break;
 		}
-	}
-
-	g_thread_data = nullptr;
 
-	for (int i = 0; i < input_objs_len_max; ++i) {
-		if (thread_data.input_objs[i]) {
-			delete (thread_data.input_objs[i]);
-			thread_data.input_objs[i] = nullptr;
+		if (break_loop) {
+			break;
 		}
 	}
 
-	thread_data.input_objs_len = 0;
+	if (_params.mnt_do_stab == 1) {
+		thread_data.output_obj->set_stabilize(true, true, true);
 
-	if (thread_data.output_obj) {
-		delete (thread_data.output_obj);
-		thread_data.output_obj = nullptr;
+	} else if (_params.mnt_do_stab == 2) {
+		thread_data.output_obj->set_stabilize(false, false, true);
+
+	} else {
+		thread_data.output_obj->set_stabilize(false, false, false);
 	}
 
-	thread_running.store(false);
-	return 0;
+	// Update output
+	thread_data.output_obj->update(
+		_control_data,
+		update_result != InputBase::UpdateResult::NoUpdate);
+
+	// Only publish the mount orientation if the mode is not mavlink v1 or v2
+	// If the gimbal speaks mavlink it publishes its own orientation.
+	if (_params.mnt_mode_out != 1 && _params.mnt_mode_out != 2) { // 1 = MAVLink v1, 2 = MAVLink v2
+		thread_data.output_obj->publish();
+	}
 }
 
+static Gimbal *g_gimbal = nullptr;
+
 int gimbal_main(int argc, char *argv[])
 {
 	if (argc < 2) {
@@ -327,29 +370,23 @@ int gimbal_main(int argc, char *argv[])
 
 		thread_should_exit.store(false);
 
-		int gimbal_task = px4_task_spawn_cmd("gimbal",
-						     SCHED_DEFAULT,
-						     SCHED_PRIORITY_DEFAULT,
-						     2100,
-						     gimbal_thread_main,
-						     nullptr);
+		g_gimbal = new Gimbal();
 
-		int counter = 0;
-
-		while (!thread_running.load() && gimbal_task >= 0) {
-			px4_usleep(5000);
-
-			if (++counter >= 100) {
-				break;
-			}
+		if (!g_gimbal) {
+			PX4_ERR("alloc failed");
+			return -1;
 		}
 
-		if (gimbal_task < 0) {
+		if (!g_gimbal->init()) {
 			PX4_ERR("failed to start");
+			delete g_gimbal;
+			g_gimbal = nullptr;
 			return -1;
 		}
 
-		return counter < 100 || thread_should_exit.load() ? 0 : -1;
+		g_thread_data = &g_gimbal->thread_data;
+		thread_running.store(true);
+		return 0;
 	}
 
 	else if (!strcmp(argv[1], "stop")) {
@@ -360,11 +397,15 @@ int gimbal_main(int argc, char *argv[])
 		}
 
 		thread_should_exit.store(true);
+		g_gimbal->ScheduleNow();
 
 		while (thread_running.load()) {
-			px4_usleep(100000);
+			px4_usleep(10000);
 		}
 
+		g_thread_data = nullptr;
+		delete g_gimbal;
+		g_gimbal = nullptr;
 		return 0;
 	}
 
@@ -469,6 +510,7 @@ void update_params(ParameterHandles &param_handles, Parameters &params)
 	param_get(param_handles.mav_compid, &params.mav_compid);
 	param_get(param_handles.mnt_rate_pitch, &params.mnt_rate_pitch);
 	param_get(param_handles.mnt_rate_yaw, &params.mnt_rate_yaw);
+	param_get(param_handles.mnt_slew_rate, &params.mnt_slew_rate);
 	param_get(param_handles.mnt_rc_in_mode, &params.mnt_rc_in_mode);
 	param_get(param_handles.mnt_lnd_p_min, &params.mnt_lnd_p_min);
 	param_get(param_handles.mnt_lnd_p_max, &params.mnt_lnd_p_max);
@@ -496,6 +538,7 @@ bool initialize_params(ParameterHandles &param_handles, Parameters &params)
 	param_handles.mav_compid = param_find("MAV_COMP_ID");
 	param_handles.mnt_rate_pitch = param_find("MNT_RATE_PITCH");
 	param_handles.mnt_rate_yaw = param_find("MNT_RATE_YAW");
+	param_handles.mnt_slew_rate = param_find("MNT_SLEW_RATE");
 	param_handles.mnt_rc_in_mode = param_find("MNT_RC_IN_MODE");
 	param_handles.mnt_lnd_p_min = param_find("MNT_LND_P_MIN");
 	param_handles.mnt_lnd_p_max = param_find("MNT_LND_P_MAX");
@@ -520,6 +563,7 @@ bool initialize_params(ParameterHandles &param_handles, Parameters &params)
 	    param_handles.mav_compid == PARAM_INVALID ||
 	    param_handles.mnt_rate_pitch == PARAM_INVALID ||
 	    param_handles.mnt_rate_yaw == PARAM_INVALID ||
+	    param_handles.mnt_slew_rate == PARAM_INVALID ||
 	    param_handles.mnt_rc_in_mode == PARAM_INVALID ||
 	    param_handles.mnt_lnd_p_min == PARAM_INVALID ||
 	    param_handles.mnt_lnd_p_max == PARAM_INVALID
@@ -266,6 +266,21 @@ PARAM_DEFINE_FLOAT(MNT_RATE_PITCH, 30.0f);
  */
 PARAM_DEFINE_FLOAT(MNT_RATE_YAW, 30.0f);
 
+/**
+ * Maximum angular rate of the gimbal angle setpoint in degrees/second.
+ *
+ * Angle setpoints (e.g. from MAVLink or RC in angle mode) are approached with
+ * at most this rate instead of jumping, which avoids jerks in the video.
+ * Set to 0 to disable.
+ *
+ * @min 0.0
+ * @max 360.0
+ * @decimal 1
+ * @unit deg/s
+ * @group Mount
+ */
+PARAM_DEFINE_FLOAT(MNT_SLEW_RATE, 0.0f);
+
 /**
  * Input mode for RC gimbal input
  *
@@ -61,6 +61,7 @@ struct Parameters {
 	int32_t mav_compid;
 	float mnt_rate_pitch;
 	float mnt_rate_yaw;
+	float mnt_slew_rate;
 	int32_t mnt_rc_in_mode;
 	float mnt_lnd_p_min;
 	float mnt_lnd_p_max;
@@ -87,6 +88,7 @@ struct ParameterHandles {
 	param_t mav_compid;
 	param_t mnt_rate_pitch;
 	param_t mnt_rate_yaw;
+	param_t mnt_slew_rate;
 	param_t mnt_rc_in_mode;
 	param_t mnt_lnd_p_min;
 	param_t mnt_lnd_p_max;
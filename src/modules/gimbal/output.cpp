@@ -224,7 +224,17 @@ void OutputBase::_calculate_angle_output(const hrt_abstime &t)
 	for (int i = 0; i < 3; ++i) {
 
 		if (q_setpoint_valid && PX4_ISFINITE(euler_gimbal(i))) {
-			_angle_outputs[i] = euler_gimbal(i);
+			if (_parameters.mnt_slew_rate > FLT_EPSILON && PX4_ISFINITE(_angle_setpoints_slewed[i])) {
+				const float max_step = math::radians(_parameters.mnt_slew_rate) * dt;
+				const float step = math::constrain(matrix::wrap_pi(euler_gimbal(i) - _angle_setpoints_slewed[i]),
+								   -max_step, max_step);
+				_angle_setpoints_slewed[i] = matrix::wrap_pi(_angle_setpoints_slewed[i] + step);
+
+			} else {
+				_angle_setpoints_slewed[i] = euler_gimbal(i);
+			}
+
+			_angle_outputs[i] = _angle_setpoints_slewed[i];
 		}
 
 		if (PX4_ISFINITE(_angle_velocity[i])) {
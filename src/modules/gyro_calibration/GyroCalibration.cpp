@@ -160,6 +160,7 @@ void GyroCalibration::Run()
 			} else {
 				// setting device id, reset all
 				_gyro_calibration[gyro].set_device_id(sensor_gyro.device_id);
+				_gyro_variance_limit[gyro] = GYRO_VARIANCE_MAX;
 				Reset();
 			}
 		}
@@ -207,10 +208,10 @@ void GyroCalibration::Run()
 					  (double)_gyro_mean[gyro].variance()(0), (double)_gyro_mean[gyro].variance()(1), (double)_gyro_mean[gyro].variance()(2),
 					  (double)_gyro_mean[gyro].variance().length());
 
-				if (_gyro_mean[gyro].variance().longerThan(0.001f)) {
+				if (_gyro_mean[gyro].variance().longerThan(_gyro_variance_limit[gyro])) {
 					// reset all
-					PX4_DEBUG("gyro %d variance longer than 0.001f (%.3f), resetting all",
-						  gyro, (double)_gyro_mean[gyro].variance().length());
+					PX4_DEBUG("gyro %d variance longer than %.9f (%.9f), resetting all",
+						  gyro, (double)_gyro_variance_limit[gyro], (double)_gyro_mean[gyro].variance().length());
 					Reset();
 					return;
 				}
@@ -235,14 +236,18 @@ void GyroCalibration::Run()
 			if (_gyro_calibration[gyro].device_id() != 0 && _gyro_mean[gyro].valid()) {
 
 				// check variance again before saving
-				if (_gyro_mean[gyro].variance().longerThan(0.001f)) {
+				if (_gyro_mean[gyro].variance().longerThan(_gyro_variance_limit[gyro])) {
 					// reset all
-					PX4_DEBUG("gyro %d variance longer than 0.001f (%.3f), resetting all",
-						  gyro, (double)_gyro_mean[gyro].variance().length());
+					PX4_DEBUG("gyro %d variance longer than %.9f (%.9f), resetting all",
+						  gyro, (double)_gyro_variance_limit[gyro], (double)_gyro_mean[gyro].variance().length());
 					Reset();
 					return;
 				}
 
+				// the accepted period was stationary, later periods need to be similarly quiet
+				_gyro_variance_limit[gyro] = math::constrain(GYRO_VARIANCE_MARGIN * _gyro_mean[gyro].variance().length(),
+							     GYRO_VARIANCE_MIN, GYRO_VARIANCE_MAX);
+
 				const Vector3f old_offset{_gyro_calibration[gyro].offset()};
 
 				if (_gyro_calibration[gyro].set_offset(_gyro_mean[gyro].mean()) || !_gyro_calibration[gyro].calibrated()) {
@@ -309,11 +314,11 @@ int GyroCalibration::print_status()
 {
 	for (int gyro = 0; gyro < _sensor_gyro_subs.size(); gyro++) {
 		if (_gyro_calibration[gyro].device_id() != 0) {
-			PX4_INFO_RAW("gyro %d (%" PRIu32 "), [%.5f, %.5f, %.5f] var: [%.9f, %.9f, %.9f] %.1f degC (count %d)\n",
+			PX4_INFO_RAW("gyro %d (%" PRIu32 "), [%.5f, %.5f, %.5f] var: [%.9f, %.9f, %.9f] (limit %.9f) %.1f degC (count %d)\n",
 				     gyro, _gyro_calibration[gyro].device_id(),
 				     (double)_gyro_mean[gyro].mean()(0), (double)_gyro_mean[gyro].mean()(1), (double)_gyro_mean[gyro].mean()(2),
 				     (double)_gyro_mean[gyro].variance()(0), (double)_gyro_mean[gyro].variance()(1), (double)_gyro_mean[gyro].variance()(2),
-				     (double)_temperature[gyro], _gyro_mean[gyro].count());
+				     (double)_gyro_variance_limit[gyro], (double)_temperature[gyro], _gyro_mean[gyro].count());
 		}
 	}
 
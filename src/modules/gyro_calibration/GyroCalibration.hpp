@@ -76,6 +76,11 @@ private:
 	static constexpr hrt_abstime INTERVAL_US = 20000_us;
 	static constexpr int MAX_SENSORS = 4;
 
+	// stationary detection: the gyro variance limit adapts to the noise of the last accepted calibration
+	static constexpr float GYRO_VARIANCE_MAX = 0.001f;     ///< (rad/s)^2, initial and upper limit
+	static constexpr float GYRO_VARIANCE_MIN = 0.000001f;  ///< (rad/s)^2
+	static constexpr float GYRO_VARIANCE_MARGIN = 10.f;    ///< limit relative to the accepted variance
+
 	void Run() override;
 
 	void Reset()
@@ -95,6 +100,7 @@ private:
 	calibration::Gyroscope _gyro_calibration[MAX_SENSORS] {};
 	math::WelfordMean<float, 3> _gyro_mean[MAX_SENSORS] {};
 	float _temperature[MAX_SENSORS] {};
+	float _gyro_variance_limit[MAX_SENSORS] {GYRO_VARIANCE_MAX, GYRO_VARIANCE_MAX, GYRO_VARIANCE_MAX, GYRO_VARIANCE_MAX};
 	hrt_abstime _gyro_last_update[MAX_SENSORS] {};
 
 	matrix::Vector3f _acceleration[MAX_SENSORS] {};
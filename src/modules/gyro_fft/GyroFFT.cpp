@@ -67,6 +67,7 @@ GyroFFT::~GyroFFT()
 	delete[] _fft_input_buffer;
 	delete[] _fft_outupt_buffer;
 	delete[] _peak_magnitudes_all;
+	delete[] _welch_magnitudes;
 }
 
 bool GyroFFT::init()
@@ -140,6 +141,7 @@ bool GyroFFT::init()
 
 	if (buffers_allocated) {
 		_imu_gyro_fft_len = _param_imu_gyro_fft_len.get();
+		_imu_gyro_fft_avg = (_welch_magnitudes != nullptr) ? _param_imu_gyro_fft_avg.get() : 1;
 
 		// init Hanning window
 		for (int n = 0; n < _imu_gyro_fft_len; n++) {
@@ -161,6 +163,8 @@ bool GyroFFT::init()
 	delete[] _hanning_window;
 	delete[] _fft_input_buffer;
 	delete[] _fft_outupt_buffer;
+	delete[] _peak_magnitudes_all;
+	delete[] _welch_magnitudes;
 
 	return false;
 }
@@ -336,9 +340,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_fifo_sub.update(&sensor_gyro_fifo)) {
 			if (_sensor_gyro_fifo_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				perf_count(_gyro_fifo_generation_gap_perf);
 			}
@@ -347,9 +349,7 @@ void GyroFFT::Run()
 
 			if (fabsf(sensor_gyro_fifo.scale - _fifo_last_scale) > FLT_EPSILON) {
 				// force reset if scale has changed
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				_fifo_last_scale = sensor_gyro_fifo.scale;
 			}
@@ -365,9 +365,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_sub.update(&sensor_gyro)) {
 			if (_sensor_gyro_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				ResetBuffers();
 
 				perf_count(_gyro_generation_gap_perf);
 			}
@@ -392,11 +390,23 @@ void GyroFFT::Run()
 	perf_end(_cycle_perf);
 }
 
+void GyroFFT::ResetBuffers()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		_fft_buffer_index[axis] = 0;
+		_welch_count[axis] = 0;
+	}
+}
+
 void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N)
 {
 	q15_t *gyro_data_buffer[] {_gyro_data_buffer_x, _gyro_data_buffer_y, _gyro_data_buffer_z};
 
-	for (int axis = 0; axis < 3; axis++) {
+	// start with a different axis every update so that the one FFT per cycle is shared evenly
+	const int axis_start = _fft_axis_next;
+
+	for (int i = 0; i < 3; i++) {
+		const int axis = (axis_start + i) % 3;
 		int &buffer_index = _fft_buffer_index[axis];
 
 		for (int n = 0; n < N; n++) {
@@ -414,6 +424,7 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 				arm_rfft_q15(&_rfft_q15, _fft_input_buffer, _fft_outupt_buffer);
 
 				_fft_updated = true;
+				_fft_axis_next = (axis + 1) % 3;
 
 				FindPeaks(timestamp_sample, axis, _fft_outupt_buffer);
 
@@ -436,16 +447,35 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 	// sum total energy across all used buckets for SNR
 	float bin_mag_sum = 0;
 
+	// Welch: average the magnitude spectrum over the last overlapping segments (plain mean until full)
+	float *welch_magnitudes = nullptr;
+	float welch_alpha = 1.f;
+
+	if (_welch_magnitudes) {
+		welch_magnitudes = &_welch_magnitudes[axis * _imu_gyro_fft_len / 2];
+
+		if (_welch_count[axis] < _imu_gyro_fft_avg) {
+			_welch_count[axis]++;
+		}
+
+		welch_alpha = 1.f / _welch_count[axis];
+	}
+
 	// FFT output buffer is ordered [real[0], imag[0], real[1], imag[1], real[2], imag[2] ... real[(N/2)-1], imag[(N/2)-1]
 	for (uint16_t fft_index = 2; fft_index < _imu_gyro_fft_len; fft_index += 2) {
 
 		const float real = fft_outupt_buffer[fft_index];
 		const float imag = fft_outupt_buffer[fft_index + 1];
 
-		const float fft_magnitude = sqrtf(real * real + imag * imag);
+		float fft_magnitude = sqrtf(real * real + imag * imag);
 
 		int bin_index = fft_index / 2;
 
+		if (welch_magnitudes) {
+			welch_magnitudes[bin_index] += welch_alpha * (fft_magnitude - welch_magnitudes[bin_index]);
+			fft_magnitude = welch_magnitudes[bin_index];
+		}
+
 		_peak_magnitudes_all[bin_index] = fft_magnitude;
 		bin_mag_sum += fft_magnitude;
 	}
@@ -703,6 +733,7 @@ int GyroFFT::task_spawn(int argc, char *argv[])
 int GyroFFT::print_status()
 {
 	PX4_INFO("gyro sample rate: %.3f Hz", (double)_gyro_sample_rate_hz);
+	PX4_INFO("FFT length: %" PRId32 ", Welch averaging: %" PRId32, _imu_gyro_fft_len, _imu_gyro_fft_avg);
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_cycle_interval_perf);
 	perf_print_counter(_fft_perf);
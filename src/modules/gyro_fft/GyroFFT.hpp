@@ -88,6 +88,7 @@ private:
 	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer);
 	inline float EstimatePeakFrequencyBin(q15_t fft[], int peak_index);
 	inline void Publish();
+	void ResetBuffers();
 	bool SensorSelectionUpdate(bool force = false);
 	void Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
 	inline void UpdateOutput(const hrt_abstime &timestamp_sample, int axis, float peak_frequencies[MAX_NUM_PEAKS],
@@ -106,6 +107,15 @@ private:
 
 		_peak_magnitudes_all = new float[N];
 
+		if (_param_imu_gyro_fft_avg.get() > 1) {
+			// averaged magnitude spectrum (N/2 bins) per axis
+			_welch_magnitudes = new float[3 * N / 2] {};
+
+			if (!_welch_magnitudes) {
+				return false;
+			}
+		}
+
 		return (_gyro_data_buffer_x && _gyro_data_buffer_y && _gyro_data_buffer_z
 			&& _hanning_window
 			&& _fft_input_buffer
@@ -143,6 +153,10 @@ private:
 
 	float *_peak_magnitudes_all{nullptr};
 
+	// Welch averaging of the magnitude spectra of the overlapping segments (optional)
+	float *_welch_magnitudes{nullptr};
+	int _welch_count[3] {};
+
 	float _gyro_sample_rate_hz{8000}; // 8 kHz default
 
 	float _fifo_last_scale{0};
@@ -158,6 +172,9 @@ private:
 	hrt_abstime _last_update[3][MAX_NUM_PEAKS] {};
 
 	int32_t _imu_gyro_fft_len{256};
+	int32_t _imu_gyro_fft_avg{1};
+
+	int _fft_axis_next{0};
 
 	bool _fft_updated{false};
 	bool _publish{false};
@@ -166,7 +183,8 @@ private:
 		(ParamInt<px4::params::IMU_GYRO_FFT_LEN>) _param_imu_gyro_fft_len,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MIN>) _param_imu_gyro_fft_min,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MAX>) _param_imu_gyro_fft_max,
-		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr
+		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr,
+		(ParamInt<px4::params::IMU_GYRO_FFT_AVG>) _param_imu_gyro_fft_avg
 	)
 };
 
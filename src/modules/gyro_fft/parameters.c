@@ -83,3 +83,18 @@ PARAM_DEFINE_INT32(IMU_GYRO_FFT_LEN, 512);
 * @group Sensors
 */
 PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_SNR, 10.f);
+
+/**
+* IMU gyro FFT Welch averaging.
+*
+* Number of overlapping FFT segments the magnitude spectrum of each axis
+* is averaged over before the peak search (1 to disable). Averaging lowers
+* the variance of the spectrum, which allows peaks with a lower SNR to be
+* tracked reliably or a shorter FFT length to be used for lower latency.
+*
+* @min 1
+* @max 8
+* @reboot_required true
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_FFT_AVG, 1);
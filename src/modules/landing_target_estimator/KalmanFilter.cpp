@@ -43,33 +43,21 @@
 
 namespace landing_target_estimator
 {
-KalmanFilter::KalmanFilter(matrix::Vector<float, 2> &initial, matrix::Matrix<float, 2, 2> &covInit)
-{
-	init(initial, covInit);
-}
 
-void KalmanFilter::init(matrix::Vector<float, 2> &initial, matrix::Matrix<float, 2, 2> &covInit)
+void KalmanFilter::init(const matrix::Vector2f &pos, const matrix::Vector2f &vel, float pos_unc, float vel_unc)
 {
-	_x = initial;
-	_covariance = covInit;
-}
+	_pos = pos;
+	_vel = vel;
 
-void KalmanFilter::init(float initial0, float initial1, float covInit00, float covInit11)
-{
-	matrix::Vector<float, 2> initial;
-	initial(0) = initial0;
-	initial(1) = initial1;
-	matrix::Matrix<float, 2, 2> covInit;
-	covInit(0, 0) = covInit00;
-	covInit(1, 1) = covInit11;
-
-	init(initial, covInit);
+	_covariance.zero();
+	_covariance(0, 0) = pos_unc;
+	_covariance(1, 1) = vel_unc;
 }
 
-void KalmanFilter::predict(float dt, float acc, float acc_unc)
+void KalmanFilter::predict(float dt, const matrix::Vector2f &acc, float acc_unc)
 {
-	_x(0) += _x(1) * dt + dt * dt / 2 * acc;
-	_x(1) += acc * dt;
+	_pos += _vel * dt + acc * (dt * dt / 2);
+	_vel += acc * dt;
 
 	matrix::Matrix<float, 2, 2> A; // propagation matrix
 	A(0, 0) = 1;
@@ -85,20 +73,19 @@ void KalmanFilter::predict(float dt, float acc, float acc_unc)
 	_covariance = A * _covariance * A.transpose() + process_noise;
 }
 
-bool KalmanFilter::update(float meas, float measUnc)
+bool KalmanFilter::update(const matrix::Vector2f &meas, float measUnc)
 {
-
 	// H = [1, 0]
-	_residual = meas - _x(0);
+	_residual = meas - _pos;
 
 	// H * P * H^T simply selects P(0,0)
 	_innovCov = _covariance(0, 0) + measUnc;
 
-	// outlier rejection
-	float beta = _residual / _innovCov * _residual;
+	// outlier rejection of both axes jointly
+	const float beta = _residual.dot(_residual) / _innovCov;
 
-	// 5% false alarm probability
-	if (beta > 3.84f) {
+	// 5% false alarm probability, 2 degrees of freedom
+	if (beta > 5.99f) {
 		return false;
 	}
 
@@ -107,7 +94,8 @@ bool KalmanFilter::update(float meas, float measUnc)
 	kalmanGain(1) = _covariance(1, 0);
 	kalmanGain /= _innovCov;
 
-	_x += kalmanGain * _residual;
+	_pos += _residual * kalmanGain(0);
+	_vel += _residual * kalmanGain(1);
 
 	matrix::Matrix<float, 2, 2> identity;
 	identity.identity();
@@ -119,32 +107,15 @@ bool KalmanFilter::update(float meas, float measUnc)
 	_covariance = (identity - KH) * _covariance;
 
 	return true;
-
-}
-
-void KalmanFilter::getState(matrix::Vector<float, 2> &state)
-{
-	state = _x;
-}
-
-void KalmanFilter::getState(float &state0, float &state1)
-{
-	state0 = _x(0);
-	state1 = _x(1);
-}
-
-void KalmanFilter::getCovariance(matrix::Matrix<float, 2, 2> &covariance)
-{
-	covariance = _covariance;
 }
 
-void KalmanFilter::getCovariance(float &cov00, float &cov11)
+void KalmanFilter::getCovariance(float &cov00, float &cov11) const
 {
 	cov00 = _covariance(0, 0);
 	cov11 = _covariance(1, 1);
 }
 
-void KalmanFilter::getInnovations(float &innov, float &innovCov)
+void KalmanFilter::getInnovations(matrix::Vector2f &innov, float &innovCov) const
 {
 	innov = _residual;
 	innovCov = _innovCov;
@@ -35,12 +35,15 @@
  * @file KalmanFilter.h
  * Simple Kalman Filter for variable gain low-passing
  *
- * Constant velocity model. Prediction according to
+ * Constant velocity model, estimating the x and y axis jointly. Prediction according to
  * x_{k+1} = A * x_{k}
- * with A = [1 dt; 0 1]
+ * with A = [1 dt; 0 1] for each axis
  *
- * Update with a direct measurement of the first state:
- * H = [1 0]
+ * Update with a direct measurement of the position:
+ * H = [1 0] for each axis
+ *
+ * Both axes share the same model, process noise and measurement noise and are always
+ * updated together, so they also share the same 2x2 position/velocity covariance.
  *
  * @author Nicolas de Palezieux (Sunflower Labs) <ndepal@gmail.com>
  *
@@ -63,87 +66,60 @@ public:
 	 */
 	KalmanFilter() {};
 
-	/**
-	 * Constructor, initialize state
-	 */
-	KalmanFilter(matrix::Vector<float, 2> &initial, matrix::Matrix<float, 2, 2> &covInit);
-
 	/**
 	 * Default desctructor
 	 */
 	virtual ~KalmanFilter() {};
 
-	/**
-	 * Initialize filter state
-	 * @param initial initial state
-	 * @param covInit initial covariance
-	 */
-	void init(matrix::Vector<float, 2> &initial, matrix::Matrix<float, 2, 2> &covInit);
-
 	/**
 	 * Initialize filter state, only specifying diagonal covariance elements
-	 * @param initial0  first initial state
-	 * @param initial1  second initial state
-	 * @param covInit00 initial variance of first state
-	 * @param covinit11 initial variance of second state
+	 * @param pos       initial position (x, y)
+	 * @param vel       initial velocity (x, y)
+	 * @param pos_unc   initial variance of the position
+	 * @param vel_unc   initial variance of the velocity
 	 */
-	void init(float initial0, float initial1, float covInit00, float covInit11);
+	void init(const matrix::Vector2f &pos, const matrix::Vector2f &vel, float pos_unc, float vel_unc);
 
 	/**
 	 * Predict the state with an external acceleration estimate
 	 * @param dt            Time delta in seconds since last state change
-	 * @param acc           Acceleration estimate
+	 * @param acc           Acceleration estimate (x, y)
 	 * @param acc_unc       Variance of acceleration estimate
 	 */
-	void predict(float dt, float acc, float acc_unc);
+	void predict(float dt, const matrix::Vector2f &acc, float acc_unc);
 
 	/**
-	 * Update the state estimate with a measurement
-	 * @param meas    state measeasurement
+	 * Update the state estimate with a position measurement of both axes
+	 * @param meas    position measurement (x, y)
 	 * @param measUnc measurement uncertainty
 	 * @return update success (measurement not rejected)
 	 */
-	bool update(float meas, float measUnc);
+	bool update(const matrix::Vector2f &meas, float measUnc);
 
-	/**
-	 * Get the current filter state
-	 * @param x1 State
-	 */
-	void getState(matrix::Vector<float, 2> &state);
-
-	/**
-	 * Get the current filter state
-	 * @param state0 First state
-	 * @param state1 Second state
-	 */
-	void getState(float &state0, float &state1);
-
-	/**
-	 * Get state covariance
-	 * @param covariance Covariance of the state
-	 */
-	void getCovariance(matrix::Matrix<float, 2, 2> &covariance);
+	const matrix::Vector2f &getPosition() const { return _pos; }
+	const matrix::Vector2f &getVelocity() const { return _vel; }
 
 	/**
-	 * Get state variances (diagonal elements)
-	 * @param cov00 Variance of first state
-	 * @param cov11 Variance of second state
+	 * Get state variances (diagonal elements), equal for both axes
+	 * @param cov00 Variance of the position
+	 * @param cov11 Variance of the velocity
 	 */
-	void getCovariance(float &cov00, float &cov11);
+	void getCovariance(float &cov00, float &cov11) const;
 
 	/**
 	 * Get measurement innovation and covariance of last update call
-	 * @param innov Measurement innovation
+	 * @param innov Measurement innovation (x, y)
 	 * @param innovCov Measurement innovation covariance
 	 */
-	void getInnovations(float &innov, float &innovCov);
+	void getInnovations(matrix::Vector2f &innov, float &innovCov) const;
 
 private:
-	matrix::Vector<float, 2> _x; // state
+	matrix::Vector2f _pos; // position state (x, y)
+	matrix::Vector2f _vel; // velocity state (x, y)
 
-	matrix::Matrix<float, 2, 2> _covariance; // state covariance
+	matrix::Matrix<float, 2, 2> _covariance; // state covariance of each axis
 
-	float _residual{0.0f}; // residual of last measurement update
+	matrix::Vector2f _residual; // residual of last measurement update
 
 	float _innovCov{0.0f}; // innovation covariance of last measurement update
 };
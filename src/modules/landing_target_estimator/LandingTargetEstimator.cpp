@@ -63,6 +63,7 @@ LandingTargetEstimator::LandingTargetEstimator()
 	_paramHandle.offset_x = param_find("LTEST_SENS_POS_X");
 	_paramHandle.offset_y = param_find("LTEST_SENS_POS_Y");
 	_paramHandle.offset_z = param_find("LTEST_SENS_POS_Z");
+	_paramHandle.meas_delay = param_find("LTEST_MEAS_DLY");
 	_check_params(true);
 }
 
@@ -72,14 +73,16 @@ void LandingTargetEstimator::update()
 
 	_update_topics();
 
+	const hrt_abstime now = hrt_absolute_time();
+
 	/* predict */
 	if (_estimator_initialized) {
-		if (hrt_absolute_time() - _last_update > landing_target_estimator_TIMEOUT_US) {
+		if (now - _last_update > landing_target_estimator_TIMEOUT_US) {
 			PX4_WARN("Timeout");
 			_estimator_initialized = false;
 
 		} else {
-			float dt = (hrt_absolute_time() - _last_predict) / SEC2USEC;
+			float dt = (now - _last_predict) / SEC2USEC;
 
 			// predict target position with the help of accel data
 			matrix::Vector3f a{_vehicle_acceleration.xyz};
@@ -93,10 +96,11 @@ void LandingTargetEstimator::update()
 				a.zero();
 			}
 
-			_kalman_filter_x.predict(dt, -a(0), _params.acc_unc);
-			_kalman_filter_y.predict(dt, -a(1), _params.acc_unc);
+			const matrix::Vector2f acc_rel(-a(0), -a(1));
+			_kalman_filter.predict(dt, acc_rel, _params.acc_unc);
 
-			_last_predict = hrt_absolute_time();
+			_last_predict = now;
+			_push_filter_history(now, acc_rel);
 		}
 	}
 
@@ -108,28 +112,35 @@ void LandingTargetEstimator::update()
 	// mark this sensor measurement as consumed
 	_new_sensorReport = false;
 
+	const matrix::Vector2f rel_pos(_target_position_report.rel_pos_x, _target_position_report.rel_pos_y);
 
 	if (!_estimator_initialized) {
 		float vx_init = _vehicleLocalPosition.v_xy_valid ? -_vehicleLocalPosition.vx : 0.f;
 		float vy_init = _vehicleLocalPosition.v_xy_valid ? -_vehicleLocalPosition.vy : 0.f;
 		PX4_INFO("Init %.2f %.2f", (double)vx_init, (double)vy_init);
-		_kalman_filter_x.init(_target_position_report.rel_pos_x, vx_init, _params.pos_unc_init, _params.vel_unc_init);
-		_kalman_filter_y.init(_target_position_report.rel_pos_y, vy_init, _params.pos_unc_init, _params.vel_unc_init);
+		_kalman_filter.init(rel_pos, matrix::Vector2f(vx_init, vy_init), _params.pos_unc_init, _params.vel_unc_init);
 
 		_estimator_initialized = true;
-		_last_update = hrt_absolute_time();
+		_last_update = now;
 		_last_predict = _last_update;
 
+		_filter_history_count = 0;
+		_push_filter_history(now, matrix::Vector2f{});
+
 	} else {
 		// update
 		const float measurement_uncertainty = _params.meas_unc * _dist_z * _dist_z;
-		bool update_x = _kalman_filter_x.update(_target_position_report.rel_pos_x, measurement_uncertainty);
-		bool update_y = _kalman_filter_y.update(_target_position_report.rel_pos_y, measurement_uncertainty);
+		const hrt_abstime meas_time = (_target_position_report.timestamp > _params.meas_delay) ?
+					      _target_position_report.timestamp - _params.meas_delay : 0;
 
-		if (!update_x || !update_y) {
+		matrix::Vector2f innov;
+		float innov_cov;
+		const bool updated = _fuse_delayed(meas_time, rel_pos, measurement_uncertainty, innov, innov_cov);
+
+		if (!updated) {
 			if (!_faulty) {
 				_faulty = true;
-				PX4_WARN("Landing target measurement rejected:%s%s", update_x ? "" : " x", update_y ? "" : " y");
+				PX4_WARN("Landing target measurement rejected");
 			}
 
 		} else {
@@ -137,36 +148,35 @@ void LandingTargetEstimator::update()
 		}
 
 		if (!_faulty) {
-			// only publish if both measurements were good
-
-			_target_pose.timestamp = _target_position_report.timestamp;
+			// only publish if the measurement was good
 
-			float x, xvel, y, yvel, covx, covx_v, covy, covy_v;
-			_kalman_filter_x.getState(x, xvel);
-			_kalman_filter_x.getCovariance(covx, covx_v);
+			// the state is latency compensated, it is valid at the last prediction
+			_target_pose.timestamp = _last_predict;
 
-			_kalman_filter_y.getState(y, yvel);
-			_kalman_filter_y.getCovariance(covy, covy_v);
+			const matrix::Vector2f &pos = _kalman_filter.getPosition();
+			const matrix::Vector2f &vel = _kalman_filter.getVelocity();
+			float cov, cov_v;
+			_kalman_filter.getCovariance(cov, cov_v);
 
 			_target_pose.is_static = (_params.mode == TargetMode::Stationary);
 
 			_target_pose.rel_pos_valid = true;
 			_target_pose.rel_vel_valid = true;
-			_target_pose.x_rel = x;
-			_target_pose.y_rel = y;
+			_target_pose.x_rel = pos(0);
+			_target_pose.y_rel = pos(1);
 			_target_pose.z_rel = _target_position_report.rel_pos_z ;
-			_target_pose.vx_rel = xvel;
-			_target_pose.vy_rel = yvel;
+			_target_pose.vx_rel = vel(0);
+			_target_pose.vy_rel = vel(1);
 
-			_target_pose.cov_x_rel = covx;
-			_target_pose.cov_y_rel = covy;
+			_target_pose.cov_x_rel = cov;
+			_target_pose.cov_y_rel = cov;
 
-			_target_pose.cov_vx_rel = covx_v;
-			_target_pose.cov_vy_rel = covy_v;
+			_target_pose.cov_vx_rel = cov_v;
+			_target_pose.cov_vy_rel = cov_v;
 
 			if (_vehicleLocalPosition_valid && _vehicleLocalPosition.xy_valid) {
-				_target_pose.x_abs = x + _vehicleLocalPosition.x;
-				_target_pose.y_abs = y + _vehicleLocalPosition.y;
+				_target_pose.x_abs = pos(0) + _vehicleLocalPosition.x;
+				_target_pose.y_abs = pos(1) + _vehicleLocalPosition.y;
 				_target_pose.z_abs = _target_position_report.rel_pos_z  + _vehicleLocalPosition.z;
 				_target_pose.abs_pos_valid = true;
 
@@ -176,24 +186,85 @@ void LandingTargetEstimator::update()
 
 			_targetPosePub.publish(_target_pose);
 
-			_last_update = hrt_absolute_time();
-			_last_predict = _last_update;
+			_last_update = now;
 		}
 
-		float innov_x, innov_cov_x, innov_y, innov_cov_y;
-		_kalman_filter_x.getInnovations(innov_x, innov_cov_x);
-		_kalman_filter_y.getInnovations(innov_y, innov_cov_y);
-
 		_target_innovations.timestamp = _target_position_report.timestamp;
-		_target_innovations.innov_x = innov_x;
-		_target_innovations.innov_cov_x = innov_cov_x;
-		_target_innovations.innov_y = innov_y;
-		_target_innovations.innov_cov_y = innov_cov_y;
+		_target_innovations.innov_x = innov(0);
+		_target_innovations.innov_cov_x = innov_cov;
+		_target_innovations.innov_y = innov(1);
+		_target_innovations.innov_cov_y = innov_cov;
 
 		_targetInnovationsPub.publish(_target_innovations);
 	}
 }
 
+void LandingTargetEstimator::_push_filter_history(hrt_abstime time, const matrix::Vector2f &acc)
+{
+	if (_filter_history_count > 0) {
+		_filter_history_head = (_filter_history_head + 1) % FILTER_HISTORY_LEN;
+	}
+
+	_filter_history_count = math::min(_filter_history_count + 1, FILTER_HISTORY_LEN);
+
+	FilterSample &sample = _filter_history[_filter_history_head];
+	sample.time = time;
+	sample.acc = acc;
+	sample.filter = _kalman_filter;
+}
+
+bool LandingTargetEstimator::_fuse_delayed(hrt_abstime time, const matrix::Vector2f &meas, float meas_unc,
+		matrix::Vector2f &innov, float &innov_cov)
+{
+	// newest sample taken at or before the measurement, the oldest one if the measurement is older than the history
+	int index = _filter_history_head;
+	int newer = 0; // number of samples after index
+
+	while (newer < _filter_history_count - 1 && _filter_history[index].time > time) {
+		index = (index + FILTER_HISTORY_LEN - 1) % FILTER_HISTORY_LEN;
+		newer++;
+	}
+
+	if (newer == 0) {
+		// measurement is not older than the latest prediction
+		const bool updated = _kalman_filter.update(meas, meas_unc);
+		_kalman_filter.getInnovations(innov, innov_cov);
+
+		if (updated) {
+			_filter_history[_filter_history_head].filter = _kalman_filter;
+		}
+
+		return updated;
+	}
+
+	// propagate to the measurement with the acceleration of the step it falls into
+	KalmanFilter filter = _filter_history[index].filter;
+	hrt_abstime filter_time = math::max(time, _filter_history[index].time);
+	int next = (index + 1) % FILTER_HISTORY_LEN;
+
+	filter.predict((filter_time - _filter_history[index].time) / SEC2USEC, _filter_history[next].acc, _params.acc_unc);
+
+	const bool updated = filter.update(meas, meas_unc);
+	filter.getInnovations(innov, innov_cov);
+
+	if (!updated) {
+		return false;
+	}
+
+	// replay the predictions up to now
+	for (; newer > 0; newer--) {
+		FilterSample &sample = _filter_history[next];
+		filter.predict((sample.time - filter_time) / SEC2USEC, sample.acc, _params.acc_unc);
+		sample.filter = filter;
+		filter_time = sample.time;
+		next = (next + 1) % FILTER_HISTORY_LEN;
+	}
+
+	_kalman_filter = filter;
+
+	return true;
+}
+
 void LandingTargetEstimator::_check_params(const bool force)
 {
 	if (_parameter_update_sub.updated() || force) {
@@ -303,6 +374,10 @@ void LandingTargetEstimator::_update_params()
 	param_get(_paramHandle.offset_x, &_params.offset_x);
 	param_get(_paramHandle.offset_y, &_params.offset_y);
 	param_get(_paramHandle.offset_z, &_params.offset_z);
+
+	float meas_delay = 0.f;
+	param_get(_paramHandle.meas_delay, &meas_delay);
+	_params.meas_delay = static_cast<hrt_abstime>(math::max(meas_delay, 0.f) * 1000.f);
 }
 
 
@@ -96,6 +96,9 @@ protected:
 	/* timeout after which filter is reset if target not seen */
 	static constexpr uint32_t landing_target_estimator_TIMEOUT_US = 2000000;
 
+	/* number of filter states kept to fuse delayed measurements (0.5 s at the 50 Hz update rate) */
+	static constexpr int FILTER_HISTORY_LEN = 25;
+
 	uORB::Publication<landing_target_pose_s> _targetPosePub{ORB_ID(landing_target_pose)};
 	landing_target_pose_s _target_pose{};
 
@@ -126,6 +129,7 @@ private:
 		param_t offset_y;
 		param_t offset_z;
 		param_t sensor_yaw;
+		param_t meas_delay;
 	} _paramHandle;
 
 	struct {
@@ -140,6 +144,7 @@ private:
 		float offset_y;
 		float offset_z;
 		enum Rotation sensor_yaw;
+		hrt_abstime meas_delay;
 	} _params;
 
 	struct {
@@ -175,8 +180,18 @@ private:
 	matrix::Dcmf _R_att; //Orientation of the body frame
 	matrix::Dcmf _S_att; //Orientation of the sensor relative to body frame
 	matrix::Vector2f _rel_pos;
-	KalmanFilter _kalman_filter_x;
-	KalmanFilter _kalman_filter_y;
+	KalmanFilter _kalman_filter;
+
+	struct FilterSample {
+		hrt_abstime time;
+		matrix::Vector2f acc; // relative acceleration over the prediction step ending at time
+		KalmanFilter filter;  // filter state at time
+	};
+
+	FilterSample _filter_history[FILTER_HISTORY_LEN] {};
+	int _filter_history_head{0}; // index of the newest sample
+	int _filter_history_count{0};
+
 	hrt_abstime _last_predict{0}; // timestamp of last filter prediction
 	hrt_abstime _last_update{0}; // timestamp of last filter update (used to check timeout)
 	float _dist_z{1.0f};
@@ -184,5 +199,13 @@ private:
 	void _check_params(const bool force);
 
 	void _update_state();
+
+	void _push_filter_history(hrt_abstime time, const matrix::Vector2f &acc);
+
+	/*
+	 * Fuse a measurement at the time it was taken and replay the predictions since then.
+	 */
+	bool _fuse_delayed(hrt_abstime time, const matrix::Vector2f &meas, float meas_unc,
+			   matrix::Vector2f &innov, float &innov_cov);
 };
 } // namespace landing_target_estimator
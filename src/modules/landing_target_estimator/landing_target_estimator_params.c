@@ -187,3 +187,18 @@ PARAM_DEFINE_FLOAT(LTEST_SENS_POS_Y, 0.0f);
  *
  */
 PARAM_DEFINE_FLOAT(LTEST_SENS_POS_Z, 0.0f);
+
+/**
+ * Landing target measurement delay
+ *
+ * Time between capturing the landing target and the timestamp of the sensor report.
+ * Measurements are fused at their capture time and the filter is propagated forward
+ * from there, measurements older than 500 ms are fused with the oldest stored state.
+ *
+ * @unit ms
+ * @min 0
+ * @max 300
+ * @decimal 1
+ * @group Landing target Estimator
+ */
+PARAM_DEFINE_FLOAT(LTEST_MEAS_DLY, 0.0f);
@@ -100,6 +100,15 @@ void LoadMon::Run()
 	perf_begin(_cycle_perf);
 
 	cpuload();
+	work_item_stats();
+
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+	heap_usage();
+#endif // CONFIG_SYSTEMCMDS_MEM
+
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	uorb_latency_publish();
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
 
 #if defined(__PX4_NUTTX)
 
@@ -120,6 +129,81 @@ void LoadMon::Run()
 	perf_end(_cycle_perf);
 }
 
+void LoadMon::work_item_stats()
+{
+	struct Context {
+		uORB::Publication<work_item_stats_s> &pub;
+		int begin;
+		int end;
+		int index;
+	};
+
+	// publish up to ORB_QUEUE_LENGTH items per cycle, continuing where the previous cycle stopped
+	Context context{_work_item_stats_pub, _work_item_stats_index, _work_item_stats_index + work_item_stats_s::ORB_QUEUE_LENGTH, 0};
+
+	px4::WorkQueueManagerForEachItem([](const px4::WorkQueue & wq, const px4::WorkItem & item, void *arg) {
+		Context &ctx = *static_cast<Context *>(arg);
+
+		if ((ctx.index >= ctx.begin) && (ctx.index < ctx.end)) {
+			const px4::WorkItem::RunStatistics &stats = item.run_statistics();
+
+			work_item_stats_s report{};
+			strncpy(report.item_name, item.ItemName(), sizeof(report.item_name) - 1);
+			strncpy(report.wq_name, wq.get_name(), sizeof(report.wq_name) - 1);
+			report.run_count = stats.run_count;
+			report.run_time_total = stats.run_time_total;
+			report.run_time_max = stats.run_time_max;
+			report.latency_total = stats.latency_total;
+			report.latency_max = stats.latency_max;
+			report.deadline = item.deadline();
+			report.deadline_misses = stats.deadline_misses;
+			report.timestamp = hrt_absolute_time();
+			ctx.pub.publish(report);
+		}
+
+		ctx.index++;
+	}, &context);
+
+	// wrap around once all items have been published
+	_work_item_stats_index = (context.index > context.end) ? context.end : 0;
+}
+
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+void LoadMon::heap_usage()
+{
+	px4_heap_totals totals;
+	px4_heap_get_totals(&totals);
+
+	// publish up to ORB_QUEUE_LENGTH modules per cycle, continuing where the previous cycle stopped
+	px4_heap_module_usage usage;
+	int published = 0;
+
+	while (published < heap_usage_s::ORB_QUEUE_LENGTH) {
+		if (!px4_heap_get_module_usage(_heap_usage_index, &usage)) {
+			_heap_usage_index = 0;
+			break;
+		}
+
+		heap_usage_s report{};
+		strncpy(report.module_name, usage.name, sizeof(report.module_name) - 1);
+		report.live_bytes = usage.live_bytes;
+		report.live_allocations = usage.live_allocations;
+		report.peak_bytes = usage.peak_bytes;
+		report.allocations = usage.allocations;
+		report.total_live_bytes = totals.live_bytes;
+		report.total_peak_bytes = totals.peak_bytes;
+		report.heap_free = totals.heap_free;
+		report.heap_largest_free = totals.heap_largest_free;
+		report.fragmentation = totals.fragmentation;
+		report.timestamp = hrt_absolute_time();
+		_heap_usage_pub.publish(report);
+
+		_heap_usage_index++;
+		published++;
+	}
+}
+#endif // CONFIG_SYSTEMCMDS_MEM
+
 void LoadMon::cpuload()
 {
 #if defined(__PX4_LINUX)
@@ -245,45 +329,105 @@ void LoadMon::cpuload()
 }
 
 #if defined(__PX4_NUTTX)
-void LoadMon::stack_usage()
+unsigned LoadMon::check_stack_free(const tcb_s *tcb, StackWatermark &watermark)
 {
-	unsigned stack_free = 0;
+	// the stack grows down: the free (still colored) words are at the bottom
+	static constexpr uint32_t STACK_COLOR = 0xdeadbeef;
+
+	const uint32_t *stack = (const uint32_t *)(((uintptr_t)tcb->stack_base_ptr + 3) & ~(uintptr_t)3);
+	const unsigned num_words = tcb->adj_stack_size / sizeof(uint32_t);
+
+	const bool known = (watermark.pid == tcb->pid) && (watermark.free_words <= num_words);
+
+	if (known && (++watermark.checks_since_full_scan < STACK_FULL_SCAN_INTERVAL)) {
+		// the stack only grows past the high-water mark through the words right below it
+		const unsigned window_start = (watermark.free_words > STACK_WATERMARK_WINDOW) ?
+					      (watermark.free_words - STACK_WATERMARK_WINDOW) : 0;
+
+		bool unchanged = true;
+
+		for (unsigned i = window_start; i < watermark.free_words; i++) {
+			if (stack[i] != STACK_COLOR) {
+				unchanged = false;
+				break;
+			}
+		}
+
+		if (unchanged) {
+			return watermark.free_words * sizeof(uint32_t);
+		}
+	}
+
+	// full scan from the bottom, once in a while also catches frames not touching the words below the mark
+	const unsigned limit = known ? watermark.free_words : num_words;
+	unsigned free_words = 0;
+
+	while ((free_words < limit) && (stack[free_words] == STACK_COLOR)) {
+		free_words++;
+	}
+
+	watermark.pid = tcb->pid;
+	watermark.free_words = free_words;
+	watermark.checks_since_full_scan = 0;
 
-	bool checked_task = false;
+	return free_words * sizeof(uint32_t);
+}
 
-	task_stack_info_s task_stack_info{};
-	static_assert(sizeof(task_stack_info.task_name) == CONFIG_TASK_NAME_SIZE,
-		      "task_stack_info.task_name must match NuttX CONFIG_TASK_NAME_SIZE");
+void LoadMon::stack_usage()
+{
+	const hrt_abstime now = hrt_absolute_time();
 
-	sched_lock();
+	for (int checked = 0; checked < STACK_CHECKS_PER_CYCLE; checked++) {
+		const int index = _stack_task_index;
 
-	if (system_load.tasks[_stack_task_index].valid && (system_load.tasks[_stack_task_index].tcb->pid > 0)) {
+		// Continue after last checked task next cycle
+		_stack_task_index = (_stack_task_index + 1) % CONFIG_FS_PROCFS_MAX_TASKS;
 
-		stack_free = up_check_tcbstack_remain(system_load.tasks[_stack_task_index].tcb);
+		unsigned stack_free = 0;
+		uint64_t total_runtime = 0;
+		bool checked_task = false;
 
-		strncpy((char *)task_stack_info.task_name, system_load.tasks[_stack_task_index].tcb->name, CONFIG_TASK_NAME_SIZE - 1);
-		task_stack_info.task_name[CONFIG_TASK_NAME_SIZE - 1] = '\0';
+		task_stack_info_s task_stack_info{};
+		static_assert(sizeof(task_stack_info.task_name) == CONFIG_TASK_NAME_SIZE,
+			      "task_stack_info.task_name must match NuttX CONFIG_TASK_NAME_SIZE");
 
-		checked_task = true;
+		sched_lock();
 
-#if CONFIG_NFILE_DESCRIPTORS_PER_BLOCK > 0
-		unsigned int tcb_num_used_fds = 0; // number of used file descriptors
-		struct filelist *filelist = &system_load.tasks[_stack_task_index].tcb->group->tg_filelist;
+		if (system_load.tasks[index].valid && (system_load.tasks[index].tcb->pid > 0)) {
 
-		for (int fdr = 0; fdr < filelist->fl_rows; fdr++) {
-			for (int fdc = 0; fdc < CONFIG_NFILE_DESCRIPTORS_PER_BLOCK; fdc++) {
-				if (filelist->fl_files[fdr][fdc].f_inode) {
-					++tcb_num_used_fds;
-				}
+			if (_stack_watermarks[index].pid != system_load.tasks[index].tcb->pid) {
+				// a new task in this slot
+				_stack_watermarks[index] = {};
 			}
+
+			stack_free = check_stack_free(system_load.tasks[index].tcb, _stack_watermarks[index]);
+			total_runtime = system_load.tasks[index].total_runtime;
+
+			strncpy((char *)task_stack_info.task_name, system_load.tasks[index].tcb->name, CONFIG_TASK_NAME_SIZE - 1);
+			task_stack_info.task_name[CONFIG_TASK_NAME_SIZE - 1] = '\0';
+
+			checked_task = true;
 		}
 
-#endif // CONFIG_NFILE_DESCRIPTORS_PER_BLOCK
-	}
+		sched_unlock();
+
+		if (!checked_task) {
+			continue;
+		}
+
+		// CPU load since the previous sample of this task (the work queues run in their own tasks)
+		StackWatermark &watermark = _stack_watermarks[index];
 
-	sched_unlock();
+		if ((watermark.last_sample > 0) && (now > watermark.last_sample) && (total_runtime >= watermark.last_runtime)) {
+			task_stack_info.cpu_load = (float)(total_runtime - watermark.last_runtime) / (float)(now - watermark.last_sample);
+
+		} else {
+			task_stack_info.cpu_load = NAN;
+		}
+
+		watermark.last_runtime = total_runtime;
+		watermark.last_sample = now;
 
-	if (checked_task) {
 		task_stack_info.stack_free = stack_free;
 		task_stack_info.timestamp = hrt_absolute_time();
 
@@ -292,11 +436,9 @@ void LoadMon::stack_usage()
 		// Found task low on stack, report and exit. Continue here in next cycle.
 		if (stack_free < STACK_LOW_WARNING_THRESHOLD) {
 			PX4_WARN("%s low on stack! (%i bytes left)", task_stack_info.task_name, stack_free);
+			break;
 		}
 	}
-
-	// Continue after last checked task next cycle
-	_stack_task_index = (_stack_task_index + 1) % CONFIG_FS_PROCFS_MAX_TASKS;
 }
 #endif
 
@@ -313,7 +455,9 @@ Background process running periodically on the low priority work queue to calcul
 usage and publish the `cpuload` topic.
 
 On NuttX it also checks the stack usage of each process and if it falls below 300 bytes, a warning is output,
-which will also appear in the log file.
+which will also appear in the log file. The check only looks at the words below the previous high-water mark
+(with a full scan every 10th check), so a few processes are checked every cycle. Together with the stack usage
+the CPU load of every process (and therefore of every work queue) is published (`task_stack_info`).
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("load_mon", "system");
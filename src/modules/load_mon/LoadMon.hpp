@@ -40,13 +40,16 @@
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
+#include <px4_platform_common/heap_accounting.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <px4_platform/cpuload.h>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
+#include <uORB/topics/heap_usage.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_stats.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -81,16 +84,51 @@ private:
 	/** Do a calculation of the CPU load and publish it. */
 	void cpuload();
 
+	/** Publish the run statistics of the next batch of WorkItems. */
+	void work_item_stats();
+
+#if defined(CONFIG_SYSTEMCMDS_MEM)
+	/** Publish the heap usage of the next batch of modules. */
+	void heap_usage();
+
+	uORB::Publication<heap_usage_s> _heap_usage_pub{ORB_ID(heap_usage)};
+
+	int _heap_usage_index{0};
+#endif // CONFIG_SYSTEMCMDS_MEM
+
 	/* Stack check only available on Nuttx */
 #if defined(__PX4_NUTTX)
 	/* Calculate stack usage */
 	void stack_usage();
 
+	struct StackWatermark {
+		pid_t pid;
+		unsigned free_words; ///< free stack at the last check (the high-water mark)
+		uint8_t checks_since_full_scan;
+		uint64_t last_runtime; ///< task runtime at the last check [us]
+		hrt_abstime last_sample;
+	};
+
+	/**
+	 * Get the free stack of a task. Only the words below the last high-water mark are checked,
+	 * with a full scan every STACK_FULL_SCAN_INTERVAL checks.
+	 */
+	unsigned check_stack_free(const tcb_s *tcb, StackWatermark &watermark);
+
+	static constexpr int STACK_CHECKS_PER_CYCLE = 4;
+	static constexpr unsigned STACK_WATERMARK_WINDOW = 16; ///< [words]
+	static constexpr uint8_t STACK_FULL_SCAN_INTERVAL = 10;
+
+	StackWatermark _stack_watermarks[CONFIG_FS_PROCFS_MAX_TASKS] {};
+
 	int _stack_task_index{0};
 
 	uORB::Publication<task_stack_info_s> _task_stack_info_pub{ORB_ID(task_stack_info)};
 #endif
 	uORB::Publication<cpuload_s> _cpuload_pub {ORB_ID(cpuload)};
+	uORB::Publication<work_item_stats_s> _work_item_stats_pub{ORB_ID(work_item_stats)};
+
+	int _work_item_stats_index{0};
 
 #if defined(__PX4_LINUX)
 	FILE *_proc_fd = nullptr;
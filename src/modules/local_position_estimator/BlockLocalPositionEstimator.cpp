@@ -966,8 +966,30 @@ void BlockLocalPositionEstimator::predict(const sensor_combined_s &imu)
 
 	// propagate
 	_x += dx;
-	Matrix<float, n_x, n_x> dP = (m_A * m_P + m_P * m_A.transpose() +
-				      m_B * m_R * m_B.transpose() + m_Q) * getDt();
+
+	// dP = (A * P + P * A^T + B * R * B^T + Q) * dt, only the position rows
+	// (velocity) and the velocity rows (rotated accel bias) of A are non-zero
+	Matrix<float, n_x, n_x> AP;
+
+	for (size_t j = 0; j < n_x; j++) {
+		for (size_t i = 0; i < 3; i++) {
+			AP(X_x + i, j) = m_P(X_vx + i, j);
+			AP(X_vx + i, j) = m_A(X_vx + i, X_bx) * m_P(X_bx, j)
+					  + m_A(X_vx + i, X_by) * m_P(X_by, j)
+					  + m_A(X_vx + i, X_bz) * m_P(X_bz, j);
+		}
+	}
+
+	Matrix<float, n_x, n_x> dP = AP + AP.transpose() + m_Q;
+
+	// B maps the input directly to the velocity states
+	for (size_t i = 0; i < n_u; i++) {
+		for (size_t j = 0; j < n_u; j++) {
+			dP(X_vx + i, X_vx + j) += m_R(i, j);
+		}
+	}
+
+	dP *= getDt();
 
 	// covariance propagation logic
 	for (size_t i = 0; i < n_x; i++) {
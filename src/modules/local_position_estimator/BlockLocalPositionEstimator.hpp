@@ -186,6 +186,74 @@ private:
 	// predict the next state
 	void predict(const sensor_combined_s &imu);
 
+	// Kalman filter correction kernels exploiting that the measurement matrices C
+	// only have one or two non-zero entries per row and P is symmetric
+
+	// P * C^T
+	template<size_t m>
+	Matrix<float, n_x, m> covarianceTimesCt(const Matrix<float, m, n_x> &C) const
+	{
+		Matrix<float, n_x, m> PCt;
+
+		for (size_t i = 0; i < m; i++) {
+			for (size_t k = 0; k < n_x; k++) {
+				if (C(i, k) != 0.f) {
+					for (size_t j = 0; j < n_x; j++) {
+						PCt(j, i) += m_P(j, k) * C(i, k);
+					}
+				}
+			}
+		}
+
+		return PCt;
+	}
+
+	// innovation covariance C * P * C^T + R
+	template<size_t m>
+	Matrix<float, m, m> innovationCovariance(const Matrix<float, m, n_x> &C, const Matrix<float, m, m> &R) const
+	{
+		const Matrix<float, n_x, m> PCt = covarianceTimesCt(C);
+		Matrix<float, m, m> S = R;
+
+		for (size_t i = 0; i < m; i++) {
+			for (size_t k = 0; k < n_x; k++) {
+				if (C(i, k) != 0.f) {
+					for (size_t j = 0; j < m; j++) {
+						S(i, j) += C(i, k) * PCt(k, j);
+					}
+				}
+			}
+		}
+
+		return S;
+	}
+
+	// x += K * r, P -= K * C * P with the gain K = P * C^T * S_I
+	template<size_t m>
+	void correct(const Matrix<float, m, n_x> &C, const Matrix<float, m, m> &S_I, const Matrix<float, m, 1> &r)
+	{
+		const Matrix<float, n_x, m> PCt = covarianceTimesCt(C);
+		const Matrix<float, n_x, m> K = PCt * S_I;
+		_x += K * r;
+
+		// K * C * P = K * (P * C^T)^T, symmetric: compute the lower triangle only
+		for (size_t i = 0; i < n_x; i++) {
+			for (size_t j = 0; j <= i; j++) {
+				float KCP = 0.f;
+
+				for (size_t k = 0; k < m; k++) {
+					KCP += K(i, k) * PCt(j, k);
+				}
+
+				m_P(i, j) -= KCP;
+
+				if (i != j) {
+					m_P(j, i) -= KCP;
+				}
+			}
+		}
+	}
+
 	// lidar
 	int  lidarMeasure(Vector<float, n_y_lidar> &y);
 	void lidarCorrect();
@@ -68,7 +68,7 @@ void BlockLocalPositionEstimator::baroCorrect()
 
 	// residual
 	Matrix<float, n_y_baro, n_y_baro> S_I =
-		inv<float, n_y_baro>((C * m_P * C.transpose()) + R);
+		inv<float, n_y_baro>(innovationCovariance(C, R));
 	Vector<float, n_y_baro> r = y - (C * _x);
 
 	// fault detection
@@ -87,10 +87,7 @@ void BlockLocalPositionEstimator::baroCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_baro> K = m_P * C.transpose() * S_I;
-	Vector<float, n_x> dx = K * r;
-	_x += dx;
-	m_P -= K * C * m_P;
+	correct(C, S_I, r);
 }
 
 void BlockLocalPositionEstimator::baroCheckTimeout()
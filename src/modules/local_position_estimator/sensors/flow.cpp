@@ -167,7 +167,7 @@ void BlockLocalPositionEstimator::flowCorrect()
 	Vector<float, 2> r = y - C * _x;
 
 	// residual covariance
-	Matrix<float, n_y_flow, n_y_flow> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_flow, n_y_flow> S = innovationCovariance(C, R);
 
 	// publish innovations
 	_pub_innov.get().flow[0] = r(0);
@@ -193,11 +193,7 @@ void BlockLocalPositionEstimator::flowCorrect()
 	}
 
 	if (!(_sensorFault & SENSOR_FLOW)) {
-		Matrix<float, n_x, n_y_flow> K =
-			m_P * C.transpose() * S_I;
-		Vector<float, n_x> dx = K * r;
-		_x += dx;
-		m_P -= K * C * m_P;
+		correct(C, S_I, r);
 	}
 }
 
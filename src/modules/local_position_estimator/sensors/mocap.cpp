@@ -139,7 +139,7 @@ void BlockLocalPositionEstimator::mocapCorrect()
 	// residual
 	Vector<float, n_y_mocap> r = y - C * _x;
 	// residual covariance
-	Matrix<float, n_y_mocap, n_y_mocap> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_y_mocap, n_y_mocap> S = innovationCovariance(C, R);
 
 	// publish innovations
 	_pub_innov.get().ev_hpos[0] = r(0);
@@ -175,10 +175,7 @@ void BlockLocalPositionEstimator::mocapCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_mocap> K = m_P * C.transpose() * S_I;
-	Vector<float, n_x> dx = K * r;
-	_x += dx;
-	m_P -= K * C * m_P;
+	correct(C, S_I, r);
 }
 
 void BlockLocalPositionEstimator::mocapCheckTimeout()
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_compressor.h"
+#include "messages.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+static constexpr int MIN_MATCH = 4;
+static constexpr int LAST_LITERALS = 5; ///< the last 5 bytes of a block are always literals
+static constexpr int MF_LIMIT = 12; ///< the last match must start at least 12 bytes before the end
+
+bool LogCompressor::enable()
+{
+	if (enabled()) {
+		return true;
+	}
+
+	// worst case output: every 255 literals take one extra byte
+	const size_t output_size = sizeof(ulog_message_compressed_s) + BLOCK_SIZE + BLOCK_SIZE / 255 + 16;
+	uint8_t *buffer = (uint8_t *)malloc(BLOCK_SIZE + output_size + HASH_TABLE_SIZE * sizeof(uint16_t));
+
+	if (!buffer) {
+		return false;
+	}
+
+	_hash_table = (uint16_t *)buffer;
+	_block = buffer + HASH_TABLE_SIZE * sizeof(uint16_t);
+	_output = _block + BLOCK_SIZE;
+	_block_size = 0;
+	_total_in = 0;
+	_total_out = 0;
+	return true;
+}
+
+void LogCompressor::disable()
+{
+	free(_hash_table);
+	_hash_table = nullptr;
+	_block = nullptr;
+	_output = nullptr;
+	_block_size = 0;
+}
+
+bool LogCompressor::append(const void *ptr, size_t size)
+{
+	if (!enabled() || _block_size + size > BLOCK_SIZE) {
+		return false;
+	}
+
+	if (_block_size == 0) {
+		_block_start = hrt_absolute_time();
+	}
+
+	memcpy(_block + _block_size, ptr, size);
+	_block_size += size;
+	return true;
+}
+
+const uint8_t *LogCompressor::finish(size_t &size)
+{
+	const size_t header_size = sizeof(ulog_message_compressed_s);
+	const size_t block_size = _block_size;
+	_block_size = 0;
+	_total_in += block_size;
+
+	// only use the compressed message if it is smaller
+	int compressed_size = -1;
+
+	if (block_size > header_size + MF_LIMIT) {
+		compressed_size = compress(_block, block_size, _output + header_size, block_size - header_size, _hash_table);
+	}
+
+	if (compressed_size <= 0) {
+		size = block_size;
+		_total_out += size;
+		return _block;
+	}
+
+	ulog_message_compressed_s header{};
+	header.msg_size = header_size + compressed_size - ULOG_MSG_HEADER_LEN;
+	header.algorithm = ULOG_COMPRESSION_LZ4_BLOCK;
+	header.uncompressed_size = block_size;
+	memcpy(_output, &header, header_size);
+
+	size = header_size + compressed_size;
+	_total_out += size;
+	return _output;
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t hash_sequence(uint32_t sequence)
+{
+	return (sequence * 2654435761U) >> (32 - LogCompressor::HASH_LOG);
+}
+
+static inline uint8_t *write_length(uint8_t *op, int length)
+{
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+int LogCompressor::compress(const uint8_t *src, int src_size, uint8_t *dst, int dst_capacity, uint16_t *hash_table)
+{
+	if (src_size <= 0 || src_size > UINT16_MAX) {
+		return -1;
+	}
+
+	// positions are relative to src, so stale entries are harmless: every candidate is verified
+	memset(hash_table, 0, HASH_TABLE_SIZE * sizeof(uint16_t));
+
+	uint8_t *op = dst;
+	uint8_t *const op_end = dst + dst_capacity;
+	int ip = 0;
+	int anchor = 0;
+
+	while (ip <= src_size - MF_LIMIT) {
+		const uint32_t sequence = read32(src + ip);
+		const uint32_t h = hash_sequence(sequence);
+		const int ref = hash_table[h];
+		hash_table[h] = ip;
+
+		if (ref >= ip || read32(src + ref) != sequence) {
+			++ip;
+			continue;
+		}
+
+		int match_length = MIN_MATCH;
+		const int max_match_length = src_size - LAST_LITERALS - ip;
+
+		while (match_length < max_match_length && src[ip + match_length] == src[ref + match_length]) {
+			++match_length;
+		}
+
+		// token + literals + offset + length bytes
+		const int literal_length = ip - anchor;
+		const int extra_length = match_length - MIN_MATCH;
+
+		if (op + 1 + literal_length / 255 + 1 + literal_length + 2 + extra_length / 255 + 1 > op_end) {
+			return -1;
+		}
+
+		uint8_t *token = op++;
+		*token = (uint8_t)(((literal_length < 15 ? literal_length : 15) << 4) | (extra_length < 15 ? extra_length : 15));
+
+		if (literal_length >= 15) {
+			op = write_length(op, literal_length - 15);
+		}
+
+		memcpy(op, src + anchor, literal_length);
+		op += literal_length;
+
+		const int offset = ip - ref;
+		*op++ = (uint8_t)offset;
+		*op++ = (uint8_t)(offset >> 8);
+
+		if (extra_length >= 15) {
+			op = write_length(op, extra_length - 15);
+		}
+
+		ip += match_length;
+		anchor = ip;
+	}
+
+	// last literals
+	const int literal_length = src_size - anchor;
+
+	if (op + 1 + literal_length / 255 + 1 + literal_length > op_end) {
+		return -1;
+	}
+
+	*op++ = (uint8_t)((literal_length < 15 ? literal_length : 15) << 4);
+
+	if (literal_length >= 15) {
+		op = write_length(op, literal_length - 15);
+	}
+
+	memcpy(op, src + anchor, literal_length);
+	op += literal_length;
+
+	return op - dst;
+}
+
+} // namespace logger
+} // namespace px4
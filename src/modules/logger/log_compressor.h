@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <drivers/drv_hrt.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogCompressor
+ * Collects consecutive ULog messages into a block and compresses the block into a single
+ * ULog COMPRESSED message (LZ4 block format). Messages are never split, so the decompressed
+ * data of each block is a valid sequence of ULog messages.
+ */
+class LogCompressor
+{
+public:
+	static constexpr size_t BLOCK_SIZE = 4096; ///< maximum uncompressed size of a block
+	static constexpr hrt_abstime MAX_BLOCK_AGE = 100000; ///< [us] a partially filled block is written after this time
+
+	LogCompressor() = default;
+	~LogCompressor() { disable(); }
+
+	LogCompressor(const LogCompressor &) = delete;
+	LogCompressor &operator=(const LogCompressor &) = delete;
+
+	/**
+	 * allocate the buffers
+	 * @return true on success
+	 */
+	bool enable();
+
+	/** free the buffers & drop any staged data */
+	void disable();
+
+	bool enabled() const { return _block != nullptr; }
+
+	bool empty() const { return _block_size == 0; }
+
+	/**
+	 * Add a complete ULog message to the current block
+	 * @return false if it does not fit (the block needs to be finished first)
+	 */
+	bool append(const void *ptr, size_t size);
+
+	/**
+	 * whether the current block should be written (almost full or too old)
+	 */
+	bool should_finish() const
+	{
+		return _block_size > BLOCK_SIZE - BLOCK_SIZE / 8 || hrt_elapsed_time(&_block_start) > MAX_BLOCK_AGE;
+	}
+
+	/**
+	 * Compress the current block and start a new one. If the data does not compress, the staged
+	 * messages are returned as is.
+	 * @param size output: number of bytes to write
+	 * @return data to write, valid until the next call to append()
+	 */
+	const uint8_t *finish(size_t &size);
+
+	uint64_t total_in() const { return _total_in; }
+	uint64_t total_out() const { return _total_out; }
+
+	/**
+	 * Compress a buffer using the LZ4 block format
+	 * @param hash_table scratch memory of HASH_TABLE_SIZE entries
+	 * @return compressed size, or -1 if the result does not fit into dst_capacity
+	 */
+	static int compress(const uint8_t *src, int src_size, uint8_t *dst, int dst_capacity, uint16_t *hash_table);
+
+	static constexpr int HASH_LOG = 11;
+	static constexpr int HASH_TABLE_SIZE = 1 << HASH_LOG;
+
+private:
+	uint8_t *_block{nullptr}; ///< staged messages
+	uint8_t *_output{nullptr}; ///< compressed message (header + data)
+	uint16_t *_hash_table{nullptr};
+
+	size_t _block_size{0};
+	hrt_abstime _block_start{0};
+
+	uint64_t _total_in{0};
+	uint64_t _total_out{0};
+};
+
+} // namespace logger
+} // namespace px4
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_index.h"
+
+#include <stdlib.h>
+
+namespace px4
+{
+namespace logger
+{
+
+bool LogIndex::start()
+{
+	if (!active()) {
+		uint8_t *buffer = (uint8_t *)malloc(MAX_ENTRIES * sizeof(ulog_index_entry_s) + 2 * MAX_OFFSETS * sizeof(uint32_t));
+
+		if (!buffer) {
+			return false;
+		}
+
+		_add_logged_offsets = (uint32_t *)buffer;
+		_parameter_offsets = _add_logged_offsets + MAX_OFFSETS;
+		_entries = (ulog_index_entry_s *)(_parameter_offsets + MAX_OFFSETS);
+	}
+
+	_num_entries = 0;
+	_num_add_logged = 0;
+	_num_parameters = 0;
+	_sync_stride = 1;
+	_sync_count = 0;
+	_incomplete = false;
+	return true;
+}
+
+void LogIndex::stop()
+{
+	free(_add_logged_offsets);
+	_add_logged_offsets = nullptr;
+	_parameter_offsets = nullptr;
+	_entries = nullptr;
+}
+
+void LogIndex::add_sync(hrt_abstime timestamp, size_t offset)
+{
+	if (!active() || offset > UINT32_MAX) {
+		return;
+	}
+
+	if (++_sync_count < _sync_stride) {
+		return;
+	}
+
+	_sync_count = 0;
+
+	if (_num_entries == MAX_ENTRIES) {
+		// keep every other entry
+		for (int i = 0; i < MAX_ENTRIES / 2; ++i) {
+			_entries[i] = _entries[2 * i + 1];
+		}
+
+		_num_entries = MAX_ENTRIES / 2;
+		_sync_stride *= 2;
+	}
+
+	// the struct is packed
+	ulog_index_entry_s entry;
+	entry.timestamp = timestamp;
+	entry.offset = offset;
+	_entries[_num_entries++] = entry;
+}
+
+void LogIndex::add_offset(uint32_t *offsets, uint16_t &num, size_t offset)
+{
+	if (!active()) {
+		return;
+	}
+
+	if (num == MAX_OFFSETS || offset > UINT32_MAX) {
+		_incomplete = true;
+		return;
+	}
+
+	offsets[num++] = offset;
+}
+
+ulog_message_index_s LogIndex::header() const
+{
+	ulog_message_index_s header{};
+	header.flags = _incomplete ? ULOG_INDEX_FLAG_INCOMPLETE : 0;
+	header.num_entries = _num_entries;
+	header.num_add_logged = _num_add_logged;
+	header.num_parameters = _num_parameters;
+	header.msg_size = sizeof(header) + _num_entries * sizeof(ulog_index_entry_s)
+			  + (_num_add_logged + _num_parameters) * sizeof(uint32_t) + sizeof(ulog_index_trailer_s) - ULOG_MSG_HEADER_LEN;
+	return header;
+}
+
+ulog_index_trailer_s LogIndex::trailer(const ulog_message_index_s &header)
+{
+	ulog_index_trailer_s trailer{};
+	trailer.index_size = header.msg_size + ULOG_MSG_HEADER_LEN;
+	trailer.magic[0] = 'U';
+	trailer.magic[1] = 'I';
+	trailer.magic[2] = 'D';
+	trailer.magic[3] = 'X';
+	return trailer;
+}
+
+} // namespace logger
+} // namespace px4
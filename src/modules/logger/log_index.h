@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "messages.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <drivers/drv_hrt.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogIndex
+ * Collects file positions while writing a log, to write an INDEX message when closing it.
+ * SYNC positions are decimated once the table is full, so the memory stays bounded for long logs.
+ */
+class LogIndex
+{
+public:
+	static constexpr int MAX_ENTRIES = 1024;
+	static constexpr int MAX_OFFSETS = 256;
+
+	LogIndex() = default;
+	~LogIndex() { stop(); }
+
+	LogIndex(const LogIndex &) = delete;
+	LogIndex &operator=(const LogIndex &) = delete;
+
+	/**
+	 * allocate the tables and reset the index
+	 * @return true on success
+	 */
+	bool start();
+
+	/** free the tables */
+	void stop();
+
+	bool active() const { return _entries != nullptr; }
+
+	void add_sync(hrt_abstime timestamp, size_t offset);
+	void add_add_logged_msg(size_t offset) { add_offset(_add_logged_offsets, _num_add_logged, offset); }
+	void add_parameter(size_t offset) { add_offset(_parameter_offsets, _num_parameters, offset); }
+
+	/** header of the INDEX message, for the current content */
+	ulog_message_index_s header() const;
+
+	static ulog_index_trailer_s trailer(const ulog_message_index_s &header);
+
+	ulog_index_entry_s *entries() const { return _entries; }
+	uint32_t *add_logged_offsets() const { return _add_logged_offsets; }
+	uint32_t *parameter_offsets() const { return _parameter_offsets; }
+
+private:
+	void add_offset(uint32_t *offsets, uint16_t &num, size_t offset);
+
+	ulog_index_entry_s *_entries{nullptr};
+	uint32_t *_add_logged_offsets{nullptr};
+	uint32_t *_parameter_offsets{nullptr};
+
+	uint16_t _num_entries{0};
+	uint16_t _num_add_logged{0};
+	uint16_t _num_parameters{0};
+
+	uint16_t _sync_stride{1}; ///< only every n-th SYNC message is added
+	uint16_t _sync_count{0};
+	bool _incomplete{false};
+};
+
+} // namespace logger
+} // namespace px4
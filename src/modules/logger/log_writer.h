@@ -138,6 +138,16 @@ public:
 		return 0;
 	}
 
+	/**
+	 * file position of the next message written to the file backend. The caller must call lock() before calling this.
+	 */
+	size_t get_write_position_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_write_position(type); }
+
+		return 0;
+	}
+
 	pthread_t thread_id_file() const
 	{
 		if (_log_writer_file) { return _log_writer_file->thread_id(); }
@@ -157,6 +167,28 @@ public:
 		if (_log_writer_mavlink) { _log_writer_mavlink->set_need_reliable_transfer(need_reliable); }
 	}
 
+	/**
+	 * Enable compression of the data section for logs started from now on
+	 */
+	void set_compression(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(enable); }
+
+		if (_log_writer_mavlink) { _log_writer_mavlink->set_compression(enable); }
+	}
+
+	/**
+	 * whether the selected write backend(s) compress data for the given log type
+	 */
+	bool compression_enabled(LogType type) const
+	{
+		if (_log_writer_file_for_write && _log_writer_file_for_write->compression_enabled(type)) { return true; }
+
+		if (_log_writer_mavlink_for_write && type == LogType::Full && _log_writer_mavlink_for_write->compression_enabled()) { return true; }
+
+		return false;
+	}
+
 	bool need_reliable_transfer() const
 	{
 		if (_log_writer_file) { return _log_writer_file->need_reliable_transfer(); }
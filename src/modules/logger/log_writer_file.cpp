@@ -35,11 +35,13 @@
 #include "messages.h"
 
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 
 #include <mathlib/mathlib.h>
 #include <px4_platform_common/posix.h>
+#include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/crypto.h>
 #include <px4_platform_common/log.h>
 #ifdef __PX4_NUTTX
@@ -55,16 +57,25 @@ namespace logger
 {
 constexpr size_t LogWriterFile::_min_write_chunk;
 
+#if defined(CONFIG_LOGGER_DIRECT_IO) && defined(__PX4_LINUX)
+static constexpr bool direct_io = true;
+#else
+static constexpr bool direct_io = false;
+#endif
+
 LogWriterFile::LogWriterFile(size_t buffer_size)
 	: _buffers{
 	//We always write larger chunks (orb messages) to the buffer, so the buffer
-	//needs to be larger than the minimum write chunk (300 is somewhat arbitrary)
+	//needs to be larger than the minimum write chunk (300 is somewhat arbitrary).
+	//The full log is written in aligned blocks of _min_write_chunk (per block latency in logger_sd_write),
+	//so the buffer size needs to be a multiple of it.
 	{
-		math::max(buffer_size, _min_write_chunk + 300),
+		align_to_write_chunk(math::max(buffer_size, _min_write_chunk + 300)), _min_write_chunk, direct_io,
 		perf_alloc(PC_ELAPSED, "logger_sd_write"), perf_alloc(PC_ELAPSED, "logger_sd_fsync")},
 
 	{
 		300, // buffer size for the mission log (can be kept fairly small)
+		0, false,
 		perf_alloc(PC_ELAPSED, "logger_sd_write_mission"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_mission")}
 }
 {
@@ -248,6 +259,19 @@ void LogWriterFile::start_log(LogType type, const char *filename)
 
 #endif
 
+	lock();
+
+	if (_compression) {
+		if (!_compressors[(int)type].enable()) {
+			PX4_ERR("compression alloc failed");
+		}
+
+	} else {
+		_compressors[(int)type].disable();
+	}
+
+	unlock();
+
 	if (_buffers[(int)type].start_log(filename)) {
 		PX4_INFO("Opened %s log file: %s", log_type_str(type), filename);
 		notify();
@@ -289,6 +313,15 @@ int LogWriterFile::hardfault_store_filename(const char *log_file)
 void LogWriterFile::stop_log(LogType type)
 {
 	lock();
+	flush_compressed(type);
+	LogCompressor &compressor = _compressors[(int)type];
+
+	if (compressor.enabled() && compressor.total_in() > 0) {
+		PX4_INFO("%s log compressed to %.1f%%", log_type_str(type),
+			 (double)(100.f * compressor.total_out() / compressor.total_in()));
+	}
+
+	compressor.disable();
 	_buffers[(int)type]._should_run = false;
 	unlock();
 	notify();
@@ -388,7 +421,7 @@ void LogWriterFile::run()
 				void *read_ptr;
 				bool is_part;
 				LogFileBuffer &buffer = _buffers[i];
-				size_t available = buffer.get_read_ptr(&read_ptr, &is_part);
+				size_t available = buffer.writable(buffer.get_read_ptr(&read_ptr, &is_part));
 
 #if defined(PX4_CRYPTO)
 				// Split into min blocksize chunks, so it is good for encrypting in pieces
@@ -496,6 +529,44 @@ void LogWriterFile::run()
 }
 
 int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start)
+{
+	LogCompressor &compressor = _compressors[(int)type];
+
+	if (compressor.enabled() && is_started(type)) {
+		// the header and messages following a dropout are written uncompressed
+		const bool can_compress = !_need_reliable_transfer && dropout_start == 0;
+
+		if (can_compress && compressor.append(ptr, size)) {
+			return compressor.should_finish() ? flush_compressed(type) : 0;
+		}
+
+		// keep the order: staged messages go first
+		if (flush_compressed(type) != 0) {
+			return -1;
+		}
+
+		if (can_compress && compressor.append(ptr, size)) {
+			return 0;
+		}
+	}
+
+	return write_uncompressed(type, ptr, size, dropout_start);
+}
+
+int LogWriterFile::flush_compressed(LogType type)
+{
+	LogCompressor &compressor = _compressors[(int)type];
+
+	if (!compressor.enabled() || compressor.empty()) {
+		return 0;
+	}
+
+	size_t size;
+	const uint8_t *data = compressor.finish(size);
+	return write_uncompressed(type, (void *)data, size, 0);
+}
+
+int LogWriterFile::write_uncompressed(LogType type, void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (_need_reliable_transfer) {
 		int ret;
@@ -576,9 +647,10 @@ const char *log_type_str(LogType type)
 	return "unknown";
 }
 
-LogWriterFile::LogFileBuffer::LogFileBuffer(size_t log_buffer_size, perf_counter_t perf_write,
-		perf_counter_t perf_fsync)
-	: _buffer_size(log_buffer_size), _perf_write(perf_write), _perf_fsync(perf_fsync)
+LogWriterFile::LogFileBuffer::LogFileBuffer(size_t log_buffer_size, size_t block_size, bool direct_io,
+		perf_counter_t perf_write, perf_counter_t perf_fsync)
+	: _buffer_size(log_buffer_size), _block_size(block_size), _direct_io(direct_io && (block_size > 0)),
+	  _perf_write(perf_write), _perf_fsync(perf_fsync)
 {
 }
 
@@ -637,7 +709,25 @@ size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 
 bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 {
-	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+	_direct_io_enabled = false;
+
+#if defined(O_DIRECT)
+
+	if (_direct_io) {
+		_fd = ::open(filename, O_CREAT | O_WRONLY | O_DIRECT, PX4_O_MODE_666);
+		_direct_io_enabled = (_fd >= 0);
+
+		if (_fd < 0) {
+			// e.g. not supported by the file system
+			PX4_WARN("O_DIRECT not available for %s (%d)", filename, errno);
+		}
+	}
+
+#endif // O_DIRECT
+
+	if (_fd < 0) {
+		_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+	}
 
 	if (_fd < 0) {
 		PX4_ERR("Can't open log file %s, errno: %d", filename, errno);
@@ -645,7 +735,14 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 	}
 
 	if (_buffer == nullptr) {
-		_buffer = (uint8_t *) px4_cache_aligned_alloc(_buffer_size);
+		if (_direct_io) {
+			// O_DIRECT requires the memory to be aligned as well
+			void *buffer = nullptr;
+			_buffer = (posix_memalign(&buffer, _block_size, _buffer_size) == 0) ? (uint8_t *)buffer : nullptr;
+
+		} else {
+			_buffer = (uint8_t *) px4_cache_aligned_alloc(_buffer_size);
+		}
 
 		if (_buffer == nullptr) {
 			PX4_ERR("Can't create log buffer");
@@ -672,17 +769,55 @@ void LogWriterFile::LogFileBuffer::fsync() const
 	perf_end(_perf_fsync);
 }
 
-ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
+ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync)
 {
-	perf_begin(_perf_write);
-	ssize_t ret = ::write(_fd, buffer, size);
-	perf_end(_perf_write);
+	const uint8_t *data = static_cast<const uint8_t *>(buffer);
+	ssize_t written = 0;
+
+	// write block by block, so that perf_write measures the latency of each block
+	while (written < (ssize_t)size) {
+		const size_t n = (_block_size > 0) ? math::min(_block_size, size - written) : (size - written);
+
+#if defined(O_DIRECT)
+
+		if (_direct_io_enabled && (n % _block_size != 0)) {
+			// unaligned tail (closing the file): O_DIRECT not possible
+			const int flags = fcntl(_fd, F_GETFL);
+
+			if (flags != -1) {
+				fcntl(_fd, F_SETFL, flags & ~O_DIRECT);
+			}
+
+			_direct_io_enabled = false;
+		}
+
+#endif // O_DIRECT
+
+		perf_begin(_perf_write);
+		ssize_t ret = ::write(_fd, data + written, n);
+		perf_end(_perf_write);
+
+		if (ret < 0) {
+			// report a partial write if some data has been written already
+			if (written == 0) {
+				return ret;
+			}
+
+			break;
+		}
+
+		written += ret;
+
+		if ((size_t)ret < n) {
+			break;
+		}
+	}
 
 	if (call_fsync) {
 		fsync();
 	}
 
-	return ret;
+	return written;
 }
 
 void LogWriterFile::LogFileBuffer::close_file()
@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include "log_compressor.h"
+
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/atomic.h>
 #include <stdint.h>
@@ -88,6 +90,13 @@ public:
 	/** @see LogWriter::write_message() */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
+	/**
+	 * Enable compression of the data section for logs started from now on
+	 */
+	void set_compression(bool enable) { _compression = enable; }
+
+	bool compression_enabled(LogType type) const { return _compressors[(int)type].enabled(); }
+
 	void lock()
 	{
 		pthread_mutex_lock(&_mtx);
@@ -118,6 +127,12 @@ public:
 		return _buffers[(int)type].count();
 	}
 
+	/** file position of the next byte written to the buffer */
+	size_t get_write_position(LogType type) const
+	{
+		return _buffers[(int)type].total_written() + _buffers[(int)type].count();
+	}
+
 	void set_need_reliable_transfer(bool need_reliable)
 	{
 		_need_reliable_transfer = need_reliable;
@@ -157,13 +172,36 @@ private:
 	 */
 	int write(LogType type, void *ptr, size_t size, uint64_t dropout_start);
 
+	/**
+	 * write a message directly to the buffer, blocking if reliable transfer is needed
+	 */
+	int write_uncompressed(LogType type, void *ptr, size_t size, uint64_t dropout_start);
+
+	/**
+	 * write the staged messages of the compressor (if any)
+	 */
+	int flush_compressed(LogType type);
+
 	/* 512 didn't seem to work properly, 4096 should match the FAT cluster size */
 	static constexpr size_t	_min_write_chunk = 4096;
 
+	/** round up to a multiple of _min_write_chunk */
+	static constexpr size_t align_to_write_chunk(size_t size)
+	{
+		return ((size + _min_write_chunk - 1) / _min_write_chunk) * _min_write_chunk;
+	}
+
 	class LogFileBuffer
 	{
 	public:
-		LogFileBuffer(size_t log_buffer_size, perf_counter_t perf_write, perf_counter_t perf_fsync);
+		/**
+		 * @param log_buffer_size size of the ring buffer (a multiple of block_size if block_size > 0)
+		 * @param block_size if > 0, data is written to the file in aligned blocks of this size
+		 *                   (each measured by perf_write), only the tail when closing can be shorter
+		 * @param direct_io open the file with O_DIRECT (if supported, requires block_size > 0)
+		 */
+		LogFileBuffer(size_t log_buffer_size, size_t block_size, bool direct_io, perf_counter_t perf_write,
+			      perf_counter_t perf_fsync);
 
 		~LogFileBuffer();
 
@@ -182,7 +220,15 @@ private:
 
 		int fd() const { return _fd; }
 
-		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync) const;
+		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync);
+
+		/**
+		 * Number of bytes of the available data that should be written now (full blocks, unless terminating)
+		 */
+		size_t writable(size_t available) const
+		{
+			return (_block_size > 0 && _should_run) ? (available / _block_size) * _block_size : available;
+		}
 
 		inline void fsync() const;
 
@@ -195,6 +241,9 @@ private:
 		bool _should_run = false;
 	private:
 		const size_t _buffer_size;
+		const size_t _block_size;
+		const bool _direct_io;
+		bool _direct_io_enabled = false; ///< file currently open with O_DIRECT
 		int	_fd = -1;
 		uint8_t *_buffer = nullptr;
 		size_t _head = 0; ///< next position to write to
@@ -205,6 +254,8 @@ private:
 	};
 
 	LogFileBuffer _buffers[(int)LogType::Count];
+	LogCompressor _compressors[(int)LogType::Count];
+	bool _compression{false};
 
 	px4::atomic_bool	_exit_thread{false};
 	bool			_need_reliable_transfer{false};
@@ -75,6 +75,16 @@ void LogWriterMavlink::start_log()
 	_ulog_stream_data.msg_sequence = 0;
 	_ulog_stream_data.length = 0;
 	_ulog_stream_data.first_message_offset = 0;
+	_next_sequence_to_ack = 0;
+
+	if (_compression) {
+		if (!_compressor.enable()) {
+			PX4_ERR("compression alloc failed");
+		}
+
+	} else {
+		_compressor.disable();
+	}
 
 	_is_started = true;
 }
@@ -82,6 +92,7 @@ void LogWriterMavlink::start_log()
 void LogWriterMavlink::stop_log()
 {
 	_ulog_stream_data.length = 0;
+	_compressor.disable();
 	_is_started = false;
 }
 
@@ -91,8 +102,45 @@ int LogWriterMavlink::write_message(void *ptr, size_t size)
 		return 0;
 	}
 
+	if (_compressor.enabled()) {
+		if (!_need_reliable_transfer && _compressor.append(ptr, size)) {
+			return _compressor.should_finish() ? flush_compressed() : 0;
+		}
+
+		// keep the order: staged messages go first
+		int ret = flush_compressed();
+
+		if (ret != 0) {
+			return ret;
+		}
+
+		if (!_need_reliable_transfer && _compressor.append(ptr, size)) {
+			return 0;
+		}
+	}
+
+	return write_uncompressed(ptr, size);
+}
+
+int LogWriterMavlink::flush_compressed()
+{
+	if (!_compressor.enabled() || _compressor.empty()) {
+		return 0;
+	}
+
+	size_t size;
+	const uint8_t *data = _compressor.finish(size);
+	return write_uncompressed(data, size);
+}
+
+int LogWriterMavlink::write_uncompressed(const void *ptr, size_t size)
+{
+	if (!is_started()) {
+		return 0;
+	}
+
 	const uint8_t data_len = (uint8_t)sizeof(_ulog_stream_data.data);
-	uint8_t *ptr_data = (uint8_t *)ptr;
+	const uint8_t *ptr_data = (const uint8_t *)ptr;
 
 	if (_ulog_stream_data.first_message_offset == 255) {
 		_ulog_stream_data.first_message_offset = _ulog_stream_data.length;
@@ -117,11 +165,25 @@ int LogWriterMavlink::write_message(void *ptr, size_t size)
 
 void LogWriterMavlink::set_need_reliable_transfer(bool need_reliable)
 {
+	if (need_reliable && !_need_reliable_transfer) {
+		// staged data is sent before switching
+		flush_compressed();
+	}
+
 	if (!need_reliable && _need_reliable_transfer) {
 		if (_ulog_stream_data.length > 0) {
 			// make sure to send previous data using reliable transfer
 			publish_message();
 		}
+
+		// unacked data must not overtake the reliable part
+		if (is_started()) {
+			wait_for_acks(0);
+		}
+	}
+
+	if (need_reliable && !_need_reliable_transfer) {
+		_next_sequence_to_ack = _ulog_stream_data.msg_sequence;
 	}
 
 	_need_reliable_transfer = need_reliable;
@@ -137,50 +199,55 @@ int LogWriterMavlink::publish_message()
 	}
 
 	_ulog_stream_pub.publish(_ulog_stream_data);
+	_ulog_stream_data.msg_sequence++;
 
-	if (_need_reliable_transfer) {
-		// we need to wait for an ack. Note that this blocks the main logger thread, so if a file logging
+	if (_need_reliable_transfer && acks_in_flight() >= ulog_stream_ack_s::ACK_WINDOW) {
+		// Wait for a slot in the ack window. Mavlink retransmits lost messages, so this only blocks when the
+		// link is slower than the logger. Note that this blocks the main logger thread, so if a file logging
 		// is already running, it will miss samples.
-		px4_pollfd_struct_t fds[1];
-		fds[0].fd = _ulog_stream_ack_sub;
-		fds[0].events = POLLIN;
-		bool got_ack = false;
-		const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
+		if (wait_for_acks(ulog_stream_ack_s::ACK_WINDOW - 1)) {
+			return -2;
+		}
+	}
 
-		hrt_abstime started = hrt_absolute_time();
+	_ulog_stream_data.length = 0;
+	_ulog_stream_data.first_message_offset = 255;
+	return 0;
+}
 
-		do {
-			int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
+int LogWriterMavlink::wait_for_acks(unsigned max_in_flight)
+{
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = _ulog_stream_ack_sub;
+	fds[0].events = POLLIN;
+	const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
 
-			if (ret <= 0) {
-				break;
-			}
+	// the timeout restarts whenever an ack arrives
+	hrt_abstime last_progress = hrt_absolute_time();
 
-			if (fds[0].revents & POLLIN) {
-				ulog_stream_ack_s ack;
-				orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+	while (acks_in_flight() > max_in_flight) {
+		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
 
-				if (ack.msg_sequence == _ulog_stream_data.msg_sequence) {
-					got_ack = true;
-				}
+		if (ret > 0 && (fds[0].revents & POLLIN)) {
+			ulog_stream_ack_s ack;
+			orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
 
-			} else {
-				break;
+			// acks are cumulative, ignore stale ones
+			const uint16_t acked = (uint16_t)(ack.msg_sequence + 1 - _next_sequence_to_ack);
+
+			if (acked > 0 && acked <= acks_in_flight()) {
+				_next_sequence_to_ack = ack.msg_sequence + 1;
+				last_progress = hrt_absolute_time();
 			}
-		} while (!got_ack && hrt_elapsed_time(&started) / 1000 < timeout_ms);
+		}
 
-		if (!got_ack) {
+		if (ret <= 0 || hrt_elapsed_time(&last_progress) / 1000 >= (hrt_abstime)timeout_ms) {
 			PX4_ERR("Ack timeout. Stopping mavlink log");
 			stop_log();
 			return -2;
 		}
-
-		PX4_DEBUG("got ack in %i ms", (int)(hrt_elapsed_time(&started) / 1000));
 	}
 
-	_ulog_stream_data.msg_sequence++;
-	_ulog_stream_data.length = 0;
-	_ulog_stream_data.first_message_offset = 255;
 	return 0;
 }
 
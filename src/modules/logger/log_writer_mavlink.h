@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include "log_compressor.h"
+
 #include <stdint.h>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/ulog_stream.h>
@@ -64,6 +66,13 @@ public:
 	/** @see LogWriter::write_message() */
 	int write_message(void *ptr, size_t size);
 
+	/**
+	 * Enable compression of the data section for logs started from now on
+	 */
+	void set_compression(bool enable) { _compression = enable; }
+
+	bool compression_enabled() const { return _compressor.enabled(); }
+
 	void set_need_reliable_transfer(bool need_reliable);
 
 	bool need_reliable_transfer() const
@@ -73,12 +82,29 @@ public:
 
 private:
 
-	/** publish message, wait for ack if needed & reset message */
+	/** publish message, wait for acks if the ack window is full & reset message */
 	int publish_message();
 
+	/**
+	 * wait until at most max_in_flight acked messages are unacknowledged
+	 * @return 0 on success, -2 on timeout (and logging is stopped)
+	 */
+	int wait_for_acks(unsigned max_in_flight);
+
+	unsigned acks_in_flight() const { return (uint16_t)(_ulog_stream_data.msg_sequence - _next_sequence_to_ack); }
+
+	int write_uncompressed(const void *ptr, size_t size);
+
+	/** write the staged messages of the compressor (if any) */
+	int flush_compressed();
+
+	LogCompressor _compressor;
+	bool _compression{false};
+
 	ulog_stream_s _ulog_stream_data{};
 	uORB::Publication<ulog_stream_s> _ulog_stream_pub{ORB_ID(ulog_stream)};
 	int _ulog_stream_ack_sub{-1};
+	uint16_t _next_sequence_to_ack{0}; ///< oldest acked message not acknowledged yet (or next sequence if none)
 	bool _need_reliable_transfer{false};
 	bool _is_started{false};
 };
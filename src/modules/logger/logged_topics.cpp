@@ -122,10 +122,15 @@ void LoggedTopics::add_default_topics()
 	add_optional_topic("vtol_vehicle_status", 200);
 	add_topic("wind", 1000);
 
+#if defined(CONFIG_UORB_LATENCY_STATISTICS)
+	add_topic("uorb_latency");
+#endif /* CONFIG_UORB_LATENCY_STATISTICS */
+
 	// multi topics
 	add_optional_topic_multi("actuator_outputs", 100, 3);
 	add_optional_topic_multi("airspeed_wind", 1000, 4);
 	add_optional_topic_multi("control_allocator_status", 200, 2);
+	add_optional_topic_multi("output_latency", 1000, 2);
 	add_optional_topic_multi("rate_ctrl_status", 200, 2);
 	add_optional_topic_multi("sensor_hygrometer", 500, 4);
 	add_optional_topic_multi("rpm", 200);
@@ -304,6 +309,9 @@ void LoggedTopics::add_debug_topics()
 	add_topic("mag_worker_data");
 	add_topic("sensor_preflight_mag", 500);
 	add_topic("actuator_test", 500);
+	add_topic("work_item_stats");
+	add_optional_topic("profiler_samples");
+	add_optional_topic("heap_usage");
 }
 
 void LoggedTopics::add_estimator_replay_topics()
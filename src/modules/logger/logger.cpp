@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/boot_timeline.h>
 #include <px4_platform_common/console_buffer.h>
 #include "logged_topics.h"
 #include "logger.h"
@@ -405,6 +406,9 @@ Logger::~Logger()
 
 	delete[](_msg_buffer);
 	delete[](_subscriptions);
+	delete[](_delta_state);
+	delete[](_delta_references);
+	delete[](_delta_msg_buffer);
 }
 
 void Logger::update_params()
@@ -434,6 +438,23 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 {
 	LoggerSubscription &sub = _subscriptions[sub_idx];
 
+#if defined(CONFIG_LOGGER_EVENT_DRIVEN)
+
+	if (sub.registered()) {
+		// nothing was published since the last visit
+		if (!_subscriptions_ready[sub_idx]) {
+			return false;
+		}
+
+		_subscriptions_ready.set(sub_idx, false);
+
+	} else if (sub.valid()) {
+		// the topic exists, so this does not create it
+		sub.registerCallback();
+	}
+
+#endif // CONFIG_LOGGER_EVENT_DRIVEN
+
 	bool updated = false;
 
 	if (sub.valid()) {
@@ -464,6 +485,15 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 		}
 	}
 
+#if defined(CONFIG_LOGGER_EVENT_DRIVEN)
+
+	// revisit if there is more queued data or the interval did not elapse yet
+	if (sub.registered() && sub.pending()) {
+		_subscriptions_ready.set(sub_idx, true);
+	}
+
+#endif // CONFIG_LOGGER_EVENT_DRIVEN
+
 	return updated;
 }
 
@@ -550,6 +580,10 @@ bool Logger::initialize_topics()
 		for (int i = 0; i < logged_topics.subscriptions().count; ++i) {
 			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
 			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance);
+#if defined(CONFIG_LOGGER_EVENT_DRIVEN)
+			_subscriptions[i].ready_set = &_subscriptions_ready;
+			_subscriptions[i].index = i;
+#endif // CONFIG_LOGGER_EVENT_DRIVEN
 			_subscriptions[i].subscribe();
 		}
 	}
@@ -762,7 +796,7 @@ void Logger::run()
 					// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
 
 					// full log
-					if (write_message(LogType::Full, _msg_buffer, msg_size)) {
+					if (write_data_message(sub_idx, msg_size, loop_time)) {
 
 #ifdef DBGPRINT
 						total_bytes += msg_size;
@@ -827,7 +861,16 @@ void Logger::run()
 				_msg_buffer[9] = 0xBB;
 				_msg_buffer[10] = 0x12;
 
-				write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+				const size_t position = _writer.get_write_position_file(LogType::Full);
+
+				if (write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN) && _log_index.active()) {
+					const ssize_t offset = written_message_position(position, write_msg_size + ULOG_MSG_HEADER_LEN);
+
+					if (offset >= 0) {
+						_log_index.add_sync(loop_time, offset);
+					}
+				}
+
 				_last_sync_time = loop_time;
 			}
 
@@ -1182,6 +1225,118 @@ void Logger::handle_vehicle_command_update()
 	}
 }
 
+void Logger::delta_encoding_start()
+{
+	if (_delta_state) {
+		for (int i = 0; i < _num_subscriptions; ++i) {
+			_delta_state[i].last_keyframe = 0;
+		}
+
+		return;
+	}
+
+	if (!_param_sdlog_delta.get() || _num_subscriptions == 0) {
+		return;
+	}
+
+	// only topics logged at full rate are encoded
+	uint32_t references_size = 0;
+
+	for (int i = 0; i < _num_subscriptions; ++i) {
+		if (_subscriptions[i].get_interval_us() == 0) {
+			references_size += _subscriptions[i].get_topic()->o_size_no_padding;
+		}
+	}
+
+	_delta_state = new DeltaState[_num_subscriptions];
+	_delta_references = new uint8_t[references_size];
+	_delta_msg_buffer = new uint8_t[_msg_buffer_len];
+
+	if (!_delta_state || !_delta_references || !_delta_msg_buffer) {
+		PX4_ERR("delta encoding alloc failed");
+		delta_encoding_stop();
+		return;
+	}
+
+	uint32_t offset = 0;
+
+	for (int i = 0; i < _num_subscriptions; ++i) {
+		_delta_state[i].last_keyframe = 0;
+
+		if (_subscriptions[i].get_interval_us() == 0) {
+			_delta_state[i].reference_offset = offset;
+			offset += _subscriptions[i].get_topic()->o_size_no_padding;
+
+		} else {
+			_delta_state[i].reference_offset = UINT32_MAX;
+		}
+	}
+}
+
+void Logger::delta_encoding_stop()
+{
+	if (_writer.is_started(LogType::Full)) {
+		return;
+	}
+
+	delete[](_delta_state);
+	_delta_state = nullptr;
+	delete[](_delta_references);
+	_delta_references = nullptr;
+	delete[](_delta_msg_buffer);
+	_delta_msg_buffer = nullptr;
+}
+
+bool Logger::write_data_message(int sub_idx, size_t msg_size, hrt_abstime now)
+{
+	if (!_delta_state || _delta_state[sub_idx].reference_offset == UINT32_MAX) {
+		return write_message(LogType::Full, _msg_buffer, msg_size);
+	}
+
+	DeltaState &state = _delta_state[sub_idx];
+	const uint8_t *sample = _msg_buffer + sizeof(ulog_message_data_s);
+	uint8_t *reference = _delta_references + state.reference_offset;
+	const int sample_size = msg_size - sizeof(ulog_message_data_s);
+
+	uint8_t *msg = _msg_buffer;
+	size_t size = msg_size;
+
+	if (state.last_keyframe != 0 && now - state.last_keyframe < DELTA_KEYFRAME_INTERVAL) {
+		// use the delta only if it is smaller than the sample
+		const int encoded_size = util::delta_encode(sample, reference, sample_size,
+					 _delta_msg_buffer + sizeof(ulog_message_data_delta_s), sample_size - 1);
+
+		if (encoded_size >= 0) {
+			const uint16_t write_msg_size = static_cast<uint16_t>(sizeof(ulog_message_data_delta_s) + encoded_size -
+							ULOG_MSG_HEADER_LEN);
+			_delta_msg_buffer[0] = (uint8_t)write_msg_size;
+			_delta_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+			_delta_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+			_delta_msg_buffer[3] = _msg_buffer[3]; // msg_id
+			_delta_msg_buffer[4] = _msg_buffer[4];
+			msg = _delta_msg_buffer;
+			size = write_msg_size + ULOG_MSG_HEADER_LEN;
+		}
+	}
+
+	if (!write_message(LogType::Full, msg, size)) {
+		// a dropout can lose already written samples (e.g. a compressed block), so restart from keyframes
+		for (int i = 0; i < _num_subscriptions; ++i) {
+			_delta_state[i].last_keyframe = 0;
+		}
+
+		return false;
+	}
+
+	memcpy(reference, sample, sample_size);
+
+	if (msg == _msg_buffer) {
+		state.last_keyframe = now;
+	}
+
+	return true;
+}
+
 bool Logger::write_message(LogType type, void *ptr, size_t size)
 {
 	Statistics &stats = _statistics[(int)type];
@@ -1404,10 +1559,26 @@ void Logger::start_log_file(LogType type)
 		_param_sdlog_crypto_exchange_key.get());
 #endif
 
+	if (type == LogType::Full) {
+		delta_encoding_start();
+	}
+
+	_writer.set_compression(_param_sdlog_compress.get());
 	_writer.start_log_file(type, file_name);
 	_writer.select_write_backend(LogWriter::BackendFile);
 	_writer.set_need_reliable_transfer(true);
 
+#if !defined(CONSTRAINED_MEMORY)
+
+	// positions inside compressed blocks cannot be indexed
+	if (type == LogType::Full && !_writer.compression_enabled(type)) {
+		if (!_log_index.start()) {
+			PX4_ERR("log index alloc failed");
+		}
+	}
+
+#endif // !CONSTRAINED_MEMORY
+
 	write_header(type);
 	write_version(type);
 	write_formats(type);
@@ -1417,6 +1588,7 @@ void Logger::start_log_file(LogType type)
 		write_parameter_defaults(type);
 		write_perf_data(true);
 		write_console_output();
+		write_boot_timeline();
 		write_events_file(LogType::Full);
 		write_excluded_optional_topics(type);
 	}
@@ -1444,10 +1616,15 @@ void Logger::stop_log_file(LogType type)
 	if (type == LogType::Full) {
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(false);
+		write_index();
 		_writer.set_need_reliable_transfer(false);
 	}
 
 	_writer.stop_log_file(type);
+
+	if (type == LogType::Full) {
+		delta_encoding_stop();
+	}
 }
 
 void Logger::start_log_mavlink()
@@ -1465,6 +1642,8 @@ void Logger::start_log_mavlink()
 
 	PX4_INFO("Start mavlink log");
 
+	delta_encoding_start();
+	_writer.set_compression(_param_sdlog_compress.get());
 	_writer.start_log_mavlink();
 	_writer.select_write_backend(LogWriter::BackendMavlink);
 	_writer.set_need_reliable_transfer(true);
@@ -1475,6 +1654,7 @@ void Logger::start_log_mavlink()
 	write_parameter_defaults(LogType::Full);
 	write_perf_data(true);
 	write_console_output();
+	write_boot_timeline();
 	write_events_file(LogType::Full);
 	write_excluded_optional_topics(LogType::Full);
 	write_all_add_logged_msg(LogType::Full);
@@ -1498,7 +1678,37 @@ void Logger::stop_log_mavlink()
 		_writer.unselect_write_backend();
 		_writer.notify();
 		_writer.stop_log_mavlink();
+		delta_encoding_stop();
+	}
+}
+
+ssize_t Logger::written_message_position(size_t position_before, size_t size) const
+{
+	// the position does not move if the file backend is not selected, and includes a preceding dropout message
+	const size_t position = _writer.get_write_position_file(LogType::Full);
+	return (position - position_before >= size) ? (ssize_t)(position - size) : -1;
+}
+
+void Logger::write_index()
+{
+	if (!_log_index.active()) {
+		return;
 	}
+
+	ulog_message_index_s header = _log_index.header();
+	ulog_index_trailer_s trailer = LogIndex::trailer(header);
+
+	_writer.lock();
+	_writer.select_write_backend(LogWriter::BackendFile);
+	write_message(LogType::Full, &header, sizeof(header));
+	write_message(LogType::Full, _log_index.entries(), header.num_entries * sizeof(ulog_index_entry_s));
+	write_message(LogType::Full, _log_index.add_logged_offsets(), header.num_add_logged * sizeof(uint32_t));
+	write_message(LogType::Full, _log_index.parameter_offsets(), header.num_parameters * sizeof(uint32_t));
+	write_message(LogType::Full, &trailer, sizeof(trailer));
+	_writer.unselect_write_backend();
+	_writer.unlock();
+
+	_log_index.stop();
 }
 
 struct perf_callback_data_t {
@@ -1620,28 +1830,46 @@ void Logger::write_console_output()
 
 }
 
+void Logger::write_boot_timeline()
+{
+	char buffer[64];
+
+	for (int i = 0; px4_boot_timeline_format(i, buffer, sizeof(buffer)); i++) {
+		write_info_multiple(LogType::Full, "boot_timeline", buffer, i != 0);
+	}
+}
+
 void Logger::write_format(LogType type, const orb_metadata &meta, WrittenFormats &written_formats,
-			  ulog_message_format_s &msg, int subscription_index, int level)
+			  ulog_message_format_s &msg, int subscription_index)
 {
-	if (level > 3) {
-		// precaution: limit recursion level. If we land here it's either a bug or nested topic definitions. In the
-		// latter case, increase the maximum level.
-		PX4_ERR("max recursion level reached (%i)", level);
+	if (!write_single_format(type, meta, written_formats, msg, subscription_index, false)) {
 		return;
 	}
 
+	// nested types (recursively) are precomputed by the uORB generator
+	const ORB_ID *nested_topics;
+	const int num_nested = orb_get_nested_topics(static_cast<ORB_ID>(meta.o_id), &nested_topics);
+
+	for (int i = 0; i < num_nested; ++i) {
+		write_single_format(type, *get_orb_meta(nested_topics[i]), written_formats, msg, subscription_index, true);
+	}
+}
+
+bool Logger::write_single_format(LogType type, const orb_metadata &meta, WrittenFormats &written_formats,
+				 ulog_message_format_s &msg, int subscription_index, bool nested)
+{
 	// check if we already wrote the format: either if at a previous _subscriptions index or in written_formats
 	for (const auto &written_format : written_formats) {
 		if (written_format == &meta) {
 			PX4_DEBUG("already added: %s", meta.o_name);
-			return;
+			return false;
 		}
 	}
 
 	for (int i = 0; i < subscription_index; ++i) {
 		if (_subscriptions[i].get_topic() == &meta) {
 			PX4_DEBUG("already in _subscriptions: %s", meta.o_name);
-			return;
+			return false;
 		}
 	}
 
@@ -1650,32 +1878,26 @@ void Logger::write_format(LogType type, const orb_metadata &meta, WrittenFormats
 	// Write the current format (we don't need to check if we already added it to written_formats)
 	int format_len = snprintf(msg.format, sizeof(msg.format), "%s:", meta.o_name);
 
-	for (int format_idx = 0; meta.o_fields[format_idx] != 0;) {
-		const char *end_field = strchr(meta.o_fields + format_idx, ';');
+	// o_fields looks like this for example: "<chr> timestamp;<chr>[5] array;", where <chr> is a single byte short
+	// type that needs to be expanded, everything else is copied as is
+	for (const char *fields = meta.o_fields; *fields != 0; ++fields) {
+		const char *c_type = orb_get_c_type(*fields);
+		const int len = c_type ? strlen(c_type) : 1;
 
-		if (!end_field) {
-			PX4_ERR("Format error in %s", meta.o_fields);
-			return;
+		if (len >= (int)sizeof(msg.format) - format_len) {
+			PX4_WARN("skip topic %s, format string is too large, max is %zu", meta.o_name,
+				 sizeof(ulog_message_format_s::format));
+			return false;
 		}
 
-		const char *c_type = orb_get_c_type(meta.o_fields[format_idx]);
-
 		if (c_type) {
-			format_len += snprintf(msg.format + format_len, sizeof(msg.format) - format_len, "%s", c_type);
-			++format_idx;
-		}
-
-		int len = end_field - (meta.o_fields + format_idx) + 1;
+			memcpy(msg.format + format_len, c_type, len);
 
-		if (len >= (int)sizeof(msg.format) - format_len) {
-			PX4_WARN("skip topic %s, format string is too large, max is %zu", meta.o_name,
-				 sizeof(ulog_message_format_s::format));
-			return;
+		} else {
+			msg.format[format_len] = *fields;
 		}
 
-		memcpy(msg.format + format_len, meta.o_fields + format_idx, len);
 		format_len += len;
-		format_idx += len;
 	}
 
 	msg.format[format_len] = '\0';
@@ -1684,69 +1906,11 @@ void Logger::write_format(LogType type, const orb_metadata &meta, WrittenFormats
 
 	write_message(type, &msg, msg_size);
 
-	if (level > 1 && !written_formats.push_back(&meta)) {
+	if (nested && !written_formats.push_back(&meta)) {
 		PX4_ERR("Array too small");
 	}
 
-	// Now go through the fields and check for nested type usages.
-	// o_fields looks like this for example: "<chr> timestamp;<chr>[5] array;"
-	const char *fmt = meta.o_fields;
-
-	while (fmt && *fmt) {
-		// extract the type name
-		char type_name[64];
-		const char *space = strchr(fmt, ' ');
-
-		if (!space) {
-			PX4_ERR("invalid format %s", fmt);
-			break;
-		}
-
-		const char *array_start = strchr(fmt, '['); // check for an array
-
-		int type_length;
-
-		if (array_start && array_start < space) {
-			type_length = array_start - fmt;
-
-		} else {
-			type_length = space - fmt;
-		}
-
-		if (type_length >= (int)sizeof(type_name)) {
-			PX4_ERR("buf len too small");
-			break;
-		}
-
-		memcpy(type_name, fmt, type_length);
-		type_name[type_length] = '\0';
-
-		// ignore built-in types
-		if (orb_get_c_type(type_name[0]) == nullptr) {
-
-			// find orb meta for type
-			const orb_metadata *const *topics = orb_get_topics();
-			const orb_metadata *found_topic = nullptr;
-
-			for (size_t i = 0; i < orb_topics_count(); i++) {
-				if (strcmp(topics[i]->o_name, type_name) == 0) {
-					found_topic = topics[i];
-				}
-			}
-
-			if (found_topic) {
-
-				write_format(type, *found_topic, written_formats, msg, subscription_index, level + 1);
-
-			} else {
-				PX4_ERR("No definition for topic %s found", fmt);
-			}
-		}
-
-		fmt = strchr(fmt, ';');
-
-		if (fmt) { ++fmt; }
-	}
+	return true;
 }
 
 void Logger::write_formats(LogType type)
@@ -1830,8 +1994,17 @@ void Logger::write_add_logged_msg(LogType type, LoggerSubscription &subscription
 
 	bool prev_reliable = _writer.need_reliable_transfer();
 	_writer.set_need_reliable_transfer(true);
+	const size_t position = _writer.get_write_position_file(type);
 	write_message(type, &msg, msg_size);
 	_writer.set_need_reliable_transfer(prev_reliable);
+
+	if (type == LogType::Full && _log_index.active()) {
+		const ssize_t offset = written_message_position(position, msg_size);
+
+		if (offset >= 0) {
+			_log_index.add_add_logged_msg(offset);
+		}
+	}
 }
 
 void Logger::write_info(LogType type, const char *name, const char *value)
@@ -2003,6 +2176,14 @@ void Logger::write_header(LogType type)
 
 	flag_bits.compat_flags[0] = ULOG_COMPAT_FLAG0_DEFAULT_PARAMETERS_MASK;
 
+	if (_writer.compression_enabled(type)) {
+		flag_bits.incompat_flags[0] |= ULOG_INCOMPAT_FLAG0_COMPRESSED_MASK;
+	}
+
+	if (type == LogType::Full && _delta_state) {
+		flag_bits.incompat_flags[0] |= ULOG_INCOMPAT_FLAG0_DATA_DELTA_MASK;
+	}
+
 	flag_bits.msg_size = sizeof(flag_bits) - ULOG_MSG_HEADER_LEN;
 	flag_bits.msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
 
@@ -2320,7 +2501,15 @@ void Logger::write_changed_parameters(LogType type)
 			// msg_size is now 1 (msg_type) + 2 (msg_size) + 1 (key_len) + key_len + value_size
 			msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
 
-			write_message(type, buffer, msg_size);
+			const size_t position = _writer.get_write_position_file(type);
+
+			if (write_message(type, buffer, msg_size) && type == LogType::Full && _log_index.active()) {
+				const ssize_t offset = written_message_position(position, msg_size);
+
+				if (offset >= 0) {
+					_log_index.add_parameter(offset);
+				}
+			}
 		}
 	} while ((param != PARAM_INVALID) && (param_idx < (int) param_count()));
 
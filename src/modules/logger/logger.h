@@ -33,11 +33,13 @@
 
 #pragma once
 
+#include "log_index.h"
 #include "log_writer.h"
 #include "logged_topics.h"
 #include "messages.h"
 #include <containers/Array.hpp>
 #include "util.h"
+#include <px4_platform_common/atomic_bitset.h>
 #include <px4_platform_common/defines.h>
 #include <drivers/drv_hrt.h>
 #include <version/version.h>
@@ -49,6 +51,7 @@
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/logger_status.h>
 #include <uORB/topics/log_message.h>
 #include <uORB/topics/manual_control_setpoint.h>
@@ -70,6 +73,33 @@ namespace logger
 
 static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
 
+#if defined(CONFIG_LOGGER_EVENT_DRIVEN)
+/**
+ * Subscription that marks itself in a ready-set on every publication, so that the
+ * logger only needs to look at topics that actually got new data.
+ */
+struct LoggerSubscription : public uORB::SubscriptionCallback {
+	LoggerSubscription() : uORB::SubscriptionCallback(nullptr) {}
+
+	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0) :
+		uORB::SubscriptionCallback(get_orb_meta(id), interval_ms * 1000, instance)
+	{}
+
+	void call() override
+	{
+		if (ready_set) {
+			ready_set->set(index, true);
+		}
+	}
+
+	/** @return true if the topic has data that was not read yet (ignoring the interval) */
+	bool pending() { return _subscription.updated(); }
+
+	px4::AtomicBitset<LoggedTopics::MAX_TOPICS_NUM> *ready_set{nullptr};
+	uint8_t index{0};
+	uint8_t msg_id{MSG_ID_INVALID};
+};
+#else
 struct LoggerSubscription : public uORB::SubscriptionInterval {
 	LoggerSubscription() = default;
 
@@ -79,6 +109,7 @@ struct LoggerSubscription : public uORB::SubscriptionInterval {
 
 	uint8_t msg_id{MSG_ID_INVALID};
 };
+#endif // CONFIG_LOGGER_EVENT_DRIVEN
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
 {
@@ -222,8 +253,18 @@ private:
 	/// Array to store written formats for nested definitions (only)
 	using WrittenFormats = Array < const orb_metadata *, 20 >;
 
+	/**
+	 * write the format of a topic and the formats of its nested types, unless already written
+	 */
 	void write_format(LogType type, const orb_metadata &meta, WrittenFormats &written_formats, ulog_message_format_s &msg,
-			  int subscription_index, int level = 1);
+			  int subscription_index);
+
+	/**
+	 * write the format of a single topic
+	 * @return false if not written (already written before, or an error)
+	 */
+	bool write_single_format(LogType type, const orb_metadata &meta, WrittenFormats &written_formats,
+				 ulog_message_format_s &msg, int subscription_index, bool nested);
 	void write_formats(LogType type);
 
 	/**
@@ -237,6 +278,11 @@ private:
 	 */
 	void write_console_output();
 
+	/**
+	 * write the start times of the modules and drivers
+	 */
+	void write_boot_timeline();
+
 	/**
 	 * callback to write the performance counters
 	 */
@@ -325,9 +371,51 @@ private:
 
 	void adjust_subscription_updates();
 
+	/**
+	 * File position in the full log of a message that was just written
+	 * @param position_before write position before writing the message
+	 * @return position, or -1 if the message was not written to the file
+	 */
+	ssize_t written_message_position(size_t position_before, size_t size) const;
+
+	/**
+	 * Write the INDEX message to the full log file, called when stopping
+	 */
+	void write_index();
+
+	/**
+	 * Allocate the delta encoding state if enabled, or make sure the next sample of each topic is
+	 * a keyframe if already running (needed whenever a new backend starts).
+	 */
+	void delta_encoding_start();
+
+	/**
+	 * Free the delta encoding state once the full log is stopped on all backends
+	 */
+	void delta_encoding_stop();
+
+	/**
+	 * Write a topic sample from _msg_buffer to the full log, delta encoded if possible
+	 * @return true on success
+	 */
+	bool write_data_message(int sub_idx, size_t msg_size, hrt_abstime now);
+
+	static constexpr hrt_abstime DELTA_KEYFRAME_INTERVAL{1_s}; ///< maximum time between DATA messages of a topic
+
+	struct DeltaState {
+		uint32_t reference_offset; ///< offset into _delta_references, UINT32_MAX if the topic is not delta encoded
+		hrt_abstime last_keyframe; ///< 0 if the next sample needs to be a keyframe
+	};
+
 	uint8_t						*_msg_buffer{nullptr};
 	int						_msg_buffer_len{0};
 
+	LogIndex					_log_index; ///< file positions for the INDEX message of the full log
+
+	DeltaState					*_delta_state{nullptr}; ///< per subscription, nullptr if delta encoding is off
+	uint8_t						*_delta_references{nullptr}; ///< last written sample of each delta encoded topic
+	uint8_t						*_delta_msg_buffer{nullptr}; ///< encoded message, _msg_buffer_len bytes
+
 	LogFileName					_file_name[(int)LogType::Count];
 
 	bool						_prev_state{false}; ///< previous state depending on logging mode (arming or aux1 state)
@@ -341,6 +429,9 @@ private:
 
 	LoggerSubscription	 			*_subscriptions{nullptr}; ///< all subscriptions for full & mission log (in front)
 	int						_num_subscriptions{0};
+#if defined(CONFIG_LOGGER_EVENT_DRIVEN)
+	px4::AtomicBitset<LoggedTopics::MAX_TOPICS_NUM>	_subscriptions_ready; ///< subscriptions with a publication since they were last visited
+#endif // CONFIG_LOGGER_EVENT_DRIVEN
 	MissionSubscription 				_mission_subscriptions[MAX_MISSION_TOPICS_NUM] {}; ///< additional data for mission subscriptions
 	int						_num_mission_subs{0};
 	LoggerSubscription				_event_subscription; ///< Subscription for the event topic (handled separately)
@@ -382,7 +473,9 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamBool<px4::params::SDLOG_COMPRESS>) _param_sdlog_compress,
+		(ParamBool<px4::params::SDLOG_DELTA>) _param_sdlog_delta
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
 		(ParamInt<px4::params::SDLOG_KEY>) _param_sdlog_crypto_key,
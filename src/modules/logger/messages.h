@@ -49,6 +49,9 @@ enum class ULogMessageType : uint8_t {
 	LOGGING = 'L',
 	LOGGING_TAGGED = 'C',
 	FLAG_BITS = 'B',
+	COMPRESSED = 'Z',
+	DATA_DELTA = 'X',
+	INDEX = 'N',
 };
 
 
@@ -179,6 +182,21 @@ struct ulog_message_data_s {
 	uint16_t msg_id;
 };
 
+/**
+ * @brief Delta encoded Data Message
+ *
+ * Topic data encoded as difference to the previous DATA or DATA_DELTA message with the same msg_id.
+ * The header is followed by runs of (uint8_t unchanged_bytes, uint8_t changed_bytes, changed_bytes
+ * bytes XOR'ed with the previous sample). Bytes after the last run are unchanged.
+ * A DATA message (keyframe) for each msg_id is written at least every second.
+ */
+struct ulog_message_data_delta_s {
+	uint16_t msg_size; ///< size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+
+	uint16_t msg_id;
+};
+
 /**
  * @brief Information Message
  *
@@ -282,6 +300,8 @@ struct ulog_message_parameter_default_s {
 
 
 #define ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK (1<<0)
+#define ULOG_INCOMPAT_FLAG0_COMPRESSED_MASK (1<<1) ///< the data section might contain COMPRESSED messages
+#define ULOG_INCOMPAT_FLAG0_DATA_DELTA_MASK (1<<2) ///< the data section might contain DATA_DELTA messages
 
 #define ULOG_COMPAT_FLAG0_DEFAULT_PARAMETERS_MASK (1<<0)
 
@@ -294,4 +314,55 @@ struct ulog_message_flag_bits_s {
 	uint64_t appended_offsets[3]; ///< file offset(s) for appended data if ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK is set
 };
 
+/**
+ * @brief Compressed Message
+ *
+ * A block of consecutive ULog messages (including their headers), compressed with the algorithm in
+ * 'algorithm'. Readers decompress the data and parse the result as if it was part of the file at
+ * the position of this message.
+ */
+#define ULOG_COMPRESSION_LZ4_BLOCK 0 ///< LZ4 block format, without frame
+
+struct ulog_message_compressed_s {
+	uint16_t msg_size;
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::COMPRESSED);
+
+	uint8_t algorithm; ///< @see ULOG_COMPRESSION_*
+	uint16_t uncompressed_size;
+	// followed by the compressed data
+};
+
+/**
+ * @brief Index Message
+ *
+ * Written at the end of a log file, so that readers can find file positions without parsing the whole file.
+ * The header is followed by:
+ * - ulog_index_entry_s[num_entries]: positions of SYNC messages, ordered by time
+ * - uint32_t[num_add_logged]: positions of the ADD_LOGGED_MSG messages
+ * - uint32_t[num_parameters]: positions of the PARAMETER messages in the data section
+ * - ulog_index_trailer_s
+ * A reader finds the index through the trailer at the end of the file (or at the start of appended data).
+ */
+#define ULOG_INDEX_FLAG_INCOMPLETE (1<<0) ///< not all ADD_LOGGED_MSG or PARAMETER messages are listed
+
+struct ulog_message_index_s {
+	uint16_t msg_size;
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::INDEX);
+
+	uint8_t flags; ///< @see ULOG_INDEX_FLAG_*
+	uint16_t num_entries;
+	uint16_t num_add_logged;
+	uint16_t num_parameters;
+};
+
+struct ulog_index_entry_s {
+	uint64_t timestamp;
+	uint32_t offset; ///< file position of the message
+};
+
+struct ulog_index_trailer_s {
+	uint32_t index_size; ///< size of the complete INDEX message, including the header and this trailer
+	uint8_t magic[4]; ///< 'U', 'I', 'D', 'X'
+};
+
 #pragma pack(pop)
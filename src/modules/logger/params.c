@@ -176,10 +176,36 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
 
+/**
+ * Compress the log data
+ *
+ * If enabled, the data section of file and MAVLink logs is written in LZ4 compressed
+ * blocks. This reduces the SD card bandwidth and the required telemetry link rate.
+ * The logs can only be read by tools that support compressed ULog messages.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_COMPRESS, 0);
+
+/**
+ * Delta encode high-rate topics
+ *
+ * If enabled, samples of topics logged at full rate are written as difference to the previous
+ * sample, with a complete sample at least every second. This reduces the log size considerably
+ * for topics where most fields change little between samples.
+ * The logs can only be read by tools that support delta encoded ULog messages.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_DELTA, 0);
+
 /**
  * Logfile Encryption algorithm
  *
- * Selects the algorithm used for logfile encryption
+ * Selects the algorithm used for logfile encryption.
+ * AES (256 bit, counter mode) uses the crypto peripheral if the board provides an AES driver.
  *
  * @value 0 Disabled
  * @value 2 XChaCha20
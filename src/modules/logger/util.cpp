@@ -34,6 +34,7 @@
 #include "util.h"
 
 #include <dirent.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <string.h>
 #include <stdlib.h>
@@ -43,8 +44,11 @@
 #include <uORB/topics/sensor_gps.h>
 
 #include <drivers/drv_hrt.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/events.h>
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+#include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
 #include <systemlib/mavlink_log.h>
 
@@ -66,6 +70,131 @@ namespace logger
 namespace util
 {
 
+// prefix of log directories that are pending removal by the cleanup thread
+static constexpr char REMOVE_PREFIX[] {"del_"};
+
+static px4::atomic_bool cleanup_running{false};
+
+static void *cleanup_thread_run(void *arg)
+{
+	px4_prctl(PR_SET_NAME, "log_cleanup", px4_getpid());
+
+	const char *log_root_dir = (const char *)arg;
+	bool removed = true;
+
+	while (removed) {
+		removed = false;
+		DIR *dp = opendir(log_root_dir);
+
+		if (dp == nullptr) {
+			break;
+		}
+
+		char directory_to_delete[LOG_DIR_LEN] {};
+		struct dirent *result = nullptr;
+
+		while ((result = readdir(dp))) {
+			if (strncmp(result->d_name, REMOVE_PREFIX, sizeof(REMOVE_PREFIX) - 1) == 0) {
+				snprintf(directory_to_delete, sizeof(directory_to_delete), "%s/%s", log_root_dir, result->d_name);
+				break;
+			}
+		}
+
+		closedir(dp);
+
+		if (directory_to_delete[0] != '\0') {
+			// do not modify the directory while iterating it
+			if (remove_directory(directory_to_delete) == 0) {
+				removed = true;
+
+			} else {
+				PX4_ERR("Failed to delete directory %s", directory_to_delete);
+			}
+		}
+	}
+
+	cleanup_running.store(false);
+	return nullptr;
+}
+
+/**
+ * Remove the directories marked for removal in a low priority thread
+ */
+static void start_cleanup_thread(const char *log_root_dir)
+{
+	bool expected = false;
+
+	if (!cleanup_running.compare_exchange(&expected, true)) {
+		return; // already running
+	}
+
+	pthread_attr_t thr_attr;
+	pthread_attr_init(&thr_attr);
+	pthread_attr_setdetachstate(&thr_attr, PTHREAD_CREATE_DETACHED);
+
+	sched_param param;
+	/* lower priority than the log writer, the removal is not urgent */
+	param.sched_priority = SCHED_PRIORITY_DEFAULT - 50;
+	(void)pthread_attr_setschedparam(&thr_attr, &param);
+
+	pthread_attr_setstacksize(&thr_attr, PX4_STACK_ADJUSTED(1500));
+
+	pthread_t thread;
+
+	if (pthread_create(&thread, &thr_attr, &cleanup_thread_run, (void *)log_root_dir) != 0) {
+		PX4_ERR("cleanup thread create failed");
+		cleanup_running.store(false);
+	}
+
+	pthread_attr_destroy(&thr_attr);
+}
+
+/**
+ * Sum of the file sizes in a directory (recursive)
+ */
+static uint64_t directory_size(const char *dir)
+{
+	DIR *d = opendir(dir);
+
+	if (!d) {
+		return 0;
+	}
+
+	const size_t dir_len = strlen(dir);
+	uint64_t size = 0;
+	struct dirent *p;
+
+	while ((p = readdir(d))) {
+		if (!strcmp(p->d_name, ".") || !strcmp(p->d_name, "..")) {
+			continue;
+		}
+
+		const size_t len = dir_len + strlen(p->d_name) + 2;
+		char *buf = new char[len];
+
+		if (buf) {
+			struct stat statbuf;
+
+			snprintf(buf, len, "%s/%s", dir, p->d_name);
+
+			if (!stat(buf, &statbuf)) {
+				if (S_ISDIR(statbuf.st_mode)) {
+					size += directory_size(buf);
+
+				} else {
+					size += statbuf.st_size;
+				}
+			}
+
+			delete[] buf;
+		}
+	}
+
+	closedir(d);
+
+	return size;
+}
+
 bool file_exist(const char *filename)
 {
 	struct stat buffer;
@@ -121,6 +250,11 @@ int check_free_space(const char *log_root_dir, int32_t max_log_dirs_to_keep, orb
 		max_log_dirs_to_keep = INT32_MAX;
 	}
 
+	// Removing a directory with large logs takes long on big cards, so directories are only renamed
+	// (marked for removal) and then removed by the cleanup thread. Their size is accounted as free.
+	uint64_t pending_free_bytes = 0;
+	bool pending_removal = false;
+
 	// remove old logs if the free space falls below a threshold
 	do {
 		if (statfs(log_root_dir, &statfs_buf) != 0) {
@@ -144,7 +278,11 @@ int check_free_space(const char *log_root_dir, int32_t max_log_dirs_to_keep, orb
 		while ((result = readdir(dp))) {
 			int year, month, day, sess_idx;
 
-			if (sscanf(result->d_name, "sess%d", &sess_idx) == 1) {
+			if (strncmp(result->d_name, REMOVE_PREFIX, sizeof(REMOVE_PREFIX) - 1) == 0) {
+				// left over from a previous removal
+				pending_removal = true;
+
+			} else if (sscanf(result->d_name, "sess%d", &sess_idx) == 1) {
 				++num_sess;
 
 				if (sess_idx > sess_idx_max) {
@@ -189,8 +327,9 @@ int check_free_space(const char *log_root_dir, int32_t max_log_dirs_to_keep, orb
 			min_free_bytes = total_bytes / 10;
 		}
 
-		if (num_sess + num_dates <= max_log_dirs_to_keep &&
-		    statfs_buf.f_bavail >= (px4_statfs_buf_f_bavail_t)(min_free_bytes / statfs_buf.f_bsize)) {
+		const uint64_t free_bytes = (uint64_t)statfs_buf.f_bavail * statfs_buf.f_bsize + pending_free_bytes;
+
+		if (num_sess + num_dates <= max_log_dirs_to_keep && free_bytes >= min_free_bytes) {
 			break; // enough free space and limit not reached
 		}
 
@@ -215,15 +354,38 @@ int check_free_space(const char *log_root_dir, int32_t max_log_dirs_to_keep, orb
 		}
 
 		PX4_INFO("removing log directory %s to get more space (left=%u MiB)", directory_to_delete,
-			 (unsigned int)(statfs_buf.f_bavail * statfs_buf.f_bsize / 1024U / 1024U));
+			 (unsigned int)(free_bytes / 1024U / 1024U));
+
+		// below the logging threshold the space needs to be available right away
+		const bool remove_now = statfs_buf.f_bavail < (px4_statfs_buf_f_bavail_t)(50 * 1024 * 1024 / statfs_buf.f_bsize);
+		bool marked = false;
+
+		if (!remove_now) {
+			char marked_directory[LOG_DIR_LEN];
+			const char *name = directory_to_delete + strlen(log_root_dir) + 1;
+			n = snprintf(marked_directory, sizeof(marked_directory), "%s/%s%s", log_root_dir, REMOVE_PREFIX, name);
 
-		if (remove_directory(directory_to_delete)) {
+			if (n < (int)sizeof(marked_directory)) {
+				const uint64_t size = directory_size(directory_to_delete);
+
+				if (rename(directory_to_delete, marked_directory) == 0) {
+					pending_free_bytes += size;
+					pending_removal = true;
+					marked = true;
+				}
+			}
+		}
+
+		if (!marked && remove_directory(directory_to_delete)) {
 			PX4_ERR("Failed to delete directory");
 			break;
 		}
 
 	} while (true);
 
+	if (pending_removal) {
+		start_cleanup_thread(log_root_dir);
+	}
 
 	/* use a threshold of 50 MiB: if below, do not start logging */
 	if (statfs_buf.f_bavail < (px4_statfs_buf_f_bavail_t)(50 * 1024 * 1024 / statfs_buf.f_bsize)) {
@@ -294,6 +456,47 @@ int remove_directory(const char *dir)
 	return ret;
 }
 
+int delta_encode(const uint8_t *sample, const uint8_t *reference, int size, uint8_t *out, int out_capacity)
+{
+	int out_size = 0;
+	int i = 0;
+
+	while (i < size) {
+		int unchanged = 0;
+
+		while (i < size && unchanged < UINT8_MAX && sample[i] == reference[i]) {
+			++unchanged;
+			++i;
+		}
+
+		if (i == size) {
+			// trailing unchanged bytes are implicit
+			break;
+		}
+
+		const int start = i;
+		int changed = 0;
+
+		while (i < size && changed < UINT8_MAX && sample[i] != reference[i]) {
+			++changed;
+			++i;
+		}
+
+		if (out_size + 2 + changed > out_capacity) {
+			return -1;
+		}
+
+		out[out_size++] = (uint8_t)unchanged;
+		out[out_size++] = (uint8_t)changed;
+
+		for (int j = start; j < i; ++j) {
+			out[out_size++] = sample[j] ^ reference[j];
+		}
+	}
+
+	return out_size;
+}
+
 } //namespace util
 } //namespace logger
 } //namespace px4
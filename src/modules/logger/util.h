@@ -65,7 +65,9 @@ bool file_exist(const char *filename);
 /**
  * Check if there is enough free space left on the SD Card.
  * It will remove old log files if there is not enough space,
- * and if that fails return 1, and send a user message
+ * and if that fails return 1, and send a user message.
+ * Unless the free space is below the logging threshold, the old directories are only renamed here
+ * and removed by a background thread.
  * @param log_root_dir log root directory: it's expected to contain directories in the form of sess%i or %d-%d-%d (year, month, day)
  * @param max_log_dirs_to_keep maximum log directories to keep (set to 0 for unlimited)
  * @param mavlink_log_pub
@@ -84,6 +86,13 @@ int check_free_space(const char *log_root_dir, int32_t max_log_dirs_to_keep, orb
  */
 bool get_log_time(struct tm *tt, int utc_offset_sec = 0, bool boot_time = false);
 
+/**
+ * Encode a sample as difference to a reference sample of the same size
+ * @see ulog_message_data_delta_s
+ * @return encoded size, or -1 if it would need more than out_capacity bytes
+ */
+int delta_encode(const uint8_t *sample, const uint8_t *reference, int size, uint8_t *out, int out_capacity);
+
 } //namespace util
 } //namespace logger
 } //namespace px4
@@ -71,7 +71,19 @@ int MagBiasEstimator::task_spawn(int argc, char *argv[])
 
 void MagBiasEstimator::start()
 {
-	ScheduleOnInterval(20_ms); // 50 Hz
+	updateSchedule();
+}
+
+void MagBiasEstimator::updateSchedule()
+{
+	// 50 Hz while disarmed, only check occasionally when armed or if there is no magnetometer
+	const bool active = (_arming_state != vehicle_status_s::ARMING_STATE_ARMED) && _sensor_mag_subs.advertised();
+	const hrt_abstime interval = active ? 20_ms : 1_s;
+
+	if (interval != _schedule_interval) {
+		_schedule_interval = interval;
+		ScheduleOnInterval(interval);
+	}
 }
 
 void MagBiasEstimator::Run()
@@ -92,18 +104,12 @@ void MagBiasEstimator::Run()
 				for (auto &reset : _reset_field_estimator) {
 					reset = true;
 				}
-
-				if (_arming_state == vehicle_status_s::ARMING_STATE_ARMED) {
-					ScheduleOnInterval(1_s);
-
-				} else {
-					// restore 50 Hz scheduling
-					ScheduleOnInterval(20_ms);
-				}
 			}
 		}
 	}
 
+	updateSchedule();
+
 	// only run when disarmed
 	if (_arming_state == vehicle_status_s::ARMING_STATE_ARMED) {
 		return;
@@ -153,11 +159,12 @@ void MagBiasEstimator::Run()
 
 	perf_begin(_cycle_perf);
 
-	// Assume a constant angular velocity during two mag samples
+	// update all magnetometers in one pass on the same gyro sample, which is only copied if any of them has new data
 	vehicle_angular_velocity_s vehicle_angular_velocity;
 
-	if (_vehicle_angular_velocity_sub.update(&vehicle_angular_velocity)) {
+	if (_sensor_mag_subs.updated() && _vehicle_angular_velocity_sub.update(&vehicle_angular_velocity)) {
 
+		// Assume a constant angular velocity during two mag samples
 		const Vector3f angular_velocity{vehicle_angular_velocity.xyz};
 
 		bool updated = false;
@@ -166,74 +173,75 @@ void MagBiasEstimator::Run()
 			sensor_mag_s sensor_mag;
 
 			while (_sensor_mag_subs[mag_index].update(&sensor_mag)) {
-
+				updateEstimator(mag_index, angular_velocity, sensor_mag);
 				updated = true;
+			}
+		}
 
-				// apply existing mag calibration
-				_calibration[mag_index].set_device_id(sensor_mag.device_id);
+		if (updated) {
+			publishMagBiasEstimate();
+		}
+	}
 
-				const Vector3f mag_calibrated = _calibration[mag_index].Correct(Vector3f{sensor_mag.x, sensor_mag.y, sensor_mag.z});
+	perf_end(_cycle_perf);
+}
 
-				float dt = (sensor_mag.timestamp_sample - _timestamp_last_update[mag_index]) * 1e-6f;
-				_timestamp_last_update[mag_index] = sensor_mag.timestamp_sample;
+void MagBiasEstimator::updateEstimator(int mag_index, const Vector3f &angular_velocity, const sensor_mag_s &sensor_mag)
+{
+	// apply existing mag calibration
+	_calibration[mag_index].set_device_id(sensor_mag.device_id);
 
-				if (dt < 0.001f || dt > 0.2f) {
-					_reset_field_estimator[mag_index] = true;
-				}
+	const Vector3f mag_calibrated = _calibration[mag_index].Correct(Vector3f{sensor_mag.x, sensor_mag.y, sensor_mag.z});
 
-				if (_reset_field_estimator[mag_index]) {
-					// reset
-					_bias_estimator[mag_index].setBias(Vector3f{});
-					_bias_estimator[mag_index].setField(mag_calibrated);
+	float dt = (sensor_mag.timestamp_sample - _timestamp_last_update[mag_index]) * 1e-6f;
+	_timestamp_last_update[mag_index] = sensor_mag.timestamp_sample;
 
-					_reset_field_estimator[mag_index] = false;
-					_valid[mag_index] = false;
-					_time_valid[mag_index] = 0;
+	if (dt < 0.001f || dt > 0.2f) {
+		_reset_field_estimator[mag_index] = true;
+	}
 
-				} else {
-					updated = true;
+	if (_reset_field_estimator[mag_index]) {
+		// reset
+		_bias_estimator[mag_index].setBias(Vector3f{});
+		_bias_estimator[mag_index].setField(mag_calibrated);
 
-					const Vector3f bias_prev = _bias_estimator[mag_index].getBias();
+		_reset_field_estimator[mag_index] = false;
+		_valid[mag_index] = false;
+		_time_valid[mag_index] = 0;
 
-					_bias_estimator[mag_index].updateEstimate(angular_velocity, mag_calibrated, dt);
+	} else {
+		const Vector3f bias_prev = _bias_estimator[mag_index].getBias();
 
-					const Vector3f &bias = _bias_estimator[mag_index].getBias();
-					const Vector3f bias_rate = (bias - bias_prev) / dt;
+		_bias_estimator[mag_index].updateEstimate(angular_velocity, mag_calibrated, dt);
 
-					if (!PX4_ISFINITE(bias(0)) || !PX4_ISFINITE(bias(1)) || !PX4_ISFINITE(bias(2)) || bias.longerThan(5.f)) {
-						_reset_field_estimator[mag_index] = true;
-						_valid[mag_index] = false;
-						_time_valid[mag_index] = 0;
+		const Vector3f &bias = _bias_estimator[mag_index].getBias();
+		const Vector3f bias_rate = (bias - bias_prev) / dt;
 
-					} else {
+		if (!PX4_ISFINITE(bias(0)) || !PX4_ISFINITE(bias(1)) || !PX4_ISFINITE(bias(2)) || bias.longerThan(5.f)) {
+			_reset_field_estimator[mag_index] = true;
+			_valid[mag_index] = false;
+			_time_valid[mag_index] = 0;
 
-						Vector3f fitness{
-							fabsf(angular_velocity(0)) / fmaxf(fabsf(bias_rate(1)) + fabsf(bias_rate(2)), 0.02f),
-							fabsf(angular_velocity(1)) / fmaxf(fabsf(bias_rate(0)) + fabsf(bias_rate(2)), 0.02f),
-							fabsf(angular_velocity(2)) / fmaxf(fabsf(bias_rate(0)) + fabsf(bias_rate(1)), 0.02f)
-						};
+		} else {
 
-						const bool bias_significant = bias.longerThan(0.04f);
-						const bool has_converged = fitness(0) > 20.f || fitness(1) > 20.f || fitness(2) > 20.f;
+			Vector3f fitness{
+				fabsf(angular_velocity(0)) / fmaxf(fabsf(bias_rate(1)) + fabsf(bias_rate(2)), 0.02f),
+				fabsf(angular_velocity(1)) / fmaxf(fabsf(bias_rate(0)) + fabsf(bias_rate(2)), 0.02f),
+				fabsf(angular_velocity(2)) / fmaxf(fabsf(bias_rate(0)) + fabsf(bias_rate(1)), 0.02f)
+			};
 
-						if (bias_significant && has_converged) {
-							if (!_valid[mag_index]) {
-								_time_valid[mag_index] = hrt_absolute_time();
-							}
+			const bool bias_significant = bias.longerThan(0.04f);
+			const bool has_converged = fitness(0) > 20.f || fitness(1) > 20.f || fitness(2) > 20.f;
 
-							_valid[mag_index] = true;
-						}
-					}
+			if (bias_significant && has_converged) {
+				if (!_valid[mag_index]) {
+					_time_valid[mag_index] = hrt_absolute_time();
 				}
-			}
-		}
 
-		if (updated) {
-			publishMagBiasEstimate();
+				_valid[mag_index] = true;
+			}
 		}
 	}
-
-	perf_end(_cycle_perf);
 }
 
 void MagBiasEstimator::publishMagBiasEstimate()
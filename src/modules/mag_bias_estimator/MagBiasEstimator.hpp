@@ -81,6 +81,8 @@ public:
 private:
 	void Run() override;
 	void publishMagBiasEstimate();
+	void updateEstimator(int mag_index, const matrix::Vector3f &angular_velocity, const sensor_mag_s &sensor_mag);
+	void updateSchedule();
 
 	static constexpr int MAX_SENSOR_COUNT = 4;
 
@@ -102,6 +104,8 @@ private:
 	bool _reset_field_estimator[MAX_SENSOR_COUNT] {};
 	bool _valid[MAX_SENSOR_COUNT] {};
 
+	hrt_abstime _schedule_interval{0};
+
 	uint8_t _arming_state{0};
 	bool _system_calibrating{false};
 
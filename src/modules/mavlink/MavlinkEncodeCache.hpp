@@ -0,0 +1,109 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file MavlinkEncodeCache.hpp
+ *
+ * Message payload shared by the streams of all mavlink instances.
+ *
+ * A stream packs its payload from uORB data, which is the same on every link.
+ * The first instance that sees a new topic generation stores the packed payload,
+ * the other instances reuse it and only do the framing (sequence number, channel, crc).
+ */
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+
+#include <stdint.h>
+
+template<typename T>
+class MavlinkEncodeCache
+{
+public:
+
+	/**
+	 * Build the cache key from the generations of the subscriptions the payload depends on.
+	 */
+	static constexpr uint64_t key(unsigned generation, unsigned secondary_generation = 0)
+	{
+		return (static_cast<uint64_t>(generation) << 32) | secondary_generation;
+	}
+
+	/**
+	 * Get the payload packed for the given key.
+	 * @return true if msg was copied, false if it needs to be packed by the caller
+	 */
+	bool get(uint64_t key, T &msg)
+	{
+		bool hit = false;
+
+		// never block the mavlink thread, on contention the caller simply packs the payload itself
+		if (try_lock()) {
+			if (_valid && (_key == key)) {
+				msg = _msg;
+				hit = true;
+			}
+
+			unlock();
+		}
+
+		return hit;
+	}
+
+	void put(uint64_t key, const T &msg)
+	{
+		if (try_lock()) {
+			_msg = msg;
+			_key = key;
+			_valid = true;
+			unlock();
+		}
+	}
+
+private:
+	bool try_lock()
+	{
+		bool expected = false;
+		return _locked.compare_exchange(&expected, true);
+	}
+
+	void unlock() { _locked.store(false); }
+
+	px4::atomic_bool _locked;
+
+	uint64_t _key{0};
+	bool _valid{false};
+	T _msg{};
+};
@@ -42,10 +42,18 @@
 #ifndef MAVLINK_BRIDGE_HEADER_H
 #define MAVLINK_BRIDGE_HEADER_H
 
+#include <px4_platform_common/px4_config.h>
+
 #define MAVLINK_NO_CONVERSION_HELPERS
 
 #define MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
+#if !defined(CONFIG_MAVLINK_SIGNING)
+/* exclude the signing code (SHA-256) */
+# define MAVLINK_NO_SIGN_PACKET
+# define MAVLINK_NO_SIGNATURE_CHECK
+#endif
+
 /* use efficient approach, see mavlink_helpers.h */
 #define MAVLINK_SEND_UART_BYTES mavlink_send_uart_bytes
 
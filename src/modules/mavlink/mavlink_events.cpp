@@ -34,47 +34,91 @@
 #include "mavlink_events.h"
 #include "mavlink_main.h"
 
+#include <lib/mathlib/mathlib.h>
 #include <px4_log.h>
 #include <errno.h>
 
 namespace events
 {
 
-EventBuffer::EventBuffer(int capacity)
-	: _capacity(capacity)
+EventBuffer::EventBuffer(int capacity_bytes)
+	: _capacity(capacity_bytes)
 {
 	pthread_mutex_init(&_mutex, nullptr);
 }
 
 EventBuffer::~EventBuffer()
 {
-	delete[](_events);
+	delete[](_buffer);
 	pthread_mutex_destroy(&_mutex);
 }
 
 int EventBuffer::init()
 {
-	if (_events) { return 0; }
+	if (_buffer) { return 0; }
 
-	_events = new Event[_capacity];
+	_buffer = new uint8_t[_capacity];
 
-	if (!_events) {
+	if (!_buffer) {
 		return -ENOMEM;
 	}
 
 	return 0;
 }
 
+void EventBuffer::read(int offset, void *data, int size) const
+{
+	offset %= _capacity;
+	const int first = math::min(size, _capacity - offset);
+	memcpy(data, _buffer + offset, first);
+	memcpy((uint8_t *)data + first, _buffer, size - first);
+}
+
+void EventBuffer::write(int offset, const void *data, int size)
+{
+	offset %= _capacity;
+	const int first = math::min(size, _capacity - offset);
+	memcpy(_buffer + offset, data, first);
+	memcpy(_buffer, (const uint8_t *)data + first, size - first);
+}
+
+void EventBuffer::drop_oldest()
+{
+	Header header;
+	read(_start, &header, sizeof(header));
+	const int event_size = sizeof(header) + header.arguments_size;
+	_start = (_start + event_size) % _capacity;
+	_used -= event_size;
+	--_size;
+}
+
 void EventBuffer::insert_event(const Event &event)
 {
+	Header header;
+	header.timestamp_ms = event.timestamp_ms;
+	header.id = event.id;
+	header.sequence = event.sequence;
+	header.log_levels = event.log_levels;
+	header.arguments_size = sizeof(event.arguments);
+
+	// the unused arguments are zero
+	while (header.arguments_size > 0 && event.arguments[header.arguments_size - 1] == 0) {
+		--header.arguments_size;
+	}
+
+	const int event_size = sizeof(header) + header.arguments_size;
+
 	pthread_mutex_lock(&_mutex);
-	_events[_next] = event;
-	_next = (_next + 1) % _capacity;
 
-	if (_size < _capacity) {
-		++_size;
+	while (_used + event_size > _capacity) {
+		drop_oldest();
 	}
 
+	write(_start + _used, &header, sizeof(header));
+	write(_start + _used + sizeof(header), event.arguments, header.arguments_size);
+	_used += event_size;
+	++_size;
+
 	_latest_sequence.store(event.sequence);
 	pthread_mutex_unlock(&_mutex);
 }
@@ -84,9 +128,13 @@ uint16_t EventBuffer::get_oldest_sequence_after(uint16_t sequence) const
 	pthread_mutex_lock(&_mutex);
 	uint16_t sequence_ret = _latest_sequence.load();
 	uint16_t min_diff = UINT16_MAX;
+	int offset = _start;
 
 	for (int i = 0; i < _size; ++i) {
-		uint16_t event_seq = _events[i].sequence;
+		Header header;
+		read(offset, &header, sizeof(header));
+		offset += sizeof(header) + header.arguments_size;
+		uint16_t event_seq = header.sequence;
 		uint16_t diff = event_seq - sequence;
 
 		// this handles wrap-arounds correctly
@@ -99,22 +147,40 @@ uint16_t EventBuffer::get_oldest_sequence_after(uint16_t sequence) const
 	pthread_mutex_unlock(&_mutex);
 	return sequence_ret;
 }
+
 bool EventBuffer::get_event(uint16_t sequence, Event &event) const
 {
-	pthread_mutex_lock(&_mutex);
+	return get_events(sequence - 1, sequence, &event, 1) == 1;
+}
 
-	for (int count = 0; count < _size; ++count) {
-		int index = (_next - 1 - count + _size) % _size;
+int EventBuffer::get_events(uint16_t after, uint16_t last, Event *events, int max_events) const
+{
+	const uint16_t range = last - after;
+	int count = 0;
 
-		if (_events[index].sequence == sequence) {
-			event = _events[index];
-			pthread_mutex_unlock(&_mutex);
-			return true;
+	pthread_mutex_lock(&_mutex);
+	int offset = _start;
+
+	for (int i = 0; i < _size && count < max_events; ++i) {
+		Header header;
+		read(offset, &header, sizeof(header));
+		const uint16_t diff = header.sequence - after; // this handles wrap-arounds correctly
+
+		if (diff != 0 && diff <= range) {
+			Event &event = events[count++];
+			event.timestamp_ms = header.timestamp_ms;
+			event.id = header.id;
+			event.sequence = header.sequence;
+			event.log_levels = header.log_levels;
+			read(offset + sizeof(header), event.arguments, header.arguments_size);
+			memset(event.arguments + header.arguments_size, 0, sizeof(event.arguments) - header.arguments_size);
 		}
+
+		offset += sizeof(header) + header.arguments_size;
 	}
 
 	pthread_mutex_unlock(&_mutex);
-	return false;
+	return count;
 }
 
 int EventBuffer::size() const
@@ -135,32 +201,37 @@ void SendProtocol::update(const hrt_abstime &now)
 	// check for new events in the buffer
 	uint16_t buffer_sequence = _buffer.get_latest_sequence();
 	int num_drops = 0;
+	Event events[send_batch_size];
 
 	while (_latest_sequence != buffer_sequence) {
 		// only send if enough tx buffer space available
-		if (_mavlink.get_free_tx_buf() < MAVLINK_MSG_ID_EVENT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES) {
+		const int free_events = _mavlink.get_free_tx_buf() / (MAVLINK_MSG_ID_EVENT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES);
+
+		if (free_events <= 0) {
 			break;
 		}
 
 		PX4_DEBUG("Changed seq: %i, latest: %i (mavlink instance: %i)", buffer_sequence, _latest_sequence,
 			  _mavlink.get_instance_id());
-		++_latest_sequence;
-		Event e;
 
-		if (_buffer.get_event(_latest_sequence, e)) {
-			send_event(e);
+		const int count = _buffer.get_events(_latest_sequence, buffer_sequence, events,
+						     math::min(free_events, send_batch_size));
 
-		} else {
-			if (num_drops == 0) { // avoid console spamming
-				// This happens if either an event dropped in uORB or update() is not called fast enough
-				PX4_WARN("Event dropped (%i, %i)", (int)_latest_sequence, buffer_sequence);
-			}
+		if (count == 0) {
+			// This happens if either an event dropped in uORB or update() is not called fast enough
+			num_drops += (uint16_t)(buffer_sequence - _latest_sequence);
+			_latest_sequence = buffer_sequence;
+			break;
+		}
 
-			++num_drops;
+		for (int i = 0; i < count; ++i) {
+			num_drops += (uint16_t)(events[i].sequence - _latest_sequence - 1);
+			_latest_sequence = events[i].sequence;
+			send_event(events[i]);
 		}
 	}
 
-	if (num_drops > 1) {
+	if (num_drops > 0) {
 		PX4_WARN("Dropped %i events (seq=%i)", num_drops, _latest_sequence);
 	}
 
@@ -174,28 +245,47 @@ void SendProtocol::handle_request_event(const mavlink_message_t &msg) const
 {
 	mavlink_request_event_t request_event;
 	mavlink_msg_request_event_decode(&msg, &request_event);
-	Event e;
-
-	const uint16_t end_sequence = request_event.last_sequence + 1;
-
-	for (uint16_t sequence = request_event.first_sequence; sequence != end_sequence; ++sequence) {
-		if (_buffer.get_event(sequence, e)) {
-			PX4_DEBUG("sending requested event %i", sequence);
-			send_event(e);
-
-		} else {
-			mavlink_response_event_error_t event_error{};
-			event_error.target_system = msg.sysid;
-			event_error.target_component = msg.compid;
-			event_error.sequence = sequence;
-			event_error.sequence_oldest_available = _buffer.get_oldest_sequence_after(sequence);
-			event_error.reason = MAV_EVENT_ERROR_REASON_UNAVAILABLE;
-			PX4_DEBUG("Event unavailable (seq=%i oldest=%i)", sequence, event_error.sequence_oldest_available);
-			mavlink_msg_response_event_error_send_struct(_mavlink.get_channel(), &event_error);
+	Event events[send_batch_size];
+
+	const uint16_t last_sequence = request_event.last_sequence;
+	uint16_t sequence = request_event.first_sequence - 1; // last handled sequence
+
+	while (sequence != last_sequence) {
+		const int count = _buffer.get_events(sequence, last_sequence, events, send_batch_size);
+
+		for (int i = 0; i < count; ++i) {
+			if (events[i].sequence != (uint16_t)(sequence + 1)) {
+				send_event_error(msg, sequence + 1);
+			}
+
+			PX4_DEBUG("sending requested event %i", events[i].sequence);
+			send_event(events[i]);
+			sequence = events[i].sequence;
+		}
+
+		if (count < send_batch_size) {
+			if (sequence != last_sequence) {
+				send_event_error(msg, sequence + 1);
+			}
+
+			break;
 		}
 	}
 }
 
+void SendProtocol::send_event_error(const mavlink_message_t &msg, uint16_t sequence) const
+{
+	// a single error for a range of unavailable events, the GCS continues with the oldest available one
+	mavlink_response_event_error_t event_error{};
+	event_error.target_system = msg.sysid;
+	event_error.target_component = msg.compid;
+	event_error.sequence = sequence;
+	event_error.sequence_oldest_available = _buffer.get_oldest_sequence_after(sequence);
+	event_error.reason = MAV_EVENT_ERROR_REASON_UNAVAILABLE;
+	PX4_DEBUG("Event unavailable (seq=%i oldest=%i)", sequence, event_error.sequence_oldest_available);
+	mavlink_msg_response_event_error_send_struct(_mavlink.get_channel(), &event_error);
+}
+
 void SendProtocol::send_event(const Event &event) const
 {
 	mavlink_event_t event_msg{};
@@ -64,6 +64,9 @@ struct Event {
 /**
  * @class EventBuffer
  * Event buffer that can be shared between threads and multiple SendProtocol instances.
+ * Events are stored back to back in a byte ringbuffer, without the trailing zeros of
+ * the arguments, so that short events take less space. The oldest events are dropped
+ * when a new one does not fit.
  * All methods are thread-safe.
  */
 class EventBuffer
@@ -71,10 +74,10 @@ class EventBuffer
 public:
 
 	/**
-	 * Create an event buffer. Required memory: sizeof(Event) * capacity.
-	 * @param capacity maximum number of buffered events
+	 * Create an event buffer.
+	 * @param capacity_bytes buffer size, holds capacity_bytes / sizeof(Event) events at least
 	 */
-	EventBuffer(int capacity = 20);
+	EventBuffer(int capacity_bytes = 20 * sizeof(Event));
 	~EventBuffer();
 
 	int init();
@@ -90,14 +93,39 @@ public:
 
 	bool get_event(uint16_t sequence, Event &event) const;
 
+	/**
+	 * Get the buffered events following a sequence number, in order and with a single lock.
+	 * Missing sequence numbers (dropped events) are skipped.
+	 * @param after copy the events after this sequence
+	 * @param last copy the events up to and including this sequence
+	 * @param events output array
+	 * @param max_events size of events
+	 * @return number of events copied
+	 */
+	int get_events(uint16_t after, uint16_t last, Event *events, int max_events) const;
+
 	int size() const;
 private:
+	/// stored before the arguments of each event
+	struct __attribute__((packed)) Header {
+		uint32_t timestamp_ms;
+		uint32_t id;
+		uint16_t sequence;
+		uint8_t log_levels;
+		uint8_t arguments_size;
+	};
+
+	void read(int offset, void *data, int size) const;
+	void write(int offset, const void *data, int size);
+	void drop_oldest();
+
 	::px4::atomic<uint16_t> _latest_sequence{events::initial_event_sequence};
 
-	Event *_events{nullptr}; ///< stored events, ringbuffer
+	uint8_t *_buffer{nullptr}; ///< stored events (header and arguments), ringbuffer
 	int _capacity;
-	int _next{0}; ///< next element to use
-	int _size{0};
+	int _start{0}; ///< offset of the oldest event
+	int _used{0}; ///< used bytes
+	int _size{0}; ///< number of events
 
 	mutable pthread_mutex_t _mutex;
 };
@@ -121,6 +149,7 @@ public:
 	/**
 	 * Handle mavlink_request_event_t message. Can be called from another thread than
 	 * the rest of the class and is therefore thread-safe.
+	 * A single error is sent for each range of unavailable events.
 	 */
 	void handle_request_event(const mavlink_message_t &msg) const;
 
@@ -132,9 +161,11 @@ public:
 private:
 
 	void send_event(const Event &event) const;
+	void send_event_error(const mavlink_message_t &msg, uint16_t sequence) const;
 	void send_current_sequence(const hrt_abstime &now);
 
 	static constexpr hrt_abstime current_sequence_interval{3_s};
+	static constexpr int send_batch_size{8}; ///< events fetched from the buffer at once
 
 	EventBuffer &_buffer;
 	uint16_t _latest_sequence;
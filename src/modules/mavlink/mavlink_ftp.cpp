@@ -42,6 +42,8 @@
 #include <errno.h>
 #include <cstring>
 
+#include <parameters/param.h>
+
 #include "mavlink_ftp.h"
 #include "mavlink_tests/mavlink_ftp_test.h"
 
@@ -54,6 +56,8 @@
 using namespace time_literals;
 
 constexpr const char MavlinkFTP::_root_dir[];
+constexpr const char MavlinkFTP::_param_pack_path[];
+constexpr const char MavlinkFTP::_param_pack_file[];
 
 MavlinkFTP::MavlinkFTP(Mavlink *mavlink) :
 	_mavlink(mavlink)
@@ -64,8 +68,18 @@ MavlinkFTP::MavlinkFTP(Mavlink *mavlink) :
 
 MavlinkFTP::~MavlinkFTP()
 {
+#ifndef MAVLINK_FTP_UNIT_TEST
+	_io_request.cancel();
+
+	while (_io_request.busy()) {
+		px4_usleep(1000);
+	}
+
+#endif // MAVLINK_FTP_UNIT_TEST
+
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
+	delete[] _read_ahead_buffer;
 }
 
 unsigned
@@ -138,11 +152,47 @@ MavlinkFTP::handle_message(const mavlink_message_t *msg)
 
 		if ((ftp_request.target_system == _getServerSystemId() || ftp_request.target_system == 0) &&
 		    (ftp_request.target_component == _getServerComponentId() || ftp_request.target_component == 0)) {
+#ifdef MAVLINK_FTP_UNIT_TEST
 			_process_request(&ftp_request, msg->sysid, msg->compid);
+#else
+
+			// don't block the receiver on file access, the GCS resends a dropped request
+			if (_request_pending.load()) {
+				PX4_DEBUG("FTP: busy, dropping request");
+				return;
+			}
+
+			_pending_request = ftp_request;
+			_pending_target_system_id = msg->sysid;
+			_pending_target_comp_id = msg->compid;
+			_request_pending.store(true);
+			_io_request.submit();
+#endif // MAVLINK_FTP_UNIT_TEST
 		}
 	}
 }
 
+#ifndef MAVLINK_FTP_UNIT_TEST
+int
+MavlinkFTP::_io_worker(void *arg)
+{
+	MavlinkFTP *ftp = static_cast<MavlinkFTP *>(arg);
+
+	if (ftp->_request_pending.load()) {
+		// release the slot before replying, so that the next request is not dropped
+		mavlink_file_transfer_protocol_t request = ftp->_pending_request;
+		const uint8_t target_system_id = ftp->_pending_target_system_id;
+		const uint8_t target_comp_id = ftp->_pending_target_comp_id;
+		ftp->_request_pending.store(false);
+
+		ftp->_process_request(&request, target_system_id, target_comp_id);
+	}
+
+	ftp->_send();
+	return PX4_OK;
+}
+#endif // MAVLINK_FTP_UNIT_TEST
+
 /// @brief Processes an FTP message
 void
 MavlinkFTP::_process_request(
@@ -506,8 +556,17 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrNoSessionsAvailable;
 	}
 
-	strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
-	strncpy(_work_buffer1 + _root_dir_len, _data_as_cstring(payload), _work_buffer1_len - _root_dir_len);
+	if (oflag == O_RDONLY && strcmp(_data_as_cstring(payload), _param_pack_path) == 0) {
+		if (!_param_pack_update()) {
+			return kErrFailErrno;
+		}
+
+		strncpy(_work_buffer1, _param_pack_file, _work_buffer1_len);
+
+	} else {
+		strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
+		strncpy(_work_buffer1 + _root_dir_len, _data_as_cstring(payload), _work_buffer1_len - _root_dir_len);
+	}
 
 	PX4_DEBUG("FTP: open '%s'", _work_buffer1);
 
@@ -543,6 +602,7 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	_session_info.fd = fd;
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
+	_read_ahead_invalidate();
 
 	payload->session = 0;
 	payload->size = sizeof(uint32_t);
@@ -551,6 +611,114 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	return kErrNone;
 }
 
+bool
+MavlinkFTP::_param_pack_update()
+{
+	// the hash covers which parameters are used, the generation all value changes (including volatile parameters)
+	const uint32_t hash = param_hash_check();
+	const uint32_t generation = param_change_generation();
+
+	if (_param_pack_valid && hash == _param_pack_hash && generation == _param_pack_generation) {
+		return true;
+	}
+
+	_param_pack_valid = false;
+
+	int fd = ::open(_param_pack_file, O_CREAT | O_TRUNC | O_WRONLY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		_our_errno = errno;
+		PX4_ERR("param pack open failed: %s", strerror(_our_errno));
+		return false;
+	}
+
+	const int count = param_count_used();
+	uint8_t *buffer = (uint8_t *)_work_buffer2;
+	int len = 0;
+	bool success = true;
+
+	const uint16_t header[3] {_param_pack_magic, (uint16_t)count, (uint16_t)count};
+	memcpy(buffer, header, sizeof(header));
+	len += sizeof(header);
+
+	const char *previous_name = "";
+	int num_packed = 0;
+
+	for (int i = 0; i < count && success; i++) {
+		const param_t param = param_for_used_index(i);
+
+		if (param == PARAM_INVALID) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+		const int name_len = strlen(name);
+
+		// common prefix with the previous name, at least one character needs to remain
+		int common_len = 0;
+
+		while (common_len < 15 && common_len < name_len - 1 && name[common_len] == previous_name[common_len]) {
+			common_len++;
+		}
+
+		const int suffix_len = name_len - common_len;
+		uint8_t type;
+		int32_t value;
+
+		switch (param_type(param)) {
+		case PARAM_TYPE_INT32: type = 3; break;
+
+		case PARAM_TYPE_FLOAT: type = 4; break;
+
+		default: continue;
+		}
+
+		if (suffix_len > 16 || param_get(param, &value) != 0) {
+			continue;
+		}
+
+		if (len + 2 + suffix_len + (int)sizeof(value) > _work_buffer2_len) {
+			success = ::write(fd, buffer, len) == len;
+			len = 0;
+		}
+
+		buffer[len++] = type;
+		buffer[len++] = (uint8_t)(common_len | ((suffix_len - 1) << 4));
+		memcpy(&buffer[len], name + common_len, suffix_len);
+		len += suffix_len;
+		memcpy(&buffer[len], &value, sizeof(value));
+		len += sizeof(value);
+
+		previous_name = name;
+		num_packed++;
+	}
+
+	if (success && len > 0) {
+		success = ::write(fd, buffer, len) == len;
+	}
+
+	if (success && num_packed != count) {
+		// some parameters were skipped (e.g. the number of used parameters changed meanwhile)
+		const uint16_t header_packed[3] {_param_pack_magic, (uint16_t)num_packed, (uint16_t)num_packed};
+		success = ::lseek(fd, 0, SEEK_SET) == 0 && ::write(fd, header_packed, sizeof(header_packed)) == sizeof(header_packed);
+	}
+
+	if (!success) {
+		_our_errno = errno;
+		PX4_ERR("param pack write failed: %s", strerror(_our_errno));
+	}
+
+	::close(fd);
+
+	if (success) {
+		_param_pack_valid = true;
+		_param_pack_hash = hash;
+		_param_pack_generation = generation;
+	}
+
+	return success;
+}
+
 /// @brief Responds to a Read command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workRead(PayloadHeader *payload)
@@ -567,19 +735,10 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 		return kErrEOF;
 	}
 
-	PX4_DEBUG("lseek with offset: %ld", payload->offset);
-
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		_our_errno = errno;
-		PX4_ERR("seek fail: %s", strerror(_our_errno));
-		return kErrFailErrno;
-	}
-
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_read = _session_read(payload->offset, &payload->data[0], payload->size);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
-		_our_errno = errno;
 		PX4_ERR("read fail %d, %s", bytes_read, strerror(_our_errno));
 		return kErrFailErrno;
 	}
@@ -589,6 +748,69 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 	return kErrNone;
 }
 
+int
+MavlinkFTP::_session_read(uint32_t offset, uint8_t *dst, unsigned len)
+{
+	if (_read_ahead_buffer == nullptr) {
+		_read_ahead_buffer = new uint8_t[_read_ahead_buffer_len];
+		_read_ahead_invalidate();
+	}
+
+	if (_read_ahead_buffer == nullptr) {
+		// no memory for read-ahead, read directly
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			_our_errno = errno;
+			return -1;
+		}
+
+		int bytes_read = ::read(_session_info.fd, dst, len);
+
+		if (bytes_read < 0) {
+			_our_errno = errno;
+		}
+
+		return bytes_read;
+	}
+
+	const bool cached = (offset >= _read_ahead_offset) && (offset + len <= _read_ahead_offset + _read_ahead_len);
+
+	if (!cached) {
+		// Keep a quarter of the buffer behind the requested offset, so that packets lost during a burst and
+		// requested again by the GCS are still served from memory. Start on a block boundary for the storage.
+		const uint32_t lookbehind = _read_ahead_buffer_len / 4;
+		uint32_t start = (offset > lookbehind) ? (offset - lookbehind) : 0;
+		start -= start % _read_ahead_alignment;
+		_read_ahead_invalidate();
+
+		if (lseek(_session_info.fd, start, SEEK_SET) < 0) {
+			_our_errno = errno;
+			PX4_WARN("read-ahead: seek fail");
+			return -1;
+		}
+
+		int bytes_read = ::read(_session_info.fd, _read_ahead_buffer, _read_ahead_buffer_len);
+
+		if (bytes_read < 0) {
+			_our_errno = errno;
+			return -1;
+		}
+
+		_read_ahead_offset = start;
+		_read_ahead_len = bytes_read;
+	}
+
+	if (offset >= _read_ahead_offset + _read_ahead_len) {
+		// EOF
+		return 0;
+	}
+
+	const unsigned available = _read_ahead_offset + _read_ahead_len - offset;
+	const unsigned bytes = (len < available) ? len : available;
+	memcpy(dst, &_read_ahead_buffer[offset - _read_ahead_offset], bytes);
+
+	return bytes;
+}
+
 /// @brief Responds to a Stream command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t target_component_id)
@@ -623,6 +845,8 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 		return kErrFailFileProtected;
 	}
 
+	_read_ahead_invalidate();
+
 	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
 		// Unable to see to the specified location
 		PX4_ERR("seek fail");
@@ -1031,7 +1255,20 @@ MavlinkFTP::_copy_file(const char *src_path, const char *dst_path, size_t length
 
 void MavlinkFTP::send()
 {
+#ifdef MAVLINK_FTP_UNIT_TEST
+	_send();
+#else
+
+	// buffers to free, a session to time out or a download to stream
+	if (_work_buffer1 || _work_buffer2 || (_session_info.fd != -1)) {
+		_io_request.submit();
+	}
+
+#endif // MAVLINK_FTP_UNIT_TEST
+}
 
+void MavlinkFTP::_send()
+{
 	if (_work_buffer1 || _work_buffer2) {
 		// free the work buffers if they are not used for a while
 		if (hrt_elapsed_time(&_last_work_buffer_access) > 2_s) {
@@ -1044,6 +1281,12 @@ void MavlinkFTP::send()
 				delete[] _work_buffer2;
 				_work_buffer2 = nullptr;
 			}
+
+			if (_read_ahead_buffer) {
+				delete[] _read_ahead_buffer;
+				_read_ahead_buffer = nullptr;
+				_read_ahead_invalidate();
+			}
 		}
 
 	} else if (_session_info.fd != -1) {
@@ -1101,14 +1344,7 @@ void MavlinkFTP::send()
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: seek fail");
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _session_read(payload->offset, &payload->data[0], kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
@@ -40,6 +40,8 @@
 #include <queue.h>
 
 #include <px4_platform_common/defines.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/AsyncIoRequest.hpp>
 #include <systemlib/err.h>
 #include <drivers/drv_hrt.h>
 
@@ -61,6 +63,7 @@ public:
 
 	/**
 	 * Handle sending of messages. Call this regularly at a fixed frequency.
+	 * The file access (and replies) run on the storage work queue, except in unit test mode.
 	 * @param t current time
 	 */
 	void send();
@@ -133,6 +136,12 @@ public:
 private:
 	char		*_data_as_cstring(PayloadHeader *payload);
 
+#ifndef MAVLINK_FTP_UNIT_TEST
+	/// Process the pending request and the stream download (on the storage work queue)
+	static int	_io_worker(void *arg);
+#endif // MAVLINK_FTP_UNIT_TEST
+	void		_send();
+
 	void		_process_request(mavlink_file_transfer_protocol_t *ftp_req, uint8_t target_system_id, uint8_t target_comp_id);
 	void		_reply(mavlink_file_transfer_protocol_t *ftp_req);
 	int		_copy_file(const char *src_path, const char *dst_path, size_t length);
@@ -157,6 +166,26 @@ private:
 
 	bool _validatePathIsWritable(const char *path);
 
+	/**
+	 * Read from the session file through the read-ahead buffer
+	 * @return number of bytes read, 0 at EOF, -1 on error (errno in _our_errno)
+	 */
+	int _session_read(uint32_t offset, uint8_t *dst, unsigned len);
+
+	/**
+	 * Drop the read-ahead buffer contents, must be called whenever the session file changes
+	 */
+	void _read_ahead_invalidate() { _read_ahead_len = 0; }
+
+	/**
+	 * (Re-)generate the parameter pack file if the parameters changed since it was last generated.
+	 * The format matches the ArduPilot '@PARAM/param.pck' format: a header {uint16 magic, uint16 count,
+	 * uint16 total count}, then per parameter {uint8 type:4 flags:4, uint8 common prefix length:4
+	 * name length-1:4, name suffix, value}, with names in sorted order.
+	 * @return true on success, false otherwise (errno in _our_errno)
+	 */
+	bool _param_pack_update();
+
 	/**
 	 * make sure that the working buffers _work_buffer* are allocated
 	 * @return true if buffers exist, false if allocation failed
@@ -198,6 +227,20 @@ private:
 	static constexpr int _work_buffer2_len = 256;
 	hrt_abstime _last_work_buffer_access{0}; ///< timestamp when the buffers were last accessed
 
+	/* read-ahead buffer for downloads: reading larger aligned blocks is much faster than a seek and
+	 * read per packet, and it serves re-requested (lost) packets without going back to the storage */
+	uint8_t *_read_ahead_buffer{nullptr};
+#if defined(CONSTRAINED_MEMORY)
+	static constexpr unsigned _read_ahead_buffer_len = 1024;
+#else
+	static constexpr unsigned _read_ahead_buffer_len = 8192;
+#endif
+	static constexpr unsigned _read_ahead_alignment = 512;
+	static_assert(_read_ahead_buffer_len / 4 + _read_ahead_alignment + kMaxDataLength <= _read_ahead_buffer_len,
+		      "read-ahead buffer too small");
+	uint32_t _read_ahead_offset{0}; ///< file offset of _read_ahead_buffer[0]
+	unsigned _read_ahead_len{0}; ///< valid bytes in _read_ahead_buffer
+
 	// prepend a root directory to each file/dir access to avoid enumerating the full FS tree (e.g. on Linux).
 	// Note that requests can still fall outside of the root dir by using ../..
 #ifdef MAVLINK_FTP_UNIT_TEST
@@ -207,10 +250,29 @@ private:
 #endif
 	static constexpr const int _root_dir_len = sizeof(_root_dir) - 1;
 
+	// bulk parameter download: read requests for _param_pack_path are served with a generated pack of all
+	// used parameters, which is only regenerated if a parameter changed (the GCS can compare _HASH_CHECK)
+	static constexpr const char _param_pack_path[] = "@PARAM/param.pck";
+	static constexpr const char _param_pack_file[] = PX4_STORAGEDIR "/.param.pck";
+	static constexpr uint16_t _param_pack_magic = 0x671b;
+	bool _param_pack_valid{false};
+	uint32_t _param_pack_hash{0};
+	uint32_t _param_pack_generation{0};
+
 	bool _last_reply_valid = false;
 	uint8_t _last_reply[MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN - MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN
 								      + sizeof(PayloadHeader) + sizeof(uint32_t)];
 
+#ifndef MAVLINK_FTP_UNIT_TEST
+	px4::AsyncIoRequest _io_request{"mavlink_ftp", &MavlinkFTP::_io_worker, this};
+
+	// request handed over to the storage work queue, only one is outstanding at a time (the GCS waits for the reply)
+	mavlink_file_transfer_protocol_t _pending_request{};
+	uint8_t _pending_target_system_id{0};
+	uint8_t _pending_target_comp_id{0};
+	px4::atomic_bool _request_pending{false};
+#endif // MAVLINK_FTP_UNIT_TEST
+
 	// Mavlink test needs to be able to call send
 	friend class MavlinkFtpTest;
 
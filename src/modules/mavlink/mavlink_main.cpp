@@ -40,6 +40,7 @@
  * @author Anton Babushkin <anton.babushkin@me.com>
  */
 
+#include <limits.h>
 #include <termios.h>
 
 #ifdef CONFIG_NET
@@ -93,6 +94,34 @@ mavlink_message_t *mavlink_get_channel_buffer(uint8_t channel) { return mavlink_
 
 static void usage();
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+// messages accepted unsigned on a signed link
+static constexpr uint32_t unsigned_messages[] {
+	MAVLINK_MSG_ID_RADIO_STATUS, // injected by SiK radios
+};
+
+static bool accept_unsigned_callback(const mavlink_status_t *status, uint32_t message_id)
+{
+	Mavlink *m = Mavlink::get_instance_for_status(status);
+
+	if (m != nullptr) {
+		const int32_t sign_mode = m->get_sign_mode();
+
+		if (sign_mode == 0 || (sign_mode == 1 && m->is_usb_uart())) {
+			return true;
+		}
+	}
+
+	for (const uint32_t msg_id : unsigned_messages) {
+		if (msg_id == message_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif // CONFIG_MAVLINK_SIGNING
+
 hrt_abstime Mavlink::_first_start_time = {0};
 
 bool Mavlink::_boot_complete = false;
@@ -178,6 +207,9 @@ Mavlink::~Mavlink()
 	perf_free(_loop_perf);
 	perf_free(_loop_interval_perf);
 	perf_free(_send_byte_error_perf);
+	perf_free(_stream_deferred_perf);
+	perf_free(_stream_dropped_perf);
+	perf_free(_tx_write_perf);
 }
 
 void
@@ -305,6 +337,20 @@ Mavlink::instance_count()
 	return inst_index;
 }
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+Mavlink *
+Mavlink::get_instance_for_status(const mavlink_status_t *status)
+{
+	for (Mavlink *inst : mavlink_module_instances) {
+		if (inst && (inst->get_status() == status)) {
+			return inst;
+		}
+	}
+
+	return nullptr;
+}
+#endif // CONFIG_MAVLINK_SIGNING
+
 Mavlink *
 Mavlink::get_instance_for_device(const char *device_name)
 {
@@ -722,6 +768,11 @@ Mavlink::get_free_tx_buf()
 				setup_flow_control(FLOW_CONTROL_OFF);
 			}
 		}
+
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE) && defined(__PX4_NUTTX)
+		// the queued frame is already committed to the driver buffer
+		buf_free = math::max(buf_free - (int)_serial_tx_frame_fill, 0);
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE && __PX4_NUTTX
 	}
 
 	return buf_free;
@@ -741,10 +792,40 @@ void Mavlink::send_start(int length)
 
 		// prevent writes
 		_tx_buffer_low = true;
+		return;
+	}
 
-	} else {
-		_tx_buffer_low = false;
+	_tx_buffer_low = false;
+
+	// serialize straight into the coalesced frame or datagram (if used), saves a copy per message
+	_tx_dest = _buf;
+	_tx_dest_size = sizeof(_buf);
+
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+
+	if (get_protocol() == Protocol::SERIAL) {
+		if (_serial_tx_frame_fill + length > sizeof(_serial_tx_frame)) {
+			send_serial_frame();
+		}
+
+		_tx_dest = &_serial_tx_frame[_serial_tx_frame_fill];
+		_tx_dest_size = sizeof(_serial_tx_frame) - _serial_tx_frame_fill;
+	}
+
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
+
+#if defined(MAVLINK_UDP)
+
+	if ((get_protocol() == Protocol::UDP) && _udp_coalesce) {
+		if (_udp_datagram_fill + length > sizeof(_udp_datagram)) {
+			send_udp_datagram();
+		}
+
+		_tx_dest = &_udp_datagram[_udp_datagram_fill];
+		_tx_dest_size = sizeof(_udp_datagram) - _udp_datagram_fill;
 	}
+
+#endif // MAVLINK_UDP
 }
 
 void Mavlink::send_finish()
@@ -758,68 +839,187 @@ void Mavlink::send_finish()
 
 	// send message to UART
 	if (get_protocol() == Protocol::SERIAL) {
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+		// already in the frame (see send_start()), it goes out when full or on flush_tx()
+		_serial_tx_frame_fill += _buf_fill;
+		ret = _buf_fill;
+#else
+		perf_begin(_tx_write_perf);
 		ret = ::write(_uart_fd, _buf, _buf_fill);
+		perf_end(_tx_write_perf);
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
 	}
 
 #if defined(MAVLINK_UDP)
 
 	else if (get_protocol() == Protocol::UDP) {
+		if (_udp_coalesce) {
+			// already in the datagram (see send_start()), it goes out when full or on flush_tx()
+			_udp_datagram_fill += _buf_fill;
+			ret = _buf_fill;
 
-# if defined(CONFIG_NET)
+		} else {
+			ret = send_udp(_buf, _buf_fill);
+		}
+	}
+
+#endif // MAVLINK_UDP
+
+	if (ret == (int)_buf_fill) {
+		_tstatus.tx_message_count++;
+		count_txbytes(_buf_fill);
+		_last_write_success_time = _last_write_try_time;
+
+	} else {
+		count_txerrbytes(_buf_fill);
+	}
+
+	_buf_fill = 0;
+
+	pthread_mutex_unlock(&_send_mutex);
+}
+
+#if defined(MAVLINK_UDP)
+int Mavlink::send_udp(const uint8_t *buf, unsigned len)
+{
+	int ret = -1;
+	bool send_unicast = true;
+	bool send_broadcast = false;
 
-		if (_src_addr_initialized) {
-# endif // CONFIG_NET
-			ret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
 # if defined(CONFIG_NET)
+	send_unicast = _src_addr_initialized;
+# endif // CONFIG_NET
+
+	if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+	    (!get_client_source_initialized() || !is_gcs_connected())) {
+
+		if (!_broadcast_address_found) {
+			find_broadcast_address();
 		}
 
-# endif // CONFIG_NET
+		send_broadcast = _broadcast_address_found && (len > 0);
+	}
 
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized() || !is_gcs_connected())) {
+	int bret = -1;
 
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
-			}
+	perf_begin(_tx_write_perf);
 
-			if (_broadcast_address_found && _buf_fill > 0) {
+# if defined(__PX4_LINUX)
 
-				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+	if (send_unicast && send_broadcast) {
+		// both destinations with a single syscall
+		iovec iov{const_cast<uint8_t *>(buf), len};
+		mmsghdr msgs[2] {};
 
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
+		msgs[0].msg_hdr.msg_name = &_src_addr;
+		msgs[0].msg_hdr.msg_namelen = sizeof(_src_addr);
+		msgs[0].msg_hdr.msg_iov = &iov;
+		msgs[0].msg_hdr.msg_iovlen = 1;
 
-				} else {
-					_broadcast_failed_warned = false;
-				}
+		msgs[1].msg_hdr.msg_name = &_bcast_addr;
+		msgs[1].msg_hdr.msg_namelen = sizeof(_bcast_addr);
+		msgs[1].msg_hdr.msg_iov = &iov;
+		msgs[1].msg_hdr.msg_iovlen = 1;
+
+		const int sent = sendmmsg(_socket_fd, msgs, 2, 0);
+
+		ret = (sent >= 1) ? (int)msgs[0].msg_len : -1;
+		bret = (sent >= 2) ? (int)msgs[1].msg_len : -1;
+
+	} else
+# endif // __PX4_LINUX
+	{
+		if (send_unicast) {
+			ret = sendto(_socket_fd, buf, len, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
+		}
+
+		if (send_broadcast) {
+			bret = sendto(_socket_fd, buf, len, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+		}
+	}
+
+	perf_end(_tx_write_perf);
+
+	if (send_broadcast) {
+		if (bret <= 0) {
+			if (!_broadcast_failed_warned) {
+				PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+				_broadcast_failed_warned = true;
 			}
+
+		} else {
+			_broadcast_failed_warned = false;
 		}
 	}
 
+	return ret;
+}
+
+void Mavlink::send_udp_datagram()
+{
+	if (_udp_datagram_fill == 0) {
+		return;
+	}
+
+	// the contained messages were already counted as sent when queued
+	if (send_udp(_udp_datagram, _udp_datagram_fill) != (int)_udp_datagram_fill) {
+		count_txerrbytes(_udp_datagram_fill);
+	}
+
+	_udp_datagram_fill = 0;
+}
 #endif // MAVLINK_UDP
 
-	if (ret == (int)_buf_fill) {
-		_tstatus.tx_message_count++;
-		count_txbytes(_buf_fill);
-		_last_write_success_time = _last_write_try_time;
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+void Mavlink::send_serial_frame()
+{
+	if (_serial_tx_frame_fill == 0) {
+		return;
+	}
 
-	} else {
-		count_txerrbytes(_buf_fill);
+	// every queued message was admitted against the free driver buffer (get_free_tx_buf()),
+	// so the frame fits and the write does not block
+	perf_begin(_tx_write_perf);
+	const int ret = ::write(_uart_fd, _serial_tx_frame, _serial_tx_frame_fill);
+	perf_end(_tx_write_perf);
+
+	// the contained messages were already counted as sent when queued
+	if (ret != (int)_serial_tx_frame_fill) {
+		count_txerrbytes(_serial_tx_frame_fill - math::max(ret, 0));
 	}
 
-	_buf_fill = 0;
+	_serial_tx_frame_fill = 0;
+}
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
 
-	pthread_mutex_unlock(&_send_mutex);
+void Mavlink::flush_tx()
+{
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+
+	if (get_protocol() == Protocol::SERIAL) {
+		pthread_mutex_lock(&_send_mutex);
+		send_serial_frame();
+		pthread_mutex_unlock(&_send_mutex);
+	}
+
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
+
+#if defined(MAVLINK_UDP)
+
+	if (_udp_coalesce) {
+		pthread_mutex_lock(&_send_mutex);
+		send_udp_datagram();
+		pthread_mutex_unlock(&_send_mutex);
+	}
+
+#endif // MAVLINK_UDP
 }
 
 void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 {
 	if (!_tx_buffer_low) {
-		if (_buf_fill + packet_len < sizeof(_buf)) {
-			memcpy(&_buf[_buf_fill], buf, packet_len);
+		if (_buf_fill + packet_len <= _tx_dest_size) {
+			memcpy(&_tx_dest[_buf_fill], buf, packet_len);
 			_buf_fill += packet_len;
 
 		} else {
@@ -997,6 +1197,15 @@ void Mavlink::init_udp()
 		return;
 	}
 
+#if defined(MAVLINK_UDP_RX_TIMESTAMP)
+	int timestamp_opt = 1;
+
+	if (setsockopt(_socket_fd, SOL_SOCKET, SO_TIMESTAMPNS, &timestamp_opt, sizeof(timestamp_opt)) < 0) {
+		PX4_WARN("setting receive timestamps failed: %s", strerror(errno));
+	}
+
+#endif // MAVLINK_UDP_RX_TIMESTAMP
+
 	/* set default target address, but not for onboard mode (will be set on first received packet) */
 	if (!_src_addr_initialized) {
 		_src_addr.sin_family = AF_INET;
@@ -1014,6 +1223,18 @@ Mavlink::handle_message(const mavlink_message_t *msg)
 	 *  NOTE: this is called from the receiver thread
 	 */
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+
+	if (msg->msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+		if (_param_mav_sign_cfg.get() != 0) {
+			_sign_control.handle_setup_signing(msg, get_system_id(), get_component_id(), is_usb_uart());
+		}
+
+		return; // never forward the key
+	}
+
+#endif // CONFIG_MAVLINK_SIGNING
+
 	if (get_forwarding_on()) {
 		/* forward any messages to other mavlink instances */
 		Mavlink::forward_message(msg, this);
@@ -1151,31 +1372,35 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 		interval = -1;
 	}
 
-	for (const auto &stream : _streams) {
-		if (strcmp(stream_name, stream->get_name()) == 0) {
-			if (interval != 0) {
-				/* set new interval */
-				stream->set_interval(interval);
+	// resolve the name once, then match the configured streams by id (the name only disambiguates streams sharing an id)
+	const StreamListItem *stream_item = find_stream_list_item(stream_name);
 
-			} else {
-				/* delete stream */
-				_streams.deleteNode(stream);
-				return OK; // must finish with loop after node is deleted
-			}
+	if (stream_item != nullptr) {
+		for (const auto &stream : _streams) {
+			if ((stream->get_id() == stream_item->get_id()) && (strcmp(stream_item->get_name(), stream->get_name()) == 0)) {
+				if (interval != 0) {
+					/* set new interval */
+					stream->set_interval(interval);
 
-			return OK;
+				} else {
+					/* delete stream */
+					_streams.deleteNode(stream);
+					return OK; // must finish with loop after node is deleted
+				}
+
+				return OK;
+			}
 		}
-	}
 
-	// search for stream with specified name in supported streams list
-	// create new instance if found
-	MavlinkStream *stream = create_mavlink_stream(stream_name, this);
+		// create new instance
+		MavlinkStream *stream = stream_item->new_instance(this);
 
-	if (stream != nullptr) {
-		stream->set_interval(interval);
-		_streams.add(stream);
+		if (stream != nullptr) {
+			stream->set_interval(interval);
+			_streams.add(stream);
 
-		return OK;
+			return OK;
+		}
 	}
 
 	/* if we reach here, the stream list does not contain the stream */
@@ -1369,14 +1594,18 @@ Mavlink::update_rate_mult()
 {
 	float const_rate = 0.0f;
 	float rate = 0.0f;
+	float rate_priority[(int)MavlinkStream::Priority::COUNT] {};
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
+		const float stream_rate = (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+
 		if (stream->const_rate()) {
-			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			const_rate += stream_rate;
 
 		} else {
-			rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			rate += stream_rate;
+			rate_priority[(int)stream->get_priority()] += stream_rate;
 		}
 	}
 
@@ -1430,6 +1659,112 @@ Mavlink::update_rate_mult()
 
 	/* ensure the rate multiplier never drops below 5% so that something is always sent */
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
+
+	/* hand out the available bandwidth by priority, so that low priority streams are scaled down first */
+	float rate_available = _rate_mult * rate;
+
+	for (int i = 0; i < (int)MavlinkStream::Priority::COUNT; i++) {
+		if (rate_priority[i] > 0.f) {
+			_rate_mult_priority[i] = math::constrain(rate_available / rate_priority[i], 0.05f, 1.0f);
+			rate_available = fmaxf(rate_available - _rate_mult_priority[i] * rate_priority[i], 0.f);
+
+		} else {
+			_rate_mult_priority[i] = 1.0f;
+		}
+	}
+}
+
+void
+Mavlink::update_streams(const hrt_abstime &t)
+{
+	unsigned due_size = 0;
+
+	for (const auto &stream : _streams) {
+		if (stream->update_due(t)) {
+			due_size += stream->get_size();
+		}
+	}
+
+	// the free space is only known for serial ports on NuttX, elsewhere get_free_tx_buf() returns the size of a packet
+	unsigned budget = UINT_MAX;
+
+#if defined(__PX4_NUTTX)
+
+	if (get_protocol() == Protocol::SERIAL) {
+		budget = get_free_tx_buf();
+	}
+
+#endif // __PX4_NUTTX
+
+	if (due_size <= budget) {
+		for (const auto &stream : _streams) {
+			if (stream->is_due()) {
+				stream->set_deficit(0);
+				stream->send_due(t);
+			}
+		}
+
+		return;
+	}
+
+	// Not everything fits: serve the priorities in order, and the streams within a priority by deficit round-robin,
+	// starting after the last stream served in the previous round. Each due stream gets a quantum of one packet per
+	// round, so that large streams do not starve small ones. Low priority updates that do not fit are dropped.
+	static constexpr unsigned QUANTUM = MAVLINK_MAX_PACKET_LEN;
+
+	for (int priority = 0; priority < (int)MavlinkStream::Priority::COUNT; priority++) {
+		int index = -1;
+		int next_start = -1;
+
+		for (int pass = 0; pass < 2; pass++) {
+			index = -1;
+
+			for (const auto &stream : _streams) {
+				if ((int)stream->get_priority() != priority) {
+					continue;
+				}
+
+				index++;
+
+				// first pass from the round-robin start to the end, second pass the beginning
+				if (!stream->is_due() || ((pass == 0) == (index < _stream_rr_start[priority]))) {
+					continue;
+				}
+
+				const unsigned size = stream->get_size();
+				const unsigned deficit = stream->get_deficit() + QUANTUM;
+
+				if ((size <= deficit) && (size <= budget)) {
+					stream->send_due(t);
+					stream->set_deficit(0);
+					budget -= size;
+
+				} else {
+					stream->set_deficit(deficit);
+
+					if (next_start < 0) {
+						next_start = index;
+					}
+				}
+			}
+		}
+
+		_stream_rr_start[priority] = (next_start >= 0) ? next_start : 0;
+	}
+
+	// whatever did not fit is deferred to the next iteration, or dropped if low priority
+	for (const auto &stream : _streams) {
+		if (stream->is_due()) {
+			if (stream->get_priority() == MavlinkStream::Priority::LOW) {
+				stream->skip_due(t);
+				stream->set_deficit(0);
+				perf_count(_stream_dropped_perf);
+
+			} else {
+				perf_count(_stream_deferred_perf);
+			}
+		}
+	}
 }
 
 void
@@ -1870,7 +2205,7 @@ Mavlink::task_main(int argc, char *argv[])
 	int temp_int_arg;
 #endif
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:fswxzZp", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:fswxzZpC", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			if (px4_get_parameter_value(myoptarg, _baudrate) != 0) {
@@ -1956,6 +2291,10 @@ Mavlink::task_main(int argc, char *argv[])
 			_mav_broadcast = BROADCAST_MODE_ON;
 			break;
 
+		case 'C':
+			_udp_coalesce = true;
+			break;
+
 #if defined(CONFIG_NET_IGMP) && defined(CONFIG_NET_ROUTE)
 
 		// multicast
@@ -1985,6 +2324,7 @@ Mavlink::task_main(int argc, char *argv[])
 		case 'u':
 		case 'o':
 		case 't':
+		case 'C':
 			PX4_ERR("UDP options not supported on this platform");
 			err_flag = true;
 			break;
@@ -2165,6 +2505,14 @@ Mavlink::task_main(int argc, char *argv[])
 		return PX4_ERROR;
 	}
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+
+	if (_param_mav_sign_cfg.get() != 0) {
+		_sign_control.start(get_instance_id(), get_status(), accept_unsigned_callback);
+	}
+
+#endif // CONFIG_MAVLINK_SIGNING
+
 	/* initialize send mutex */
 	pthread_mutex_init(&_send_mutex, nullptr);
 	pthread_mutex_init(&_radio_status_mutex, nullptr);
@@ -2263,6 +2611,7 @@ Mavlink::task_main(int argc, char *argv[])
 
 		if (!should_transmit()) {
 			check_requested_subscriptions();
+			flush_tx();
 			continue;
 		}
 
@@ -2285,6 +2634,10 @@ Mavlink::task_main(int argc, char *argv[])
 
 		configure_sik_radio();
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+		_sign_control.update();
+#endif // CONFIG_MAVLINK_SIGNING
+
 		if (_vehicle_status_sub.updated()) {
 			vehicle_status_s vehicle_status;
 
@@ -2450,9 +2803,9 @@ Mavlink::task_main(int argc, char *argv[])
 		check_requested_subscriptions();
 
 		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
+		update_streams(t);
 
+		for (const auto &stream : _streams) {
 			if (!_first_heartbeat_sent) {
 				if (_mode == MAVLINK_MODE_IRIDIUM) {
 					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
@@ -2589,11 +2942,16 @@ Mavlink::task_main(int argc, char *argv[])
 			publish_telemetry_status();
 		}
 
+		// send everything queued during this iteration (coalesced UDP datagram or serial frame)
+		flush_tx();
+
 		perf_end(_loop_perf);
 	}
 
 	_receiver.stop();
 
+	flush_tx();
+
 	delete _subscribe_to_stream;
 	_subscribe_to_stream = nullptr;
 
@@ -2884,6 +3242,14 @@ Mavlink::display_status()
 
 	printf("\tmavlink chan: #%u\n", static_cast<unsigned>(_channel));
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+
+	if (_sign_control.enabled()) {
+		printf("\tsigning: enabled (timestamp %" PRIu64 ")\n", _sign_control.timestamp());
+	}
+
+#endif // CONFIG_MAVLINK_SIGNING
+
 	if (_tstatus.timestamp > 0) {
 
 		printf("\ttype:\t\t");
@@ -2976,8 +3342,6 @@ Mavlink::display_status_streams()
 {
 	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
 
-	const float rate_mult = _rate_mult;
-
 	for (const auto &stream : _streams) {
 		const int interval = stream->get_interval();
 		const unsigned size = stream->get_size();
@@ -2990,7 +3354,7 @@ Mavlink::display_status_streams()
 			float rate = 1000000.0f / (float)interval;
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
-			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+			float rate_current = stream->const_rate() ? rate : rate * get_rate_mult(stream->get_priority());
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
@@ -3303,6 +3667,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_INT('u', 14556, 0, 65536, "Select UDP Network Port (local)", true);
 	PRINT_MODULE_USAGE_PARAM_INT('o', 14550, 0, 65536, "Select UDP Network Port (remote)", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('t', "127.0.0.1", nullptr, "Partner IP (broadcasting can be enabled via -p flag)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('C', "Coalesce messages into UDP datagrams (sent at least once per loop iteration)", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_STRING('m', "normal", "custom|camera|onboard|osd|magic|config|iridium|minimal|extvision|extvisionmin|gimbal",
 					"Mode: sets default streams and rates", true);
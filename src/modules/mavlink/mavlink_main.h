@@ -83,6 +83,9 @@
 #include "mavlink_messages.h"
 #include "mavlink_receiver.h"
 #include "mavlink_shell.h"
+#if defined(CONFIG_MAVLINK_SIGNING)
+#include "mavlink_sign_control.h"
+#endif // CONFIG_MAVLINK_SIGNING
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
@@ -95,6 +98,11 @@
 # define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
 #endif // CONFIG_NET || __PX4_POSIX
 
+#if defined(MAVLINK_UDP) && defined(__PX4_LINUX) && !defined(ENABLE_LOCKSTEP_SCHEDULER)
+// kernel receive timestamps (the simulated time of lockstep can't be derived from them)
+# define MAVLINK_UDP_RX_TIMESTAMP
+#endif
+
 enum class Protocol {
 	SERIAL = 0,
 #if defined(MAVLINK_UDP)
@@ -156,6 +164,12 @@ public:
 
 	mavlink_status_t 	*get_status() { return &_mavlink_status; }
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+	static Mavlink 		*get_instance_for_status(const mavlink_status_t *status);
+
+	int32_t			get_sign_mode() const { return _param_mav_sign_cfg.get(); }
+#endif // CONFIG_MAVLINK_SIGNING
+
 	/**
 	 * Set the MAVLink version
 	 *
@@ -338,6 +352,11 @@ public:
 	 */
 	void             	send_finish();
 
+	/**
+	 * Send out any messages queued for UDP coalescing (-C) or in the serial TX frame
+	 */
+	void			flush_tx();
+
 	/**
 	 * Resend message as is, don't change sequence number and CRC.
 	 */
@@ -406,6 +425,11 @@ public:
 
 	float			get_rate_mult() const { return _rate_mult; }
 
+	/**
+	 * Rate multiplier of the streams with a given priority, bandwidth is taken away from low priority streams first
+	 */
+	float			get_rate_mult(MavlinkStream::Priority priority) const { return _rate_mult_priority[(int)priority]; }
+
 	float			get_baudrate() { return _baudrate; }
 
 	/* Functions for waiting to start transmission until message received. */
@@ -499,6 +523,7 @@ public:
 	bool hash_check_enabled() const { return _param_mav_hash_chk_en.get(); }
 	bool forward_heartbeats_enabled() const { return _param_mav_hb_forw_en.get(); }
 	bool odometry_loopback_enabled() const { return _param_mav_odom_lp.get(); }
+	int mission_upload_window() const { return _param_mav_mis_up_win.get(); }
 
 	bool failure_injection_enabled() const { return _param_sys_failure_injection_enabled.get(); }
 
@@ -555,6 +580,10 @@ private:
 	mavlink_message_t	_mavlink_buffer {};
 	mavlink_status_t	_mavlink_status {};
 
+#if defined(CONFIG_MAVLINK_SIGNING)
+	MavlinkSignControl	_sign_control {};
+#endif // CONFIG_MAVLINK_SIGNING
+
 	/* states */
 	bool			_hil_enabled{false};		/**< Hardware In the Loop mode */
 	bool			_is_usb_uart{false};		/**< Port is USB */
@@ -585,6 +614,8 @@ private:
 	int			_baudrate{57600};
 	int			_datarate{1000};		///< data rate for normal streams (attitude, position, etc.)
 	float			_rate_mult{1.0f};
+	float			_rate_mult_priority[(int)MavlinkStream::Priority::COUNT] {1.0f, 1.0f, 1.0f};
+	uint8_t			_stream_rr_start[(int)MavlinkStream::Priority::COUNT] {}; ///< round-robin start per priority, see update_streams()
 
 	bool			_radio_status_available{false};
 	bool			_radio_status_critical{false};
@@ -630,10 +661,25 @@ private:
 
 	unsigned short		_network_port{14556};
 	unsigned short		_remote_port{DEFAULT_REMOTE_PORT_UDP};
+
+	bool			_udp_coalesce{false};
+
+	static constexpr unsigned UDP_DATAGRAM_SIZE{1472}; ///< Ethernet MTU minus IPv4 and UDP headers, avoids fragmentation
+	uint8_t			_udp_datagram[UDP_DATAGRAM_SIZE] {};
+	unsigned		_udp_datagram_fill{0};
 #endif // MAVLINK_UDP
 
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+	static constexpr unsigned SERIAL_TX_FRAME_SIZE{512}; ///< handed to the serial driver (and its TX DMA) with a single write
+	uint8_t			_serial_tx_frame[SERIAL_TX_FRAME_SIZE] {};
+	unsigned		_serial_tx_frame_fill{0};
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
+
 	uint8_t			_buf[MAVLINK_MAX_PACKET_LEN] {};
-	unsigned		_buf_fill{0};
+	unsigned		_buf_fill{0};			///< bytes of the current message written to _tx_dest
+
+	uint8_t			*_tx_dest{_buf};		///< where send_bytes() writes the current message (_buf or the coalescing buffer)
+	unsigned		_tx_dest_size{sizeof(_buf)};
 
 	bool			_tx_buffer_low{false};
 
@@ -673,6 +719,10 @@ private:
 		(ParamBool<px4::params::MAV_HB_FORW_EN>) _param_mav_hb_forw_en,
 		(ParamBool<px4::params::MAV_ODOM_LP>) _param_mav_odom_lp,
 		(ParamInt<px4::params::MAV_RADIO_TOUT>)      _param_mav_radio_timeout,
+		(ParamInt<px4::params::MAV_MIS_UP_WIN>) _param_mav_mis_up_win,
+#if defined(CONFIG_MAVLINK_SIGNING)
+		(ParamInt<px4::params::MAV_SIGN_CFG>) _param_mav_sign_cfg,
+#endif // CONFIG_MAVLINK_SIGNING
 		(ParamInt<px4::params::SYS_HITL>) _param_sys_hitl,
 		(ParamBool<px4::params::SYS_FAILURE_EN>) _param_sys_failure_injection_enabled
 	)
@@ -680,6 +730,9 @@ private:
 	perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": tx run elapsed")};                      /**< loop performance counter */
 	perf_counter_t _loop_interval_perf{perf_alloc(PC_INTERVAL, MODULE_NAME": tx run interval")};           /**< loop interval performance counter */
 	perf_counter_t _send_byte_error_perf{perf_alloc(PC_COUNT, MODULE_NAME": send_bytes error")};           /**< send bytes error count */
+	perf_counter_t _stream_deferred_perf{perf_alloc(PC_COUNT, MODULE_NAME": streams deferred")};           /**< due streams not sent because of tx buffer space */
+	perf_counter_t _stream_dropped_perf{perf_alloc(PC_COUNT, MODULE_NAME": streams dropped")};             /**< low priority stream updates dropped */
+	perf_counter_t _tx_write_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": tx write")};                        /**< time spent in the serial write / UDP sendto */
 
 	void			mavlink_update_parameters();
 
@@ -740,12 +793,29 @@ private:
 	 */
 	void update_rate_mult();
 
+	/**
+	 * Send the due streams within the free tx buffer space.
+	 */
+	void update_streams(const hrt_abstime &t);
+
 #if defined(MAVLINK_UDP)
 	void find_broadcast_address();
 
+	/**
+	 * Send a datagram to the partner and/or the broadcast address
+	 * @return bytes sent to the partner, -1 on error
+	 */
+	int send_udp(const uint8_t *buf, unsigned len);
+
+	void send_udp_datagram();
+
 	void init_udp();
 #endif // MAVLINK_UDP
 
+#if defined(CONFIG_MAVLINK_SERIAL_TX_COALESCE)
+	void send_serial_frame();
+#endif // CONFIG_MAVLINK_SERIAL_TX_COALESCE
+
 
 	bool set_channel();
 
@@ -43,6 +43,7 @@
 #include "mavlink_messages.h"
 #include "mavlink_command_sender.h"
 #include "mavlink_simple_analyzer.h"
+#include "MavlinkEncodeCache.hpp"
 
 #include <drivers/drv_pwm_output.h>
 #include <lib/conversion/rotation.h>
@@ -317,7 +318,8 @@ union px4_custom_mode get_px4_custom_mode(uint8_t nav_state)
 	return custom_mode;
 }
 
-static const StreamListItem streams_list[] = {
+// constant initialized: the list lives in flash and needs no static constructors
+static constexpr StreamListItem streams_list[] = {
 #if defined(HEARTBEAT_HPP)
 	create_stream_list_item<MavlinkStreamHeartbeat>(),
 #endif // HEARTBEAT_HPP
@@ -578,13 +580,13 @@ const char *get_stream_name(const uint16_t msg_id)
 	return nullptr;
 }
 
-MavlinkStream *create_mavlink_stream(const char *stream_name, Mavlink *mavlink)
+const StreamListItem *find_stream_list_item(const char *stream_name)
 {
 	// search for stream with specified name in supported streams list
 	if (stream_name != nullptr) {
 		for (const auto &stream : streams_list) {
 			if (strcmp(stream_name, stream.get_name()) == 0) {
-				return stream.new_instance(mavlink);
+				return &stream;
 			}
 		}
 	}
@@ -592,6 +594,13 @@ MavlinkStream *create_mavlink_stream(const char *stream_name, Mavlink *mavlink)
 	return nullptr;
 }
 
+MavlinkStream *create_mavlink_stream(const char *stream_name, Mavlink *mavlink)
+{
+	const StreamListItem *stream = find_stream_list_item(stream_name);
+
+	return (stream != nullptr) ? stream->new_instance(mavlink) : nullptr;
+}
+
 MavlinkStream *create_mavlink_stream(const uint16_t msg_id, Mavlink *mavlink)
 {
 	// search for stream with specified name in supported streams list
@@ -53,21 +53,27 @@ public:
 	const char *name;
 	uint16_t id;
 
-	StreamListItem(MavlinkStream * (*inst)(Mavlink *mavlink), const char *_name, uint16_t _id) :
+	constexpr StreamListItem(MavlinkStream * (*inst)(Mavlink *mavlink), const char *_name, uint16_t _id) :
 		new_instance(inst),
 		name(_name),
 		id(_id) {}
 
-	const char *get_name() const { return name; }
-	uint16_t get_id() const { return id; }
+	constexpr const char *get_name() const { return name; }
+	constexpr uint16_t get_id() const { return id; }
 };
 
 template <class T>
-static StreamListItem create_stream_list_item()
+static constexpr StreamListItem create_stream_list_item()
 {
 	return StreamListItem(&T::new_instance, T::get_name_static(), T::get_id_static());
 }
 
+/**
+ * Find a stream in the supported streams list
+ * @return the stream, or nullptr if not supported
+ */
+const StreamListItem *find_stream_list_item(const char *stream_name);
+
 const char *get_stream_name(const uint16_t msg_id);
 
 MavlinkStream *create_mavlink_stream(const char *stream_name, Mavlink *mavlink);
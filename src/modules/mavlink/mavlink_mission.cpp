@@ -541,8 +541,8 @@ MavlinkMissionManager::send()
 	if (_state == MAVLINK_WPM_STATE_GETLIST && (_time_last_sent > 0)
 	    && hrt_elapsed_time(&_time_last_sent) > MAVLINK_MISSION_RETRY_TIMEOUT_DEFAULT) {
 
-		// try to request item again after timeout
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		// try to request the missing items again after timeout
+		request_missing_items();
 
 	} else if (_state != MAVLINK_WPM_STATE_IDLE && (_time_last_recv > 0)
 		   && hrt_elapsed_time(&_time_last_recv) > MAVLINK_MISSION_PROTOCOL_TIMEOUT_DEFAULT) {
@@ -639,14 +639,8 @@ MavlinkMissionManager::handle_mission_ack(const mavlink_message_t *msg)
 				// INT or float mode is not supported
 				if (wpa.type == MAV_MISSION_UNSUPPORTED) {
 
-					if (_int_mode) {
-						_int_mode = false;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-
-					} else {
-						_int_mode = true;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-					}
+					_int_mode = !_int_mode;
+					request_missing_items();
 
 				} else if (wpa.type == MAV_MISSION_OPERATION_CANCELLED) {
 					PX4_DEBUG("WPM: MISSION_ACK CANCELLED, switch to state IDLE");
@@ -949,6 +943,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 
 			_state = MAVLINK_WPM_STATE_GETLIST;
 			_transfer_seq = 0;
+			_transfer_request_seq = 0;
+			_transfer_received = 0;
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 			_transfer_count = wpc.count;
@@ -974,9 +970,10 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
-			if (_transfer_seq == 0) {
+			if (_transfer_seq == 0 && _transfer_received == 0) {
 				/* looks like our MISSION_REQUEST was lost, try again */
 				PX4_DEBUG("WPM: MISSION_COUNT %u from ID %u (again)", wpc.count, msg->sysid);
+				_transfer_request_seq = 0;
 
 			} else {
 				PX4_DEBUG("WPM: MISSION_COUNT ERROR: busy, already receiving seq %u", _transfer_seq);
@@ -999,7 +996,34 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			return;
 		}
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		request_upload_window();
+	}
+}
+
+uint16_t
+MavlinkMissionManager::upload_window() const
+{
+	return math::constrain(_mavlink->mission_upload_window(), 1, (int)MAX_UPLOAD_WINDOW);
+}
+
+void
+MavlinkMissionManager::request_upload_window()
+{
+	const uint16_t window_end = math::min((uint32_t)_transfer_seq + upload_window(), (uint32_t)_transfer_count);
+
+	while (_transfer_request_seq < window_end) {
+		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_request_seq);
+		_transfer_request_seq++;
+	}
+}
+
+void
+MavlinkMissionManager::request_missing_items()
+{
+	for (uint16_t seq = _transfer_seq; seq < _transfer_request_seq; seq++) {
+		if (!(_transfer_received & (1u << (seq - _transfer_seq)))) {
+			send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, seq);
+		}
 	}
 }
 
@@ -1062,17 +1086,19 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 		if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
-			if (wp.seq != _transfer_seq) {
-				PX4_DEBUG("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_seq);
+			if (wp.seq < _transfer_seq || wp.seq >= _transfer_request_seq
+			    || (_transfer_received & (1u << (wp.seq - _transfer_seq)))) {
+				PX4_DEBUG("WPM: MISSION_ITEM ERROR: seq %u not in the expected range %u..%u", wp.seq, _transfer_seq,
+					  _transfer_request_seq - 1);
 
 				/* Item sequence not expected, ignore item */
 				return;
 			}
 
 		} else if (_state == MAVLINK_WPM_STATE_IDLE) {
-			if (_transfer_seq == wp.seq + 1) {
+			if (wp.seq < _transfer_seq && wp.seq + upload_window() >= _transfer_seq) {
 				// Assume this is a duplicate, where we already successfully got all mission items,
-				// but the GCS did not receive the last ack and sent the same item again
+				// but the GCS did not receive the last ack or answered a repeated request late
 				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ACCEPTED);
 
 			} else {
@@ -1215,7 +1241,13 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 		PX4_DEBUG("WPM: MISSION_ITEM seq %u received", wp.seq);
 
-		_transfer_seq = wp.seq + 1;
+		// advance the window start over all items received in sequence
+		_transfer_received |= 1u << (wp.seq - _transfer_seq);
+
+		while (_transfer_received & 1u) {
+			_transfer_received >>= 1;
+			_transfer_seq++;
+		}
 
 		if (_transfer_seq == _transfer_count) {
 			/* got all new mission items successfully */
@@ -1256,8 +1288,8 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			_transfer_in_progress = false;
 
 		} else {
-			/* request next item */
-			send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+			/* request the items which moved into the window */
+			request_upload_window();
 		}
 	}
 }
@@ -117,7 +117,9 @@ private:
 	dm_item_t			_transfer_dataman_id{DM_KEY_WAYPOINTS_OFFBOARD_1};		///< Dataman storage ID for current transmission
 
 	uint16_t		_transfer_count{0};			///< Items count in current transmission
-	uint16_t		_transfer_seq{0};			///< Item sequence in current transmission
+	uint16_t		_transfer_seq{0};			///< Item sequence in current transmission (first item not received yet)
+	uint16_t		_transfer_request_seq{0};		///< Next item to request when receiving (end of the upload window)
+	uint32_t		_transfer_received{0};			///< Items received ahead of _transfer_seq (bit i: _transfer_seq + i)
 
 	int32_t			_transfer_current_seq{-1};		///< Current item ID for current transmission (-1 means not initialized)
 
@@ -153,6 +155,17 @@ private:
 	/** get the number of item count for the current _mission_type */
 	uint16_t current_item_count();
 
+	static constexpr uint16_t	MAX_UPLOAD_WINDOW = 32;	///< bits in _transfer_received
+
+	/** number of items which are requested at once while receiving (MAV_MIS_UP_WIN) */
+	uint16_t upload_window() const;
+
+	/** request all items up to the end of the upload window which were not requested yet */
+	void request_upload_window();
+
+	/** repeat the requests of all items in the upload window which did not arrive yet */
+	void request_missing_items();
+
 	/* do not allow top copying this class */
 	MavlinkMissionManager(MavlinkMissionManager &);
 	MavlinkMissionManager &operator = (const MavlinkMissionManager &);
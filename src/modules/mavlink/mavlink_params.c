@@ -58,6 +58,21 @@ PARAM_DEFINE_INT32(MAV_COMP_ID, 1);
  */
 PARAM_DEFINE_INT32(MAV_PROTO_VER, 0);
 
+/**
+ * MAVLink message signing
+ *
+ * Signs outgoing MAVLink 2 messages and checks the signature of incoming ones, once a key
+ * has been set with SETUP_SIGNING (which is only accepted over USB, or signed with the current key).
+ * Unsigned RADIO_STATUS messages are always accepted.
+ *
+ * @group MAVLink
+ * @value 0 Disabled
+ * @value 1 Signing, unsigned messages accepted on USB
+ * @value 2 Signing on all links
+ * @reboot_required true
+ */
+PARAM_DEFINE_INT32(MAV_SIGN_CFG, 0);
+
 /**
  * MAVLink SiK Radio ID
  *
@@ -166,3 +181,18 @@ PARAM_DEFINE_INT32(MAV_ODOM_LP, 0);
  * @max 250
  */
 PARAM_DEFINE_INT32(MAV_RADIO_TOUT, 5);
+
+/**
+ * Mission upload window
+ *
+ * Number of mission items requested at once while receiving a mission, fence or
+ * rally point list. The items may arrive in any order within the window, which
+ * hides the round trip time of each MISSION_REQUEST(_INT) on high latency links.
+ * Set to 1 for ground stations which only answer the request of the next item
+ * in sequence.
+ *
+ * @group MAVLink
+ * @min 1
+ * @max 32
+ */
+PARAM_DEFINE_INT32(MAV_MIS_UP_WIN, 1);
@@ -69,6 +69,51 @@
 #define MAVLINK_RECEIVER_NET_ADDED_STACK 0
 #endif
 
+#if defined(MAVLINK_UDP_RX_TIMESTAMP)
+/**
+ * recvfrom() that moves rx_time back to the kernel receive timestamp (SO_TIMESTAMPNS) of the datagram
+ */
+static ssize_t recvfrom_timestamped(int fd, uint8_t *buf, size_t len, sockaddr_in &srcaddr, socklen_t &addrlen,
+				    hrt_abstime &rx_time)
+{
+	iovec iov{buf, len};
+	alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec))];
+
+	msghdr msg{};
+	msg.msg_name = &srcaddr;
+	msg.msg_namelen = addrlen;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	const ssize_t nread = recvmsg(fd, &msg, 0);
+	addrlen = msg.msg_namelen;
+
+	for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); (nread > 0) && (cmsg != nullptr); cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS)) {
+			timespec kernel_ts;
+			memcpy(&kernel_ts, CMSG_DATA(cmsg), sizeof(kernel_ts));
+
+			// the kernel stamps with CLOCK_REALTIME, only use the age of the datagram
+			timespec now_ts{};
+			clock_gettime(CLOCK_REALTIME, &now_ts);
+			const hrt_abstime now = hrt_absolute_time();
+
+			const int64_t age_us = (int64_t)(now_ts.tv_sec - kernel_ts.tv_sec) * 1000000LL
+					       + (now_ts.tv_nsec - kernel_ts.tv_nsec) / 1000;
+
+			// ignore realtime clock jumps
+			if ((age_us >= 0) && (age_us < 100000) && ((hrt_abstime)age_us < now)) {
+				rx_time = math::min(rx_time, now - age_us);
+			}
+		}
+	}
+
+	return nread;
+}
+#endif // MAVLINK_UDP_RX_TIMESTAMP
+
 MavlinkReceiver::~MavlinkReceiver()
 {
 	delete _tune_publisher;
@@ -78,6 +123,12 @@ MavlinkReceiver::~MavlinkReceiver()
 #if !defined(CONSTRAINED_FLASH)
 	delete[] _received_msg_stats;
 #endif // !CONSTRAINED_FLASH
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	perf_free(_deferred_wait_perf);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
+	perf_free(_rx_latency_perf);
+	perf_free(_offboard_link_latency_perf);
 }
 
 static constexpr vehicle_odometry_s vehicle_odometry_empty {
@@ -1688,8 +1739,19 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 
 			// Publish rate setpoint only once in OFFBOARD
 			if (vehicle_status.nav_state == vehicle_status_s::NAVIGATION_STATE_OFFBOARD) {
+				// the rate controller measures the latency from here to the actuator output (see MulticopterRateControl)
+				setpoint.timestamp_sample = _rx_time;
 				setpoint.timestamp = hrt_absolute_time();
 				_rates_sp_pub.publish(setpoint);
+
+				if (_mavlink_timesync.sync_converged() && (attitude_target.time_boot_ms != 0)) {
+					// companion send time -> packet reception, only meaningful if the sender stamps time_boot_ms with its timesync clock
+					const hrt_abstime sent = _mavlink_timesync.sync_stamp(attitude_target.time_boot_ms * 1000ULL);
+
+					if ((sent <= _rx_time) && (_rx_time - sent < 1_s)) {
+						perf_set_elapsed(_offboard_link_latency_perf, _rx_time - sent);
+					}
+				}
 			}
 		}
 	}
@@ -2486,6 +2548,12 @@ MavlinkReceiver::handle_message_follow_target(mavlink_message_t *msg)
 	follow_target_s follow_target_topic{};
 
 	follow_target_topic.timestamp = hrt_absolute_time();
+
+	if (_mavlink_timesync.sync_converged() && (follow_target_msg.timestamp != 0)) {
+		follow_target_topic.timestamp_sample = math::min(_mavlink_timesync.sync_stamp(follow_target_msg.timestamp * 1000ULL),
+						       follow_target_topic.timestamp);
+	}
+
 	follow_target_topic.lat = follow_target_msg.lat * 1e-7;
 	follow_target_topic.lon = follow_target_msg.lon * 1e-7;
 	follow_target_topic.alt = follow_target_msg.alt;
@@ -2707,18 +2775,68 @@ MavlinkReceiver::handle_message_gps_rtcm_data(mavlink_message_t *msg)
 	mavlink_gps_rtcm_data_t gps_rtcm_data_msg;
 	mavlink_msg_gps_rtcm_data_decode(msg, &gps_rtcm_data_msg);
 
+	const size_t len = math::min(sizeof(gps_rtcm_data_msg.data), (size_t)gps_rtcm_data_msg.len);
+
+	// flags: bit 0 fragmented, bits 1-2 fragment id, bits 3-7 sequence id
+	const bool fragmented = gps_rtcm_data_msg.flags & 0x1;
+	const uint8_t fragment_id = (gps_rtcm_data_msg.flags >> 1) & 0x3;
+	const uint8_t sequence_id = (gps_rtcm_data_msg.flags >> 3) & 0x1f;
+
+	if (_rtcm_len > 0) {
+		if (!fragmented || sequence_id != _rtcm_sequence) {
+			// the previous message ended on a full fragment
+			publish_gps_inject_data(_rtcm_buffer, _rtcm_len);
+			_rtcm_len = 0;
+
+		} else if (fragment_id != _rtcm_next_fragment) {
+			// a fragment got lost, the GPS would reject the incomplete frame anyway
+			_rtcm_fragments_dropped += _rtcm_next_fragment;
+			_rtcm_len = 0;
+		}
+	}
+
+	if (!fragmented) {
+		publish_gps_inject_data(gps_rtcm_data_msg.data, len);
+		return;
+	}
+
+	if (_rtcm_len == 0 && fragment_id != 0) {
+		_rtcm_fragments_dropped++;
+		return;
+	}
+
+	memcpy(&_rtcm_buffer[_rtcm_len], gps_rtcm_data_msg.data, len);
+	_rtcm_len += len;
+	_rtcm_sequence = sequence_id;
+	_rtcm_next_fragment = fragment_id + 1;
+
+	// the last fragment is the first one that is not full
+	if ((len < sizeof(gps_rtcm_data_msg.data)) || (_rtcm_next_fragment == RTCM_MAX_FRAGMENTS)) {
+		publish_gps_inject_data(_rtcm_buffer, _rtcm_len);
+		_rtcm_len = 0;
+	}
+}
+
+void
+MavlinkReceiver::publish_gps_inject_data(const uint8_t *data, size_t len)
+{
 	gps_inject_data_s gps_inject_data_topic{};
 
-	gps_inject_data_topic.timestamp = hrt_absolute_time();
+	// fill every message, a reassembled frame needs fewer queue slots than its MAVLink fragments
+	for (size_t offset = 0; offset < len;) {
+		const size_t chunk = math::min(len - offset, sizeof(gps_inject_data_topic.data));
+
+		gps_inject_data_topic.len = chunk;
+		gps_inject_data_topic.flags = (offset + chunk < len) ? 1 : 0; // more data of this frame follows
+		memcpy(gps_inject_data_topic.data, &data[offset], chunk);
 
-	gps_inject_data_topic.len = math::min((int)sizeof(gps_rtcm_data_msg.data),
-					      (int)sizeof(uint8_t) * gps_rtcm_data_msg.len);
-	gps_inject_data_topic.flags = gps_rtcm_data_msg.flags;
-	memcpy(gps_inject_data_topic.data, gps_rtcm_data_msg.data,
-	       math::min((int)sizeof(gps_inject_data_topic.data), (int)sizeof(uint8_t) * gps_inject_data_topic.len));
+		gps_inject_data_topic.timestamp = hrt_absolute_time();
+		_gps_inject_data_pub.publish(gps_inject_data_topic);
+
+		offset += chunk;
+	}
 
-	gps_inject_data_topic.timestamp = hrt_absolute_time();
-	_gps_inject_data_pub.publish(gps_inject_data_topic);
+	_rtcm_frames++;
 }
 
 void
@@ -3198,7 +3316,6 @@ MavlinkReceiver::run()
 #endif // MAVLINK_UDP
 
 	ssize_t nread = 0;
-	hrt_abstime last_send_update = 0;
 
 	while (!_mavlink->should_exit()) {
 
@@ -3215,6 +3332,9 @@ MavlinkReceiver::run()
 		int ret = poll(&fds[0], 1, timeout);
 
 		if (ret > 0) {
+			// earliest time available to us, refined with the kernel timestamp of UDP datagrams if supported
+			hrt_abstime rx_time = hrt_absolute_time();
+
 			if (_mavlink->get_protocol() == Protocol::SERIAL) {
 				/* non-blocking read. read may return negative values */
 				nread = ::read(fds[0].fd, buf, sizeof(buf));
@@ -3228,7 +3348,11 @@ MavlinkReceiver::run()
 
 			else if (_mavlink->get_protocol() == Protocol::UDP) {
 				if (fds[0].revents & POLLIN) {
+#if defined(MAVLINK_UDP_RX_TIMESTAMP)
+					nread = recvfrom_timestamped(_mavlink->get_socket_fd(), buf, sizeof(buf), srcaddr, addrlen, rx_time);
+#else
 					nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
+#endif // MAVLINK_UDP_RX_TIMESTAMP
 				}
 
 				struct sockaddr_in &srcaddr_last = _mavlink->get_client_source_address();
@@ -3259,6 +3383,9 @@ MavlinkReceiver::run()
 			if (_mavlink->get_protocol() != Protocol::UDP || _mavlink->get_client_source_initialized()) {
 #endif // MAVLINK_UDP
 
+				const hrt_abstime read_time = hrt_absolute_time();
+				_rx_time = rx_time;
+
 				/* if read failed, this loop won't execute */
 				for (ssize_t i = 0; i < nread; i++) {
 					if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &_status)) {
@@ -3269,38 +3396,36 @@ MavlinkReceiver::run()
 							_mavlink->set_proto_version(2);
 						}
 
+						if (!_mavlink->boot_complete() && (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s)) {
+							PX4_ERR("system boot did not complete in 20 seconds");
+							_mavlink->set_boot_complete();
+						}
+
 						/* handle generic messages and commands */
 						handle_message(&msg);
 
-						/* handle packet with mission manager */
-						_mission_manager.handle_message(&msg);
-
-						/* handle packet with parameter component */
-						if (_mavlink->boot_complete()) {
-							// make sure mavlink app has booted before we start processing parameter sync
-							_parameters_manager.handle_message(&msg);
-
-						} else {
-							if (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s) {
-								PX4_ERR("system boot did not complete in 20 seconds");
-								_mavlink->set_boot_complete();
-							}
-						}
+						/* handle packet with mission manager, parameter, ftp and log component */
+						const bool slow_message = is_slow_message(msg.msgid);
 
-						if (_mavlink->ftp_enabled()) {
-							/* handle packet with ftp component */
-							_mavlink_ftp.handle_message(&msg);
+						if (slow_message) {
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+							defer_message(msg);
+#else
+							handle_slow_message(&msg);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
 						}
 
-						/* handle packet with log component */
-						_mavlink_log_handler.handle_message(&msg);
-
 						/* handle packet with timesync component */
-						_mavlink_timesync.handle_message(&msg);
+						_mavlink_timesync.handle_message(&msg, _rx_time);
 
 						/* handle packet with parent object */
 						_mavlink->handle_message(&msg);
 
+						if (!slow_message) {
+							// time from reading the buffer until the message is handled
+							perf_set_elapsed(_rx_latency_perf, hrt_elapsed_time(&read_time));
+						}
+
 						update_rx_stats(msg);
 
 						if (_message_statistics_enabled) {
@@ -3347,19 +3472,9 @@ MavlinkReceiver::run()
 
 		CheckHeartbeats(t);
 
-		if (t - last_send_update > timeout * 1000) {
-			_mission_manager.check_active_mission();
-			_mission_manager.send();
-
-			_parameters_manager.send();
-
-			if (_mavlink->ftp_enabled()) {
-				_mavlink_ftp.send();
-			}
-
-			_mavlink_log_handler.send();
-			last_send_update = t;
-		}
+#if !defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+		update_slow_handlers(t);
+#endif // !CONFIG_MAVLINK_RECEIVER_WORKER
 
 		if (_tune_publisher != nullptr) {
 			_tune_publisher->publish_next_tune(t);
@@ -3384,6 +3499,157 @@ bool MavlinkReceiver::component_was_seen(int system_id, int component_id)
 	return false;
 }
 
+bool MavlinkReceiver::is_slow_message(uint16_t msgid)
+{
+	switch (msgid) {
+	case MAVLINK_MSG_ID_MISSION_ACK:
+	case MAVLINK_MSG_ID_MISSION_SET_CURRENT:
+	case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+	case MAVLINK_MSG_ID_MISSION_REQUEST:
+	case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+	case MAVLINK_MSG_ID_MISSION_COUNT:
+	case MAVLINK_MSG_ID_MISSION_ITEM:
+	case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+	case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+	case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+	case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+	case MAVLINK_MSG_ID_PARAM_SET:
+	case MAVLINK_MSG_ID_PARAM_MAP_RC:
+	case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+	case MAVLINK_MSG_ID_LOG_REQUEST_LIST:
+	case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+	case MAVLINK_MSG_ID_LOG_ERASE:
+	case MAVLINK_MSG_ID_LOG_REQUEST_END:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void MavlinkReceiver::handle_slow_message(mavlink_message_t *msg)
+{
+	/* handle packet with mission manager */
+	_mission_manager.handle_message(msg);
+
+	/* handle packet with parameter component */
+	if (_mavlink->boot_complete()) {
+		// make sure mavlink app has booted before we start processing parameter sync
+		_parameters_manager.handle_message(msg);
+	}
+
+	if (_mavlink->ftp_enabled()) {
+		/* handle packet with ftp component */
+		_mavlink_ftp.handle_message(msg);
+	}
+
+	/* handle packet with log component */
+	_mavlink_log_handler.handle_message(msg);
+}
+
+void MavlinkReceiver::update_slow_handlers(const hrt_abstime &t)
+{
+	// same rate as the receive loop poll timeout
+	if (t - _last_slow_handlers_update > 10_ms) {
+		_mission_manager.check_active_mission();
+		_mission_manager.send();
+
+		_parameters_manager.send();
+
+		if (_mavlink->ftp_enabled()) {
+			_mavlink_ftp.send();
+		}
+
+		_mavlink_log_handler.send();
+		_last_slow_handlers_update = t;
+	}
+}
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+bool MavlinkReceiver::defer_message(const mavlink_message_t &msg)
+{
+	pthread_mutex_lock(&_deferred_mutex);
+
+	if (_deferred_count >= DEFERRED_QUEUE_SIZE) {
+		// the sender retries (all of these protocols have timeouts and retransmission)
+		_deferred_dropped++;
+		pthread_mutex_unlock(&_deferred_mutex);
+		return false;
+	}
+
+	DeferredMessage &deferred = _deferred_queue[(_deferred_head + _deferred_count) % DEFERRED_QUEUE_SIZE];
+	deferred.msg = msg;
+	deferred.timestamp = hrt_absolute_time();
+	_deferred_count++;
+
+	if (_deferred_count > _deferred_count_max) {
+		_deferred_count_max = _deferred_count;
+	}
+
+	pthread_mutex_unlock(&_deferred_mutex);
+
+	px4_sem_post(&_deferred_sem);
+	return true;
+}
+
+void MavlinkReceiver::run_worker()
+{
+	/* set thread name */
+	{
+		char thread_name[17];
+		snprintf(thread_name, sizeof(thread_name), "mavlink_wrk_if%d", _mavlink->get_instance_id());
+		px4_prctl(PR_SET_NAME, thread_name, px4_getpid());
+	}
+
+	mavlink_message_t msg;
+
+	while (!_mavlink->should_exit() && !_should_exit.load()) {
+
+		// wait for a message, at most until the next send update is due
+		timespec ts{};
+#if defined(__PX4_NUTTX)
+		px4_clock_gettime(CLOCK_REALTIME, &ts);
+#else
+		px4_clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+		uint64_t nsecs = ts.tv_nsec + 10'000'000;
+		ts.tv_sec += nsecs / 1'000'000'000;
+		ts.tv_nsec = nsecs % 1'000'000'000;
+
+		px4_sem_timedwait(&_deferred_sem, &ts);
+
+		for (;;) {
+			pthread_mutex_lock(&_deferred_mutex);
+
+			if (_deferred_count == 0) {
+				pthread_mutex_unlock(&_deferred_mutex);
+				break;
+			}
+
+			const DeferredMessage &deferred = _deferred_queue[_deferred_head];
+			msg = deferred.msg;
+			perf_set_elapsed(_deferred_wait_perf, hrt_elapsed_time(&deferred.timestamp));
+
+			_deferred_head = (_deferred_head + 1) % DEFERRED_QUEUE_SIZE;
+			_deferred_count--;
+
+			pthread_mutex_unlock(&_deferred_mutex);
+
+			handle_slow_message(&msg);
+		}
+
+		update_slow_handlers(hrt_absolute_time());
+	}
+}
+
+void *MavlinkReceiver::worker_trampoline(void *context)
+{
+	MavlinkReceiver *self = reinterpret_cast<MavlinkReceiver *>(context);
+	self->run_worker();
+	return nullptr;
+}
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
+
 void MavlinkReceiver::update_rx_stats(const mavlink_message_t &message)
 {
 	const bool component_states_has_still_space = [this, &message]() {
@@ -3510,6 +3776,15 @@ void MavlinkReceiver::update_message_statistics(const mavlink_message_t &message
 
 void MavlinkReceiver::print_detailed_rx_stats() const
 {
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	printf("\tDeferred messages: queued %" PRIu8 " (max %" PRIu8 " of %" PRIu8 "), dropped %" PRIu32 "\n",
+	       _deferred_count, _deferred_count_max, DEFERRED_QUEUE_SIZE, _deferred_dropped);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
+
+	if (_rtcm_frames > 0 || _rtcm_fragments_dropped > 0) {
+		printf("\tRTCM frames: %" PRIu32 ", fragments dropped: %" PRIu32 "\n", _rtcm_frames, _rtcm_fragments_dropped);
+	}
+
 	// TODO: add mutex around shared data.
 	if (_component_states_count > 0) {
 		printf("\tReceived Messages:\n");
@@ -3564,6 +3839,26 @@ void MavlinkReceiver::start()
 	pthread_create(&_thread, &receiveloop_attr, MavlinkReceiver::start_trampoline, (void *)this);
 
 	pthread_attr_destroy(&receiveloop_attr);
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	pthread_mutex_init(&_deferred_mutex, nullptr);
+	px4_sem_init(&_deferred_sem, 0, 0);
+	// _deferred_sem use case is a signal
+	px4_sem_setprotocol(&_deferred_sem, SEM_PRIO_NONE);
+
+	pthread_attr_t worker_attr;
+	pthread_attr_init(&worker_attr);
+
+	(void)pthread_attr_getschedparam(&worker_attr, &param);
+	param.sched_priority = SCHED_PRIORITY_DEFAULT;
+	(void)pthread_attr_setschedparam(&worker_attr, &param);
+
+	pthread_attr_setstacksize(&worker_attr, PX4_STACK_ADJUSTED(2840 + MAVLINK_RECEIVER_NET_ADDED_STACK));
+
+	pthread_create(&_worker_thread, &worker_attr, MavlinkReceiver::worker_trampoline, (void *)this);
+
+	pthread_attr_destroy(&worker_attr);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
 }
 
 void
@@ -3584,4 +3879,12 @@ void MavlinkReceiver::stop()
 {
 	_should_exit.store(true);
 	pthread_join(_thread, nullptr);
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	px4_sem_post(&_deferred_sem);
+	pthread_join(_worker_thread, nullptr);
+
+	px4_sem_destroy(&_deferred_sem);
+	pthread_mutex_destroy(&_deferred_mutex);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
 }
@@ -56,7 +56,10 @@
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
 #include <lib/drivers/magnetometer/PX4Magnetometer.hpp>
 #include <lib/systemlib/mavlink_log.h>
+#include <perf/perf_counter.h>
 #include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/sem.h>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/SubscriptionInterval.hpp>
@@ -215,6 +218,23 @@ private:
 
 	void CheckHeartbeats(const hrt_abstime &t, bool force = false);
 
+	/**
+	 * Mission, parameter, FTP and log handling, which may access storage.
+	 */
+	static bool is_slow_message(uint16_t msgid);
+	void handle_slow_message(mavlink_message_t *msg);
+	void update_slow_handlers(const hrt_abstime &t);
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	static void *worker_trampoline(void *context);
+	void run_worker();
+
+	/**
+	 * Queue a message for the worker thread, returns false if the queue is full.
+	 */
+	bool defer_message(const mavlink_message_t &msg);
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
+
 	/**
 	 * Set the interval at which the given message stream is published.
 	 * The rate is the number of messages per second.
@@ -237,8 +257,49 @@ private:
 	void update_message_statistics(const mavlink_message_t &message);
 	void update_rx_stats(const mavlink_message_t &message);
 
+	/**
+	 * Publish RTCM data to the GPS drivers, split over as few gps_inject_data messages as possible.
+	 */
+	void publish_gps_inject_data(const uint8_t *data, size_t len);
+
 	px4::atomic_bool 	_should_exit{false};
 	pthread_t		_thread {};
+
+#if defined(CONFIG_MAVLINK_RECEIVER_WORKER)
+	pthread_t		_worker_thread {};
+
+	struct DeferredMessage {
+		mavlink_message_t msg;
+		hrt_abstime timestamp;
+	};
+
+	static constexpr uint8_t DEFERRED_QUEUE_SIZE{8};
+	DeferredMessage		_deferred_queue[DEFERRED_QUEUE_SIZE] {};
+	uint8_t			_deferred_head{0};
+	uint8_t			_deferred_count{0};
+	uint8_t			_deferred_count_max{0};
+	uint32_t		_deferred_dropped{0};
+	pthread_mutex_t		_deferred_mutex {};
+	px4_sem_t		_deferred_sem {};	///< posted for every queued message
+
+	perf_counter_t _deferred_wait_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": rx deferred wait")};
+#endif // CONFIG_MAVLINK_RECEIVER_WORKER
+
+	hrt_abstime		_last_slow_handlers_update{0};
+
+	// GPS_RTCM_DATA fragment reassembly
+	static constexpr uint8_t RTCM_MAX_FRAGMENTS{4};
+	uint8_t			_rtcm_buffer[RTCM_MAX_FRAGMENTS * MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN] {};
+	uint16_t		_rtcm_len{0};
+	uint8_t			_rtcm_sequence{0};
+	uint8_t			_rtcm_next_fragment{0};
+	uint32_t		_rtcm_frames{0};
+	uint32_t		_rtcm_fragments_dropped{0};
+
+	perf_counter_t _rx_latency_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": rx handling latency")};
+	perf_counter_t _offboard_link_latency_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": offboard setpoint link latency")};
+
+	hrt_abstime		_rx_time{0};	///< reception time of the buffer completing the message currently handled
 	/**
 	 * @brief Updates optical flow parameters.
 	 */
@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "mavlink_sign_control.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+static const char *MAVLINK_FOLDER_PATH = PX4_STORAGEDIR"/mavlink";
+static const char *MAVLINK_SIGNING_KEY_FILE = PX4_STORAGEDIR"/mavlink/mavlink-signing-key.bin";
+
+// signing timestamp: 10 us units since 1st January 2015 GMT
+static constexpr time_t SIGNING_EPOCH_SECS = 1420070400;
+static constexpr uint64_t SIGNING_TIMESTAMP_PER_SEC = 100000;
+
+static bool key_is_set(const uint8_t key[32])
+{
+	for (int i = 0; i < 32; i++) {
+		if (key[i] != 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MavlinkSignControl::start(uint8_t link_id, mavlink_status_t *mavlink_status,
+			       mavlink_accept_unsigned_t accept_unsigned_callback)
+{
+	_mavlink_status = mavlink_status;
+	_mavlink_signing.link_id = link_id;
+	_mavlink_signing.accept_unsigned_callback = accept_unsigned_callback;
+
+	if (load() && key_is_set(_mavlink_signing.secret_key)) {
+		// the stored timestamp might be up to one store interval behind the last one used
+		_mavlink_signing.timestamp += STORE_INTERVAL / 10;
+		_mavlink_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+		_mavlink_status->signing = &_mavlink_signing;
+		_mavlink_status->signing_streams = &_mavlink_signing_streams;
+		_enabled = true;
+	}
+}
+
+bool MavlinkSignControl::handle_setup_signing(const mavlink_message_t *msg, uint8_t system_id, uint8_t component_id,
+		bool trusted_link)
+{
+	if (msg->msgid != MAVLINK_MSG_ID_SETUP_SIGNING) {
+		return false;
+	}
+
+	mavlink_setup_signing_t setup_signing;
+	mavlink_msg_setup_signing_decode(msg, &setup_signing);
+
+	if ((setup_signing.target_system != system_id && setup_signing.target_system != 0)
+	    || (setup_signing.target_component != component_id && setup_signing.target_component != 0)) {
+		return false;
+	}
+
+	// with signing enabled only the current key owner may change it
+	const bool signed_message = (msg->incompat_flags & MAVLINK_IFLAG_SIGNED);
+
+	if (!trusted_link && !(_enabled && signed_message)) {
+		PX4_WARN("SETUP_SIGNING rejected (untrusted link)");
+		return false;
+	}
+
+	memcpy(_mavlink_signing.secret_key, setup_signing.secret_key, sizeof(_mavlink_signing.secret_key));
+
+	if (setup_signing.initial_timestamp > _mavlink_signing.timestamp) {
+		_mavlink_signing.timestamp = setup_signing.initial_timestamp;
+	}
+
+	if (key_is_set(_mavlink_signing.secret_key)) {
+		_mavlink_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+		_mavlink_status->signing_streams = &_mavlink_signing_streams;
+		_mavlink_status->signing = &_mavlink_signing;
+		_enabled = true;
+
+	} else {
+		// an all zero key disables signing
+		_mavlink_status->signing = nullptr;
+		_mavlink_status->signing_streams = nullptr;
+		_mavlink_signing.flags = 0;
+		_enabled = false;
+	}
+
+	if (!store()) {
+		PX4_ERR("storing the signing key failed");
+	}
+
+	PX4_INFO("signing %s", _enabled ? "enabled" : "disabled");
+	return true;
+}
+
+void MavlinkSignControl::update()
+{
+	if (!_enabled) {
+		return;
+	}
+
+	struct timespec ts {};
+
+	px4_clock_gettime(CLOCK_REALTIME, &ts);
+
+	if (ts.tv_sec > SIGNING_EPOCH_SECS) {
+		const uint64_t timestamp = (uint64_t)(ts.tv_sec - SIGNING_EPOCH_SECS) * SIGNING_TIMESTAMP_PER_SEC
+					   + (uint64_t)ts.tv_nsec / 10000;
+
+		if (timestamp > _mavlink_signing.timestamp) {
+			_mavlink_signing.timestamp = timestamp;
+		}
+	}
+
+	if (hrt_elapsed_time(&_last_store) > STORE_INTERVAL) {
+		store();
+	}
+}
+
+bool MavlinkSignControl::load()
+{
+	int fd = ::open(MAVLINK_SIGNING_KEY_FILE, O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	uint64_t timestamp = 0;
+	uint8_t key[sizeof(_mavlink_signing.secret_key)];
+	const bool ok = (::read(fd, &timestamp, sizeof(timestamp)) == sizeof(timestamp))
+			&& (::read(fd, key, sizeof(key)) == sizeof(key));
+	::close(fd);
+
+	if (ok) {
+		_mavlink_signing.timestamp = timestamp;
+		memcpy(_mavlink_signing.secret_key, key, sizeof(key));
+	}
+
+	_last_store = hrt_absolute_time();
+	return ok;
+}
+
+bool MavlinkSignControl::store()
+{
+	_last_store = hrt_absolute_time();
+
+	mkdir(MAVLINK_FOLDER_PATH, S_IRWXU | S_IRWXG | S_IRWXO);
+
+	int fd = ::open(MAVLINK_SIGNING_KEY_FILE, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_600);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	const uint64_t timestamp = _mavlink_signing.timestamp;
+	const bool ok = (::write(fd, &timestamp, sizeof(timestamp)) == sizeof(timestamp))
+			&& (::write(fd, _mavlink_signing.secret_key, sizeof(_mavlink_signing.secret_key))
+			    == sizeof(_mavlink_signing.secret_key));
+	::close(fd);
+
+	return ok;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_sign_control.h
+ * MAVLink 2 message signing: key storage, SETUP_SIGNING handling and the signing timestamp.
+ */
+
+#pragma once
+
+#include "mavlink_bridge_header.h"
+
+#include <drivers/drv_hrt.h>
+
+using namespace time_literals;
+
+class MavlinkSignControl
+{
+public:
+	MavlinkSignControl() = default;
+	~MavlinkSignControl() = default;
+
+	/**
+	 * Load the stored key and enable signing on a channel if a key is set.
+	 * @param link_id link id sent in the signature of outgoing messages
+	 * @param mavlink_status status of the channel
+	 * @param accept_unsigned_callback decides which unsigned messages are accepted
+	 */
+	void start(uint8_t link_id, mavlink_status_t *mavlink_status, mavlink_accept_unsigned_t accept_unsigned_callback);
+
+	/**
+	 * Handle SETUP_SIGNING. The key is only accepted if the message is signed with the current key,
+	 * or over a trusted link (USB).
+	 * @return true if the key was changed
+	 */
+	bool handle_setup_signing(const mavlink_message_t *msg, uint8_t system_id, uint8_t component_id, bool trusted_link);
+
+	/**
+	 * Advance the signing timestamp to the real time once it is known and store it periodically,
+	 * so it keeps increasing over reboots. Call from the main loop.
+	 */
+	void update();
+
+	bool enabled() const { return _enabled; }
+
+	uint64_t timestamp() const { return _mavlink_signing.timestamp; }
+
+private:
+	bool load();
+	bool store();
+
+	static constexpr hrt_abstime STORE_INTERVAL{300_s};
+
+	mavlink_signing_t _mavlink_signing{};
+	mavlink_signing_streams_t _mavlink_signing_streams{};
+	mavlink_status_t *_mavlink_status{nullptr};
+
+	hrt_abstime _last_store{0};
+	bool _enabled{false};
+};
@@ -50,47 +50,82 @@ MavlinkStream::MavlinkStream(Mavlink *mavlink) :
 	_last_sent = hrt_absolute_time();
 }
 
+MavlinkStream::Priority
+MavlinkStream::default_priority(uint16_t msg_id)
+{
+	switch (msg_id) {
+	case MAVLINK_MSG_ID_HEARTBEAT:
+	case MAVLINK_MSG_ID_HIGH_LATENCY2:
+	case MAVLINK_MSG_ID_SYS_STATUS:
+	case MAVLINK_MSG_ID_STATUSTEXT:
+	case MAVLINK_MSG_ID_ATTITUDE:
+	case MAVLINK_MSG_ID_ATTITUDE_QUATERNION:
+	case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+	case MAVLINK_MSG_ID_BATTERY_STATUS:
+		return Priority::HIGH;
+
+	case MAVLINK_MSG_ID_DEBUG:
+	case MAVLINK_MSG_ID_DEBUG_VECT:
+	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
+	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
+	case MAVLINK_MSG_ID_HIGHRES_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU2:
+	case MAVLINK_MSG_ID_SCALED_IMU3:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE2:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE3:
+	case MAVLINK_MSG_ID_ESTIMATOR_STATUS:
+	case MAVLINK_MSG_ID_VIBRATION:
+	case MAVLINK_MSG_ID_LINK_NODE_STATUS:
+		return Priority::LOW;
+
+	default:
+		return Priority::NORMAL;
+	}
+}
+
+int
+MavlinkStream::current_interval()
+{
+	int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult(get_priority());
+	}
+
+	return interval;
+}
+
 /**
- * Update subscriptions and send message if necessary
+ * Update subscriptions and check if the message needs to be sent
  */
-int
-MavlinkStream::update(const hrt_abstime &t)
+bool
+MavlinkStream::update_due(const hrt_abstime &t)
 {
 	update_data();
 
+	_due = false;
+
 	// If the message has never been sent before we want
-	// to send it immediately and can return right away
+	// to send it immediately
 	if (_last_sent == 0) {
-		// this will give different messages on the same run a different
-		// initial timestamp which will help spacing them out
-		// on the link scheduling
-		if (send()) {
-			_last_sent = hrt_absolute_time();
-
-			if (!_first_message_sent) {
-				_first_message_sent = true;
-			}
-		}
-
-		return 0;
+		_due = true;
+		return _due;
 	}
 
 	// One of the previous iterations sent the update
 	// already before the deadline
 	if (_last_sent > t) {
-		return -1;
+		return _due;
 	}
 
-	int64_t dt = t - _last_sent;
-	int interval = _interval;
-
-	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
-	}
+	const int64_t dt = t - _last_sent;
+	const int interval = current_interval();
 
 	// We don't need to send anything if the inverval is 0. send() will be called manually.
 	if (interval == 0) {
-		return 0;
+		return _due;
 	}
 
 	const bool unlimited_rate = interval < 0;
@@ -104,27 +139,51 @@ MavlinkStream::update(const hrt_abstime &t)
 	// needs to be accounted for as well.
 	// This method is not theoretically optimal but a suitable
 	// stopgap as it hits its deadlines well (0.5 Hz, 50 Hz and 250 Hz)
+	_due = unlimited_rate || (dt > (interval - (_mavlink->get_main_loop_delay() / 10) * 3));
 
-	if (unlimited_rate || (dt > (interval - (_mavlink->get_main_loop_delay() / 10) * 3))) {
-		// interval expired, send message
+	return _due;
+}
 
-		// If the interval is non-zero and dt is smaller than 1.5 times the interval
-		// do not use the actual time but increment at a fixed rate, so that processing delays do not
-		// distort the average rate. The check of the maximum interval is done to ensure that after a
-		// long time not sending anything, sending multiple messages in a short time is avoided.
-		if (send()) {
-			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+bool
+MavlinkStream::send_due(const hrt_abstime &t)
+{
+	_due = false;
 
-			if (!_first_message_sent) {
-				_first_message_sent = true;
-			}
+	if (_last_sent == 0) {
+		// this will give different messages on the same run a different
+		// initial timestamp which will help spacing them out
+		// on the link scheduling
+		if (send()) {
+			_last_sent = hrt_absolute_time();
+			_first_message_sent = true;
+			return true;
+		}
 
-			return 0;
+		return false;
+	}
 
-		} else {
-			return -1;
-		}
+	const int64_t dt = t - _last_sent;
+	const int interval = current_interval();
+
+	// If the interval is non-zero and dt is smaller than 1.5 times the interval
+	// do not use the actual time but increment at a fixed rate, so that processing delays do not
+	// distort the average rate. The check of the maximum interval is done to ensure that after a
+	// long time not sending anything, sending multiple messages in a short time is avoided.
+	if (send()) {
+		_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+		_first_message_sent = true;
+		return true;
 	}
 
-	return -1;
+	return false;
+}
+
+void
+MavlinkStream::skip_due(const hrt_abstime &t)
+{
+	_due = false;
+
+	if (_last_sent != 0) {
+		_last_sent = t;
+	}
 }
@@ -52,6 +52,13 @@ class MavlinkStream : public ListNode<MavlinkStream *>
 
 public:
 
+	enum class Priority : uint8_t {
+		HIGH = 0,	///< vehicle state and link keep-alive, scaled down last
+		NORMAL,
+		LOW,		///< debug and raw sensor data, decimated first under link pressure
+		COUNT
+	};
+
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream() = default;
 
@@ -76,12 +83,45 @@ public:
 	int get_interval() { return _interval; }
 
 	/**
-	 * @return 0 if updated / sent, -1 if unchanged
+	 * Collect data and check if the stream is due for sending.
+	 *
+	 * Called at every iteration of the mavlink module, followed by send_due() or
+	 * skip_due() for due streams, as decided by the stream scheduler.
+	 *
+	 * @return true if due
+	 */
+	bool update_due(const hrt_abstime &t);
+
+	bool is_due() const { return _due; }
+
+	/**
+	 * Send a due stream.
+	 *
+	 * @return true if sent
+	 */
+	bool send_due(const hrt_abstime &t);
+
+	/**
+	 * Drop the current update of a due stream (decimation), the next one is scheduled one interval from now.
 	 */
-	int update(const hrt_abstime &t);
+	void skip_due(const hrt_abstime &t);
+
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
+	/**
+	 * @return the scheduling priority of the stream when the link is congested
+	 */
+	virtual Priority get_priority() { return default_priority(get_id()); }
+
+	static Priority default_priority(uint16_t msg_id);
+
+	/**
+	 * Deficit round-robin counter in bytes, only used by the stream scheduler.
+	 */
+	unsigned get_deficit() const { return _deficit; }
+	void set_deficit(unsigned deficit) { _deficit = deficit; }
+
 	/**
 	 * @return true if steam rate shouldn't be adjusted
 	 */
@@ -137,7 +177,11 @@ protected:
 	virtual void update_data() { }
 
 private:
+	int current_interval();
+
 	hrt_abstime _last_sent{0};
+	unsigned _deficit{0};
+	bool _due{false};
 	bool _first_message_sent{false};
 };
 
@@ -39,6 +39,8 @@
 #include <stdio.h>
 #include <fcntl.h>
 
+#include <parameters/param.h>
+
 #include "mavlink_ftp_test.h"
 #include "../mavlink_ftp.h"
 
@@ -54,6 +56,9 @@ static const char *_test_files[] = {
 	PX4_MAVLINK_TEST_DATA_DIR  "/" "test_240.data"
 };
 
+static const char *_test_file_large = PX4_MAVLINK_TEST_DATA_DIR  "/" "test_large.data";
+static constexpr int _test_file_large_len = 20000;
+
 constexpr uint32_t MAX_DATA_LEN = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(
 		MavlinkFTP::PayloadHeader);
 
@@ -137,6 +142,8 @@ bool MavlinkFtpTest::_remove_test_files()
 		::unlink(_test_files[i]);
 	}
 
+	::unlink(_test_file_large);
+
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR "/empty_dir");
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR);
 
@@ -551,6 +558,95 @@ bool MavlinkFtpTest::_read_test()
 	return true;
 }
 
+/// @brief Tests Read commands at non sequential offsets (like a GCS filling gaps) across read-ahead boundaries.
+bool MavlinkFtpTest::_read_out_of_order_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+
+	uint8_t *bytes = new uint8_t[_test_file_large_len];
+	ut_assert("new failed", bytes != nullptr);
+
+	for (int i = 0; i < _test_file_large_len; i++) {
+		bytes[i] = (i * 7) & 0xff;
+	}
+
+	int fd = ::open(_test_file_large, O_CREAT | O_TRUNC | O_WRONLY, S_IRWXU | S_IRWXG | S_IRWXO);
+	ut_assert("open failed", fd != -1);
+	int bytes_written = ::write(fd, bytes, _test_file_large_len);
+	::close(fd);
+	ut_compare("write failed", bytes_written, _test_file_large_len);
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(_test_file_large) + 1;
+
+	bool success = _send_receive_msg(&payload, (uint8_t *)_test_file_large, payload.size, &reply);
+
+	if (!success) {
+		delete[] bytes;
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	const uint8_t session = reply->session;
+
+	// read forward, going back every few packets, then jump to the start and the end
+	const uint32_t num_packets = (_test_file_large_len + MAX_DATA_LEN - 1) / MAX_DATA_LEN;
+	uint32_t packets[num_packets + num_packets / 4 + 2];
+	uint32_t num_reads = 0;
+
+	for (uint32_t i = 0; i < num_packets; i++) {
+		packets[num_reads++] = i;
+
+		if ((i % 4 == 3) && (i >= 5)) {
+			packets[num_reads++] = i - 5;
+		}
+	}
+
+	packets[num_reads++] = 0;
+	packets[num_reads++] = num_packets - 1;
+
+	for (uint32_t i = 0; i < num_reads; i++) {
+		payload.opcode = MavlinkFTP::kCmdReadFile;
+		payload.session = session;
+		payload.offset = packets[i] * MAX_DATA_LEN;
+		payload.size = (_test_file_large_len - payload.offset > MAX_DATA_LEN) ? MAX_DATA_LEN : _test_file_large_len -
+			       payload.offset;
+		const uint32_t offset = payload.offset;
+		const uint32_t size = payload.size;
+
+		success = _send_receive_msg(&payload, nullptr, 0, &reply);
+
+		if (!success) {
+			delete[] bytes;
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		ut_compare("Offset incorrect", reply->offset, offset);
+		ut_compare("Payload size incorrect", reply->size, size);
+		ut_compare("Payload content differs", memcmp(reply->data, bytes + offset, reply->size), 0);
+	}
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = session;
+	payload.size = 0;
+
+	success = _send_receive_msg(&payload, nullptr, 0, &reply);
+
+	delete[] bytes;
+	::unlink(_test_file_large);
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 /// @brief Tests for correct reponse to a Read command on an open session.
 bool MavlinkFtpTest::_burst_test()
 {
@@ -856,6 +952,65 @@ bool MavlinkFtpTest::_removefile_test()
 	return true;
 }
 
+/// @brief Tests the download of the generated parameter pack.
+bool MavlinkFtpTest::_param_pack_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	const char				*file = "@PARAM/param.pck";
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(file) + 1;
+
+	bool success = _send_receive_msg(&payload,	// FTP payload header
+					 (uint8_t *)file,	// Data to start into FTP message payload
+					 payload.size,	// size in bytes of data
+					 &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("Reply containing file size wrong", reply->size, sizeof(uint32_t));
+	const uint32_t size = *reinterpret_cast<const uint32_t *>(&reply->data[0]);
+	ut_assert("File too small", size >= 3 * sizeof(uint16_t));
+
+	// read the header
+	payload.opcode = MavlinkFTP::kCmdReadFile;
+	payload.session = reply->session;
+	payload.offset = 0;
+	payload.size = 3 * sizeof(uint16_t);
+
+	success = _send_receive_msg(&payload, nullptr, 0, &reply);
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("Payload size incorrect", reply->size, payload.size);
+	uint16_t header[3];
+	memcpy(header, reply->data, sizeof(header));
+	ut_compare("Magic incorrect", header[0], 0x671b);
+	ut_compare("Parameter count incorrect", header[1], param_count_used());
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = reply->session;
+	payload.size = 0;
+
+	success = _send_receive_msg(&payload, nullptr, 0, &reply);
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 /// Static method used as callback from MavlinkFTP for generic use. This method will be called by MavlinkFTP when
 /// it needs to send a message out on Mavlink.
 void MavlinkFtpTest::receive_message_handler_generic(const mavlink_file_transfer_protocol_t *ftp_req, void *worker_data)
@@ -1016,10 +1171,12 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_terminate_badsession_test);
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
+	ut_run_test(_read_out_of_order_test);
 	ut_run_test(_burst_test);
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
+	ut_run_test(_param_pack_test);
 
 	return (_tests_failed == 0);
 
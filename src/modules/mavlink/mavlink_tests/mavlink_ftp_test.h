@@ -92,10 +92,12 @@ private:
 	bool _terminate_badsession_test(void);
 	bool _read_test(void);
 	bool _read_badsession_test(void);
+	bool _read_out_of_order_test(void);
 	bool _burst_test(void);
 	bool _removedirectory_test(void);
 	bool _createdirectory_test(void);
 	bool _removefile_test(void);
+	bool _param_pack_test(void);
 
 	void _receive_message_handler_generic(const mavlink_file_transfer_protocol_t *ftp_req);
 	bool _setup_ftp_msg(const MavlinkFTP::PayloadHeader *payload_header,
@@ -41,6 +41,7 @@
 #include "mavlink_timesync.h"
 #include "mavlink_main.h"
 
+#include <lib/mathlib/mathlib.h>
 #include <stdlib.h>
 
 MavlinkTimesync::MavlinkTimesync(Mavlink *mavlink) :
@@ -49,7 +50,7 @@ MavlinkTimesync::MavlinkTimesync(Mavlink *mavlink) :
 }
 
 void
-MavlinkTimesync::handle_message(const mavlink_message_t *msg)
+MavlinkTimesync::handle_message(const mavlink_message_t *msg, const hrt_abstime &rx_time)
 {
 	switch (msg->msgid) {
 	case MAVLINK_MSG_ID_TIMESYNC: {
@@ -57,13 +58,12 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 			mavlink_timesync_t tsync = {};
 			mavlink_msg_timesync_decode(msg, &tsync);
 
-			const uint64_t now = hrt_absolute_time();
-
 			if (tsync.tc1 == 0) {			// Message originating from remote system, timestamp and return it
 
 				mavlink_timesync_t rsync;
 
-				rsync.tc1 = now * 1000ULL;
+				// the remote assumes tc1 in the middle of its round trip, split our turnaround time
+				rsync.tc1 = ((rx_time + hrt_absolute_time()) / 2) * 1000ULL;
 				rsync.ts1 = tsync.ts1;
 
 				mavlink_msg_timesync_send_struct(_mavlink->get_channel(), &rsync);
@@ -74,14 +74,17 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 
 				// Calculate time offset between this system and the remote system, assuming RTT for
 				// the timesync packet is roughly equal both ways.
-				int64_t offset_us = (int64_t)((tsync.ts1 / 1000ULL) + now - (tsync.tc1 / 1000ULL) * 2) / 2 ;
+				int64_t offset_us = (int64_t)((tsync.ts1 / 1000ULL) + rx_time - (tsync.tc1 / 1000ULL) * 2) / 2 ;
 
 				// Calculate the round trip time (RTT) it took the timesync packet to bounce back to us from remote system
-				uint64_t rtt_us = now - (tsync.ts1 / 1000ULL);
+				uint64_t rtt_us = rx_time - (tsync.ts1 / 1000ULL);
 
 				// Calculate the difference of this sample from the current estimate
 				uint64_t deviation = llabs((int64_t)_time_offset - offset_us);
 
+				// Track the minimum RTT, slowly following it up if the link got slower
+				_rtt_min = math::min(rtt_us, _rtt_min + RTT_MIN_RISE);
+
 				if (rtt_us < MAX_RTT_SAMPLE) {	// Only use samples with low RTT
 
 					if (sync_converged() && (deviation > MAX_DEVIATION_SAMPLE)) {
@@ -97,6 +100,10 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 							reset_filter();
 						}
 
+					} else if (sync_converged() && is_outlier(rtt_us, deviation)) {
+						// Queuing delay on one leg of the round trip, the sample carries no information about the offset
+						_outlier_count++;
+
 					} else {
 
 						// Filter gain scheduling
@@ -112,6 +119,15 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 							_filter_beta = BETA_GAIN_FINAL;
 						}
 
+						// Track the spread of the samples around the estimate
+						if (sync_converged()) {
+							const double residual = (double)offset_us - (_time_offset + _time_skew);
+							_residual_variance += ACCURACY_GAIN * (residual * residual - _residual_variance);
+
+						} else {
+							_residual_variance = (double)rtt_us * rtt_us / 4.0;
+						}
+
 						// Perform filter update
 						add_sample(offset_us);
 
@@ -123,6 +139,8 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 
 						// Reset high RTT count after filter update
 						_high_rtt_count = 0;
+
+						_outlier_count = 0;
 					}
 
 				} else {
@@ -146,6 +164,7 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 				tsync_status.observed_offset = offset_us;
 				tsync_status.estimated_offset = (int64_t)_time_offset;
 				tsync_status.round_trip_time = rtt_us;
+				tsync_status.estimated_accuracy = sync_converged() ? (uint32_t)sqrt(_residual_variance) : 0;
 
 				_timesync_status_pub.publish(tsync_status);
 			}
@@ -200,6 +219,20 @@ MavlinkTimesync::sync_converged()
 	return _sequence >= CONVERGENCE_WINDOW;
 }
 
+bool
+MavlinkTimesync::is_outlier(uint64_t rtt_us, uint64_t deviation_us) const
+{
+	if (_outlier_count >= MAX_CONSECUTIVE_OUTLIERS) {
+		// don't lock out the filter if the estimate itself is off
+		return false;
+	}
+
+	// the offset error of a sample is bounded by half its round trip time (fully asymmetric delay)
+	const double gate = 0.5 * rtt_us + OUTLIER_SIGMA * sqrt(_residual_variance);
+
+	return (rtt_us > 2 * _rtt_min + RTT_MIN_MARGIN) || (deviation_us > gate);
+}
+
 void
 MavlinkTimesync::add_sample(int64_t offset_us)
 {
@@ -234,5 +267,8 @@ MavlinkTimesync::reset_filter()
 	_filter_beta = BETA_GAIN_INITIAL;
 	_high_deviation_count = 0;
 	_high_rtt_count = 0;
+	_outlier_count = 0;
+	_rtt_min = UINT64_MAX / 2;
+	_residual_variance = 0.0;
 
 }
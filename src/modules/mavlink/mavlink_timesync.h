@@ -92,6 +92,21 @@ static constexpr uint64_t MAX_DEVIATION_SAMPLE = 100_ms;
 static constexpr uint32_t MAX_CONSECUTIVE_HIGH_RTT = 5;
 static constexpr uint32_t MAX_CONSECUTIVE_HIGH_DEVIATION = 5;
 
+// Outlier rejection of converged estimates
+//
+// Timesync samples are only as good as the symmetry of their round trip. Once converged,
+// samples whose RTT is far above the (slowly rising) minimum RTT mostly waited in a queue on
+// one leg and are skipped, as are samples further off the estimate than half their RTT plus
+// OUTLIER_SIGMA times the observed spread. More than MAX_CONSECUTIVE_OUTLIERS in a row are
+// accepted again so that a biased estimate can still recover.
+static constexpr uint64_t RTT_MIN_RISE = 20;	// [us] per sample
+static constexpr uint64_t RTT_MIN_MARGIN = 1_ms;
+static constexpr double OUTLIER_SIGMA = 4.0;
+static constexpr uint32_t MAX_CONSECUTIVE_OUTLIERS = 10;
+
+// Gain of the exponential filter of the squared sample residuals (estimated accuracy)
+static constexpr double ACCURACY_GAIN = 0.05;
+
 class Mavlink;
 
 class MavlinkTimesync
@@ -100,7 +115,10 @@ public:
 	explicit MavlinkTimesync(Mavlink *mavlink);
 	~MavlinkTimesync() = default;
 
-	void handle_message(const mavlink_message_t *msg);
+	/**
+	 * @param rx_time reception time of the message, as early as the link allows
+	 */
+	void handle_message(const mavlink_message_t *msg, const hrt_abstime &rx_time);
 
 	/**
 	 * Convert remote timestamp to local hrt time (usec)
@@ -108,6 +126,12 @@ public:
 	 */
 	uint64_t sync_stamp(uint64_t usec);
 
+	/**
+	 * Return true if the timesync algorithm converged to a good estimate,
+	 * return false otherwise
+	 */
+	bool sync_converged();
+
 private:
 
 	/* do not allow top copying this class */
@@ -122,10 +146,9 @@ protected:
 	void add_sample(int64_t offset_us);
 
 	/**
-	 * Return true if the timesync algorithm converged to a good estimate,
-	 * return false otherwise
+	 * Return true if a sample of a converged filter should be skipped, see OUTLIER_SIGMA
 	 */
-	bool sync_converged();
+	bool is_outlier(uint64_t rtt_us, uint64_t deviation_us) const;
 
 	/**
 	 * Reset the exponential filter and its states
@@ -147,6 +170,10 @@ protected:
 	// Outlier rejection and filter reset
 	uint32_t _high_deviation_count{0};
 	uint32_t _high_rtt_count{0};
+	uint32_t _outlier_count{0};
+
+	uint64_t _rtt_min{UINT64_MAX / 2};	///< [us] minimum round trip time, rises by RTT_MIN_RISE per sample
+	double _residual_variance{0};		///< [us^2] filtered squared deviation of the samples from the estimate
 
 	Mavlink *const _mavlink;
 };
@@ -69,6 +69,7 @@ MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_sys
 MavlinkULog::~MavlinkULog()
 {
 	perf_free(_msg_missed_ulog_stream_perf);
+	perf_free(_msg_retransmitted_perf);
 }
 
 void MavlinkULog::start_ack_received()
@@ -96,45 +97,30 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 		return 0;
 	}
 
-	// check if we're waiting for an ACK
-	if (_last_sent_time) {
-		bool check_for_updates = false;
+	lock();
 
-		if (_ack_received) {
-			_last_sent_time = 0;
-			check_for_updates = true;
+	// retransmit only the messages that were not acked in time
+	const hrt_abstime now = hrt_absolute_time();
 
-		} else {
+	for (int i = 0; i < _pending_count && _current_num_msgs < _max_num_messages; i++) {
+		const int index = (_pending_head + i) % ACK_WINDOW;
+		PendingMessage &pending = _pending[index];
 
-			if (hrt_elapsed_time(&_last_sent_time) > ulog_stream_ack_s::ACK_TIMEOUT * 1000) {
-				if (++_sent_tries > ulog_stream_ack_s::ACK_MAX_TRIES) {
-					return -ETIMEDOUT;
-
-				} else {
-					PX4_DEBUG("re-sending ulog mavlink message (try=%i)", _sent_tries);
-					_last_sent_time = hrt_absolute_time();
-
-					const ulog_stream_s &ulog_data = _ulog_stream_sub.get();
-
-					mavlink_logging_data_acked_t msg;
-					msg.sequence = ulog_data.msg_sequence;
-					msg.length = ulog_data.length;
-					msg.first_message_offset = ulog_data.first_message_offset;
-					msg.target_system = _target_system;
-					msg.target_component = _target_component;
-					memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-					mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-				}
+		if (!pending.acked && (now - pending.sent_time > ulog_stream_ack_s::ACK_TIMEOUT * 1000)) {
+			if (pending.tries >= ulog_stream_ack_s::ACK_MAX_TRIES) {
+				unlock();
+				return -ETIMEDOUT;
 			}
-		}
 
-		if (!check_for_updates) {
-			return 0;
+			PX4_DEBUG("re-sending ulog mavlink message %i (try=%i)", pending.msg.sequence, pending.tries + 1);
+			perf_count(_msg_retransmitted_perf);
+			send_pending(channel, index);
+			++_current_num_msgs;
 		}
 	}
 
-
-	while ((_current_num_msgs < _max_num_messages) && _ulog_stream_sub.updated()) {
+	// the logger keeps at most ACK_WINDOW acked messages in flight, the check is only a safeguard
+	while ((_current_num_msgs < _max_num_messages) && (_pending_count < ACK_WINDOW) && _ulog_stream_sub.updated()) {
 		const unsigned last_generation = _ulog_stream_sub.get_last_generation();
 		_ulog_stream_sub.update();
 
@@ -146,21 +132,19 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 
 		if (ulog_data.timestamp > 0) {
 			if (ulog_data.flags & ulog_stream_s::FLAGS_NEED_ACK) {
-				_sent_tries = 1;
-				_last_sent_time = hrt_absolute_time();
-				lock();
-				_wait_for_ack_sequence = ulog_data.msg_sequence;
-				_ack_received = false;
-				unlock();
-
-				mavlink_logging_data_acked_t msg;
-				msg.sequence = ulog_data.msg_sequence;
-				msg.length = ulog_data.length;
-				msg.first_message_offset = ulog_data.first_message_offset;
-				msg.target_system = _target_system;
-				msg.target_component = _target_component;
-				memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-				mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+				const int index = (_pending_head + _pending_count) % ACK_WINDOW;
+				PendingMessage &pending = _pending[index];
+				pending.msg.sequence = ulog_data.msg_sequence;
+				pending.msg.length = ulog_data.length;
+				pending.msg.first_message_offset = ulog_data.first_message_offset;
+				pending.msg.target_system = _target_system;
+				pending.msg.target_component = _target_component;
+				memcpy(pending.msg.data, ulog_data.data, sizeof(pending.msg.data));
+				pending.tries = 0;
+				pending.acked = false;
+				_pending_count++;
+
+				send_pending(channel, index);
 
 			} else {
 				mavlink_logging_data_t msg;
@@ -177,6 +161,8 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 		++_current_num_msgs;
 	}
 
+	unlock();
+
 	//need to update the rate?
 	hrt_abstime t = hrt_absolute_time();
 
@@ -243,14 +229,41 @@ void MavlinkULog::stop()
 	unlock();
 }
 
+void MavlinkULog::send_pending(mavlink_channel_t channel, int index)
+{
+	PendingMessage &pending = _pending[index];
+	pending.tries++;
+	pending.sent_time = hrt_absolute_time();
+	mavlink_msg_logging_data_acked_send_struct(channel, &pending.msg);
+}
+
 void MavlinkULog::handle_ack(mavlink_logging_ack_t ack)
 {
 	lock();
 
 	if (_instance) { // make sure stop() was not called right before
-		if (_wait_for_ack_sequence == ack.sequence) {
-			_ack_received = true;
-			publish_ack(ack.sequence);
+		for (int i = 0; i < _pending_count; i++) {
+			PendingMessage &pending = _pending[(_pending_head + i) % ACK_WINDOW];
+
+			if (pending.msg.sequence == ack.sequence) {
+				pending.acked = true;
+				break;
+			}
+		}
+
+		// release the acked messages at the start of the window, then ack them cumulatively to the logger
+		bool released = false;
+		uint16_t last_sequence = 0;
+
+		while (_pending_count > 0 && _pending[_pending_head].acked) {
+			last_sequence = _pending[_pending_head].msg.sequence;
+			_pending_head = (_pending_head + 1) % ACK_WINDOW;
+			_pending_count--;
+			released = true;
+		}
+
+		if (released) {
+			publish_ack(last_sequence);
 		}
 	}
 
@@ -122,12 +122,25 @@ private:
 	static MavlinkULog *_instance;
 	static const float _rate_calculation_delta_t; ///< rate update interval
 
+	void send_pending(mavlink_channel_t channel, int index);
+
 	uORB::SubscriptionData<ulog_stream_s> _ulog_stream_sub{ORB_ID(ulog_stream)};
 	uORB::Publication<ulog_stream_ack_s> _ulog_stream_ack_pub{ORB_ID(ulog_stream_ack)};
-	uint16_t _wait_for_ack_sequence;
-	uint8_t _sent_tries = 0;
-	volatile bool _ack_received = false; ///< set to true if a matching ack received
-	hrt_abstime _last_sent_time = 0; ///< last time we sent a message that requires an ack
+
+	/** sent messages that need an ack, kept for retransmission */
+	struct PendingMessage {
+		mavlink_logging_data_acked_t msg;
+		hrt_abstime sent_time;
+		uint8_t tries;
+		bool acked;
+	};
+	static constexpr int ACK_WINDOW = ulog_stream_ack_s::ACK_WINDOW;
+	static_assert(ACK_WINDOW < ulog_stream_s::ORB_QUEUE_LENGTH, "ulog_stream queue too short for the ack window");
+	PendingMessage _pending[ACK_WINDOW] {}; ///< ring buffer, ordered by sequence
+	int _pending_head = 0;
+	int _pending_count = 0;
+
+	hrt_abstime _last_sent_time = 0; ///< used to time out waiting for the initial ack
 	bool _waiting_for_initial_ack = false;
 	const uint8_t _target_system;
 	const uint8_t _target_component;
@@ -139,6 +152,7 @@ private:
 	hrt_abstime _next_rate_check; ///< next timestamp at which to update the rate
 
 	perf_counter_t _msg_missed_ulog_stream_perf{perf_alloc(PC_COUNT, MODULE_NAME": ulog_stream messages missed")};
+	perf_counter_t _msg_retransmitted_perf{perf_alloc(PC_COUNT, MODULE_NAME": ulog messages retransmitted")};
 
 	/* do not allow copying this class */
 	MavlinkULog(const MavlinkULog &) = delete;
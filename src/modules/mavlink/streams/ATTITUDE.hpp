@@ -59,6 +59,9 @@ private:
 	uORB::Subscription _att_sub{ORB_ID(vehicle_attitude)};
 	uORB::Subscription _angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
 
+	using EncodeCache = MavlinkEncodeCache<mavlink_attitude_t>;
+	static EncodeCache _encode_cache; ///< shared by all mavlink instances
+
 	bool send() override
 	{
 		vehicle_attitude_s att;
@@ -69,15 +72,21 @@ private:
 
 			mavlink_attitude_t msg{};
 
-			const matrix::Eulerf euler = matrix::Quatf(att.q);
-			msg.time_boot_ms = att.timestamp / 1000;
-			msg.roll = euler.phi();
-			msg.pitch = euler.theta();
-			msg.yaw = euler.psi();
+			const uint64_t key = EncodeCache::key(_att_sub.get_last_generation(), _angular_velocity_sub.get_last_generation());
+
+			if (!_encode_cache.get(key, msg)) {
+				const matrix::Eulerf euler = matrix::Quatf(att.q);
+				msg.time_boot_ms = att.timestamp / 1000;
+				msg.roll = euler.phi();
+				msg.pitch = euler.theta();
+				msg.yaw = euler.psi();
 
-			msg.rollspeed = angular_velocity.xyz[0];
-			msg.pitchspeed = angular_velocity.xyz[1];
-			msg.yawspeed = angular_velocity.xyz[2];
+				msg.rollspeed = angular_velocity.xyz[0];
+				msg.pitchspeed = angular_velocity.xyz[1];
+				msg.yawspeed = angular_velocity.xyz[2];
+
+				_encode_cache.put(key, msg);
+			}
 
 			mavlink_msg_attitude_send_struct(_mavlink->get_channel(), &msg);
 
@@ -88,4 +97,6 @@ private:
 	}
 };
 
+MavlinkStreamAttitude::EncodeCache MavlinkStreamAttitude::_encode_cache{};
+
 #endif // ATTITUDE_HPP
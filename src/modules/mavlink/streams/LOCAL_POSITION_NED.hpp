@@ -57,6 +57,9 @@ private:
 
 	uORB::Subscription _lpos_sub{ORB_ID(vehicle_local_position)};
 
+	using EncodeCache = MavlinkEncodeCache<mavlink_local_position_ned_t>;
+	static EncodeCache _encode_cache; ///< shared by all mavlink instances
+
 	bool send() override
 	{
 		vehicle_local_position_s lpos;
@@ -65,13 +68,19 @@ private:
 			if (lpos.xy_valid && lpos.v_xy_valid) {
 				mavlink_local_position_ned_t msg{};
 
-				msg.time_boot_ms = lpos.timestamp / 1000;
-				msg.x = lpos.x;
-				msg.y = lpos.y;
-				msg.z = lpos.z;
-				msg.vx = lpos.vx;
-				msg.vy = lpos.vy;
-				msg.vz = lpos.vz;
+				const uint64_t key = EncodeCache::key(_lpos_sub.get_last_generation());
+
+				if (!_encode_cache.get(key, msg)) {
+					msg.time_boot_ms = lpos.timestamp / 1000;
+					msg.x = lpos.x;
+					msg.y = lpos.y;
+					msg.z = lpos.z;
+					msg.vx = lpos.vx;
+					msg.vy = lpos.vy;
+					msg.vz = lpos.vz;
+
+					_encode_cache.put(key, msg);
+				}
 
 				mavlink_msg_local_position_ned_send_struct(_mavlink->get_channel(), &msg);
 
@@ -83,4 +92,6 @@ private:
 	}
 };
 
+MavlinkStreamLocalPositionNED::EncodeCache MavlinkStreamLocalPositionNED::_encode_cache{};
+
 #endif // LOCAL_POSITION_NED_HPP
@@ -211,17 +211,53 @@ MulticopterAttitudeControl::generate_attitude_setpoint(const Quatf &q, float dt,
 	_last_attitude_setpoint = attitude_setpoint.timestamp;
 }
 
+void
+MulticopterAttitudeControl::vtol_suspend_poll()
+{
+	vtol_vehicle_status_s vtol_vehicle_status;
+
+	if (!_vtol_vehicle_status_sub.update(&vtol_vehicle_status)
+	    || (vtol_vehicle_status.mc_control_suspended == _vtol_suspended)) {
+		return;
+	}
+
+	_vtol_suspended = vtol_vehicle_status.mc_control_suspended;
+
+	if (_vtol_suspended) {
+		// only wake up on VTOL state changes
+		_vehicle_attitude_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.registerCallback();
+
+	} else {
+		_vtol_vehicle_status_sub.unregisterCallback();
+		_vehicle_attitude_sub.registerCallback();
+
+		// start from the current state, the latest attitude setpoint is picked up on the next update
+		_reset_yaw_sp = true;
+		_man_x_input_filter.reset(0.f);
+		_man_y_input_filter.reset(0.f);
+	}
+}
+
 void
 MulticopterAttitudeControl::Run()
 {
 	if (should_exit()) {
 		_vehicle_attitude_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
 	perf_begin(_loop_perf);
 
+	vtol_suspend_poll();
+
+	if (_vtol_suspended) {
+		perf_end(_loop_perf);
+		return;
+	}
+
 	// Check if parameters have changed
 	if (_parameter_update_sub.updated()) {
 		// clear update
@@ -304,6 +340,9 @@ MulticopterAttitudeControl::Run()
 
 		bool run_att_ctrl = _vehicle_control_mode.flag_control_attitude_enabled && (is_hovering || is_tailsitter_transition);
 
+		// the rate controller runs the attitude controller itself (MC_ATT_INLINE), only provide the attitude setpoint
+		const bool att_ctrl_inline = _param_mc_att_inline.get() && !_vtol;
+
 		if (run_att_ctrl) {
 
 			// Generate the attitude setpoint from stick inputs if we are in Manual/Stabilized mode
@@ -319,7 +358,9 @@ MulticopterAttitudeControl::Run()
 				_man_x_input_filter.reset(0.f);
 				_man_y_input_filter.reset(0.f);
 			}
+		}
 
+		if (run_att_ctrl && !att_ctrl_inline) {
 			Vector3f rates_sp = _attitude_control.update(q);
 
 			const hrt_abstime now = hrt_absolute_time();
@@ -158,3 +158,18 @@ PARAM_DEFINE_FLOAT(MC_YAWRATE_MAX, 200.0f);
  * @group Multicopter Position Control
  */
 PARAM_DEFINE_FLOAT(MC_MAN_TILT_TAU, 0.0f);
+
+/**
+ * Run the attitude controller inline with the rate controller
+ *
+ * If enabled, mc_rate_control runs the attitude controller at the gyro rate
+ * on the latest attitude estimate propagated with the gyro measurements, and
+ * mc_att_control only generates the attitude setpoints. This removes the
+ * vehicle_rates_setpoint hop and the setpoint latency between attitude updates.
+ * Not used for VTOL.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Multicopter Attitude Control
+ */
+PARAM_DEFINE_INT32(MC_ATT_INLINE, 0);
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file HoverThrustEstimator.cpp
+ *
+ * @author Mathieu Bresciani 	<brescianimathieu@gmail.com>
+ */
+
+#include "HoverThrustEstimator.hpp"
+
+#include <mathlib/mathlib.h>
+
+using namespace time_literals;
+
+HoverThrustEstimator::HoverThrustEstimator(ModuleParams *parent) :
+	ModuleParams(parent)
+{
+	_valid_hysteresis.set_hysteresis_time_from(false, 2_s);
+	updateParams();
+	reset();
+}
+
+void HoverThrustEstimator::reset()
+{
+	_hover_thrust_ekf.setHoverThrust(_param_mpc_thr_hover.get());
+	_hover_thrust_ekf.setHoverThrustStdDev(_param_hte_ht_err_init.get());
+	_hover_thrust_ekf.resetAccelNoise();
+}
+
+void HoverThrustEstimator::updateParams()
+{
+	const float ht_err_init_prev = _param_hte_ht_err_init.get();
+	ModuleParams::updateParams();
+
+	_hover_thrust_ekf.setProcessNoiseStdDev(_param_hte_ht_noise.get());
+
+	if (fabsf(_param_hte_ht_err_init.get() - ht_err_init_prev) > FLT_EPSILON) {
+		_hover_thrust_ekf.setHoverThrustStdDev(_param_hte_ht_err_init.get());
+	}
+
+	_hover_thrust_ekf.setAccelInnovGate(_param_hte_acc_gate.get());
+
+	_hover_thrust_ekf.setMinHoverThrust(math::constrain(_param_mpc_thr_hover.get() - _param_hte_thr_range.get(), 0.f,
+					    0.8f));
+	_hover_thrust_ekf.setMaxHoverThrust(math::constrain(_param_mpc_thr_hover.get() + _param_hte_thr_range.get(), 0.2f,
+					    0.9f));
+}
+
+void HoverThrustEstimator::update(const vehicle_local_position_s &local_pos, float thrust_z, bool armed, bool in_air)
+{
+	const float dt = (local_pos.timestamp - _timestamp_last) * 1e-6f;
+	_timestamp_last = local_pos.timestamp;
+
+	if (armed && in_air && (dt > 0.001f) && (dt < 1.f) && PX4_ISFINITE(local_pos.az)) {
+
+		_hover_thrust_ekf.predict(dt);
+
+		if (PX4_ISFINITE(thrust_z)) {
+			// Inform the hover thrust estimator about the measured vertical
+			// acceleration (positive acceleration is up) and the current thrust (positive thrust is up)
+			// Guard against fast up and down motions biasing the estimator due to large drag and prop wash effects
+			const float meas_noise_coeff_z = fmaxf((fabsf(local_pos.vz) - _param_hte_vz_thr.get()) + 1.f, 1.f);
+			const float meas_noise_coeff_xy = fmaxf((matrix::Vector2f(local_pos.vx,
+								local_pos.vy).norm() - _param_hte_vxy_thr.get()) + 1.f,
+								1.f);
+
+			_hover_thrust_ekf.setMeasurementNoiseScale(fmaxf(meas_noise_coeff_xy, meas_noise_coeff_z));
+			_hover_thrust_ekf.fuseAccZ(-local_pos.az, -thrust_z);
+
+			bool valid = (_hover_thrust_ekf.getHoverThrustEstimateVar() < 0.001f);
+
+			// The test ratio does not need to pass all the time to have a valid estimate
+			if (!_valid) {
+				valid = valid && (_hover_thrust_ekf.getInnovationTestRatio() < 1.f);
+			}
+
+			_valid_hysteresis.set_state_and_update(valid, local_pos.timestamp);
+			_valid = _valid_hysteresis.get_state();
+
+			publishStatus(local_pos.timestamp);
+		}
+
+	} else {
+		_valid_hysteresis.set_state_and_update(false, hrt_absolute_time());
+
+		if (!armed) {
+			reset();
+		}
+
+		if (_valid) {
+			// only publish a single message to invalidate
+			publishInvalidStatus();
+
+			_valid = false;
+		}
+	}
+}
+
+void HoverThrustEstimator::publishStatus(const hrt_abstime &timestamp_sample)
+{
+	hover_thrust_estimate_s status_msg{};
+
+	status_msg.timestamp_sample = timestamp_sample;
+
+	status_msg.hover_thrust = _hover_thrust_ekf.getHoverThrustEstimate();
+	status_msg.hover_thrust_var = _hover_thrust_ekf.getHoverThrustEstimateVar();
+
+	status_msg.accel_innov = _hover_thrust_ekf.getInnovation();
+	status_msg.accel_innov_var = _hover_thrust_ekf.getInnovationVar();
+	status_msg.accel_innov_test_ratio = _hover_thrust_ekf.getInnovationTestRatio();
+	status_msg.accel_noise_var = _hover_thrust_ekf.getAccelNoiseVar();
+
+	status_msg.valid = _valid;
+
+	status_msg.timestamp = hrt_absolute_time();
+
+	_hover_thrust_ekf_pub.publish(status_msg);
+}
+
+void HoverThrustEstimator::publishInvalidStatus()
+{
+	hover_thrust_estimate_s status_msg{};
+
+	status_msg.hover_thrust = NAN;
+	status_msg.hover_thrust_var = NAN;
+	status_msg.accel_innov = NAN;
+	status_msg.accel_innov_var = NAN;
+	status_msg.accel_innov_test_ratio = NAN;
+	status_msg.accel_noise_var = NAN;
+
+	status_msg.timestamp = hrt_absolute_time();
+
+	_hover_thrust_ekf_pub.publish(status_msg);
+}
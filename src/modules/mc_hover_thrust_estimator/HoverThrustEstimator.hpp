@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file HoverThrustEstimator.hpp
+ * @brief Hover thrust estimation from the local position and the thrust setpoint,
+ * used by the mc_hover_thrust_estimator module or directly by the position controller
+ * Convention is positive thrust, hover thrust and acceleration UP
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/hysteresis/hysteresis.h>
+#include <px4_platform_common/module_params.h>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/hover_thrust_estimate.h>
+#include <uORB/topics/vehicle_local_position.h>
+
+#include "zero_order_hover_thrust_ekf.hpp"
+
+class HoverThrustEstimator : public ModuleParams
+{
+public:
+	HoverThrustEstimator(ModuleParams *parent);
+	~HoverThrustEstimator() override = default;
+
+	void reset();
+
+	/**
+	 * Run one estimator step and publish hover_thrust_estimate
+	 * @param local_pos new local position sample
+	 * @param thrust_z vertical thrust setpoint (NED) that produced the acceleration of the sample, NAN if unknown
+	 */
+	void update(const vehicle_local_position_s &local_pos, float thrust_z, bool armed, bool in_air);
+
+	bool valid() const { return _valid; }
+	float getHoverThrustEstimate() const { return _hover_thrust_ekf.getHoverThrustEstimate(); }
+
+private:
+	void updateParams() override;
+	void publishStatus(const hrt_abstime &timestamp_sample);
+	void publishInvalidStatus();
+
+	ZeroOrderHoverThrustEkf _hover_thrust_ekf{};
+
+	uORB::Publication<hover_thrust_estimate_s> _hover_thrust_ekf_pub{ORB_ID(hover_thrust_estimate)};
+
+	hrt_abstime _timestamp_last{0};
+
+	bool _valid{false};
+
+	systemlib::Hysteresis _valid_hysteresis{false};
+
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::HTE_HT_NOISE>) _param_hte_ht_noise,
+		(ParamFloat<px4::params::HTE_ACC_GATE>) _param_hte_acc_gate,
+		(ParamFloat<px4::params::HTE_HT_ERR_INIT>) _param_hte_ht_err_init,
+		(ParamFloat<px4::params::HTE_THR_RANGE>) _param_hte_thr_range,
+		(ParamFloat<px4::params::HTE_VXY_THR>) _param_hte_vxy_thr,
+		(ParamFloat<px4::params::HTE_VZ_THR>) _param_hte_vz_thr,
+		(ParamFloat<px4::params::MPC_THR_HOVER>) _param_mpc_thr_hover
+	)
+};
@@ -39,17 +39,12 @@
 
 #include "MulticopterHoverThrustEstimator.hpp"
 
-#include <mathlib/mathlib.h>
-
 using namespace time_literals;
 
 MulticopterHoverThrustEstimator::MulticopterHoverThrustEstimator() :
 	ModuleParams(nullptr),
 	WorkItem(MODULE_NAME, px4::wq_configurations::nav_and_controllers)
 {
-	_valid_hysteresis.set_hysteresis_time_from(false, 2_s);
-	updateParams();
-	reset();
 }
 
 MulticopterHoverThrustEstimator::~MulticopterHoverThrustEstimator()
@@ -67,32 +62,6 @@ bool MulticopterHoverThrustEstimator::init()
 	return true;
 }
 
-void MulticopterHoverThrustEstimator::reset()
-{
-	_hover_thrust_ekf.setHoverThrust(_param_mpc_thr_hover.get());
-	_hover_thrust_ekf.setHoverThrustStdDev(_param_hte_ht_err_init.get());
-	_hover_thrust_ekf.resetAccelNoise();
-}
-
-void MulticopterHoverThrustEstimator::updateParams()
-{
-	const float ht_err_init_prev = _param_hte_ht_err_init.get();
-	ModuleParams::updateParams();
-
-	_hover_thrust_ekf.setProcessNoiseStdDev(_param_hte_ht_noise.get());
-
-	if (fabsf(_param_hte_ht_err_init.get() - ht_err_init_prev) > FLT_EPSILON) {
-		_hover_thrust_ekf.setHoverThrustStdDev(_param_hte_ht_err_init.get());
-	}
-
-	_hover_thrust_ekf.setAccelInnovGate(_param_hte_acc_gate.get());
-
-	_hover_thrust_ekf.setMinHoverThrust(math::constrain(_param_mpc_thr_hover.get() - _param_hte_thr_range.get(), 0.f,
-					    0.8f));
-	_hover_thrust_ekf.setMaxHoverThrust(math::constrain(_param_mpc_thr_hover.get() + _param_hte_thr_range.get(), 0.2f,
-					    0.9f));
-}
-
 void MulticopterHoverThrustEstimator::Run()
 {
 	if (should_exit()) {
@@ -149,6 +118,11 @@ void MulticopterHoverThrustEstimator::Run()
 		updateParams();
 	}
 
+	// the position controller runs the estimator itself
+	if (_param_mpc_use_hte.get() == 2) {
+		return;
+	}
+
 	perf_begin(_cycle_perf);
 
 	if (_vehicle_status_sub.updated()) {
@@ -159,97 +133,14 @@ void MulticopterHoverThrustEstimator::Run()
 		}
 	}
 
-	const float dt = (local_pos.timestamp - _timestamp_last) * 1e-6f;
-	_timestamp_last = local_pos.timestamp;
-
-	if (_armed && _in_air && (dt > 0.001f) && (dt < 1.f) && PX4_ISFINITE(local_pos.az)) {
-
-		_hover_thrust_ekf.predict(dt);
-
-		vehicle_local_position_setpoint_s local_pos_sp;
-
-		if (_vehicle_local_position_setpoint_sub.copy(&local_pos_sp)) {
-			if (PX4_ISFINITE(local_pos_sp.thrust[2])) {
-				// Inform the hover thrust estimator about the measured vertical
-				// acceleration (positive acceleration is up) and the current thrust (positive thrust is up)
-				// Guard against fast up and down motions biasing the estimator due to large drag and prop wash effects
-				const float meas_noise_coeff_z = fmaxf((fabsf(local_pos.vz) - _param_hte_vz_thr.get()) + 1.f, 1.f);
-				const float meas_noise_coeff_xy = fmaxf((matrix::Vector2f(local_pos.vx,
-									local_pos.vy).norm() - _param_hte_vxy_thr.get()) + 1.f,
-									1.f);
-
-				_hover_thrust_ekf.setMeasurementNoiseScale(fmaxf(meas_noise_coeff_xy, meas_noise_coeff_z));
-				_hover_thrust_ekf.fuseAccZ(-local_pos.az, -local_pos_sp.thrust[2]);
-
-				bool valid = (_hover_thrust_ekf.getHoverThrustEstimateVar() < 0.001f);
-
-				// The test ratio does not need to pass all the time to have a valid estimate
-				if (!_valid) {
-					valid = valid && (_hover_thrust_ekf.getInnovationTestRatio() < 1.f);
-				}
-
-				_valid_hysteresis.set_state_and_update(valid, local_pos.timestamp);
-				_valid = _valid_hysteresis.get_state();
-
-				publishStatus(local_pos.timestamp);
-			}
-		}
-
-	} else {
-		_valid_hysteresis.set_state_and_update(false, hrt_absolute_time());
-
-		if (!_armed) {
-			reset();
-		}
+	vehicle_local_position_setpoint_s local_pos_sp;
+	const float thrust_z = _vehicle_local_position_setpoint_sub.copy(&local_pos_sp) ? local_pos_sp.thrust[2] : NAN;
 
-		if (_valid) {
-			// only publish a single message to invalidate
-			publishInvalidStatus();
-
-			_valid = false;
-		}
-	}
+	_hover_thrust_estimator.update(local_pos, thrust_z, _armed, _in_air);
 
 	perf_end(_cycle_perf);
 }
 
-void MulticopterHoverThrustEstimator::publishStatus(const hrt_abstime &timestamp_sample)
-{
-	hover_thrust_estimate_s status_msg{};
-
-	status_msg.timestamp_sample = timestamp_sample;
-
-	status_msg.hover_thrust = _hover_thrust_ekf.getHoverThrustEstimate();
-	status_msg.hover_thrust_var = _hover_thrust_ekf.getHoverThrustEstimateVar();
-
-	status_msg.accel_innov = _hover_thrust_ekf.getInnovation();
-	status_msg.accel_innov_var = _hover_thrust_ekf.getInnovationVar();
-	status_msg.accel_innov_test_ratio = _hover_thrust_ekf.getInnovationTestRatio();
-	status_msg.accel_noise_var = _hover_thrust_ekf.getAccelNoiseVar();
-
-	status_msg.valid = _valid;
-
-	status_msg.timestamp = hrt_absolute_time();
-
-	_hover_thrust_ekf_pub.publish(status_msg);
-}
-
-void MulticopterHoverThrustEstimator::publishInvalidStatus()
-{
-	hover_thrust_estimate_s status_msg{};
-
-	status_msg.hover_thrust = NAN;
-	status_msg.hover_thrust_var = NAN;
-	status_msg.accel_innov = NAN;
-	status_msg.accel_innov_var = NAN;
-	status_msg.accel_innov_test_ratio = NAN;
-	status_msg.accel_noise_var = NAN;
-
-	status_msg.timestamp = hrt_absolute_time();
-
-	_hover_thrust_ekf_pub.publish(status_msg);
-}
-
 int MulticopterHoverThrustEstimator::task_spawn(int argc, char *argv[])
 {
 	MulticopterHoverThrustEstimator *instance = new MulticopterHoverThrustEstimator();
@@ -42,7 +42,6 @@
 #pragma once
 
 #include <drivers/drv_hrt.h>
-#include <lib/hysteresis/hysteresis.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
@@ -52,14 +51,13 @@
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
-#include <uORB/topics/hover_thrust_estimate.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/vehicle_land_detected.h>
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_local_position_setpoint.h>
 #include <uORB/topics/vehicle_status.h>
 
-#include "zero_order_hover_thrust_ekf.hpp"
+#include "HoverThrustEstimator.hpp"
 
 using namespace time_literals;
 
@@ -86,16 +84,8 @@ public:
 
 private:
 	void Run() override;
-	void updateParams() override;
 
-	void reset();
-
-	void publishStatus(const hrt_abstime &timestamp_sample);
-	void publishInvalidStatus();
-
-	ZeroOrderHoverThrustEkf _hover_thrust_ekf{};
-
-	uORB::Publication<hover_thrust_estimate_s> _hover_thrust_ekf_pub{ORB_ID(hover_thrust_estimate)};
+	HoverThrustEstimator _hover_thrust_estimator{this};
 
 	uORB::SubscriptionCallbackWorkItem _vehicle_local_position_sub{this, ORB_ID(vehicle_local_position)};
 
@@ -105,25 +95,13 @@ private:
 	uORB::Subscription _vehicle_status_sub{ORB_ID(vehicle_status)};
 	uORB::Subscription _vehicle_local_position_setpoint_sub{ORB_ID(vehicle_local_position_setpoint)};
 
-	hrt_abstime _timestamp_last{0};
-
 	bool _armed{false};
 	bool _landed{false};
 	bool _in_air{false};
 
-	bool _valid{false};
-
-	systemlib::Hysteresis _valid_hysteresis{false};
-
 	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time")};
 
 	DEFINE_PARAMETERS(
-		(ParamFloat<px4::params::HTE_HT_NOISE>) _param_hte_ht_noise,
-		(ParamFloat<px4::params::HTE_ACC_GATE>) _param_hte_acc_gate,
-		(ParamFloat<px4::params::HTE_HT_ERR_INIT>) _param_hte_ht_err_init,
-		(ParamFloat<px4::params::HTE_THR_RANGE>) _param_hte_thr_range,
-		(ParamFloat<px4::params::HTE_VXY_THR>) _param_hte_vxy_thr,
-		(ParamFloat<px4::params::HTE_VZ_THR>) _param_hte_vz_thr,
-		(ParamFloat<px4::params::MPC_THR_HOVER>) _param_mpc_thr_hover
+		(ParamInt<px4::params::MPC_USE_HTE>) _param_mpc_use_hte
 	)
 };
@@ -330,17 +330,42 @@ void MulticopterPositionControl::Run()
 		return;
 	}
 
-	// reschedule backup
-	ScheduleDelayed(100_ms);
+	// reschedule backup, the interpolation interval takes its place if enabled
+	if (_interpolation_rate == 0) {
+		ScheduleDelayed(100_ms);
+	}
 
 	parameters_update(false);
 
+	if (_param_mpc_interp_rate.get() != _interpolation_rate) {
+		_interpolation_rate = math::max(_param_mpc_interp_rate.get(), (int32_t)0);
+
+		if (_interpolation_rate > 0) {
+			ScheduleOnInterval(1_s / _interpolation_rate);
+
+		} else {
+			ScheduleDelayed(100_ms);
+		}
+	}
+
 	perf_begin(_cycle_perf);
 	vehicle_local_position_s vehicle_local_position;
+	bool control_update = false;
+	bool estimator_update = false;
 
 	if (_local_pos_sub.update(&vehicle_local_position)) {
+		_vehicle_local_position = vehicle_local_position;
+		control_update = true;
+		estimator_update = true;
+
+	} else if (_interpolation_rate > 0) {
+		// control step in between estimator updates
+		control_update = predict_local_position(hrt_absolute_time(), vehicle_local_position);
+	}
+
+	if (control_update) {
 		const float dt =
-			math::constrain(((vehicle_local_position.timestamp_sample - _time_stamp_last_loop) * 1e-6f), 0.002f, 0.04f);
+			math::constrain(((int64_t)(vehicle_local_position.timestamp_sample - _time_stamp_last_loop) * 1e-6f), 0.002f, 0.04f);
 		_time_stamp_last_loop = vehicle_local_position.timestamp_sample;
 
 		// set _dt in controllib Block for BlockDerivative
@@ -362,7 +387,24 @@ void MulticopterPositionControl::Run()
 
 		_vehicle_land_detected_sub.update(&_vehicle_land_detected);
 
-		if (_param_mpc_use_hte.get()) {
+		if (_param_mpc_use_hte.get() == 2) {
+#if defined(CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR)
+
+			// run the hover thrust estimator on the same local position sample, without the lag of a separate module
+			if (estimator_update) {
+				const bool in_air = (_takeoff.getTakeoffState() >= TakeoffState::flight)
+						    && !_vehicle_land_detected.landed && !_vehicle_land_detected.ground_contact;
+
+				_hover_thrust_estimator.update(vehicle_local_position, _thrust_sp_z_last, _vehicle_control_mode.flag_armed, in_air);
+
+				if (_hover_thrust_estimator.valid()) {
+					_control.updateHoverThrust(_hover_thrust_estimator.getHoverThrustEstimate());
+				}
+			}
+
+#endif // CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR
+
+		} else if (_param_mpc_use_hte.get()) {
 			hover_thrust_estimate_s hte;
 
 			if (_hover_thrust_estimate_sub.update(&hte)) {
@@ -388,6 +430,8 @@ void MulticopterPositionControl::Run()
 				_setpoint.acceleration[2] = trajectory_setpoint.acceleration[2];
 				_setpoint.yaw = trajectory_setpoint.yaw;
 				_setpoint.yawspeed = trajectory_setpoint.yawspeed;
+				_setpoint_jerk = Vector3f(trajectory_setpoint.jerk);
+				_trajectory_setpoint_timestamp = trajectory_setpoint.timestamp;
 			}
 		}
 
@@ -541,7 +585,7 @@ void MulticopterPositionControl::Run()
 				math::min(speed_up, _param_mpc_z_vel_max_up.get()), // takeoff ramp starts with negative velocity limit
 				math::max(speed_down, 0.f));
 
-			_control.setInputSetpoint(_setpoint);
+			_control.setInputSetpoint(_interpolation_rate > 0 ? extrapolate_setpoint(hrt_absolute_time()) : _setpoint);
 
 			// update states
 			if (!PX4_ISFINITE(_setpoint.z)
@@ -576,6 +620,10 @@ void MulticopterPositionControl::Run()
 			local_pos_sp.timestamp = hrt_absolute_time();
 			_local_pos_sp_pub.publish(local_pos_sp);
 
+#if defined(CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR)
+			_thrust_sp_z_last = local_pos_sp.thrust[2];
+#endif // CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR
+
 			// Publish attitude setpoint output
 			vehicle_attitude_setpoint_s attitude_setpoint{};
 			_control.getAttitudeSetpoint(attitude_setpoint);
@@ -603,6 +651,87 @@ void MulticopterPositionControl::Run()
 	perf_end(_cycle_perf);
 }
 
+bool MulticopterPositionControl::predict_local_position(const hrt_abstime &now,
+		vehicle_local_position_s &local_pos) const
+{
+	const hrt_abstime interval = 1_s / _interpolation_rate;
+
+	if ((_vehicle_local_position.timestamp == 0) || (now < _vehicle_local_position.timestamp)
+	    || (now - _vehicle_local_position.timestamp > 50_ms)) {
+		return false;
+	}
+
+	local_pos = _vehicle_local_position;
+	const hrt_abstime dt_us = now - _vehicle_local_position.timestamp;
+	local_pos.timestamp += dt_us;
+	local_pos.timestamp_sample += dt_us;
+
+	// skip steps too close to the previous one (e.g. right after an estimator update)
+	if (local_pos.timestamp_sample < _time_stamp_last_loop + math::max(interval / 2, (hrt_abstime)2_ms)) {
+		return false;
+	}
+
+	const float dt = dt_us * 1e-6f;
+
+	if (local_pos.v_xy_valid && PX4_ISFINITE(local_pos.ax) && PX4_ISFINITE(local_pos.ay)) {
+		local_pos.x += (local_pos.vx + 0.5f * local_pos.ax * dt) * dt;
+		local_pos.y += (local_pos.vy + 0.5f * local_pos.ay * dt) * dt;
+		local_pos.vx += local_pos.ax * dt;
+		local_pos.vy += local_pos.ay * dt;
+	}
+
+	if (local_pos.v_z_valid && PX4_ISFINITE(local_pos.az)) {
+		local_pos.z += (local_pos.vz + 0.5f * local_pos.az * dt) * dt;
+		local_pos.vz += local_pos.az * dt;
+		local_pos.z_deriv += local_pos.az * dt;
+	}
+
+	return true;
+}
+
+vehicle_local_position_setpoint_s MulticopterPositionControl::extrapolate_setpoint(const hrt_abstime &now) const
+{
+	vehicle_local_position_setpoint_s setpoint = _setpoint;
+
+	// only the trajectory setpoint as published describes a (locally) constant jerk trajectory
+	if ((_setpoint.timestamp != _trajectory_setpoint_timestamp) || (now <= _setpoint.timestamp)) {
+		return setpoint;
+	}
+
+	// stop extrapolating a stale setpoint
+	const float dt = math::min((now - _setpoint.timestamp) * 1e-6f, 0.05f);
+
+	float *position[3] {&setpoint.x, &setpoint.y, &setpoint.z};
+	float *velocity[3] {&setpoint.vx, &setpoint.vy, &setpoint.vz};
+
+	for (int i = 0; i < 3; i++) {
+		const float acc = setpoint.acceleration[i];
+		const float jerk = PX4_ISFINITE(_setpoint_jerk(i)) ? _setpoint_jerk(i) : 0.f;
+
+		if (!PX4_ISFINITE(*velocity[i])) {
+			continue;
+		}
+
+		if (PX4_ISFINITE(acc)) {
+			if (PX4_ISFINITE(*position[i])) {
+				*position[i] += (*velocity[i] + (acc / 2.f + jerk * dt / 6.f) * dt) * dt;
+			}
+
+			*velocity[i] += (acc + jerk * dt / 2.f) * dt;
+			setpoint.acceleration[i] += jerk * dt;
+
+		} else if (PX4_ISFINITE(*position[i])) {
+			*position[i] += *velocity[i] * dt;
+		}
+	}
+
+	if (PX4_ISFINITE(setpoint.yaw) && PX4_ISFINITE(setpoint.yawspeed)) {
+		setpoint.yaw = wrap_pi(setpoint.yaw + setpoint.yawspeed * dt);
+	}
+
+	return setpoint;
+}
+
 vehicle_local_position_setpoint_s MulticopterPositionControl::generateFailsafeSetpoint(const hrt_abstime &now,
 		const PositionControlStates &states)
 {
@@ -65,6 +65,10 @@
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_local_position_setpoint.h>
 
+#if defined(CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR)
+#include <modules/mc_hover_thrust_estimator/HoverThrustEstimator.hpp>
+#endif // CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR
+
 using namespace time_literals;
 
 class MulticopterPositionControl : public ModuleBase<MulticopterPositionControl>, public control::SuperBlock,
@@ -112,6 +116,11 @@ private:
 	vehicle_local_position_setpoint_s _setpoint {};
 	vehicle_control_mode_s _vehicle_control_mode {};
 
+	vehicle_local_position_s _vehicle_local_position{};	/**< last estimator update, base of the predicted states in between */
+	matrix::Vector3f _setpoint_jerk{};			/**< jerk of the last trajectory setpoint */
+	hrt_abstime _trajectory_setpoint_timestamp{0};
+	int32_t _interpolation_rate{0};				/**< currently scheduled MPC_INTERP_RATE */
+
 	vehicle_constraints_s _vehicle_constraints {
 		.timestamp = 0,
 		.speed_up = NAN,
@@ -144,7 +153,8 @@ private:
 		(ParamFloat<px4::params::MPC_Z_VEL_MAX_DN>) _param_mpc_z_vel_max_dn,
 		(ParamFloat<px4::params::MPC_TILTMAX_AIR>)  _param_mpc_tiltmax_air,
 		(ParamFloat<px4::params::MPC_THR_HOVER>)    _param_mpc_thr_hover,
-		(ParamBool<px4::params::MPC_USE_HTE>)       _param_mpc_use_hte,
+		(ParamInt<px4::params::MPC_USE_HTE>)        _param_mpc_use_hte,
+		(ParamInt<px4::params::MPC_INTERP_RATE>)    _param_mpc_interp_rate,
 
 		// Takeoff / Land
 		(ParamFloat<px4::params::COM_SPOOLUP_TIME>) _param_com_spoolup_time, /**< time to let motors spool up after arming */
@@ -188,6 +198,11 @@ private:
 
 	bool _hover_thrust_initialized{false};
 
+#if defined(CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR)
+	HoverThrustEstimator _hover_thrust_estimator{this}; ///< used instead of the module if MPC_USE_HTE is 2 (inline)
+	float _thrust_sp_z_last{NAN}; ///< thrust setpoint that produced the acceleration of the next local position sample
+#endif // CONFIG_MODULES_MC_HOVER_THRUST_ESTIMATOR
+
 	/** Timeout in us for trajectory data to get considered invalid */
 	static constexpr uint64_t TRAJECTORY_STREAM_TIMEOUT_US = 500_ms;
 
@@ -218,6 +233,18 @@ private:
 	 */
 	PositionControlStates set_vehicle_states(const vehicle_local_position_s &local_pos);
 
+	/**
+	 * Predict the last estimator update forward by the time since it was received,
+	 * using the estimated acceleration. Used for the control steps in between estimator updates.
+	 * @return false if there is no recent enough estimate
+	 */
+	bool predict_local_position(const hrt_abstime &now, vehicle_local_position_s &local_pos) const;
+
+	/**
+	 * Advance the trajectory setpoint along its constant jerk segment to the current time.
+	 */
+	vehicle_local_position_setpoint_s extrapolate_setpoint(const hrt_abstime &now) const;
+
 	/**
 	 * Generate setpoint to bridge no executable setpoint being available.
 	 * Used to handle transitions where no proper setpoint was generated yet and when the received setpoint is invalid.
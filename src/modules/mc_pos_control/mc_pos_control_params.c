@@ -77,10 +77,14 @@ PARAM_DEFINE_FLOAT(MPC_THR_HOVER, 0.5f);
 /**
  * Hover thrust source selector
  *
- * Set false to use the fixed parameter MPC_THR_HOVER
- * Set true to use the value computed by the hover thrust estimator
+ * Fixed uses the parameter MPC_THR_HOVER.
+ * Estimator uses the value computed by the hover thrust estimator module.
+ * Inline runs the hover thrust estimator inside the position controller on the same
+ * local position sample, which removes the lag of the estimator module (which then idles).
  *
- * @boolean
+ * @value 0 Fixed
+ * @value 1 Estimator
+ * @value 2 Inline
  * @group Multicopter Position Control
  */
 PARAM_DEFINE_INT32(MPC_USE_HTE, 1);
@@ -876,3 +880,20 @@ PARAM_DEFINE_FLOAT(MPC_XY_VEL_ALL, -10.0f);
  * @group Multicopter Position Control
  */
 PARAM_DEFINE_FLOAT(MPC_Z_VEL_ALL, -3.0f);
+
+/**
+ * Position control interpolation rate
+ *
+ * If set, the position controller additionally runs at this rate in between
+ * the estimator updates. These steps use the last position estimate predicted
+ * forward with the estimated acceleration, and the trajectory setpoint advanced
+ * along its jerk limited trajectory. The setpoint is extrapolated in all control
+ * steps then, including the ones on estimator updates.
+ * Set to 0 to only run on estimator updates.
+ *
+ * @unit Hz
+ * @min 0
+ * @max 400
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_INT32(MPC_INTERP_RATE, 0);
@@ -47,7 +47,8 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 	ModuleParams(nullptr),
 	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
 	_actuator_controls_0_pub(vtol ? ORB_ID(actuator_controls_virtual_mc) : ORB_ID(actuator_controls_0)),
-	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
+	_offboard_latency_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": offboard setpoint latency"))
 {
 	_vehicle_status.vehicle_type = vehicle_status_s::VEHICLE_TYPE_ROTARY_WING;
 
@@ -58,12 +59,14 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 MulticopterRateControl::~MulticopterRateControl()
 {
 	perf_free(_loop_perf);
+	perf_free(_offboard_latency_perf);
 }
 
 bool
 MulticopterRateControl::init()
 {
-	if (!_vehicle_angular_velocity_sub.registerCallback()) {
+	// every run should finish within one gyro period
+	if (!_vehicle_angular_velocity_sub.registerCallback(1_s / math::max(_param_imu_gyro_ratemax.get(), (int32_t)50))) {
 		PX4_ERR("callback registration failed");
 		return false;
 	}
@@ -94,6 +97,115 @@ MulticopterRateControl::parameters_updated()
 	// manual rate control acro mode rate limits
 	_acro_rate_max = Vector3f(radians(_param_mc_acro_r_max.get()), radians(_param_mc_acro_p_max.get()),
 				  radians(_param_mc_acro_y_max.get()));
+
+	// attitude control parameters (same as mc_att_control)
+	_attitude_control.setProportionalGain(Vector3f(_param_mc_roll_p.get(), _param_mc_pitch_p.get(), _param_mc_yaw_p.get()),
+					      _param_mc_yaw_weight.get());
+	_attitude_control.setRateLimit(Vector3f(radians(_param_mc_rollrate_max.get()), radians(_param_mc_pitchrate_max.get()),
+						radians(_param_mc_yawrate_max.get())));
+}
+
+bool
+MulticopterRateControl::updateAttitudeControl(const vehicle_angular_velocity_s &angular_velocity)
+{
+	// Check for new attitude setpoint
+	if (_vehicle_attitude_setpoint_sub.updated()) {
+		vehicle_attitude_setpoint_s vehicle_attitude_setpoint;
+
+		if (_vehicle_attitude_setpoint_sub.copy(&vehicle_attitude_setpoint)
+		    && (vehicle_attitude_setpoint.timestamp > _last_attitude_setpoint)) {
+
+			_attitude_control.setAttitudeSetpoint(Quatf(vehicle_attitude_setpoint.q_d), vehicle_attitude_setpoint.yaw_sp_move_rate);
+			_thrust_setpoint = Vector3f(vehicle_attitude_setpoint.thrust_body);
+			_last_attitude_setpoint = vehicle_attitude_setpoint.timestamp;
+		}
+	}
+
+	vehicle_attitude_s v_att;
+
+	if (_vehicle_attitude_sub.update(&v_att)) {
+		_attitude = Quatf(v_att.q);
+		_attitude_timestamp_sample = v_att.timestamp_sample;
+
+		// Check for a heading reset
+		if (_quat_reset_counter != v_att.quat_reset_counter) {
+			if (v_att.timestamp > _last_attitude_setpoint) {
+				// adapt existing attitude setpoint unless it was generated after the current attitude estimate
+				_attitude_control.adaptAttitudeSetpoint(Quatf(v_att.delta_q_reset));
+			}
+
+			_quat_reset_counter = v_att.quat_reset_counter;
+		}
+	}
+
+	if ((_attitude_timestamp_sample == 0) || (_last_attitude_setpoint == 0)
+	    || (angular_velocity.timestamp_sample > _attitude_timestamp_sample + 100_ms)) {
+		// no (recent) attitude estimate or setpoint
+		return false;
+	}
+
+	// propagate the attitude to the current gyro sample
+	if (angular_velocity.timestamp_sample > _attitude_timestamp_sample) {
+		const float dt = (angular_velocity.timestamp_sample - _attitude_timestamp_sample) * 1e-6f;
+		_attitude = (_attitude * Quatf(AxisAnglef(Vector3f(angular_velocity.xyz) * dt))).normalized();
+		_attitude_timestamp_sample = angular_velocity.timestamp_sample;
+	}
+
+	_rates_setpoint = _attitude_control.update(_attitude);
+
+	autotune_attitude_control_status_s pid_autotune;
+
+	if (_autotune_attitude_control_status_sub.copy(&pid_autotune)) {
+		if ((pid_autotune.state == autotune_attitude_control_status_s::STATE_ROLL
+		     || pid_autotune.state == autotune_attitude_control_status_s::STATE_PITCH
+		     || pid_autotune.state == autotune_attitude_control_status_s::STATE_YAW
+		     || pid_autotune.state == autotune_attitude_control_status_s::STATE_TEST)
+		    && ((hrt_absolute_time() - pid_autotune.timestamp) < 1_s)) {
+			_rates_setpoint += Vector3f(pid_autotune.rate_sp);
+		}
+	}
+
+	// publish rate setpoint (for logging)
+	vehicle_rates_setpoint_s vehicle_rates_setpoint{};
+	vehicle_rates_setpoint.roll = _rates_setpoint(0);
+	vehicle_rates_setpoint.pitch = _rates_setpoint(1);
+	vehicle_rates_setpoint.yaw = _rates_setpoint(2);
+	_thrust_setpoint.copyTo(vehicle_rates_setpoint.thrust_body);
+	vehicle_rates_setpoint.timestamp = hrt_absolute_time();
+	_vehicle_rates_setpoint_pub.publish(vehicle_rates_setpoint);
+
+	return true;
+}
+
+void
+MulticopterRateControl::updateVtolSuspension()
+{
+	vtol_vehicle_status_s vtol_vehicle_status;
+
+	if (!_vtol_vehicle_status_sub.update(&vtol_vehicle_status)
+	    || (vtol_vehicle_status.mc_control_suspended == _vtol_suspended)) {
+		return;
+	}
+
+	_vtol_suspended = vtol_vehicle_status.mc_control_suspended;
+
+	if (_vtol_suspended) {
+		// only wake up on VTOL state changes, zero the outputs so that the next transition doesn't start from stale values
+		_vehicle_angular_velocity_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.registerCallback();
+
+		actuator_controls_s actuators{};
+		actuators.timestamp = hrt_absolute_time();
+		_actuator_controls_0_pub.publish(actuators);
+
+	} else {
+		_vtol_vehicle_status_sub.unregisterCallback();
+		_vehicle_angular_velocity_sub.registerCallback();
+
+		// start from the current state
+		_rate_control.resetIntegral();
+		_last_run = 0;
+	}
 }
 
 void
@@ -101,12 +213,20 @@ MulticopterRateControl::Run()
 {
 	if (should_exit()) {
 		_vehicle_angular_velocity_sub.unregisterCallback();
+		_vtol_vehicle_status_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
 	perf_begin(_loop_perf);
 
+	updateVtolSuspension();
+
+	if (_vtol_suspended) {
+		perf_end(_loop_perf);
+		return;
+	}
+
 	// Check if parameters have changed
 	if (_parameter_update_sub.updated()) {
 		// clear update
@@ -195,12 +315,18 @@ MulticopterRateControl::Run()
 				_vehicle_rates_setpoint_pub.publish(vehicle_rates_setpoint);
 			}
 
+		} else if (_param_mc_att_inline.get() && _vehicle_control_mode.flag_control_attitude_enabled
+			   && !_vehicle_status.is_vtol && (_vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING)
+			   && updateAttitudeControl(angular_velocity)) {
+			// attitude controller run inline, _rates_setpoint and _thrust_setpoint updated
+
 		} else if (_vehicle_rates_setpoint_sub.update(&vehicle_rates_setpoint)) {
 			if (_vehicle_rates_setpoint_sub.copy(&vehicle_rates_setpoint)) {
 				_rates_setpoint(0) = PX4_ISFINITE(vehicle_rates_setpoint.roll)  ? vehicle_rates_setpoint.roll  : rates(0);
 				_rates_setpoint(1) = PX4_ISFINITE(vehicle_rates_setpoint.pitch) ? vehicle_rates_setpoint.pitch : rates(1);
 				_rates_setpoint(2) = PX4_ISFINITE(vehicle_rates_setpoint.yaw)   ? vehicle_rates_setpoint.yaw   : rates(2);
 				_thrust_setpoint = Vector3f(vehicle_rates_setpoint.thrust_body);
+				_rates_setpoint_timestamp_sample = vehicle_rates_setpoint.timestamp_sample;
 			}
 		}
 
@@ -238,10 +364,12 @@ MulticopterRateControl::Run()
 			const Vector3f att_control = _rate_control.update(rates, _rates_setpoint, angular_accel, dt, _maybe_landed || _landed);
 
 			// publish rate controller status
-			rate_ctrl_status_s rate_ctrl_status{};
-			_rate_control.getRateControlStatus(rate_ctrl_status);
-			rate_ctrl_status.timestamp = hrt_absolute_time();
-			_controller_status_pub.publish(rate_ctrl_status);
+			if (_controller_status_pub.has_subscribers()) {
+				rate_ctrl_status_s rate_ctrl_status{};
+				_rate_control.getRateControlStatus(rate_ctrl_status);
+				rate_ctrl_status.timestamp = hrt_absolute_time();
+				_controller_status_pub.publish(rate_ctrl_status);
+			}
 
 			// publish actuator controls
 			actuator_controls_s actuators{};
@@ -254,7 +382,7 @@ MulticopterRateControl::Run()
 			actuators.timestamp_sample = angular_velocity.timestamp_sample;
 
 			if (!_vehicle_status.is_vtol) {
-				publishTorqueSetpoint(att_control, angular_velocity.timestamp_sample);
+				publishTorqueSetpoint(att_control, angular_velocity);
 				publishThrustSetpoint(angular_velocity.timestamp_sample);
 			}
 
@@ -278,6 +406,12 @@ MulticopterRateControl::Run()
 			actuators.timestamp = hrt_absolute_time();
 			_actuator_controls_0_pub.publish(actuators);
 
+			// external setpoint reception -> first actuator output using it
+			if (_rates_setpoint_timestamp_sample != 0) {
+				perf_set_elapsed(_offboard_latency_perf, actuators.timestamp - _rates_setpoint_timestamp_sample);
+				_rates_setpoint_timestamp_sample = 0;
+			}
+
 			updateActuatorControlsStatus(actuators, dt);
 
 		} else if (_vehicle_control_mode.flag_control_termination_enabled) {
@@ -293,11 +427,13 @@ MulticopterRateControl::Run()
 	perf_end(_loop_perf);
 }
 
-void MulticopterRateControl::publishTorqueSetpoint(const Vector3f &torque_sp, const hrt_abstime &timestamp_sample)
+void MulticopterRateControl::publishTorqueSetpoint(const Vector3f &torque_sp,
+		const vehicle_angular_velocity_s &angular_velocity)
 {
 	vehicle_torque_setpoint_s vehicle_torque_setpoint{};
 	vehicle_torque_setpoint.timestamp = hrt_absolute_time();
-	vehicle_torque_setpoint.timestamp_sample = timestamp_sample;
+	vehicle_torque_setpoint.timestamp_sample = angular_velocity.timestamp_sample;
+	vehicle_torque_setpoint.timestamp_angular_velocity = angular_velocity.timestamp;
 	vehicle_torque_setpoint.xyz[0] = (PX4_ISFINITE(torque_sp(0))) ? torque_sp(0) : 0.0f;
 	vehicle_torque_setpoint.xyz[1] = (PX4_ISFINITE(torque_sp(1))) ? torque_sp(1) : 0.0f;
 	vehicle_torque_setpoint.xyz[2] = (PX4_ISFINITE(torque_sp(2))) ? torque_sp(2) : 0.0f;
@@ -37,17 +37,20 @@
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
+#include <px4_platform_common/hot_section.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <lib/systemlib/mavlink_log.h>
+#include <AttitudeControl.hpp>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_controls_status.h>
+#include <uORB/topics/autotune_attitude_control_status.h>
 #include <uORB/topics/battery_status.h>
 #include <uORB/topics/control_allocator_status.h>
 #include <uORB/topics/landing_gear.h>
@@ -56,10 +59,13 @@
 #include <uORB/topics/rate_ctrl_status.h>
 #include <uORB/topics/vehicle_angular_acceleration.h>
 #include <uORB/topics/vehicle_angular_velocity.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_attitude_setpoint.h>
 #include <uORB/topics/vehicle_control_mode.h>
 #include <uORB/topics/vehicle_land_detected.h>
 #include <uORB/topics/vehicle_rates_setpoint.h>
 #include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/vtol_vehicle_status.h>
 #include <uORB/topics/vehicle_thrust_setpoint.h>
 #include <uORB/topics/vehicle_torque_setpoint.h>
 
@@ -83,7 +89,7 @@ public:
 	bool init();
 
 private:
-	void Run() override;
+	PX4_HOT void Run() override;
 
 	/**
 	 * initialize some vectors/matrices from parameters
@@ -92,16 +98,31 @@ private:
 
 	void updateActuatorControlsStatus(const actuator_controls_s &actuators, float dt);
 
-	void publishTorqueSetpoint(const matrix::Vector3f &torque_sp, const hrt_abstime &timestamp_sample);
+	void publishTorqueSetpoint(const matrix::Vector3f &torque_sp, const vehicle_angular_velocity_s &angular_velocity);
 	void publishThrustSetpoint(const hrt_abstime &timestamp_sample);
 
+	/**
+	 * Run the attitude controller on the latest attitude estimate propagated with the gyro (MC_ATT_INLINE).
+	 * @return true if _rates_setpoint and _thrust_setpoint were updated
+	 */
+	bool updateAttitudeControl(const vehicle_angular_velocity_s &angular_velocity);
+
+	/**
+	 * VTOL: stop running on gyro updates while vtol_att_control doesn't use the outputs (VT_CTRL_SUSPEND)
+	 */
+	void updateVtolSuspension();
+
 	RateControl _rate_control; ///< class for rate control calculations
+	AttitudeControl _attitude_control; ///< attitude controller, only used with MC_ATT_INLINE
 
+	uORB::Subscription _autotune_attitude_control_status_sub{ORB_ID(autotune_attitude_control_status)};
 	uORB::Subscription _battery_status_sub{ORB_ID(battery_status)};
 	uORB::Subscription _control_allocator_status_sub{ORB_ID(control_allocator_status)};
 	uORB::Subscription _landing_gear_sub{ORB_ID(landing_gear)};
 	uORB::Subscription _manual_control_setpoint_sub{ORB_ID(manual_control_setpoint)};
 	uORB::Subscription _vehicle_angular_acceleration_sub{ORB_ID(vehicle_angular_acceleration)};
+	uORB::Subscription _vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
+	uORB::Subscription _vehicle_attitude_setpoint_sub{ORB_ID(vehicle_attitude_setpoint)};
 	uORB::Subscription _vehicle_control_mode_sub{ORB_ID(vehicle_control_mode)};
 	uORB::Subscription _vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
 	uORB::Subscription _vehicle_rates_setpoint_sub{ORB_ID(vehicle_rates_setpoint)};
@@ -110,6 +131,7 @@ private:
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
 	uORB::SubscriptionCallbackWorkItem _vehicle_angular_velocity_sub{this, ORB_ID(vehicle_angular_velocity)};
+	uORB::SubscriptionCallbackWorkItem _vtol_vehicle_status_sub{this, ORB_ID(vtol_vehicle_status)}; // wakeup while suspended
 
 	uORB::Publication<actuator_controls_s>		_actuator_controls_0_pub;
 	uORB::Publication<actuator_controls_status_s>	_actuator_controls_status_0_pub{ORB_ID(actuator_controls_status_0)};
@@ -125,10 +147,19 @@ private:
 
 	bool _landed{true};
 	bool _maybe_landed{true};
+	bool _vtol_suspended{false};
 
 	hrt_abstime _last_run{0};
 
+	matrix::Quatf _attitude{};			/**< latest attitude estimate, propagated with the gyro */
+	hrt_abstime _attitude_timestamp_sample{0};	/**< sample time of _attitude */
+	hrt_abstime _last_attitude_setpoint{0};
+	uint8_t _quat_reset_counter{0};
+
 	perf_counter_t	_loop_perf;			/**< loop duration performance counter */
+	perf_counter_t	_offboard_latency_perf;		/**< offboard setpoint reception to actuator output */
+
+	hrt_abstime _rates_setpoint_timestamp_sample{0};	/**< reception time of a not yet applied offboard setpoint */
 
 	// keep setpoint values between updates
 	matrix::Vector3f _acro_rate_max;		/**< max attitude rates in acro mode */
@@ -174,6 +205,17 @@ private:
 		(ParamFloat<px4::params::MC_ACRO_SUPEXPO>) _param_mc_acro_supexpo,		/**< superexpo stick curve shape (roll & pitch) */
 		(ParamFloat<px4::params::MC_ACRO_SUPEXPOY>) _param_mc_acro_supexpoy,		/**< superexpo stick curve shape (yaw) */
 
-		(ParamBool<px4::params::MC_BAT_SCALE_EN>) _param_mc_bat_scale_en
+		(ParamBool<px4::params::MC_BAT_SCALE_EN>) _param_mc_bat_scale_en,
+
+		(ParamBool<px4::params::MC_ATT_INLINE>) _param_mc_att_inline,
+		(ParamFloat<px4::params::MC_ROLL_P>) _param_mc_roll_p,
+		(ParamFloat<px4::params::MC_PITCH_P>) _param_mc_pitch_p,
+		(ParamFloat<px4::params::MC_YAW_P>) _param_mc_yaw_p,
+		(ParamFloat<px4::params::MC_YAW_WEIGHT>) _param_mc_yaw_weight,
+		(ParamFloat<px4::params::MC_ROLLRATE_MAX>) _param_mc_rollrate_max,
+		(ParamFloat<px4::params::MC_PITCHRATE_MAX>) _param_mc_pitchrate_max,
+		(ParamFloat<px4::params::MC_YAWRATE_MAX>) _param_mc_yawrate_max,
+
+		(ParamInt<px4::params::IMU_GYRO_RATEMAX>) _param_imu_gyro_ratemax
 	)
 };
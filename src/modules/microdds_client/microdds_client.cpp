@@ -219,6 +219,8 @@ void MicroddsClient::run()
 		int num_pings_missed = 0;
 		bool had_ping_reply = false;
 		uint32_t last_num_payload_sent{};
+		uint32_t last_num_samples_sent{};
+		uint32_t last_num_frames_sent{};
 		uint32_t last_num_payload_received{};
 		bool error_printed = false;
 		hrt_abstime last_read = hrt_absolute_time();
@@ -271,6 +273,11 @@ void MicroddsClient::run()
 				_last_payload_tx_rate = (_subs->num_payload_sent - last_num_payload_sent) / dt;
 				_last_payload_rx_rate = (_pubs->num_payload_received - last_num_payload_received) / dt;
 				last_num_payload_sent = _subs->num_payload_sent;
+
+				const uint32_t frames_sent = _subs->num_frames_sent - last_num_frames_sent;
+				_last_samples_per_frame = frames_sent > 0 ? (float)(_subs->num_samples_sent - last_num_samples_sent) / frames_sent : 0.f;
+				last_num_samples_sent = _subs->num_samples_sent;
+				last_num_frames_sent = _subs->num_frames_sent;
 				last_num_payload_received = _pubs->num_payload_received;
 				last_status_update = now;
 			}
@@ -298,7 +305,8 @@ void MicroddsClient::run()
 
 		uxr_delete_session_retries(&session, _connected ? 1 : 0);
 		_last_payload_tx_rate = 0;
-		_last_payload_tx_rate = 0;
+		_last_payload_rx_rate = 0;
+		_last_samples_per_frame = 0.f;
 	}
 
 	orb_unsubscribe(polling_topic_sub);
@@ -430,7 +438,7 @@ int MicroddsClient::task_spawn(int argc, char *argv[])
 int MicroddsClient::print_status()
 {
 	PX4_INFO("Running, %s", _connected ? "connected" : "disconnected");
-	PX4_INFO("Payload tx: %i B/s", _last_payload_tx_rate);
+	PX4_INFO("Payload tx: %i B/s (%.1f samples per frame)", _last_payload_tx_rate, (double)_last_samples_per_frame);
 	PX4_INFO("Payload rx: %i B/s", _last_payload_rx_rate);
 	return 0;
 }
@@ -86,6 +86,7 @@ private:
 
 	int _last_payload_tx_rate{}; ///< in B/s
 	int _last_payload_rx_rate{}; ///< in B/s
+	float _last_samples_per_frame{};
 	bool _connected{false};
 };
 
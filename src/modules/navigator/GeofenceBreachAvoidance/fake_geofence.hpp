@@ -75,6 +75,30 @@ public:
 		}
 	}
 
+	// binary search on the probe function
+	float distanceToViolation(double lat, double lon, float altitude, float bearing, float max_distance) override
+	{
+		float current_distance = max_distance * 0.5f;
+		float current_min = 0.0f;
+		float current_max = max_distance;
+
+		while (fabsf(current_max - current_min) > 0.5f) {
+			double test_lat, test_lon;
+			waypoint_from_heading_and_distance(lat, lon, bearing, current_distance, &test_lat, &test_lon);
+
+			if (!isInsidePolygonOrCircle(test_lat, test_lon, altitude)) {
+				current_max = current_distance;
+
+			} else {
+				current_min = current_distance;
+			}
+
+			current_distance = (current_max + current_min) * 0.5f;
+		}
+
+		return current_distance;
+	}
+
 	enum class ProbeFunction {
 		ALL_POINTS_OUTSIDE = 0,
 		LEFT_INSIDE_RIGHT_OUTSIDE,
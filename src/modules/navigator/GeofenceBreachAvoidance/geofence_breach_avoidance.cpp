@@ -153,26 +153,12 @@ GeofenceBreachAvoidance::generateLoiterPointForMultirotor(geofence_violation_typ
 {
 
 	if (violation_type.flags.fence_violation) {
-		float current_distance = _test_point_distance * 0.5f;
-		float current_min = 0.0f;
-		float current_max = _test_point_distance;
-		Vector2d test_point;
+		// distance from the drone to the geofence in the given direction
+		const float current_distance = geofence->distanceToViolation(_current_pos_lat_lon(0), _current_pos_lat_lon(1),
+					       _current_alt_amsl, _test_point_bearing, _test_point_distance);
 
-		// binary search for the distance from the drone to the geofence in the given direction
-		while (abs(current_max - current_min) > 0.5f) {
-			test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing, current_distance);
-
-			if (!geofence->isInsidePolygonOrCircle(test_point(0), test_point(1), _current_alt_amsl)) {
-				current_max = current_distance;
-
-			} else {
-				current_min = current_distance;
-			}
-
-			current_distance = (current_max + current_min) * 0.5f;
-		}
-
-		test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing, current_distance);
+		const Vector2d test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing,
+					    current_distance);
 
 		if (_multirotor_braking_distance > current_distance - _min_hor_dist_to_fence_mc) {
 			return waypointFromBearingAndDistance(test_point, _test_point_bearing + M_PI_F, _min_hor_dist_to_fence_mc);
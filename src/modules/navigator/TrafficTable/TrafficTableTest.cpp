@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include "traffic_table.h"
+
+#include <lib/geo/geo.h>
+
+using namespace time_literals;
+
+static constexpr double own_lat = 47.397742;
+static constexpr double own_lon = 8.545594;
+
+static transponder_report_s makeReport(uint32_t icao_address, float north, float east, float altitude, float heading,
+				       float hor_velocity, hrt_abstime timestamp = 0)
+{
+	transponder_report_s report{};
+	report.timestamp = timestamp;
+	report.icao_address = icao_address;
+	report.lat = own_lat + math::degrees((double)north / CONSTANTS_RADIUS_OF_EARTH);
+	report.lon = own_lon + math::degrees((double)east / (CONSTANTS_RADIUS_OF_EARTH * cos(math::radians(own_lat))));
+	report.altitude = altitude;
+	report.heading = heading;
+	report.hor_velocity = hor_velocity;
+	report.flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS | transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING
+		       | transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY | transponder_report_s::PX4_ADSB_FLAGS_VALID_ALTITUDE;
+	return report;
+}
+
+static constexpr TrafficTable::OwnState own{own_lat, own_lon, 500.f, 0.f, 0.f, 0.f};
+
+TEST(TrafficTableTest, keyedByIcaoAddress)
+{
+	TrafficTable table;
+
+	EXPECT_TRUE(table.update(makeReport(30, 1000.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+	EXPECT_TRUE(table.update(makeReport(10, 2000.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+	EXPECT_TRUE(table.update(makeReport(20, 3000.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+	EXPECT_TRUE(table.update(makeReport(10, 4000.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+
+	ASSERT_EQ(table.size(), 3);
+	EXPECT_EQ(table.track(0).icao_address, 10u);
+	EXPECT_EQ(table.track(1).icao_address, 20u);
+	EXPECT_EQ(table.track(2).icao_address, 30u);
+	EXPECT_EQ(table.find(20), 1);
+	EXPECT_EQ(table.find(40), -1);
+
+	// updated in place
+	EXPECT_NEAR(table.track(0).lat, makeReport(10, 4000.f, 0.f, 500.f, 0.f, 10.f).lat, 1e-9);
+
+	// incomplete reports are ignored
+	transponder_report_s report = makeReport(50, 0.f, 0.f, 500.f, 0.f, 10.f);
+	report.flags &= ~transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY;
+	EXPECT_FALSE(table.update(report, own_lat, own_lon));
+	EXPECT_EQ(table.size(), 3);
+}
+
+TEST(TrafficTableTest, removeStale)
+{
+	TrafficTable table;
+	table.update(makeReport(1, 1000.f, 0.f, 500.f, 0.f, 10.f, 1_s), own_lat, own_lon);
+	table.update(makeReport(2, 1000.f, 0.f, 500.f, 0.f, 10.f, 5_s), own_lat, own_lon);
+	table.update(makeReport(3, 1000.f, 0.f, 500.f, 0.f, 10.f, 3_s), own_lat, own_lon);
+
+	table.removeStale(12_s, 10_s);
+
+	ASSERT_EQ(table.size(), 2);
+	EXPECT_EQ(table.track(0).icao_address, 2u);
+	EXPECT_EQ(table.track(1).icao_address, 3u);
+}
+
+TEST(TrafficTableTest, fullTableKeepsClosest)
+{
+	TrafficTable table;
+
+	for (int i = 0; i < TRAFFIC_TABLE_SIZE; i++) {
+		EXPECT_TRUE(table.update(makeReport(100 + i, 1000.f + 100.f * i, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+	}
+
+	// farther than all others
+	EXPECT_FALSE(table.update(makeReport(1, 100000.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+
+	// replaces the farthest one
+	EXPECT_TRUE(table.update(makeReport(1, 500.f, 0.f, 500.f, 0.f, 10.f), own_lat, own_lon));
+	EXPECT_EQ(table.size(), TRAFFIC_TABLE_SIZE);
+	EXPECT_EQ(table.track(0).icao_address, 1u);
+	EXPECT_EQ(table.find(100 + TRAFFIC_TABLE_SIZE - 1), -1);
+	EXPECT_EQ(table.find(100), 1);
+}
+
+TEST(TrafficTableTest, closestPointOfApproach)
+{
+	TrafficTable table;
+	TrafficTable::Conflict conflicts[4];
+
+	// 2 km north heading south at 50 m/s, passes 100 m east after 40 s
+	table.update(makeReport(1, 2000.f, 100.f, 500.f, M_PI_F, 50.f), own_lat, own_lon);
+
+	ASSERT_EQ(table.checkConflicts(own, 0, 500.f, 10.f, 60.f, conflicts, 4), 1);
+	EXPECT_EQ(conflicts[0].index, 0);
+	EXPECT_NEAR(conflicts[0].distance, 100.f, 1.f);
+	EXPECT_NEAR(conflicts[0].time, 40.f, 0.1f);
+
+	// not within the prediction horizon
+	EXPECT_EQ(table.checkConflicts(own, 0, 500.f, 10.f, 30.f, conflicts, 4), 0);
+
+	// the report is predicted to the current time: 50 s later it already passed
+	EXPECT_EQ(table.checkConflicts(own, 50_s, 500.f, 10.f, 60.f, conflicts, 4), 0);
+
+	// vertically separated
+	table.update(makeReport(1, 2000.f, 100.f, 1500.f, M_PI_F, 50.f), own_lat, own_lon);
+	EXPECT_EQ(table.checkConflicts(own, 0, 500.f, 10.f, 60.f, conflicts, 4), 0);
+
+	// heading away
+	table.update(makeReport(1, 2000.f, 100.f, 500.f, 0.f, 50.f), own_lat, own_lon);
+	EXPECT_EQ(table.checkConflicts(own, 0, 500.f, 10.f, 60.f, conflicts, 4), 0);
+
+	// UAV emitters use the unmanned separation
+	transponder_report_s report = makeReport(2, 200.f, 20.f, 500.f, M_PI_F, 10.f);
+	report.emitter_type = transponder_report_s::ADSB_EMITTER_TYPE_UAV;
+	table.update(report, own_lat, own_lon);
+	EXPECT_EQ(table.checkConflicts(own, 0, 500.f, 10.f, 60.f, conflicts, 4), 0);
+	EXPECT_EQ(table.checkConflicts(own, 0, 500.f, 30.f, 60.f, conflicts, 4), 1);
+
+	// own velocity: flying East into the path of the UAV, both meet after 20 s
+	const TrafficTable::OwnState own_moving{own_lat, own_lon, 500.f, 0.f, 1.f, 0.f};
+	ASSERT_EQ(table.checkConflicts(own_moving, 0, 500.f, 10.f, 60.f, conflicts, 4), 1);
+	EXPECT_EQ(table.track(conflicts[0].index).icao_address, 2u);
+	EXPECT_NEAR(conflicts[0].time, 20.f, 0.1f);
+}
@@ -0,0 +1,238 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "traffic_table.h"
+
+#include <lib/geo/geo.h>
+#include <mathlib/mathlib.h>
+#include <matrix/math.hpp>
+
+#include <new>
+#include <string.h>
+
+int TrafficTable::lowerBound(uint32_t icao_address) const
+{
+	int low = 0;
+	int high = _size;
+
+	while (low < high) {
+		const int mid = (low + high) / 2;
+
+		if (_tracks[mid].icao_address < icao_address) {
+			low = mid + 1;
+
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+int TrafficTable::find(uint32_t icao_address) const
+{
+	const int index = lowerBound(icao_address);
+
+	if ((index < _size) && (_tracks[index].icao_address == icao_address)) {
+		return index;
+	}
+
+	return -1;
+}
+
+float TrafficTable::distanceSquared(double lat_a, double lon_a, double lat_b, double lon_b)
+{
+	const float d_n = (float)math::radians(lat_b - lat_a) * CONSTANTS_RADIUS_OF_EARTH_F;
+	const float d_e = (float)math::radians(matrix::wrap(lon_b - lon_a, -180., 180.)) * CONSTANTS_RADIUS_OF_EARTH_F
+			  * cosf((float)math::radians(lat_a));
+	return d_n * d_n + d_e * d_e;
+}
+
+bool TrafficTable::update(const transponder_report_s &report, double own_lat, double own_lon)
+{
+	static constexpr uint16_t required_flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS |
+			transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING |
+			transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY | transponder_report_s::PX4_ADSB_FLAGS_VALID_ALTITUDE;
+
+	if ((report.flags & required_flags) != required_flags) {
+		return false;
+	}
+
+	if (_tracks == nullptr) {
+		// most vehicles never see any traffic
+		_tracks = new (std::nothrow) Track[TRAFFIC_TABLE_SIZE];
+
+		if (_tracks == nullptr) {
+			return false;
+		}
+	}
+
+	int index = lowerBound(report.icao_address);
+
+	if ((index >= _size) || (_tracks[index].icao_address != report.icao_address)) {
+		// new aircraft
+		if (_size == TRAFFIC_TABLE_SIZE) {
+			int farthest = 0;
+			float farthest_dist_sq = 0.f;
+
+			for (int i = 0; i < _size; i++) {
+				const float dist_sq = distanceSquared(own_lat, own_lon, _tracks[i].lat, _tracks[i].lon);
+
+				if (dist_sq > farthest_dist_sq) {
+					farthest_dist_sq = dist_sq;
+					farthest = i;
+				}
+			}
+
+			if (distanceSquared(own_lat, own_lon, report.lat, report.lon) >= farthest_dist_sq) {
+				return false;
+			}
+
+			memmove(&_tracks[farthest], &_tracks[farthest + 1], (_size - farthest - 1) * sizeof(Track));
+			_size--;
+
+			if (farthest < index) {
+				index--;
+			}
+		}
+
+		memmove(&_tracks[index + 1], &_tracks[index], (_size - index) * sizeof(Track));
+		_size++;
+
+		_tracks[index] = {};
+		_tracks[index].icao_address = report.icao_address;
+	}
+
+	Track &track = _tracks[index];
+	track.lat = report.lat;
+	track.lon = report.lon;
+	track.timestamp = report.timestamp;
+	track.altitude = report.altitude;
+	track.vel_n = report.hor_velocity * cosf(report.heading);
+	track.vel_e = report.hor_velocity * sinf(report.heading);
+	track.vel_u = report.ver_velocity;
+	track.heading = report.heading;
+	track.emitter_type = report.emitter_type;
+
+	track.uas_id = 0;
+
+	for (int i = 0; i < 8; i++) {
+		track.uas_id |= (uint64_t)(report.uas_id[sizeof(report.uas_id) - i - 1]) << (i * 8);
+	}
+
+	track.callsign_valid = (report.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN);
+	memcpy(track.callsign, report.callsign, sizeof(track.callsign));
+	track.callsign[sizeof(track.callsign) - 1] = '\0';
+
+	return true;
+}
+
+void TrafficTable::removeStale(hrt_abstime now, hrt_abstime timeout)
+{
+	int kept = 0;
+
+	for (int i = 0; i < _size; i++) {
+		if ((now < _tracks[i].timestamp) || (now - _tracks[i].timestamp < timeout)) {
+			if (kept != i) {
+				_tracks[kept] = _tracks[i];
+			}
+
+			kept++;
+		}
+	}
+
+	_size = kept;
+}
+
+int TrafficTable::checkConflicts(const OwnState &own, hrt_abstime now, float separation_manned,
+				 float separation_unmanned, float horizon, Conflict conflicts[], int max_conflicts) const
+{
+	// local North/East offsets of all tracks with the same projection (equirectangular around the own position),
+	// the error is negligible at the distances that can lead to a conflict within the horizon
+	const float meters_per_rad_lat = CONSTANTS_RADIUS_OF_EARTH_F;
+	const float meters_per_rad_lon = CONSTANTS_RADIUS_OF_EARTH_F * cosf((float)math::radians(own.lat));
+	const float own_speed = sqrtf(own.vel_n * own.vel_n + own.vel_e * own.vel_e);
+
+	int n_conflicts = 0;
+
+	for (int i = 0; (i < _size) && (n_conflicts < max_conflicts); i++) {
+		const Track &track = _tracks[i];
+
+		const float separation = (track.emitter_type == transponder_report_s::ADSB_EMITTER_TYPE_UAV) ? separation_unmanned :
+					 separation_manned;
+
+		// predict the track to now
+		const float dt = (now > track.timestamp) ? (now - track.timestamp) * 1e-6f : 0.f;
+
+		const float p_n = (float)math::radians(track.lat - own.lat) * meters_per_rad_lat + track.vel_n * dt;
+		const float p_e = (float)math::radians(matrix::wrap(track.lon - own.lon, -180., 180.)) * meters_per_rad_lon
+				  + track.vel_e * dt;
+		const float p_u = track.altitude - own.alt + track.vel_u * dt;
+
+		// cull the tracks that cannot come within the separation distance within the horizon
+		const float reach = separation + horizon * (own_speed + fabsf(track.vel_n) + fabsf(track.vel_e));
+
+		if ((fabsf(p_n) > reach) || (fabsf(p_e) > reach)
+		    || (fabsf(p_u) > separation + horizon * fabsf(track.vel_u - own.vel_u))) {
+			continue;
+		}
+
+		// horizontal closest point of approach of the relative motion
+		const float v_n = track.vel_n - own.vel_n;
+		const float v_e = track.vel_e - own.vel_e;
+		const float v_u = track.vel_u - own.vel_u;
+		const float v_sq = v_n * v_n + v_e * v_e;
+
+		float t_cpa = 0.f;
+
+		if (v_sq > FLT_EPSILON) {
+			t_cpa = math::constrain(-(p_n * v_n + p_e * v_e) / v_sq, 0.f, horizon);
+		}
+
+		const float d_n = p_n + v_n * t_cpa;
+		const float d_e = p_e + v_e * t_cpa;
+		const float d_u = p_u + v_u * t_cpa;
+		const float distance_sq = d_n * d_n + d_e * d_e;
+
+		if ((distance_sq < separation * separation) && (fabsf(d_u) < separation)) {
+			conflicts[n_conflicts].index = i;
+			conflicts[n_conflicts].distance = sqrtf(distance_sq);
+			conflicts[n_conflicts].vertical_distance = d_u;
+			conflicts[n_conflicts].time = t_cpa;
+			n_conflicts++;
+		}
+	}
+
+	return n_conflicts;
+}
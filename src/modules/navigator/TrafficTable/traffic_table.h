@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file traffic_table.h
+ *
+ * Table of the ADS-B / UTM traffic reported by transponder_report, keyed by ICAO address.
+ * Every track is predicted with its last reported velocity and all tracks are checked
+ * for a conflict with the own vehicle in one batch (closest point of approach).
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <uORB/topics/transponder_report.h>
+
+#if defined(CONFIG_NAVIGATOR_TRAFFIC_TABLE_SIZE)
+static constexpr int TRAFFIC_TABLE_SIZE = CONFIG_NAVIGATOR_TRAFFIC_TABLE_SIZE;
+#else
+static constexpr int TRAFFIC_TABLE_SIZE = 64;
+#endif
+
+class TrafficTable
+{
+public:
+	struct Track {
+		double lat;			///< latitude of the last report (deg)
+		double lon;			///< longitude of the last report (deg)
+		hrt_abstime timestamp;		///< time of the last report
+		hrt_abstime last_alert;		///< time of the last conflict alert, 0 if never
+		uint64_t uas_id;		///< last 8 bytes of the UAS ID
+		uint32_t icao_address;
+		float altitude;			///< altitude of the last report (AMSL, m)
+		float vel_n;			///< velocity North (m/s)
+		float vel_e;			///< velocity East (m/s)
+		float vel_u;			///< velocity up (m/s)
+		float heading;			///< course over ground (rad)
+		char callsign[9];
+		uint8_t emitter_type;
+		bool callsign_valid;
+	};
+
+	struct OwnState {
+		double lat;			///< (deg)
+		double lon;			///< (deg)
+		float alt;			///< AMSL (m)
+		float vel_n;			///< (m/s)
+		float vel_e;			///< (m/s)
+		float vel_u;			///< (m/s)
+	};
+
+	struct Conflict {
+		int index;			///< track index, see track()
+		float distance;			///< horizontal distance at the closest point of approach (m)
+		float vertical_distance;	///< vertical distance at the closest point of approach (m)
+		float time;			///< time until the closest point of approach (s)
+	};
+
+	TrafficTable() = default;
+	~TrafficTable() { delete[] _tracks; }
+
+	TrafficTable(const TrafficTable &) = delete;
+	TrafficTable &operator=(const TrafficTable &) = delete;
+
+	/**
+	 * Insert or update the track of a report. Reports without coordinates, altitude, heading and velocity are ignored.
+	 * If the table is full the track farthest away from the own vehicle is replaced if the new one is closer.
+	 * @return false if the report was not added
+	 */
+	bool update(const transponder_report_s &report, double own_lat, double own_lon);
+
+	/**
+	 * Remove the tracks that were not updated within timeout.
+	 */
+	void removeStale(hrt_abstime now, hrt_abstime timeout);
+
+	/**
+	 * Check all tracks for a loss of separation with the own vehicle within the time horizon,
+	 * assuming straight flight with constant velocity of both.
+	 *
+	 * @param separation_manned required horizontal and vertical separation to all but UAV emitters (m)
+	 * @param separation_unmanned required horizontal and vertical separation to UAV emitters (m)
+	 * @param horizon prediction horizon (s)
+	 * @param conflicts output, sorted by track index
+	 * @return number of conflicts written to conflicts
+	 */
+	int checkConflicts(const OwnState &own, hrt_abstime now, float separation_manned, float separation_unmanned,
+			   float horizon, Conflict conflicts[], int max_conflicts) const;
+
+	int size() const { return _size; }
+	Track &track(int index) { return _tracks[index]; }
+	const Track &track(int index) const { return _tracks[index]; }
+
+	/** @return track index or -1 */
+	int find(uint32_t icao_address) const;
+
+private:
+	/** index of the first track with an ICAO address >= icao_address */
+	int lowerBound(uint32_t icao_address) const;
+
+	/** squared horizontal distance with an equirectangular projection, valid for the distances of interest */
+	static float distanceSquared(double lat_a, double lon_a, double lat_b, double lon_b);
+
+	Track *_tracks{nullptr};	///< sorted by ICAO address, allocated with the first report
+	int _size{0};
+};
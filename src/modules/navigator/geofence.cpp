@@ -69,6 +69,8 @@ Geofence::~Geofence()
 	if (_polygons) {
 		delete[](_polygons);
 	}
+
+	_freeIndex();
 }
 
 void Geofence::updateFence()
@@ -97,6 +99,7 @@ void Geofence::_updateFence()
 	}
 
 	// iterate over all polygons and store their starting vertices
+	_freeIndex();
 	_num_polygons = 0;
 	int current_seq = 1;
 
@@ -175,6 +178,184 @@ void Geofence::_updateFence()
 
 	}
 
+	_buildIndex(num_fence_items);
+}
+
+void Geofence::_freeIndex()
+{
+	delete[](_vertices);
+	_vertices = nullptr;
+
+	delete[](_bucket_start);
+	_bucket_start = nullptr;
+
+	delete[](_bucket_edges);
+	_bucket_edges = nullptr;
+
+	delete[](_vertices_local);
+	_vertices_local = nullptr;
+}
+
+int Geofence::bucket(const PolygonInfo &polygon, double lon)
+{
+	const int bucket = (lon - polygon.lon_min) * polygon.bucket_scale;
+	return math::constrain(bucket, 0, polygon.bucket_count - 1);
+}
+
+void Geofence::_buildIndex(int num_fence_items)
+{
+	if (_num_polygons == 0) {
+		return;
+	}
+
+	_vertices = new Vertex[num_fence_items + 1];
+
+	if (!_vertices) {
+		_num_polygons = 0;
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	int total_buckets = 0;
+	int total_edges = 0;
+
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		PolygonInfo &polygon = _polygons[polygon_index];
+		const bool is_circle_area = (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION)
+					    || (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION);
+		const int vertex_count = is_circle_area ? 1 : polygon.vertex_count;
+		bool supported = true;
+
+		polygon.bucket_count = 0;
+
+		for (int i = 0; i < vertex_count; ++i) {
+			mission_fence_point_s mission_fence_point;
+
+			if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &mission_fence_point,
+				    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
+				PX4_ERR("dm_read failed");
+				supported = false;
+				break;
+			}
+
+			if (mission_fence_point.frame != NAV_FRAME_GLOBAL && mission_fence_point.frame != NAV_FRAME_GLOBAL_INT
+			    && mission_fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
+			    && mission_fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+				// TODO: handle different frames
+				PX4_ERR("Frame type %i not supported", (int)mission_fence_point.frame);
+				supported = false;
+				break;
+			}
+
+			_vertices[polygon.dataman_index + i].lat = mission_fence_point.lat;
+			_vertices[polygon.dataman_index + i].lon = mission_fence_point.lon;
+		}
+
+		if (!supported) {
+			// never inside
+			if (is_circle_area) {
+				polygon.circle_radius = 0.f;
+
+			} else {
+				polygon.vertex_count = 0;
+			}
+
+			continue;
+		}
+
+		if (is_circle_area) {
+			continue;
+		}
+
+		const Vertex *vertices = &_vertices[polygon.dataman_index];
+		polygon.lat_min = polygon.lat_max = vertices[0].lat;
+		polygon.lon_min = polygon.lon_max = vertices[0].lon;
+
+		for (int i = 1; i < vertex_count; ++i) {
+			polygon.lat_min = math::min(polygon.lat_min, vertices[i].lat);
+			polygon.lat_max = math::max(polygon.lat_max, vertices[i].lat);
+			polygon.lon_min = math::min(polygon.lon_min, vertices[i].lon);
+			polygon.lon_max = math::max(polygon.lon_max, vertices[i].lon);
+		}
+
+		if ((vertex_count >= EDGE_INDEX_MIN_VERTICES) && (polygon.lon_max > polygon.lon_min)) {
+			polygon.bucket_count = math::min(vertex_count / 2, EDGE_INDEX_MAX_BUCKETS);
+			polygon.bucket_scale = polygon.bucket_count / (polygon.lon_max - polygon.lon_min);
+			polygon.bucket_index = total_buckets;
+			total_buckets += polygon.bucket_count + 1;
+
+			for (int i = 0, j = vertex_count - 1; i < vertex_count; j = i++) {
+				total_edges += bucket(polygon, math::max(vertices[i].lon, vertices[j].lon))
+					       - bucket(polygon, math::min(vertices[i].lon, vertices[j].lon)) + 1;
+			}
+		}
+	}
+
+	_vertices_local = new matrix::Vector2f[num_fence_items + 1];
+
+	if (_vertices_local) {
+		_local_reference = MapProjection{};
+
+		for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+			const PolygonInfo &polygon = _polygons[polygon_index];
+			const bool is_circle_area = (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION)
+						    || (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION);
+
+			// only the loaded areas (unsupported ones have no vertices or radius)
+			const int vertex_count = is_circle_area ? (polygon.circle_radius > 0.f ? 1 : 0) : polygon.vertex_count;
+
+			for (int i = polygon.dataman_index; i < polygon.dataman_index + vertex_count; ++i) {
+				if (!_local_reference.isInitialized()) {
+					_local_reference.initReference(_vertices[i].lat, _vertices[i].lon);
+				}
+
+				_vertices_local[i] = _local_reference.project(_vertices[i].lat, _vertices[i].lon);
+			}
+		}
+
+	} else {
+		PX4_ERR("alloc failed");
+	}
+
+	if (total_buckets == 0) {
+		return;
+	}
+
+	_bucket_start = new uint16_t[total_buckets];
+	_bucket_edges = new uint16_t[total_edges];
+
+	if (!_bucket_start || !_bucket_edges) {
+		// fall back to testing all edges
+		PX4_ERR("alloc failed");
+
+		for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+			_polygons[polygon_index].bucket_count = 0;
+		}
+
+		return;
+	}
+
+	uint16_t offset = 0;
+
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		const PolygonInfo &polygon = _polygons[polygon_index];
+		const Vertex *vertices = &_vertices[polygon.dataman_index];
+
+		for (int b = 0; b < polygon.bucket_count; ++b) {
+			_bucket_start[polygon.bucket_index + b] = offset;
+
+			for (int i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+				if ((bucket(polygon, math::min(vertices[i].lon, vertices[j].lon)) <= b)
+				    && (bucket(polygon, math::max(vertices[i].lon, vertices[j].lon)) >= b)) {
+					_bucket_edges[offset++] = i;
+				}
+			}
+		}
+
+		if (polygon.bucket_count > 0) {
+			_bucket_start[polygon.bucket_index + polygon.bucket_count] = offset;
+		}
+	}
 }
 
 bool Geofence::checkAll(const struct vehicle_global_position_s &global_position)
@@ -306,7 +487,8 @@ bool Geofence::isBelowMaxAltitude(float altitude)
 
 bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 {
-	// the following uses dm_read, so first we try to lock all items. If that fails, it (most likely) means
+	// the fence is checked against the RAM copy of the dataman items, which is updated if the dataman update
+	// counter changes. So first we try to lock all items. If that fails, it (most likely) means
 	// the data is currently being updated (via a mavlink geofence transfer), and we do not check for a violation now
 	if (dm_trylock(DM_KEY_FENCE_POINTS) != 0) {
 		return true;
@@ -380,8 +562,142 @@ bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 	return (!had_inclusion_areas || inside_inclusion) && outside_exclusion;
 }
 
+float Geofence::distanceToViolation(double lat, double lon, float altitude, float bearing, float max_distance)
+{
+	// same locking and update as isInsidePolygonOrCircle(), no violation while the fence is being updated
+	if (dm_trylock(DM_KEY_FENCE_POINTS) != 0) {
+		return max_distance;
+	}
+
+	mission_stats_entry_s stats;
+	int ret = dm_read(DM_KEY_FENCE_POINTS, 0, &stats, sizeof(mission_stats_entry_s));
+
+	if (ret == sizeof(mission_stats_entry_s) && _update_counter != stats.update_counter) {
+		_updateFence();
+	}
+
+	if (isEmpty() || !_vertices_local) {
+		dm_unlock(DM_KEY_FENCE_POINTS);
+		return max_distance;
+	}
+
+	if ((_altitude_max > _altitude_min) && (altitude > _altitude_max || altitude < _altitude_min)) {
+		dm_unlock(DM_KEY_FENCE_POINTS);
+		return 0.f;
+	}
+
+	const matrix::Vector2f origin = _local_reference.project(lat, lon);
+	const matrix::Vector2f dir{cosf(bearing), sinf(bearing)};
+
+	int inclusion_areas = 0;
+	int inside_inclusion = 0;
+	int inside_exclusion = 0;
+
+	// inside at the origin if the ray crosses the boundary an odd number of times
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		PolygonInfo &polygon = _polygons[polygon_index];
+		const bool inclusion = (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION)
+				       || (polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION);
+
+		polygon.ray_inside = rayCrossings(polygon, origin, dir, 0.f, polygon.ray_next) & 1;
+
+		inclusion_areas += inclusion;
+		(inclusion ? inside_inclusion : inside_exclusion) += polygon.ray_inside;
+	}
+
+	const auto allowed = [&]() {
+		return ((inclusion_areas == 0) || (inside_inclusion > 0)) && (inside_exclusion == 0);
+	};
+
+	float distance = 0.f;
+
+	// step along the ray through the boundary crossings, only rescanning the areas crossed
+	while (allowed()) {
+		distance = INFINITY;
+
+		for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+			distance = math::min(distance, _polygons[polygon_index].ray_next);
+		}
+
+		if (!(distance < max_distance)) {
+			distance = max_distance;
+			break;
+		}
+
+		for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+			PolygonInfo &polygon = _polygons[polygon_index];
+
+			if (polygon.ray_next <= distance + RAY_CROSSING_TIE) {
+				const bool inclusion = (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION)
+						       || (polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION);
+
+				polygon.ray_inside = !polygon.ray_inside;
+				(inclusion ? inside_inclusion : inside_exclusion) += polygon.ray_inside ? 1 : -1;
+
+				rayCrossings(polygon, origin, dir, polygon.ray_next, polygon.ray_next);
+			}
+		}
+	}
+
+	dm_unlock(DM_KEY_FENCE_POINTS);
+
+	return distance;
+}
+
+int Geofence::rayCrossings(const PolygonInfo &polygon, const matrix::Vector2f &origin, const matrix::Vector2f &dir,
+			   float t_from, float &t_first) const
+{
+	int crossings = 0;
+	t_first = INFINITY;
+
+	const auto add = [&](float t) {
+		if (t > t_from) {
+			crossings++;
+			t_first = math::min(t_first, t);
+		}
+	};
+
+	if ((polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION) || (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION)) {
+		// |origin + t * dir - center| = radius
+		const matrix::Vector2f to_center = _vertices_local[polygon.dataman_index] - origin;
+		const float t_closest = to_center.dot(dir);
+		const float d2 = polygon.circle_radius * polygon.circle_radius - (to_center.norm_squared() - t_closest * t_closest);
+
+		if (d2 > 0.f) {
+			add(t_closest - sqrtf(d2));
+			add(t_closest + sqrtf(d2));
+		}
+
+		return crossings;
+	}
+
+	const matrix::Vector2f *vertices = &_vertices_local[polygon.dataman_index];
+
+	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+		// origin + t * dir = vertices[j] + s * edge, s in [0, 1) so that shared vertices count once
+		const matrix::Vector2f edge = vertices[i] - vertices[j];
+		const matrix::Vector2f w = vertices[j] - origin;
+		const float denominator = dir % edge;
+
+		if (fabsf(denominator) > FLT_EPSILON) {
+			const float s = (w % dir) / denominator;
+
+			if ((s >= 0.f) && (s < 1.f)) {
+				add((w % edge) / denominator);
+			}
+		}
+	}
+
+	return crossings;
+}
+
 bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
+	if ((polygon.vertex_count == 0) || (lat < polygon.lat_min) || (lat > polygon.lat_max)
+	    || (lon < polygon.lon_min) || (lon > polygon.lon_max)) {
+		return false;
+	}
+
 	/**
 	 * Adaptation of algorithm originally presented as
 	 * PNPOLY - Point Inclusion in Polygon Test
@@ -389,33 +705,33 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 	 * Only supports non-complex polygons (not self intersecting)
 	 */
 
-	mission_fence_point_s temp_vertex_i{};
-	mission_fence_point_s temp_vertex_j{};
+	const Vertex *vertices = &_vertices[polygon.dataman_index];
 	bool c = false;
 
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &temp_vertex_i,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
+	const auto crosses = [vertices, lat, lon](unsigned i, unsigned j) {
+		return ((vertices[i].lon >= lon) != (vertices[j].lon >= lon)) &&
+		       (lat <= (vertices[j].lat - vertices[i].lat) * (lon - vertices[i].lon) /
+			(vertices[j].lon - vertices[i].lon) + vertices[i].lat);
+	};
 
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + j, &temp_vertex_j,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
+	if (polygon.bucket_count > 0) {
+		// only the edges overlapping the longitude of the point can be crossed
+		const int b = polygon.bucket_index + bucket(polygon, lon);
 
-		if (temp_vertex_i.frame != NAV_FRAME_GLOBAL && temp_vertex_i.frame != NAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
+		for (unsigned k = _bucket_start[b]; k < _bucket_start[b + 1]; ++k) {
+			const unsigned i = _bucket_edges[k];
+			const unsigned j = (i == 0) ? polygon.vertex_count - 1 : i - 1;
+
+			if (crosses(i, j)) {
+				c = !c;
+			}
 		}
 
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-			c = !c;
+	} else {
+		for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+			if (crosses(i, j)) {
+				c = !c;
+			}
 		}
 	}
 
@@ -424,22 +740,7 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 
 bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
-
-	mission_fence_point_s circle_point{};
-
-	if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index, &circle_point,
-		    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-		PX4_ERR("dm_read failed");
-		return false;
-	}
-
-	if (circle_point.frame != NAV_FRAME_GLOBAL && circle_point.frame != NAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
-	}
+	const Vertex &center = _vertices[polygon.dataman_index];
 
 	if (!_projection_reference.isInitialized()) {
 		_projection_reference.initReference(lat, lon);
@@ -447,9 +748,9 @@ bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon,
 
 	float x1, y1, x2, y2;
 	_projection_reference.project(lat, lon, x1, y1);
-	_projection_reference.project(circle_point.lat, circle_point.lon, x2, y2);
+	_projection_reference.project(center.lat, center.lon, x2, y2);
 	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	return dx * dx + dy * dy < polygon.circle_radius * polygon.circle_radius;
 }
 
 bool
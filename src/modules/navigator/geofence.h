@@ -111,6 +111,15 @@ public:
 
 	virtual bool isInsidePolygonOrCircle(double lat, double lon, float altitude);
 
+	/**
+	 * Distance along a bearing from a point to where it first violates the polygon, circle or altitude fence,
+	 * intersecting the ray with the locally projected fence.
+	 *
+	 * @param bearing [rad] from north
+	 * @return [m] 0 if the point itself violates the fence, max_distance if there is no violation up to it
+	 */
+	virtual float distanceToViolation(double lat, double lon, float altitude, float bearing, float max_distance);
+
 	int clearDm();
 
 	bool valid();
@@ -156,16 +165,48 @@ private:
 
 	struct PolygonInfo {
 		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
-		uint16_t dataman_index;
+		uint16_t dataman_index; ///< also the index of the first vertex in _vertices
 		union {
 			uint16_t vertex_count;
 			float circle_radius;
 		};
+
+		// polygons only
+		uint16_t bucket_index; ///< first entry in _bucket_start
+		uint16_t bucket_count; ///< number of longitude buckets of the edge index, 0 if not indexed
+		double bucket_scale; ///< buckets per degree longitude
+		double lat_min, lat_max, lon_min, lon_max; ///< bounding box
+
+		// distanceToViolation() state
+		float ray_next; ///< [m] next crossing of the boundary along the ray
+		bool ray_inside;
 	};
 
+	struct Vertex {
+		double lat;
+		double lon;
+	};
+
+	/**
+	 * Polygons with at least this many vertices get an edge index: the longitude range
+	 * of the polygon is split into buckets, each listing the edges overlapping it.
+	 */
+	static constexpr int EDGE_INDEX_MIN_VERTICES = 16;
+	static constexpr int EDGE_INDEX_MAX_BUCKETS = 32;
+
+	static constexpr float RAY_CROSSING_TIE{0.01f}; ///< [m] boundaries crossed within this distance are crossed together
+
 	Navigator   *_navigator{nullptr};
 	PolygonInfo *_polygons{nullptr};
 
+	// RAM copy of the fence items, rebuilt when the fence in dataman changes
+	Vertex *_vertices{nullptr}; ///< indexed by dataman index
+	uint16_t *_bucket_start{nullptr}; ///< offset in _bucket_edges per bucket (bucket_count + 1 entries per polygon)
+	uint16_t *_bucket_edges{nullptr}; ///< edges by their first vertex (relative to the polygon)
+
+	matrix::Vector2f *_vertices_local{nullptr}; ///< _vertices projected with _local_reference
+	MapProjection _local_reference{}; ///< first vertex of the fence
+
 	hrt_abstime _last_horizontal_range_warning{0};
 	hrt_abstime _last_vertical_range_warning{0};
 
@@ -186,6 +227,27 @@ private:
 	 */
 	void _updateFence();
 
+	/**
+	 * load the vertices and build bounding boxes and edge indexes of _polygons
+	 */
+	void _buildIndex(int num_fence_items);
+
+	void _freeIndex();
+
+	/**
+	 * @return the longitude bucket of the polygon edge index lon falls into (clamped)
+	 */
+	static int bucket(const PolygonInfo &polygon, double lon);
+
+	/**
+	 * Intersect a ray with the boundary of a polygon or circle in the local frame
+	 * @param t_from [m] only count crossings further along the ray
+	 * @param t_first [m] nearest of the counted crossings, INFINITY if none
+	 * @return number of crossings further than t_from
+	 */
+	int rayCrossings(const PolygonInfo &polygon, const matrix::Vector2f &origin, const matrix::Vector2f &dir, float t_from,
+			 float &t_first) const;
+
 	/**
 	 * Check if a point passes the Geofence test.
 	 * This takes all polygons and minimum & maximum altitude into account
@@ -515,6 +515,9 @@ Mission::update_mission()
 
 	const mission_s old_mission = _mission;
 
+	// the mission items might have been rewritten
+	invalidate_mission_item_cache();
+
 	if (_mission_sub.copy(&_mission)) {
 		/* determine current index */
 		if (_mission.current_seq >= 0 && _mission.current_seq < (int)_mission.count) {
@@ -1217,6 +1220,7 @@ Mission::set_mission_items()
 	}
 
 	publish_navigator_mission_item(); // for logging
+	publish_mission_lookahead();
 	_navigator->set_position_setpoint_triplet_updated();
 }
 
@@ -1574,7 +1578,7 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 		struct mission_item_s mission_item_tmp;
 
 		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		if (!read_mission_item_cached(dm_item, *mission_index_ptr, mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Waypoint could not be read.\t");
 			events::send<uint16_t>(events::ID("mission_failed_to_read_wp"), events::Log::Error,
@@ -1603,6 +1607,8 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 						return false;
 					}
 
+					cache_mission_item(dm_item, *mission_index_ptr, mission_item_tmp);
+
 					report_do_jump_mission_changed(*mission_index_ptr, mission_item_tmp.do_jump_repeat_count);
 				}
 
@@ -1639,6 +1645,54 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 	return false;
 }
 
+bool
+Mission::read_mission_item_cached(dm_item_t dm_item, int index, mission_item_s &mission_item)
+{
+	for (const MissionItemCacheEntry &entry : _mission_item_cache) {
+		if ((entry.index == index) && (entry.dataman_id == dm_item)) {
+			mission_item = entry.item;
+			return true;
+		}
+	}
+
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_read(dm_item, index, &mission_item, len) != len) {
+		return false;
+	}
+
+	cache_mission_item(dm_item, index, mission_item);
+	return true;
+}
+
+void
+Mission::cache_mission_item(dm_item_t dm_item, int index, const mission_item_s &mission_item)
+{
+	MissionItemCacheEntry *slot = &_mission_item_cache[_mission_item_cache_next];
+
+	for (MissionItemCacheEntry &entry : _mission_item_cache) {
+		if ((entry.index == index) && (entry.dataman_id == dm_item)) {
+			// update in place (DO_JUMP counter written back)
+			entry.item = mission_item;
+			return;
+		}
+	}
+
+	slot->item = mission_item;
+	slot->index = index;
+	slot->dataman_id = dm_item;
+
+	_mission_item_cache_next = (_mission_item_cache_next + 1) % MISSION_ITEM_CACHE_SIZE;
+}
+
+void
+Mission::invalidate_mission_item_cache()
+{
+	for (MissionItemCacheEntry &entry : _mission_item_cache) {
+		entry.index = -1;
+	}
+}
+
 void
 Mission::save_mission_state()
 {
@@ -1759,6 +1813,9 @@ Mission::reset_mission(struct mission_s &mission)
 {
 	dm_lock(DM_KEY_MISSION_STATE);
 
+	// the jump counters are reset below
+	invalidate_mission_item_cache();
+
 	if (dm_read(DM_KEY_MISSION_STATE, 0, &mission, sizeof(mission_s)) == sizeof(mission_s)) {
 		if (mission.dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0 || mission.dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_1) {
 			/* set current item to 0 */
@@ -1930,3 +1987,67 @@ void Mission::publish_navigator_mission_item()
 
 	_navigator_mission_item_pub.publish(navigator_mission_item);
 }
+
+void Mission::publish_mission_lookahead()
+{
+	mission_lookahead_s mission_lookahead{};
+
+	const position_setpoint_s &next = _navigator->get_position_setpoint_triplet()->next;
+	mission_lookahead.anchor_lat = next.lat;
+	mission_lookahead.anchor_lon = next.lon;
+
+	if (next.valid && (_mission_type == MISSION_TYPE_MISSION)
+	    && (_mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_NORMAL)) {
+
+		const dm_item_t dm_item = (dm_item_t)_mission.dataman_id;
+		const int last_index = math::min((int)_mission.count - 1, _current_mission_index + MISSION_LOOKAHEAD_MAX_ITEMS);
+		bool anchor_found = false;
+
+		for (int index = _current_mission_index + 1; index <= last_index; index++) {
+			mission_item_s mission_item;
+
+			if (!read_mission_item_cached(dm_item, index, mission_item)) {
+				break;
+			}
+
+			if (mission_item.nav_cmd == NAV_CMD_DO_JUMP || mission_item.nav_cmd == NAV_CMD_DO_CHANGE_SPEED) {
+				// the following waypoints are not flown in this order or at this speed
+				break;
+			}
+
+			if (!item_contains_position(mission_item)) {
+				continue;
+			}
+
+			// the vehicle only keeps its speed through plain waypoints
+			const bool pass_through = (mission_item.nav_cmd == NAV_CMD_WAYPOINT) && mission_item.autocontinue
+						  && (get_time_inside(mission_item) < FLT_EPSILON);
+
+			if (!anchor_found) {
+				// the first position item is the next setpoint of the triplet
+				if (!pass_through || (fabs(mission_item.lat - next.lat) > 1e-9) || (fabs(mission_item.lon - next.lon) > 1e-9)) {
+					break;
+				}
+
+				anchor_found = true;
+				continue;
+			}
+
+			if (mission_item.nav_cmd != NAV_CMD_WAYPOINT) {
+				break;
+			}
+
+			mission_lookahead.lat[mission_lookahead.count] = mission_item.lat;
+			mission_lookahead.lon[mission_lookahead.count] = mission_item.lon;
+			mission_lookahead.alt[mission_lookahead.count] = get_absolute_altitude_for_item(mission_item);
+			mission_lookahead.count++;
+
+			if (!pass_through || (mission_lookahead.count >= mission_lookahead_s::MAX_WAYPOINTS)) {
+				break;
+			}
+		}
+	}
+
+	mission_lookahead.timestamp = hrt_absolute_time();
+	_mission_lookahead_pub.publish(mission_lookahead);
+}
@@ -58,6 +58,7 @@
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/mission.h>
+#include <uORB/topics/mission_lookahead.h>
 #include <uORB/topics/mission_result.h>
 #include <uORB/topics/navigator_mission_item.h>
 #include <uORB/topics/position_setpoint_triplet.h>
@@ -191,6 +192,20 @@ private:
 	 */
 	bool read_mission_item(int offset, struct mission_item_s *mission_item);
 
+	/**
+	 * Read a mission item of the current mission, from the cache if it was read recently
+	 *
+	 * @return true if successful
+	 */
+	bool read_mission_item_cached(dm_item_t dm_item, int index, mission_item_s &mission_item);
+
+	/**
+	 * Store a mission item that was read from or written to the dataman in the cache
+	 */
+	void cache_mission_item(dm_item_t dm_item, int index, const mission_item_s &mission_item);
+
+	void invalidate_mission_item_cache();
+
 	/**
 	 * Save current mission state to dataman
 	 */
@@ -240,6 +255,11 @@ private:
 
 	void publish_navigator_mission_item();
 
+	/**
+	 * Publish the waypoints the vehicle passes through after the next position setpoint of the triplet
+	 */
+	void publish_mission_lookahead();
+
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::MIS_DIST_1WP>) _param_mis_dist_1wp,
 		(ParamFloat<px4::params::MIS_DIST_WPS>) _param_mis_dist_wps,
@@ -247,12 +267,32 @@ private:
 	)
 
 	uORB::Publication<navigator_mission_item_s> _navigator_mission_item_pub{ORB_ID::navigator_mission_item};
+	uORB::Publication<mission_lookahead_s> _mission_lookahead_pub{ORB_ID(mission_lookahead)};
+
+	static constexpr int MISSION_LOOKAHEAD_MAX_ITEMS = 10; ///< maximum number of mission items read for the lookahead
 
 	uORB::Subscription	_mission_sub{ORB_ID(mission)};		/**< mission subscription */
 	mission_s		_mission {};
 
 	int32_t _current_mission_index{-1};
 
+	// recently read mission items, saves dataman reads when a mission item is reached and the
+	// next items (already read for the lookahead) are read again
+#if defined(CONSTRAINED_MEMORY)
+	static constexpr int MISSION_ITEM_CACHE_SIZE {3};
+#else
+	static constexpr int MISSION_ITEM_CACHE_SIZE {8};
+#endif // CONSTRAINED_MEMORY
+
+	struct MissionItemCacheEntry {
+		mission_item_s item;
+		int32_t index{-1};
+		uint8_t dataman_id{0};
+	};
+
+	MissionItemCacheEntry _mission_item_cache[MISSION_ITEM_CACHE_SIZE] {};
+	uint8_t _mission_item_cache_next{0};
+
 	// track location of planned mission landing
 	bool	_land_start_available{false};
 	uint16_t _land_start_index{UINT16_MAX};		/**< index of DO_LAND_START, INVALID_DO_LAND_START if no planned landing */
@@ -65,6 +65,8 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission,
 		return false;
 	}
 
+	loadMissionItems(mission);
+
 	bool failed = false;
 
 	// first check if we have a valid position
@@ -98,9 +100,58 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission,
 		failed = failed || !checkFixedwing(mission, home_alt, land_start_req);
 	}
 
+	releaseMissionItems();
+
 	return !failed;
 }
 
+void
+MissionFeasibilityChecker::loadMissionItems(const mission_s &mission)
+{
+	releaseMissionItems();
+
+#if !defined(CONSTRAINED_MEMORY)
+	_mission_items = new mission_item_s[mission.count];
+
+	if (_mission_items == nullptr) {
+		// not enough memory, read every item from dataman
+		return;
+	}
+
+	for (size_t i = 0; i < mission.count; i++) {
+		const ssize_t len = sizeof(mission_item_s);
+
+		if (dm_read((dm_item_t)mission.dataman_id, i, &_mission_items[i], len) != len) {
+			// let the checks report the failure
+			releaseMissionItems();
+			return;
+		}
+	}
+
+	_mission_items_count = mission.count;
+#endif // !CONSTRAINED_MEMORY
+}
+
+void
+MissionFeasibilityChecker::releaseMissionItems()
+{
+	delete[] _mission_items;
+	_mission_items = nullptr;
+	_mission_items_count = 0;
+}
+
+bool
+MissionFeasibilityChecker::readMissionItem(const mission_s &mission, size_t index, mission_item_s &mission_item) const
+{
+	if (index < _mission_items_count) {
+		mission_item = _mission_items[index];
+		return true;
+	}
+
+	const ssize_t len = sizeof(mission_item_s);
+	return dm_read((dm_item_t)mission.dataman_id, index, &mission_item, len) == len;
+}
+
 bool
 MissionFeasibilityChecker::checkRotarywing(const mission_s &mission, float home_alt)
 {
@@ -147,9 +198,8 @@ MissionFeasibilityChecker::checkGeofence(const mission_s &mission, float home_al
 	if (_navigator->get_geofence().valid()) {
 		for (size_t i = 0; i < mission.count; i++) {
 			struct mission_item_s missionitem = {};
-			const ssize_t len = sizeof(missionitem);
 
-			if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+			if (!readMissionItem(mission, i, missionitem)) {
 				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 				return false;
 			}
@@ -184,9 +234,8 @@ MissionFeasibilityChecker::checkHomePositionAltitude(const mission_s &mission, f
 	/* Check if all waypoints are above the home altitude */
 	for (size_t i = 0; i < mission.count; i++) {
 		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+		if (!readMissionItem(mission, i, missionitem)) {
 			_navigator->get_mission_result()->warning = true;
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
@@ -227,9 +276,8 @@ MissionFeasibilityChecker::checkMissionItemValidity(const mission_s &mission)
 	// do not allow mission if we find unsupported item
 	for (size_t i = 0; i < mission.count; i++) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+		if (!readMissionItem(mission, i, missionitem)) {
 			// not supposed to happen unless the datamanager can't access the SD card, etc.
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Cannot access SD card\t");
 			events::send(events::ID("navigator_mis_sd_failure"), events::Log::Error,
@@ -333,9 +381,8 @@ MissionFeasibilityChecker::checkTakeoff(const mission_s &mission, float home_alt
 
 	for (size_t i = 0; i < mission.count; i++) {
 		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+		if (!readMissionItem(mission, i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
 		}
@@ -388,9 +435,8 @@ MissionFeasibilityChecker::checkTakeoff(const mission_s &mission, float home_alt
 		// one of the bellow mission items
 		for (size_t i = 0; i < (size_t)takeoff_index; i++) {
 			struct mission_item_s missionitem = {};
-			const ssize_t len = sizeof(struct mission_item_s);
 
-			if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+			if (!readMissionItem(mission, i, missionitem)) {
 				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 				return false;
 			}
@@ -466,9 +512,8 @@ MissionFeasibilityChecker::checkFixedWingLanding(const mission_s &mission, bool
 
 	for (size_t i = 0; i < mission.count; i++) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+		if (!readMissionItem(mission, i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
 		}
@@ -506,7 +551,7 @@ MissionFeasibilityChecker::checkFixedWingLanding(const mission_s &mission, bool
 			if (i > 0) {
 				landing_approach_index = i - 1;
 
-				if (dm_read((dm_item_t)mission.dataman_id, landing_approach_index, &missionitem_previous, len) != len) {
+				if (!readMissionItem(mission, landing_approach_index, missionitem_previous)) {
 					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 					return false;
 				}
@@ -655,9 +700,8 @@ MissionFeasibilityChecker::checkVTOLLanding(const mission_s &mission, bool land_
 
 	for (size_t i = 0; i < mission.count; i++) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
+		if (!readMissionItem(mission, i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
 		}
@@ -682,7 +726,7 @@ MissionFeasibilityChecker::checkVTOLLanding(const mission_s &mission, bool land_
 			if (i > 0) {
 				landing_approach_index = i - 1;
 
-				if (dm_read((dm_item_t)mission.dataman_id, landing_approach_index, &missionitem_previous, len) != len) {
+				if (!readMissionItem(mission, landing_approach_index, missionitem_previous)) {
 					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 					return false;
 				}
@@ -737,7 +781,7 @@ MissionFeasibilityChecker::checkDistanceToFirstWaypoint(const mission_s &mission
 
 		struct mission_item_s mission_item {};
 
-		if (!(dm_read((dm_item_t)mission.dataman_id, i, &mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s))) {
+		if (!readMissionItem(mission, i, mission_item)) {
 			/* error reading, mission is invalid */
 			mavlink_log_info(_navigator->get_mavlink_log_pub(), "Error reading offboard mission.\t");
 			events::send(events::ID("navigator_mis_storage_failure"), events::Log::Error,
@@ -793,7 +837,7 @@ MissionFeasibilityChecker::checkDistancesBetweenWaypoints(const mission_s &missi
 
 		struct mission_item_s mission_item {};
 
-		if (!(dm_read((dm_item_t)mission.dataman_id, i, &mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s))) {
+		if (!readMissionItem(mission, i, mission_item)) {
 			/* error reading, mission is invalid */
 			mavlink_log_info(_navigator->get_mavlink_log_pub(), "Error reading offboard mission.\t");
 			events::send(events::ID("navigator_mis_storage_failure2"), events::Log::Error,
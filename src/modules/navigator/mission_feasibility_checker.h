@@ -42,6 +42,8 @@
 
 #pragma once
 
+#include "navigation.h"
+
 #include <dataman/dataman.h>
 #include <uORB/topics/mission.h>
 #include <px4_platform_common/module_params.h>
@@ -54,6 +56,14 @@ class MissionFeasibilityChecker: public ModuleParams
 private:
 	Navigator *_navigator{nullptr};
 
+	/* Copy of the mission items while checking, the checks below iterate the mission several times */
+	mission_item_s *_mission_items{nullptr};
+	size_t _mission_items_count{0};
+
+	void loadMissionItems(const mission_s &mission);
+	void releaseMissionItems();
+	bool readMissionItem(const mission_s &mission, size_t index, mission_item_s &mission_item) const;
+
 	/* Checks for all airframes */
 	bool checkGeofence(const mission_s &mission, float home_alt, bool home_valid);
 
@@ -79,7 +89,7 @@ private:
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator) : ModuleParams(nullptr), _navigator(navigator) {}
-	~MissionFeasibilityChecker() = default;
+	~MissionFeasibilityChecker() { releaseMissionItems(); }
 
 	MissionFeasibilityChecker(const MissionFeasibilityChecker &) = delete;
 	MissionFeasibilityChecker &operator=(const MissionFeasibilityChecker &) = delete;
@@ -54,6 +54,7 @@
 #include "navigation.h"
 
 #include "GeofenceBreachAvoidance/geofence_breach_avoidance.h"
+#include "TrafficTable/traffic_table.h"
 
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/module.h>
@@ -61,6 +62,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/SubscriptionReadySet.hpp>
 #include <uORB/topics/geofence_result.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/mission.h>
@@ -147,10 +149,6 @@ public:
 	 */
 	void check_traffic();
 
-	/**
-	 * Buffer for air traffic to control the amount of messages sent to a user
-	 */
-	bool buffer_air_traffic(uint32_t icao_address);
 
 	/**
 	 * Setters
@@ -326,14 +324,11 @@ public:
 
 private:
 
-	struct traffic_buffer_s {
-		uint32_t 	icao_address;
-		hrt_abstime timestamp;
-	};
-
-	int _local_pos_sub{-1};
-	int _mission_sub{-1};
-	int _vehicle_status_sub{-1};
+	// wakeup sources of the main loop
+	uORB::ReadySet _wakeup_set;
+	uORB::SubscriptionReady _local_pos_sub{_wakeup_set, ORB_ID(vehicle_local_position), 50_ms}; // rate-limited to 20 Hz
+	uORB::SubscriptionReady _vehicle_status_sub{_wakeup_set, ORB_ID(vehicle_status)};
+	uORB::SubscriptionReady _mission_sub{_wakeup_set, ORB_ID(mission)};
 
 	uORB::SubscriptionData<position_controller_status_s>	_position_controller_status_sub{ORB_ID(position_controller_status)};
 
@@ -414,7 +409,11 @@ private:
 	bool _mission_landing_in_progress{false};	/**< this flag gets set if the mission is currently executing on a landing pattern
 							 * if mission mode is inactive, this flag will be cleared after 2 seconds */
 
-	traffic_buffer_s _traffic_buffer{};
+	static constexpr hrt_abstime TRAFFIC_CHECK_INTERVAL{100_ms};	/**< conflict check rate of the traffic table */
+	static constexpr hrt_abstime TRAFFIC_TIMEOUT{10_s};		/**< tracks without report are removed after */
+
+	TrafficTable _traffic_table;
+	hrt_abstime _traffic_check_last{0};
 
 	bool _is_capturing_images{false}; // keep track if we need to stop capturing images
 
@@ -447,6 +446,7 @@ private:
 		(ParamInt<px4::params::NAV_TRAFF_AVOID>)    _param_nav_traff_avoid,	/**< avoiding other aircraft is enabled */
 		(ParamFloat<px4::params::NAV_TRAFF_A_RADU>) _param_nav_traff_a_radu,	/**< avoidance Distance Unmanned*/
 		(ParamFloat<px4::params::NAV_TRAFF_A_RADM>) _param_nav_traff_a_radm,	/**< avoidance Distance Manned*/
+		(ParamFloat<px4::params::NAV_TRAFF_COLL_T>) _param_nav_traff_coll_t,	/**< conflict prediction horizon */
 
 		// non-navigator parameters: Mission (MIS_*)
 		(ParamFloat<px4::params::MIS_LTRMIN_ALT>)  _param_mis_ltrmin_alt,
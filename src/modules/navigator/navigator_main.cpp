@@ -94,10 +94,6 @@ Navigator::Navigator() :
 	_handle_mpc_jerk_auto = param_find("MPC_JERK_AUTO");
 	_handle_mpc_acc_hor = param_find("MPC_ACC_HOR");
 
-	_local_pos_sub = orb_subscribe(ORB_ID(vehicle_local_position));
-	_mission_sub = orb_subscribe(ORB_ID(mission));
-	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
-
 	// Update the timeout used in mission_block (which can't hold it's own parameters)
 	_mission.set_payload_deployment_timeout(_param_mis_payload_delivery_timeout.get());
 
@@ -107,9 +103,6 @@ Navigator::Navigator() :
 Navigator::~Navigator()
 {
 	perf_free(_loop_perf);
-	orb_unsubscribe(_local_pos_sub);
-	orb_unsubscribe(_mission_sub);
-	orb_unsubscribe(_vehicle_status_sub);
 }
 
 void Navigator::params_update()
@@ -150,44 +143,20 @@ void Navigator::run()
 
 	params_update();
 
-	/* wakeup source(s) */
-	px4_pollfd_struct_t fds[3] {};
-
-	/* Setup of loop */
-	fds[0].fd = _local_pos_sub;
-	fds[0].events = POLLIN;
-	fds[1].fd = _vehicle_status_sub;
-	fds[1].events = POLLIN;
-	fds[2].fd = _mission_sub;
-	fds[2].events = POLLIN;
-
-	/* rate-limit position subscription to 20 Hz / 50 ms */
-	orb_set_interval(_local_pos_sub, 50);
-
 	while (!should_exit()) {
 
-		/* wait for up to 1000ms for data */
-		int pret = px4_poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 1000);
-
-		if (pret == 0) {
-			/* Let the loop run anyway, don't do `continue` here. */
-
-		} else if (pret < 0) {
-			/* this is undesirable but not much we can do - might want to flag unhappy status */
-			PX4_ERR("poll error %d, %d", pret, errno);
-			px4_usleep(10000);
-			continue;
-		}
+		/* wait for up to 1000ms for data, let the loop run anyway on timeout */
+		_wakeup_set.wait(1_s);
 
 		perf_begin(_loop_perf);
 
-		orb_copy(ORB_ID(vehicle_local_position), _local_pos_sub, &_local_pos);
-		orb_copy(ORB_ID(vehicle_status), _vehicle_status_sub, &_vstatus);
+		_local_pos_sub.copy(&_local_pos);
+		_vehicle_status_sub.copy(&_vstatus);
 
-		if (fds[2].revents & POLLIN) {
+		if (_mission_sub.updated()) {
 			// copy mission to clear any update
 			mission_s mission;
-			orb_copy(ORB_ID(mission), _mission_sub, &mission);
+			_mission_sub.copy(&mission);
 		}
 
 		/* gps updated */
@@ -1173,226 +1142,164 @@ void Navigator::fake_traffic(const char *callsign, float distance, float directi
 
 void Navigator::check_traffic()
 {
-	double lat = get_global_position()->lat;
-	double lon = get_global_position()->lon;
-	float alt = get_global_position()->alt;
+	const hrt_abstime now = hrt_absolute_time();
+	const double lat = get_global_position()->lat;
+	const double lon = get_global_position()->lon;
 
-	// TODO for non-multirotors predicting the future
-	// position as accurately as possible will become relevant
-	// float vel_n = get_global_position()->vel_n;
-	// float vel_e = get_global_position()->vel_e;
-	// float vel_d = get_global_position()->vel_d;
+	// add the new reports to the traffic table
+	transponder_report_s tr;
+
+	while (_traffic_sub.update(&tr)) {
+		_traffic_table.update(tr, lat, lon);
+	}
 
-	bool changed = _traffic_sub.updated();
+	if (_traffic_table.size() == 0 || (now < _traffic_check_last + TRAFFIC_CHECK_INTERVAL)) {
+		return;
+	}
 
-	char uas_id[11]; //GUID of incoming UTM messages
+	// check all tracks at a fixed rate
+	_traffic_check_last = now;
+	_traffic_table.removeStale(now, TRAFFIC_TIMEOUT);
 
-	float NAVTrafficAvoidUnmanned = _param_nav_traff_a_radu.get();
-	float NAVTrafficAvoidManned = _param_nav_traff_a_radm.get();
-	float horizontal_separation = NAVTrafficAvoidManned;
-	float vertical_separation = NAVTrafficAvoidManned;
+	TrafficTable::OwnState own{};
+	own.lat = lat;
+	own.lon = lon;
+	own.alt = get_global_position()->alt;
 
-	while (changed) {
+	if (_local_pos.v_xy_valid && _local_pos.v_z_valid) {
+		own.vel_n = _local_pos.vx;
+		own.vel_e = _local_pos.vy;
+		own.vel_u = -_local_pos.vz;
+	}
 
-		//vehicle_status_s vs{};
-		transponder_report_s tr{};
-		_traffic_sub.copy(&tr);
+	TrafficTable::Conflict conflicts[8];
+	const int n_conflicts = _traffic_table.checkConflicts(own, now, _param_nav_traff_a_radm.get(),
+				_param_nav_traff_a_radu.get(), _param_nav_traff_coll_t.get(), conflicts, sizeof(conflicts) / sizeof(conflicts[0]));
 
-		uint16_t required_flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS |
-					  transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING |
-					  transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY | transponder_report_s::PX4_ADSB_FLAGS_VALID_ALTITUDE;
+	for (int i = 0; i < n_conflicts; i++) {
+		TrafficTable::Track &track = _traffic_table.track(conflicts[i].index);
 
-		if ((tr.flags & required_flags) != required_flags) {
-			changed = _traffic_sub.updated();
+		// alert once per aircraft and minute
+		if ((track.last_alert != 0) && (now < track.last_alert + 60_s)) {
 			continue;
 		}
 
-		//convert UAS_id byte array to char array for User Warning
-		for (int i = 0; i < 5; i++) {
-			snprintf(&uas_id[i * 2], sizeof(uas_id) - i * 2, "%02x", tr.uas_id[PX4_GUID_BYTE_LENGTH - 5 + i]);
-		}
+		track.last_alert = now;
 
-		uint64_t uas_id_int = 0;
+		//convert UAS_id (last 5 bytes) to char array for User Warning
+		char uas_id[11];
 
-		for (int i = 0; i < 8; i++) {
-			uas_id_int |= (uint64_t)(tr.uas_id[PX4_GUID_BYTE_LENGTH - i - 1]) << (i * 8);
+		for (int j = 0; j < 5; j++) {
+			snprintf(&uas_id[j * 2], sizeof(uas_id) - j * 2, "%02x", (unsigned)(track.uas_id >> ((4 - j) * 8)) & 0xff);
 		}
 
-		//Manned/Unmanned Vehicle Seperation Distance
-		if (tr.emitter_type == transponder_report_s::ADSB_EMITTER_TYPE_UAV) {
-			horizontal_separation = NAVTrafficAvoidUnmanned;
-			vertical_separation = NAVTrafficAvoidUnmanned;
-		}
+		// direction of traffic in human-readable 0..360 degree in earth frame
+		int traffic_direction = math::degrees(track.heading) + 180;
+		int traffic_seperation = (int)fabsf(conflicts[i].distance);
 
-		float d_hor, d_vert;
-		get_distance_to_point_global_wgs84(lat, lon, alt,
-						   tr.lat, tr.lon, tr.altitude, &d_hor, &d_vert);
+		switch (_param_nav_traff_avoid.get()) {
 
+		case 0: {
+				/* Ignore */
+				PX4_WARN("TRAFFIC %s! dst %d, hdg %d",
+					 track.callsign_valid ? track.callsign : uas_id,
+					 traffic_seperation,
+					 traffic_direction);
+				break;
+			}
 
-		// predict final altitude (positive is up) in prediction time frame
-		float end_alt = tr.altitude + (d_vert / tr.hor_velocity) * tr.ver_velocity;
-
-		// Predict until the vehicle would have passed this system at its current speed
-		float prediction_distance = d_hor + 1000.0f;
-
-		// If the altitude is not getting close to us, do not calculate
-		// the horizontal separation.
-		// Since commercial flights do most of the time keep flight levels
-		// check for the current and for the predicted flight level.
-		// we also make the implicit assumption that this system is on the lowest
-		// flight level close to ground in the
-		// (end_alt - horizontal_separation < alt) condition. If this system should
-		// ever be used in normal airspace this implementation would anyway be
-		// inappropriate as it should be replaced with a TCAS compliant solution.
-
-		if ((fabsf(alt - tr.altitude) < vertical_separation) || ((end_alt - horizontal_separation) < alt)) {
-
-			double end_lat, end_lon;
-			waypoint_from_heading_and_distance(tr.lat, tr.lon, tr.heading, prediction_distance, &end_lat, &end_lon);
-
-			struct crosstrack_error_s cr;
-
-			if (!get_distance_to_line(&cr, lat, lon, tr.lat, tr.lon, end_lat, end_lon)) {
-
-				if (!cr.past_end && (fabsf(cr.distance) < horizontal_separation)) {
-
-					bool action_needed = buffer_air_traffic(tr.icao_address);
-
-					if (action_needed) {
-						// direction of traffic in human-readable 0..360 degree in earth frame
-						int traffic_direction = math::degrees(tr.heading) + 180;
-						int traffic_seperation = (int)fabsf(cr.distance);
-
-						switch (_param_nav_traff_avoid.get()) {
-
-						case 0: {
-								/* Ignore */
-								PX4_WARN("TRAFFIC %s! dst %d, hdg %d",
-									 tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-									 traffic_seperation,
-									 traffic_direction);
-								break;
-							}
+		case 1: {
+				/* Warn only */
+				mavlink_log_critical(&_mavlink_log_pub, "Warning TRAFFIC %s! dst %d, hdg %d\t",
+						     track.callsign_valid ? track.callsign : uas_id,
+						     traffic_seperation,
+						     traffic_direction);
+				/* EVENT
+				 * @description
+				 * - ID: {1}
+				 * - Distance: {2m}
+				 * - Direction: {3} degrees
+				 */
+				events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic"), events::Log::Critical, "Traffic alert",
+						track.uas_id, traffic_seperation, traffic_direction);
+				break;
+			}
 
-						case 1: {
-								/* Warn only */
-								mavlink_log_critical(&_mavlink_log_pub, "Warning TRAFFIC %s! dst %d, hdg %d\t",
-										     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-										     traffic_seperation,
-										     traffic_direction);
-								/* EVENT
-								 * @description
-								 * - ID: {1}
-								 * - Distance: {2m}
-								 * - Direction: {3} degrees
-								 */
-								events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic"), events::Log::Critical, "Traffic alert",
-										uas_id_int, traffic_seperation, traffic_direction);
-								break;
-							}
+		case 2: {
+				/* RTL Mode */
+				mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Returning home! dst %d, hdg %d\t",
+						     track.callsign_valid ? track.callsign : uas_id,
+						     traffic_seperation,
+						     traffic_direction);
+				/* EVENT
+				 * @description
+				 * - ID: {1}
+				 * - Distance: {2m}
+				 * - Direction: {3} degrees
+				 */
+				events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_rtl"), events::Log::Critical,
+						"Traffic alert, returning home",
+						track.uas_id, traffic_seperation, traffic_direction);
 
-						case 2: {
-								/* RTL Mode */
-								mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Returning home! dst %d, hdg %d\t",
-										     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-										     traffic_seperation,
-										     traffic_direction);
-								/* EVENT
-								 * @description
-								 * - ID: {1}
-								 * - Distance: {2m}
-								 * - Direction: {3} degrees
-								 */
-								events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_rtl"), events::Log::Critical,
-										"Traffic alert, returning home",
-										uas_id_int, traffic_seperation, traffic_direction);
-
-								// set the return altitude to minimum
-								_rtl.set_return_alt_min(true);
-
-								// ask the commander to execute an RTL
-								vehicle_command_s vcmd = {};
-								vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_RETURN_TO_LAUNCH;
-								publish_vehicle_cmd(&vcmd);
-								break;
-							}
+				// set the return altitude to minimum
+				_rtl.set_return_alt_min(true);
 
-						case 3: {
-								/* Land Mode */
-								mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Landing! dst %d, hdg % d\t",
-										     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-										     traffic_seperation,
-										     traffic_direction);
-								/* EVENT
-								 * @description
-								 * - ID: {1}
-								 * - Distance: {2m}
-								 * - Direction: {3} degrees
-								 */
-								events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_land"), events::Log::Critical,
-										"Traffic alert, landing",
-										uas_id_int, traffic_seperation, traffic_direction);
-
-								// ask the commander to land
-								vehicle_command_s vcmd = {};
-								vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LAND;
-								publish_vehicle_cmd(&vcmd);
-								break;
+				// ask the commander to execute an RTL
+				vehicle_command_s vcmd = {};
+				vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_RETURN_TO_LAUNCH;
+				publish_vehicle_cmd(&vcmd);
+				break;
+			}
 
-							}
+		case 3: {
+				/* Land Mode */
+				mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Landing! dst %d, hdg % d\t",
+						     track.callsign_valid ? track.callsign : uas_id,
+						     traffic_seperation,
+						     traffic_direction);
+				/* EVENT
+				 * @description
+				 * - ID: {1}
+				 * - Distance: {2m}
+				 * - Direction: {3} degrees
+				 */
+				events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_land"), events::Log::Critical,
+						"Traffic alert, landing",
+						track.uas_id, traffic_seperation, traffic_direction);
 
-						case 4: {
-								/* Position hold */
-								mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Holding position! dst %d, hdg %d\t",
-										     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-										     traffic_seperation,
-										     traffic_direction);
-								/* EVENT
-								 * @description
-								 * - ID: {1}
-								 * - Distance: {2m}
-								 * - Direction: {3} degrees
-								 */
-								events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_hold"), events::Log::Critical,
-										"Traffic alert, holding position",
-										uas_id_int, traffic_seperation, traffic_direction);
-
-								// ask the commander to Loiter
-								vehicle_command_s vcmd = {};
-								vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LOITER_UNLIM;
-								publish_vehicle_cmd(&vcmd);
-								break;
+				// ask the commander to land
+				vehicle_command_s vcmd = {};
+				vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LAND;
+				publish_vehicle_cmd(&vcmd);
+				break;
 
-							}
-						}
-					}
-				}
 			}
-		}
-
-		changed = _traffic_sub.updated();
-	}
-}
-
-bool Navigator::buffer_air_traffic(uint32_t icao_address)
-{
-	bool action_needed = true;
 
-	if (_traffic_buffer.icao_address == icao_address) {
+		case 4: {
+				/* Position hold */
+				mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Holding position! dst %d, hdg %d\t",
+						     track.callsign_valid ? track.callsign : uas_id,
+						     traffic_seperation,
+						     traffic_direction);
+				/* EVENT
+				 * @description
+				 * - ID: {1}
+				 * - Distance: {2m}
+				 * - Direction: {3} degrees
+				 */
+				events::send<uint64_t, int32_t, int16_t>(events::ID("navigator_traffic_hold"), events::Log::Critical,
+						"Traffic alert, holding position",
+						track.uas_id, traffic_seperation, traffic_direction);
 
-		if (hrt_elapsed_time(&_traffic_buffer.timestamp) > 60_s) {
-			_traffic_buffer.timestamp = hrt_absolute_time();
+				// ask the commander to Loiter
+				vehicle_command_s vcmd = {};
+				vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LOITER_UNLIM;
+				publish_vehicle_cmd(&vcmd);
+				break;
 
-		} else {
-			action_needed = false;
+			}
 		}
-
-	} else {
-		_traffic_buffer.timestamp = hrt_absolute_time();
-		_traffic_buffer.icao_address = icao_address;
 	}
-
-	return action_needed;
 }
 
 bool Navigator::abort_landing()
@@ -154,6 +154,20 @@ PARAM_DEFINE_FLOAT(NAV_TRAFF_A_RADM, 500);
  */
 PARAM_DEFINE_FLOAT(NAV_TRAFF_A_RADU, 10);
 
+/**
+ * Set NAV TRAFFIC AVOID prediction horizon
+ *
+ * Traffic is checked for a loss of separation (NAV_TRAFF_A_RADM/NAV_TRAFF_A_RADU)
+ * within this time, assuming constant velocity of the traffic and the vehicle.
+ *
+ * @unit s
+ * @min 1
+ * @max 600
+ * @decimal 0
+ * @group Mission
+ */
+PARAM_DEFINE_FLOAT(NAV_TRAFF_COLL_T, 60);
+
 /**
  * Airfield home Lat
  *
@@ -167,26 +167,15 @@ void RTL::find_RTL_destination()
 	}
 
 	// compare to safe landing positions
-	mission_safe_point_s closest_safe_point {};
-	mission_stats_entry_s stats;
-	int ret = dm_read(DM_KEY_SAFE_POINTS, 0, &stats, sizeof(mission_stats_entry_s));
-	int num_safe_points = 0;
+	updateSafePoints();
 
-	if (ret == sizeof(mission_stats_entry_s)) {
-		num_safe_points = stats.num_items;
-	}
+	mission_safe_point_s closest_safe_point {};
 
 	// check if a safe point is closer than home or landing
 	int closest_index = 0;
 
-	for (int current_seq = 1; current_seq <= num_safe_points; ++current_seq) {
-		mission_safe_point_s mission_safe_point;
-
-		if (dm_read(DM_KEY_SAFE_POINTS, current_seq, &mission_safe_point, sizeof(mission_safe_point_s)) !=
-		    sizeof(mission_safe_point_s)) {
-			PX4_ERR("dm_read failed");
-			continue;
-		}
+	for (int current_seq = 1; current_seq <= _num_safe_points; ++current_seq) {
+		const mission_safe_point_s &mission_safe_point = _safe_points[current_seq - 1];
 
 		// TODO: take altitude into account for distance measurement
 		dlat = mission_safe_point.lat - global_position.lat;
@@ -236,6 +225,41 @@ void RTL::find_RTL_destination()
 	}
 }
 
+void RTL::updateSafePoints()
+{
+	// a single read of the stats entry, the items are only read again after a rally point transfer
+	mission_stats_entry_s stats;
+
+	if (dm_read(DM_KEY_SAFE_POINTS, 0, &stats, sizeof(mission_stats_entry_s)) != sizeof(mission_stats_entry_s)) {
+		_num_safe_points = 0;
+		_safe_points_loaded = false;
+		return;
+	}
+
+	if (_safe_points_loaded && (stats.update_counter == _safe_points_update_counter)) {
+		return;
+	}
+
+	const int num_items = math::min(static_cast<int>(stats.num_items), static_cast<int>(DM_KEY_SAFE_POINTS_MAX - 1));
+	bool read_failed = false;
+	_num_safe_points = 0;
+
+	for (int current_seq = 1; current_seq <= num_items; ++current_seq) {
+		if (dm_read(DM_KEY_SAFE_POINTS, current_seq, &_safe_points[_num_safe_points], sizeof(mission_safe_point_s)) !=
+		    sizeof(mission_safe_point_s)) {
+			PX4_ERR("dm_read failed");
+			read_failed = true;
+			continue;
+		}
+
+		_num_safe_points++;
+	}
+
+	// try again on the next call if an item could not be read
+	_safe_points_update_counter = stats.update_counter;
+	_safe_points_loaded = !read_failed;
+}
+
 void RTL::on_activation()
 {
 	_rtl_state = RTL_STATE_NONE;
@@ -46,6 +46,7 @@
 #include "navigator_mode.h"
 #include "mission_block.h"
 
+#include <dataman/dataman.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/rtl_time_estimate.h>
@@ -120,6 +121,11 @@ private:
 
 	void advance_rtl();
 
+	/**
+	 * Reload the RAM copy of the safe points if the dataman update counter changed.
+	 */
+	void updateSafePoints();
+
 	float calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg);
 	void calc_and_pub_rtl_time_estimate(const RTLState rtl_state);
 
@@ -158,6 +164,11 @@ private:
 
 	hrt_abstime _destination_check_time{0};
 
+	mission_safe_point_s _safe_points[DM_KEY_SAFE_POINTS_MAX - 1] {}; ///< RAM copy of the safe points (dataman item 0 is the stats entry)
+	int _num_safe_points{0};
+	uint16_t _safe_points_update_counter{0};
+	bool _safe_points_loaded{false};
+
 	float _rtl_alt{0.0f};	// AMSL altitude at which the vehicle should return to the home position
 
 	bool _rtl_alt_min{false};
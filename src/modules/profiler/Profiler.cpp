@@ -0,0 +1,495 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "Profiler.hpp"
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__PX4_NUTTX)
+# include <nuttx/irq.h> // CURRENT_REGS, REG_PC, REG_LR
+# if defined(REG_PC) && defined(REG_LR)
+#  define PROFILER_SUPPORTED 1
+# endif
+#elif defined(__PX4_LINUX)
+# include <sys/syscall.h>
+# include <sys/time.h>
+# include <ucontext.h>
+# if defined(__x86_64__) || defined(__aarch64__) || defined(__arm__)
+#  define PROFILER_SUPPORTED 1
+# endif
+// text segment bounds of the executable (GNU linker)
+extern char __executable_start;
+extern char etext;
+#endif
+
+using namespace time_literals;
+
+namespace profiler
+{
+
+Profiler::Sample Profiler::_ring[RING_SIZE] {};
+px4::atomic<uint32_t> Profiler::_ring_head{0};
+px4::atomic<uint32_t> Profiler::_ring_tail{0};
+px4::atomic<uint32_t> Profiler::_ring_dropped{0};
+
+#if defined(__PX4_NUTTX)
+struct hrt_call Profiler::_hrt_call {};
+uint32_t Profiler::_interval_us{0};
+uint32_t Profiler::_jitter_state{0x12345678};
+#elif defined(__PX4_POSIX)
+px4::atomic_bool Profiler::_in_handler{false};
+#endif
+
+Profiler::Profiler(uint32_t rate_hz, bool publish) :
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default),
+	_rate_hz(rate_hz),
+	_publish(publish)
+{
+}
+
+Profiler::~Profiler()
+{
+	ScheduleClear();
+	stopSampling();
+}
+
+bool Profiler::init()
+{
+	// discard anything left from a previous run
+	_ring_tail.store(_ring_head.load());
+	_dropped_last = _ring_dropped.load();
+
+	if (!startSampling()) {
+		return false;
+	}
+
+	_start_time = hrt_absolute_time();
+	ScheduleOnInterval(50_ms);
+	return true;
+}
+
+void Profiler::record(uint32_t pc, uint32_t lr, uint32_t pid)
+{
+	// single producer: the HRT interrupt does not nest, the signal handler is guarded by _in_handler
+	const uint32_t head = _ring_head.load();
+
+	if (head - _ring_tail.load() >= RING_SIZE) {
+		_ring_dropped.fetch_add(1);
+		return;
+	}
+
+	_ring[head & (RING_SIZE - 1)] = Sample{pc, lr, pid};
+	_ring_head.store(head + 1);
+}
+
+#if defined(__PX4_NUTTX)
+
+uint32_t Profiler::nextInterval()
+{
+	// xorshift32, uniformly distributed in [interval/2, interval*3/2)
+	_jitter_state ^= _jitter_state << 13;
+	_jitter_state ^= _jitter_state >> 17;
+	_jitter_state ^= _jitter_state << 5;
+	return _interval_us / 2 + _jitter_state % _interval_us;
+}
+
+void Profiler::hrtCallback(void *arg)
+{
+#if defined(PROFILER_SUPPORTED)
+	// registers of the code the HRT interrupt preempted
+	const uint32_t *regs = (const uint32_t *)CURRENT_REGS;
+
+	if (regs != nullptr) {
+		record(regs[REG_PC], regs[REG_LR], getpid());
+	}
+
+#endif // PROFILER_SUPPORTED
+
+	// Randomize the interval, otherwise the samples alias with everything else that is scheduled
+	// periodically from the HRT (which would then always or never be seen).
+	hrt_call_after(&_hrt_call, nextInterval(), &Profiler::hrtCallback, nullptr);
+}
+
+bool Profiler::startSampling()
+{
+#if defined(PROFILER_SUPPORTED)
+	_interval_us = 1000000 / _rate_hz;
+	hrt_call_after(&_hrt_call, _interval_us, &Profiler::hrtCallback, nullptr);
+	return true;
+#else
+	PX4_ERR("not supported on this architecture");
+	return false;
+#endif // PROFILER_SUPPORTED
+}
+
+void Profiler::stopSampling()
+{
+	hrt_cancel(&_hrt_call);
+}
+
+#elif defined(__PX4_POSIX)
+
+void Profiler::signalHandler(int signo, siginfo_t *info, void *context)
+{
+#if defined(PROFILER_SUPPORTED)
+	// SIGPROF can hit several threads at the same time
+	bool expected = false;
+
+	if (!_in_handler.compare_exchange(&expected, true)) {
+		_ring_dropped.fetch_add(1);
+		return;
+	}
+
+	const ucontext_t *uc = (const ucontext_t *)context;
+	uintptr_t pc = 0;
+	uintptr_t lr = 0;
+
+#if defined(__x86_64__)
+	pc = uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+	pc = uc->uc_mcontext.pc;
+	lr = uc->uc_mcontext.regs[30];
+#elif defined(__arm__)
+	pc = uc->uc_mcontext.arm_pc;
+	lr = uc->uc_mcontext.arm_lr;
+#endif
+
+	// store offsets into the executable so the samples can be resolved against the (PIE) ELF,
+	// code outside of it (shared libraries, vdso) is recorded as 0
+	const uintptr_t text_start = (uintptr_t)&__executable_start;
+	const uintptr_t text_end = (uintptr_t)&etext;
+
+	const uint32_t pc_offset = (pc >= text_start && pc < text_end) ? pc - text_start : 0;
+	const uint32_t lr_offset = (lr >= text_start && lr < text_end) ? lr - text_start : 0;
+
+	record(pc_offset, lr_offset, (uint32_t)syscall(SYS_gettid));
+
+	_in_handler.store(false);
+#endif // PROFILER_SUPPORTED
+}
+
+bool Profiler::startSampling()
+{
+#if defined(PROFILER_SUPPORTED)
+	struct sigaction action {};
+	action.sa_sigaction = &Profiler::signalHandler;
+	action.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	if (sigaction(SIGPROF, &action, &_previous_action) != 0) {
+		PX4_ERR("sigaction failed (%i)", errno);
+		return false;
+	}
+
+	// ITIMER_PROF counts the CPU time of the whole process, the signal is delivered to a running thread
+	struct itimerval timer {};
+	timer.it_interval.tv_usec = 1000000 / _rate_hz;
+	timer.it_value = timer.it_interval;
+
+	if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+		PX4_ERR("setitimer failed (%i)", errno);
+		sigaction(SIGPROF, &_previous_action, nullptr);
+		return false;
+	}
+
+	return true;
+#else
+	PX4_ERR("not supported on this platform");
+	return false;
+#endif // PROFILER_SUPPORTED
+}
+
+void Profiler::stopSampling()
+{
+#if defined(PROFILER_SUPPORTED)
+	struct itimerval timer {};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	sigaction(SIGPROF, &_previous_action, nullptr);
+#endif // PROFILER_SUPPORTED
+}
+
+#endif
+
+void Profiler::addToHistogram(uint32_t pc)
+{
+	// open addressing with a short linear probe, entries are never removed
+	uint32_t index = (pc * 2654435761u) & (HISTOGRAM_SIZE - 1);
+
+	for (int probe = 0; probe < 8; probe++) {
+		HistogramEntry &entry = _histogram[index];
+
+		if (entry.count == 0) {
+			entry.pc = pc;
+			entry.count = 1;
+			return;
+
+		} else if (entry.pc == pc) {
+			entry.count++;
+			return;
+		}
+
+		index = (index + 1) & (HISTOGRAM_SIZE - 1);
+	}
+
+	_histogram_overflow++;
+}
+
+void Profiler::Run()
+{
+	if (should_exit()) {
+		ScheduleClear();
+		exit_and_cleanup();
+		return;
+	}
+
+	const uint32_t head = _ring_head.load();
+	uint32_t tail = _ring_tail.load();
+
+	const uint32_t dropped = _ring_dropped.load();
+	_samples.dropped += dropped - _dropped_last;
+	_dropped_total += dropped - _dropped_last;
+	_dropped_last = dropped;
+
+	while (tail != head) {
+		const Sample &sample = _ring[tail & (RING_SIZE - 1)];
+
+		addToHistogram(sample.pc);
+
+		if (_publish) {
+			_samples.pc[_samples.count] = sample.pc;
+			_samples.lr[_samples.count] = sample.lr;
+			_samples.pid[_samples.count] = sample.pid;
+			_samples.count++;
+
+			if (_samples.count == BATCH_SIZE) {
+				publishSamples();
+			}
+		}
+
+		tail++;
+		_sample_count++;
+	}
+
+	// release the slots only after they have been read
+	_ring_tail.store(tail);
+
+	if (_publish && (_samples.count > 0)) {
+		publishSamples();
+	}
+}
+
+void Profiler::publishSamples()
+{
+	_samples.sample_interval_us = 1000000 / _rate_hz;
+	_samples.timestamp = hrt_absolute_time();
+	_profiler_samples_pub.publish(_samples);
+	_samples.count = 0;
+	_samples.dropped = 0;
+}
+
+int Profiler::dump(const char *file)
+{
+	int fd = ::open(file, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open %s (%i)", file, errno);
+		return PX4_ERROR;
+	}
+
+	dprintf(fd, "# samples: %" PRIu64 ", dropped: %" PRIu32 ", overflow: %" PRIu32 ", interval: %" PRIu32 " us\n",
+		_sample_count, _dropped_total, _histogram_overflow, 1000000 / _rate_hz);
+
+	for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+		if (_histogram[i].count > 0) {
+			dprintf(fd, "0x%08" PRIx32 " %" PRIu32 "\n", _histogram[i].pc, _histogram[i].count);
+		}
+	}
+
+	::close(fd);
+	PX4_INFO("wrote %s", file);
+	return PX4_OK;
+}
+
+int Profiler::print_status()
+{
+	const float elapsed = hrt_elapsed_time(&_start_time) * 1e-6f;
+
+	PX4_INFO("rate: %" PRIu32 " Hz, running for %.1f s%s", _rate_hz, (double)elapsed, _publish ? ", publishing" : "");
+	PX4_INFO("samples: %" PRIu64 ", dropped: %" PRIu32 ", histogram overflow: %" PRIu32,
+		 _sample_count, _dropped_total, _histogram_overflow);
+
+	if (_sample_count == 0) {
+		return 0;
+	}
+
+	// print the top entries, in descending order of (count, pc)
+	PX4_INFO_RAW("         pc    count       %%\n");
+	uint32_t last_count = UINT32_MAX;
+	uint32_t last_pc = UINT32_MAX;
+
+	for (int n = 0; n < 10; n++) {
+		const HistogramEntry *top = nullptr;
+
+		for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+			const HistogramEntry &entry = _histogram[i];
+
+			const bool below_last = (entry.count < last_count) || (entry.count == last_count && entry.pc < last_pc);
+
+			if ((entry.count > 0) && below_last
+			    && ((top == nullptr) || (entry.count > top->count) || (entry.count == top->count && entry.pc > top->pc))) {
+				top = &entry;
+			}
+		}
+
+		if (top == nullptr) {
+			break;
+		}
+
+		PX4_INFO_RAW(" 0x%08" PRIx32 " %8" PRIu32 " %6.2f%%\n", top->pc, top->count, (double)(100.f * top->count / _sample_count));
+		last_count = top->count;
+		last_pc = top->pc;
+	}
+
+	return 0;
+}
+
+int Profiler::task_spawn(int argc, char *argv[])
+{
+	uint32_t rate_hz = 500;
+	bool publish = false;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "r:p", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'r':
+			rate_hz = strtoul(myoptarg, nullptr, 10);
+			break;
+
+		case 'p':
+			publish = true;
+			break;
+
+		default:
+			return print_usage("unrecognized flag");
+		}
+	}
+
+	if (rate_hz < 10 || rate_hz > 5000) {
+		return print_usage("rate out of range");
+	}
+
+	Profiler *instance = new Profiler(rate_hz, publish);
+
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (instance->init()) {
+			return PX4_OK;
+		}
+
+	} else {
+		PX4_ERR("alloc failed");
+	}
+
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
+}
+
+int Profiler::custom_command(int argc, char *argv[])
+{
+	if (!is_running()) {
+		return print_usage("profiler not running");
+	}
+
+	if (!strcmp(argv[0], "dump") && argc > 1) {
+		return get_instance()->dump(argv[1]);
+	}
+
+	return print_usage("unknown command");
+}
+
+int Profiler::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_ERR("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Statistical profiler. The program counter of the interrupted code is sampled from the HRT interrupt
+(NuttX) or a `SIGPROF` timer (Linux) at a randomized interval. The samples are accumulated into a histogram,
+and optionally published as `profiler_samples`, which the logger records with the debug profile.
+
+The addresses are resolved offline against the ELF of the same build with `Tools/profiler_report.py`,
+either from a histogram written with `dump` or from a log file.
+On Linux the addresses are offsets into the executable and code in shared libraries is reported as 0.
+
+### Example
+$ profiler start -r 1000
+$ profiler dump /fs/microsd/profile.txt
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("profiler", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start sampling");
+	PRINT_MODULE_USAGE_PARAM_INT('r', 500, 10, 5000, "Sampling rate in Hz", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('p', "Publish the samples (profiler_samples topic)", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Write the histogram to a file");
+	PRINT_MODULE_USAGE_ARG("<file>", "Output file", false);
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+	return 0;
+}
+
+extern "C" __EXPORT int profiler_main(int argc, char *argv[])
+{
+	return Profiler::main(argc, argv);
+}
+
+} // namespace profiler
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file Profiler.hpp
+ *
+ * Statistical profiler: the interrupted program counter is sampled from the HRT
+ * interrupt (NuttX) or a SIGPROF timer (POSIX) into a lock-free ring buffer, which is
+ * drained on the low priority work queue into a histogram and the profiler_samples topic.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/profiler_samples.h>
+
+#if defined(__PX4_POSIX)
+#include <signal.h>
+#endif
+
+namespace profiler
+{
+
+class Profiler : public ModuleBase<Profiler>, public px4::ScheduledWorkItem
+{
+public:
+	Profiler(uint32_t rate_hz, bool publish);
+	~Profiler() override;
+
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	bool init();
+
+private:
+	void Run() override;
+
+	bool startSampling();
+	void stopSampling();
+
+	void addToHistogram(uint32_t pc);
+	void publishSamples();
+	int dump(const char *file);
+
+	struct Sample {
+		uint32_t pc;
+		uint32_t lr;
+		uint32_t pid;
+	};
+
+	/** called from the HRT interrupt or the signal handler */
+	static void record(uint32_t pc, uint32_t lr, uint32_t pid);
+
+#if defined(__PX4_NUTTX)
+	static void hrtCallback(void *arg);
+	static uint32_t nextInterval();
+#elif defined(__PX4_POSIX)
+	static void signalHandler(int signo, siginfo_t *info, void *context);
+#endif
+
+	static constexpr uint32_t RING_SIZE = 512; ///< must be a power of 2
+	static Sample _ring[RING_SIZE];
+	static px4::atomic<uint32_t> _ring_head;
+	static px4::atomic<uint32_t> _ring_tail;
+	static px4::atomic<uint32_t> _ring_dropped;
+
+#if defined(__PX4_NUTTX)
+	static struct hrt_call _hrt_call;
+	static uint32_t _interval_us;
+	static uint32_t _jitter_state;
+#elif defined(__PX4_POSIX)
+	static px4::atomic_bool _in_handler;
+	struct sigaction _previous_action {};
+#endif
+
+	struct HistogramEntry {
+		uint32_t pc;
+		uint32_t count;
+	};
+
+	static constexpr int HISTOGRAM_SIZE = 512; ///< must be a power of 2
+	HistogramEntry _histogram[HISTOGRAM_SIZE] {};
+	uint32_t _histogram_overflow{0};
+
+	uint64_t _sample_count{0};
+	uint32_t _dropped_total{0};
+	uint32_t _dropped_last{0};
+	hrt_abstime _start_time{0};
+
+	const uint32_t _rate_hz;
+	const bool _publish;
+
+	static constexpr uint8_t BATCH_SIZE = sizeof(profiler_samples_s::pc) / sizeof(profiler_samples_s::pc[0]);
+	profiler_samples_s _samples{};
+	uORB::Publication<profiler_samples_s> _profiler_samples_pub{ORB_ID(profiler_samples)};
+};
+
+} // namespace profiler
@@ -77,7 +77,7 @@
 
 #define REG_TO_BOOL(_reg) 	((bool)(_reg))
 
-#define PX4IO_PROTOCOL_VERSION		5
+#define PX4IO_PROTOCOL_VERSION		6
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -145,6 +145,13 @@
 /* array of raw ADC values */
 #define PX4IO_PAGE_RAW_ADC_INPUT		6	/* 0..CONFIG_ADC_INPUT_COUNT-1 */
 
+/* reply of a PKT_CODE_EXCHANGE transaction: IO state needed every cycle, saves separate reads */
+#define PX4IO_EXCHANGE_STATUS			0	/* PX4IO_P_STATUS_FLAGS ... PX4IO_P_STATUS_VRSSI */
+#define PX4IO_EXCHANGE_STATUS_COUNT		6
+#define PX4IO_EXCHANGE_RAW_RC			6	/* PX4IO_P_RAW_RC_COUNT ... PX4IO_P_RAW_LOST_FRAME_COUNT */
+#define PX4IO_EXCHANGE_RAW_RC_COUNT		PX4IO_P_RAW_RC_BASE
+#define PX4IO_EXCHANGE_COUNT			(PX4IO_EXCHANGE_STATUS_COUNT + PX4IO_EXCHANGE_RAW_RC_COUNT)
+
 /* PWM servo information */
 #define PX4IO_PAGE_PWM_INFO			7
 #define PX4IO_RATE_MAP_BASE			0	/* 0..CONFIG_ACTUATOR_COUNT bitmaps of PWM rate groups */
@@ -233,6 +240,7 @@ struct IOPacket {
 
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
+#define PKT_CODE_EXCHANGE	0x80	/* FMU->IO write transaction, replied with the exchange registers */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
 #define PKT_CODE_CORRUPT	0x40	/* IO->FMU bad packet reply */
 #define PKT_CODE_ERROR		0x80	/* IO->FMU register op error reply */
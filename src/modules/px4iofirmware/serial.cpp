@@ -194,6 +194,28 @@ rx_handle_packet(void)
 		return;
 	}
 
+	if (PKT_CODE(dma_packet) == PKT_CODE_EXCHANGE) {
+
+		/* a write, the reply carries the status and R/C input state */
+		if (registers_set(dma_packet.page, dma_packet.offset, &dma_packet.regs[0], PKT_COUNT(dma_packet))) {
+#if defined(PX4IO_PERF)
+			perf_count(pc_regerr);
+#endif
+
+			dma_packet.count_code = PKT_CODE_ERROR;
+
+		} else {
+			for (unsigned i = 0; i < PX4IO_EXCHANGE_STATUS_COUNT; i++) {
+				dma_packet.regs[PX4IO_EXCHANGE_STATUS + i] = r_page_status[PX4IO_P_STATUS_FLAGS + i];
+			}
+
+			memcpy((void *)&dma_packet.regs[PX4IO_EXCHANGE_RAW_RC], r_page_raw_rc_input, PX4IO_EXCHANGE_RAW_RC_COUNT * 2);
+			dma_packet.count_code = PX4IO_EXCHANGE_COUNT | PKT_CODE_SUCCESS;
+		}
+
+		return;
+	}
+
 	if (PKT_CODE(dma_packet) == PKT_CODE_READ) {
 
 		/* it's a read - get register pointer for reply */
@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "MappedULogFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <logger/messages.h>
+#include <px4_platform_common/log.h>
+
+namespace px4
+{
+
+MappedFileBuffer::~MappedFileBuffer()
+{
+	if (_data) {
+		munmap(_data, _size);
+	}
+}
+
+bool
+MappedFileBuffer::open(const char *file_name)
+{
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	// the parser mostly reads forward
+	madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+	_data = (char *)data;
+	_size = st.st_size;
+	setg(_data, _data, _data + _size);
+	return true;
+}
+
+MappedFileBuffer::pos_type
+MappedFileBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	off_type position;
+
+	switch (dir) {
+	case std::ios_base::beg: position = off; break;
+
+	case std::ios_base::cur: position = (gptr() - eback()) + off; break;
+
+	case std::ios_base::end: position = (off_type)_size + off; break;
+
+	default: return pos_type(off_type(-1));
+	}
+
+	if (!(which & std::ios_base::in) || position < 0 || position > (off_type)_size) {
+		return pos_type(off_type(-1));
+	}
+
+	setg(_data, _data + position, _data + _size);
+	return pos_type(position);
+}
+
+MappedFileBuffer::pos_type
+MappedFileBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+ULogMessageIndex::~ULogMessageIndex()
+{
+	wait();
+}
+
+bool
+ULogMessageIndex::start(const uint8_t *data, size_t size, size_t start_offset)
+{
+	wait();
+
+	_data = data;
+	_size = size;
+	_start_offset = start_offset;
+	_valid = false;
+	_data_positions.clear();
+	_add_logged_positions.clear();
+
+	_thread_running = pthread_create(&_thread, nullptr, &ULogMessageIndex::parseHelper, this) == 0;
+	return _thread_running;
+}
+
+bool
+ULogMessageIndex::wait()
+{
+	if (_thread_running) {
+		pthread_join(_thread, nullptr);
+		_thread_running = false;
+	}
+
+	return _valid;
+}
+
+void *
+ULogMessageIndex::parseHelper(void *context)
+{
+	((ULogMessageIndex *)context)->parse();
+	return nullptr;
+}
+
+void
+ULogMessageIndex::parse()
+{
+	size_t position = _start_offset;
+
+	while (position + ULOG_MSG_HEADER_LEN <= _size) {
+		ulog_message_header_s header;
+		memcpy(&header, _data + position, ULOG_MSG_HEADER_LEN);
+
+		if (position + ULOG_MSG_HEADER_LEN + header.msg_size > _size) {
+			break; // truncated message at the end
+		}
+
+		if (header.msg_type == (uint8_t)ULogMessageType::DATA && header.msg_size >= sizeof(uint16_t)) {
+			uint16_t msg_id;
+			memcpy(&msg_id, _data + position + ULOG_MSG_HEADER_LEN, sizeof(msg_id));
+
+			if (_data_positions.size() <= msg_id) {
+				_data_positions.resize(msg_id + 1);
+			}
+
+			_data_positions[msg_id].push_back(position);
+
+		} else if (header.msg_type == (uint8_t)ULogMessageType::ADD_LOGGED_MSG) {
+			_add_logged_positions.push_back(position);
+		}
+
+		position += ULOG_MSG_HEADER_LEN + header.msg_size;
+	}
+
+	PX4_DEBUG("indexed %zu bytes", position);
+	_valid = true;
+}
+
+int64_t
+ULogMessageIndex::nextData(uint16_t msg_id, int64_t position) const
+{
+	if (msg_id >= _data_positions.size()) {
+		return -1;
+	}
+
+	const std::vector<uint64_t> &positions = _data_positions[msg_id];
+	auto it = std::upper_bound(positions.begin(), positions.end(), (uint64_t)std::max(position, (int64_t)0));
+
+	return it == positions.end() ? -1 : (int64_t) * it;
+}
+
+void
+ULogMessageIndex::addLoggedMessages(int64_t from, int64_t to, const uint64_t *&begin, const uint64_t *&end) const
+{
+	auto first = std::upper_bound(_add_logged_positions.begin(), _add_logged_positions.end(),
+				      (uint64_t)std::max(from, (int64_t)0));
+	auto last = std::lower_bound(first, _add_logged_positions.end(), (uint64_t)std::max(to, (int64_t)0));
+
+	begin = _add_logged_positions.data() + (first - _add_logged_positions.begin());
+	end = _add_logged_positions.data() + (last - _add_logged_positions.begin());
+}
+
+} // namespace px4
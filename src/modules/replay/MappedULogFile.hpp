@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+#include <streambuf>
+#include <vector>
+
+namespace px4
+{
+
+/**
+ * @class MappedFileBuffer
+ * Read-only stream buffer over a memory mapped file: seeking is free and reading is a memcpy,
+ * so the many small seek & read calls of the ULog parser do not go through the file system.
+ */
+class MappedFileBuffer : public std::streambuf
+{
+public:
+	MappedFileBuffer() = default;
+	~MappedFileBuffer();
+
+	MappedFileBuffer(const MappedFileBuffer &) = delete;
+	MappedFileBuffer &operator=(const MappedFileBuffer &) = delete;
+
+	/**
+	 * map a file
+	 * @return true on success
+	 */
+	bool open(const char *file_name);
+
+	const uint8_t *data() const { return (const uint8_t *)_data; }
+	size_t size() const { return _size; }
+
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+	char *_data{nullptr};
+	size_t _size{0};
+};
+
+/**
+ * @class ULogMessageIndex
+ * File positions of all DATA messages (per msg_id) and ADD_LOGGED_MSG messages of a ULog file.
+ * The file is parsed on a background thread, while the definitions are read and the replay is set up.
+ */
+class ULogMessageIndex
+{
+public:
+	ULogMessageIndex() = default;
+	~ULogMessageIndex();
+
+	ULogMessageIndex(const ULogMessageIndex &) = delete;
+	ULogMessageIndex &operator=(const ULogMessageIndex &) = delete;
+
+	/**
+	 * start parsing in the background
+	 * @param data file content, must stay valid until the index is destroyed
+	 * @param start_offset position of the first message (after the file header)
+	 */
+	bool start(const uint8_t *data, size_t size, size_t start_offset);
+
+	/**
+	 * wait until parsing is done
+	 * @return true if the index can be used
+	 */
+	bool wait();
+
+	/**
+	 * @return position of the first DATA message of msg_id after position, or -1 if there is none
+	 */
+	int64_t nextData(uint16_t msg_id, int64_t position) const;
+
+	/**
+	 * ADD_LOGGED_MSG positions in the range (from, to)
+	 */
+	void addLoggedMessages(int64_t from, int64_t to, const uint64_t *&begin, const uint64_t *&end) const;
+
+private:
+	static void *parseHelper(void *context);
+	void parse();
+
+	const uint8_t *_data{nullptr};
+	size_t _size{0};
+	size_t _start_offset{0};
+
+	pthread_t _thread{};
+	bool _thread_running{false};
+	bool _valid{false};
+
+	std::vector<std::vector<uint64_t>> _data_positions; ///< per msg_id
+	std::vector<uint64_t> _add_logged_positions;
+};
+
+} // namespace px4
@@ -48,6 +48,7 @@
 #include <px4_platform_common/shutdown.h>
 #include <lib/parameters/param.h>
 
+#include <algorithm>
 #include <cstring>
 #include <float.h>
 #include <fstream>
@@ -63,6 +64,7 @@
 
 #include "Replay.hpp"
 #include "ReplayEkf2.hpp"
+#include "ReplayLockstep.hpp"
 
 #define PARAMS_OVERRIDE_FILE PX4_ROOTFSDIR "/replay_params.txt"
 
@@ -183,7 +185,7 @@ Replay::setUserParams(const char *filename)
 }
 
 bool
-Replay::readFileHeader(std::ifstream &file)
+Replay::readFileHeader(std::istream &file)
 {
 	file.seekg(0);
 	ulog_file_header_s msg_header;
@@ -207,7 +209,7 @@ Replay::readFileHeader(std::ifstream &file)
 }
 
 bool
-Replay::readFileDefinitions(std::ifstream &file)
+Replay::readFileDefinitions(std::istream &file)
 {
 	PX4_INFO("Applying params from ULog file...");
 
@@ -265,7 +267,7 @@ Replay::readFileDefinitions(std::ifstream &file)
 }
 
 bool
-Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
+Replay::readFlagBits(std::istream &file, uint16_t msg_size)
 {
 	if (msg_size != 40) {
 		PX4_ERR("unsupported message length for FLAG_BITS message (%i)", msg_size);
@@ -312,7 +314,7 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readFormat(std::ifstream &file, uint16_t msg_size)
+Replay::readFormat(std::istream &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size + 1);
 	char *format = (char *)_read_buffer.data();
@@ -368,7 +370,7 @@ string Replay::parseOrbFields(const string &fields)
 }
 
 bool
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+Replay::readAndAddSubscription(std::istream &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size + 1);
 	char *message = (char *)_read_buffer.data();
@@ -556,7 +558,7 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 }
 
 bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+Replay::readAndHandleAdditionalMessages(std::istream &file, std::streampos end_position)
 {
 	ulog_message_header_s message_header;
 
@@ -589,7 +591,7 @@ Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_
 }
 
 bool
-Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
+Replay::readAndApplyParameter(std::istream &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size);
 	uint8_t *message = (uint8_t *)_read_buffer.data();
@@ -631,7 +633,7 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+Replay::readDropout(std::istream &file, uint16_t msg_size)
 {
 	uint16_t duration;
 	file.read((char *)&duration, sizeof(duration));
@@ -641,8 +643,67 @@ Replay::readDropout(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+Replay::nextDataMessageIndexed(std::istream &file, Subscription &subscription, int msg_id)
 {
+	ulog_message_header_s message_header;
+	int64_t position = subscription.next_read_pos;
+
+	while (true) {
+		int64_t next_position = _message_index.nextData(msg_id, position);
+
+		if (next_position >= 0) {
+			file.seekg(next_position);
+			file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+			if (!file || next_position + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
+				next_position = -1;
+			}
+		}
+
+		// subscriptions added before the next data message
+		const uint64_t *add_logged_begin;
+		const uint64_t *add_logged_end;
+		_message_index.addLoggedMessages(position, next_position >= 0 ? next_position : _read_until_file_position,
+						 add_logged_begin, add_logged_end);
+
+		for (const uint64_t *add_logged = add_logged_begin; add_logged != add_logged_end; ++add_logged) {
+			ulog_message_header_s add_logged_header;
+			file.seekg(*add_logged);
+			file.read((char *)&add_logged_header, ULOG_MSG_HEADER_LEN);
+
+			if (!file || !readAndAddSubscription(file, add_logged_header.msg_size)) {
+				return false;
+			}
+		}
+
+		if (next_position < 0) {
+			// no more data messages for this subscription
+			subscription.orb_meta = nullptr;
+			file.clear();
+			return true;
+		}
+
+		if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
+			subscription.next_read_pos = next_position;
+			file.seekg(next_position + ULOG_MSG_HEADER_LEN + sizeof(uint16_t) + subscription.timestamp_offset);
+			file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
+			return file.good();
+		}
+
+		PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
+			subscription.orb_meta->o_name, message_header.msg_size,
+			subscription.orb_meta->o_size_no_padding + 2);
+		position = next_position;
+	}
+}
+
+bool
+Replay::nextDataMessage(std::istream &file, Subscription &subscription, int msg_id)
+{
+	if (_message_index.wait()) {
+		return nextDataMessageIndexed(file, subscription, msg_id);
+	}
+
 	ulog_message_header_s message_header;
 	file.seekg(subscription.next_read_pos);
 	//ignore the first message (it's data we already read)
@@ -699,6 +760,7 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 			break;
 
 		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
+		case (int)ULogMessageType::INDEX:
 		case (int)ULogMessageType::PARAMETER:
 		case (int)ULogMessageType::DROPOUT:
 		case (int)ULogMessageType::INFO:
@@ -726,6 +788,139 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 	return file.good();
 }
 
+bool
+Replay::readIndex(std::istream &file)
+{
+	_index_entries.clear();
+	_index_add_logged_offsets.clear();
+	_index_parameter_offsets.clear();
+
+	// the index ends at the end of the file, or where appended data starts
+	file.seekg(0, ios::end);
+	const int64_t end = std::min((int64_t)file.tellg(), _read_until_file_position);
+
+	ulog_index_trailer_s trailer;
+	ulog_message_index_s header;
+
+	if (end < (int64_t)(sizeof(header) + sizeof(trailer))) {
+		return false;
+	}
+
+	file.seekg(end - sizeof(trailer));
+	file.read((char *)&trailer, sizeof(trailer));
+
+	if (!file || memcmp(trailer.magic, "UIDX", sizeof(trailer.magic)) != 0 || trailer.index_size > end) {
+		file.clear();
+		return false;
+	}
+
+	file.seekg(end - trailer.index_size);
+	file.read((char *)&header, sizeof(header));
+
+	const size_t expected_size = sizeof(header) + header.num_entries * sizeof(ulog_index_entry_s)
+				     + (header.num_add_logged + header.num_parameters) * sizeof(uint32_t) + sizeof(trailer);
+
+	if (!file || header.msg_type != (uint8_t)ULogMessageType::INDEX || expected_size != trailer.index_size
+	    || header.msg_size + ULOG_MSG_HEADER_LEN != trailer.index_size) {
+		PX4_WARN("invalid log index");
+		file.clear();
+		return false;
+	}
+
+	if (header.flags & ULOG_INDEX_FLAG_INCOMPLETE) {
+		PX4_WARN("log index is incomplete, not using it");
+		return false;
+	}
+
+	_index_entries.resize(header.num_entries);
+	_index_add_logged_offsets.resize(header.num_add_logged);
+	_index_parameter_offsets.resize(header.num_parameters);
+	file.read((char *)_index_entries.data(), header.num_entries * sizeof(ulog_index_entry_s));
+	file.read((char *)_index_add_logged_offsets.data(), header.num_add_logged * sizeof(uint32_t));
+	file.read((char *)_index_parameter_offsets.data(), header.num_parameters * sizeof(uint32_t));
+
+	if (!file) {
+		_index_entries.clear();
+		file.clear();
+		return false;
+	}
+
+	return !_index_entries.empty();
+}
+
+bool
+Replay::seekToTime(std::istream &file, uint64_t start_time, std::streampos &last_additional_message_pos)
+{
+	// last indexed position before the start time
+	const ulog_index_entry_s *entry = nullptr;
+
+	for (const ulog_index_entry_s &e : _index_entries) {
+		if (e.timestamp > start_time) {
+			break;
+		}
+
+		entry = &e;
+	}
+
+	if (!entry) {
+		return false;
+	}
+
+	const streampos seek_pos = (streamoff)entry->offset;
+
+	if (seek_pos <= last_additional_message_pos) {
+		return false;
+	}
+
+	ulog_message_header_s message_header;
+
+	for (uint32_t offset : _index_add_logged_offsets) {
+		if ((streamoff)offset >= seek_pos) {
+			break;
+		}
+
+		file.seekg(offset);
+		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+		if (!file || message_header.msg_type != (uint8_t)ULogMessageType::ADD_LOGGED_MSG
+		    || !readAndAddSubscription(file, message_header.msg_size)) {
+			return false;
+		}
+	}
+
+	for (uint32_t offset : _index_parameter_offsets) {
+		if ((streamoff)offset >= seek_pos) {
+			break;
+		}
+
+		file.seekg(offset);
+		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+		if (!file || message_header.msg_type != (uint8_t)ULogMessageType::PARAMETER
+		    || !readAndApplyParameter(file, message_header.msg_size)) {
+			return false;
+		}
+	}
+
+	// the entry is a SYNC message, which nextDataMessage() skips. Subscriptions might be added meanwhile.
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		Subscription *subscription = _subscriptions[i];
+
+		if (subscription && subscription->orb_meta && subscription->next_read_pos < seek_pos) {
+			subscription->next_read_pos = seek_pos;
+			nextDataMessage(file, *subscription, i);
+		}
+	}
+
+	PX4_INFO("Starting replay at %.3lf s (file offset %u)", (double)(entry->timestamp - _file_start_time) / 1.e6,
+		 (unsigned)entry->offset);
+
+	// the replay timeline starts here
+	last_additional_message_pos = seek_pos;
+	_file_start_time = entry->timestamp;
+	return true;
+}
+
 const orb_metadata *
 Replay::findTopic(const std::string &name)
 {
@@ -799,7 +994,7 @@ Replay::sizeOfFullType(const std::string &type_name_full)
 }
 
 bool
-Replay::readDefinitionsAndApplyParams(std::ifstream &file)
+Replay::readDefinitionsAndApplyParams(std::istream &file)
 {
 	// log reader currently assumes little endian
 	int num = 1;
@@ -809,7 +1004,7 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 		return false;
 	}
 
-	if (!file.is_open()) {
+	if (!file) {
 		PX4_ERR("Failed to open replay file");
 		return false;
 	}
@@ -832,9 +1027,23 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 void
 Replay::run()
 {
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
+	// use a memory mapped file if possible, and start indexing the messages in the background
+	MappedFileBuffer mapped_file;
+	filebuf file_buffer;
+	streambuf *buffer = &mapped_file;
+
+	if (mapped_file.open(_replay_file)) {
+		_message_index.start(mapped_file.data(), mapped_file.size(), sizeof(ulog_file_header_s));
+
+	} else {
+		PX4_WARN("Failed to map replay file, falling back to file reads");
+		buffer = file_buffer.open(_replay_file, ios::in | ios::binary) ? &file_buffer : nullptr;
+	}
+
+	istream replay_file(buffer);
 
 	if (!readDefinitionsAndApplyParams(replay_file)) {
+		_message_index.wait();
 		return;
 	}
 
@@ -859,12 +1068,30 @@ Replay::run()
 
 	if (!readAndAddSubscription(replay_file, message_header.msg_size)) {
 		PX4_ERR("Failed to read subscription");
+		_message_index.wait();
 		return;
 	}
 
+	streampos last_additional_message_pos = _data_section_start;
+	const uint64_t file_start_time = _file_start_time;
+	const char *replay_start = getenv(replay::ENV_START);
+	const char *replay_end = getenv(replay::ENV_END);
+	uint64_t end_time = UINT64_MAX;
+
+	if (replay_end) {
+		end_time = file_start_time + (uint64_t)(atof(replay_end) * 1e6);
+	}
+
+	if (replay_start) {
+		const uint64_t start_time = file_start_time + (uint64_t)(atof(replay_start) * 1e6);
+
+		if (!readIndex(replay_file) || !seekToTime(replay_file, start_time, last_additional_message_pos)) {
+			PX4_WARN("No usable log index, replaying from the start");
+		}
+	}
+
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
 	while (!should_exit() && replay_file) {
 
@@ -894,6 +1121,10 @@ Replay::run()
 			break; //no active subscription anymore. We're done.
 		}
 
+		if (next_file_time > end_time) {
+			break;
+		}
+
 		Subscription &sub = *_subscriptions[next_msg_id];
 
 		if (next_file_time == 0) {
@@ -947,7 +1178,7 @@ Replay::run()
 	onExitMainLoop();
 
 	if (!should_exit()) {
-		replay_file.close();
+		file_buffer.close();
 		px4_shutdown_request();
 		// we need to ensure the shutdown logic gets updated and eventually triggers shutdown
 		hrt_abstime t = hrt_absolute_time();
@@ -962,7 +1193,7 @@ Replay::run()
 }
 
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::readTopicDataToBuffer(const Subscription &sub, std::istream &replay_file)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
@@ -972,7 +1203,7 @@ Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_fil
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data, std::istream &replay_file)
 {
 	return publishTopic(sub, data);
 }
@@ -1141,6 +1372,10 @@ Replay::instantiate(int argc, char *argv[])
 		PX4_INFO("Ekf2 replay mode");
 		instance = new ReplayEkf2();
 
+	} else if (replay_mode && strcmp(replay_mode, "lockstep") == 0) {
+		PX4_INFO("Lockstep replay mode");
+		instance = new ReplayLockstep();
+
 	} else {
 		instance = new Replay();
 	}
@@ -1164,9 +1399,18 @@ There are 2 environment variables used for configuration: `replay`, which must b
 the log file to be replayed. The second is the mode, specified via `replay_mode`:
 - `replay_mode=ekf2`: specific EKF2 replay mode. It can only be used with the ekf2 module, but allows the replay
   to run as fast as possible.
+- `replay_mode=lockstep`: generic replay of any module(s) as fast as possible. After publishing the messages of a
+  timestamp, the replay waits until all work queues are idle (e.g. the rate controller, position controller and
+  control allocator processed the data) before the time is advanced, so the output is reproducible.
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
+Optionally, `replay_start` and `replay_end` limit the replay to a time window, in seconds relative to the log start.
+If the log contains an index (written by the logger when stopping), the data before `replay_start` is not parsed.
+
+To replay many logs, `Tools/replay_batch.py` runs one px4 instance per log in parallel (each with its own
+working directory) and collects the output logs.
+
 The module is typically used together with uORB publisher rules, to specify which messages should be replayed.
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
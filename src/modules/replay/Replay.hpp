@@ -40,7 +40,9 @@
 #include <string>
 
 #include "definitions.hpp"
+#include "MappedULogFile.hpp"
 
+#include <logger/messages.h>
 #include <px4_platform_common/module.h>
 #include <uORB/topics/uORBTopics.hpp>
 #include <uORB/topics/ekf2_timestamps.h>
@@ -189,12 +191,12 @@ protected:
 	 * handle the publication of a topic update
 	 * @return true if published, false otherwise
 	 */
-	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file);
+	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::istream &replay_file);
 
 	/**
 	 * read a topic from the file (offset given by the subscription) into _read_buffer
 	 */
-	void readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file);
+	void readTopicDataToBuffer(const Subscription &sub, std::istream &replay_file);
 
 	/**
 	 * Find next data message for this subscription, starting with the stored file offset.
@@ -204,7 +206,12 @@ protected:
 	 * File seek position is arbitrary after this call.
 	 * @return false on file error
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	bool nextDataMessage(std::istream &file, Subscription &subscription, int msg_id);
+
+	/**
+	 * nextDataMessage() using the message index instead of parsing the file
+	 */
+	bool nextDataMessageIndexed(std::istream &file, Subscription &subscription, int msg_id);
 
 	virtual uint64_t getTimestampOffset()
 	{
@@ -231,28 +238,34 @@ private:
 
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
+	ULogMessageIndex _message_index; ///< only used with a memory mapped file
+
+	std::vector<ulog_index_entry_s> _index_entries; ///< from the INDEX message, empty if there is none
+	std::vector<uint32_t> _index_add_logged_offsets;
+	std::vector<uint32_t> _index_parameter_offsets;
+
 	float _accumulated_delay{0.f};
 
-	bool readFileHeader(std::ifstream &file);
+	bool readFileHeader(std::istream &file);
 
 	/**
 	 * Read definitions section: check formats, apply parameters and store
 	 * the start of the data section.
 	 * @return true on success
 	 */
-	bool readFileDefinitions(std::ifstream &file);
+	bool readFileDefinitions(std::istream &file);
 
 	///file parsing methods. They return false, when further parsing should be aborted.
-	bool readFormat(std::ifstream &file, uint16_t msg_size);
-	bool readAndAddSubscription(std::ifstream &file, uint16_t msg_size);
-	bool readFlagBits(std::ifstream &file, uint16_t msg_size);
+	bool readFormat(std::istream &file, uint16_t msg_size);
+	bool readAndAddSubscription(std::istream &file, uint16_t msg_size);
+	bool readFlagBits(std::istream &file, uint16_t msg_size);
 
 	/**
 	 * Read the file header and definitions sections. Apply the parameters from this section
 	 * and apply user-defined overridden parameters.
 	 * @return true on success
 	 */
-	bool readDefinitionsAndApplyParams(std::ifstream &file);
+	bool readDefinitionsAndApplyParams(std::istream &file);
 
 	/**
 	 * Read and handle additional messages starting at current file position, while position < end_position.
@@ -260,9 +273,24 @@ private:
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
 	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
-	bool readDropout(std::ifstream &file, uint16_t msg_size);
-	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
+	bool readAndHandleAdditionalMessages(std::istream &file, std::streampos end_position);
+	bool readDropout(std::istream &file, uint16_t msg_size);
+	bool readAndApplyParameter(std::istream &file, uint16_t msg_size);
+
+	/**
+	 * Read the INDEX message at the end of the file (if there is one)
+	 * @return true if a complete index was found
+	 */
+	bool readIndex(std::istream &file);
+
+	/**
+	 * Use the index to skip the data before the given time: adds all subscriptions and applies all
+	 * parameter changes logged before it, then continues all subscriptions from there.
+	 * @param start_time file timestamp
+	 * @param last_additional_message_pos output: position up to which additional messages are handled
+	 * @return false if the index cannot be used (nothing is changed then)
+	 */
+	bool seekToTime(std::istream &file, uint64_t start_time, std::streampos &last_additional_message_pos);
 
 	static const orb_metadata *findTopic(const std::string &name);
 
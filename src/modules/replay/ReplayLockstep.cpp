@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+
+#include <lib/parameters/param.h>
+
+#include "ReplayLockstep.hpp"
+
+namespace px4
+{
+
+bool
+ReplayLockstep::handleTopicUpdate(Subscription &sub, void *data, std::istream &replay_file)
+{
+	if (publishTopic(sub, data)) {
+		_published = true;
+		return true;
+	}
+
+	return false;
+}
+
+uint64_t
+ReplayLockstep::handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset)
+{
+	const uint64_t publish_timestamp = next_file_time + timestamp_offset;
+
+	if (publish_timestamp != _last_publish_timestamp) {
+		if (_published) {
+			// let the modules process everything published at the previous timestamp before advancing
+			px4_lockstep_wait_for_components();
+			_published = false;
+			++_steps;
+		}
+
+		_last_publish_timestamp = publish_timestamp;
+	}
+
+	return Replay::handleTopicDelay(next_file_time, timestamp_offset);
+}
+
+void
+ReplayLockstep::onEnterMainLoop()
+{
+	_speed_factor = 0.f; // do not wait, the time is advanced directly to the next message
+
+	// disable parameter auto save
+	param_control_autosave(false);
+}
+
+void
+ReplayLockstep::onExitMainLoop()
+{
+	if (_published) {
+		px4_lockstep_wait_for_components();
+		++_steps;
+	}
+
+	PX4_INFO("Lockstep replay: %" PRIu32 " steps", _steps);
+}
+
+} // namespace px4
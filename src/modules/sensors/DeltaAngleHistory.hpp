@@ -0,0 +1,192 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file DeltaAngleHistory.hpp
+ *
+ * History of the integrated angular rate (e.g. vehicle_imu delta angles) indexed by time,
+ * to get the rotation over an arbitrary time interval in O(log n).
+ *
+ * The cumulative angle is stored at the end of every delta angle interval, and linearly
+ * interpolated in between (the angular rate is assumed to be constant within an interval).
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <matrix/math.hpp>
+
+namespace sensors
+{
+
+template<size_t N>
+class DeltaAngleHistory
+{
+public:
+	static_assert(N >= 2, "at least one interval needs to be stored");
+
+	void reset() { _count = 0; }
+
+	bool empty() const { return _count == 0; }
+
+	hrt_abstime oldest() const { return empty() ? 0 : entry(0).time_us; }
+	hrt_abstime newest() const { return empty() ? 0 : entry(_count - 1).time_us; }
+
+	/**
+	 * Add a delta angle
+	 * @param timestamp_sample end of the integration interval (us)
+	 * @param delta_angle delta angle (rad)
+	 * @param dt_us length of the integration interval (us)
+	 */
+	void push(const hrt_abstime timestamp_sample, const matrix::Vector3f &delta_angle, const uint32_t dt_us)
+	{
+		if ((dt_us == 0) || (timestamp_sample < dt_us)) {
+			return;
+		}
+
+		const hrt_abstime interval_start = timestamp_sample - dt_us;
+
+		// start over if the new interval does not continue the history
+		if (!empty() && ((timestamp_sample <= newest()) || (interval_start > newest() + dt_us / 2))) {
+			reset();
+		}
+
+		if (empty()) {
+			add(interval_start, matrix::Vector3f{});
+		}
+
+		add(timestamp_sample, entry(_count - 1).angle + delta_angle);
+
+		// keep the float resolution of the cumulative angle
+		if (entry(_count - 1).angle.abs().max() > CUMULATIVE_ANGLE_MAX) {
+			const matrix::Vector3f offset = entry(0).angle;
+
+			for (size_t i = 0; i < _count; i++) {
+				entry(i).angle -= offset;
+			}
+		}
+	}
+
+	/**
+	 * Get the delta angle over an interval
+	 * The end of the interval can be extrapolated up to one delta angle interval past the newest
+	 * sample, as the data for the current interval might not have been received yet.
+	 * @param start start of the interval (us)
+	 * @param end end of the interval (us)
+	 * @param delta_angle delta angle over the interval (rad)
+	 * @return true if the interval is covered by the history
+	 */
+	bool integrate(const hrt_abstime start, const hrt_abstime end, matrix::Vector3f &delta_angle) const
+	{
+		matrix::Vector3f angle_start;
+		matrix::Vector3f angle_end;
+
+		if ((start <= end) && angleAt(start, angle_start) && angleAt(end, angle_end)) {
+			delta_angle = angle_end - angle_start;
+			return true;
+		}
+
+		return false;
+	}
+
+private:
+	static constexpr float CUMULATIVE_ANGLE_MAX{10.f};
+
+	struct Entry {
+		hrt_abstime time_us;
+		matrix::Vector3f angle; ///< cumulative angle up to time_us
+	};
+
+	// index 0 is the oldest entry
+	Entry &entry(size_t index) { return _entries[(_head + N - _count + 1 + index) % N]; }
+	const Entry &entry(size_t index) const { return _entries[(_head + N - _count + 1 + index) % N]; }
+
+	void add(hrt_abstime time_us, const matrix::Vector3f &angle)
+	{
+		_head = (_head + 1) % N;
+		_entries[_head] = Entry{time_us, angle};
+
+		if (_count < N) {
+			_count++;
+		}
+	}
+
+	bool angleAt(const hrt_abstime time_us, matrix::Vector3f &angle) const
+	{
+		if ((_count < 2) || (time_us < oldest())) {
+			return false;
+		}
+
+		size_t upper;
+
+		if (time_us > newest()) {
+			// extrapolate with the rate of the newest interval
+			upper = _count - 1;
+
+			if (time_us - newest() > newest() - entry(upper - 1).time_us) {
+				return false;
+			}
+
+		} else {
+			// first entry not older than time_us
+			size_t low = 1;
+			upper = _count - 1;
+
+			while (low < upper) {
+				const size_t mid = (low + upper) / 2;
+
+				if (entry(mid).time_us < time_us) {
+					low = mid + 1;
+
+				} else {
+					upper = mid;
+				}
+			}
+		}
+
+		const Entry &a = entry(upper - 1);
+		const Entry &b = entry(upper);
+		const float fraction = static_cast<float>(static_cast<int64_t>(time_us - a.time_us))
+				       / static_cast<float>(b.time_us - a.time_us);
+
+		angle = a.angle + (b.angle - a.angle) * fraction;
+		return true;
+	}
+
+	Entry _entries[N] {};
+	size_t _head{N - 1};
+	size_t _count{0};
+};
+
+} // namespace sensors
@@ -122,9 +122,9 @@ public:
 
 	/**
 	 * Get the RMS values of this validator
-	 * @return		the stored RMS
+	 * @return		the RMS (computed on request)
 	 */
-	float *rms() { return _rms; }
+	float *rms();
 
 	/**
 	 * Print the validator value
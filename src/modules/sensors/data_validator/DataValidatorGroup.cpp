@@ -62,6 +62,7 @@ DataValidatorGroup::DataValidatorGroup(unsigned siblings)
 		}
 
 		prev = next;
+		add_to_index(next);
 	}
 
 	_last = next;
@@ -92,9 +93,40 @@ DataValidator *DataValidatorGroup::add_new_validator()
 	_last->setSibling(validator);
 	_last = validator;
 	_last->set_timeout(_timeout_interval_us);
+	add_to_index(validator);
 	return _last;
 }
 
+void DataValidatorGroup::add_to_index(DataValidator *validator)
+{
+	if (_count < MAX_INDEXED) {
+		_index[_count] = validator;
+	}
+
+	_count++;
+}
+
+DataValidator *DataValidatorGroup::validator(unsigned index)
+{
+	if (index < MAX_INDEXED) {
+		return (index < _count) ? _index[index] : nullptr;
+	}
+
+	DataValidator *next = _first;
+	unsigned i = 0;
+
+	while (next != nullptr) {
+		if (i == index) {
+			return next;
+		}
+
+		next = next->sibling();
+		i++;
+	}
+
+	return nullptr;
+}
+
 void DataValidatorGroup::set_timeout(uint32_t timeout_interval_us)
 {
 
@@ -122,18 +154,10 @@ void DataValidatorGroup::set_equal_value_threshold(uint32_t threshold)
 void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val[3], uint32_t error_count,
 			     uint8_t priority)
 {
+	DataValidator *next = validator(index);
 
-	DataValidator *next = _first;
-	unsigned i = 0;
-
-	while (next != nullptr) {
-		if (i == index) {
-			next->put(timestamp, val, error_count, priority);
-			break;
-		}
-
-		next = next->sibling();
-		i++;
+	if (next != nullptr) {
+		next->put(timestamp, val, error_count, priority);
 	}
 }
 
@@ -290,16 +314,10 @@ uint32_t DataValidatorGroup::failover_state()
 
 uint32_t DataValidatorGroup::get_sensor_state(unsigned index)
 {
-	DataValidator *next = _first;
-	unsigned i = 0;
+	DataValidator *next = validator(index);
 
-	while (next != nullptr) {
-		if (i == index) {
-			return next->state();
-		}
-
-		next = next->sibling();
-		i++;
+	if (next != nullptr) {
+		return next->state();
 	}
 
 	// sensor index not found
@@ -308,16 +326,10 @@ uint32_t DataValidatorGroup::get_sensor_state(unsigned index)
 
 uint8_t DataValidatorGroup::get_sensor_priority(unsigned index)
 {
-	DataValidator *next = _first;
-	unsigned i = 0;
+	DataValidator *next = validator(index);
 
-	while (next != nullptr) {
-		if (i == index) {
-			return next->priority();
-		}
-
-		next = next->sibling();
-		i++;
+	if (next != nullptr) {
+		return next->priority();
 	}
 
 	// sensor index not found
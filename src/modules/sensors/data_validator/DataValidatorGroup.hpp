@@ -132,6 +132,20 @@ public:
 	void set_equal_value_threshold(uint32_t threshold);
 
 private:
+	/**
+	 * Get the validator with the specified index (constant time for the first MAX_INDEXED validators)
+	 *
+	 * @return		validator or nullptr if the index doesn't exist
+	 */
+	DataValidator *validator(unsigned index);
+
+	void add_to_index(DataValidator *validator);
+
+	static constexpr unsigned MAX_INDEXED = 8;
+
+	DataValidator *_index[MAX_INDEXED] {}; /**< direct access to the first validators, put() runs for every sample */
+	unsigned _count{0}; /**< number of validators */
+
 	DataValidator *_first{nullptr}; /**< first node in the group */
 	DataValidator *_last{nullptr};  /**< last node in the group */
 
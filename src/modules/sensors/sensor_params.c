@@ -222,6 +222,20 @@ PARAM_DEFINE_INT32(SENS_EXT_I2C_PRB, 1);
  */
 PARAM_DEFINE_INT32(SENS_IMU_MODE, 1);
 
+/**
+ * Sensors hub IMU fusion
+ *
+ * Publish the inverse variance weighted mean of all healthy IMUs instead of
+ * only the primary one. IMUs are only fused when sampled within half an
+ * integration period of the primary gyro and when not clipping, otherwise the
+ * primary IMU is used alone. Only used with SENS_IMU_MODE 1.
+ *
+ * @boolean
+ * @category system
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(SENS_IMU_FUSE, 0);
+
 /**
  * Enable internal barometers
  *
@@ -48,6 +48,15 @@ VehicleAngularVelocity::VehicleAngularVelocity() :
 {
 	_vehicle_angular_acceleration_pub.advertise();
 	_vehicle_angular_velocity_pub.advertise();
+
+#if !defined(CONSTRAINED_FLASH)
+
+	for (int k = 0; k <= NOTCH_LUT_SIZE; k++) {
+		_notch_cos_lut[k] = cosf(k * M_PI_F / NOTCH_LUT_SIZE);
+		_notch_sin_lut[k] = sinf(k * M_PI_F / NOTCH_LUT_SIZE);
+	}
+
+#endif // !CONSTRAINED_FLASH
 }
 
 VehicleAngularVelocity::~VehicleAngularVelocity()
@@ -166,21 +175,21 @@ void VehicleAngularVelocity::ResetFilters(const hrt_abstime &time_now_us)
 		const Vector3f angular_velocity_uncalibrated{GetResetAngularVelocity()};
 		const Vector3f angular_acceleration_uncalibrated{GetResetAngularAcceleration()};
 
-		for (int axis = 0; axis < 3; axis++) {
-			// angular velocity low pass
-			_lp_filter_velocity[axis].set_cutoff_frequency(_filter_sample_rate_hz, _param_imu_gyro_cutoff.get());
-			_lp_filter_velocity[axis].reset(angular_velocity_uncalibrated(axis));
+		// angular velocity low pass
+		_lp_filter_velocity.set_cutoff_frequency(_filter_sample_rate_hz, _param_imu_gyro_cutoff.get());
+		_lp_filter_velocity.reset(angular_velocity_uncalibrated);
 
-			// angular velocity notch 0
-			_notch_filter0_velocity[axis].setParameters(_filter_sample_rate_hz, _param_imu_gyro_nf0_frq.get(),
-					_param_imu_gyro_nf0_bw.get());
-			_notch_filter0_velocity[axis].reset();
+		// angular velocity notch 0
+		_notch_filter0_velocity.setParameters(_filter_sample_rate_hz, _param_imu_gyro_nf0_frq.get(),
+						      _param_imu_gyro_nf0_bw.get());
+		_notch_filter0_velocity.reset();
 
-			// angular velocity notch 1
-			_notch_filter1_velocity[axis].setParameters(_filter_sample_rate_hz, _param_imu_gyro_nf1_frq.get(),
-					_param_imu_gyro_nf1_bw.get());
-			_notch_filter1_velocity[axis].reset();
+		// angular velocity notch 1
+		_notch_filter1_velocity.setParameters(_filter_sample_rate_hz, _param_imu_gyro_nf1_frq.get(),
+						      _param_imu_gyro_nf1_bw.get());
+		_notch_filter1_velocity.reset();
 
+		for (int axis = 0; axis < 3; axis++) {
 			// angular acceleration low pass
 			if ((_param_imu_dgyro_cutoff.get() > 0.f)
 			    && (_lp_filter_acceleration[axis].setCutoffFreq(_filter_sample_rate_hz, _param_imu_dgyro_cutoff.get()))) {
@@ -397,32 +406,27 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 		}
 
 		// gyro low pass cutoff frequency changed
-		for (auto &lp : _lp_filter_velocity) {
-			if (fabsf(lp.get_cutoff_freq() - _param_imu_gyro_cutoff.get()) > 0.01f) {
-				_reset_filters = true;
-				break;
-			}
+		if (fabsf(_lp_filter_velocity.get_cutoff_freq() - _param_imu_gyro_cutoff.get()) > 0.01f) {
+			_reset_filters = true;
 		}
 
 		// gyro notch filter 0 frequency or bandwidth changed
-		for (auto &nf : _notch_filter0_velocity) {
-			const bool nf_freq_changed = (fabsf(nf.getNotchFreq() - _param_imu_gyro_nf0_frq.get()) > 0.01f);
-			const bool nf_bw_changed   = (fabsf(nf.getBandwidth() - _param_imu_gyro_nf0_bw.get()) > 0.01f);
+		{
+			const bool nf_freq_changed = (fabsf(_notch_filter0_velocity.getNotchFreq() - _param_imu_gyro_nf0_frq.get()) > 0.01f);
+			const bool nf_bw_changed   = (fabsf(_notch_filter0_velocity.getBandwidth() - _param_imu_gyro_nf0_bw.get()) > 0.01f);
 
 			if ((nf0_enabled_prev != nf0_enabled) || (nf0_enabled && (nf_freq_changed || nf_bw_changed))) {
 				_reset_filters = true;
-				break;
 			}
 		}
 
 		// gyro notch filter 1 frequency or bandwidth changed
-		for (auto &nf : _notch_filter1_velocity) {
-			const bool nf_freq_changed = (fabsf(nf.getNotchFreq() - _param_imu_gyro_nf1_frq.get()) > 0.01f);
-			const bool nf_bw_changed   = (fabsf(nf.getBandwidth() - _param_imu_gyro_nf1_bw.get()) > 0.01f);
+		{
+			const bool nf_freq_changed = (fabsf(_notch_filter1_velocity.getNotchFreq() - _param_imu_gyro_nf1_frq.get()) > 0.01f);
+			const bool nf_bw_changed   = (fabsf(_notch_filter1_velocity.getBandwidth() - _param_imu_gyro_nf1_bw.get()) > 0.01f);
 
 			if ((nf1_enabled_prev != nf1_enabled) || (nf1_enabled && (nf_freq_changed || nf_bw_changed))) {
 				_reset_filters = true;
-				break;
 			}
 		}
 
@@ -441,9 +445,17 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 			const int32_t esc_rpm_harmonics = math::constrain(_param_imu_gyro_dnf_hmc.get(), (int32_t)1, (int32_t)10);
 
 			if (_dynamic_notch_filter_esc_rpm && (esc_rpm_harmonics != _esc_rpm_harmonics)) {
-				delete[] _dynamic_notch_filter_esc_rpm;
-				_dynamic_notch_filter_esc_rpm = nullptr;
-				_esc_rpm_harmonics = 0;
+				if (esc_rpm_harmonics <= _esc_rpm_harmonics_capacity) {
+					// fits in the existing storage, reuse it instead of fragmenting the heap
+					DisableDynamicNotchEscRpm();
+					_esc_rpm_harmonics = esc_rpm_harmonics;
+
+				} else {
+					delete[] _dynamic_notch_filter_esc_rpm;
+					_dynamic_notch_filter_esc_rpm = nullptr;
+					_esc_rpm_harmonics = 0;
+					_esc_rpm_harmonics_capacity = 0;
+				}
 			}
 
 			if (_dynamic_notch_filter_esc_rpm == nullptr) {
@@ -452,6 +464,7 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 
 				if (_dynamic_notch_filter_esc_rpm) {
 					_esc_rpm_harmonics = esc_rpm_harmonics;
+					_esc_rpm_harmonics_capacity = esc_rpm_harmonics;
 
 					if (_dynamic_notch_filter_esc_rpm_disable_perf == nullptr) {
 						_dynamic_notch_filter_esc_rpm_disable_perf = perf_alloc(PC_COUNT,
@@ -533,13 +546,12 @@ void VehicleAngularVelocity::DisableDynamicNotchEscRpm()
 #if !defined(CONSTRAINED_FLASH)
 
 	if (_dynamic_notch_filter_esc_rpm) {
-		for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-			for (int axis = 0; axis < 3; axis++) {
-				for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
-					_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].disable();
-					_esc_available.set(esc, false);
-					perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
-				}
+		// including the unused harmonics, they become active again if the number of harmonics increases
+		for (int harmonic = 0; harmonic < _esc_rpm_harmonics_capacity; harmonic++) {
+			for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
+				_dynamic_notch_filter_esc_rpm[harmonic][esc].disable();
+				_esc_available.set(esc, false);
+				perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
 			}
 		}
 	}
@@ -576,60 +588,75 @@ void VehicleAngularVelocity::UpdateDynamicNotchEscRpm(const hrt_abstime &time_no
 
 		if (_esc_status_sub.copy(&esc_status) && (time_now_us < esc_status.timestamp + DYNAMIC_NOTCH_FITLER_TIMEOUT)) {
 
-			static constexpr float FREQ_MIN = 10.f; // TODO: configurable
-
 			for (size_t esc = 0; esc < math::min(esc_status.esc_count, (uint8_t)MAX_NUM_ESCS); esc++) {
 				const esc_report_s &esc_report = esc_status.esc[esc];
 
 				// only update if ESC RPM range seems valid
 				if ((esc_report.esc_rpm != 0) && (time_now_us < esc_report.timestamp + DYNAMIC_NOTCH_FITLER_TIMEOUT)) {
 
-					bool esc_enabled = false;
-					bool update = force || !_esc_available[esc]; // force parameter update or notch was previously disabled
+					// force parameter update or notch was previously disabled
+					if (force || !_esc_available[esc]) {
+						_esc_rpm_update_force.set(esc, true);
+					}
 
-					const float esc_hz = abs(esc_report.esc_rpm) / 60.f;
+					_esc_rpm_hz[esc] = abs(esc_report.esc_rpm) / 60.f;
+					_esc_rpm_update_pending.set(esc, true);
+					_last_esc_rpm_notch_update[esc] = esc_report.timestamp;
+				}
+			}
+		}
+	}
 
-					for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-						const float frequency_hz = esc_hz * (harmonic + 1);
+	if (enabled && (_esc_rpm_update_pending.count() > 0)) {
 
-						// for each ESC harmonic determine if enabled/disabled from first notch (x axis)
-						auto &nfx = _dynamic_notch_filter_esc_rpm[harmonic][0][esc];
+		static constexpr float FREQ_MIN = 10.f; // TODO: configurable
 
-						if (frequency_hz > FREQ_MIN) {
-							// update filter parameters if frequency changed or forced
-							if (update || !nfx.initialized() || (fabsf(nfx.getNotchFreq() - frequency_hz) > 0.1f)) {
-								for (int axis = 0; axis < 3; axis++) {
-									auto &nf = _dynamic_notch_filter_esc_rpm[harmonic][axis][esc];
-									nf.setParameters(_filter_sample_rate_hz, frequency_hz, _param_imu_gyro_dnf_bw.get());
-									perf_count(_dynamic_notch_filter_esc_rpm_update_perf);
-								}
-							}
+		// limit the number of notch updates per cycle, unless forced
+		int budget = force ? (_esc_rpm_harmonics * MAX_NUM_ESCS) : ESC_RPM_NOTCH_UPDATE_BUDGET;
 
-							esc_enabled = true;
+		for (int i = 0; (i < MAX_NUM_ESCS) && (budget > 0); i++) {
+			const int esc = _esc_rpm_update_index;
+			_esc_rpm_update_index = (_esc_rpm_update_index + 1) % MAX_NUM_ESCS;
 
-						} else {
-							// disable these notch filters (if they aren't already)
-							if (nfx.getNotchFreq() > 0.f) {
-								for (int axis = 0; axis < 3; axis++) {
-									auto &nf = _dynamic_notch_filter_esc_rpm[harmonic][axis][esc];
-									nf.disable();
-									perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
-								}
-							}
-						}
+			if (!_esc_rpm_update_pending[esc]) {
+				continue;
+			}
+
+			const bool update = _esc_rpm_update_force[esc];
+			_esc_rpm_update_pending.set(esc, false);
+			_esc_rpm_update_force.set(esc, false);
+
+			bool esc_enabled = false;
+
+			for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
+				const float frequency_hz = _esc_rpm_hz[esc] * (harmonic + 1);
+
+				auto &nf = _dynamic_notch_filter_esc_rpm[harmonic][esc];
+
+				if (frequency_hz > FREQ_MIN) {
+					// update filter parameters if frequency changed or forced
+					if (update || !nf.initialized() || (fabsf(nf.getNotchFreq() - frequency_hz) > 0.1f)) {
+						nf.setParameters(_filter_sample_rate_hz, frequency_hz, _param_imu_gyro_dnf_bw.get(), NotchBeta(frequency_hz));
+						perf_count(_dynamic_notch_filter_esc_rpm_update_perf);
+						budget--;
 					}
 
-					if (esc_enabled) {
-						_esc_available.set(esc, true);
-						_last_esc_rpm_notch_update[esc] = esc_report.timestamp;
+					esc_enabled = true;
 
-					} else {
-						_esc_available.set(esc, false);
+				} else {
+					// disable this notch filter (if it isn't already)
+					if (nf.getNotchFreq() > 0.f) {
+						nf.disable();
+						perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
 					}
 				}
 			}
+
+			_esc_available.set(esc, esc_enabled);
 		}
+	}
 
+	if (enabled) {
 		// check ESC feedback timeout
 		for (size_t esc = 0; esc < MAX_NUM_ESCS; esc++) {
 			if (_esc_available[esc] && (time_now_us > _last_esc_rpm_notch_update[esc] + DYNAMIC_NOTCH_FITLER_TIMEOUT)) {
@@ -637,10 +664,8 @@ void VehicleAngularVelocity::UpdateDynamicNotchEscRpm(const hrt_abstime &time_no
 				_esc_available.set(esc, false);
 
 				for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-					for (int axis = 0; axis < 3; axis++) {
-						_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].disable();
-						perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
-					}
+					_dynamic_notch_filter_esc_rpm[harmonic][esc].disable();
+					perf_count(_dynamic_notch_filter_esc_rpm_disable_perf);
 				}
 			}
 		}
@@ -649,6 +674,23 @@ void VehicleAngularVelocity::UpdateDynamicNotchEscRpm(const hrt_abstime &time_no
 #endif // !CONSTRAINED_FLASH
 }
 
+float VehicleAngularVelocity::NotchBeta(float frequency_hz) const
+{
+#if !defined(CONSTRAINED_FLASH)
+	// beta = -cos(w) with w = 2 pi f / fs, from the closest table entry w_k and d = w - w_k (|d| <= pi / 128):
+	// cos(w) = cos(w_k) cos(d) - sin(w_k) sin(d), cos(d) and sin(d) by their Taylor series (accurate to float precision)
+	static constexpr float step = M_PI_F / NOTCH_LUT_SIZE;
+	const float w = 2.f * M_PI_F * frequency_hz / _filter_sample_rate_hz;
+	const int k = math::constrain((int)(w / step + 0.5f), 0, NOTCH_LUT_SIZE);
+	const float d = w - k * step;
+	const float d2 = d * d;
+
+	return -(_notch_cos_lut[k] * (1.f - 0.5f * d2) - _notch_sin_lut[k] * d * (1.f - d2 / 6.f));
+#else
+	return NAN;
+#endif // !CONSTRAINED_FLASH
+}
+
 void VehicleAngularVelocity::UpdateDynamicNotchFFT(const hrt_abstime &time_now_us, bool force)
 {
 #if !defined(CONSTRAINED_FLASH)
@@ -708,7 +750,7 @@ void VehicleAngularVelocity::UpdateDynamicNotchFFT(const hrt_abstime &time_now_u
 #endif // !CONSTRAINED_FLASH
 }
 
-float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int N)
+Vector3f VehicleAngularVelocity::FilterAngularVelocity(Vector3f data[], int N)
 {
 #if !defined(CONSTRAINED_FLASH)
 
@@ -717,7 +759,7 @@ float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int
 		for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
 			if (_esc_available[esc]) {
 				for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-					_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data, N);
+					_dynamic_notch_filter_esc_rpm[harmonic][esc].applyArray(data, N);
 				}
 			}
 		}
@@ -725,9 +767,15 @@ float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int
 
 	// Apply dynamic notch filter from FFT
 	if (_dynamic_notch_fft_available) {
-		for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
-			if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
-				_dynamic_notch_filter_fft[axis][peak].applyArray(data, N);
+		for (int axis = 0; axis < 3; axis++) {
+			for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
+				auto &nf = _dynamic_notch_filter_fft[axis][peak];
+
+				if (nf.getNotchFreq() > 0.f) {
+					for (int n = 0; n < N; n++) {
+						data[n](axis) = nf.apply(data[n](axis));
+					}
+				}
 			}
 		}
 	}
@@ -735,17 +783,17 @@ float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int
 #endif // !CONSTRAINED_FLASH
 
 	// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
-	if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter0_velocity[axis].applyArray(data, N);
+	if (_notch_filter0_velocity.getNotchFreq() > 0.f) {
+		_notch_filter0_velocity.applyArray(data, N);
 	}
 
 	// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
-	if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter1_velocity[axis].applyArray(data, N);
+	if (_notch_filter1_velocity.getNotchFreq() > 0.f) {
+		_notch_filter1_velocity.applyArray(data, N);
 	}
 
 	// Apply general low-pass filter (IMU_GYRO_CUTOFF)
-	_lp_filter_velocity[axis].applyArray(data, N);
+	_lp_filter_velocity.applyArray(data, N);
 
 	// return last filtered sample
 	return data[N - 1];
@@ -816,19 +864,26 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_velocity_uncalibrated;
 				Vector3f angular_acceleration_uncalibrated;
 
-				int16_t *raw_data_array[] {sensor_fifo_data.x, sensor_fifo_data.y, sensor_fifo_data.z};
+				// copy raw int16 sensor samples to float array for filtering
+				Vector3f data[FIFO_SIZE_MAX];
+
+				for (int n = 0; n < N; n++) {
+					data[n](0) = sensor_fifo_data.scale * sensor_fifo_data.x[n];
+					data[n](1) = sensor_fifo_data.scale * sensor_fifo_data.y[n];
+					data[n](2) = sensor_fifo_data.scale * sensor_fifo_data.z[n];
+				}
+
+				// save last filtered sample
+				angular_velocity_uncalibrated = FilterAngularVelocity(data, N);
 
 				for (int axis = 0; axis < 3; axis++) {
-					// copy raw int16 sensor samples to float array for filtering
-					float data[FIFO_SIZE_MAX];
+					float data_axis[FIFO_SIZE_MAX];
 
 					for (int n = 0; n < N; n++) {
-						data[n] = sensor_fifo_data.scale * raw_data_array[axis][n];
+						data_axis[n] = data[n](axis);
 					}
 
-					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data, N);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data, N);
+					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data_axis, N);
 				}
 
 				// Publish
@@ -862,15 +917,14 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_velocity_uncalibrated;
 				Vector3f angular_acceleration_uncalibrated;
 
-				float raw_data_array[] {sensor_data.x, sensor_data.y, sensor_data.z};
+				Vector3f data[1] {Vector3f{sensor_data.x, sensor_data.y, sensor_data.z}};
 
-				for (int axis = 0; axis < 3; axis++) {
-					// copy sensor sample to float array for filtering
-					float data[1] {raw_data_array[axis]};
+				// save last filtered sample
+				angular_velocity_uncalibrated = FilterAngularVelocity(data);
 
-					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data);
+				for (int axis = 0; axis < 3; axis++) {
+					float data_axis[1] {data[0](axis)};
+					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data_axis);
 				}
 
 				// Publish
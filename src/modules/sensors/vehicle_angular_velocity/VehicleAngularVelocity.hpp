@@ -41,6 +41,7 @@
 #include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
 #include <lib/mathlib/math/filter/NotchFilter.hpp>
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/hot_section.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
@@ -74,12 +75,12 @@ public:
 	void Stop();
 
 private:
-	void Run() override;
+	PX4_HOT void Run() override;
 
 	bool CalibrateAndPublish(const hrt_abstime &timestamp_sample, const matrix::Vector3f &angular_velocity_uncalibrated,
 				 const matrix::Vector3f &angular_acceleration_uncalibrated);
 
-	inline float FilterAngularVelocity(int axis, float data[], int N = 1);
+	inline matrix::Vector3f FilterAngularVelocity(matrix::Vector3f data[], int N = 1);
 	inline float FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N = 1);
 
 	void DisableDynamicNotchEscRpm();
@@ -90,6 +91,7 @@ private:
 	void SensorBiasUpdate(bool force = false);
 	bool SensorSelectionUpdate(const hrt_abstime &time_now_us, bool force = false);
 	void UpdateDynamicNotchEscRpm(const hrt_abstime &time_now_us, bool force = false);
+	float NotchBeta(float frequency_hz) const;
 	void UpdateDynamicNotchFFT(const hrt_abstime &time_now_us, bool force = false);
 	bool UpdateSampleRate();
 
@@ -131,9 +133,10 @@ private:
 	float _filter_sample_rate_hz{NAN};
 
 	// angular velocity filters
-	math::LowPassFilter2p<float> _lp_filter_velocity[3] {};
-	math::NotchFilter<float> _notch_filter0_velocity[3] {};
-	math::NotchFilter<float> _notch_filter1_velocity[3] {};
+	// all axes share the same coefficients: filter them together, in a single pass over the samples
+	math::LowPassFilter2p<matrix::Vector3f> _lp_filter_velocity{};
+	math::NotchFilter<matrix::Vector3f> _notch_filter0_velocity{};
+	math::NotchFilter<matrix::Vector3f> _notch_filter1_velocity{};
 
 #if !defined(CONSTRAINED_FLASH)
 
@@ -147,13 +150,26 @@ private:
 	// ESC RPM
 	static constexpr int MAX_NUM_ESCS = sizeof(esc_status_s::esc) / sizeof(esc_status_s::esc[0]);
 
-	using NotchFilterHarmonic = math::NotchFilter<float>[3][MAX_NUM_ESCS];
+	using NotchFilterHarmonic = math::NotchFilter<matrix::Vector3f>[MAX_NUM_ESCS];
 	NotchFilterHarmonic *_dynamic_notch_filter_esc_rpm{nullptr};
 
 	int _esc_rpm_harmonics{0};
+	int _esc_rpm_harmonics_capacity{0}; ///< allocated number of harmonics, >= _esc_rpm_harmonics
 	px4::Bitset<MAX_NUM_ESCS> _esc_available{};
 	hrt_abstime _last_esc_rpm_notch_update[MAX_NUM_ESCS] {};
 
+	// the notch updates of an esc_status update are spread over multiple cycles (round-robin over the ESCs)
+	static constexpr int ESC_RPM_NOTCH_UPDATE_BUDGET = 8; ///< maximum number of notch updates per cycle
+	float _esc_rpm_hz[MAX_NUM_ESCS] {};
+	px4::Bitset<MAX_NUM_ESCS> _esc_rpm_update_pending{};
+	px4::Bitset<MAX_NUM_ESCS> _esc_rpm_update_force{};
+	int _esc_rpm_update_index{0};
+
+	// cos/sin table of the normalized notch frequency [0, pi] for the notch coefficient updates
+	static constexpr int NOTCH_LUT_SIZE = 64;
+	float _notch_cos_lut[NOTCH_LUT_SIZE + 1] {};
+	float _notch_sin_lut[NOTCH_LUT_SIZE + 1] {};
+
 	perf_counter_t _dynamic_notch_filter_esc_rpm_update_perf{nullptr};
 	perf_counter_t _dynamic_notch_filter_esc_rpm_disable_perf{nullptr};
 
@@ -161,6 +177,7 @@ private:
 	static constexpr int MAX_NUM_FFT_PEAKS = sizeof(sensor_gyro_fft_s::peak_frequencies_x)
 			/ sizeof(sensor_gyro_fft_s::peak_frequencies_x[0]);
 
+	// the peaks differ per axis
 	math::NotchFilter<float> _dynamic_notch_filter_fft[3][MAX_NUM_FFT_PEAKS] {};
 
 	perf_counter_t _dynamic_notch_filter_fft_disable_perf{nullptr};
@@ -75,7 +75,7 @@ private:
 	static constexpr uint8_t BLEND_MASK_USE_VPOS_ACC = 4;
 
 	// define max number of GPS receivers supported
-	static constexpr int GPS_MAX_RECEIVERS = 2;
+	static constexpr int GPS_MAX_RECEIVERS = 3;
 	static_assert(GPS_MAX_RECEIVERS == GpsBlending::GPS_MAX_RECEIVERS_BLEND,
 		      "GPS_MAX_RECEIVERS must match to GPS_MAX_RECEIVERS_BLEND");
 
@@ -86,6 +86,7 @@ private:
 	uORB::SubscriptionCallbackWorkItem _sensor_gps_sub[GPS_MAX_RECEIVERS] {	/**< sensor data subscription */
 		{this, ORB_ID(sensor_gps), 0},
 		{this, ORB_ID(sensor_gps), 1},
+		{this, ORB_ID(sensor_gps), 2},
 	};
 
 	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
@@ -204,146 +204,107 @@ bool GpsBlending::blend_gps_data(uint64_t hrt_now_us)
 	}
 
 	if (gps_new_output_data) {
-		// calculate the sum squared speed accuracy across all GPS sensors
-		float speed_accuracy_sum_sq = 0.0f;
-
-		if (_blend_use_spd_acc) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].s_variance_m_s > 0.0f) {
-					speed_accuracy_sum_sq += _gps_state[i].s_variance_m_s * _gps_state[i].s_variance_m_s;
-				}
-			}
-		}
-
-		// calculate the sum squared horizontal position accuracy across all GPS sensors
-		float horizontal_accuracy_sum_sq = 0.0f;
-
-		if (_blend_use_hpos_acc) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 2 && _gps_state[i].eph > 0.0f) {
-					horizontal_accuracy_sum_sq += _gps_state[i].eph * _gps_state[i].eph;
-				}
-			}
-		}
-
-		// calculate the sum squared vertical position accuracy across all GPS sensors
-		float vertical_accuracy_sum_sq = 0.0f;
-
-		if (_blend_use_vpos_acc) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].epv > 0.0f) {
-					vertical_accuracy_sum_sq += _gps_state[i].epv * _gps_state[i].epv;
-				}
-			}
-		}
-
-		// Check if we can do blending using reported accuracy
-		bool can_do_blending = (horizontal_accuracy_sum_sq > 0.0f || vertical_accuracy_sum_sq > 0.0f
-					|| speed_accuracy_sum_sq > 0.0f);
+		// blend weight for each GPS. The blend weights must sum to 1.0 across all instances.
+		float blend_weights[GPS_MAX_RECEIVERS_BLEND] {};
 
 		// if we can't do blending using reported accuracy, return false and hard switch logic will be used instead
-		if (!can_do_blending) {
+		if (!calc_blend_weights(blend_weights)) {
 			return false;
 		}
 
-		float sum_of_all_weights = 0.0f;
-
-		// calculate a weighting using the reported speed accuracy
-		float spd_blend_weights[GPS_MAX_RECEIVERS_BLEND] {};
+		// move all receivers to the sample time of the timing reference
+		align_gps_states(_gps_state[_gps_time_ref_index].timestamp);
 
-		if (speed_accuracy_sum_sq > 0.0f && _blend_use_spd_acc) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_spd_weights = 0.0f;
+		// With updated weights we can calculate a blended GPS solution and
+		// offsets for each physical receiver
+		sensor_gps_s gps_blended_state = gps_blend_states(blend_weights);
 
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].s_variance_m_s >= 0.001f) {
-					spd_blend_weights[i] = 1.0f / (_gps_state[i].s_variance_m_s * _gps_state[i].s_variance_m_s);
-					sum_of_spd_weights += spd_blend_weights[i];
-				}
-			}
+		update_gps_offsets(gps_blended_state);
 
-			// normalise the weights
-			if (sum_of_spd_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-					spd_blend_weights[i] = spd_blend_weights[i] / sum_of_spd_weights;
-				}
+		// calculate a blended output from the offset corrected receiver data
+		// publish if blending was successful
+		calc_gps_blend_output(gps_blended_state, blend_weights);
 
-				sum_of_all_weights += 1.0f;
-			}
-		}
+		_gps_blended_state = gps_blended_state;
+		_selected_gps = GPS_MAX_RECEIVERS_BLEND;
+		_is_new_output_data_available = true;
+	}
 
-		// calculate a weighting using the reported horizontal position
-		float hpos_blend_weights[GPS_MAX_RECEIVERS_BLEND] {};
+	return true;
+}
 
-		if (horizontal_accuracy_sum_sq > 0.0f && _blend_use_hpos_acc) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_hpos_weights = 0.0f;
+bool GpsBlending::calc_blend_weights(float blend_weights[GPS_MAX_RECEIVERS_BLEND]) const
+{
+	// inverse variance weighting of each metric, every metric that has information contributes equally
+	float spd_weights[GPS_MAX_RECEIVERS_BLEND] {};
+	float hpos_weights[GPS_MAX_RECEIVERS_BLEND] {};
+	float vpos_weights[GPS_MAX_RECEIVERS_BLEND] {};
+	float spd_weights_sum = 0.f;
+	float hpos_weights_sum = 0.f;
+	float vpos_weights_sum = 0.f;
 
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 2 && _gps_state[i].eph >= 0.001f) {
-					hpos_blend_weights[i] = horizontal_accuracy_sum_sq / (_gps_state[i].eph * _gps_state[i].eph);
-					sum_of_hpos_weights += hpos_blend_weights[i];
-				}
-			}
+	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
+		const sensor_gps_s &gps = _gps_state[i];
 
-			// normalise the weights
-			if (sum_of_hpos_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-					hpos_blend_weights[i] = hpos_blend_weights[i] / sum_of_hpos_weights;
-				}
+		if (_blend_use_spd_acc && gps.fix_type >= 3 && gps.s_variance_m_s >= 0.001f) {
+			spd_weights[i] = 1.f / (gps.s_variance_m_s * gps.s_variance_m_s);
+			spd_weights_sum += spd_weights[i];
+		}
 
-				sum_of_all_weights += 1.0f;
-			}
+		if (_blend_use_hpos_acc && gps.fix_type >= 2 && gps.eph >= 0.001f) {
+			hpos_weights[i] = 1.f / (gps.eph * gps.eph);
+			hpos_weights_sum += hpos_weights[i];
 		}
 
-		// calculate a weighting using the reported vertical position accuracy
-		float vpos_blend_weights[GPS_MAX_RECEIVERS_BLEND] = {};
+		if (_blend_use_vpos_acc && gps.fix_type >= 3 && gps.epv >= 0.001f) {
+			vpos_weights[i] = 1.f / (gps.epv * gps.epv);
+			vpos_weights_sum += vpos_weights[i];
+		}
+	}
 
-		if (vertical_accuracy_sum_sq > 0.0f && _blend_use_vpos_acc) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_vpos_weights = 0.0f;
+	const float spd_scale = (spd_weights_sum > 0.f) ? 1.f / spd_weights_sum : 0.f;
+	const float hpos_scale = (hpos_weights_sum > 0.f) ? 1.f / hpos_weights_sum : 0.f;
+	const float vpos_scale = (vpos_weights_sum > 0.f) ? 1.f / vpos_weights_sum : 0.f;
+	const float metric_count = (spd_scale > 0.f ? 1.f : 0.f) + (hpos_scale > 0.f ? 1.f : 0.f) + (vpos_scale > 0.f ? 1.f : 0.f);
 
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].epv >= 0.001f) {
-					vpos_blend_weights[i] = vertical_accuracy_sum_sq / (_gps_state[i].epv * _gps_state[i].epv);
-					sum_of_vpos_weights += vpos_blend_weights[i];
-				}
-			}
+	if (metric_count < 1.f) {
+		return false;
+	}
 
-			// normalise the weights
-			if (sum_of_vpos_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-					vpos_blend_weights[i] = vpos_blend_weights[i] / sum_of_vpos_weights;
-				}
+	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
+		blend_weights[i] = (spd_weights[i] * spd_scale + hpos_weights[i] * hpos_scale + vpos_weights[i] * vpos_scale)
+				   / metric_count;
+	}
 
-				sum_of_all_weights += 1.0f;
-			};
-		}
+	return true;
+}
 
-		// blend weight for each GPS. The blend weights must sum to 1.0 across all instances.
-		float blend_weights[GPS_MAX_RECEIVERS_BLEND];
+void GpsBlending::align_gps_states(hrt_abstime epoch)
+{
+	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
+		const sensor_gps_s &gps = _gps_state[i];
+		_gps_aligned[i] = gps;
 
-		// calculate an overall weight
-		for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
-			blend_weights[i] = (hpos_blend_weights[i] + vpos_blend_weights[i] + spd_blend_weights[i]) / sum_of_all_weights;
+		if (!gps.vel_ned_valid || (gps.timestamp == 0) || (gps.timestamp == epoch)) {
+			continue;
 		}
 
-		// With updated weights we can calculate a blended GPS solution and
-		// offsets for each physical receiver
-		sensor_gps_s gps_blended_state = gps_blend_states(blend_weights);
-
-		update_gps_offsets(gps_blended_state);
+		// the receivers are at most half an update interval apart, propagate with the reported velocity
+		const float dt = 1e-6f * (float)((int64_t)epoch - (int64_t)gps.timestamp);
 
-		// calculate a blended output from the offset corrected receiver data
-		// publish if blending was successful
-		calc_gps_blend_output(gps_blended_state, blend_weights);
+		if (fabsf(dt) > GPS_TIMEOUT_S) {
+			continue;
+		}
 
-		_gps_blended_state = gps_blended_state;
-		_selected_gps = GPS_MAX_RECEIVERS_BLEND;
-		_is_new_output_data_available = true;
+		double lat_deg_res = 0;
+		double lon_deg_res = 0;
+		add_vector_to_global_position(gps.lat * 1.0e-7, gps.lon * 1.0e-7,
+					      gps.vel_n_m_s * dt, gps.vel_e_m_s * dt,
+					      &lat_deg_res, &lon_deg_res);
+		_gps_aligned[i].lat = (int32_t)(1.0E7 * lat_deg_res);
+		_gps_aligned[i].lon = (int32_t)(1.0E7 * lon_deg_res);
+		_gps_aligned[i].alt = gps.alt - (int32_t)(gps.vel_d_m_s * dt * 1e3f);
 	}
-
-	return true;
 }
 
 sensor_gps_s GpsBlending::gps_blend_states(float blend_weights[GPS_MAX_RECEIVERS_BLEND]) const
@@ -362,11 +323,13 @@ sensor_gps_s GpsBlending::gps_blend_states(float blend_weights[GPS_MAX_RECEIVERS
 	}
 
 	// initialise the blended states so we can accumulate the results using the weightings for each GPS receiver.
-	sensor_gps_s gps_blended_state{_gps_state[gps_best_index]}; // start with best GPS for all other misc fields
+	sensor_gps_s gps_blended_state{_gps_aligned[gps_best_index]}; // start with best GPS for all other misc fields
+
+	// the positions are aligned to the sample time of the timing reference
+	gps_blended_state.timestamp = _gps_state[_gps_time_ref_index].timestamp;
+	gps_blended_state.timestamp_sample = _gps_state[_gps_time_ref_index].timestamp_sample;
 
-	// zerp all fields that are an accumulated blend below
-	gps_blended_state.timestamp = 0;
-	gps_blended_state.timestamp_sample = 0;
+	// zero all fields that are an accumulated blend below
 	gps_blended_state.vel_m_s = 0;
 	gps_blended_state.vel_n_m_s = 0;
 	gps_blended_state.vel_e_m_s = 0;
@@ -378,9 +341,6 @@ sensor_gps_s GpsBlending::gps_blend_states(float blend_weights[GPS_MAX_RECEIVERS
 		// If any receiver contributing has an invalid velocity, then report blended velocity as invalid
 		if (blend_weights[i] > 0.0f) {
 
-			// blend the timing data
-			gps_blended_state.timestamp += (uint64_t)((double)_gps_state[i].timestamp * (double)blend_weights[i]);
-			gps_blended_state.timestamp_sample += (uint64_t)((double)_gps_state[i].timestamp_sample * (double)blend_weights[i]);
 
 			// calculate a blended average speed and velocity vector
 			gps_blended_state.vel_m_s += _gps_state[i].vel_m_s * blend_weights[i];
@@ -450,14 +410,14 @@ sensor_gps_s GpsBlending::gps_blend_states(float blend_weights[GPS_MAX_RECEIVERS
 			// calculate the horizontal offset
 			Vector2f horiz_offset{};
 			get_vector_to_next_waypoint((gps_blended_state.lat / 1.0e7), (gps_blended_state.lon / 1.0e7),
-						    (_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
+						    (_gps_aligned[i].lat / 1.0e7), (_gps_aligned[i].lon / 1.0e7),
 						    &horiz_offset(0), &horiz_offset(1));
 
 			// sum weighted offsets
 			blended_NE_offset_m += horiz_offset * blend_weights[i];
 
 			// calculate vertical offset
-			float vert_offset = (float)(_gps_state[i].alt - gps_blended_state.alt);
+			float vert_offset = (float)(_gps_aligned[i].alt - gps_blended_state.alt);
 
 			// sum weighted offsets
 			blended_alt_offset_mm += vert_offset * blend_weights[i];
@@ -516,13 +476,13 @@ void GpsBlending::update_gps_offsets(const sensor_gps_s &gps_blended_state)
 	// Calculate a filtered position delta for each GPS relative to the blended solution state
 	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
 		Vector2f offset;
-		get_vector_to_next_waypoint((_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
+		get_vector_to_next_waypoint((_gps_aligned[i].lat / 1.0e7), (_gps_aligned[i].lon / 1.0e7),
 					    (gps_blended_state.lat / 1.0e7), (gps_blended_state.lon / 1.0e7),
 					    &offset(0), &offset(1));
 
 		_NE_pos_offset_m[i] = offset * alpha[i] + _NE_pos_offset_m[i] * (1.0f - alpha[i]);
 
-		_hgt_offset_mm[i] = (float)(gps_blended_state.alt - _gps_state[i].alt) *  alpha[i] +
+		_hgt_offset_mm[i] = (float)(gps_blended_state.alt - _gps_aligned[i].alt) *  alpha[i] +
 				    _hgt_offset_mm[i] * (1.0f - alpha[i]);
 	}
 
@@ -532,14 +492,15 @@ void GpsBlending::update_gps_offsets(const sensor_gps_s &gps_blended_state)
 
 	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS_BLEND; i++) {
 		for (uint8_t j = i; j < GPS_MAX_RECEIVERS_BLEND; j++) {
-			if (i != j) {
+			// only compare receivers that are used for blending
+			if (i != j && _gps_state[i].fix_type >= 2 && _gps_state[j].fix_type >= 2) {
 				Vector2f offset;
-				get_vector_to_next_waypoint((_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
-							    (_gps_state[j].lat / 1.0e7), (_gps_state[j].lon / 1.0e7),
+				get_vector_to_next_waypoint((_gps_aligned[i].lat / 1.0e7), (_gps_aligned[i].lon / 1.0e7),
+							    (_gps_aligned[j].lat / 1.0e7), (_gps_aligned[j].lon / 1.0e7),
 							    &offset(0), &offset(1));
 				max_ne_offset(0) = fmaxf(max_ne_offset(0), fabsf(offset(0)));
 				max_ne_offset(1) = fmaxf(max_ne_offset(1), fabsf(offset(1)));
-				max_alt_offset = fmaxf(max_alt_offset, fabsf((float)(_gps_state[i].alt - _gps_state[j].alt)));
+				max_alt_offset = fmaxf(max_alt_offset, fabsf((float)(_gps_aligned[i].alt - _gps_aligned[j].alt)));
 			}
 		}
 	}
@@ -564,15 +525,15 @@ void GpsBlending::calc_gps_blend_output(sensor_gps_s &gps_blended_state,
 		if (blend_weights[i] > 0.0f) {
 
 			// Add the sum of weighted offsets to the reference position to obtain the blended position
-			const double lat_deg_orig = (double)_gps_state[i].lat * 1.0e-7;
-			const double lon_deg_orig = (double)_gps_state[i].lon * 1.0e-7;
+			const double lat_deg_orig = (double)_gps_aligned[i].lat * 1.0e-7;
+			const double lon_deg_orig = (double)_gps_aligned[i].lon * 1.0e-7;
 			double lat_deg_offset_res = 0;
 			double lon_deg_offset_res = 0;
 			add_vector_to_global_position(lat_deg_orig, lon_deg_orig,
 						      _NE_pos_offset_m[i](0), _NE_pos_offset_m[i](1),
 						      &lat_deg_offset_res, &lon_deg_offset_res);
 
-			float alt_offset = _gps_state[i].alt + (int32_t)_hgt_offset_mm[i];
+			float alt_offset = _gps_aligned[i].alt + (int32_t)_hgt_offset_mm[i];
 
 
 			// calculate the horizontal offset
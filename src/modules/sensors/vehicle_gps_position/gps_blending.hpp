@@ -63,7 +63,7 @@ public:
 	~GpsBlending() = default;
 
 	// define max number of GPS receivers supported for blending
-	static constexpr int GPS_MAX_RECEIVERS_BLEND = 2;
+	static constexpr int GPS_MAX_RECEIVERS_BLEND = 3;
 
 	void setGpsData(const sensor_gps_s &gps_data, int instance)
 	{
@@ -102,6 +102,18 @@ private:
 	*/
 	bool blend_gps_data(uint64_t hrt_now_us);
 
+	/*
+	 * Calculate the inverse variance weight of each receiver from the enabled accuracy metrics.
+	 * Returns false if none of the receivers reports a usable accuracy.
+	 */
+	bool calc_blend_weights(float blend_weights[GPS_MAX_RECEIVERS_BLEND]) const;
+
+	/*
+	 * Propagate the position of each receiver to a common epoch using its reported velocity,
+	 * so that a receiver reporting a few tens of ms earlier doesn't lag behind in the blended position.
+	 */
+	void align_gps_states(hrt_abstime epoch);
+
 	/*
 	 * Calculate internal states used to blend GPS data from multiple receivers using weightings calculated
 	 * by calc_blend_weights()
@@ -121,6 +133,7 @@ private:
 	void calc_gps_blend_output(sensor_gps_s &gps_blended_state, float blend_weights[GPS_MAX_RECEIVERS_BLEND]) const;
 
 	sensor_gps_s _gps_state[GPS_MAX_RECEIVERS_BLEND] {}; ///< internal state data for the physical GPS
+	sensor_gps_s _gps_aligned[GPS_MAX_RECEIVERS_BLEND] {}; ///< physical GPS data with the position moved to the blending epoch
 	sensor_gps_s _gps_blended_state {};
 	bool _gps_updated[GPS_MAX_RECEIVERS_BLEND] {};
 	int _selected_gps{0};
@@ -45,6 +45,9 @@
 
 using matrix::Vector3f;
 
+// index reported by getSelectedGps() when the blended solution is used
+static constexpr int kBlendedInstance = GpsBlending::GPS_MAX_RECEIVERS_BLEND;
+
 class GpsBlendingTest : public ::testing::Test
 {
 public:
@@ -206,7 +209,7 @@ TEST_F(GpsBlendingTest, dualReceiverBlendingHPos)
 
 	// THEN: the blended instance should be selected (2)
 	// and the eph should be adjusted
-	EXPECT_EQ(gps_blending.getSelectedGps(), 2);
+	EXPECT_EQ(gps_blending.getSelectedGps(), kBlendedInstance);
 	EXPECT_EQ(gps_blending.getNumberOfGpsSuitableForBlending(), 2);
 	EXPECT_TRUE(gps_blending.isNewOutputDataAvailable());
 	EXPECT_LT(gps_blending.getOutputGpsData().eph, gps_data0.eph);
@@ -275,3 +278,69 @@ TEST_F(GpsBlendingTest, dualReceiverFailover)
 	EXPECT_EQ(gps_blending.getSelectedGps(), 0);
 	EXPECT_TRUE(gps_blending.isNewOutputDataAvailable());
 }
+
+TEST_F(GpsBlendingTest, dualReceiverBlendingTimeAlignment)
+{
+	GpsBlending gps_blending;
+
+	gps_blending.setBlendingUseHPosAccuracy(true);
+
+	// GIVEN: two receivers on the same antenna flying north at 10 m/s
+	sensor_gps_s gps_data0 = getDefaultGpsData();
+	sensor_gps_s gps_data1 = getDefaultGpsData();
+	gps_data0.vel_n_m_s = gps_data1.vel_n_m_s = 10.f;
+	gps_data0.vel_e_m_s = gps_data1.vel_e_m_s = 0.f;
+	gps_data0.vel_d_m_s = gps_data1.vel_d_m_s = 0.f;
+
+	// WHEN: the second one reports the position it had 40ms earlier (0.4m further south)
+	gps_data1.timestamp = gps_data0.timestamp - 40e3;
+	double lat_deg = 0;
+	double lon_deg = 0;
+	add_vector_to_global_position(gps_data0.lat * 1e-7, gps_data0.lon * 1e-7, -0.4f, 0.f, &lat_deg, &lon_deg);
+	gps_data1.lat = (int32_t)(lat_deg * 1e7);
+	gps_data1.lon = (int32_t)(lon_deg * 1e7);
+
+	gps_blending.setGpsData(gps_data0, 0);
+	gps_blending.setGpsData(gps_data1, 1);
+	gps_blending.update(_time_now_us);
+
+	// THEN: the blended position is the position at the newest sample, not halfway in between
+	EXPECT_EQ(gps_blending.getSelectedGps(), kBlendedInstance);
+	EXPECT_TRUE(gps_blending.isNewOutputDataAvailable());
+	EXPECT_EQ(gps_blending.getOutputGpsData().timestamp, gps_data0.timestamp);
+	EXPECT_NEAR(gps_blending.getOutputGpsData().lat, gps_data0.lat, 2);
+	EXPECT_NEAR(gps_blending.getOutputGpsData().lon, gps_data0.lon, 2);
+}
+
+TEST_F(GpsBlendingTest, tripleReceiverBlending)
+{
+	GpsBlending gps_blending;
+
+	gps_blending.setBlendingUseHPosAccuracy(true);
+
+	// GIVEN: three receivers, the third one being north of the other two and twice as accurate
+	sensor_gps_s gps_data[3] {getDefaultGpsData(), getDefaultGpsData(), getDefaultGpsData()};
+	gps_data[2].eph = gps_data[0].eph / 2.f;
+	double lat_deg = 0;
+	double lon_deg = 0;
+	add_vector_to_global_position(gps_data[0].lat * 1e-7, gps_data[0].lon * 1e-7, 6.f, 0.f, &lat_deg, &lon_deg);
+	gps_data[2].lat = (int32_t)(lat_deg * 1e7);
+
+	for (int i = 0; i < 3; i++) {
+		gps_blending.setGpsData(gps_data[i], i);
+	}
+
+	gps_blending.update(_time_now_us);
+
+	// THEN: all of them are blended with weights 1/6, 1/6, 4/6
+	EXPECT_EQ(gps_blending.getSelectedGps(), kBlendedInstance);
+	EXPECT_EQ(gps_blending.getNumberOfGpsSuitableForBlending(), 3);
+	EXPECT_TRUE(gps_blending.isNewOutputDataAvailable());
+
+	Vector2f offset;
+	get_vector_to_next_waypoint(gps_data[0].lat * 1e-7, gps_data[0].lon * 1e-7,
+				    gps_blending.getOutputGpsData().lat * 1e-7, gps_blending.getOutputGpsData().lon * 1e-7,
+				    &offset(0), &offset(1));
+	EXPECT_NEAR(offset(0), 4.f, 0.05f);
+	EXPECT_NEAR(offset(1), 0.f, 0.05f);
+}
@@ -77,6 +77,6 @@ PARAM_DEFINE_FLOAT(SENS_GPS_TAU, 10.0f);
  *
  * @group Sensors
  * @min -1
- * @max 1
+ * @max 2
  */
 PARAM_DEFINE_INT32(SENS_GPS_PRIME, 0);
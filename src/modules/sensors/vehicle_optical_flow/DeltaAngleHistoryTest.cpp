@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the delta angle history
+ * Run this test only using make tests TESTFILTER=DeltaAngleHistory
+ */
+
+#include <gtest/gtest.h>
+#include <matrix/matrix/math.hpp>
+
+#include <DeltaAngleHistory.hpp>
+
+using matrix::Vector3f;
+using sensors::DeltaAngleHistory;
+
+static constexpr uint32_t IMU_DT_US{5000};
+
+// constant angular rate (rad/s) sampled as delta angles
+static void pushConstantRate(DeltaAngleHistory<32> &history, hrt_abstime start, int count, const Vector3f &rate)
+{
+	for (int i = 1; i <= count; i++) {
+		history.push(start + i * IMU_DT_US, rate * (IMU_DT_US * 1e-6f), IMU_DT_US);
+	}
+}
+
+TEST(DeltaAngleHistory, empty)
+{
+	DeltaAngleHistory<32> history;
+	Vector3f delta_angle;
+
+	EXPECT_TRUE(history.empty());
+	EXPECT_FALSE(history.integrate(1000, 2000, delta_angle));
+}
+
+TEST(DeltaAngleHistory, interpolation)
+{
+	DeltaAngleHistory<32> history;
+	const Vector3f rate{1.f, -2.f, 0.5f};
+	const hrt_abstime start = 1'000'000;
+	pushConstantRate(history, start, 10, rate);
+
+	EXPECT_EQ(history.oldest(), start);
+	EXPECT_EQ(history.newest(), start + 10 * IMU_DT_US);
+
+	// WHEN: integrating over an interval that does not match the IMU intervals
+	Vector3f delta_angle;
+	EXPECT_TRUE(history.integrate(start + 1234, start + 1234 + 20'000, delta_angle));
+
+	// THEN: the rotation is the rate times the interval
+	EXPECT_LT((delta_angle - rate * 0.02f).abs().max(), 1e-6f);
+
+	// AND: data older than the history is not available
+	EXPECT_FALSE(history.integrate(start - 1, start + 1000, delta_angle));
+
+	// AND: the end of the interval can be extrapolated by up to one IMU interval
+	EXPECT_TRUE(history.integrate(start + 40'000, start + 52'000, delta_angle));
+	EXPECT_LT((delta_angle - rate * 0.012f).abs().max(), 1e-6f);
+	EXPECT_FALSE(history.integrate(start + 40'000, start + 56'000, delta_angle));
+}
+
+TEST(DeltaAngleHistory, overflowAndGap)
+{
+	DeltaAngleHistory<32> history;
+	const Vector3f rate{0.f, 0.f, 10.f};
+	const hrt_abstime start = 1'000'000;
+
+	// WHEN: more samples than the history length are pushed, with large cumulative angles
+	pushConstantRate(history, start, 1000, rate);
+
+	// THEN: only the newest samples are kept and the resolution is preserved
+	const hrt_abstime newest = start + 1000 * IMU_DT_US;
+	EXPECT_EQ(history.newest(), newest);
+	EXPECT_EQ(history.oldest(), newest - 31 * IMU_DT_US);
+
+	Vector3f delta_angle;
+	EXPECT_TRUE(history.integrate(newest - 10'000, newest, delta_angle));
+	EXPECT_LT((delta_angle - rate * 0.01f).abs().max(), 1e-5f);
+
+	// WHEN: there is a gap in the data
+	pushConstantRate(history, newest + 100'000, 2, rate);
+
+	// THEN: the history restarts
+	EXPECT_EQ(history.oldest(), newest + 100'000);
+	EXPECT_FALSE(history.integrate(newest - 10'000, newest, delta_angle));
+}
@@ -48,8 +48,6 @@ VehicleOpticalFlow::VehicleOpticalFlow() :
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::nav_and_controllers)
 {
 	_vehicle_optical_flow_pub.advertise();
-
-	_gyro_integrator.set_reset_samples(1);
 }
 
 VehicleOpticalFlow::~VehicleOpticalFlow()
@@ -62,11 +60,11 @@ bool VehicleOpticalFlow::Start()
 {
 	_sensor_flow_sub.registerCallback();
 
-	_sensor_gyro_sub.registerCallback();
-	_sensor_gyro_sub.set_required_updates(sensor_gyro_s::ORB_QUEUE_LENGTH / 2);
-
 	_sensor_selection_sub.registerCallback();
 
+	_vehicle_imu_sub.registerCallback();
+	_vehicle_imu_sub.set_required_updates(vehicle_imu_s::ORB_QUEUE_LENGTH / 2);
+
 	ScheduleNow();
 	return true;
 }
@@ -77,8 +75,8 @@ void VehicleOpticalFlow::Stop()
 
 	// clear all registered callbacks
 	_sensor_flow_sub.unregisterCallback();
-	_sensor_gyro_sub.unregisterCallback();
 	_sensor_selection_sub.unregisterCallback();
+	_vehicle_imu_sub.unregisterCallback();
 }
 
 void VehicleOpticalFlow::ParametersUpdate()
@@ -102,7 +100,7 @@ void VehicleOpticalFlow::Run()
 	ParametersUpdate();
 
 	UpdateDistanceSensor();
-	UpdateSensorGyro();
+	UpdateVehicleImu();
 
 	sensor_optical_flow_s sensor_optical_flow;
 
@@ -118,10 +116,9 @@ void VehicleOpticalFlow::Run()
 
 		const hrt_abstime timestamp_oldest = sensor_optical_flow.timestamp_sample - lroundf(
 				sensor_optical_flow.integration_timespan_us);
-		const hrt_abstime timestamp_newest = sensor_optical_flow.timestamp;
 
 		// delta angle
-		//  - from sensor_optical_flow if available, otherwise use synchronized sensor_gyro if available
+		//  - from sensor_optical_flow if available, otherwise use synchronized vehicle_imu if available
 		if (sensor_optical_flow.delta_angle_available
 		    && PX4_ISFINITE(sensor_optical_flow.delta_angle[0])
 		    && PX4_ISFINITE(sensor_optical_flow.delta_angle[1])
@@ -131,30 +128,11 @@ void VehicleOpticalFlow::Run()
 			_delta_angle += _flow_rotation * Vector3f{sensor_optical_flow.delta_angle};
 
 		} else {
-			// integrate synchronized gyro
-			gyroSample gyro_sample;
-
-			while (_gyro_buffer.pop_oldest(timestamp_oldest, timestamp_newest, &gyro_sample)) {
-
-				_gyro_integrator.put(gyro_sample.data, gyro_sample.dt);
-
-				float min_interval_s = (sensor_optical_flow.integration_timespan_us * 1e-6f) * 0.99f;
-
-				if (_gyro_integrator.integral_dt() > min_interval_s) {
-					//PX4_INFO("integral dt: %.6f, min interval: %.6f", (double)_gyro_integrator.integral_dt(),(double) min_interval_s);
-					break;
-				}
-			}
+			// rotation over the flow integration interval, interpolated from the IMU delta angles
+			Vector3f delta_angle;
 
-			Vector3f delta_angle{NAN, NAN, NAN};
-			uint16_t delta_angle_dt;
-
-			if (_gyro_integrator.reset(delta_angle, delta_angle_dt)) {
+			if (_delta_angle_history.integrate(timestamp_oldest, sensor_optical_flow.timestamp_sample, delta_angle)) {
 				_delta_angle += delta_angle;
-
-			} else {
-				// force integrator reset
-				_gyro_integrator.reset();
 			}
 		}
 
@@ -399,59 +377,51 @@ void VehicleOpticalFlow::UpdateDistanceSensor()
 	}
 }
 
-void VehicleOpticalFlow::UpdateSensorGyro()
+void VehicleOpticalFlow::UpdateVehicleImu()
 {
 	if (_sensor_selection_sub.updated()) {
 		sensor_selection_s sensor_selection{};
 		_sensor_selection_sub.copy(&sensor_selection);
 
 		for (uint8_t i = 0; i < MAX_SENSOR_COUNT; i++) {
-			uORB::SubscriptionData<sensor_gyro_s> sensor_gyro_sub{ORB_ID(sensor_gyro), i};
+			uORB::SubscriptionData<vehicle_imu_s> vehicle_imu_sub{ORB_ID(vehicle_imu), i};
 
-			if (sensor_gyro_sub.advertised()
-			    && (sensor_gyro_sub.get().timestamp != 0)
-			    && (sensor_gyro_sub.get().device_id != 0)
-			    && (hrt_elapsed_time(&sensor_gyro_sub.get().timestamp) < 1_s)) {
+			if (vehicle_imu_sub.advertised()
+			    && (vehicle_imu_sub.get().timestamp != 0)
+			    && (vehicle_imu_sub.get().gyro_device_id != 0)
+			    && (hrt_elapsed_time(&vehicle_imu_sub.get().timestamp) < 1_s)) {
 
-				if (sensor_gyro_sub.get().device_id == sensor_selection.gyro_device_id) {
-					if (_sensor_gyro_sub.ChangeInstance(i) && _sensor_gyro_sub.registerCallback()) {
+				if (vehicle_imu_sub.get().gyro_device_id == sensor_selection.gyro_device_id) {
+					if (_vehicle_imu_sub.get_instance() == i) {
+						break;
+					}
 
-						_gyro_calibration.set_device_id(sensor_gyro_sub.get().device_id);
-						PX4_DEBUG("selecting sensor_gyro:%" PRIu8 " %" PRIu32, i, sensor_gyro_sub.get().device_id);
+					if (_vehicle_imu_sub.ChangeInstance(i) && _vehicle_imu_sub.registerCallback()) {
+						_delta_angle_history.reset();
+						PX4_DEBUG("selecting vehicle_imu:%" PRIu8 " %" PRIu32, i, vehicle_imu_sub.get().gyro_device_id);
 						break;
 
 					} else {
-						PX4_ERR("unable to register callback for sensor_gyro:%" PRIu8 " %" PRIu32, i, sensor_gyro_sub.get().device_id);
+						PX4_ERR("unable to register callback for vehicle_imu:%" PRIu8 " %" PRIu32, i, vehicle_imu_sub.get().gyro_device_id);
 					}
 				}
 			}
 		}
 	}
 
-	// buffer
-	while (_sensor_gyro_sub.updated()) {
-		const unsigned last_generation = _sensor_gyro_sub.get_last_generation();
+	while (_vehicle_imu_sub.updated()) {
+		const unsigned last_generation = _vehicle_imu_sub.get_last_generation();
 
-		sensor_gyro_s sensor_gyro;
+		vehicle_imu_s vehicle_imu;
 
-		if (_sensor_gyro_sub.copy(&sensor_gyro)) {
+		if (_vehicle_imu_sub.copy(&vehicle_imu)) {
 
-			if (_sensor_gyro_sub.get_last_generation() != last_generation + 1) {
-				PX4_ERR("sensor_gyro lost, generation %u -> %u", last_generation, _sensor_gyro_sub.get_last_generation());
+			if (_vehicle_imu_sub.get_last_generation() != last_generation + 1) {
+				PX4_ERR("vehicle_imu lost, generation %u -> %u", last_generation, _vehicle_imu_sub.get_last_generation());
 			}
 
-			_gyro_calibration.set_device_id(sensor_gyro.device_id);
-			_gyro_calibration.SensorCorrectionsUpdate();
-
-			const float dt_s = (sensor_gyro.timestamp_sample - _gyro_timestamp_sample_last) * 1e-6f;
-			_gyro_timestamp_sample_last = sensor_gyro.timestamp_sample;
-
-			gyroSample gyro_sample;
-			gyro_sample.time_us = sensor_gyro.timestamp_sample;
-			gyro_sample.data = _gyro_calibration.Correct(Vector3f{sensor_gyro.x, sensor_gyro.y, sensor_gyro.z});
-			gyro_sample.dt = dt_s;
-
-			_gyro_buffer.push(gyro_sample);
+			// a gap is detected by the history (restarts from this sample)
+			_delta_angle_history.push(vehicle_imu.timestamp_sample, Vector3f{vehicle_imu.delta_angle}, vehicle_imu.delta_angle_dt);
 		}
 	}
 }
@@ -469,8 +439,6 @@ void VehicleOpticalFlow::ClearAccumulatedData()
 
 	_quality_sum = 0;
 	_accumulated_count = 0;
-
-	_gyro_integrator.reset();
 }
 
 void VehicleOpticalFlow::PrintStatus()
@@ -36,12 +36,12 @@
 #include "data_validator/DataValidatorGroup.hpp"
 #include "RingBuffer.hpp"
 
-#include <Integrator.hpp>
+#include <DeltaAngleHistory.hpp>
 
 #include <lib/mathlib/math/Limits.hpp>
 #include <lib/matrix/matrix/math.hpp>
+#include <lib/conversion/rotation.h>
 #include <lib/perf/perf_counter.h>
-#include <lib/sensor_calibration/Gyroscope.hpp>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_config.h>
@@ -52,10 +52,10 @@
 #include <uORB/SubscriptionMultiArray.hpp>
 #include <uORB/topics/distance_sensor.h>
 #include <uORB/topics/parameter_update.h>
-#include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/sensor_optical_flow.h>
 #include <uORB/topics/sensor_selection.h>
 #include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_imu.h>
 #include <uORB/topics/vehicle_optical_flow.h>
 #include <uORB/topics/vehicle_optical_flow_vel.h>
 
@@ -76,7 +76,7 @@ public:
 private:
 	void ClearAccumulatedData();
 	void UpdateDistanceSensor();
-	void UpdateSensorGyro();
+	void UpdateVehicleImu();
 
 	void Run() override;
 
@@ -95,14 +95,11 @@ private:
 	uORB::Subscription _vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
 
 	uORB::SubscriptionCallbackWorkItem _sensor_flow_sub{this, ORB_ID(sensor_optical_flow)};
-	uORB::SubscriptionCallbackWorkItem _sensor_gyro_sub{this, ORB_ID(sensor_gyro)};
 	uORB::SubscriptionCallbackWorkItem _sensor_selection_sub{this, ORB_ID(sensor_selection)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_imu_sub{this, ORB_ID(vehicle_imu)};
 
-	sensors::IntegratorConing _gyro_integrator{};
-
-	hrt_abstime _gyro_timestamp_sample_last{0};
-
-	calibration::Gyroscope _gyro_calibration{};
+	// delta angles of the selected IMU (calibrated and coning corrected by VehicleIMU)
+	DeltaAngleHistory<32> _delta_angle_history{};
 
 	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
 
@@ -122,18 +119,11 @@ private:
 	int _distance_sensor_selected{-1}; // because we can have several distance sensor instances with different orientations
 	hrt_abstime _last_range_sensor_update{0};
 
-	struct gyroSample {
-		uint64_t time_us{}; ///< timestamp of the measurement (uSec)
-		matrix::Vector3f data{};
-		float dt{0.f};
-	};
-
 	struct rangeSample {
 		uint64_t time_us{}; ///< timestamp of the measurement (uSec)
 		float data{};
 	};
 
-	RingBuffer<gyroSample, 32> _gyro_buffer{};
 	RingBuffer<rangeSample, 5> _range_buffer{};
 
 	DEFINE_PARAMETERS(
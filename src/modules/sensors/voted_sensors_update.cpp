@@ -178,6 +178,17 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 
 			_last_accel_timestamp[uorb_index] = imu_report.timestamp_sample;
 
+			const float accel_var = imu_status.var_accel[0] + imu_status.var_accel[1] + imu_status.var_accel[2];
+			const float gyro_var = imu_status.var_gyro[0] + imu_status.var_gyro[1] + imu_status.var_gyro[2];
+
+			if (PX4_ISFINITE(accel_var) && (accel_var > 0.f)) {
+				_accel_var[uorb_index] = accel_var;
+			}
+
+			if (PX4_ISFINITE(gyro_var) && (gyro_var > 0.f)) {
+				_gyro_var[uorb_index] = gyro_var;
+			}
+
 			_accel.voter.put(uorb_index, imu_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
 					 imu_status.accel_error_count, _accel.priority[uorb_index]);
 
@@ -239,6 +250,13 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 		raw.gyro_clipping             = _last_sensor_data[gyro_best_index].gyro_clipping;
 		raw.gyro_calibration_count    = _last_sensor_data[gyro_best_index].gyro_calibration_count;
 
+		if (_param_sens_imu_mode.get() && _param_sens_imu_fuse.get()) {
+			fuseImus(raw, accel_best_index, gyro_best_index);
+
+		} else {
+			_imu_fused_count = 0;
+		}
+
 		if ((accel_best_index != _accel.last_best_vote) || (_selection.accel_device_id != _accel_device_id[accel_best_index])) {
 			_accel.last_best_vote = (uint8_t)accel_best_index;
 			_selection.accel_device_id = _accel_device_id[accel_best_index];
@@ -285,6 +303,63 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 	}
 }
 
+void VotedSensorsUpdate::fuseImus(sensor_combined_s &raw, int accel_best_index, int gyro_best_index)
+{
+	// variance floor to keep a single very quiet IMU from taking all the weight
+	static constexpr float VAR_MIN = 1e-6f;
+
+	const hrt_abstime timestamp_sample = _last_sensor_data[gyro_best_index].timestamp;
+	const hrt_abstime max_offset_us = _last_sensor_data[gyro_best_index].gyro_integral_dt / 2;
+
+	Vector3f accel_sum{};
+	Vector3f gyro_sum{};
+	float accel_weight_sum = 0.f;
+	float gyro_weight_sum = 0.f;
+	uint8_t fused_count = 0;
+
+	for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+		const sensor_combined_s &imu = _last_sensor_data[i];
+
+		const bool usable = (_accel_device_id[i] != 0) && (_gyro_device_id[i] != 0)
+				    && (_accel.priority[i] > 0) && (_gyro.priority[i] > 0)
+				    && (_accel_var[i] > 0.f) && (_gyro_var[i] > 0.f)
+				    && (_accel.voter.get_sensor_state(i) == DataValidator::ERROR_FLAG_NO_ERROR)
+				    && (_gyro.voter.get_sensor_state(i) == DataValidator::ERROR_FLAG_NO_ERROR)
+				    && (imu.accelerometer_clipping == 0) && (imu.gyro_clipping == 0)
+				    && (imu.timestamp + max_offset_us >= timestamp_sample)
+				    && (imu.timestamp <= timestamp_sample + max_offset_us);
+
+		if (usable) {
+			const float accel_weight = 1.f / math::max(_accel_var[i], VAR_MIN);
+			const float gyro_weight = 1.f / math::max(_gyro_var[i], VAR_MIN);
+
+			accel_sum += Vector3f{imu.accelerometer_m_s2} * accel_weight;
+			gyro_sum += Vector3f{imu.gyro_rad} * gyro_weight;
+			accel_weight_sum += accel_weight;
+			gyro_weight_sum += gyro_weight;
+			fused_count++;
+		}
+	}
+
+	// the selected IMU has to be part of the fused set, otherwise keep it alone
+	const sensor_combined_s &best = _last_sensor_data[gyro_best_index];
+
+	if ((fused_count > 1) && (accel_best_index == gyro_best_index)
+	    && (best.accelerometer_clipping == 0) && (best.gyro_clipping == 0)) {
+
+		const Vector3f accel = accel_sum / accel_weight_sum;
+		const Vector3f gyro = gyro_sum / gyro_weight_sum;
+
+		accel.copyTo(raw.accelerometer_m_s2);
+		gyro.copyTo(raw.gyro_rad);
+
+		_imu_fused_count = fused_count;
+
+	} else {
+		_imu_fused_count = 1;
+	}
+}
+
 bool VotedSensorsUpdate::checkFailover(SensorData &sensor, const char *sensor_name,
 				       events::px4::enums::sensor_type_t sensor_type)
 {
@@ -394,6 +469,11 @@ void VotedSensorsUpdate::printStatus()
 	PX4_INFO_RAW("\n");
 	PX4_INFO_RAW("selected accel: %" PRIu32 " (%" PRIu8 ")\n", _selection.accel_device_id, _accel.last_best_vote);
 	_accel.voter.print();
+
+	if (_param_sens_imu_mode.get() && _param_sens_imu_fuse.get()) {
+		PX4_INFO_RAW("\n");
+		PX4_INFO_RAW("fused IMUs: %" PRIu8 "\n", _imu_fused_count);
+	}
 }
 
 void VotedSensorsUpdate::sensorsPoll(sensor_combined_s &raw)
@@ -130,6 +130,12 @@ private:
 	 */
 	void imuPoll(sensor_combined_s &raw);
 
+	/**
+	 * Replace the selected IMU data in raw with the inverse variance weighted mean of all healthy IMUs
+	 * sampled within half an integration period of the selected gyro (SENS_IMU_FUSE).
+	 */
+	void fuseImus(sensor_combined_s &raw, int accel_best_index, int gyro_best_index);
+
 	/**
 	 * Check & handle failover of a sensor
 	 * @return true if a switch occured (could be for a non-critical reason)
@@ -174,12 +180,18 @@ private:
 
 	uint64_t _last_accel_timestamp[MAX_SENSOR_COUNT] {};	/**< latest full timestamp */
 
+	float _accel_var[MAX_SENSOR_COUNT] {};	/**< accel noise variance (sum over axes) from vehicle_imu_status, used for fusion weights */
+	float _gyro_var[MAX_SENSOR_COUNT] {};	/**< gyro noise variance (sum over axes) from vehicle_imu_status, used for fusion weights */
+
+	uint8_t _imu_fused_count{0};		/**< number of IMUs in the last fused sample */
+
 	sensor_selection_s _selection {};		/**< struct containing the sensor selection to be published to the uORB */
 
 	bool _parameter_update{false};
 
 	DEFINE_PARAMETERS(
-		(ParamBool<px4::params::SENS_IMU_MODE>) _param_sens_imu_mode
+		(ParamBool<px4::params::SENS_IMU_MODE>) _param_sens_imu_mode,
+		(ParamBool<px4::params::SENS_IMU_FUSE>) _param_sens_imu_fuse
 	)
 };
 
@@ -62,6 +62,9 @@ GZBridge::~GZBridge()
 	for (auto &sub_topic : _node.SubscribedTopics()) {
 		_node.Unsubscribe(sub_topic);
 	}
+
+	perf_free(_ingest_perf);
+	perf_free(_imu_dropped_perf);
 }
 
 int GZBridge::init()
@@ -327,6 +330,9 @@ void GZBridge::clockCallback(const ignition::msgs::Clock &clock)
 	}
 
 	pthread_mutex_unlock(&_mutex);
+
+	// publish everything received for this step
+	_ingest_work_item.ScheduleNow();
 }
 
 void GZBridge::imuCallback(const ignition::msgs::IMU &imu)
@@ -351,37 +357,28 @@ void GZBridge::imuCallback(const ignition::msgs::IMU &imu)
 			imu.linear_acceleration().y(),
 			imu.linear_acceleration().z()));
 
-	// publish accel
-	sensor_accel_s sensor_accel{};
-	sensor_accel.timestamp_sample = time_us;
-	sensor_accel.device_id = 1310988; // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
-	sensor_accel.x = accel_b.X();
-	sensor_accel.y = accel_b.Y();
-	sensor_accel.z = accel_b.Z();
-	sensor_accel.temperature = NAN;
-	sensor_accel.samples = 1;
-	sensor_accel.timestamp = time_us; // hrt_absolute_time();
-	_sensor_accel_pub.publish(sensor_accel);
-
-
 	ignition::math::Vector3d gyro_b = q_FLU_to_FRD.RotateVector(ignition::math::Vector3d(
 			imu.angular_velocity().x(),
 			imu.angular_velocity().y(),
 			imu.angular_velocity().z()));
 
-	// publish gyro
-	sensor_gyro_s sensor_gyro{};
-	sensor_gyro.timestamp_sample = time_us;
-	sensor_gyro.device_id = 1310988; // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
-	sensor_gyro.x = gyro_b.X();
-	sensor_gyro.y = gyro_b.Y();
-	sensor_gyro.z = gyro_b.Z();
-	sensor_gyro.temperature = NAN;
-	sensor_gyro.samples = 1;
-	sensor_gyro.timestamp = time_us; // hrt_absolute_time();
-	_sensor_gyro_pub.publish(sensor_gyro);
+	if (_imu_queue_count < IMU_QUEUE_SIZE) {
+		ImuSample &sample = _imu_queue[_imu_queue_count++];
+		sample.time_us = time_us;
+		sample.accel[0] = accel_b.X();
+		sample.accel[1] = accel_b.Y();
+		sample.accel[2] = accel_b.Z();
+		sample.gyro[0] = gyro_b.X();
+		sample.gyro[1] = gyro_b.Y();
+		sample.gyro[2] = gyro_b.Z();
+
+	} else {
+		perf_count(_imu_dropped_perf);
+	}
 
 	pthread_mutex_unlock(&_mutex);
+
+	_ingest_work_item.ScheduleNow();
 }
 
 void GZBridge::poseInfoCallback(const ignition::msgs::Pose_V &pose)
@@ -401,102 +398,14 @@ void GZBridge::poseInfoCallback(const ignition::msgs::Pose_V &pose)
 				updateClock(pose.header().stamp().sec(), pose.header().stamp().nsec());
 			}
 
-			const double dt = math::constrain((time_us - _timestamp_prev) * 1e-6, 0.001, 0.1);
-			_timestamp_prev = time_us;
-
-			ignition::msgs::Vector3d pose_position = pose.pose(p).position();
-			ignition::msgs::Quaternion pose_orientation = pose.pose(p).orientation();
-
-			static const auto q_FLU_to_FRD = ignition::math::Quaterniond(0, 1, 0, 0);
-
-			/**
-			 * @brief Quaternion for rotation between ENU and NED frames
-			 *
-			 * NED to ENU: +PI/2 rotation about Z (Down) followed by a +PI rotation around X (old North/new East)
-			 * ENU to NED: +PI/2 rotation about Z (Up) followed by a +PI rotation about X (old East/new North)
-			 * This rotation is symmetric, so q_ENU_to_NED == q_NED_to_ENU.
-			 */
-			static const auto q_ENU_to_NED = ignition::math::Quaterniond(0, 0.70711, 0.70711, 0);
-
-			// ground truth
-			ignition::math::Quaterniond q_gr = ignition::math::Quaterniond(
-					pose_orientation.w(),
-					pose_orientation.x(),
-					pose_orientation.y(),
-					pose_orientation.z());
-
-			ignition::math::Quaterniond q_gb = q_gr * q_FLU_to_FRD.Inverse();
-			ignition::math::Quaterniond q_nb = q_ENU_to_NED * q_gb;
-
-			// publish attitude groundtruth
-			vehicle_attitude_s vehicle_attitude_groundtruth{};
-			vehicle_attitude_groundtruth.timestamp_sample = time_us;
-			vehicle_attitude_groundtruth.q[0] = q_nb.W();
-			vehicle_attitude_groundtruth.q[1] = q_nb.X();
-			vehicle_attitude_groundtruth.q[2] = q_nb.Y();
-			vehicle_attitude_groundtruth.q[3] = q_nb.Z();
-			vehicle_attitude_groundtruth.timestamp = hrt_absolute_time();
-			_attitude_ground_truth_pub.publish(vehicle_attitude_groundtruth);
-
-			// publish angular velocity groundtruth
-			const matrix::Eulerf euler{matrix::Quatf(vehicle_attitude_groundtruth.q)};
-			vehicle_angular_velocity_s vehicle_angular_velocity_groundtruth{};
-			vehicle_angular_velocity_groundtruth.timestamp_sample = time_us;
-
-			const matrix::Vector3f angular_velocity = (euler - _euler_prev) / dt;
-			_euler_prev = euler;
-			angular_velocity.copyTo(vehicle_angular_velocity_groundtruth.xyz);
-
-			vehicle_angular_velocity_groundtruth.timestamp = hrt_absolute_time();
-			_angular_velocity_ground_truth_pub.publish(vehicle_angular_velocity_groundtruth);
-
-			if (!_pos_ref.isInitialized()) {
-				_pos_ref.initReference((double)_param_sim_home_lat.get(), (double)_param_sim_home_lon.get(), hrt_absolute_time());
-			}
-
-			vehicle_local_position_s local_position_groundtruth{};
-			local_position_groundtruth.timestamp_sample = time_us;
-
-			// position ENU -> NED
-			const matrix::Vector3d position{pose_position.y(), pose_position.x(), -pose_position.z()};
-			const matrix::Vector3d velocity{(position - _position_prev) / dt};
-			const matrix::Vector3d acceleration{(velocity - _velocity_prev) / dt};
-
-			_position_prev = position;
-			_velocity_prev = velocity;
-
-			local_position_groundtruth.ax = acceleration(0);
-			local_position_groundtruth.ay = acceleration(1);
-			local_position_groundtruth.az = acceleration(2);
-			local_position_groundtruth.vx = velocity(0);
-			local_position_groundtruth.vy = velocity(1);
-			local_position_groundtruth.vz = velocity(2);
-			local_position_groundtruth.x = position(0);
-			local_position_groundtruth.y = position(1);
-			local_position_groundtruth.z = position(2);
-
-			local_position_groundtruth.ref_lat = _pos_ref.getProjectionReferenceLat(); // Reference point latitude in degrees
-			local_position_groundtruth.ref_lon = _pos_ref.getProjectionReferenceLon(); // Reference point longitude in degrees
-			local_position_groundtruth.ref_alt = _param_sim_home_alt.get();
-			local_position_groundtruth.ref_timestamp = _pos_ref.getProjectionReferenceTimestamp();
-
-			local_position_groundtruth.timestamp = hrt_absolute_time();
-			_lpos_ground_truth_pub.publish(local_position_groundtruth);
-
-			if (_pos_ref.isInitialized()) {
-				// publish position groundtruth
-				vehicle_global_position_s global_position_groundtruth{};
-				global_position_groundtruth.timestamp_sample = time_us;
-
-				_pos_ref.reproject(local_position_groundtruth.x, local_position_groundtruth.y,
-						   global_position_groundtruth.lat, global_position_groundtruth.lon);
-
-				global_position_groundtruth.alt = _param_sim_home_alt.get() - static_cast<float>(position(2));
-				global_position_groundtruth.timestamp = hrt_absolute_time();
-				_gpos_ground_truth_pub.publish(global_position_groundtruth);
-			}
+			// only the latest pose is needed for the ground truth
+			_pose_pending = pose.pose(p);
+			_pose_pending_time_us = time_us;
+			_pose_pending_updated = true;
 
 			pthread_mutex_unlock(&_mutex);
+
+			_ingest_work_item.ScheduleNow();
 			return;
 		}
 	}
@@ -504,6 +413,170 @@ void GZBridge::poseInfoCallback(const ignition::msgs::Pose_V &pose)
 	pthread_mutex_unlock(&_mutex);
 }
 
+void GZBridge::publishImu(const uint64_t time_us, const float accel[3], const float gyro[3])
+{
+	// publish accel
+	sensor_accel_s sensor_accel{};
+	sensor_accel.timestamp_sample = time_us;
+	sensor_accel.device_id = 1310988; // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
+	sensor_accel.x = accel[0];
+	sensor_accel.y = accel[1];
+	sensor_accel.z = accel[2];
+	sensor_accel.temperature = NAN;
+	sensor_accel.samples = 1;
+	sensor_accel.timestamp = time_us; // hrt_absolute_time();
+	_sensor_accel_pub.publish(sensor_accel);
+
+	// publish gyro
+	sensor_gyro_s sensor_gyro{};
+	sensor_gyro.timestamp_sample = time_us;
+	sensor_gyro.device_id = 1310988; // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
+	sensor_gyro.x = gyro[0];
+	sensor_gyro.y = gyro[1];
+	sensor_gyro.z = gyro[2];
+	sensor_gyro.temperature = NAN;
+	sensor_gyro.samples = 1;
+	sensor_gyro.timestamp = time_us; // hrt_absolute_time();
+	_sensor_gyro_pub.publish(sensor_gyro);
+}
+
+void GZBridge::processIngest()
+{
+	perf_begin(_ingest_perf);
+
+	ImuSample imu_samples[IMU_QUEUE_SIZE];
+	int imu_sample_count = 0;
+
+	ignition::msgs::Pose pose;
+	uint64_t pose_time_us = 0;
+	bool pose_updated = false;
+
+	pthread_mutex_lock(&_mutex);
+
+	imu_sample_count = _imu_queue_count;
+	memcpy(imu_samples, _imu_queue, imu_sample_count * sizeof(imu_samples[0]));
+	_imu_queue_count = 0;
+
+	if (_pose_pending_updated) {
+		pose.Swap(&_pose_pending);
+		pose_time_us = _pose_pending_time_us;
+		pose_updated = true;
+		_pose_pending_updated = false;
+	}
+
+	pthread_mutex_unlock(&_mutex);
+
+	_imu_batch_max = math::max(_imu_batch_max, imu_sample_count);
+
+	for (int i = 0; i < imu_sample_count; i++) {
+		publishImu(imu_samples[i].time_us, imu_samples[i].accel, imu_samples[i].gyro);
+	}
+
+	if (pose_updated) {
+		publishPose(pose_time_us, pose);
+	}
+
+	perf_end(_ingest_perf);
+}
+
+void GZBridge::publishPose(const uint64_t time_us, const ignition::msgs::Pose &pose)
+{
+	const double dt = math::constrain((time_us - _timestamp_prev) * 1e-6, 0.001, 0.1);
+	_timestamp_prev = time_us;
+
+	ignition::msgs::Vector3d pose_position = pose.position();
+	ignition::msgs::Quaternion pose_orientation = pose.orientation();
+
+	static const auto q_FLU_to_FRD = ignition::math::Quaterniond(0, 1, 0, 0);
+
+	/**
+	 * @brief Quaternion for rotation between ENU and NED frames
+	 *
+	 * NED to ENU: +PI/2 rotation about Z (Down) followed by a +PI rotation around X (old North/new East)
+	 * ENU to NED: +PI/2 rotation about Z (Up) followed by a +PI rotation about X (old East/new North)
+	 * This rotation is symmetric, so q_ENU_to_NED == q_NED_to_ENU.
+	 */
+	static const auto q_ENU_to_NED = ignition::math::Quaterniond(0, 0.70711, 0.70711, 0);
+
+	// ground truth
+	ignition::math::Quaterniond q_gr = ignition::math::Quaterniond(
+			pose_orientation.w(),
+			pose_orientation.x(),
+			pose_orientation.y(),
+			pose_orientation.z());
+
+	ignition::math::Quaterniond q_gb = q_gr * q_FLU_to_FRD.Inverse();
+	ignition::math::Quaterniond q_nb = q_ENU_to_NED * q_gb;
+
+	// publish attitude groundtruth
+	vehicle_attitude_s vehicle_attitude_groundtruth{};
+	vehicle_attitude_groundtruth.timestamp_sample = time_us;
+	vehicle_attitude_groundtruth.q[0] = q_nb.W();
+	vehicle_attitude_groundtruth.q[1] = q_nb.X();
+	vehicle_attitude_groundtruth.q[2] = q_nb.Y();
+	vehicle_attitude_groundtruth.q[3] = q_nb.Z();
+	vehicle_attitude_groundtruth.timestamp = hrt_absolute_time();
+	_attitude_ground_truth_pub.publish(vehicle_attitude_groundtruth);
+
+	// publish angular velocity groundtruth
+	const matrix::Eulerf euler{matrix::Quatf(vehicle_attitude_groundtruth.q)};
+	vehicle_angular_velocity_s vehicle_angular_velocity_groundtruth{};
+	vehicle_angular_velocity_groundtruth.timestamp_sample = time_us;
+
+	const matrix::Vector3f angular_velocity = (euler - _euler_prev) / dt;
+	_euler_prev = euler;
+	angular_velocity.copyTo(vehicle_angular_velocity_groundtruth.xyz);
+
+	vehicle_angular_velocity_groundtruth.timestamp = hrt_absolute_time();
+	_angular_velocity_ground_truth_pub.publish(vehicle_angular_velocity_groundtruth);
+
+	if (!_pos_ref.isInitialized()) {
+		_pos_ref.initReference((double)_param_sim_home_lat.get(), (double)_param_sim_home_lon.get(), hrt_absolute_time());
+	}
+
+	vehicle_local_position_s local_position_groundtruth{};
+	local_position_groundtruth.timestamp_sample = time_us;
+
+	// position ENU -> NED
+	const matrix::Vector3d position{pose_position.y(), pose_position.x(), -pose_position.z()};
+	const matrix::Vector3d velocity{(position - _position_prev) / dt};
+	const matrix::Vector3d acceleration{(velocity - _velocity_prev) / dt};
+
+	_position_prev = position;
+	_velocity_prev = velocity;
+
+	local_position_groundtruth.ax = acceleration(0);
+	local_position_groundtruth.ay = acceleration(1);
+	local_position_groundtruth.az = acceleration(2);
+	local_position_groundtruth.vx = velocity(0);
+	local_position_groundtruth.vy = velocity(1);
+	local_position_groundtruth.vz = velocity(2);
+	local_position_groundtruth.x = position(0);
+	local_position_groundtruth.y = position(1);
+	local_position_groundtruth.z = position(2);
+
+	local_position_groundtruth.ref_lat = _pos_ref.getProjectionReferenceLat(); // Reference point latitude in degrees
+	local_position_groundtruth.ref_lon = _pos_ref.getProjectionReferenceLon(); // Reference point longitude in degrees
+	local_position_groundtruth.ref_alt = _param_sim_home_alt.get();
+	local_position_groundtruth.ref_timestamp = _pos_ref.getProjectionReferenceTimestamp();
+
+	local_position_groundtruth.timestamp = hrt_absolute_time();
+	_lpos_ground_truth_pub.publish(local_position_groundtruth);
+
+	if (_pos_ref.isInitialized()) {
+		// publish position groundtruth
+		vehicle_global_position_s global_position_groundtruth{};
+		global_position_groundtruth.timestamp_sample = time_us;
+
+		_pos_ref.reproject(local_position_groundtruth.x, local_position_groundtruth.y,
+				   global_position_groundtruth.lat, global_position_groundtruth.lon);
+
+		global_position_groundtruth.alt = _param_sim_home_alt.get() - static_cast<float>(position(2));
+		global_position_groundtruth.timestamp = hrt_absolute_time();
+		_gpos_ground_truth_pub.publish(global_position_groundtruth);
+	}
+}
+
 void GZBridge::motorSpeedCallback(const ignition::msgs::Actuators &actuators)
 {
 	if (hrt_absolute_time() == 0) {
@@ -595,6 +668,11 @@ void GZBridge::Run()
 int GZBridge::print_status()
 {
 	//perf_print_counter(_cycle_perf);
+	perf_print_counter(_ingest_perf);
+	perf_print_counter(_imu_dropped_perf);
+	PX4_INFO("max IMU samples per ingest: %d", _imu_batch_max);
+	_ingest_work_item.print_run_statistics();
+
 	_mixing_output.printStatus();
 
 	return 0;
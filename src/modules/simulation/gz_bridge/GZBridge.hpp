@@ -41,6 +41,7 @@
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <lib/geo/geo.h>
 #include <lib/mixer_module/mixer_module.hpp>
+#include <lib/perf/perf_counter.h>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionInterval.hpp>
@@ -96,6 +97,49 @@ private:
 	void poseInfoCallback(const ignition::msgs::Pose_V &pose);
 	void motorSpeedCallback(const ignition::msgs::Actuators &actuators);
 
+	// publish the queued gz messages, runs on the PX4 work queue
+	void processIngest();
+	void publishImu(const uint64_t time_us, const float accel[3], const float gyro[3]);
+	void publishPose(const uint64_t time_us, const ignition::msgs::Pose &pose);
+
+	/**
+	 * The gz-transport callbacks only convert and queue the sensor messages, they are published
+	 * in batches by this work item (scheduled again by every message, so messages that arrive
+	 * before it runs are handled in a single run).
+	 */
+	class IngestWorkItem : public px4::WorkItem
+	{
+	public:
+		explicit IngestWorkItem(GZBridge &bridge) : px4::WorkItem(MODULE_NAME"_ingest", bridge), _bridge(bridge) {}
+		~IngestWorkItem() override { ScheduleClear(); }
+
+	private:
+		void Run() override { _bridge.processIngest(); }
+
+		GZBridge &_bridge;
+	};
+
+	struct ImuSample {
+		uint64_t time_us;
+		float accel[3]; // FRD [m/s^2]
+		float gyro[3];  // FRD [rad/s]
+	};
+
+	static constexpr int IMU_QUEUE_SIZE = 16;
+
+	// protected by _mutex
+	ImuSample _imu_queue[IMU_QUEUE_SIZE] {};
+	int _imu_queue_count{0};
+	ignition::msgs::Pose _pose_pending{};
+	uint64_t _pose_pending_time_us{0};
+	bool _pose_pending_updated{false};
+
+	IngestWorkItem _ingest_work_item{*this};
+
+	perf_counter_t _ingest_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": ingest")};
+	perf_counter_t _imu_dropped_perf{perf_alloc(PC_COUNT, MODULE_NAME": IMU queue overflow")};
+	int _imu_batch_max{0};
+
 	// Subscriptions
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 
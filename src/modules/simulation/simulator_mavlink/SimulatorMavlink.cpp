@@ -173,12 +173,26 @@ void SimulatorMavlink::send_controls()
 		mavlink_hil_actuator_controls_t hil_act_control;
 		actuator_controls_from_outputs(&hil_act_control);
 
-		mavlink_message_t message{};
-		mavlink_msg_hil_actuator_controls_encode(_param_mav_sys_id.get(), _param_mav_comp_id.get(), &message, &hil_act_control);
-
 		PX4_DEBUG("sending controls t=%ld (%ld)", _actuator_outputs.timestamp, hil_act_control.time_usec);
 
-		send_mavlink_message(message);
+#if defined(__PX4_LINUX)
+
+		if (!_shm_name.empty()) {
+			simulator_shm::Record record{};
+			record.msgid = MAVLINK_MSG_ID_HIL_ACTUATOR_CONTROLS;
+			record.hil_actuator_controls = hil_act_control;
+
+			if (!_shm.send(record)) {
+				PX4_WARN("shared memory ring full, dropping controls");
+			}
+
+		} else
+#endif
+		{
+			mavlink_message_t message{};
+			mavlink_msg_hil_actuator_controls_encode(_param_mav_sys_id.get(), _param_mav_comp_id.get(), &message, &hil_act_control);
+			send_mavlink_message(message);
+		}
 
 		send_esc_telemetry(hil_act_control);
 	}
@@ -398,7 +412,11 @@ void SimulatorMavlink::handle_message_hil_gps(const mavlink_message_t *msg)
 {
 	mavlink_hil_gps_t hil_gps;
 	mavlink_msg_hil_gps_decode(msg, &hil_gps);
+	handle_hil_gps(hil_gps);
+}
 
+void SimulatorMavlink::handle_hil_gps(const mavlink_hil_gps_t &hil_gps)
+{
 	if (!_gps_blocked) {
 		sensor_gps_s gps{};
 
@@ -468,7 +486,11 @@ void SimulatorMavlink::handle_message_hil_sensor(const mavlink_message_t *msg)
 {
 	mavlink_hil_sensor_t imu;
 	mavlink_msg_hil_sensor_decode(msg, &imu);
+	handle_hil_sensor(imu);
+}
 
+void SimulatorMavlink::handle_hil_sensor(const mavlink_hil_sensor_t &imu)
+{
 	// Assume imu with id 0 is the primary imu an base lockstep based on this.
 	if (imu.id == 0) {
 		if (_lockstep_component == -1) {
@@ -516,7 +538,11 @@ void SimulatorMavlink::handle_message_hil_state_quaternion(const mavlink_message
 {
 	mavlink_hil_state_quaternion_t hil_state;
 	mavlink_msg_hil_state_quaternion_decode(msg, &hil_state);
+	handle_hil_state_quaternion(hil_state);
+}
 
+void SimulatorMavlink::handle_hil_state_quaternion(const mavlink_hil_state_quaternion_t &hil_state)
+{
 	uint64_t timestamp = hrt_absolute_time();
 
 	/* angular velocity */
@@ -1002,7 +1028,10 @@ void SimulatorMavlink::send()
 	// simulator to start sending sensor data which will set the time and
 	// get everything rolling.
 	// Without this, we get stuck at px4_poll which waits for a time update.
-	send_heartbeat();
+	// (The shared memory transport has no handshake, the simulator starts once attached.)
+	if (_shm_name.empty()) {
+		send_heartbeat();
+	}
 
 	px4_pollfd_struct_t fds_actuator_outputs[1] = {};
 	fds_actuator_outputs[0].fd = _actuator_outputs_sub;
@@ -1061,6 +1090,80 @@ void SimulatorMavlink::send_heartbeat()
 	send_mavlink_message(message);
 }
 
+void SimulatorMavlink::start_sender_thread()
+{
+	// Create a thread for sending data to the simulator.
+	pthread_t sender_thread;
+
+	pthread_attr_t sender_thread_attr;
+	pthread_attr_init(&sender_thread_attr);
+	pthread_attr_setstacksize(&sender_thread_attr, PX4_STACK_ADJUSTED(8000));
+
+	struct sched_param param;
+	(void)pthread_attr_getschedparam(&sender_thread_attr, &param);
+
+	// sender thread should run immediately after new outputs are available
+	//  to send the lockstep update to the simulation
+	param.sched_priority = SCHED_PRIORITY_ACTUATOR_OUTPUTS + 1;
+	(void)pthread_attr_setschedparam(&sender_thread_attr, &param);
+
+	pthread_create(&sender_thread, &sender_thread_attr, SimulatorMavlink::sending_trampoline, nullptr);
+	pthread_attr_destroy(&sender_thread_attr);
+}
+
+void SimulatorMavlink::run_shm()
+{
+#if defined(__PX4_LINUX)
+
+	if (!_shm.create(_shm_name.c_str())) {
+		PX4_ERR("creating shared memory %s failed: %s", _shm_name.c_str(), strerror(errno));
+		return;
+	}
+
+	PX4_INFO("Waiting for simulator to attach to shared memory %s", _shm.name());
+
+	simulator_shm::Record record{};
+	bool connected = false;
+
+	while (true) {
+		if (!_shm.receive(record, 1000)) {
+			if (connected) {
+				PX4_ERR("shared memory receive timeout");
+			}
+
+			continue;
+		}
+
+		if (!connected) {
+			connected = true;
+			PX4_INFO("Simulator attached to shared memory %s.", _shm.name());
+			start_sender_thread();
+		}
+
+		switch (record.msgid) {
+		case MAVLINK_MSG_ID_HIL_SENSOR:
+			handle_hil_sensor(record.hil_sensor);
+			break;
+
+		case MAVLINK_MSG_ID_HIL_GPS:
+			handle_hil_gps(record.hil_gps);
+			break;
+
+		case MAVLINK_MSG_ID_HIL_STATE_QUATERNION:
+			handle_hil_state_quaternion(record.hil_state_quaternion);
+			break;
+
+		default:
+			PX4_DEBUG("unsupported shared memory record %" PRIu32, record.msgid);
+			break;
+		}
+	}
+
+#else
+	PX4_ERR("shared memory transport not supported on this platform");
+#endif
+}
+
 void SimulatorMavlink::run()
 {
 #ifdef __PX4_DARWIN
@@ -1069,6 +1172,11 @@ void SimulatorMavlink::run()
 	pthread_setname_np(pthread_self(), "sim_rcv");
 #endif
 
+	if (!_shm_name.empty()) {
+		run_shm();
+		return;
+	}
+
 	struct sockaddr_in _myaddr {};
 	_myaddr.sin_family = AF_INET;
 	_myaddr.sin_addr.s_addr = htonl(INADDR_ANY);
@@ -1152,29 +1260,13 @@ void SimulatorMavlink::run()
 
 	}
 
-	// Create a thread for sending data to the simulator.
-	pthread_t sender_thread;
-
-	pthread_attr_t sender_thread_attr;
-	pthread_attr_init(&sender_thread_attr);
-	pthread_attr_setstacksize(&sender_thread_attr, PX4_STACK_ADJUSTED(8000));
-
-	struct sched_param param;
-	(void)pthread_attr_getschedparam(&sender_thread_attr, &param);
-
-	// sender thread should run immediately after new outputs are available
-	//  to send the lockstep update to the simulation
-	param.sched_priority = SCHED_PRIORITY_ACTUATOR_OUTPUTS + 1;
-	(void)pthread_attr_setschedparam(&sender_thread_attr, &param);
-
 	struct pollfd fds[2] = {};
 	unsigned fd_count = 1;
 	fds[0].fd = _fd;
 	fds[0].events = POLLIN;
 
 	// got data from simulator, now activate the sending thread
-	pthread_create(&sender_thread, &sender_thread_attr, SimulatorMavlink::sending_trampoline, nullptr);
-	pthread_attr_destroy(&sender_thread_attr);
+	start_sender_thread();
 
 	mavlink_status_t mavlink_status = {};
 
@@ -1558,6 +1650,11 @@ int SimulatorMavlink::start(int argc, char *argv[])
 			_instance->set_port(atoi(argv[5]));
 		}
 
+		if (argc == 5 && strcmp(argv[3], "-m") == 0) {
+			PX4_INFO("using shared memory %s", argv[4]);
+			_instance->set_shm_name(argv[4]);
+		}
+
 		if (argc == 6 && strcmp(argv[3], "-h") == 0) {
 			PX4_INFO("using TCP on remote host %s port %s", argv[4], argv[5]);
 			PX4_WARN("Please ensure port %s is not blocked by a firewall.", argv[5]);
@@ -1578,12 +1675,13 @@ int SimulatorMavlink::start(int argc, char *argv[])
 
 static void usage()
 {
-	PX4_INFO("Usage: simulator_mavlink {start -[spt] [-u udp_port / -c tcp_port] |stop|status}");
+	PX4_INFO("Usage: simulator_mavlink {start -[spt] [-u udp_port / -c tcp_port / -m shm_name] |stop|status}");
 	PX4_INFO("Start simulator:     simulator_mavlink start");
 	PX4_INFO("Connect using UDP: simulator_mavlink start -u udp_port");
 	PX4_INFO("Connect using TCP: simulator_mavlink start -c tcp_port");
 	PX4_INFO("Connect to a remote server using TCP: simulator_mavlink start -t ip_addr tcp_port");
 	PX4_INFO("Connect to a remote server via hostname using TCP: simulator_mavlink start -h hostname tcp_port");
+	PX4_INFO("Lockstep exchange over shared memory (Linux): simulator_mavlink start -m /shm_name");
 }
 
 __BEGIN_DECLS
@@ -1637,6 +1735,9 @@ int simulator_mavlink_main(int argc, char *argv[])
 
 		} else {
 			PX4_INFO("running");
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+			PX4_INFO("lockstep speed factor: %.2f", (double)px4_lockstep_get_speed_factor());
+#endif
 		}
 
 	} else {
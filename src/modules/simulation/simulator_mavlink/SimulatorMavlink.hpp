@@ -83,6 +83,10 @@
 #include <mavlink.h>
 #include <mavlink_types.h>
 
+#if defined(__PX4_LINUX)
+#include "SimulatorShm.hpp"
+#endif
+
 using namespace time_literals;
 
 //! Enumeration to use on the bitmask in HIL_SENSOR
@@ -129,6 +133,7 @@ public:
 	void set_port(unsigned port) { _port = port; }
 	void set_hostname(const char *hostname) { _hostname = hostname; }
 	void set_tcp_remote_ipaddr(char *tcp_remote_ipaddr) { _tcp_remote_ipaddr = tcp_remote_ipaddr; }
+	void set_shm_name(const char *shm_name) { _shm_name = shm_name; }
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	bool has_initialized() { return _has_initialized.load(); }
@@ -214,12 +219,20 @@ private:
 
 	char *_tcp_remote_ipaddr{nullptr};
 
+	std::string _shm_name{""};		///< shared memory transport instead of MAVLink if set
+
+#if defined(__PX4_LINUX)
+	simulator_shm::Transport _shm;
+#endif
+
 	double _realtime_factor{1.0};		///< How fast the simulation runs in comparison to real system time
 
 	hrt_abstime _last_sim_timestamp{0};
 	hrt_abstime _last_sitl_timestamp{0};
 
 	void run();
+	void run_shm();
+	void start_sender_thread();
 
 	void handle_message(const mavlink_message_t *msg);
 	void handle_message_distance_sensor(const mavlink_message_t *msg);
@@ -232,6 +245,10 @@ private:
 	void handle_message_rc_channels(const mavlink_message_t *msg);
 	void handle_message_vision_position_estimate(const mavlink_message_t *msg);
 
+	void handle_hil_gps(const mavlink_hil_gps_t &hil_gps);
+	void handle_hil_sensor(const mavlink_hil_sensor_t &imu);
+	void handle_hil_state_quaternion(const mavlink_hil_state_quaternion_t &hil_state);
+
 	void parameters_update(bool force);
 	void poll_for_MAVLink_messages();
 	void request_hil_state_quaternion();
@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 Mark Charlebois. All rights reserved.
+ *   Copyright (c) 2016-2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SimulatorShm.hpp
+ *
+ * Shared memory transport for the lockstep exchange with the simulator, as an
+ * alternative to MAVLink over UDP/TCP.
+ *
+ * PX4 creates the segment (shm_open() name given to "simulator_mavlink start -m"),
+ * the simulator maps it and checks magic and version. The layout is fixed:
+ * two single producer, single consumer rings of Record, each with a process
+ * shared semaphore posted once per record written. The payloads are the
+ * (packed) MAVLink message structs, so no framing, CRC or encoding is needed.
+ *
+ *  - to_px4:   HIL_SENSOR, HIL_GPS, HIL_STATE_QUATERNION
+ *  - from_px4: HIL_ACTUATOR_CONTROLS
+ */
+
+#pragma once
+
+#include <atomic>
+#include <errno.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <semaphore.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <mavlink.h>
+
+namespace simulator_shm
+{
+
+static constexpr uint32_t MAGIC = 0x50583453; // "S4XP"
+static constexpr uint32_t VERSION = 1;
+static constexpr uint32_t RING_SIZE = 64; // power of 2
+
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of 2");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "ring indices must be lock-free to be shared between processes");
+
+struct Record {
+	uint32_t msgid; ///< MAVLINK_MSG_ID_* of the payload
+	uint32_t reserved;
+
+	union {
+		mavlink_hil_sensor_t hil_sensor;
+		mavlink_hil_gps_t hil_gps;
+		mavlink_hil_state_quaternion_t hil_state_quaternion;
+		mavlink_hil_actuator_controls_t hil_actuator_controls;
+	};
+};
+
+struct Ring {
+	sem_t available;
+	std::atomic<uint32_t> head; ///< next record to write, only modified by the producer
+	std::atomic<uint32_t> tail; ///< next record to read, only modified by the consumer
+	Record records[RING_SIZE];
+
+	bool push(const Record &record)
+	{
+		const uint32_t head_index = head.load(std::memory_order_relaxed);
+
+		if (head_index - tail.load(std::memory_order_acquire) >= RING_SIZE) {
+			return false; // full
+		}
+
+		records[head_index & (RING_SIZE - 1)] = record;
+		head.store(head_index + 1, std::memory_order_release);
+		sem_post(&available);
+		return true;
+	}
+
+	/**
+	 * Wait for the next record.
+	 * @param timeout_ms wall clock timeout
+	 * @return true if a record was copied
+	 */
+	bool pop(Record &record, int timeout_ms)
+	{
+		timespec abstime{};
+		clock_gettime(CLOCK_REALTIME, &abstime);
+		abstime.tv_sec += timeout_ms / 1000;
+		abstime.tv_nsec += (timeout_ms % 1000) * 1000000;
+
+		if (abstime.tv_nsec >= 1000000000) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= 1000000000;
+		}
+
+		// there is one post per record, so the record is there once the wait succeeded
+		while (sem_timedwait(&available, &abstime) != 0) {
+			if (errno != EINTR) {
+				return false;
+			}
+		}
+
+		const uint32_t tail_index = tail.load(std::memory_order_relaxed);
+		record = records[tail_index & (RING_SIZE - 1)];
+		tail.store(tail_index + 1, std::memory_order_release);
+		return true;
+	}
+};
+
+struct Layout {
+	std::atomic<uint32_t> magic; ///< set to MAGIC once the rings are initialized
+	uint32_t version;
+	Ring to_px4;
+	Ring from_px4;
+};
+
+class Transport
+{
+public:
+	Transport() = default;
+	~Transport() { close(); }
+
+	Transport(const Transport &) = delete;
+	Transport &operator=(const Transport &) = delete;
+
+	/**
+	 * Create (or re-create) and initialize the shared memory segment.
+	 * @param name shm_open() name, e.g. "/px4_sim_0"
+	 */
+	bool create(const char *name)
+	{
+		close();
+
+		strncpy(_name, name, sizeof(_name) - 1);
+		_name[sizeof(_name) - 1] = '\0';
+
+		shm_unlink(_name);
+		const int fd = shm_open(_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+		if (fd < 0) {
+			return false;
+		}
+
+		void *ptr = MAP_FAILED;
+
+		if (ftruncate(fd, sizeof(Layout)) == 0) {
+			ptr = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		}
+
+		::close(fd);
+
+		if (ptr == MAP_FAILED) {
+			shm_unlink(_name);
+			return false;
+		}
+
+		_layout = static_cast<Layout *>(ptr);
+
+		// the segment is zero filled by ftruncate()
+		_layout->version = VERSION;
+
+		if (!init_ring(_layout->to_px4) || !init_ring(_layout->from_px4)) {
+			close();
+			return false;
+		}
+
+		_layout->magic.store(MAGIC, std::memory_order_release);
+		return true;
+	}
+
+	void close()
+	{
+		if (_layout) {
+			_layout->magic.store(0);
+			sem_destroy(&_layout->to_px4.available);
+			sem_destroy(&_layout->from_px4.available);
+			munmap(_layout, sizeof(Layout));
+			shm_unlink(_name);
+			_layout = nullptr;
+		}
+	}
+
+	bool receive(Record &record, int timeout_ms) { return _layout && _layout->to_px4.pop(record, timeout_ms); }
+	bool send(const Record &record) { return _layout && _layout->from_px4.push(record); }
+
+	const char *name() const { return _name; }
+
+private:
+	static bool init_ring(Ring &ring)
+	{
+		ring.head.store(0);
+		ring.tail.store(0);
+		return sem_init(&ring.available, 1, 0) == 0;
+	}
+
+	Layout *_layout{nullptr};
+	char _name[64] {};
+};
+
+} // namespace simulator_shm
@@ -81,6 +81,13 @@ void Sih::run()
 	_actuator_out_sub = uORB::Subscription{ORB_ID(actuator_outputs_sim)};
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	_substeps = math::constrain(static_cast<int>(_sih_substeps.get()), 1, MAX_SUBSTEPS);
+
+	if (_substeps > 1) {
+		_px4_accel.set_scale(ACCEL_FIFO_SCALE);
+		_px4_gyro.set_scale(GYRO_FIFO_SCALE);
+	}
+
 	lockstep_loop();
 #else
 	realtime_loop();
@@ -117,17 +124,29 @@ void Sih::lockstep_loop()
 		speed_factor = atof(speedup);
 	}
 
-	int rt_interval_us = int(roundf(sim_interval_us / speed_factor));
+	// each loop iteration integrates _substeps physics steps
+	const int loop_interval_us = sim_interval_us * _substeps;
+
+	// a speed factor <= 0 runs as fast as possible
+	int rt_interval_us = (speed_factor > 0.f) ? int(roundf(loop_interval_us / speed_factor)) : 0;
 
 	PX4_INFO("Simulation loop with %d Hz (%d us sim time interval)", rate, sim_interval_us);
+
+	if (_substeps > 1) {
+		PX4_INFO("Fast-forward with %d physics sub-steps per loop (%d us sim time loop interval)", _substeps, loop_interval_us);
+	}
+
 	PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
 	uint64_t pre_compute_wall_time_us;
 
+	_lockstep_start_wall_time_us = micros();
+	_lockstep_start_simulation_time_us = _current_simulation_time_us;
+
 	while (!should_exit()) {
 		pre_compute_wall_time_us = micros();
 		perf_count(_loop_interval_perf);
 
-		_current_simulation_time_us += sim_interval_us;
+		_current_simulation_time_us += loop_interval_us;
 		struct timespec ts;
 		abstime_to_ts(&ts, _current_simulation_time_us);
 		px4_clock_settime(CLOCK_MONOTONIC, &ts);
@@ -143,7 +162,7 @@ void Sih::lockstep_loop()
 		if (_last_actuator_output_time <= 0) {
 			PX4_DEBUG("SIH starting up - no lockstep yet");
 			current_wall_time_us = micros();
-			sleep_time = math::max(0, sim_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
+			sleep_time = math::max(0, loop_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 
 		} else {
 			px4_lockstep_wait_for_components();
@@ -151,8 +170,9 @@ void Sih::lockstep_loop()
 			sleep_time = math::max(0, rt_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 		}
 
-		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)(
+		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)loop_interval_us / (float)(
 					    current_wall_time_us - pre_compute_wall_time_us + sleep_time));
+		_lockstep_last_wall_time_us = current_wall_time_us + sleep_time;
 		usleep(sleep_time);
 	}
 }
@@ -210,11 +230,44 @@ void Sih::sensor_step()
 
 	read_motors(dt);
 
-	generate_force_and_torques();
+	if (_substeps <= 1) {
+		generate_force_and_torques();
+
+		equations_of_motion(dt);
+
+		reconstruct_sensors_signals(now);
+
+	} else {
+		// fast-forward: integrate the sub-steps at the IMU rate and publish their samples in one batch
+		const float dt_substep = dt / _substeps;
+
+		for (int i = 0; i < _substeps; i++) {
+			generate_force_and_torques();
 
-	equations_of_motion(dt);
+			equations_of_motion(dt_substep);
 
-	reconstruct_sensors_signals(now);
+			Vector3f acc;
+			Vector3f gyro;
+			sample_imu(acc, gyro);
+
+			_accel_fifo.x[i] = (int16_t)math::constrain(roundf(acc(0) / ACCEL_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+			_accel_fifo.y[i] = (int16_t)math::constrain(roundf(acc(1) / ACCEL_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+			_accel_fifo.z[i] = (int16_t)math::constrain(roundf(acc(2) / ACCEL_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+			_gyro_fifo.x[i] = (int16_t)math::constrain(roundf(gyro(0) / GYRO_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+			_gyro_fifo.y[i] = (int16_t)math::constrain(roundf(gyro(1) / GYRO_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+			_gyro_fifo.z[i] = (int16_t)math::constrain(roundf(gyro(2) / GYRO_FIFO_SCALE), (float)INT16_MIN, (float)INT16_MAX);
+		}
+
+		_accel_fifo.timestamp_sample = now;
+		_accel_fifo.dt = dt_substep * 1e6f;
+		_accel_fifo.samples = _substeps;
+		_px4_accel.updateFIFO(_accel_fifo);
+
+		_gyro_fifo.timestamp_sample = now;
+		_gyro_fifo.dt = dt_substep * 1e6f;
+		_gyro_fifo.samples = _substeps;
+		_px4_gyro.updateFIFO(_gyro_fifo);
+	}
 
 	if ((_vehicle == VehicleType::FW || _vehicle == VehicleType::TS) && now - _airspeed_time >= 50_ms) {
 		_airspeed_time = now;
@@ -437,14 +490,21 @@ void Sih::reconstruct_sensors_signals(const hrt_abstime &time_now_us)
 	//     In 2018 IEEE International Conference on Robotics and Automation (ICRA), pp. 6573-6580. IEEE, 2018.
 
 	// IMU
-	Vector3f acc = _C_IB.transpose() * (_v_I_dot - Vector3f(0.0f, 0.0f, CONSTANTS_ONE_G)) + noiseGauss3f(0.5f, 1.7f, 1.4f);
-	Vector3f gyro = _w_B + noiseGauss3f(0.14f, 0.07f, 0.03f);
+	Vector3f acc;
+	Vector3f gyro;
+	sample_imu(acc, gyro);
 
 	// update IMU every iteration
 	_px4_accel.update(time_now_us, acc(0), acc(1), acc(2));
 	_px4_gyro.update(time_now_us, gyro(0), gyro(1), gyro(2));
 }
 
+void Sih::sample_imu(Vector3f &acc, Vector3f &gyro)
+{
+	acc = _C_IB.transpose() * (_v_I_dot - Vector3f(0.0f, 0.0f, CONSTANTS_ONE_G)) + noiseGauss3f(0.5f, 1.7f, 1.4f);
+	gyro = _w_B + noiseGauss3f(0.14f, 0.07f, 0.03f);
+}
+
 void Sih::send_airspeed(const hrt_abstime &time_now_us)
 {
 	// TODO: send differential pressure instead?
@@ -604,6 +664,17 @@ int Sih::print_status()
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	PX4_INFO("Running in lockstep mode");
 	PX4_INFO("Achieved speedup: %.2fX", (double)_achieved_speedup);
+
+	if (_lockstep_last_wall_time_us > _lockstep_start_wall_time_us) {
+		// average since start, the benchmark figure for headless runs with PX4_SIM_SPEED_FACTOR=0
+		PX4_INFO("Simulated seconds per wall second: %.2f",
+			 (double)(_current_simulation_time_us - _lockstep_start_simulation_time_us)
+			 / (double)(_lockstep_last_wall_time_us - _lockstep_start_wall_time_us));
+	}
+
+	if (_substeps > 1) {
+		PX4_INFO("Fast-forward: %d physics sub-steps per loop", _substeps);
+	}
 #endif
 
 	if (_vehicle == VehicleType::MC) {
@@ -161,14 +161,26 @@ private:
 	void publish_ground_truth(const hrt_abstime &time_now_us);
 	void generate_fw_aerodynamics();
 	void generate_ts_aerodynamics();
+	void sample_imu(matrix::Vector3f &acc, matrix::Vector3f &gyro);
 	void sensor_step();
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	void lockstep_loop();
 	uint64_t _current_simulation_time_us{0};
 	float _achieved_speedup{0.f};
+	uint64_t _lockstep_start_wall_time_us{0};
+	uint64_t _lockstep_start_simulation_time_us{0};
+	uint64_t _lockstep_last_wall_time_us{0};
 #endif
 
+	// fast-forward: physics sub-steps per loop iteration, the IMU samples are published as one FIFO batch
+	static constexpr int MAX_SUBSTEPS = 8;
+	static constexpr float ACCEL_FIFO_SCALE = 16.f * CONSTANTS_ONE_G / INT16_MAX;
+	static constexpr float GYRO_FIFO_SCALE = math::radians(2000.f) / INT16_MAX;
+	int _substeps{1};
+	sensor_accel_fifo_s _accel_fifo{};
+	sensor_gyro_fifo_s _gyro_fifo{};
+
 	void realtime_loop();
 
 	px4_sem_t       _data_semaphore;
@@ -280,6 +292,7 @@ private:
 		(ParamFloat<px4::params::SIH_DISTSNSR_MAX>) _sih_distance_snsr_max,
 		(ParamFloat<px4::params::SIH_DISTSNSR_OVR>) _sih_distance_snsr_override,
 		(ParamFloat<px4::params::SIH_T_TAU>) _sih_thrust_tau,
-		(ParamInt<px4::params::SIH_VEHICLE_TYPE>) _sih_vtype
+		(ParamInt<px4::params::SIH_VEHICLE_TYPE>) _sih_vtype,
+		(ParamInt<px4::params::SIH_SUBSTEPS>) _sih_substeps
 	)
 };
@@ -338,3 +338,19 @@ PARAM_DEFINE_FLOAT(SIH_T_TAU, 0.05f);
  * @group Simulation In Hardware
  */
 PARAM_DEFINE_INT32(SIH_VEHICLE_TYPE, 0);
+
+/**
+ * Physics sub-steps per simulation loop iteration
+ *
+ * Fast-forward mode for lockstep simulation (SITL only): the rigid body is
+ * integrated this many times per loop iteration at the IMU rate, and the IMU
+ * samples of all sub-steps are published as one sensor FIFO batch. The rest
+ * of the system then runs at the IMU rate divided by this value, which
+ * allows a higher simulation speed factor. 1 disables it.
+ *
+ * @min 1
+ * @max 8
+ * @reboot_required true
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_SUBSTEPS, 1);
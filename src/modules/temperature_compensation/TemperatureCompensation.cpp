@@ -264,17 +264,9 @@ bool TemperatureCompensation::calc_thermal_offsets_1D(SensorCalData1D &coef, flo
 
 	}
 
-	// calulate the offset
-	float temp_var = delta_temp;
-	offset = coef.x0 + coef.x1 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x2 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x3 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x4 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x5 * temp_var;
+	// calulate the offset (Horner's scheme)
+	offset = ((((coef.x5 * delta_temp + coef.x4) * delta_temp + coef.x3) * delta_temp + coef.x2) * delta_temp + coef.x1)
+		 * delta_temp + coef.x0;
 
 	return ret;
 
@@ -300,12 +292,9 @@ bool TemperatureCompensation::calc_thermal_offsets_3D(const SensorCalData3D &coe
 
 	}
 
-	// calulate the offsets
-	float delta_temp_2 = delta_temp * delta_temp;
-	float delta_temp_3 = delta_temp_2 * delta_temp;
-
+	// calulate the offsets (Horner's scheme)
 	for (uint8_t i = 0; i < 3; i++) {
-		offset[i] = coef.x0[i] + coef.x1[i] * delta_temp + coef.x2[i] * delta_temp_2 + coef.x3[i] * delta_temp_3;
+		offset[i] = ((coef.x3[i] * delta_temp + coef.x2[i]) * delta_temp + coef.x1[i]) * delta_temp + coef.x0[i];
 	}
 
 	return ret;
@@ -344,7 +333,12 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 {
 	for (int i = 0; i < sensor_count_max; ++i) {
 		if (device_id == (uint32_t)sensor_cal_data[i].ID) {
-			sensor_data.device_mapping[topic_instance] = i;
+			if (sensor_data.device_mapping[topic_instance] != i) {
+				// different coefficients: recompute the offsets on the next update
+				sensor_data.device_mapping[topic_instance] = i;
+				sensor_data.last_temperature[topic_instance] = -100.0f;
+			}
+
 			return i;
 		}
 	}
@@ -366,11 +360,10 @@ int TemperatureCompensation::update_offsets_gyro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > 1.0f) {
+	// Only update the offsets if the temperature changed enough to warrant a new publication,
+	// otherwise the offsets from the last update are still valid
+	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > TEMPERATURE_HYSTERESIS) {
+		calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
 		_gyro_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
@@ -392,11 +385,10 @@ int TemperatureCompensation::update_offsets_accel(int topic_instance, float temp
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > 1.0f) {
+	// Only update the offsets if the temperature changed enough to warrant a new publication,
+	// otherwise the offsets from the last update are still valid
+	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > TEMPERATURE_HYSTERESIS) {
+		calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
 		_accel_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
@@ -418,11 +410,10 @@ int TemperatureCompensation::update_offsets_baro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > 1.0f) {
+	// Only update the offsets if the temperature changed enough to warrant a new publication,
+	// otherwise the offsets from the last update are still valid
+	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > TEMPERATURE_HYSTERESIS) {
+		calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
 		_baro_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
@@ -60,6 +60,8 @@ static_assert(BARO_COUNT_MAX == 4, "BARO_COUNT_MAX must be 4 (if changed, add/re
 
 static constexpr uint8_t SENSOR_COUNT_MAX = 4;
 
+static constexpr float TEMPERATURE_HYSTERESIS = 1.f; ///< [deg C] temperature change to recompute the offsets
+
 /**
  ** class TemperatureCompensation
  * Applies temperature compensation to sensor data. Loads the parameters from PX4 param storage.
@@ -83,7 +85,8 @@ public:
 	 * @param topic_instance uORB topic instance
 	 * @param sensor_data input sensor data, output sensor data with applied corrections
 	 * @param temperature measured current temperature
-	 * @param offsets returns offsets that were applied (length = 3, except for baro), depending on return value
+	 * @param offsets returns offsets that were applied (length = 3, except for baro), only written if
+	 *        the return value is 2 (they remain valid otherwise)
 	 * @return -1: error: correction enabled, but no sensor mapping set (@see set_sendor_id_gyro)
 	 *         0: no changes (correction not enabled),
 	 *         1: corrections applied but no changes to offsets,
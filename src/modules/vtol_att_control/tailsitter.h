@@ -61,6 +61,9 @@ public:
 	void fill_actuator_outputs() override;
 	void waiting_on_tecs() override;
 
+	// the multicopter rate controller also stabilizes the tailsitter in fixed-wing flight
+	bool mc_control_required() const override { return true; }
+
 private:
 	enum class vtol_mode {
 		MC_MODE = 0,			/**< vtol is in multicopter mode */
@@ -382,6 +382,8 @@ VtolAttitudeControl::Run()
 		_vehicle_thrust_setpoint1_pub.publish(_thrust_setpoint_1);
 
 		// Advertise/Publish vtol vehicle status
+		_vtol_vehicle_status.mc_control_suspended = _param_vt_ctrl_suspend.get() && !_vtol_type->mc_control_required();
+		_vtol_vehicle_status.fw_control_suspended = _param_vt_ctrl_suspend.get() && !_vtol_type->fw_control_required();
 		_vtol_vehicle_status.timestamp = hrt_absolute_time();
 		_vtol_vehicle_status_pub.publish(_vtol_vehicle_status);
 	}
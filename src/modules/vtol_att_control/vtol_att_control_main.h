@@ -235,6 +235,7 @@ private:
 	void 		parameters_update();
 
 	DEFINE_PARAMETERS(
-		(ParamInt<px4::params::VT_TYPE>) _param_vt_type
+		(ParamInt<px4::params::VT_TYPE>) _param_vt_type,
+		(ParamBool<px4::params::VT_CTRL_SUSPEND>) _param_vt_ctrl_suspend
 	)
 };
@@ -63,6 +63,19 @@ PARAM_DEFINE_INT32(VT_TYPE, 0);
  */
 PARAM_DEFINE_INT32(VT_ELEV_MC_LOCK, 1);
 
+/**
+ * Suspend the unused attitude controllers
+ *
+ * If set to 1 the multicopter attitude and rate controllers stop running in fixed-wing flight
+ * (except for tailsitters) and the fixed-wing attitude controller stops running in hover
+ * if the control surfaces are locked (VT_ELEV_MC_LOCK). They are restarted
+ * with reset integrators as soon as a transition begins.
+ *
+ * @boolean
+ * @group VTOL Attitude Control
+ */
+PARAM_DEFINE_INT32(VT_CTRL_SUSPEND, 0);
+
 /**
  * Duration of a front transition
  *
@@ -144,6 +144,16 @@ public:
 
 	mode get_mode() {return _vtol_mode;}
 
+	/**
+	 * @return true if the multicopter attitude and rate controller outputs are used in the current mode
+	 */
+	virtual bool mc_control_required() const { return _vtol_mode != mode::FIXED_WING; }
+
+	/**
+	 * @return true if the fixed-wing attitude controller outputs are used in the current mode
+	 */
+	bool fw_control_required() const { return (_vtol_mode != mode::ROTARY_WING) || !_param_vt_elev_mc_lock.get(); }
+
 	/**
 	 * @return Minimum front transition time scaled for air density (if available) [s]
 	*/
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mem.cpp
+ *
+ * Print the heap usage per module (CONFIG_SYSTEMCMDS_MEM).
+ */
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/arena.h>
+#include <px4_platform_common/heap_accounting.h>
+
+#include <inttypes.h>
+#include <string.h>
+
+static void usage();
+
+extern "C" {
+	__EXPORT int mem_main(int argc, char *argv[]);
+}
+
+static void print_status()
+{
+	PX4_INFO_RAW("%-24s %10s %8s %10s %10s\n", "module", "live [B]", "blocks", "peak [B]", "allocs");
+
+	px4_heap_module_usage usage;
+
+	for (int i = 0; px4_heap_get_module_usage(i, &usage); i++) {
+		PX4_INFO_RAW("%-24s %10" PRIu32 " %8" PRIu32 " %10" PRIu32 " %10" PRIu32 "\n", usage.name, usage.live_bytes,
+			     usage.live_allocations, usage.peak_bytes, usage.allocations);
+	}
+
+	px4_heap_totals totals;
+	px4_heap_get_totals(&totals);
+
+	PX4_INFO_RAW("\n%-24s %10" PRIu32 " %8s %10" PRIu32 " %10" PRIu32 "\n", "total", totals.live_bytes, "",
+		     totals.peak_bytes, totals.allocations);
+
+	if (totals.failed_allocations > 0) {
+		PX4_INFO_RAW("failed allocations: %" PRIu32 "\n", totals.failed_allocations);
+	}
+
+	px4_arena_usage arena;
+	px4_arena_get_usage(&arena);
+	PX4_INFO_RAW("arena (never freed): %zu B in %" PRIu32 " allocations, %zu B reserved in %" PRIu32 " chunks\n",
+		     arena.used, arena.allocations, arena.reserved, arena.chunks);
+
+	if (arena.pool_size > 0) {
+		PX4_INFO_RAW("arena static pool: %zu / %zu B used\n", arena.pool_used, arena.pool_size);
+	}
+
+	if (totals.fragmentation >= 0.f) {
+		PX4_INFO_RAW("heap free: %" PRIu32 " B, largest free block: %" PRIu32 " B, fragmentation: %.1f %%\n",
+			     totals.heap_free, totals.heap_largest_free, (double)(totals.fragmentation * 100.f));
+	}
+}
+
+int mem_main(int argc, char *argv[])
+{
+	if (argc < 2 || !strcmp(argv[1], "status")) {
+		print_status();
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "reset")) {
+		px4_heap_reset_peak();
+		return 0;
+	}
+
+	usage();
+	return 1;
+}
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Heap usage per module. Every C++ allocation (new) is attributed to the module running the
+command (e.g. 'ekf2 start'), the module task, or the work item the allocation is made from,
+and to the task name otherwise. Plain malloc() calls are not accounted.
+
+The sizes are the requested sizes, without the allocator overhead (use 'free' for the heap state).
+Fragmentation is 1 - largest free block / free heap (NuttX only).
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("mem", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print the usage of every module (default)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the peak usage");
+}
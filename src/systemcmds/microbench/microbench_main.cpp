@@ -34,6 +34,9 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/log.h>
 
+#include "microbench.h"
+
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <fcntl.h>
@@ -42,9 +45,13 @@
 __BEGIN_DECLS
 
 extern int test_microbench_atomic(int argc, char *argv[]);
+extern int test_microbench_control(int argc, char *argv[]);
+extern int test_microbench_filters(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
+extern int test_microbench_param(int argc, char *argv[]);
+extern int test_microbench_rc(int argc, char *argv[]);
 extern int test_microbench_uorb(int argc, char *argv[]);
 
 __END_DECLS
@@ -64,9 +71,13 @@ const struct {
 	{"all",		microbench_all,		OPT_NOALLTEST},
 
 	{"microbench_atomic",	test_microbench_atomic,	0},
+	{"microbench_control",	test_microbench_control,	0},
+	{"microbench_filters",	test_microbench_filters,	0},
 	{"microbench_hrt",	test_microbench_hrt,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
+	{"microbench_param",	test_microbench_param,	0},
+	{"microbench_rc",	test_microbench_rc,	0},
 	{"microbench_uorb",	test_microbench_uorb,	0},
 
 	{nullptr,			nullptr, 		0}
@@ -74,8 +85,21 @@ const struct {
 
 #define NMICROBENCHMARKS (sizeof(microbenchmarks) / sizeof(microbenchmarks[0]))
 
+static bool csv_output = false;
+
+void microbench_report(const char *name, perf_counter_t counter)
+{
+	perf_print_counter(counter);
+
+	if (csv_output) {
+		printf("MICROBENCH,%s,%" PRIu64 ",%.3f\n", name, perf_event_count(counter), (double)perf_mean(counter));
+	}
+}
+
 static int microbench_help(int argc, char *argv[])
 {
+	printf("Usage: microbench [-c] <test>\n");
+	printf("  -c  additionally print machine readable results: MICROBENCH,<name>,<runs>,<mean us>\n\n");
 	printf("Available tests:\n");
 
 	for (int i = 0; microbenchmarks[i].name; i++) {
@@ -149,6 +173,18 @@ extern "C" __EXPORT int microbench_main(int argc, char *argv[])
 		return 1;
 	}
 
+	csv_output = (strcmp(argv[1], "-c") == 0);
+
+	if (csv_output) {
+		argc--;
+		argv++;
+
+		if (argc < 2) {
+			PX4_WARN("missing test name - 'microbench help' for a list of tests");
+			return 1;
+		}
+	}
+
 	for (size_t i = 0; microbenchmarks[i].name; i++) {
 		if (!strcmp(microbenchmarks[i].name, argv[1])) {
 			if (microbenchmarks[i].fn(argc - 1, argv + 1) == 0) {
@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_control.cpp
+ * Microbenchmark the control allocation and trajectory generation.
+ */
+
+#include <unit_test.h>
+
+#include "microbench.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <ControlAllocation/ControlAllocationSequentialDesaturation.hpp>
+#include <lib/mathlib/mathlib.h>
+#include <lib/motion_planning/VelocitySmoothing.hpp>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
+
+namespace MicroBenchControl
+{
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench_report(name, p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchControl : public UnitTest
+{
+public:
+	bool run_tests() override;
+
+private:
+
+	bool time_sequential_desaturation();
+	bool time_velocity_smoothing();
+
+	void reset();
+
+	void lock()
+	{
+#ifdef __PX4_NUTTX
+		_flags = px4_enter_critical_section();
+#endif
+	}
+
+	void unlock()
+	{
+#ifdef __PX4_NUTTX
+		px4_leave_critical_section(_flags);
+#endif
+	}
+
+	template<typename T>
+	static T random(T min, T max)
+	{
+		const T scale = rand() / (T) RAND_MAX;
+		return min + scale * (max - min);
+	}
+
+#ifdef __PX4_NUTTX
+	irqstate_t _flags {};
+#endif
+
+	static constexpr int NUM_AXES = ControlAllocation::NUM_AXES;
+	static constexpr int NUM_ACTUATORS = ControlAllocation::NUM_ACTUATORS;
+
+	// the control setpoint is randomized in reset(), so the desaturation iterates
+	ControlAllocationSequentialDesaturation _allocation{};
+	matrix::Vector<float, NUM_AXES> _control_sp{};
+
+	// a new velocity setpoint every run, otherwise the cached durations are returned
+	VelocitySmoothing _smoothing{};
+	float _vel_sp{0.f};
+};
+
+bool MicroBenchControl::run_tests()
+{
+	ut_run_test(time_sequential_desaturation);
+	ut_run_test(time_velocity_smoothing);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchControl::reset()
+{
+	srand(time(nullptr));
+
+	_control_sp(ControlAllocation::ROLL) = random(-1.f, 1.f);
+	_control_sp(ControlAllocation::PITCH) = random(-1.f, 1.f);
+	_control_sp(ControlAllocation::YAW) = random(-1.f, 1.f);
+	_control_sp(ControlAllocation::THRUST_Z) = random(-1.f, 0.f);
+
+	_vel_sp = random(-10.f, 10.f);
+	_smoothing.setCurrentVelocity(random(-10.f, 10.f));
+	_smoothing.setCurrentAcceleration(random(-3.f, 3.f));
+}
+
+ut_declare_test_c(test_microbench_control, MicroBenchControl)
+
+bool MicroBenchControl::time_sequential_desaturation()
+{
+	// octorotor in X configuration (rotor i at 22.5 + i * 45 degrees, alternating direction)
+	static constexpr int NUM_ROTORS = 8;
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> effectiveness{};
+
+	for (int i = 0; i < NUM_ROTORS; i++) {
+		const float angle = math::radians(22.5f + i * 45.f);
+		effectiveness(ControlAllocation::ROLL, i) = -sinf(angle);
+		effectiveness(ControlAllocation::PITCH, i) = cosf(angle);
+		effectiveness(ControlAllocation::YAW, i) = (i % 2 == 0) ? 0.05f : -0.05f;
+		effectiveness(ControlAllocation::THRUST_Z, i) = -1.f;
+	}
+
+	ControlAllocation::ActuatorVector trim{};
+	ControlAllocation::ActuatorVector linearization_point{};
+	ControlAllocation::ActuatorVector actuator_min{};
+	ControlAllocation::ActuatorVector actuator_max{};
+
+	for (int i = 0; i < NUM_ROTORS; i++) {
+		actuator_max(i) = 1.f;
+	}
+
+	_allocation.updateParameters();
+	_allocation.setEffectivenessMatrix(effectiveness, trim, linearization_point, NUM_ROTORS, true);
+	_allocation.setActuatorMin(actuator_min);
+	_allocation.setActuatorMax(actuator_max);
+
+	PERF("ControlAllocationSequentialDesaturation allocate 8 rotors",
+	     _allocation.setControlSetpoint(_control_sp); _allocation.allocate(), 1000);
+
+	return true;
+}
+
+bool MicroBenchControl::time_velocity_smoothing()
+{
+	_smoothing.setMaxJerk(8.f);
+	_smoothing.setMaxAccel(3.f);
+	_smoothing.setMaxVel(12.f);
+
+	PERF("VelocitySmoothing updateDurations", _smoothing.updateDurations(_vel_sp), 1000);
+	PERF("VelocitySmoothing updateDurations updateTraj",
+	     _smoothing.updateDurations(_vel_sp); _smoothing.updateTraj(0.02f), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchControl
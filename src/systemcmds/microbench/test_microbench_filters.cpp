@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_filters.cpp
+ * Microbenchmark the filters of the gyro/accel pipeline.
+ */
+
+#include <unit_test.h>
+
+#include "microbench.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
+
+namespace MicroBenchFilters
+{
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench_report(name, p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchFilters : public UnitTest
+{
+public:
+	bool run_tests() override;
+
+private:
+
+	bool time_notch();
+	bool time_lowpass();
+
+	void reset();
+
+	void lock()
+	{
+#ifdef __PX4_NUTTX
+		_flags = px4_enter_critical_section();
+#endif
+	}
+
+	void unlock()
+	{
+#ifdef __PX4_NUTTX
+		px4_leave_critical_section(_flags);
+#endif
+	}
+
+#ifdef __PX4_NUTTX
+	irqstate_t _flags {};
+#endif
+
+	// a full sensor_gyro_fifo sample buffer
+	static constexpr int NUM_SAMPLES = 32;
+	static constexpr float SAMPLE_FREQ = 8000.f;
+
+	float _samples[NUM_SAMPLES] {};
+
+	math::NotchFilter<float> _notch{};
+	math::LowPassFilter2p<float> _lowpass{};
+};
+
+bool MicroBenchFilters::run_tests()
+{
+	_notch.setParameters(SAMPLE_FREQ, 150.f, 20.f);
+	_lowpass.set_cutoff_frequency(SAMPLE_FREQ, 40.f);
+
+	ut_run_test(time_notch);
+	ut_run_test(time_lowpass);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchFilters::reset()
+{
+	srand(time(nullptr));
+
+	for (int i = 0; i < NUM_SAMPLES; i++) {
+		_samples[i] = (rand() / (float)RAND_MAX - 0.5f) * 10.f;
+	}
+}
+
+ut_declare_test_c(test_microbench_filters, MicroBenchFilters)
+
+bool MicroBenchFilters::time_notch()
+{
+	PERF("NotchFilter applyArray 32 samples", _notch.applyArray(_samples, NUM_SAMPLES), 1000);
+	PERF("NotchFilter apply", _samples[0] = _notch.apply(_samples[1]), 1000);
+
+	return true;
+}
+
+bool MicroBenchFilters::time_lowpass()
+{
+	PERF("LowPassFilter2p applyArray 32 samples", _lowpass.applyArray(_samples, NUM_SAMPLES), 1000);
+	PERF("LowPassFilter2p apply", _samples[0] = _lowpass.apply(_samples[1]), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchFilters
@@ -38,6 +38,8 @@
 
 #include <unit_test.h>
 
+#include "microbench.h"
+
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -82,7 +84,7 @@ void unlock()
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench_report(name, p); \
 		perf_free(p); \
 	} while (0)
 
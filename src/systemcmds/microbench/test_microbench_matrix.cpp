@@ -38,6 +38,8 @@
 
 #include <unit_test.h>
 
+#include "microbench.h"
+
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -84,7 +86,7 @@ void unlock()
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench_report(name, p); \
 		perf_free(p); \
 	} while (0)
 
@@ -99,6 +101,8 @@ private:
 	bool time_matrix_quaternion();
 	bool time_matrix_dcm();
 	bool time_matrix_pseduo_inverse();
+	bool time_matrix_multiplication();
+	bool time_matrix_inverse();
 
 	void reset();
 
@@ -108,6 +112,15 @@ private:
 	matrix::Matrix<float, 16, 6> A16;
 	matrix::Matrix<float, 6, 16> B16;
 	matrix::Matrix<float, 6, 16> B16_4;
+
+	matrix::SquareMatrix<float, 3> M3;
+	matrix::SquareMatrix<float, 3> N3;
+	matrix::SquareMatrix<float, 4> M4;
+	matrix::SquareMatrix<float, 4> N4;
+	matrix::SquareMatrix<float, 24> M24;
+	matrix::SquareMatrix<float, 24> N24;
+	matrix::Vector<float, 24> v24;
+	matrix::Vector<float, 16> v16;
 };
 
 bool MicroBenchMatrix::run_tests()
@@ -116,6 +129,8 @@ bool MicroBenchMatrix::run_tests()
 	ut_run_test(time_matrix_quaternion);
 	ut_run_test(time_matrix_dcm);
 	ut_run_test(time_matrix_pseduo_inverse);
+	ut_run_test(time_matrix_multiplication);
+	ut_run_test(time_matrix_inverse);
 
 	return (_tests_failed == 0);
 }
@@ -145,6 +160,35 @@ void MicroBenchMatrix::reset()
 			B16_4(j, i) = random(-10.0, 10.0);
 		}
 	}
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			M3(i, j) = random(-10.0, 10.0);
+		}
+
+		M3(i, i) += 30.f; // well conditioned
+	}
+
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			M4(i, j) = random(-10.0, 10.0);
+		}
+
+		M4(i, i) += 40.f;
+	}
+
+	for (size_t i = 0; i < 24; i++) {
+		for (size_t j = 0; j < 24; j++) {
+			M24(i, j) = random(-10.0, 10.0);
+			N24(i, j) = random(-10.0, 10.0);
+		}
+
+		v24(i) = random(-10.0, 10.0);
+	}
+
+	for (size_t i = 0; i < 16; i++) {
+		v16(i) = random(-10.0, 10.0);
+	}
 }
 
 bool MicroBenchMatrix::time_matrix_euler()
@@ -175,6 +219,25 @@ bool MicroBenchMatrix::time_matrix_pseduo_inverse()
 	return true;
 }
 
+bool MicroBenchMatrix::time_matrix_multiplication()
+{
+	PERF("matrix 3x3 * 3x3", N3 = M3 * M3, 100);
+	PERF("matrix 4x4 * 4x4", N4 = M4 * M4, 100);
+	PERF("matrix 16x6 * 6x16", N24.slice<16, 16>(0, 0) = A16 * B16, 100);
+	PERF("matrix 6x16 * 16", v24.slice<6, 1>(0, 0) = B16 * v16, 100);
+	PERF("matrix 24x24 * 24x24", N24 = M24 * N24, 100);
+	PERF("matrix 24x24 * 24", v24 = M24 * v24, 100);
+	PERF("matrix 24x24 transpose", N24 = M24.transpose(), 100);
+	return true;
+}
+
+bool MicroBenchMatrix::time_matrix_inverse()
+{
+	PERF("matrix 3x3 inverse", matrix::inv(M3, N3), 100);
+	PERF("matrix 4x4 inverse (LU)", matrix::inv(M4, N4), 100);
+	return true;
+}
+
 ut_declare_test_c(test_microbench_matrix, MicroBenchMatrix)
 
 } // namespace MicroBenchMatrix
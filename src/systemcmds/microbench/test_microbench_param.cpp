@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_param.cpp
+ * Microbenchmark the parameter lookup and access.
+ */
+
+#include <unit_test.h>
+
+#include "microbench.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/parameters/param.h>
+
+namespace MicroBenchParam
+{
+
+// no critical section, param_get() takes the parameter lock
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+		} \
+		microbench_report(name, p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchParam : public UnitTest
+{
+public:
+	bool run_tests() override;
+
+private:
+
+	bool time_param_find();
+	bool time_param_get();
+
+	volatile param_t _handle{PARAM_INVALID};
+	int32_t _value_int{0};
+	float _value_float{0.f};
+};
+
+bool MicroBenchParam::run_tests()
+{
+	ut_run_test(time_param_find);
+	ut_run_test(time_param_get);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_param, MicroBenchParam)
+
+bool MicroBenchParam::time_param_find()
+{
+	// the parameters are sorted by name, the first and the last one bound the lookup time
+	const char *first = param_name(param_for_index(0));
+	const char *last = param_name(param_for_index(param_count() - 1));
+	ut_assert_true(first != nullptr && last != nullptr);
+
+	PERF("param_find first", _handle = param_find_no_notification(first), 1000);
+	PERF("param_find last", _handle = param_find_no_notification(last), 1000);
+	PERF("param_find SYS_AUTOSTART", _handle = param_find("SYS_AUTOSTART"), 1000);
+	PERF("param_find invalid", _handle = param_find_no_notification("NOT_A_PARAM"), 1000);
+
+	return true;
+}
+
+bool MicroBenchParam::time_param_get()
+{
+	const param_t sys_autostart = param_find("SYS_AUTOSTART");
+	ut_assert_true(sys_autostart != PARAM_INVALID);
+
+	PERF("param_get int32 SYS_AUTOSTART", param_get(sys_autostart, &_value_int), 1000);
+
+	// any float parameter
+	param_t param_float = PARAM_INVALID;
+
+	for (unsigned i = 0; i < param_count(); i++) {
+		if (param_type(param_for_index(i)) == PARAM_TYPE_FLOAT) {
+			param_float = param_for_index(i);
+			break;
+		}
+	}
+
+	ut_assert_true(param_float != PARAM_INVALID);
+
+	PERF("param_get float", param_get(param_float, &_value_float), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchParam
@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_rc.cpp
+ * Microbenchmark the RC input parsers.
+ */
+
+#include <unit_test.h>
+
+#include "microbench.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/rc/common_rc.h>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
+
+namespace MicroBenchRC
+{
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		microbench_report(name, p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchRC : public UnitTest
+{
+public:
+	bool run_tests() override;
+
+private:
+
+	bool time_crc8();
+	bool time_unpack();
+	bool time_sbus();
+	bool time_crsf();
+
+	void reset();
+
+	void lock()
+	{
+#ifdef __PX4_NUTTX
+		_flags = px4_enter_critical_section();
+#endif
+	}
+
+	void unlock()
+	{
+#ifdef __PX4_NUTTX
+		px4_leave_critical_section(_flags);
+#endif
+	}
+
+#ifdef __PX4_NUTTX
+	irqstate_t _flags {};
+#endif
+
+	static constexpr uint16_t MAX_CHANNELS = 18;
+	static constexpr unsigned SBUS_FRAME_LEN = 25;
+	static constexpr unsigned CRSF_FRAME_LEN = 26;
+
+	uint8_t _sbus_frame[SBUS_FRAME_LEN] {};
+	uint8_t _crsf_frame[CRSF_FRAME_LEN] {};
+
+	uint64_t _timestamp{0};
+
+	uint16_t _values[MAX_CHANNELS] {};
+	uint16_t _num_values{0};
+	volatile uint8_t _crc{0};
+	volatile bool _ret{false};
+};
+
+bool MicroBenchRC::run_tests()
+{
+	ut_run_test(time_crc8);
+	ut_run_test(time_unpack);
+	ut_run_test(time_sbus);
+	ut_run_test(time_crsf);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchRC::reset()
+{
+	srand(time(nullptr));
+
+	// SBUS: start byte, 16 channels of 11 bits, flags, end byte (S.BUS 1)
+	_sbus_frame[0] = 0x0f;
+
+	for (unsigned i = 1; i < 23; i++) {
+		_sbus_frame[i] = rand();
+	}
+
+	_sbus_frame[23] = 0;
+	_sbus_frame[24] = 0;
+
+	// CRSF: address, length, type, 16 channels of 11 bits, CRC over type and payload
+	_crsf_frame[0] = 0xc8;
+	_crsf_frame[1] = 24;
+	_crsf_frame[2] = 0x16;
+
+	for (unsigned i = 3; i < 25; i++) {
+		_crsf_frame[i] = rand();
+	}
+
+	_crsf_frame[25] = crc8_dvb_s2_buf(&_crsf_frame[2], 23);
+
+	// frames are at least 7 ms apart, which the SBUS parser uses for framing
+	_timestamp += 7000;
+}
+
+ut_declare_test_c(test_microbench_rc, MicroBenchRC)
+
+bool MicroBenchRC::time_crc8()
+{
+	PERF("crc8_dvb_s2_buf 23 bytes", _crc = crc8_dvb_s2_buf(&_crsf_frame[2], 23), 1000);
+
+	return true;
+}
+
+bool MicroBenchRC::time_unpack()
+{
+	PERF("rc_unpack_11bit_channels 16 channels", rc_unpack_11bit_channels(&_sbus_frame[1], _values, 16), 1000);
+
+	return true;
+}
+
+bool MicroBenchRC::time_sbus()
+{
+	bool failsafe = false;
+	bool frame_drop = false;
+	unsigned frame_drops = 0;
+
+	PERF("sbus_parse frame", _ret = sbus_parse(_timestamp, _sbus_frame, SBUS_FRAME_LEN, _values, &_num_values,
+					&failsafe, &frame_drop, &frame_drops, MAX_CHANNELS), 1000);
+
+	return true;
+}
+
+bool MicroBenchRC::time_crsf()
+{
+	PERF("crsf_parse frame", _ret = crsf_parse(_timestamp, _crsf_frame, CRSF_FRAME_LEN, _values, &_num_values,
+					MAX_CHANNELS), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchRC
@@ -38,6 +38,8 @@
 
 #include <unit_test.h>
 
+#include "microbench.h"
+
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -47,7 +49,10 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/orb_test_medium.h>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/sensor_gyro_fifo.h>
@@ -89,7 +94,7 @@ void unlock()
 			unlock(); \
 			reset(); \
 		} \
-		perf_print_counter(p); \
+		microbench_report(name, p); \
 		perf_free(p); \
 	} while (0)
 
@@ -102,6 +107,7 @@ private:
 
 	bool time_px4_uorb();
 	bool time_px4_uorb_direct();
+	bool time_px4_uorb_publish();
 
 	void reset();
 
@@ -115,6 +121,7 @@ bool MicroBenchORB::run_tests()
 {
 	ut_run_test(time_px4_uorb);
 	ut_run_test(time_px4_uorb_direct);
+	ut_run_test(time_px4_uorb_publish);
 
 	return (_tests_failed == 0);
 }
@@ -246,4 +253,53 @@ bool MicroBenchORB::time_px4_uorb_direct()
 	return true;
 }
 
+// callback subscriber doing no work, so only the notification cost is measured
+class CallbackCounter : public uORB::SubscriptionCallback
+{
+public:
+	CallbackCounter() : uORB::SubscriptionCallback(ORB_ID(orb_test_medium)) {}
+
+	void call() override { calls++; }
+
+	unsigned calls{0};
+};
+
+bool MicroBenchORB::time_px4_uorb_publish()
+{
+	static constexpr int MAX_SUBSCRIBERS = 16;
+
+	orb_test_medium_s medium{};
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+
+	PERF("uORB::Publication publish orb_test_medium 0 subscribers", pub.publish(medium), 100);
+
+	CallbackCounter *subscribers = new CallbackCounter[MAX_SUBSCRIBERS];
+
+	if (subscribers == nullptr) {
+		return false;
+	}
+
+	int registered = 0;
+	char name[64];
+
+	for (int num_subscribers : {1, 4, 16}) {
+		while (registered < num_subscribers) {
+			if (!subscribers[registered++].registerCallback()) {
+				PX4_ERR("registering callback %d failed", registered);
+				delete[] subscribers;
+				return false;
+			}
+		}
+
+		printf("\n");
+
+		snprintf(name, sizeof(name), "uORB::Publication publish orb_test_medium %d subscribers", num_subscribers);
+		PERF(name, medium.val++; pub.publish(medium), 100);
+	}
+
+	delete[] subscribers;
+
+	return true;
+}
+
 } // namespace MicroBenchORB
@@ -56,12 +56,15 @@ typedef struct sdb_config {
 	bool synchronized; ///< call fsync after each block?
 	bool aligned;
 	unsigned int total_blocks_written;
+	int logger_rate; ///< simulated logger data rate [KB/s] (logger workload test)
 } sdb_config_t;
 
 /** sequential write speed test */
 static void write_test(int fd, sdb_config_t *cfg, uint8_t *block, int block_size);
 /** sequential read speed test */
 static int read_test(int fd, sdb_config_t *cfg, uint8_t *block, int block_size);
+/** write pattern of the logger: chunks of what accumulated in the buffer, periodic fsync */
+static int logger_test(int fd, sdb_config_t *cfg);
 
 /**
  * Measure the time for fsync.
@@ -74,7 +77,17 @@ static const char *BENCHMARK_FILE = PX4_STORAGEDIR"/benchmark.tmp";
 
 static void usage()
 {
-	PRINT_MODULE_DESCRIPTION("Test the speed of an SD Card");
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Test the speed of an SD Card.
+
+With -l, the write pattern of the logger is simulated instead of sequential fixed size blocks:
+data is produced at a constant rate into a (virtual, unbounded) buffer, which is written out
+in multiples of 4 KB whenever at least 4 KB accumulated, and fsync is called once per second.
+The write latency percentiles and the buffer high water mark are reported. The latter is
+the minimum log buffer size (SDLOG_BUF equivalent) without dropouts at that rate.
+)DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME_SIMPLE("sd_bench", "command");
 	PRINT_MODULE_USAGE_PARAM_INT('b', 4096, 1, 1000000, "Block size for each read/write", true);
@@ -84,6 +97,8 @@ static void usage()
 	PRINT_MODULE_USAGE_PARAM_FLAG('s', "Call fsync after each block (default=at end of each run)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('u', "Test performance with unaligned data", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Verify data and block number", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "Simulate the logger write pattern", true);
+	PRINT_MODULE_USAGE_PARAM_INT('R', 100, 1, 10000, "Logger data rate in KB/s (with -l)", true);
 }
 
 extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
@@ -99,9 +114,11 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 	cfg.num_runs = 5;
 	cfg.run_duration = 2000;
 	cfg.aligned = true;
+	cfg.logger_rate = 100;
+	bool logger = false;
 	uint8_t *block = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:ksuv", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:ksuvlR:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			block_size = strtol(myoptarg, nullptr, 0);
@@ -131,6 +148,14 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 			verify = true;
 			break;
 
+		case 'l':
+			logger = true;
+			break;
+
+		case 'R':
+			cfg.logger_rate = strtol(myoptarg, nullptr, 0);
+			break;
+
 		default:
 			usage();
 			return -1;
@@ -138,7 +163,7 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 		}
 	}
 
-	if (block_size <= 0 || cfg.num_runs <= 0) {
+	if (block_size <= 0 || cfg.num_runs <= 0 || cfg.logger_rate <= 0) {
 		PX4_ERR("invalid argument");
 		return -1;
 	}
@@ -150,6 +175,17 @@ extern "C" __EXPORT int sd_bench_main(int argc, char *argv[])
 		return -1;
 	}
 
+	if (logger) {
+		int ret = logger_test(bench_fd, &cfg);
+		close(bench_fd);
+
+		if (!keep) {
+			unlink(BENCHMARK_FILE);
+		}
+
+		return ret;
+	}
+
 	//create some data block
 	if (cfg.aligned) {
 		block = (uint8_t *)px4_cache_aligned_alloc(block_size);
@@ -329,3 +365,152 @@ int read_test(int fd, sdb_config_t *cfg, uint8_t *block, int block_size)
 	free(read_block);
 	return 0;
 }
+
+/** latency histogram with 1 ms bins, the last bin collects everything above */
+struct latency_histogram_s {
+	static constexpr unsigned NUM_BINS = 1000;
+	uint32_t bins[NUM_BINS];
+	uint32_t count;
+	unsigned int max;
+
+	void add(unsigned int time_ms)
+	{
+		bins[time_ms < NUM_BINS ? time_ms : NUM_BINS - 1]++;
+		count++;
+
+		if (time_ms > max) {
+			max = time_ms;
+		}
+	}
+
+	/** @return upper bound of the bin containing percentile p [ms] */
+	unsigned int percentile(double p) const
+	{
+		if (count == 0) {
+			return 0;
+		}
+
+		const uint64_t limit = (uint64_t)(p / 100. * count + 0.5);
+		uint64_t sum = 0;
+
+		for (unsigned i = 0; i < NUM_BINS - 1; ++i) {
+			sum += bins[i];
+
+			if (sum >= limit) {
+				return i + 1;
+			}
+		}
+
+		return max;
+	}
+};
+
+int logger_test(int fd, sdb_config_t *cfg)
+{
+	// same as LogWriterFile: write when at least 4 KB are available, fsync every second
+	static constexpr size_t min_write_chunk = 4096;
+	static constexpr size_t max_write_chunk = 32 * 1024; ///< bounded by the buffer wrap-around in the logger
+	static constexpr hrt_abstime fsync_interval = 1000000;
+
+	latency_histogram_s *write_hist = (latency_histogram_s *)calloc(1, sizeof(latency_histogram_s));
+	latency_histogram_s *fsync_hist = (latency_histogram_s *)calloc(1, sizeof(latency_histogram_s));
+	uint8_t *block = (uint8_t *)px4_cache_aligned_alloc(max_write_chunk);
+
+	if (!write_hist || !fsync_hist || !block) {
+		PX4_ERR("Failed to allocate memory");
+		free(write_hist);
+		free(fsync_hist);
+		free(block);
+		return -1;
+	}
+
+	for (size_t i = 0; i < max_write_chunk; ++i) {
+		block[i] = (uint8_t)i;
+	}
+
+	const uint64_t rate = (uint64_t)cfg->logger_rate * 1024; // [B/s]
+
+	PX4_INFO("");
+	PX4_INFO("Testing Logger Write Pattern at %i KB/s...", cfg->logger_rate);
+
+	size_t total_max_fill = 0;
+
+	for (int run = 0; run < cfg->num_runs; ++run) {
+		const hrt_abstime start = hrt_absolute_time();
+		hrt_abstime last_fsync = start;
+		uint64_t written = 0;
+		size_t max_fill = 0;
+		unsigned int max_write_time = 0;
+		int ret = 0;
+
+		while (ret == 0 && (int64_t)hrt_elapsed_time(&start) < cfg->run_duration * 1000) {
+			const hrt_abstime now = hrt_absolute_time();
+			const size_t fill = (now - start) * rate / 1000000 - written;
+
+			if (fill > max_fill) {
+				max_fill = fill;
+			}
+
+			if (fill < min_write_chunk) {
+				px4_usleep((min_write_chunk - fill) * 1000000 / rate + 1);
+				continue;
+			}
+
+			size_t chunk = fill - fill % min_write_chunk;
+
+			if (chunk > max_write_chunk) {
+				chunk = max_write_chunk;
+			}
+
+			hrt_abstime write_start = hrt_absolute_time();
+
+			if (write(fd, block, chunk) != (ssize_t)chunk) {
+				PX4_ERR("Write error: %d", errno);
+				ret = -1;
+			}
+
+			const unsigned int write_time = hrt_elapsed_time(&write_start) / 1000;
+			write_hist->add(write_time);
+			written += chunk;
+
+			if (write_time > max_write_time) {
+				max_write_time = write_time;
+			}
+
+			if (hrt_elapsed_time(&last_fsync) > fsync_interval) {
+				last_fsync = hrt_absolute_time();
+				fsync_hist->add(time_fsync(fd));
+			}
+		}
+
+		if (ret != 0) {
+			free(write_hist);
+			free(fsync_hist);
+			free(block);
+			return ret;
+		}
+
+		PX4_INFO("  Run %2i: %8.2lf KB/s written, max write time: %u ms, buffer high water: %u KB", run,
+			 (double)written / (hrt_elapsed_time(&start) / 1.e6) / 1024., max_write_time,
+			 (unsigned)((max_fill + 1023) / 1024));
+
+		if (max_fill > total_max_fill) {
+			total_max_fill = max_fill;
+		}
+	}
+
+	PX4_INFO("  write (%u): p50 %u ms, p90 %u ms, p99 %u ms, p99.9 %u ms, max %u ms", (unsigned)write_hist->count,
+		 write_hist->percentile(50.), write_hist->percentile(90.), write_hist->percentile(99.),
+		 write_hist->percentile(99.9), write_hist->max);
+	PX4_INFO("  fsync (%u): p50 %u ms, p90 %u ms, p99 %u ms, max %u ms", (unsigned)fsync_hist->count,
+		 fsync_hist->percentile(50.), fsync_hist->percentile(90.), fsync_hist->percentile(99.), fsync_hist->max);
+
+	// the logger needs room for the data accumulated during the longest stall plus the chunk in flight
+	PX4_INFO("  Minimum log buffer size: %u KB (logger default 12 KB)",
+		 (unsigned)((total_max_fill + min_write_chunk + 1023) / 1024));
+
+	free(write_hist);
+	free(fsync_hist);
+	free(block);
+	return 0;
+}
@@ -40,14 +40,24 @@
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/getopt.h>
 
+#include <fcntl.h>
 #include <poll.h>
 
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
+#include <modules/logger/messages.h>
+#include <uORB/Subscription.hpp>
 #include <uORB/topics/uORBTopics.hpp>
 #include "topic_listener.hpp"
 
 // Amount of time to wait when listening for a message, before giving up.
 static constexpr float MESSAGE_TIMEOUT_S = 2.0f;
 
+// binary mode limits
+static constexpr int MAX_BINARY_SUBSCRIPTIONS = 16;
+static constexpr int MAX_BINARY_FORMATS = 32;
+static constexpr size_t BINARY_BUFFER_SIZE = 4096;
+
 extern "C" __EXPORT int listener_main(int argc, char *argv[]);
 
 static void usage();
@@ -160,6 +170,321 @@ void listener(const orb_id_t &id, unsigned num_msgs, int topic_instance,
 
 }
 
+/**
+ * Binary output of the listener: a ULog stream with the formats and subscriptions of the
+ * listened topics followed by their data messages.
+ */
+class BinaryWriter
+{
+public:
+	BinaryWriter(int fd) : _fd(fd) {}
+	~BinaryWriter() { delete[] _buffer; }
+
+	bool init() { _buffer = new uint8_t[BINARY_BUFFER_SIZE]; return _buffer != nullptr; }
+
+	bool write_header()
+	{
+		ulog_file_header_s header{};
+		header.magic[0] = 'U';
+		header.magic[1] = 'L';
+		header.magic[2] = 'o';
+		header.magic[3] = 'g';
+		header.magic[4] = 0x01;
+		header.magic[5] = 0x12;
+		header.magic[6] = 0x35;
+		header.magic[7] = 0x01; //file version 1
+		header.timestamp = hrt_absolute_time();
+
+		ulog_message_flag_bits_s flag_bits{};
+		flag_bits.msg_size = sizeof(flag_bits) - ULOG_MSG_HEADER_LEN;
+		flag_bits.msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
+
+		return write(&header, sizeof(header)) && write(&flag_bits, sizeof(flag_bits));
+	}
+
+	/**
+	 * write the format of a topic and all its nested types, unless already written
+	 */
+	bool write_format(const orb_metadata &meta)
+	{
+		if (!write_single_format(meta)) {
+			return false;
+		}
+
+		const ORB_ID *nested_topics;
+		const int num_nested = orb_get_nested_topics(static_cast<ORB_ID>(meta.o_id), &nested_topics);
+
+		for (int i = 0; i < num_nested; ++i) {
+			write_single_format(*get_orb_meta(nested_topics[i]));
+		}
+
+		return true;
+	}
+
+	bool write_add_logged(const orb_metadata &meta, uint8_t instance, uint16_t msg_id)
+	{
+		ulog_message_add_logged_s msg{};
+		const size_t name_len = math::min(strlen(meta.o_name), sizeof(msg.message_name));
+		memcpy(msg.message_name, meta.o_name, name_len);
+		msg.multi_id = instance;
+		msg.msg_id = msg_id;
+
+		const size_t msg_size = sizeof(msg) - sizeof(msg.message_name) + name_len;
+		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+		return write(&msg, msg_size);
+	}
+
+	bool write_data(uint16_t msg_id, const void *data, size_t size)
+	{
+		ulog_message_data_s msg{};
+		msg.msg_size = sizeof(msg) + size - ULOG_MSG_HEADER_LEN;
+		msg.msg_id = msg_id;
+		return write(&msg, sizeof(msg)) && write(data, size);
+	}
+
+	bool flush()
+	{
+		size_t written = 0;
+
+		while (written < _buffer_used) {
+			const ssize_t ret = ::write(_fd, _buffer + written, _buffer_used - written);
+
+			if (ret <= 0) {
+				return false;
+			}
+
+			written += ret;
+		}
+
+		_buffer_used = 0;
+		return true;
+	}
+
+private:
+	bool write(const void *data, size_t size)
+	{
+		if (_buffer_used + size > BINARY_BUFFER_SIZE && !flush()) {
+			return false;
+		}
+
+		if (size > BINARY_BUFFER_SIZE) {
+			return ::write(_fd, data, size) == (ssize_t)size;
+		}
+
+		memcpy(_buffer + _buffer_used, data, size);
+		_buffer_used += size;
+		return true;
+	}
+
+	bool write_single_format(const orb_metadata &meta)
+	{
+		for (int i = 0; i < _num_formats; i++) {
+			if (_formats[i] == &meta) {
+				return false;
+			}
+		}
+
+		if (_num_formats >= MAX_BINARY_FORMATS) {
+			PX4_ERR("too many formats");
+			return false;
+		}
+
+		_formats[_num_formats++] = &meta;
+
+		if (!flush()) {
+			return false;
+		}
+
+		// expand the format directly in the (now empty) buffer
+		ulog_message_format_s &msg = *reinterpret_cast<ulog_message_format_s *>(_buffer);
+		msg.msg_type = static_cast<uint8_t>(ULogMessageType::FORMAT);
+		int format_len = snprintf(msg.format, sizeof(msg.format), "%s:", meta.o_name);
+
+		for (const char *fields = meta.o_fields; *fields != 0; ++fields) {
+			const char *c_type = orb_get_c_type(*fields);
+			const int len = c_type ? strlen(c_type) : 1;
+
+			if (len >= (int)sizeof(msg.format) - format_len) {
+				PX4_ERR("format of %s too large", meta.o_name);
+				return false;
+			}
+
+			if (c_type) {
+				memcpy(msg.format + format_len, c_type, len);
+
+			} else {
+				msg.format[format_len] = *fields;
+			}
+
+			format_len += len;
+		}
+
+		const size_t msg_size = sizeof(msg) - sizeof(msg.format) + format_len;
+		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+		_buffer_used = msg_size;
+
+		return flush();
+	}
+
+	const int _fd;
+	uint8_t *_buffer{nullptr};
+	size_t _buffer_used{0};
+
+	const orb_metadata *_formats[MAX_BINARY_FORMATS] {};
+	int _num_formats{0};
+};
+
+/**
+ * Stream all samples of one or several topics (comma separated) as ULog to a file or stdout ('-').
+ * All instances are streamed unless topic_instance is set, num_msgs = 0 streams until stopped.
+ */
+int listener_binary(char *topic_names, const char *output, int topic_instance, unsigned num_msgs,
+		    unsigned topic_interval)
+{
+	static_assert(sizeof(ulog_message_format_s) < BINARY_BUFFER_SIZE, "buffer too small");
+
+	uORB::Subscription *subscriptions[MAX_BINARY_SUBSCRIPTIONS] {};
+	int num_subscriptions = 0;
+	size_t max_size = 0;
+
+	char *save_ptr = nullptr;
+
+	for (char *name = strtok_r(topic_names, ",", &save_ptr); name; name = strtok_r(nullptr, ",", &save_ptr)) {
+		const orb_metadata *meta = nullptr;
+
+		for (size_t i = 0; i < orb_topics_count(); i++) {
+			if (strcmp(orb_get_topics()[i]->o_name, name) == 0) {
+				meta = orb_get_topics()[i];
+			}
+		}
+
+		if (!meta) {
+			PX4_ERR("Topic %s did not match any known topics", name);
+			continue;
+		}
+
+		for (int instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+			if ((topic_instance == -1 && orb_exists(meta, instance) == PX4_OK) || instance == topic_instance) {
+				if (num_subscriptions >= MAX_BINARY_SUBSCRIPTIONS) {
+					PX4_ERR("too many subscriptions, max is %d", MAX_BINARY_SUBSCRIPTIONS);
+					break;
+				}
+
+				subscriptions[num_subscriptions++] = new uORB::Subscription(meta, instance);
+				max_size = math::max(max_size, (size_t)meta->o_size);
+			}
+		}
+	}
+
+	const bool to_stdout = (strcmp(output, "-") == 0);
+	const int fd = to_stdout ? 1 : open(output, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+	uint8_t *sample = (num_subscriptions > 0) ? new uint8_t[max_size] : nullptr;
+	BinaryWriter writer{fd};
+	int ret = PX4_ERROR;
+
+	if (num_subscriptions == 0) {
+		PX4_ERR("no topic to stream");
+
+	} else if (fd < 0) {
+		PX4_ERR("failed to open %s (%i)", output, errno);
+
+	} else if (!sample || !writer.init() || !writer.write_header()) {
+		PX4_ERR("failed to start");
+
+	} else {
+		ret = PX4_OK;
+
+		for (int i = 0; i < num_subscriptions && ret == PX4_OK; i++) {
+			const orb_metadata *meta = subscriptions[i]->get_topic();
+			writer.write_format(*meta);
+
+			if (!writer.write_add_logged(*meta, subscriptions[i]->get_instance(), i)) {
+				ret = PX4_ERROR;
+			}
+		}
+
+		hrt_abstime last_written[MAX_BINARY_SUBSCRIPTIONS] {};
+		unsigned msgs_written = 0;
+		unsigned msgs_lost = 0;
+
+		struct pollfd fds {};
+		// Poll for user input (for q or escape), this also paces the loop at about 1 kHz
+		fds.fd = 0; /* stdin */
+		fds.events = POLLIN;
+
+		while (ret == PX4_OK && (num_msgs == 0 || msgs_written < num_msgs)) {
+			bool idle = true;
+
+			// drain the queues of all subscriptions
+			for (int i = 0; i < num_subscriptions; i++) {
+				while ((num_msgs == 0 || msgs_written < num_msgs) && subscriptions[i]->updated()) {
+					const unsigned last_generation = subscriptions[i]->get_last_generation();
+
+					if (!subscriptions[i]->update(sample)) {
+						break;
+					}
+
+					// the subscription skips over samples that were overwritten in the queue
+					msgs_lost += subscriptions[i]->get_last_generation() - last_generation - 1;
+
+					const hrt_abstime timestamp = *reinterpret_cast<uint64_t *>(sample);
+
+					if (topic_interval != 0 && timestamp < last_written[i] + topic_interval * 1000) {
+						continue;
+					}
+
+					last_written[i] = timestamp;
+
+					if (!writer.write_data(i, sample, subscriptions[i]->get_topic()->o_size_no_padding)) {
+						ret = PX4_ERROR;
+						break;
+					}
+
+					idle = false;
+					msgs_written++;
+				}
+			}
+
+			// batch the output while data keeps coming in
+			if (idle && !writer.flush()) {
+				ret = PX4_ERROR;
+			}
+
+			if (ret == PX4_OK && poll(&fds, 1, 1) > 0 && (fds.revents & POLLIN)) {
+				char c = 0;
+
+				if (read(0, &c, 1) <= 0 || c == 0x03 || c == 0x1b || c == 'q') {
+					break;
+				}
+			}
+		}
+
+		if (!writer.flush()) {
+			ret = PX4_ERROR;
+		}
+
+		if (ret != PX4_OK) {
+			PX4_ERR("write failed (%i)", errno);
+		}
+
+		if (!to_stdout) {
+			PX4_INFO("%u messages written, %u lost", msgs_written, msgs_lost);
+		}
+	}
+
+	if (fd >= 0 && !to_stdout) {
+		close(fd);
+	}
+
+	delete[] sample;
+
+	for (int i = 0; i < num_subscriptions; i++) {
+		delete subscriptions[i];
+	}
+
+	return ret;
+}
+
 int listener_main(int argc, char *argv[])
 {
 	if (argc <= 1) {
@@ -172,14 +497,19 @@ int listener_main(int argc, char *argv[])
 	int topic_instance = -1;
 	unsigned topic_rate = 0;
 	unsigned num_msgs = 0;
+	const char *binary_output = nullptr;
 
 	int myoptind = 1;
 	int ch;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "i:r:n:", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "i:r:n:b:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 
+		case 'b':
+			binary_output = myoptarg;
+			break;
+
 		case 'i':
 			topic_instance = strtol(myoptarg, nullptr, 0);
 			break;
@@ -199,7 +529,7 @@ int listener_main(int argc, char *argv[])
 		}
 	}
 
-	if (num_msgs == 0) {
+	if (num_msgs == 0 && !binary_output) {
 		if (topic_rate != 0) {
 			num_msgs = 30 * topic_rate; // arbitrary limit (30 seconds at max rate)
 
@@ -215,6 +545,10 @@ int listener_main(int argc, char *argv[])
 		topic_interval = 1000 / topic_rate;
 	}
 
+	if (binary_output) {
+		return listener_binary(topic_name, binary_output, topic_instance, num_msgs, topic_interval);
+	}
+
 	const orb_metadata *const *topics = orb_get_topics();
 	const orb_metadata *found_topic = nullptr;
 
@@ -244,6 +578,15 @@ usage()
 Utility to listen on uORB topics and print the data to the console.
 
 The listener can be exited any time by pressing Ctrl+C, Esc, or Q.
+
+With -b the samples are streamed unformatted as ULog (the same format as the logger) to a file, a serial
+device or stdout, so every sample of a topic can be captured without starting the logger.
+Several topics can be given comma separated and all their instances are streamed unless -i is set.
+Streaming continues until stopped if -n is not given.
+
+### Examples
+Capture the gyro FIFO samples of all IMUs on the SD card:
+$ listener sensor_gyro_fifo,sensor_accel_fifo -b /fs/microsd/fifo.ulg
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("listener", "command");
@@ -252,4 +595,5 @@ The listener can be exited any time by pressing Ctrl+C, Esc, or Q.
 	PRINT_MODULE_USAGE_PARAM_INT('i', 0, 0, ORB_MULTI_MAX_INSTANCES - 1, "Topic instance", true);
 	PRINT_MODULE_USAGE_PARAM_INT('n', 1, 0, 100, "Number of messages", true);
 	PRINT_MODULE_USAGE_PARAM_INT('r', 0, 0, 1000, "Subscription rate (unlimited if 0)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('b', nullptr, "<file>", "Stream binary ULog to a file ('-' for stdout)", true);
 }
@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file trace.cpp
+ *
+ * Control the event trace buffer and write it as Chrome trace (JSON).
+ */
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/trace.h>
+
+#include <fcntl.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static void usage();
+
+extern "C" {
+	__EXPORT int trace_main(int argc, char *argv[]);
+}
+
+static void write_event(int fd, const px4_trace_entry &entry)
+{
+	// the thread name metadata is always the first event
+	const char *separator = ",\n";
+	const char *string = (const char *)entry.object;
+
+	// chrome trace timestamps are in microseconds
+	const unsigned long long ts = entry.timestamp;
+
+	switch (entry.event) {
+	case PX4_TRACE_WORK_ITEM_SCHEDULE:
+		dprintf(fd, "%s{\"name\":\"schedule %s\",\"cat\":\"wq\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, string, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_WORK_ITEM_RUN_BEGIN:
+		dprintf(fd, "%s{\"name\":\"%s\",\"cat\":\"wq\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, string, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_WORK_ITEM_RUN_END:
+	case PX4_TRACE_SEM_WAIT_END:
+	case PX4_TRACE_HRT_END:
+		dprintf(fd, "%s{\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}", separator, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_ORB_PUBLISH:
+		dprintf(fd, "%s{\"name\":\"publish %s\",\"cat\":\"uorb\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, string, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_SEM_WAIT_BEGIN:
+		dprintf(fd, "%s{\"name\":\"sem_wait %p\",\"cat\":\"sem\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, entry.object, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_SEM_POST:
+		dprintf(fd, "%s{\"name\":\"sem_post %p\",\"cat\":\"sem\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, entry.object, ts, entry.tid);
+		break;
+
+	case PX4_TRACE_HRT_BEGIN:
+		dprintf(fd, "%s{\"name\":\"hrt %p\",\"cat\":\"hrt\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%" PRIu32 "}",
+			separator, entry.object, ts, entry.tid);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static int dump(const char *file)
+{
+	// stop recording, the buffer is only consistent while no one writes
+	px4_trace_enable(false);
+
+	int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open %s (%i)", file, errno);
+		return 1;
+	}
+
+	dprintf(fd, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	dprintf(fd, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"hrt\"}}");
+
+	px4_trace_entry entry;
+	int count = 0;
+
+	while (px4_trace_get(count, &entry)) {
+		write_event(fd, entry);
+		count++;
+	}
+
+	dprintf(fd, "\n]}\n");
+	close(fd);
+
+	PX4_INFO("wrote %i events to %s (%" PRIu32 " overwritten)", count, file, px4_trace_overwritten());
+	return 0;
+}
+
+int trace_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return 1;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		px4_trace_enable(true);
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		px4_trace_enable(false);
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		px4_trace_entry entry;
+		int count = 0;
+
+		while (px4_trace_get(count, &entry)) {
+			count++;
+		}
+
+		PX4_INFO("%s, %i events (%" PRIu32 " overwritten), buffer: %i entries", px4_trace_enabled ? "recording" : "stopped",
+			 count, px4_trace_overwritten(), CONFIG_SYSTEMCMDS_TRACE_BUFFER_ENTRIES);
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "dump") && argc > 2) {
+		return dump(argv[2]);
+	}
+
+	usage();
+	return 1;
+}
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Event tracing. When enabled, work item scheduling and runs, uORB publications, blocking semaphore
+waits (and the posts waking them) and HRT callouts are recorded into a ring buffer. The oldest
+events are overwritten, so stop (or dump) right after the event of interest.
+
+The dump is a Chrome trace file that can be opened with chrome://tracing or https://ui.perfetto.dev.
+Threads show up with their task (NuttX) or thread (Linux) id.
+
+### Example
+$ trace start
+$ trace dump /fs/microsd/trace.json
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("trace", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Clear the buffer and start recording");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("stop", "Stop recording");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print the buffer state");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Stop recording and write the buffer as Chrome trace");
+	PRINT_MODULE_USAGE_ARG("<file>", "Output file", false);
+}
@@ -91,5 +91,6 @@ $ uorb top
 	PRINT_MODULE_USAGE_COMMAND_DESCR("top", "Monitor topic publication rates");
 	PRINT_MODULE_USAGE_PARAM_FLAG('a', "print all instead of only currently publishing topics with subscribers", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('1', "run only once, then exit", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "show publication and callback latencies (requires CONFIG_UORB_LATENCY_STATISTICS)", true);
 	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match (implies -a)", true);
 }
@@ -45,7 +45,7 @@ extern "C" {
 int
 work_queue_main(int argc, char *argv[])
 {
-	if (argc != 2) {
+	if (argc < 2) {
 		usage();
 		return 1;
 	}
@@ -59,7 +59,8 @@ work_queue_main(int argc, char *argv[])
 		return 0;
 
 	} else if (!strcmp(argv[1], "status")) {
-		px4::WorkQueueManagerStatus();
+		const bool verbose = (argc > 2) && !strcmp(argv[2], "-v");
+		px4::WorkQueueManagerStatus(verbose);
 		return 0;
 	}
 
@@ -82,5 +83,7 @@ Command-line tool to show work queue status.
 
 	PRINT_MODULE_USAGE_NAME("work_queue", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
-	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "print status info");
+	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Print run statistics (execution time, scheduling latency) of every WorkItem", true);
+	PRINT_MODULE_USAGE_COMMAND("stop");
 }